@@ -30,12 +30,17 @@
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/Triple.h>
 
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
 #include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/Deduplicate.h"
 #include "Magnum/SceneTools/Filter.h"
 #include "Magnum/SceneTools/Hierarchy.h"
+#include "Magnum/SceneTools/SpatialIndex.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -160,4 +165,40 @@ for(const Containers::Pair<UnsignedInt, Int>& parent:
 }
 /* [parentsBreadthFirst-transformations] */
 }
+
+{
+/* [deduplicateMeshes] */
+Containers::Array<Trade::MeshData> meshes = DOXYGEN_ELLIPSIS({});
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> mapping =
+    SceneTools::deduplicateMeshes(meshes);
+
+Containers::Array<Trade::MeshData> uniqueMeshes;
+arrayReserve(uniqueMeshes, mapping.second());
+for(std::size_t i = 0; i != meshes.size(); ++i)
+    if(mapping.first()[i] == uniqueMeshes.size())
+        arrayAppend(uniqueMeshes, Utility::move(meshes[i]));
+/* [deduplicateMeshes] */
+}
+
+{
+/* [SpatialIndex3D-usage] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+Containers::Array<Trade::MeshData> meshes = DOXYGEN_ELLIPSIS({});
+
+Containers::Array<Range3D> meshBounds{NoInit, meshes.size()};
+for(std::size_t i = 0; i != meshes.size(); ++i)
+    meshBounds[i] = MeshTools::boundingRange(meshes[i].positions3DAsArray());
+
+SceneTools::SpatialIndex3D index{scene, meshBounds};
+
+/* IDs of Mesh field entries visible by the camera, index.objects() maps them
+   back to object IDs */
+Matrix4 projection = DOXYGEN_ELLIPSIS({});
+Matrix4 cameraMatrix = DOXYGEN_ELLIPSIS({});
+Containers::Array<UnsignedInt> visible =
+    index.intersectFrustum(Frustum::fromMatrix(projection*cameraMatrix));
+/* [SpatialIndex3D-usage] */
+static_cast<void>(visible);
+}
 }
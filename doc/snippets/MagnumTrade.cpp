@@ -52,15 +52,18 @@
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelImport.h"
 #include "Magnum/Trade/PbrClearCoatMaterialData.h"
 #include "Magnum/Trade/PbrSpecularGlossinessMaterialData.h"
 #include "Magnum/Trade/PbrMetallicRoughnessMaterialData.h"
 #include "Magnum/Trade/PhongMaterialData.h"
+#include "Magnum/Trade/Profiler.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/SceneGraph/Drawable.h"
 #include "Magnum/SceneGraph/Scene.h"
@@ -244,6 +247,78 @@ importer->openFile("scene.gltf"); // memory-maps all files
 }
 #endif
 
+{
+/* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
+   the converter pointer. I don't care, I just want you to check compilation
+   errors, not more! */
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer = manager.loadAndInstantiate("SomethingWhatever");
+/* [importMeshes] */
+importer->openFile("scene.obj");
+
+/* Import all meshes, in parallel if the importer supports it */
+Containers::Array<UnsignedInt> ids{importer->meshCount()};
+for(UnsignedInt i = 0; i != ids.size(); ++i) ids[i] = i;
+Containers::Array<Containers::Optional<Trade::MeshData>> meshes =
+    Trade::importMeshes(*importer, ids);
+/* [importMeshes] */
+}
+
+{
+/* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
+   the converter pointer. I don't care, I just want you to check compilation
+   errors, not more! */
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer = manager.loadAndInstantiate("SomethingWhatever");
+/* [Profiler] */
+Trade::Profiler profiler;
+importer->setProfiler(&profiler);
+
+importer->openFile("scene.gltf");
+for(UnsignedInt i = 0; i != importer->meshCount(); ++i)
+    importer->mesh(i);
+
+/* Print the slowest mesh */
+const Trade::ProfilerRecord* slowest = nullptr;
+for(const Trade::ProfilerRecord& record: profiler.records())
+    if(Containers::StringView{record.function} == "Trade::AbstractImporter::mesh()" &&
+       (!slowest || record.duration > slowest->duration))
+        slowest = &record;
+if(slowest) Debug{} << "Mesh" << slowest->id << "took"
+    << slowest->duration/1.0e6 << "ms";
+
+/* Save a trace for viewing in chrome://tracing */
+Utility::Path::write("trace.json", profiler.chromeTrace());
+/* [Profiler] */
+}
+
+{
+/* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
+   the converter pointer. I don't care, I just want you to check compilation
+   errors, not more! */
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer = manager.loadAndInstantiate("SomethingWhatever");
+/* [ArrayArena] */
+Trade::ArrayArena arena;
+importer->setArrayArena(&arena);
+
+for(const char* file: {"a.obj", "b.obj", "c.obj"}) {
+    importer->openFile(file);
+    Containers::Optional<Trade::MeshData> mesh = importer->mesh(0);
+    importer->close();
+
+    // process the mesh ...
+
+    /* Mesh data are destroyed at the end of the scope, release the arena
+       memory at once for the next file */
+    mesh = Containers::NullOpt;
+    arena.release();
+}
+
+Debug{} << "Peak arena usage:" << arena.peakAllocatedSize() << "bytes";
+/* [ArrayArena] */
+}
+
 {
 /* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
    the converter pointer. I don't care, I just want you to check compilation
@@ -49,12 +49,15 @@
 # OpenGL ES libraries). Additional dependencies are specified by the
 # components. The optional components are:
 #
+#  AnimationTools               - AnimationTools library
 #  AnyAudioImporter             - Any audio importer
 #  AnyImageConverter            - Any image converter
 #  AnyImageImporter             - Any image importer
 #  AnySceneConverter            - Any scene converter
 #  AnySceneImporter             - Any scene importer
 #  Audio                        - Audio library
+#  CachingImporter              - Caching importer
+#  CachingShaderConverter       - Caching shader converter
 #  DebugTools                   - DebugTools library
 #  GL                           - GL library
 #  MaterialTools                - MaterialTools library
@@ -87,6 +90,8 @@
 #  VulkanTester                 - VulkanTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImporter               - Magnum blob importer plugin
+#  MagnumSceneConverter         - Magnum blob scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -380,12 +385,13 @@ endif()
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
 set(_MAGNUM_LIBRARY_COMPONENTS
-    Audio DebugTools GL MaterialTools MeshTools Primitives SceneGraph
-    SceneTools Shaders ShaderTools Text TextureTools Trade
+    AnimationTools Audio DebugTools GL MaterialTools MeshTools Primitives
+    SceneGraph SceneTools Shaders ShaderTools Text TextureTools Trade
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
+    AnySceneImporter CachingImporter CachingShaderConverter MagnumFont
+    MagnumFontConverter MagnumImporter MagnumSceneConverter ObjImporter
     TgaImageConverter TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
@@ -427,6 +433,8 @@ if(CORRADE_TARGET_UNIX OR CORRADE_TARGET_WINDOWS)
 endif()
 
 # Inter-component dependencies
+set(_MAGNUM_AnimationTools_DEPENDENCIES Trade)
+
 set(_MAGNUM_Audio_DEPENDENCIES )
 
 # Trade is used by CompareImage. If Trade is not enabled, CompareImage is not
@@ -472,7 +480,11 @@ if(MAGNUM_TARGET_GL)
 endif()
 
 set(_MAGNUM_SceneGraph_DEPENDENCIES )
-set(_MAGNUM_SceneTools_DEPENDENCIES Trade)
+set(_MAGNUM_SceneTools_DEPENDENCIES MeshTools Trade)
+if(MAGNUM_TARGET_GL)
+    # GL not required by SceneTools themselves, but transitively by MeshTools
+    list(APPEND _MAGNUM_SceneTools_DEPENDENCIES GL)
+endif()
 set(_MAGNUM_Shaders_DEPENDENCIES GL)
 
 set(_MAGNUM_Text_DEPENDENCIES TextureTools)
@@ -887,11 +899,21 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             # No additional dependencies for CGL context
             # No additional dependencies for WGL context
 
-        # Audio library
+        # AnimationTools library
+        elseif(_component STREQUAL AnimationTools)
+            set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Reduce.h)
+
+        # Audio library, BufferStreamer decodes on a background thread
         elseif(_component STREQUAL Audio)
             find_package(OpenAL)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES OpenAL::OpenAL)
+            if(MAGNUM_BUILD_STATIC AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
 
         # No special setup for DebugTools library
 
@@ -927,9 +949,15 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL MaterialTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES PhongToPbrMetallicRoughness.h)
 
-        # MeshTools library
+        # MeshTools library, skinning is done on multiple threads
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
+            if(MAGNUM_BUILD_STATIC AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
 
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
@@ -945,9 +973,15 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
 
         # No special setup for SceneGraph library
 
-        # SceneTools library
+        # SceneTools library, deduplication hashes on multiple threads
         elseif(_component STREQUAL SceneTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Hierarchy.h)
+            if(MAGNUM_BUILD_STATIC AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
 
         # No special setup for ShaderTools library
         # No special setup for Shaders library
@@ -957,7 +991,14 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL TextureTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
 
-        # No special setup for Trade library
+        # Trade library, ParallelImport.cpp spawns threads
+        elseif(_component STREQUAL Trade)
+            if(MAGNUM_BUILD_STATIC AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
 
         # Vk library
         elseif(_component STREQUAL Vk)
@@ -970,10 +1011,14 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnyImageConverter plugin
         # No special setup for AnyImageImporter plugin
         # No special setup for AnySceneImporter plugin
+        # No special setup for CachingImporter plugin
+        # No special setup for CachingShaderConverter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
-        # No special setup for ObjImporter plugin
-        # No special setup for TgaImageConverter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
+        # ObjImporter plugin dependencies are handled below
+        # TgaImageConverter plugin dependencies are handled below
         # No special setup for TgaImporter plugin
         # No special setup for WavAudioImporter plugin
 
@@ -999,6 +1044,15 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             if(NOT _magnum${_component}_BUILD_STATIC EQUAL -1)
                 set_property(TARGET Magnum::${_component} APPEND PROPERTY
                     INTERFACE_SOURCES ${_MAGNUM_${_COMPONENT}_INCLUDE_DIR}/importStaticPlugin.cpp)
+
+                # ObjImporter parses and TgaImageConverter encodes on multiple
+                # threads, which only needs to be propagated if they're static
+                if((_component STREQUAL ObjImporter OR _component STREQUAL TgaImageConverter) AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                    set(THREADS_PREFER_PTHREAD_FLAG TRUE)
+                    find_package(Threads REQUIRED)
+                    set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                        INTERFACE_LINK_LIBRARIES Threads::Threads)
+                endif()
             endif()
         endif()
 
@@ -29,6 +29,7 @@ cmake .. ^
     -DMAGNUM_TARGET_GLES2=%TARGET_GLES2% ^
     -DMAGNUM_TARGET_EGL=OFF ^
     -DMAGNUM_WITH_AUDIO=OFF ^
+    -DMAGNUM_WITH_ANIMATIONTOOLS=OFF ^
     -DMAGNUM_WITH_MATERIALTOOLS=OFF ^
     -DMAGNUM_WITH_SCENETOOLS=OFF ^
     -DMAGNUM_WITH_SHADERTOOLS=OFF ^
@@ -45,6 +46,10 @@ cmake .. ^
     -DMAGNUM_WITH_ANYSHADERCONVERTER=OFF ^
     -DMAGNUM_WITH_MAGNUMFONT=ON ^
     -DMAGNUM_WITH_MAGNUMFONTCONVERTER=ON ^
+    -DMAGNUM_WITH_CACHINGIMPORTER=ON ^
+    -DMAGNUM_WITH_CACHINGSHADERCONVERTER=OFF ^
+    -DMAGNUM_WITH_MAGNUMIMPORTER=ON ^
+    -DMAGNUM_WITH_MAGNUMSCENECONVERTER=ON ^
     -DMAGNUM_WITH_OBJIMPORTER=OFF ^
     -DMAGNUM_WITH_TGAIMAGECONVERTER=ON ^
     -DMAGNUM_WITH_TGAIMPORTER=ON ^
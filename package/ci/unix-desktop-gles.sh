@@ -25,6 +25,7 @@ cmake .. \
     -DMAGNUM_TARGET_GLES=ON \
     -DMAGNUM_TARGET_GLES2=$TARGET_GLES2 \
     -DMAGNUM_WITH_AUDIO=OFF \
+    -DMAGNUM_WITH_ANIMATIONTOOLS=OFF \
     -DMAGNUM_WITH_MATERIALTOOLS=OFF \
     -DMAGNUM_WITH_SCENETOOLS=OFF \
     -DMAGNUM_WITH_SHADERTOOLS=OFF \
@@ -42,6 +43,10 @@ cmake .. \
     -DMAGNUM_WITH_ANYSHADERCONVERTER=OFF \
     -DMAGNUM_WITH_MAGNUMFONT=ON \
     -DMAGNUM_WITH_MAGNUMFONTCONVERTER=ON \
+    -DMAGNUM_WITH_CACHINGIMPORTER=ON \
+    -DMAGNUM_WITH_CACHINGSHADERCONVERTER=OFF \
+    -DMAGNUM_WITH_MAGNUMIMPORTER=ON \
+    -DMAGNUM_WITH_MAGNUMSCENECONVERTER=ON \
     -DMAGNUM_WITH_OBJIMPORTER=OFF \
     -DMAGNUM_WITH_TGAIMAGECONVERTER=ON \
     -DMAGNUM_WITH_TGAIMPORTER=ON \
@@ -0,0 +1,118 @@
+#ifndef Magnum_AnimationTools_Implementation_tracks_h
+#define Magnum_AnimationTools_Implementation_tracks_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace AnimationTools { namespace Implementation {
+
+/* Owned, contiguous copy of a single track that gets assembled into a new
+   AnimationData via combineTracks() once all tracks are processed */
+struct Track {
+    Trade::AnimationTrackTarget targetName;
+    UnsignedLong target;
+    Trade::AnimationTrackType type;
+    Trade::AnimationTrackType resultType;
+    Animation::Interpolation interpolation;
+    void(*interpolator)();
+    Animation::Extrapolation before;
+    Animation::Extrapolation after;
+    Containers::Array<Float> keys;
+    Containers::Array<char> values;
+};
+
+/* Track metadata with empty keys and values */
+inline Track trackMetadata(const Trade::AnimationData& animation, const UnsignedInt id) {
+    const Animation::TrackViewStorage<const Float> track = animation.track(id);
+    return Track{
+        animation.trackTargetName(id),
+        animation.trackTarget(id),
+        animation.trackType(id),
+        animation.trackResultType(id),
+        track.interpolation(),
+        track.interpolator(),
+        track.before(),
+        track.after(),
+        {}, {}};
+}
+
+/* Verbatim copy of a track */
+inline Track copyTrack(const Trade::AnimationData& animation, const UnsignedInt id) {
+    const Animation::TrackViewStorage<const Float> track = animation.track(id);
+    const std::size_t typeSize = Trade::animationTrackTypeSize(animation.trackType(id));
+
+    Track out = trackMetadata(animation, id);
+    out.keys = Containers::Array<Float>{NoInit, track.size()};
+    out.values = Containers::Array<char>{NoInit, track.size()*typeSize};
+    Utility::copy(track.keys(), out.keys);
+    Utility::copy(Containers::arrayCast<2, const char>(track.values(), typeSize),
+        Containers::StridedArrayView2D<char>{out.values, {track.size(), typeSize}});
+    return out;
+}
+
+/* Puts all tracks into a single allocation, aligning each value block to four
+   bytes, which is the largest alignment any AnimationTrackType needs */
+inline Trade::AnimationData combineTracks(const Containers::ArrayView<const Track> tracks, const Range1D& duration, const void* const importerState) {
+    std::size_t dataSize = 0;
+    for(const Track& track: tracks) {
+        dataSize += track.keys.size()*sizeof(Float);
+        dataSize += (track.values.size() + 3) & ~std::size_t{3};
+    }
+
+    Containers::Array<char> data{ValueInit, dataSize};
+    Containers::Array<Trade::AnimationTrackData> trackData{tracks.size()};
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i != tracks.size(); ++i) {
+        const Track& track = tracks[i];
+        const std::size_t count = track.keys.size();
+
+        Containers::ArrayView<Float> keys = Containers::arrayCast<Float>(data.sliceSize(offset, count*sizeof(Float)));
+        Utility::copy(track.keys, keys);
+        offset += keys.size()*sizeof(Float);
+
+        Containers::ArrayView<char> values = data.sliceSize(offset, track.values.size());
+        Utility::copy(track.values, values);
+        offset += (track.values.size() + 3) & ~std::size_t{3};
+
+        trackData[i] = Trade::AnimationTrackData{track.targetName, track.target,
+            track.type, track.resultType, keys,
+            Containers::StridedArrayView1D<const void>{Containers::StridedArrayView1D<const char>{values, count, count ? std::ptrdiff_t(track.values.size()/count) : 0}},
+            track.interpolation, track.interpolator,
+            track.before, track.after};
+    }
+
+    return Trade::AnimationData{Utility::move(data), Utility::move(trackData), duration, importerState};
+}
+
+}}}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Quantize.h"
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/AnimationTools/Implementation/tracks.h"
+
+namespace Magnum { namespace AnimationTools {
+
+UnsignedInt packQuaternionSmallestThree(const Quaternion& rotation) {
+    Vector4 components{rotation.vector(), rotation.scalar()};
+    components /= components.length();
+
+    /* Find the largest component and make it positive, as both q and -q
+       represent the same rotation */
+    std::size_t largest = 0;
+    for(std::size_t i = 1; i != 4; ++i)
+        if(Math::abs(components[i]) > Math::abs(components[largest]))
+            largest = i;
+    if(components[largest] < 0.0f)
+        components = -components;
+
+    /* The remaining three are all in [-1/sqrt(2), 1/sqrt(2)], map that to
+       [0, 1] and then to 10 bits */
+    UnsignedInt packed = UnsignedInt(largest) << 30;
+    UnsignedInt shift = 20;
+    for(std::size_t i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Math::clamp(components[i]*Constants::sqrt2()*0.5f + 0.5f, 0.0f, 1.0f);
+        packed |= UnsignedInt(Math::round(normalized*1023.0f)) << shift;
+        shift -= 10;
+    }
+
+    return packed;
+}
+
+Quaternion unpackQuaternionSmallestThree(const UnsignedInt packed) {
+    const std::size_t largest = packed >> 30;
+
+    Vector4 components;
+    Float sum = 0.0f;
+    UnsignedInt shift = 20;
+    for(std::size_t i = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Float((packed >> shift) & 0x3ff)/1023.0f;
+        components[i] = (normalized*2.0f - 1.0f)*Constants::sqrtHalf();
+        sum += components[i]*components[i];
+        shift -= 10;
+    }
+
+    /* Due to quantization the three components can be slightly over unit
+       length, in which case the result needs to be renormalized */
+    components[largest] = Math::sqrt(Math::max(0.0f, 1.0f - sum));
+    const Quaternion out{components.xyz(), components.w()};
+    return sum > 1.0f ? out.normalized() : out;
+}
+
+Quaternion slerpQuaternionSmallestThree(const UnsignedInt& a, const UnsignedInt& b, const Float t) {
+    return Math::slerpShortestPath(unpackQuaternionSmallestThree(a), unpackQuaternionSmallestThree(b), t);
+}
+
+Quaternion selectQuaternionSmallestThree(const UnsignedInt& a, const UnsignedInt& b, const Float t) {
+    return unpackQuaternionSmallestThree(Math::select(a, b, t));
+}
+
+Vector2ui packVector3Half(const Vector3& value) {
+    const Math::Vector3<UnsignedShort> packed = Math::packHalf(value);
+    return {UnsignedInt(packed.x())|(UnsignedInt(packed.y()) << 16), packed.z()};
+}
+
+Vector3 unpackVector3Half(const Vector2ui& packed) {
+    return Math::unpackHalf(Math::Vector3<UnsignedShort>{
+        UnsignedShort(packed.x() & 0xffff),
+        UnsignedShort(packed.x() >> 16),
+        UnsignedShort(packed.y() & 0xffff)});
+}
+
+Vector3 lerpVector3Half(const Vector2ui& a, const Vector2ui& b, const Float t) {
+    return Math::lerp(unpackVector3Half(a), unpackVector3Half(b), t);
+}
+
+Vector3 selectVector3Half(const Vector2ui& a, const Vector2ui& b, const Float t) {
+    return unpackVector3Half(Math::select(a, b, t));
+}
+
+namespace {
+
+template<class T, class Packed, class R> Implementation::Track quantizeTrack(const Trade::AnimationData& animation, const UnsignedInt id, Packed(*pack)(const T&), R(*linear)(const Packed&, const Packed&, Float), R(*constant)(const Packed&, const Packed&, Float)) {
+    const Animation::TrackView<const Float, const T> track = animation.track<T>(id);
+
+    Implementation::Track out = Implementation::trackMetadata(animation, id);
+    out.type = Trade::Implementation::animationTypeFor<Packed>();
+    out.interpolator = reinterpret_cast<void(*)()>(track.interpolation() == Animation::Interpolation::Linear ? linear : constant);
+    out.keys = Containers::Array<Float>{NoInit, track.size()};
+    out.values = Containers::Array<char>{NoInit, track.size()*sizeof(Packed)};
+    Utility::copy(track.keys(), out.keys);
+    const Containers::ArrayView<Packed> values = Containers::arrayCast<Packed>(out.values);
+    for(std::size_t i = 0; i != track.size(); ++i)
+        values[i] = pack(track.values()[i]);
+
+    return out;
+}
+
+}
+
+Trade::AnimationData quantize(const Trade::AnimationData& animation) {
+    Containers::Array<Implementation::Track> tracks{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        const Animation::TrackViewStorage<const Float> track = animation.track(i);
+
+        /* Only tracks that use the builtin interpolators are converted, as a
+           custom interpolator wouldn't be able to work with the packed
+           data */
+        if(type == animation.trackResultType(i) && (
+            track.interpolation() == Animation::Interpolation::Linear ||
+            track.interpolation() == Animation::Interpolation::Constant))
+        {
+            if(type == Trade::AnimationTrackType::Quaternion && track.interpolator() == reinterpret_cast<void(*)()>(Trade::animationInterpolatorFor<Quaternion>(track.interpolation()))) {
+                tracks[i] = quantizeTrack<Quaternion, UnsignedInt, Quaternion>(animation, i, packQuaternionSmallestThree, slerpQuaternionSmallestThree, selectQuaternionSmallestThree);
+                continue;
+            }
+
+            if(type == Trade::AnimationTrackType::Vector3 && track.interpolator() == reinterpret_cast<void(*)()>(Trade::animationInterpolatorFor<Vector3>(track.interpolation()))) {
+                tracks[i] = quantizeTrack<Vector3, Vector2ui, Vector3>(animation, i, packVector3Half, lerpVector3Half, selectVector3Half);
+                continue;
+            }
+        }
+
+        tracks[i] = Implementation::copyTrack(animation, i);
+    }
+
+    return Implementation::combineTracks(tracks, animation.duration(), animation.importerState());
+}
+
+}}
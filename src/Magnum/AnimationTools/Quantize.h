@@ -0,0 +1,163 @@
+#ifndef Magnum_AnimationTools_Quantize_h
+#define Magnum_AnimationTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::AnimationTools::quantize(), @ref Magnum::AnimationTools::packQuaternionSmallestThree(), @ref Magnum::AnimationTools::unpackQuaternionSmallestThree(), @ref Magnum::AnimationTools::slerpQuaternionSmallestThree(), @ref Magnum::AnimationTools::selectQuaternionSmallestThree(), @ref Magnum::AnimationTools::packVector3Half(), @ref Magnum::AnimationTools::unpackVector3Half(), @ref Magnum::AnimationTools::lerpVector3Half(), @ref Magnum::AnimationTools::selectVector3Half()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/AnimationTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace AnimationTools {
+
+/**
+@brief Pack a quaternion using the smallest three encoding
+@m_since_latest
+
+Normalizes @p rotation, flips its sign so the component with the largest
+absolute value is positive and stores the remaining three components, which
+are guaranteed to be in the @f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$
+range, in 10 bits each. The index of the largest component is stored in the
+top two bits. The largest component is then reconstructed in
+@ref unpackQuaternionSmallestThree() from the unit length requirement. The
+maximal error per component is about @f$ 7 \cdot 10^{-4} @f$.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT UnsignedInt packQuaternionSmallestThree(const Quaternion& rotation);
+
+/**
+@brief Unpack a quaternion from the smallest three encoding
+@m_since_latest
+
+Inverse of @ref packQuaternionSmallestThree(). The returned quaternion is
+always normalized.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Quaternion unpackQuaternionSmallestThree(UnsignedInt packed);
+
+/**
+@brief Linear interpolator for smallest-three-packed quaternions
+@m_since_latest
+
+Calls @ref Math::slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+on the result of @ref unpackQuaternionSmallestThree() applied on @p a and
+@p b. Used by @ref quantize() for @ref Animation::Interpolation::Linear
+quaternion tracks.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Quaternion slerpQuaternionSmallestThree(const UnsignedInt& a, const UnsignedInt& b, Float t);
+
+/**
+@brief Constant interpolator for smallest-three-packed quaternions
+@m_since_latest
+
+Calls @ref unpackQuaternionSmallestThree() on the result of
+@ref Math::select(). Used by @ref quantize() for
+@ref Animation::Interpolation::Constant quaternion tracks.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Quaternion selectQuaternionSmallestThree(const UnsignedInt& a, const UnsignedInt& b, Float t);
+
+/**
+@brief Pack a three-component vector into half-floats
+@m_since_latest
+
+The X and Y component is stored in the lower and upper 16 bits of the first
+component of the output, the Z component in the lower 16 bits of the second
+component. The upper 16 bits of the second component are zero.
+@see @ref Math::packHalf()
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Vector2ui packVector3Half(const Vector3& value);
+
+/**
+@brief Unpack a three-component vector from half-floats
+@m_since_latest
+
+Inverse of @ref packVector3Half().
+@see @ref Math::unpackHalf()
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Vector3 unpackVector3Half(const Vector2ui& packed);
+
+/**
+@brief Linear interpolator for half-float-packed three-component vectors
+@m_since_latest
+
+Calls @ref Math::lerp() on the result of @ref unpackVector3Half() applied on
+@p a and @p b. Used by @ref quantize() for
+@ref Animation::Interpolation::Linear three-component vector tracks.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Vector3 lerpVector3Half(const Vector2ui& a, const Vector2ui& b, Float t);
+
+/**
+@brief Constant interpolator for half-float-packed three-component vectors
+@m_since_latest
+
+Calls @ref unpackVector3Half() on the result of @ref Math::select(). Used by
+@ref quantize() for @ref Animation::Interpolation::Constant three-component
+vector tracks.
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Vector3 selectVector3Half(const Vector2ui& a, const Vector2ui& b, Float t);
+
+/**
+@brief Quantize animation tracks
+@m_since_latest
+
+Returns a copy of @p animation with quaternion and three-component vector
+tracks stored in a compressed form:
+
+-   @ref Trade::AnimationTrackType::Quaternion tracks are packed using
+    @ref packQuaternionSmallestThree() into
+    @ref Trade::AnimationTrackType::UnsignedInt, using a quarter of the
+    original memory, with the result type staying
+    @ref Trade::AnimationTrackType::Quaternion.
+-   @ref Trade::AnimationTrackType::Vector3 tracks, such as translations and
+    scaling, are packed using @ref packVector3Half() into
+    @ref Trade::AnimationTrackType::Vector2ui, using two thirds of the
+    original memory, with the result type staying
+    @ref Trade::AnimationTrackType::Vector3.
+
+Only tracks with @ref Animation::Interpolation::Linear or
+@relativeref{Animation::Interpolation,Constant} that use the default
+interpolator from @ref Trade::animationInterpolatorFor() are converted, the
+interpolator is then replaced with @ref slerpQuaternionSmallestThree(),
+@ref selectQuaternionSmallestThree(), @ref lerpVector3Half() or
+@ref selectVector3Half(). All other tracks, track target names, targets,
+extrapolation and the animation duration are preserved. As the result type
+doesn't change, the output can be passed to @ref Animation::Player the same
+way as the original, just with the typed track accessed as
+@cpp animation.track<UnsignedInt, Quaternion>(i) @ce or
+@cpp animation.track<Vector2ui, Vector3>(i) @ce. The output is always a
+self-contained @ref Trade::AnimationData with all tracks in a single
+allocation.
+
+For best results, run @ref reduceKeyframes() before quantization, as the
+error bound is better evaluated on the original data.
+@see @ref resample()
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Trade::AnimationData quantize(const Trade::AnimationData& animation);
+
+}}
+
+#endif
@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Reduce.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/AnimationTools/Implementation/tracks.h"
+
+namespace Magnum { namespace AnimationTools {
+
+namespace {
+
+/* Max absolute difference of all components */
+inline Float difference(const Float a, const Float b) {
+    return Math::abs(a - b);
+}
+inline Float difference(const Vector2& a, const Vector2& b) {
+    return Math::abs(a - b).max();
+}
+inline Float difference(const Vector3& a, const Vector3& b) {
+    return Math::abs(a - b).max();
+}
+inline Float difference(const Vector4& a, const Vector4& b) {
+    return Math::abs(a - b).max();
+}
+inline Float difference(const Complex& a, const Complex& b) {
+    return Math::max(Math::abs(a.real() - b.real()), Math::abs(a.imaginary() - b.imaginary()));
+}
+inline Float difference(const Quaternion& a, const Quaternion& b) {
+    /* Both q and -q represent the same rotation, pick the closer one */
+    return Math::min(
+        Math::max(Math::abs(a.vector() - b.vector()).max(), Math::abs(a.scalar() - b.scalar())),
+        Math::max(Math::abs(a.vector() + b.vector()).max(), Math::abs(a.scalar() + b.scalar())));
+}
+
+inline void appendKeyframe(Implementation::Track& out, const Float key, const Containers::ArrayView<const char> value) {
+    arrayAppend(out.keys, key);
+    arrayAppend(out.values, value);
+}
+
+template<class T> inline Containers::ArrayView<const char> valueBytes(const T& value) {
+    return {reinterpret_cast<const char*>(&value), sizeof(T)};
+}
+
+template<class T> Implementation::Track reduceTrack(const Trade::AnimationData& animation, const UnsignedInt id, const Float maxError) {
+    const Animation::TrackView<const Float, const T, T> track = animation.track<T, T>(id);
+    const Containers::StridedArrayView1D<const Float> keys = track.keys();
+    const Containers::StridedArrayView1D<const T> values = track.values();
+    const std::size_t count = keys.size();
+
+    Implementation::Track out = Implementation::trackMetadata(animation, id);
+    if(!count) return out;
+    appendKeyframe(out, keys[0], valueBytes(values[0]));
+
+    /* Constant interpolation -- a keyframe can be dropped if it's close enough
+       to the last one that's kept */
+    if(track.interpolation() == Animation::Interpolation::Constant) {
+        std::size_t last = 0;
+        for(std::size_t i = 1; i + 1 < count; ++i) {
+            if(difference(values[i], values[last]) <= maxError) continue;
+            appendKeyframe(out, keys[i], valueBytes(values[i]));
+            last = i;
+        }
+
+    /* Linear interpolation -- greedily extend a segment starting at the
+       last kept keyframe for as long as interpolating across it reproduces
+       all keyframes in between within the error bound. Once that's no longer
+       possible, keep the keyframe before the one that broke it and start a
+       new segment from there. */
+    } else {
+        CORRADE_INTERNAL_ASSERT(track.interpolation() == Animation::Interpolation::Linear);
+        const auto interpolator = track.interpolator();
+        std::size_t anchor = 0;
+        for(std::size_t i = 1; i + 1 < count; ++i) {
+            const std::size_t end = i + 1;
+            const Float span = keys[end] - keys[anchor];
+
+            /* Two keyframes at the same time form a discontinuity, which can't
+               be removed */
+            bool reproduced = span > 0.0f;
+            for(std::size_t j = anchor + 1; reproduced && j != end; ++j) {
+                const T interpolated = interpolator(values[anchor], values[end], (keys[j] - keys[anchor])/span);
+                if(difference(interpolated, values[j]) > maxError)
+                    reproduced = false;
+            }
+            if(reproduced) continue;
+
+            appendKeyframe(out, keys[i], valueBytes(values[i]));
+            anchor = i;
+        }
+    }
+
+    /* The last keyframe is always kept to preserve the duration */
+    if(count > 1)
+        appendKeyframe(out, keys[count - 1], valueBytes(values[count - 1]));
+
+    return out;
+}
+
+/* Constant interpolation of types for which there's no error metric, a
+   keyframe is dropped only if it's the same as the last one that's kept */
+Implementation::Track reduceConstantTrack(const Trade::AnimationData& animation, const UnsignedInt id) {
+    const Animation::TrackViewStorage<const Float> track = animation.track(id);
+    const Containers::StridedArrayView1D<const Float> keys = track.keys();
+    const Containers::StridedArrayView2D<const char> values = Containers::arrayCast<2, const char>(track.values(), Trade::animationTrackTypeSize(animation.trackType(id)));
+    const std::size_t count = keys.size();
+
+    Implementation::Track out = Implementation::trackMetadata(animation, id);
+    if(!count) return out;
+    appendKeyframe(out, keys[0], values[0].asContiguous());
+
+    std::size_t last = 0;
+    for(std::size_t i = 1; i + 1 < count; ++i) {
+        if(std::memcmp(values[i].data(), values[last].data(), values.size()[1]) == 0) continue;
+        appendKeyframe(out, keys[i], values[i].asContiguous());
+        last = i;
+    }
+
+    if(count > 1)
+        appendKeyframe(out, keys[count - 1], values[count - 1].asContiguous());
+
+    return out;
+}
+
+}
+
+Trade::AnimationData reduceKeyframes(const Trade::AnimationData& animation, const Float maxError) {
+    CORRADE_ASSERT(maxError >= 0.0f,
+        "AnimationTools::reduceKeyframes(): expected a non-negative max error but got" << maxError,
+        (Trade::AnimationData{nullptr, nullptr}));
+
+    Containers::Array<Implementation::Track> tracks{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        const Animation::Interpolation interpolation = animation.track(i).interpolation();
+
+        if(type != animation.trackResultType(i) || (
+            interpolation != Animation::Interpolation::Constant &&
+            interpolation != Animation::Interpolation::Linear))
+        {
+            tracks[i] = Implementation::copyTrack(animation, i);
+            continue;
+        }
+
+        switch(type) {
+            #define _c(type_)                                               \
+                case Trade::AnimationTrackType::type_:                      \
+                    tracks[i] = reduceTrack<type_>(animation, i, maxError); \
+                    continue;
+            _c(Float)
+            _c(Vector2)
+            _c(Vector3)
+            _c(Vector4)
+            _c(Complex)
+            _c(Quaternion)
+            #undef _c
+            default: break;
+        }
+
+        tracks[i] = interpolation == Animation::Interpolation::Constant ?
+            reduceConstantTrack(animation, i) :
+            Implementation::copyTrack(animation, i);
+    }
+
+    return Implementation::combineTracks(tracks, animation.duration(), animation.importerState());
+}
+
+}}
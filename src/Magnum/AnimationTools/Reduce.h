@@ -0,0 +1,84 @@
+#ifndef Magnum_AnimationTools_Reduce_h
+#define Magnum_AnimationTools_Reduce_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::AnimationTools::reduceKeyframes()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/AnimationTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace AnimationTools {
+
+/**
+@brief Remove redundant keyframes from an animation
+@m_since_latest
+
+Returns a copy of @p animation with keyframes removed from each track as long
+as the curve interpolated through the remaining keyframes doesn't deviate from
+the original by more than @p maxError in any of the removed keyframes. The
+first and last keyframe of each track is always kept, so track durations and
+extrapolation behavior stay the same. Track target names, targets,
+interpolation, interpolators, extrapolation and the animation duration are
+preserved.
+
+The error is measured as a maximum absolute difference of all components. For
+@ref Trade::AnimationTrackType::Quaternion the difference is taken to the
+closer of @f$ q @f$ and @f$ -q @f$ as both represent the same rotation. The
+following tracks are processed:
+
+-   @ref Animation::Interpolation::Linear tracks of
+    @ref Trade::AnimationTrackType::Float, @relativeref{Trade::AnimationTrackType,Vector2},
+    @relativeref{Trade::AnimationTrackType,Vector3},
+    @relativeref{Trade::AnimationTrackType,Vector4},
+    @relativeref{Trade::AnimationTrackType,Complex} and
+    @relativeref{Trade::AnimationTrackType,Quaternion} types, where the
+    original interpolator is used to evaluate the error. A keyframe is removed
+    if interpolating between the neighboring kept keyframes reproduces it
+    within @p maxError. The reduction is greedy, extending each segment for as
+    long as all keyframes it spans stay within the bound.
+-   @ref Animation::Interpolation::Constant tracks of the above types, where a
+    keyframe is removed if it differs from the previous kept keyframe by at
+    most @p maxError, and tracks of all other non-spline types, where a
+    keyframe is removed if it's bitwise equal to the previous kept keyframe.
+
+Other tracks, in particular @ref Animation::Interpolation::Spline and
+@ref Animation::Interpolation::Custom ones and tracks where the result type
+differs from the value type, are copied unchanged. The output is always a
+self-contained @ref Trade::AnimationData with all tracks in a single
+allocation. Expects that @p maxError is not negative, passing
+@cpp 0.0f @ce removes only keyframes that are exactly reproduced by the
+interpolation.
+@see @ref resample(), @ref quantize()
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Trade::AnimationData reduceKeyframes(const Trade::AnimationData& animation, Float maxError);
+
+}}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Resample.h"
+
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/AnimationTools/Implementation/tracks.h"
+
+namespace Magnum { namespace AnimationTools {
+
+namespace {
+
+template<class V, class R> Implementation::Track resampleTrack(const Trade::AnimationData& animation, const UnsignedInt id, const Float rate) {
+    const Animation::TrackView<const Float, const V, R> track = animation.track<V, R>(id);
+    const Range1D range = track.duration();
+    const std::size_t count = std::size_t(Math::ceil(range.size()*rate)) + 1;
+
+    Implementation::Track out = Implementation::trackMetadata(animation, id);
+    out.type = Trade::Implementation::animationTypeFor<R>();
+    out.keys = Containers::Array<Float>{NoInit, count};
+    out.values = Containers::Array<char>{NoInit, count*sizeof(R)};
+
+    /* If the type changes, which is the case for splines and quantized
+       tracks, the original interpolator can't be used anymore. Use a constant
+       or linear one instead. */
+    if(!std::is_same<V, R>::value) {
+        out.interpolation = track.interpolation() == Animation::Interpolation::Constant ?
+            Animation::Interpolation::Constant :
+            Animation::Interpolation::Linear;
+        out.interpolator = reinterpret_cast<void(*)()>(Trade::animationInterpolatorFor<R, R>(out.interpolation));
+    }
+
+    /* Because the keys are sorted, the hint makes the lookup constant-time */
+    const Containers::ArrayView<R> values = Containers::arrayCast<R>(out.values);
+    std::size_t hint = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        /* Use exactly the original begin and end to preserve the range */
+        const Float key = i == 0 ? range.min() :
+            i == count - 1 ? range.max() :
+            Math::lerp(range.min(), range.max(), Float(i)/(count - 1));
+        out.keys[i] = key;
+        values[i] = track.at(key, hint);
+    }
+
+    return out;
+}
+
+}
+
+Trade::AnimationData resample(const Trade::AnimationData& animation, const Float rate) {
+    CORRADE_ASSERT(rate > 0.0f,
+        "AnimationTools::resample(): expected a positive rate but got" << rate,
+        (Trade::AnimationData{nullptr, nullptr}));
+
+    Containers::Array<Implementation::Track> tracks{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const Trade::AnimationTrackType type = animation.trackType(i);
+        const Trade::AnimationTrackType resultType = animation.trackResultType(i);
+
+        /* Nothing to resample here */
+        if(animation.track(i).size() < 2) {
+            tracks[i] = Implementation::copyTrack(animation, i);
+            continue;
+        }
+
+        switch(type) {
+            #define _cr(type_, typeName, resultType_, resultTypeName)       \
+                case Trade::AnimationTrackType::type_:                      \
+                    if(resultType == Trade::AnimationTrackType::resultType_) { \
+                        tracks[i] = resampleTrack<typeName, resultTypeName>(animation, i, rate); \
+                        continue;                                           \
+                    }                                                       \
+                    break;
+            #define _ct(type_, typeName) _cr(type_, typeName, type_, typeName)
+            #define _c(type_) _ct(type_, type_)
+            _ct(Bool, bool)
+            _c(Float)
+            _c(Int)
+            _c(BitVector2)
+            _c(BitVector3)
+            _c(BitVector4)
+            _c(Vector2)
+            _c(Vector2i)
+            _c(Vector3)
+            _c(Vector3ui)
+            _c(Vector3i)
+            _c(Vector4)
+            _c(Vector4ui)
+            _c(Vector4i)
+            _c(Complex)
+            _c(DualQuaternion)
+            _cr(CubicHermite1D, CubicHermite1D, Float, Float)
+            _cr(CubicHermite2D, CubicHermite2D, Vector2, Vector2)
+            _cr(CubicHermite3D, CubicHermite3D, Vector3, Vector3)
+            _cr(CubicHermiteComplex, CubicHermiteComplex, Complex, Complex)
+            _cr(CubicHermiteQuaternion, CubicHermiteQuaternion, Quaternion, Quaternion)
+            #undef _c
+            #undef _ct
+            #undef _cr
+
+            /* These can be either plain or a storage of quantize() results */
+            case Trade::AnimationTrackType::UnsignedInt:
+                if(resultType == Trade::AnimationTrackType::UnsignedInt) {
+                    tracks[i] = resampleTrack<UnsignedInt, UnsignedInt>(animation, i, rate);
+                    continue;
+                } else if(resultType == Trade::AnimationTrackType::Quaternion) {
+                    tracks[i] = resampleTrack<UnsignedInt, Quaternion>(animation, i, rate);
+                    continue;
+                }
+                break;
+            case Trade::AnimationTrackType::Vector2ui:
+                if(resultType == Trade::AnimationTrackType::Vector2ui) {
+                    tracks[i] = resampleTrack<Vector2ui, Vector2ui>(animation, i, rate);
+                    continue;
+                } else if(resultType == Trade::AnimationTrackType::Vector3) {
+                    tracks[i] = resampleTrack<Vector2ui, Vector3>(animation, i, rate);
+                    continue;
+                }
+                break;
+            case Trade::AnimationTrackType::Quaternion:
+                if(resultType == Trade::AnimationTrackType::Quaternion) {
+                    tracks[i] = resampleTrack<Quaternion, Quaternion>(animation, i, rate);
+                    continue;
+                }
+                break;
+        }
+
+        /* Unknown type combination, keep as-is */
+        tracks[i] = Implementation::copyTrack(animation, i);
+    }
+
+    return Implementation::combineTracks(tracks, animation.duration(), animation.importerState());
+}
+
+}}
@@ -0,0 +1,79 @@
+#ifndef Magnum_AnimationTools_Resample_h
+#define Magnum_AnimationTools_Resample_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::AnimationTools::resample()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/AnimationTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace AnimationTools {
+
+/**
+@brief Resample an animation to a uniform keyframe rate
+@m_since_latest
+
+Returns a copy of @p animation where each track with at least two keyframes is
+sampled at @f$ n = \lceil d r \rceil + 1 @f$ uniformly spaced keys covering
+the same time range @f$ d @f$ as the original track, where @f$ r @f$ is
+@p rate in keyframes per second. The spacing is thus at most @f$ \frac{1}{r} @f$.
+The values are evaluated with the original interpolator, so spline tracks are
+converted to their result type --- for example
+@ref Trade::AnimationTrackType::CubicHermite3D becomes
+@relativeref{Trade::AnimationTrackType,Vector3} --- and the same happens for
+tracks produced by @ref quantize(). Such tracks get
+@ref Animation::Interpolation::Linear, or
+@relativeref{Animation::Interpolation,Constant} if they were constant before,
+with the default interpolator from @ref Trade::animationInterpolatorFor().
+Tracks where the type matches the result type keep their interpolation and
+interpolator. Track target names, targets, extrapolation and the animation
+duration are preserved, tracks with less than two keyframes and tracks with
+type combinations not listed in @ref Trade::AnimationTrackType are copied
+unchanged.
+
+Since the keys are uniformly spaced, a keyframe index for time @f$ t @f$ can
+be calculated directly as
+@f$ \left\lfloor \frac{(t - t_0)(n - 1)}{d} \right\rfloor @f$ without
+searching, and the hint-based
+@ref Animation::TrackView::at(K, std::size_t&) const used by
+@ref Animation::Player needs at most one step from the previous keyframe
+during regular playback. Note that resampling usually increases the keyframe
+count, so it's a tradeoff between lookup speed and memory use.
+
+Expects that @p rate is greater than zero. The output is always a
+self-contained @ref Trade::AnimationData with all tracks in a single
+allocation.
+@see @ref quantize()
+*/
+MAGNUM_ANIMATIONTOOLS_EXPORT Trade::AnimationData resample(const Trade::AnimationData& animation, Float rate);
+
+}}
+
+#endif
@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/AnimationTools/Quantize.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace AnimationTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void packUnpackQuaternion();
+    void packQuaternionNotNormalized();
+    void interpolateQuaternion();
+
+    void packUnpackVector3();
+    void interpolateVector3();
+
+    void quantize();
+};
+
+using namespace Math::Literals;
+
+Vector3 customLerp(const Vector3& a, const Vector3& b, Float t) {
+    return Math::lerp(a, b, t);
+}
+
+const struct {
+    const char* name;
+    Quaternion rotation;
+    UnsignedInt expectedLargest;
+} PackUnpackQuaternionData[]{
+    {"identity", {}, 3},
+    {"X", Quaternion::rotation(170.0_degf, Vector3::xAxis()), 0},
+    {"Y", Quaternion::rotation(-160.0_degf, Vector3::yAxis()), 1},
+    {"Z", Quaternion::rotation(135.0_degf, Vector3::zAxis()), 2},
+    {"arbitrary", Quaternion::rotation(73.0_degf, Vector3{0.3f, -0.5f, 0.8f}.normalized()), 3},
+    {"negative W", -Quaternion::rotation(35.0_degf, Vector3{-1.0f, 1.0f, 0.5f}.normalized()), 3},
+};
+
+QuantizeTest::QuantizeTest() {
+    addInstancedTests({&QuantizeTest::packUnpackQuaternion},
+        Containers::arraySize(PackUnpackQuaternionData));
+
+    addTests({&QuantizeTest::packQuaternionNotNormalized,
+              &QuantizeTest::interpolateQuaternion,
+
+              &QuantizeTest::packUnpackVector3,
+              &QuantizeTest::interpolateVector3,
+
+              &QuantizeTest::quantize});
+}
+
+void QuantizeTest::packUnpackQuaternion() {
+    auto&& data = PackUnpackQuaternionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const UnsignedInt packed = packQuaternionSmallestThree(data.rotation);
+    CORRADE_COMPARE(packed >> 30, data.expectedLargest);
+
+    /* The unpacked quaternion is normalized and represents the same rotation,
+       possibly with a flipped sign */
+    const Quaternion unpacked = unpackQuaternionSmallestThree(packed);
+    CORRADE_VERIFY(unpacked.isNormalized());
+    CORRADE_COMPARE_AS(Math::abs(Math::dot(unpacked, data.rotation)),
+        1.0f - 1.0e-5f,
+        TestSuite::Compare::Greater);
+}
+
+void QuantizeTest::packQuaternionNotNormalized() {
+    const Quaternion rotation = Quaternion::rotation(45.0_degf, Vector3::zAxis());
+    CORRADE_COMPARE(packQuaternionSmallestThree(rotation*3.0f),
+                    packQuaternionSmallestThree(rotation));
+}
+
+void QuantizeTest::interpolateQuaternion() {
+    const Quaternion a = Quaternion::rotation(15.0_degf, Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(75.0_degf, Vector3::xAxis());
+    const UnsignedInt packedA = packQuaternionSmallestThree(a);
+    const UnsignedInt packedB = packQuaternionSmallestThree(b);
+
+    CORRADE_COMPARE_AS(Math::abs(Math::dot(slerpQuaternionSmallestThree(packedA, packedB, 0.5f), Quaternion::rotation(45.0_degf, Vector3::xAxis()))),
+        1.0f - 1.0e-5f,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(selectQuaternionSmallestThree(packedA, packedB, 0.75f), unpackQuaternionSmallestThree(packedA));
+    CORRADE_COMPARE(selectQuaternionSmallestThree(packedA, packedB, 1.0f), unpackQuaternionSmallestThree(packedB));
+}
+
+void QuantizeTest::packUnpackVector3() {
+    const Vector2ui packed = packVector3Half({1.5f, -2.0f, 0.25f});
+    /* 1.5 is 0x3e00, -2.0 is 0xc000, 0.25 is 0x3400 */
+    CORRADE_COMPARE(packed, (Vector2ui{0xc0003e00u, 0x00003400u}));
+    CORRADE_COMPARE(unpackVector3Half(packed), (Vector3{1.5f, -2.0f, 0.25f}));
+}
+
+void QuantizeTest::interpolateVector3() {
+    const Vector2ui a = packVector3Half({1.0f, 2.0f, 3.0f});
+    const Vector2ui b = packVector3Half({3.0f, 4.0f, 5.0f});
+
+    CORRADE_COMPARE(lerpVector3Half(a, b, 0.5f), (Vector3{2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(selectVector3Half(a, b, 0.5f), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(selectVector3Half(a, b, 1.0f), (Vector3{3.0f, 4.0f, 5.0f}));
+}
+
+void QuantizeTest::quantize() {
+    const Float keys[]{0.0f, 1.0f, 2.0f};
+    const Quaternion rotations[]{
+        Quaternion::rotation(0.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(120.0_degf, Vector3::yAxis()),
+    };
+    const Vector3 translations[]{
+        {0.0f, 1.0f, 2.0f},
+        {0.5f, 1.5f, 2.5f},
+        {1.0f, 2.0f, 3.0f}
+    };
+    const Float floats[]{0.0f, 1.0f, 2.0f};
+    int state;
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Rotation3D, 5,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(rotations),
+            Animation::Interpolation::Linear,
+            Animation::Extrapolation::Extrapolated,
+            Animation::Extrapolation::DefaultConstructed},
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Translation3D, 6,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(translations),
+            Animation::Interpolation::Constant},
+        /* Custom interpolator, can't be quantized */
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Scaling3D, 7,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(translations),
+            customLerp},
+        /* Other types are left untouched */
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 8,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(floats),
+            Animation::Interpolation::Linear},
+    }, {-1.0f, 3.0f}, &state};
+
+    Trade::AnimationData quantized = AnimationTools::quantize(animation);
+    CORRADE_COMPARE(quantized.dataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(quantized.duration(), (Range1D{-1.0f, 3.0f}));
+    CORRADE_COMPARE(quantized.importerState(), &state);
+    CORRADE_COMPARE(quantized.trackCount(), 4);
+
+    /* Quaternions are in 32 bits, the result type stays */
+    CORRADE_COMPARE(quantized.trackTargetName(0), Trade::AnimationTrackTarget::Rotation3D);
+    CORRADE_COMPARE(quantized.trackTarget(0), 5);
+    CORRADE_COMPARE(quantized.trackType(0), Trade::AnimationTrackType::UnsignedInt);
+    CORRADE_COMPARE(quantized.trackResultType(0), Trade::AnimationTrackType::Quaternion);
+    {
+        Animation::TrackView<const Float, const UnsignedInt, Quaternion> track = quantized.track<UnsignedInt, Quaternion>(0);
+        CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+        CORRADE_VERIFY(track.interpolator() == slerpQuaternionSmallestThree);
+        CORRADE_COMPARE(track.before(), Animation::Extrapolation::Extrapolated);
+        CORRADE_COMPARE(track.after(), Animation::Extrapolation::DefaultConstructed);
+        CORRADE_COMPARE_AS(track.keys(), Containers::arrayView(keys),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(Math::abs(Math::dot(track.at(0.5f), Quaternion::rotation(30.0_degf, Vector3::yAxis()))),
+            1.0f - 1.0e-5f,
+            TestSuite::Compare::Greater);
+    }
+
+    /* Vector3 is in three halves, the result type stays */
+    CORRADE_COMPARE(quantized.trackTargetName(1), Trade::AnimationTrackTarget::Translation3D);
+    CORRADE_COMPARE(quantized.trackType(1), Trade::AnimationTrackType::Vector2ui);
+    CORRADE_COMPARE(quantized.trackResultType(1), Trade::AnimationTrackType::Vector3);
+    {
+        Animation::TrackView<const Float, const Vector2ui, Vector3> track = quantized.track<Vector2ui, Vector3>(1);
+        CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Constant);
+        CORRADE_VERIFY(track.interpolator() == selectVector3Half);
+        CORRADE_COMPARE(track.at(0.5f), (Vector3{0.0f, 1.0f, 2.0f}));
+        CORRADE_COMPARE(track.at(1.5f), (Vector3{0.5f, 1.5f, 2.5f}));
+    }
+
+    CORRADE_COMPARE(quantized.trackType(2), Trade::AnimationTrackType::Vector3);
+    CORRADE_COMPARE(quantized.trackResultType(2), Trade::AnimationTrackType::Vector3);
+    CORRADE_COMPARE(quantized.track(2).interpolation(), Animation::Interpolation::Custom);
+
+    CORRADE_COMPARE(quantized.trackType(3), Trade::AnimationTrackType::Float);
+    CORRADE_COMPARE_AS(quantized.track<Float>(3).values(), Containers::arrayView(floats),
+        TestSuite::Compare::Container);
+
+    /* 3 keys for each track, 3 packed quaternions, 2x3 vectors in 64 bits,
+       3 vectors and 3 floats */
+    CORRADE_COMPARE(quantized.data().size(), 4*3*4 + 3*4 + 3*8 + 3*12 + 3*4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::AnimationTools::Test::QuantizeTest)
@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/AnimationTools/Reduce.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace AnimationTools { namespace Test { namespace {
+
+struct ReduceTest: TestSuite::Tester {
+    explicit ReduceTest();
+
+    void linear();
+    void linearErrorBound();
+    void linearQuaternion();
+    void constant();
+    void constantNoErrorMetric();
+    void unchanged();
+    void empty();
+
+    void negativeError();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Float maxError;
+    std::size_t expectedCount;
+} LinearErrorBoundData[]{
+    {"exact", 0.0f, 4},
+    {"too small", 0.01f, 4},
+    {"large enough", 0.1f, 2},
+};
+
+ReduceTest::ReduceTest() {
+    addTests({&ReduceTest::linear});
+
+    addInstancedTests({&ReduceTest::linearErrorBound},
+        Containers::arraySize(LinearErrorBoundData));
+
+    addTests({&ReduceTest::linearQuaternion,
+              &ReduceTest::constant,
+              &ReduceTest::constantNoErrorMetric,
+              &ReduceTest::unchanged,
+              &ReduceTest::empty,
+
+              &ReduceTest::negativeError});
+}
+
+void ReduceTest::linear() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const Vector2 values[]{
+        {0.0f, 1.0f},
+        {1.0f, 1.0f},
+        {2.0f, 1.0f},
+        {3.0f, 1.0f},
+        {3.0f, 1.5f},
+        {3.0f, 2.0f},
+    };
+    int state;
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Translation2D, 17,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear,
+            Animation::Extrapolation::Extrapolated,
+            Animation::Extrapolation::DefaultConstructed}
+    }, {-1.0f, 7.0f}, &state};
+
+    Trade::AnimationData reduced = reduceKeyframes(animation, 1.0e-5f);
+    CORRADE_COMPARE(reduced.dataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(reduced.duration(), (Range1D{-1.0f, 7.0f}));
+    CORRADE_COMPARE(reduced.importerState(), &state);
+    CORRADE_COMPARE(reduced.trackCount(), 1);
+    CORRADE_COMPARE(reduced.trackTargetName(0), Trade::AnimationTrackTarget::Translation2D);
+    CORRADE_COMPARE(reduced.trackTarget(0), 17);
+    CORRADE_COMPARE(reduced.trackType(0), Trade::AnimationTrackType::Vector2);
+    CORRADE_COMPARE(reduced.trackResultType(0), Trade::AnimationTrackType::Vector2);
+
+    /* The keyframes on a straight line get removed, the corner stays */
+    Animation::TrackView<const Float, const Vector2> track = reduced.track<Vector2>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(track.before(), Animation::Extrapolation::Extrapolated);
+    CORRADE_COMPARE(track.after(), Animation::Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 3.0f, 5.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f},
+        {3.0f, 1.0f},
+        {3.0f, 2.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Interpolating the reduced track gives the same result */
+    CORRADE_COMPARE(track.at(1.5f), (Vector2{1.5f, 1.0f}));
+    CORRADE_COMPARE(track.at(4.5f), (Vector2{3.0f, 1.75f}));
+}
+
+void ReduceTest::linearErrorBound() {
+    auto&& data = LinearErrorBoundData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const Float values[]{0.0f, 1.05f, 2.0f, 3.0f};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear}
+    }};
+
+    Trade::AnimationData reduced = reduceKeyframes(animation, data.maxError);
+    CORRADE_COMPARE(reduced.trackCount(), 1);
+    Animation::TrackView<const Float, const Float> track = reduced.track<Float>(0);
+    CORRADE_COMPARE(track.size(), data.expectedCount);
+    CORRADE_COMPARE(track.keys().front(), 0.0f);
+    CORRADE_COMPARE(track.keys().back(), 3.0f);
+}
+
+void ReduceTest::linearQuaternion() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::zAxis()),
+        /* Both q and -q are the same rotation, so this should get removed
+           as well */
+        -Quaternion::rotation(30.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::xAxis()),
+    };
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Rotation3D, 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear}
+    }};
+
+    Trade::AnimationData reduced = reduceKeyframes(animation, 1.0e-5f);
+    CORRADE_COMPARE(reduced.trackCount(), 1);
+    Animation::TrackView<const Float, const Quaternion> track = reduced.track<Quaternion>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 2.0f, 3.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(track.at(1.0f), Quaternion::rotation(30.0_degf, Vector3::zAxis()));
+}
+
+void ReduceTest::constant() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Vector3 values[]{
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.05f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {4.0f, 5.0f, 6.0f},
+        {4.0f, 5.0f, 6.0f},
+    };
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Scaling3D, 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Constant}
+    }};
+
+    /* The last keyframe is kept even though it's the same to preserve the
+       track duration */
+    Trade::AnimationData reduced = reduceKeyframes(animation, 0.1f);
+    CORRADE_COMPARE(reduced.trackCount(), 1);
+    Animation::TrackView<const Float, const Vector3> track = reduced.track<Vector3>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Constant);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 2.0f, 4.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {4.0f, 5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ReduceTest::constantNoErrorMetric() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Int values[]{1, 1, 2, 3, 3};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Constant}
+    }};
+
+    /* The error doesn't apply to integer types, only the exact duplicates get
+       removed */
+    Trade::AnimationData reduced = reduceKeyframes(animation, 10.0f);
+    CORRADE_COMPARE(reduced.trackCount(), 1);
+    Animation::TrackView<const Float, const Int> track = reduced.track<Int>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 2.0f, 3.0f, 4.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView({
+        1, 2, 3, 3
+    }), TestSuite::Compare::Container);
+}
+
+void ReduceTest::unchanged() {
+    const Float keys[]{0.0f, 1.0f, 2.0f};
+    const CubicHermite1D splineValues[]{
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const Float values[]{1.0f, 1.0f, 1.0f};
+    Trade::AnimationData animation{{}, nullptr, {
+        /* Spline interpolation */
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(splineValues),
+            Animation::Interpolation::Spline},
+        /* Custom interpolation */
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(1), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Math::lerp}
+    }};
+
+    Trade::AnimationData reduced = reduceKeyframes(animation, 1.0f);
+    CORRADE_COMPARE(reduced.trackCount(), 2);
+
+    CORRADE_COMPARE(reduced.trackType(0), Trade::AnimationTrackType::CubicHermite1D);
+    CORRADE_COMPARE(reduced.trackResultType(0), Trade::AnimationTrackType::Float);
+    CORRADE_COMPARE(reduced.track(0).interpolation(), Animation::Interpolation::Spline);
+    CORRADE_COMPARE(reduced.track(0).size(), 3);
+
+    CORRADE_COMPARE(reduced.trackType(1), Trade::AnimationTrackType::Float);
+    CORRADE_COMPARE(reduced.track(1).interpolation(), Animation::Interpolation::Custom);
+    CORRADE_COMPARE_AS(reduced.track<Float>(1).values(), Containers::arrayView({
+        1.0f, 1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ReduceTest::empty() {
+    const Float keys[]{5.0f};
+    const Float values[]{3.0f};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys).prefix(0),
+            Containers::stridedArrayView(values).prefix(0),
+            Animation::Interpolation::Linear},
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(1), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear}
+    }};
+
+    Trade::AnimationData reduced = reduceKeyframes(animation, 0.0f);
+    CORRADE_COMPARE(reduced.trackCount(), 2);
+    CORRADE_COMPARE(reduced.track(0).size(), 0);
+    CORRADE_COMPARE(reduced.track(1).size(), 1);
+    CORRADE_COMPARE(reduced.track<Float>(1).keys()[0], 5.0f);
+    CORRADE_COMPARE(reduced.track<Float>(1).values()[0], 3.0f);
+}
+
+void ReduceTest::negativeError() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::AnimationData animation{nullptr, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reduceKeyframes(animation, -0.5f);
+    CORRADE_COMPARE(out.str(), "AnimationTools::reduceKeyframes(): expected a non-negative max error but got -0.5\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::AnimationTools::Test::ReduceTest)
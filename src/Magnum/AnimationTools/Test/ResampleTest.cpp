@@ -0,0 +1,234 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/AnimationTools/Quantize.h"
+#include "Magnum/AnimationTools/Resample.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace AnimationTools { namespace Test { namespace {
+
+struct ResampleTest: TestSuite::Tester {
+    explicit ResampleTest();
+
+    void linear();
+    void nonIntegerRate();
+    void constant();
+    void spline();
+    void quantized();
+    void singleKeyframe();
+
+    void invalidRate();
+};
+
+using namespace Math::Literals;
+
+ResampleTest::ResampleTest() {
+    addTests({&ResampleTest::linear,
+              &ResampleTest::nonIntegerRate,
+              &ResampleTest::constant,
+              &ResampleTest::spline,
+              &ResampleTest::quantized,
+              &ResampleTest::singleKeyframe,
+
+              &ResampleTest::invalidRate});
+}
+
+void ResampleTest::linear() {
+    const Float keys[]{0.0f, 1.0f, 2.5f};
+    const Float values[]{0.0f, 2.0f, 5.0f};
+    int state;
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(3), 17,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear,
+            Animation::Extrapolation::Extrapolated,
+            Animation::Extrapolation::DefaultConstructed}
+    }, {-1.0f, 7.0f}, &state};
+
+    Trade::AnimationData resampled = resample(animation, 2.0f);
+    CORRADE_COMPARE(resampled.dataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{-1.0f, 7.0f}));
+    CORRADE_COMPARE(resampled.importerState(), &state);
+    CORRADE_COMPARE(resampled.trackCount(), 1);
+    CORRADE_COMPARE(resampled.trackTargetName(0), Trade::animationTrackTargetCustom(3));
+    CORRADE_COMPARE(resampled.trackTarget(0), 17);
+    CORRADE_COMPARE(resampled.trackType(0), Trade::AnimationTrackType::Float);
+    CORRADE_COMPARE(resampled.trackResultType(0), Trade::AnimationTrackType::Float);
+
+    Animation::TrackView<const Float, const Float> track = resampled.track<Float>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(track.before(), Animation::Extrapolation::Extrapolated);
+    CORRADE_COMPARE(track.after(), Animation::Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView({
+        0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ResampleTest::nonIntegerRate() {
+    const Float keys[]{1.0f, 2.0f};
+    const Vector2 values[]{{0.0f, 3.0f}, {3.0f, 0.0f}};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Translation2D, 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear}
+    }};
+
+    /* 2.5 keyframes per second is rounded up to 3 intervals, the begin and
+       end stays the same */
+    Trade::AnimationData resampled = resample(animation, 2.5f);
+    Animation::TrackView<const Float, const Vector2> track = resampled.track<Vector2>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        1.0f, 4.0f/3.0f, 5.0f/3.0f, 2.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector2>({
+        {0.0f, 3.0f},
+        {1.0f, 2.0f},
+        {2.0f, 1.0f},
+        {3.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ResampleTest::constant() {
+    const Float keys[]{0.0f, 0.5f, 1.0f};
+    const bool values[]{false, true, false};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Constant}
+    }};
+
+    Trade::AnimationData resampled = resample(animation, 4.0f);
+    CORRADE_COMPARE(resampled.trackType(0), Trade::AnimationTrackType::Bool);
+    Animation::TrackView<const Float, const bool> track = resampled.track<bool>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Constant);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 0.25f, 0.5f, 0.75f, 1.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView({
+        false, false, true, true, false
+    }), TestSuite::Compare::Container);
+}
+
+void ResampleTest::spline() {
+    const Float keys[]{0.0f, 1.0f};
+    /* Tangents matching the slope, so the spline is a straight line */
+    const CubicHermite1D values[]{
+        {1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Spline}
+    }};
+
+    /* The spline gets evaluated into its result type, interpolated linearly */
+    Trade::AnimationData resampled = resample(animation, 4.0f);
+    CORRADE_COMPARE(resampled.trackType(0), Trade::AnimationTrackType::Float);
+    CORRADE_COMPARE(resampled.trackResultType(0), Trade::AnimationTrackType::Float);
+    Animation::TrackView<const Float, const Float> track = resampled.track<Float>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_VERIFY(track.interpolator() == Trade::animationInterpolatorFor<Float>(Animation::Interpolation::Linear));
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        0.0f, 0.25f, 0.5f, 0.75f, 1.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView({
+        0.0f, 0.25f, 0.5f, 0.75f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ResampleTest::quantized() {
+    const Float keys[]{0.0f, 1.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::yAxis())
+    };
+    Trade::AnimationData animation = quantize(Trade::AnimationData{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::AnimationTrackTarget::Rotation3D, 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Linear}
+    }});
+    CORRADE_COMPARE(animation.trackType(0), Trade::AnimationTrackType::UnsignedInt);
+
+    /* The packed values are unpacked back into the result type */
+    Trade::AnimationData resampled = resample(animation, 2.0f);
+    CORRADE_COMPARE(resampled.trackType(0), Trade::AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(resampled.trackResultType(0), Trade::AnimationTrackType::Quaternion);
+    Animation::TrackView<const Float, const Quaternion> track = resampled.track<Quaternion>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(track.size(), 3);
+    CORRADE_COMPARE_AS((track.values()[1] - Quaternion::rotation(45.0_degf, Vector3::yAxis())).length(),
+        1.0e-3f,
+        TestSuite::Compare::Less);
+}
+
+void ResampleTest::singleKeyframe() {
+    const Float keys[]{2.0f};
+    const CubicHermite1D values[]{{0.0f, 3.0f, 0.0f}};
+    Trade::AnimationData animation{{}, nullptr, {
+        Trade::AnimationTrackData{Trade::animationTrackTargetCustom(0), 0,
+            Containers::stridedArrayView(keys),
+            Containers::stridedArrayView(values),
+            Animation::Interpolation::Spline}
+    }};
+
+    /* There's nothing to resample, the track is copied as-is */
+    Trade::AnimationData resampled = resample(animation, 60.0f);
+    CORRADE_COMPARE(resampled.trackType(0), Trade::AnimationTrackType::CubicHermite1D);
+    CORRADE_COMPARE(resampled.track(0).interpolation(), Animation::Interpolation::Spline);
+    CORRADE_COMPARE(resampled.track(0).size(), 1);
+    CORRADE_COMPARE(resampled.track<CubicHermite1D>(0).values()[0].point(), 3.0f);
+}
+
+void ResampleTest::invalidRate() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::AnimationData animation{nullptr, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resample(animation, 0.0f);
+    CORRADE_COMPARE(out.str(), "AnimationTools::resample(): expected a positive rate but got 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::AnimationTools::Test::ResampleTest)
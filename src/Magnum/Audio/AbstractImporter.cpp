@@ -140,6 +140,48 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+std::size_t AbstractImporter::dataSize() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Stream,
+        "Audio::AbstractImporter::dataSize(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::dataSize(): no file opened", {});
+    return doDataSize();
+}
+
+std::size_t AbstractImporter::doDataSize() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::dataSize(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::read(const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(features() & ImporterFeature::Stream,
+        "Audio::AbstractImporter::read(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::read(): no file opened", {});
+
+    const std::size_t size = doRead(data);
+    CORRADE_ASSERT(size <= data.size(),
+        "Audio::AbstractImporter::read(): implementation returned" << size << "bytes for a" << data.size() << Debug::nospace << "-byte view", {});
+    return size;
+}
+
+std::size_t AbstractImporter::doRead(Containers::ArrayView<char>) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::read(): feature advertised but not implemented", {});
+}
+
+bool AbstractImporter::seek(const std::size_t offset) {
+    CORRADE_ASSERT(features() & ImporterFeature::Stream,
+        "Audio::AbstractImporter::seek(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t size = doDataSize();
+    #endif
+    CORRADE_ASSERT(offset <= size,
+        "Audio::AbstractImporter::seek(): offset" << offset << "out of range for" << size << "bytes", {});
+    return doSeek(offset);
+}
+
+bool AbstractImporter::doSeek(std::size_t) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::seek(): feature advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
 
@@ -150,6 +192,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFeature::v: return debug << (packed ? "" : "::") << Debug::nospace << #v;
         _c(OpenData)
+        _c(Stream)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -159,7 +202,8 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
 
 Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "Audio::ImporterFeatures{}", {
-        ImporterFeature::OpenData});
+        ImporterFeature::OpenData,
+        ImporterFeature::Stream});
 }
 
 }}
@@ -45,7 +45,14 @@ namespace Magnum { namespace Audio {
 */
 enum class ImporterFeature: UnsignedByte {
     /** Opening files from raw data using @ref AbstractImporter::openData() */
-    OpenData = 1 << 0
+    OpenData = 1 << 0,
+
+    /**
+     * Incremental decoding using @ref AbstractImporter::read() and
+     * @ref AbstractImporter::seek()
+     * @m_since_latest
+     */
+    Stream = 1 << 1
 };
 
 /**
@@ -106,6 +113,11 @@ checked by the implementation:
     deleter, otherwise this could cause dangling function pointer call on array
     destruction if the plugin gets unloaded before the array is destroyed. This
     is asserted by the base implementation on return.
+
+If @ref ImporterFeature::Stream is supported, the plugin additionally
+implements @ref doDataSize(), @ref doRead() and @ref doSeek(). These are
+called only if the feature is supported and there is a file opened, the
+@p offset passed to @ref doSeek() is checked to be in bounds.
 */
 class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlugin<AbstractImporter> {
     public:
@@ -200,6 +212,51 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Decoded sample data size
+         * @m_since_latest
+         *
+         * Size of the whole decoded sample data in bytes, i.e. the same as
+         * size of the array returned by @ref data(). Available only if
+         * @ref ImporterFeature::Stream is supported.
+         * @see @ref features(), @ref read(), @ref seek()
+         */
+        std::size_t dataSize() const;
+
+        /**
+         * @brief Decode next part of sample data
+         * @m_since_latest
+         *
+         * Decodes sample data at the current position into @p data and
+         * advances the position past them. Returns count of bytes written,
+         * which is always a whole number of sample frames and is less than
+         * @cpp data.size() @ce only when the end of the data was reached.
+         * Returns @cpp 0 @ce at the end of the data or if @p data is smaller
+         * than a single sample frame. Available only if
+         * @ref ImporterFeature::Stream is supported.
+         *
+         * Unlike @ref data(), which needs the whole decoded data to be in
+         * memory at once, this allows to decode arbitrarily long clips
+         * using a fixed amount of memory. See @ref BufferStreamer for a way
+         * to play the data through a @ref Source while they're being decoded.
+         * @see @ref features(), @ref seek(), @ref dataSize()
+         */
+        std::size_t read(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Seek to given position in sample data
+         * @m_since_latest
+         *
+         * The @p offset is in bytes of decoded data and is expected to not
+         * be larger than @ref dataSize(). If it's not a multiple of the sample
+         * frame size, the implementation rounds it down. A subsequent
+         * @ref read() continues from given position. On failure prints a
+         * message to @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * Available only if @ref ImporterFeature::Stream is supported.
+         * @see @ref features()
+         */
+        bool seek(std::size_t offset);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -236,6 +293,24 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref dataSize()
+         * @m_since_latest
+         */
+        virtual std::size_t doDataSize() const;
+
+        /**
+         * @brief Implementation for @ref read()
+         * @m_since_latest
+         */
+        virtual std::size_t doRead(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Implementation for @ref seek()
+         * @m_since_latest
+         */
+        virtual bool doSeek(std::size_t offset);
 };
 
 /**
@@ -256,7 +331,7 @@ updated interface string.
 */
 /* Silly indentation to make the string appear in pluginInterface() docs */
 #define MAGNUM_AUDIO_ABSTRACTIMPORTER_PLUGIN_INTERFACE /* [interface] */ \
-"cz.mosra.magnum.Audio.AbstractImporter/0.1"
+"cz.mosra.magnum.Audio.AbstractImporter/0.2"
 /* [interface] */
 
 }}
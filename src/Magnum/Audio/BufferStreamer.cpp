@@ -0,0 +1,344 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BufferStreamer.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+#ifdef MAGNUM_IMPLEMENTATION_THREADS
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+struct Block {
+    Containers::Array<char> data;
+    std::size_t size;
+};
+
+/* Size of a single sample frame in bytes. AbstractImporter::read() returns
+   only whole frames, so the blocks have to be a multiple of it. */
+std::size_t frameSize(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::MonoALaw:
+        case BufferFormat::MonoMuLaw:
+            return 1;
+        case BufferFormat::Mono16:
+        case BufferFormat::Stereo8:
+        case BufferFormat::StereoALaw:
+        case BufferFormat::StereoMuLaw:
+        case BufferFormat::Rear8:
+            return 2;
+        case BufferFormat::Stereo16:
+        case BufferFormat::MonoFloat:
+        case BufferFormat::Quad8:
+        case BufferFormat::Rear16:
+            return 4;
+        case BufferFormat::Surround51Channel8:
+            return 6;
+        case BufferFormat::Surround61Channel8:
+            return 7;
+        case BufferFormat::StereoFloat:
+        case BufferFormat::MonoDouble:
+        case BufferFormat::Quad16:
+        case BufferFormat::Rear32:
+        case BufferFormat::Surround71Channel8:
+            return 8;
+        case BufferFormat::Surround51Channel16:
+            return 12;
+        case BufferFormat::Surround61Channel16:
+            return 14;
+        case BufferFormat::StereoDouble:
+        case BufferFormat::Quad32:
+        case BufferFormat::Surround71Channel16:
+            return 16;
+        case BufferFormat::Surround51Channel32:
+            return 24;
+        case BufferFormat::Surround61Channel32:
+            return 28;
+        case BufferFormat::Surround71Channel32:
+            return 32;
+    }
+
+    /* Unknown formats are treated as having no frame alignment */
+    return 1;
+}
+
+}
+
+struct BufferStreamer::State {
+    explicit State(AbstractImporter& importer, Source& source): importer(importer), source(source) {}
+
+    /* Decodes the next block, returns false if the end was reached. Called
+       with the block exclusively owned by the caller. */
+    bool decode(Block& block, bool looping);
+
+    /* Queued buffers in the order they were queued */
+    Containers::Array<Containers::Reference<Buffer>> queuedBuffers();
+
+    AbstractImporter& importer;
+    Source& source;
+    BufferFormat format;
+    UnsignedInt frequency;
+
+    /* Blocks with decoded data and their count, decoder fills them at
+       decodeIndex, update() consumes them at uploadIndex */
+    Containers::Array<Block> blocks;
+    std::size_t decodeIndex{}, uploadIndex{}, decodedCount{};
+    bool looping{}, decodedAll{}, quit{};
+
+    /* Buffers in a ring, the first queuedCount from queuedIndex are queued to
+       the source in the order they were queued */
+    Containers::Array<Buffer> buffers;
+    std::size_t queuedIndex{}, queuedCount{};
+
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    /* Guards all block bookkeeping above, the block data itself is owned by
+       whoever is on the other side of decodedCount */
+    mutable std::mutex mutex;
+    std::condition_variable decodeCondition;
+    std::thread thread;
+    #endif
+};
+
+bool BufferStreamer::State::decode(Block& block, const bool looping) {
+    /* Only a read that returns nothing means the end was reached, so keep
+       reading until the block is full. As the block size is a whole number
+       of frames, there's always space for at least one more frame. */
+    block.size = 0;
+    bool rewound = false;
+    while(block.size < block.data.size()) {
+        if(const std::size_t size = importer.read(block.data.exceptPrefix(block.size))) {
+            block.size += size;
+            rewound = false;
+            continue;
+        }
+
+        /* At the end, continue from the beginning if looping, repeating the
+           clip until the block is full if it's shorter. Stop if nothing can
+           be read even right after rewinding to avoid spinning on empty or
+           broken files. */
+        if(!looping || rewound || !importer.seek(0)) return false;
+        rewound = true;
+    }
+    return true;
+}
+
+Containers::Array<Containers::Reference<Buffer>> BufferStreamer::State::queuedBuffers() {
+    Containers::Array<Containers::Reference<Buffer>> out{NoInit, queuedCount};
+    for(std::size_t i = 0; i != queuedCount; ++i)
+        new(&out[i]) Containers::Reference<Buffer>{buffers[(queuedIndex + i) % buffers.size()]};
+    return out;
+}
+
+BufferStreamer::BufferStreamer(AbstractImporter& importer, Source& source, const UnsignedInt bufferCount, const std::size_t bufferSize): _state{InPlaceInit, importer, source} {
+    CORRADE_ASSERT(importer.features() & ImporterFeature::Stream,
+        "Audio::BufferStreamer: the importer doesn't support streaming", );
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::BufferStreamer: no file opened", );
+    CORRADE_ASSERT(bufferCount && bufferSize,
+        "Audio::BufferStreamer: expected non-zero buffer count and size but got" << bufferCount << "and" << bufferSize, );
+
+    State& state = *_state;
+    state.format = importer.format();
+    state.frequency = importer.frequency();
+
+    /* The blocks have to contain only whole frames, otherwise the importer
+       returns less than the block size and the space after can't be filled
+       with anything */
+    const std::size_t formatFrameSize = frameSize(state.format);
+    const std::size_t blockSize = bufferSize/formatFrameSize*formatFrameSize;
+    CORRADE_ASSERT(blockSize,
+        "Audio::BufferStreamer: buffer size" << bufferSize << "is smaller than a single sample frame of" << formatFrameSize << "bytes", );
+
+    state.blocks = Containers::Array<Block>{bufferCount};
+    for(Block& block: state.blocks)
+        block.data = Containers::Array<char>{NoInit, blockSize};
+    state.buffers = Containers::Array<Buffer>{bufferCount};
+
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    state.thread = std::thread{[&state]() {
+        for(;;) {
+            bool looping;
+            {
+                std::unique_lock<std::mutex> lock{state.mutex};
+                state.decodeCondition.wait(lock, [&state]() {
+                    return state.quit || (!state.decodedAll && state.decodedCount < state.blocks.size());
+                });
+                if(state.quit) return;
+                looping = state.looping;
+            }
+
+            /* The block at decodeIndex isn't touched by update() until
+               decodedCount gets incremented, so it can be filled without
+               holding the lock */
+            Block& block = state.blocks[state.decodeIndex];
+            const bool more = state.decode(block, looping);
+
+            std::lock_guard<std::mutex> lock{state.mutex};
+            state.decodeIndex = (state.decodeIndex + 1) % state.blocks.size();
+            ++state.decodedCount;
+            if(!more) state.decodedAll = true;
+        }
+    }};
+    #endif
+}
+
+BufferStreamer::~BufferStreamer() {
+    /* The asserts in the constructor might have failed */
+    if(_state->buffers.isEmpty()) return;
+
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->quit = true;
+    }
+    _state->decodeCondition.notify_one();
+    _state->thread.join();
+    #endif
+
+    /* Buffers can't be deleted while they're queued. After stopping, all
+       queued buffers are marked as processed so they can be unqueued. */
+    if(_state->queuedCount) {
+        _state->source.stop();
+        Containers::Array<Containers::Reference<Buffer>> queued = _state->queuedBuffers();
+        _state->source.unqueueBuffers(queued);
+    }
+}
+
+AbstractImporter& BufferStreamer::importer() { return _state->importer; }
+
+Source& BufferStreamer::source() { return _state->source; }
+
+bool BufferStreamer::isLooping() const {
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    return _state->looping;
+}
+
+BufferStreamer& BufferStreamer::setLooping(const bool looping) {
+    {
+        #ifdef MAGNUM_IMPLEMENTATION_THREADS
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        #endif
+        _state->looping = looping;
+        /* If the decoder already reached the end, make it continue from the
+           beginning */
+        if(looping) _state->decodedAll = false;
+    }
+    /* Wake up the decoder in case it's waiting because it reached the end */
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    _state->decodeCondition.notify_one();
+    #endif
+    return *this;
+}
+
+bool BufferStreamer::isFinished() const {
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+    return _state->decodedAll && !_state->decodedCount && !_state->queuedCount;
+}
+
+std::size_t BufferStreamer::update() {
+    State& state = *_state;
+    const std::size_t bufferCount = state.buffers.size();
+
+    /* Unqueue buffers the source finished playing. OpenAL always processes
+       the queue in order, so the unqueued buffers are the oldest ones. The
+       view gets reordered by the call, so it has to be a temporary copy. */
+    if(state.queuedCount) {
+        Containers::Array<Containers::Reference<Buffer>> queued = state.queuedBuffers();
+        const std::size_t unqueuedCount = state.source.unqueueBuffers(queued);
+        state.queuedIndex = (state.queuedIndex + unqueuedCount) % bufferCount;
+        state.queuedCount -= unqueuedCount;
+    }
+
+    /* Fill the free buffers with decoded blocks */
+    Containers::Array<Containers::Reference<Buffer>> toQueue{NoInit, bufferCount - state.queuedCount};
+    std::size_t toQueueCount = 0;
+    while(state.queuedCount + toQueueCount < bufferCount) {
+        #ifdef MAGNUM_IMPLEMENTATION_THREADS
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            if(!state.decodedCount) break;
+        }
+        #else
+        /* No thread, decode the next block directly */
+        if(!state.decodedCount) {
+            if(state.decodedAll) break;
+            if(!state.decode(state.blocks[state.decodeIndex], state.looping))
+                state.decodedAll = true;
+            state.decodeIndex = (state.decodeIndex + 1) % state.blocks.size();
+            ++state.decodedCount;
+        }
+        #endif
+
+        /* The block at uploadIndex isn't touched by the decoder until
+           decodedCount gets decremented, so it can be uploaded without
+           holding the lock. The last block may be empty if the data size was
+           a multiple of the block size, don't queue such. */
+        const Block& block = state.blocks[state.uploadIndex];
+        if(block.size) {
+            Buffer& buffer = state.buffers[(state.queuedIndex + state.queuedCount + toQueueCount) % bufferCount];
+            buffer.setData(state.format, block.data.prefix(block.size), state.frequency);
+            new(&toQueue[toQueueCount++]) Containers::Reference<Buffer>{buffer};
+        }
+
+        {
+            #ifdef MAGNUM_IMPLEMENTATION_THREADS
+            std::lock_guard<std::mutex> lock{state.mutex};
+            #endif
+            state.uploadIndex = (state.uploadIndex + 1) % state.blocks.size();
+            --state.decodedCount;
+        }
+        #ifdef MAGNUM_IMPLEMENTATION_THREADS
+        state.decodeCondition.notify_one();
+        #endif
+    }
+
+    if(toQueueCount) {
+        state.source.queueBuffers(toQueue.prefix(toQueueCount));
+        state.queuedCount += toQueueCount;
+    }
+
+    return toQueueCount;
+}
+
+}}
@@ -0,0 +1,163 @@
+#ifndef Magnum_Audio_BufferStreamer_h
+#define Magnum_Audio_BufferStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Audio::BufferStreamer
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Buffer streamer
+@m_since_latest
+
+Plays arbitrarily long clips through a @ref Source using a fixed amount of
+memory. The data are decoded from an importer supporting
+@ref ImporterFeature::Stream using @ref AbstractImporter::read() in a
+background thread into a ring of fixed-size blocks. Periodically calling
+@ref update() from the thread owning the OpenAL context then unqueues buffers
+the source finished playing with @ref Source::unqueueBuffers(), fills them
+with the decoded blocks and queues them again with @ref Source::queueBuffers():
+
+@code{.cpp}
+Containers::Pointer<Audio::AbstractImporter> importer = …;
+importer->openFile("music.wav");
+
+Audio::Source source;
+Audio::BufferStreamer streamer{*importer, source};
+streamer.update();
+source.play();
+
+// every frame
+streamer.update();
+@endcode
+
+All OpenAL calls are done in @ref update() and the destructor, the
+background thread only touches the importer. Because of that, the importer
+isn't allowed to be used for anything else during the lifetime of the
+streamer. On platforms without threading support, such as Emscripten
+without `-pthread`, the data are decoded directly in @ref update().
+
+If @ref update() is not called often enough and the source runs out of queued
+buffers, it stops. In that case it's up to the application to call
+@ref Source::play() again after the next @ref update().
+*/
+class MAGNUM_AUDIO_EXPORT BufferStreamer {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer      Importer with an opened file
+         * @param source        Source to stream the data to
+         * @param bufferCount   Count of buffers to cycle through
+         * @param bufferSize    Size of each buffer in bytes
+         *
+         * Expects that @p importer supports @ref ImporterFeature::Stream and
+         * has a file opened, that @p bufferCount and @p bufferSize are both
+         * non-zero and that @p bufferSize is at least a single sample frame.
+         * If @p bufferSize isn't a multiple of the sample frame size, it's
+         * rounded down to the nearest multiple. Immediately
+         * starts decoding the data in the background, nothing is queued to
+         * the source until @ref update() is called.
+         */
+        explicit BufferStreamer(AbstractImporter& importer, Source& source, UnsignedInt bufferCount = 4, std::size_t bufferSize = 65536);
+
+        /** @brief Copying is not allowed */
+        BufferStreamer(const BufferStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferStreamer(BufferStreamer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the decoding thread. If there are any buffers queued, stops
+         * the source and unqueues them.
+         */
+        ~BufferStreamer();
+
+        /** @brief Copying is not allowed */
+        BufferStreamer& operator=(const BufferStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferStreamer& operator=(BufferStreamer&&) = delete;
+
+        /** @brief Importer */
+        AbstractImporter& importer();
+
+        /** @brief Source */
+        Source& source();
+
+        /** @brief Whether the stream is looping */
+        bool isLooping() const;
+
+        /**
+         * @brief Set whether the stream is looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the decoder seeks back to the beginning using
+         * @ref AbstractImporter::seek() once it reaches the end of the data.
+         * If the decoder already reached the end with looping disabled,
+         * enabling it makes the decoder continue from the beginning again.
+         * Default is @cpp false @ce.
+         */
+        BufferStreamer& setLooping(bool looping);
+
+        /**
+         * @brief Whether the stream is finished
+         *
+         * Returns @cpp true @ce if all data were decoded and all buffers
+         * queued to the source were played and unqueued again. Never returns
+         * @cpp true @ce if the stream is looping.
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Update the source queue
+         * @return Count of newly queued buffers
+         *
+         * Unqueues buffers that the source finished playing and queues as many
+         * decoded blocks as there are free buffers and blocks available. Has
+         * to be called from the thread owning the OpenAL context.
+         */
+        std::size_t update();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -66,6 +66,13 @@ struct AbstractImporterTest: TestSuite::Tester {
     void dataNoFile();
     void dataCustomDeleter();
 
+    void stream();
+    void streamNotSupported();
+    void streamNotImplemented();
+    void streamNoFile();
+    void readTooMuch();
+    void seekOutOfRange();
+
     void debugFeature();
     void debugFeaturePacked();
     void debugFeatures();
@@ -93,6 +100,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
 
+              &AbstractImporterTest::stream,
+              &AbstractImporterTest::streamNotSupported,
+              &AbstractImporterTest::streamNotImplemented,
+              &AbstractImporterTest::streamNoFile,
+              &AbstractImporterTest::readTooMuch,
+              &AbstractImporterTest::seekOutOfRange,
+
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeaturePacked,
               &AbstractImporterTest::debugFeatures,
@@ -385,6 +399,182 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::stream() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doDataSize() const override { return 5; }
+        std::size_t doRead(Containers::ArrayView<char> data) override {
+            std::size_t i = 0;
+            for(; i != data.size() && _position != 5; ++i, ++_position)
+                data[i] = 'a' + _position;
+            return i;
+        }
+        bool doSeek(std::size_t offset) override {
+            _position = offset;
+            return true;
+        }
+
+        std::size_t _position = 0;
+    } importer;
+
+    CORRADE_COMPARE(importer.dataSize(), 5);
+
+    char data[3];
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(2),
+        Containers::arrayView({'d', 'e'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.read(data), 0);
+
+    /* Seeking to the end is allowed */
+    CORRADE_VERIFY(importer.seek(5));
+    CORRADE_COMPARE(importer.read(data), 0);
+
+    CORRADE_VERIFY(importer.seek(1));
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView({'b', 'c', 'd'}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::streamNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.dataSize();
+    importer.read(data);
+    importer.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::dataSize(): feature not supported\n"
+        "Audio::AbstractImporter::read(): feature not supported\n"
+        "Audio::AbstractImporter::seek(): feature not supported\n");
+}
+
+void AbstractImporterTest::streamNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        /* Implemented so seek() can get past the range check */
+        std::size_t doDataSize() const override { return 5; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.read(data);
+    importer.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::read(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::seek(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::streamNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.dataSize();
+    importer.read(data);
+    importer.seek(0);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::dataSize(): no file opened\n"
+        "Audio::AbstractImporter::read(): no file opened\n"
+        "Audio::AbstractImporter::seek(): no file opened\n");
+}
+
+void AbstractImporterTest::readTooMuch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doRead(Containers::ArrayView<char> data) override {
+            return data.size() + 1;
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[3];
+    importer.read(data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::read(): implementation returned 4 bytes for a 3-byte view\n");
+}
+
+void AbstractImporterTest::seekOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doDataSize() const override { return 5; }
+        bool doSeek(std::size_t) override { return true; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.seek(6);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seek(): offset 6 out of range for 5 bytes\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
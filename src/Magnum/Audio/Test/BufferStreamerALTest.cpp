@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/BufferStreamer.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct BufferStreamerALTest: TestSuite::Tester {
+    explicit BufferStreamerALTest();
+
+    void construct();
+    void constructNotStreamable();
+    void constructNoFile();
+    void constructZeroBuffers();
+    void constructBufferSmallerThanFrame();
+
+    void stream();
+    void streamBufferSizeNotFrameMultiple();
+    void streamLooping();
+    void streamLoopingAfterEnd();
+
+    Context _context;
+};
+
+/* Streams a ramp of bytes of given length, by default as Mono8 samples. Like
+   actual importers, reads only whole frames. */
+struct RampImporter: AbstractImporter {
+    explicit RampImporter(std::size_t size, BufferFormat format = BufferFormat::Mono8, std::size_t frameSize = 1): _size{size}, _format{format}, _frameSize{frameSize} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return _format; }
+    UnsignedInt doFrequency() const override { return 22050; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    std::size_t doDataSize() const override { return _size; }
+    std::size_t doRead(Containers::ArrayView<char> data) override {
+        const std::size_t size = data.size()/_frameSize*_frameSize;
+        std::size_t i = 0;
+        for(; i != size && _position != _size; ++i, ++_position)
+            data[i] = char(_position);
+        return i;
+    }
+    bool doSeek(std::size_t offset) override {
+        _position = offset;
+        return true;
+    }
+
+    std::size_t _size, _position = 0;
+    BufferFormat _format;
+    std::size_t _frameSize;
+};
+
+BufferStreamerALTest::BufferStreamerALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&BufferStreamerALTest::construct,
+              &BufferStreamerALTest::constructNotStreamable,
+              &BufferStreamerALTest::constructNoFile,
+              &BufferStreamerALTest::constructZeroBuffers,
+              &BufferStreamerALTest::constructBufferSmallerThanFrame,
+
+              &BufferStreamerALTest::stream,
+              &BufferStreamerALTest::streamBufferSizeNotFrameMultiple,
+              &BufferStreamerALTest::streamLooping,
+              &BufferStreamerALTest::streamLoopingAfterEnd});
+}
+
+void BufferStreamerALTest::construct() {
+    RampImporter importer{100};
+    Source source;
+
+    {
+        BufferStreamer streamer{importer, source, 3, 16};
+        CORRADE_COMPARE(&streamer.importer(), &importer);
+        CORRADE_COMPARE(&streamer.source(), &source);
+        CORRADE_VERIFY(!streamer.isLooping());
+        CORRADE_VERIFY(!streamer.isFinished());
+    }
+
+    /* Nothing queued, so the source type stays untouched */
+    CORRADE_COMPARE(source.type(), Source::Type::Undetermined);
+}
+
+void BufferStreamerALTest::constructNotStreamable() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+    Source source;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BufferStreamer{importer, source};
+    CORRADE_COMPARE(out.str(), "Audio::BufferStreamer: the importer doesn't support streaming\n");
+}
+
+void BufferStreamerALTest::constructNoFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Stream; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+    Source source;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BufferStreamer{importer, source};
+    CORRADE_COMPARE(out.str(), "Audio::BufferStreamer: no file opened\n");
+}
+
+void BufferStreamerALTest::constructZeroBuffers() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    RampImporter importer{100};
+    Source source;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BufferStreamer{importer, source, 0, 16};
+    BufferStreamer{importer, source, 3, 0};
+    CORRADE_COMPARE(out.str(),
+        "Audio::BufferStreamer: expected non-zero buffer count and size but got 0 and 16\n"
+        "Audio::BufferStreamer: expected non-zero buffer count and size but got 3 and 0\n");
+}
+
+void BufferStreamerALTest::constructBufferSmallerThanFrame() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    RampImporter importer{100, BufferFormat::Stereo16, 4};
+    Source source;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BufferStreamer{importer, source, 3, 3};
+    CORRADE_COMPARE(out.str(), "Audio::BufferStreamer: buffer size 3 is smaller than a single sample frame of 4 bytes\n");
+}
+
+void BufferStreamerALTest::stream() {
+    /* 100 bytes in 16-byte blocks is 7 buffers in total, the last one
+       partially filled */
+    RampImporter importer{100};
+    Source source;
+    BufferStreamer streamer{importer, source, 3, 16};
+
+    /* The decoding happens in the background, so wait until all buffers get
+       queued. Give up after a while to not hang forever if it doesn't. */
+    std::size_t queued = 0;
+    for(std::size_t i = 0; i != 1000 && queued != 3; ++i) {
+        queued += streamer.update();
+        if(queued != 3) std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_COMPARE(queued, 3);
+    CORRADE_COMPARE(source.type(), Source::Type::Streaming);
+    CORRADE_VERIFY(!streamer.isFinished());
+
+    /* All buffers are queued, nothing more can be queued until the source
+       plays some */
+    CORRADE_COMPARE(streamer.update(), 0);
+
+    /* Play everything. 100 samples at 22 kHz take about 5 milliseconds,
+       restart the source if it ran out of buffers in the meantime. */
+    source.play();
+    for(std::size_t i = 0; i != 1000 && !streamer.isFinished(); ++i) {
+        if(streamer.update() && source.state() == Source::State::Stopped)
+            source.play();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_VERIFY(streamer.isFinished());
+    CORRADE_COMPARE(streamer.update(), 0);
+}
+
+void BufferStreamerALTest::streamBufferSizeNotFrameMultiple() {
+    /* 100 bytes of 4-byte frames in 15-byte buffers get rounded down to 12
+       bytes, giving 9 buffers in total, the last one partially filled. If
+       the buffer size wasn't rounded, the importer would read just 12 bytes
+       into the first buffer and the short read would end the stream right
+       away. */
+    RampImporter importer{100, BufferFormat::Stereo16, 4};
+    Source source;
+    BufferStreamer streamer{importer, source, 3, 15};
+
+    source.play();
+    std::size_t queued = 0;
+    for(std::size_t i = 0; i != 1000 && !streamer.isFinished(); ++i) {
+        const std::size_t count = streamer.update();
+        if(count && source.state() != Source::State::Playing)
+            source.play();
+        queued += count;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_VERIFY(streamer.isFinished());
+    CORRADE_COMPARE(queued, 9);
+    CORRADE_COMPARE(importer._position, 100);
+}
+
+void BufferStreamerALTest::streamLooping() {
+    RampImporter importer{10};
+    Source source;
+    BufferStreamer streamer{importer, source, 2, 16};
+    streamer.setLooping(true);
+    CORRADE_VERIFY(streamer.isLooping());
+
+    /* Even though the clip is shorter than a single block, it never finishes
+       and the blocks keep getting filled */
+    source.play();
+    std::size_t queued = 0;
+    for(std::size_t i = 0; i != 1000 && queued < 6; ++i) {
+        const std::size_t count = streamer.update();
+        if(count && source.state() != Source::State::Playing)
+            source.play();
+        queued += count;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_COMPARE_AS(queued, 6, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_VERIFY(!streamer.isFinished());
+}
+
+void BufferStreamerALTest::streamLoopingAfterEnd() {
+    RampImporter importer{10};
+    Source source;
+    BufferStreamer streamer{importer, source, 2, 16};
+
+    /* Play everything with looping disabled */
+    source.play();
+    for(std::size_t i = 0; i != 1000 && !streamer.isFinished(); ++i) {
+        if(streamer.update() && source.state() != Source::State::Playing)
+            source.play();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_VERIFY(streamer.isFinished());
+
+    /* Enabling looping afterwards should wake up the decoder and make it
+       continue from the beginning */
+    streamer.setLooping(true);
+    CORRADE_VERIFY(!streamer.isFinished());
+    std::size_t queued = 0;
+    for(std::size_t i = 0; i != 1000 && queued < 4; ++i) {
+        const std::size_t count = streamer.update();
+        if(count && source.state() != Source::State::Playing)
+            source.play();
+        queued += count;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CORRADE_COMPARE_AS(queued, 4, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_VERIFY(!streamer.isFinished());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::BufferStreamerALTest)
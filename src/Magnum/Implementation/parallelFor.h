@@ -0,0 +1,100 @@
+#ifndef Magnum_Implementation_parallelFor_h
+#define Magnum_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+
+/* Emscripten without -pthread has std::thread but creating one fails at
+   runtime, so don't even try there. Everything below then runs on the calling
+   thread only. Code that needs a thread for something else than a parallel
+   loop, such as a background worker, should check this macro as well. */
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#define MAGNUM_IMPLEMENTATION_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+/* Thread count corresponding to a user-specified value, with 0 meaning all
+   available hardware threads. Always 1 if threads aren't supported. */
+inline std::size_t threadCount(const std::size_t requested) {
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    if(requested) return requested;
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return hardware ? hardware : 1;
+    #else
+    static_cast<void>(requested);
+    return 1;
+    #endif
+}
+
+/* Calls function(thread, i) for all i in [0, count) on at most threadCount
+   threads, with the calling thread being one of them. The thread argument is
+   in [0, threadCount) and can be used to index per-thread state. Each thread
+   picks the next index once it's done with the previous one, which balances
+   the load better than splitting the range into fixed-size chunks upfront if
+   the items vary in size. A threadCount of 0 is treated the same as 1, pass
+   the output of threadCount() above to get all hardware threads. */
+template<class F> void parallelForThread(const std::size_t count, std::size_t threadCount, F&& function) {
+    #ifdef MAGNUM_IMPLEMENTATION_THREADS
+    if(threadCount > count) threadCount = count;
+    if(threadCount > 1) {
+        std::atomic<std::size_t> next{0};
+        const auto worker = [&](const std::size_t thread) {
+            for(std::size_t i; (i = next++) < count; )
+                function(thread, i);
+        };
+
+        Containers::Array<std::thread> threads{threadCount - 1};
+        for(std::size_t i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{worker, i + 1};
+        worker(0);
+        for(std::thread& thread: threads)
+            thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    for(std::size_t i = 0; i != count; ++i)
+        function(std::size_t{0}, i);
+}
+
+/* Like above, but calls just function(i) */
+template<class F> void parallelFor(const std::size_t count, const std::size_t threadCount, F&& function) {
+    parallelForThread(count, threadCount, [&function](std::size_t, const std::size_t i) {
+        function(i);
+    });
+}
+
+}}
+
+#endif
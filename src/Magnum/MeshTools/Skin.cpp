@@ -0,0 +1,282 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Vertices are distributed to threads in chunks of this size, handing out
+   anything smaller is not worth the synchronization */
+constexpr std::size_t VerticesPerChunk = 4096;
+
+/* One joint ID + weight attribute pair, either pointing directly to the mesh
+   data or to a converted copy */
+struct InfluenceSet {
+    Containers::StridedArrayView2D<const UnsignedInt> jointIds;
+    Containers::StridedArrayView2D<const Float> weights;
+};
+
+/* Inputs and outputs, either pointing directly to the mesh data or to a
+   converted copy */
+struct SkinViews {
+    Containers::Array<InfluenceSet> sets;
+    Containers::StridedArrayView1D<const Vector3> positions, normals, tangents;
+    Containers::StridedArrayView1D<Vector3> positionsOut, normalsOut, tangentsOut;
+};
+
+/* With count being a compile-time constant the loop gets unrolled and the
+   multiply-add on the matrix columns vectorized. A zero count means the size
+   is taken from the view at runtime. */
+template<std::size_t count> inline void blend(Matrix4& out, const Containers::StridedArrayView1D<const Matrix4>& joints, const Containers::StridedArrayView1D<const UnsignedInt>& jointIds, const Containers::StridedArrayView1D<const Float>& weights) {
+    const std::size_t n = count ? count : jointIds.size();
+    for(std::size_t i = 0; i != n; ++i)
+        out += joints[jointIds[i]]*weights[i];
+}
+
+/* Dual quaternions are accumulated as two separate quaternions, flipping
+   their sign to be in the same hemisphere as the first influence. The
+   reference is the first joint of the first set, taken before any
+   accumulation happens. */
+template<std::size_t count> inline void blend(Quaternion& outReal, Quaternion& outDual, const Quaternion& reference, const Containers::StridedArrayView1D<const DualQuaternion>& joints, const Containers::StridedArrayView1D<const UnsignedInt>& jointIds, const Containers::StridedArrayView1D<const Float>& weights) {
+    const std::size_t n = count ? count : jointIds.size();
+    for(std::size_t i = 0; i != n; ++i) {
+        const DualQuaternion& joint = joints[jointIds[i]];
+        const Float weight = Math::dot(joint.real(), reference) < 0.0f ? -weights[i] : weights[i];
+        outReal += joint.real()*weight;
+        outDual += joint.dual()*weight;
+    }
+}
+
+void skinRange(const SkinViews& views, const Containers::StridedArrayView1D<const Matrix4>& joints, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        Matrix4 matrix{Math::ZeroInit};
+        for(const InfluenceSet& set: views.sets) {
+            const Containers::StridedArrayView1D<const UnsignedInt> jointIds = set.jointIds[i];
+            const Containers::StridedArrayView1D<const Float> weights = set.weights[i];
+            switch(jointIds.size()) {
+                case 4: blend<4>(matrix, joints, jointIds, weights); break;
+                case 8: blend<8>(matrix, joints, jointIds, weights); break;
+                default: blend<0>(matrix, joints, jointIds, weights);
+            }
+        }
+
+        /* Normals need the inverse transpose to stay perpendicular to the
+           surface if the blended matrix has a non-uniform scale or shear,
+           tangents lie in the surface and so are transformed directly */
+        views.positionsOut[i] = matrix.transformPoint(views.positions[i]);
+        if(!views.normalsOut.isEmpty())
+            views.normalsOut[i] = (matrix.normalMatrix()*views.normals[i]).normalized();
+        if(!views.tangentsOut.isEmpty())
+            views.tangentsOut[i] = matrix.transformVector(views.tangents[i]).normalized();
+    }
+}
+
+void skinRange(const SkinViews& views, const Containers::StridedArrayView1D<const DualQuaternion>& joints, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        const Quaternion reference = joints[views.sets[0].jointIds[i][0]].real();
+        Quaternion real{Math::ZeroInit};
+        Quaternion dual{Math::ZeroInit};
+        for(const InfluenceSet& set: views.sets) {
+            const Containers::StridedArrayView1D<const UnsignedInt> jointIds = set.jointIds[i];
+            const Containers::StridedArrayView1D<const Float> weights = set.weights[i];
+            switch(jointIds.size()) {
+                case 4: blend<4>(real, dual, reference, joints, jointIds, weights); break;
+                case 8: blend<8>(real, dual, reference, joints, jointIds, weights); break;
+                default: blend<0>(real, dual, reference, joints, jointIds, weights);
+            }
+        }
+
+        /* If the weights are all zero or the influences cancel each other
+           out, there's nothing to normalize. Keep the vertex as-is instead of
+           producing NaNs. */
+        const Float length = real.length();
+        if(length == 0.0f) {
+            views.positionsOut[i] = views.positions[i];
+            if(!views.normalsOut.isEmpty())
+                views.normalsOut[i] = views.normals[i];
+            if(!views.tangentsOut.isEmpty())
+                views.tangentsOut[i] = views.tangents[i];
+            continue;
+        }
+
+        /* Normalize the blended result and calculate the translation from
+           the (not necessarily orthogonal) dual part directly instead of
+           going through DualQuaternion, which would assert on that */
+        real /= length;
+        dual /= length;
+        const Vector3 translation = (dual*real.conjugated()).vector()*2.0f;
+
+        views.positionsOut[i] = real.transformVectorNormalized(views.positions[i]) + translation;
+        if(!views.normalsOut.isEmpty())
+            views.normalsOut[i] = real.transformVectorNormalized(views.normals[i]);
+        if(!views.tangentsOut.isEmpty())
+            views.tangentsOut[i] = real.transformVectorNormalized(views.tangents[i]);
+    }
+}
+
+template<class T> void skinParallel(const SkinViews& views, const Containers::StridedArrayView1D<const T>& joints, const UnsignedInt threadCount) {
+    const std::size_t vertexCount = views.positionsOut.size();
+    const std::size_t chunkCount = (vertexCount + VerticesPerChunk - 1)/VerticesPerChunk;
+    Magnum::Implementation::parallelFor(chunkCount, Magnum::Implementation::threadCount(threadCount), [&](const std::size_t chunk) {
+        skinRange(views, joints, chunk*VerticesPerChunk, Math::min((chunk + 1)*VerticesPerChunk, vertexCount));
+    });
+}
+
+/* Storage for converted inputs, has to outlive the SkinViews */
+struct SkinStorage {
+    Containers::Array<Containers::Array<UnsignedInt>> jointIds;
+    Containers::Array<Containers::Array<Float>> weights;
+    Containers::Array<Vector3> positions, normals, tangents;
+};
+
+/* Returns false if asserts fail in a graceful assert build */
+bool prepare(const Trade::MeshData& mesh, const std::size_t jointCount, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& tangents, SkinViews& views, SkinStorage& storage) {
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    const UnsignedInt setCount = mesh.attributeCount(Trade::MeshAttribute::JointIds);
+
+    const Containers::Optional<UnsignedInt> positionAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Position);
+    CORRADE_ASSERT(positionAttributeId,
+        "MeshTools::skinInto(): the mesh has no positions", false);
+    const VertexFormat positionFormat = mesh.attributeFormat(*positionAttributeId);
+    CORRADE_ASSERT(!isVertexFormatImplementationSpecific(positionFormat),
+        "MeshTools::skinInto(): positions have an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(positionFormat)), false);
+    CORRADE_ASSERT(vertexFormatComponentCount(positionFormat) == 3,
+        "MeshTools::skinInto(): expected 3D positions but got" << positionFormat, false);
+    /* The MeshData constructor already checks that each joint ID attribute
+       has a matching weight attribute of the same array size */
+    CORRADE_ASSERT(setCount,
+        "MeshTools::skinInto(): the mesh has no joint IDs", false);
+    CORRADE_ASSERT(positions.size() == vertexCount,
+        "MeshTools::skinInto(): expected" << vertexCount << "positions but got" << positions.size(), false);
+    CORRADE_ASSERT(normals.isEmpty() || normals.size() == vertexCount,
+        "MeshTools::skinInto(): expected either no or" << vertexCount << "normals but got" << normals.size(), false);
+    CORRADE_ASSERT(normals.isEmpty() || mesh.hasAttribute(Trade::MeshAttribute::Normal),
+        "MeshTools::skinInto(): the mesh has no normals", false);
+    CORRADE_ASSERT(tangents.isEmpty() || tangents.size() == vertexCount,
+        "MeshTools::skinInto(): expected either no or" << vertexCount << "tangents but got" << tangents.size(), false);
+    CORRADE_ASSERT(tangents.isEmpty() || mesh.hasAttribute(Trade::MeshAttribute::Tangent),
+        "MeshTools::skinInto(): the mesh has no tangents", false);
+
+    /* Use the joint and weight data directly if they're in the desired
+       format, convert them otherwise */
+    views.sets = Containers::Array<InfluenceSet>{setCount};
+    storage.jointIds = Containers::Array<Containers::Array<UnsignedInt>>{setCount};
+    storage.weights = Containers::Array<Containers::Array<Float>>{setCount};
+    for(UnsignedInt i = 0; i != setCount; ++i) {
+        const std::size_t arraySize = mesh.attributeArraySize(Trade::MeshAttribute::JointIds, i);
+
+        if(mesh.attributeFormat(Trade::MeshAttribute::JointIds, i) == VertexFormat::UnsignedInt)
+            views.sets[i].jointIds = mesh.attribute<UnsignedInt[]>(Trade::MeshAttribute::JointIds, i);
+        else {
+            storage.jointIds[i] = Containers::Array<UnsignedInt>{NoInit, vertexCount*arraySize};
+            const Containers::StridedArrayView2D<UnsignedInt> jointIds{storage.jointIds[i], {vertexCount, arraySize}};
+            mesh.jointIdsInto(jointIds, i);
+            views.sets[i].jointIds = jointIds;
+        }
+
+        if(mesh.attributeFormat(Trade::MeshAttribute::Weights, i) == VertexFormat::Float)
+            views.sets[i].weights = mesh.attribute<Float[]>(Trade::MeshAttribute::Weights, i);
+        else {
+            storage.weights[i] = Containers::Array<Float>{NoInit, vertexCount*arraySize};
+            const Containers::StridedArrayView2D<Float> weights{storage.weights[i], {vertexCount, arraySize}};
+            mesh.weightsInto(weights, i);
+            views.sets[i].weights = weights;
+        }
+
+        #ifndef CORRADE_NO_ASSERT
+        for(const Containers::StridedArrayView1D<const UnsignedInt> vertex: views.sets[i].jointIds)
+            for(const UnsignedInt jointId: vertex)
+                CORRADE_ASSERT(jointId < jointCount,
+                    "MeshTools::skinInto(): joint ID" << jointId << "out of range for" << jointCount << "joints", false);
+        #else
+        static_cast<void>(jointCount);
+        #endif
+    }
+
+    /* Same for positions, normals and tangents */
+    if(positionFormat == VertexFormat::Vector3)
+        views.positions = mesh.attribute<Vector3>(*positionAttributeId);
+    else {
+        storage.positions = mesh.positions3DAsArray();
+        views.positions = storage.positions;
+    }
+    views.positionsOut = positions;
+
+    if(!normals.isEmpty()) {
+        if(mesh.attributeFormat(Trade::MeshAttribute::Normal) == VertexFormat::Vector3)
+            views.normals = mesh.attribute<Vector3>(Trade::MeshAttribute::Normal);
+        else {
+            storage.normals = mesh.normalsAsArray();
+            views.normals = storage.normals;
+        }
+        views.normalsOut = normals;
+    }
+
+    if(!tangents.isEmpty()) {
+        if(mesh.attributeFormat(Trade::MeshAttribute::Tangent) == VertexFormat::Vector3)
+            views.tangents = mesh.attribute<Vector3>(Trade::MeshAttribute::Tangent);
+        else {
+            storage.tangents = mesh.tangentsAsArray();
+            views.tangents = storage.tangents;
+        }
+        views.tangentsOut = tangents;
+    }
+
+    return true;
+}
+
+}
+
+void skinInto(const Trade::MeshData& mesh, const Containers::StridedArrayView1D<const Matrix4>& jointMatrices, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& tangents, const UnsignedInt threadCount) {
+    SkinViews views;
+    SkinStorage storage;
+    if(!prepare(mesh, jointMatrices.size(), positions, normals, tangents, views, storage))
+        return; /* LCOV_EXCL_LINE */
+
+    skinParallel(views, jointMatrices, threadCount);
+}
+
+void skinInto(const Trade::MeshData& mesh, const Containers::StridedArrayView1D<const DualQuaternion>& jointTransformations, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& tangents, const UnsignedInt threadCount) {
+    SkinViews views;
+    SkinStorage storage;
+    if(!prepare(mesh, jointTransformations.size(), positions, normals, tangents, views, storage))
+        return; /* LCOV_EXCL_LINE */
+
+    skinParallel(views, jointTransformations, threadCount);
+}
+
+}}
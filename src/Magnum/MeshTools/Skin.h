@@ -0,0 +1,108 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::skinInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin a mesh on the CPU using joint matrices
+@param[in] mesh             Mesh with joint IDs and weights
+@param[in] jointMatrices    Per-joint transformation matrices
+@param[out] positions       Where to put skinned positions
+@param[out] normals         Where to put skinned normals. Can be empty.
+@param[out] tangents        Where to put skinned tangents. Can be empty.
+@param[in] threadCount      Worker thread count. If @cpp 0 @ce, the count
+    is autodetected from available hardware concurrency.
+@m_since_latest
+
+Performs linear blend skinning of the first set of
+@ref Trade::MeshAttribute::Position, @relativeref{Trade::MeshAttribute,Normal}
+and @relativeref{Trade::MeshAttribute,Tangent} attributes, with the per-vertex
+joint matrix being a weighted sum of @p jointMatrices indexed by all
+@ref Trade::MeshAttribute::JointIds and
+@relativeref{Trade::MeshAttribute,Weights} attributes in the mesh. The
+@p jointMatrices are expected to already include the inverse bind matrices
+from @ref Trade::SkinData::inverseBindMatrices(), i.e. be the same matrices
+that get passed to the builtin shaders for GPU skinning.
+
+Normals are transformed with the @ref Matrix4::normalMatrix() of the blended
+matrix and tangents with its upper 3x3 part, and both are renormalized, so
+they stay perpendicular even with non-uniformly scaled joints. If the tangents
+have four components, the bitangent sign in the fourth component isn't
+affected by the skinning and is thus not written.
+
+Meshes where the joint IDs are @ref VertexFormat::UnsignedInt and weights are
+@ref VertexFormat::Float, either in a single attribute set or, as is common
+with glTF files, in two sets of four, are processed directly without any
+intermediate copies. Other formats are unpacked into a temporary allocation
+first. Layouts with four and eight influences per vertex use dedicated
+fixed-size loops, other counts go through a generic loop. These are written
+with the regular @ref Math types and the fixed size only lets the compiler
+unroll them and auto-vectorize the multiply-add on the matrix columns, there
+are no hand-written SIMD kernels. The vertices are split into chunks of a few
+thousand, which are then distributed among @p threadCount threads including
+the calling thread. If threads aren't available on the platform, all vertices
+are processed on the calling thread.
+
+Expects that the mesh has 3D positions, at least one joint ID attribute, all
+joint IDs are less than size of @p jointMatrices, the @p positions view has
+the same size as @ref Trade::MeshData::vertexCount() and @p normals /
+@p tangents are either empty or have the same size and the mesh has a
+corresponding attribute.
+@see @ref Trade::MeshData::jointIdsInto(), @ref Trade::MeshData::weightsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInto(const Trade::MeshData& mesh, const Containers::StridedArrayView1D<const Matrix4>& jointMatrices, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals = nullptr, const Containers::StridedArrayView1D<Vector3>& tangents = nullptr, UnsignedInt threadCount = 1);
+
+/**
+@brief Skin a mesh on the CPU using joint dual quaternions
+@m_since_latest
+
+Like @ref skinInto(const Trade::MeshData&, const Containers::StridedArrayView1D<const Matrix4>&, const Containers::StridedArrayView1D<Vector3>&, const Containers::StridedArrayView1D<Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt),
+but performs dual quaternion skinning, which preserves volume around joints
+where linear blend skinning causes the "candy wrapper" artifacts. The
+per-vertex transformation is a weighted sum of @p jointTransformations, with
+each dual quaternion negated if needed to be in the same hemisphere as the
+first influence, and then normalized. If the weighted sum has a zero length,
+for example because all weights of given vertex are zero, the vertex is
+copied to the output untransformed. The @p jointTransformations are expected
+to be normalized and contain only rotation and translation.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInto(const Trade::MeshData& mesh, const Containers::StridedArrayView1D<const DualQuaternion>& jointTransformations, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals = nullptr, const Containers::StridedArrayView1D<Vector3>& tangents = nullptr, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
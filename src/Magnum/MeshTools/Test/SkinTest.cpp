@@ -0,0 +1,616 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Half.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Skin.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SkinTest: TestSuite::Tester {
+    explicit SkinTest();
+
+    void matrices();
+    void matricesEight();
+    void matricesPacked();
+    void matricesNormalsTangents();
+    void matricesNormalsTangentsNonUniformScale();
+    void dualQuaternions();
+    void multithreaded();
+
+    void invalidMesh();
+    void invalidSize();
+    void jointIdOutOfRange();
+
+    void benchmarkMatrices4();
+    void benchmarkMatrices8();
+    void benchmarkMatrices4Multithreaded();
+    void benchmarkDualQuaternions4();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    bool twoSets;
+} MatricesEightData[]{
+    {"single set of eight", false},
+    {"two sets of four", true}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} MultithreadedData[]{
+    {"four threads", 4},
+    {"autodetected thread count", 0},
+    {"more threads than vertex ranges", 1000}
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::matrices});
+
+    addInstancedTests({&SkinTest::matricesEight},
+        Containers::arraySize(MatricesEightData));
+
+    addTests({&SkinTest::matricesPacked,
+              &SkinTest::matricesNormalsTangents,
+              &SkinTest::matricesNormalsTangentsNonUniformScale,
+              &SkinTest::dualQuaternions});
+
+    addInstancedTests({&SkinTest::multithreaded},
+        Containers::arraySize(MultithreadedData));
+
+    addTests({&SkinTest::invalidMesh,
+              &SkinTest::invalidSize,
+              &SkinTest::jointIdOutOfRange});
+
+    addBenchmarks({&SkinTest::benchmarkMatrices4,
+                   &SkinTest::benchmarkMatrices8,
+                   &SkinTest::benchmarkMatrices4Multithreaded,
+                   &SkinTest::benchmarkDualQuaternions4}, 10);
+}
+
+const Matrix4 JointMatrices[]{
+    Matrix4::translation({1.0f, 0.0f, 0.0f}),
+    Matrix4::translation({0.0f, 2.0f, 0.0f}),
+    Matrix4::rotationZ(90.0_degf),
+    Matrix4::scaling(Vector3{2.0f})
+};
+
+void SkinTest::matrices() {
+    struct Vertex {
+        Vector3 position;
+        UnsignedInt jointIds[4];
+        Float weights[4];
+    } vertices[]{
+        /* Single influence */
+        {{1.0f, 1.0f, 1.0f}, {0, 1, 2, 3}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        /* Two influences */
+        {{1.0f, 0.0f, 0.0f}, {0, 1, 0, 0}, {0.5f, 0.5f, 0.0f, 0.0f}},
+        /* All four */
+        {{1.0f, 0.0f, 0.0f}, {2, 3, 1, 0}, {0.25f, 0.25f, 0.25f, 0.25f}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 positions[3];
+    skinInto(mesh, JointMatrices, positions);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView({
+        Vector3{2.0f, 1.0f, 1.0f},
+        Vector3{1.5f, 1.0f, 0.0f},
+        Vector3{1.25f, 0.75f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::matricesEight() {
+    auto&& data = MatricesEightData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Same as the last vertex in matrices(), with each influence split into
+       two, and the first vertex with the first four weights zero */
+    struct Vertex {
+        Vector3 position;
+        UnsignedInt jointIds[8];
+        Float weights[8];
+    } vertices[]{
+        {{1.0f, 1.0f, 1.0f}, {3, 2, 1, 3, 0, 1, 2, 3},
+         {0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {2, 3, 1, 0, 2, 3, 1, 0},
+         {0.125f, 0.125f, 0.125f, 0.125f, 0.125f, 0.125f, 0.125f, 0.125f}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Containers::Array<Trade::MeshAttributeData> attributes;
+    if(data.twoSets) attributes = Containers::array({
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, offsetof(Vertex, jointIds),
+            2, sizeof(Vertex), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, offsetof(Vertex, jointIds) + 4*4,
+            2, sizeof(Vertex), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, offsetof(Vertex, weights),
+            2, sizeof(Vertex), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, offsetof(Vertex, weights) + 4*4,
+            2, sizeof(Vertex), 4},
+    });
+    else attributes = Containers::array({
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 8},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 8}
+    });
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, Utility::move(attributes)};
+    CORRADE_COMPARE(mesh.attributeCount(Trade::MeshAttribute::JointIds), data.twoSets ? 2u : 1u);
+
+    Vector3 positions[2];
+    skinInto(mesh, JointMatrices, positions);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView({
+        Vector3{2.0f, 1.0f, 1.0f},
+        Vector3{1.25f, 0.75f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::matricesPacked() {
+    /* Same as matrices(), but with everything packed so it goes through the
+       conversion paths */
+    struct Vertex {
+        Vector3h position;
+        UnsignedByte jointIds[4];
+        Half weights[4];
+    } vertices[]{
+        {{1.0_h, 1.0_h, 1.0_h}, {0, 1, 2, 3}, {1.0_h, 0.0_h, 0.0_h, 0.0_h}},
+        {{1.0_h, 0.0_h, 0.0_h}, {0, 1, 0, 0}, {0.5_h, 0.5_h, 0.0_h, 0.0_h}},
+        {{1.0_h, 0.0_h, 0.0_h}, {2, 3, 1, 0}, {0.25_h, 0.25_h, 0.25_h, 0.25_h}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedByte, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Half, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 positions[3];
+    skinInto(mesh, JointMatrices, positions);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView({
+        Vector3{2.0f, 1.0f, 1.0f},
+        Vector3{1.5f, 1.0f, 0.0f},
+        Vector3{1.25f, 0.75f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::matricesNormalsTangents() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        /* Four-component tangents to verify the conversion path */
+        Vector4 tangent;
+        UnsignedInt jointIds[4];
+        Float weights[4];
+    } vertices[]{
+        {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f, -1.0f},
+         {0, 1, 2, 3}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 1.0f},
+         {2, 3, 1, 0}, {0.25f, 0.25f, 0.25f, 0.25f}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+            view.slice(&Vertex::tangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 positions[2];
+    Vector3 normals[2];
+    Vector3 tangents[2];
+    skinInto(mesh, JointMatrices, positions, normals, tangents);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView({
+        Vector3{2.0f, 1.0f, 1.0f},
+        Vector3{1.25f, 0.75f, 0.0f}
+    }), TestSuite::Compare::Container);
+    /* Translation doesn't affect normals and tangents, the blended 3x3 part
+       of the second vertex is (rotationZ(90°) + 4*identity)/4 */
+    CORRADE_COMPARE_AS(Containers::arrayView(normals), Containers::arrayView({
+        Vector3{0.0f, 0.0f, 1.0f},
+        Vector3{4.0f, 1.0f, 0.0f}.normalized()
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(tangents), Containers::arrayView({
+        Vector3{1.0f, 0.0f, 0.0f},
+        Vector3{-1.0f, 4.0f, 0.0f}.normalized()
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::matricesNormalsTangentsNonUniformScale() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector3 tangent;
+        UnsignedInt jointIds[1];
+        Float weights[1];
+    } vertices[]{
+        {{1.0f, 1.0f, 0.0f}, Vector3{1.0f, 1.0f, 0.0f}.normalized(),
+         Vector3{1.0f, -1.0f, 0.0f}.normalized(), {0}, {1.0f}}
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+            view.slice(&Vertex::tangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 1},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 1}
+    }};
+
+    const Matrix4 jointMatrices[]{
+        Matrix4::scaling({2.0f, 1.0f, 1.0f})
+    };
+
+    Vector3 positions[1];
+    Vector3 normals[1];
+    Vector3 tangents[1];
+    skinInto(mesh, jointMatrices, positions, normals, tangents);
+    CORRADE_COMPARE(positions[0], (Vector3{2.0f, 1.0f, 0.0f}));
+    /* The tangent gets stretched along X together with the surface, while
+       the normal has to lean towards Y to stay perpendicular to it */
+    CORRADE_COMPARE(tangents[0], (Vector3{2.0f, -1.0f, 0.0f}.normalized()));
+    CORRADE_COMPARE(normals[0], (Vector3{1.0f, 2.0f, 0.0f}.normalized()));
+    CORRADE_COMPARE(Math::dot(normals[0], tangents[0]), 0.0f);
+}
+
+void SkinTest::dualQuaternions() {
+    const DualQuaternion translation = DualQuaternion::translation({1.0f, 0.0f, 0.0f});
+    const DualQuaternion joints[]{
+        translation,
+        DualQuaternion::translation({0.0f, 2.0f, 0.0f}),
+        DualQuaternion::rotation(90.0_degf, Vector3::zAxis()),
+        /* Same transformation as the first, but in the opposite hemisphere */
+        DualQuaternion{-translation.real(), -translation.dual()}
+    };
+
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        UnsignedInt jointIds[4];
+        Float weights[4];
+    } vertices[]{
+        /* Single influence */
+        {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 1.0f},
+         {0, 1, 2, 3}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        /* Two translations get averaged */
+        {{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+         {0, 1, 0, 0}, {0.5f, 0.5f, 0.0f, 0.0f}},
+        /* Two equivalent transformations in different hemispheres, would
+           cancel out without the sign flip */
+        {{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+         {0, 3, 0, 0}, {0.5f, 0.5f, 0.0f, 0.0f}},
+        /* Rotation */
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+         {2, 0, 0, 0}, {1.0f, 0.0f, 0.0f, 0.0f}},
+        /* All weights zero, the blended quaternion has a zero length and the
+           vertex is kept as-is instead of becoming a NaN */
+        {{1.0f, 2.0f, 3.0f}, {0.0f, 1.0f, 0.0f},
+         {0, 1, 2, 3}, {0.0f, 0.0f, 0.0f, 0.0f}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 positions[5];
+    Vector3 normals[5];
+    skinInto(mesh, joints, positions, normals);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView({
+        Vector3{2.0f, 1.0f, 1.0f},
+        Vector3{1.5f, 1.0f, 0.0f},
+        Vector3{2.0f, 0.0f, 0.0f},
+        Vector3{0.0f, 1.0f, 0.0f},
+        Vector3{1.0f, 2.0f, 3.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals), Containers::arrayView({
+        Vector3{0.0f, 0.0f, 1.0f},
+        Vector3{0.0f, 0.0f, 1.0f},
+        Vector3{0.0f, 0.0f, 1.0f},
+        Vector3{0.0f, 1.0f, 0.0f},
+        Vector3{0.0f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+struct BenchmarkVertex {
+    Vector3 position;
+    Vector3 normal;
+    UnsignedInt jointIds[8];
+    Float weights[8];
+};
+
+/* Enough vertices to get split across several threads */
+Trade::MeshData benchmarkMesh(Containers::ArrayView<BenchmarkVertex> vertices, UnsignedInt influenceCount) {
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        vertices[i].position = {Float(i%37), Float(i%11), Float(i%5)};
+        vertices[i].normal = Vector3{Float(i%3), 1.0f, Float(i%7)}.normalized();
+        for(UnsignedInt j = 0; j != influenceCount; ++j) {
+            vertices[i].jointIds[j] = (i + j)%4;
+            vertices[i].weights[j] = 1.0f/influenceCount;
+        }
+    }
+
+    auto view = Containers::stridedArrayView(vertices);
+    return Trade::MeshData{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&BenchmarkVertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&BenchmarkVertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&BenchmarkVertex::jointIds), UnsignedShort(influenceCount)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&BenchmarkVertex::weights), UnsignedShort(influenceCount)}
+    }};
+}
+
+void SkinTest::multithreaded() {
+    auto&& data = MultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Not a multiple of the thread count to test that the last range is
+       handled correctly */
+    Containers::Array<BenchmarkVertex> vertices{4*4096 + 17};
+    Trade::MeshData mesh = benchmarkMesh(vertices, 4);
+
+    Containers::Array<Vector3> expectedPositions{NoInit, vertices.size()};
+    Containers::Array<Vector3> expectedNormals{NoInit, vertices.size()};
+    skinInto(mesh, JointMatrices, expectedPositions, expectedNormals);
+
+    Containers::Array<Vector3> positions{NoInit, vertices.size()};
+    Containers::Array<Vector3> normals{NoInit, vertices.size()};
+    skinInto(mesh, JointMatrices, positions, normals, nullptr, data.threadCount);
+    CORRADE_COMPARE_AS(positions, expectedPositions,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(normals, expectedNormals,
+        TestSuite::Compare::Container);
+}
+
+void SkinTest::invalidMesh() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData noPositions{MeshPrimitive::Points, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds, VertexFormat::UnsignedInt, nullptr, 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights, VertexFormat::Float, nullptr, 4}
+    }};
+    Trade::MeshData positions2D{MeshPrimitive::Points, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector2, nullptr},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds, VertexFormat::UnsignedInt, nullptr, 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights, VertexFormat::Float, nullptr, 4}
+    }};
+    Trade::MeshData positionsImplementationSpecific{MeshPrimitive::Points, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertexFormatWrap(0xdead), nullptr},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds, VertexFormat::UnsignedInt, nullptr, 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights, VertexFormat::Float, nullptr, 4}
+    }};
+    Trade::MeshData noJoints{MeshPrimitive::Points, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    skinInto(noPositions, JointMatrices, nullptr);
+    skinInto(positions2D, JointMatrices, nullptr);
+    skinInto(positionsImplementationSpecific, JointMatrices, nullptr);
+    skinInto(noJoints, JointMatrices, nullptr);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinInto(): the mesh has no positions\n"
+        "MeshTools::skinInto(): expected 3D positions but got VertexFormat::Vector2\n"
+        "MeshTools::skinInto(): positions have an implementation-specific format 0xdead\n"
+        "MeshTools::skinInto(): the mesh has no joint IDs\n");
+}
+
+void SkinTest::invalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector3 tangent;
+        UnsignedInt jointIds[4];
+        Float weights[4];
+    } vertices[3]{};
+    auto view = Containers::stridedArrayView(vertices);
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+    Trade::MeshData meshWithNormalsTangents{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+            view.slice(&Vertex::tangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedInt, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 data[4];
+    std::ostringstream out;
+    Error redirectError{&out};
+    skinInto(mesh, JointMatrices, Containers::arrayView(data).prefix(4));
+    skinInto(meshWithNormalsTangents, JointMatrices, Containers::arrayView(data).prefix(3), Containers::arrayView(data).prefix(2));
+    skinInto(mesh, JointMatrices, Containers::arrayView(data).prefix(3), Containers::arrayView(data).prefix(3));
+    skinInto(meshWithNormalsTangents, JointMatrices, Containers::arrayView(data).prefix(3), nullptr, Containers::arrayView(data).prefix(4));
+    skinInto(mesh, JointMatrices, Containers::arrayView(data).prefix(3), nullptr, Containers::arrayView(data).prefix(3));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinInto(): expected 3 positions but got 4\n"
+        "MeshTools::skinInto(): expected either no or 3 normals but got 2\n"
+        "MeshTools::skinInto(): the mesh has no normals\n"
+        "MeshTools::skinInto(): expected either no or 3 tangents but got 4\n"
+        "MeshTools::skinInto(): the mesh has no tangents\n");
+}
+
+void SkinTest::jointIdOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct Vertex {
+        Vector3 position;
+        UnsignedByte jointIds[4];
+        Float weights[4];
+    } vertices[]{
+        {{}, {0, 1, 2, 3}, {}},
+        {{}, {3, 4, 0, 1}, {}},
+    };
+    auto view = Containers::stridedArrayView(vertices);
+
+    /* Packed to verify the check is done also on the converted data */
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::JointIds,
+            VertexFormat::UnsignedByte, view.slice(&Vertex::jointIds), 4},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Weights,
+            VertexFormat::Float, view.slice(&Vertex::weights), 4}
+    }};
+
+    Vector3 positions[2];
+    std::ostringstream out;
+    Error redirectError{&out};
+    skinInto(mesh, JointMatrices, positions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinInto(): joint ID 4 out of range for 4 joints\n");
+}
+
+void SkinTest::benchmarkMatrices4() {
+    Containers::Array<BenchmarkVertex> vertices{100000};
+    Trade::MeshData mesh = benchmarkMesh(vertices, 4);
+    Containers::Array<Vector3> positions{NoInit, vertices.size()};
+    Containers::Array<Vector3> normals{NoInit, vertices.size()};
+
+    CORRADE_BENCHMARK(5)
+        skinInto(mesh, JointMatrices, positions, normals);
+
+    CORRADE_COMPARE(positions[0], (Vector3{0.25f, 0.5f, 0.0f}));
+}
+
+void SkinTest::benchmarkMatrices8() {
+    Containers::Array<BenchmarkVertex> vertices{100000};
+    Trade::MeshData mesh = benchmarkMesh(vertices, 8);
+    Containers::Array<Vector3> positions{NoInit, vertices.size()};
+    Containers::Array<Vector3> normals{NoInit, vertices.size()};
+
+    CORRADE_BENCHMARK(5)
+        skinInto(mesh, JointMatrices, positions, normals);
+
+    CORRADE_COMPARE(positions[0], (Vector3{0.25f, 0.5f, 0.0f}));
+}
+
+void SkinTest::benchmarkMatrices4Multithreaded() {
+    Containers::Array<BenchmarkVertex> vertices{100000};
+    Trade::MeshData mesh = benchmarkMesh(vertices, 4);
+    Containers::Array<Vector3> positions{NoInit, vertices.size()};
+    Containers::Array<Vector3> normals{NoInit, vertices.size()};
+
+    CORRADE_BENCHMARK(5)
+        skinInto(mesh, JointMatrices, positions, normals, nullptr, 0);
+
+    CORRADE_COMPARE(positions[0], (Vector3{0.25f, 0.5f, 0.0f}));
+}
+
+void SkinTest::benchmarkDualQuaternions4() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f}),
+        DualQuaternion::translation({0.0f, 2.0f, 0.0f}),
+        DualQuaternion::rotation(90.0_degf, Vector3::zAxis()),
+        DualQuaternion::rotation(-90.0_degf, Vector3::zAxis())
+    };
+
+    Containers::Array<BenchmarkVertex> vertices{100000};
+    Trade::MeshData mesh = benchmarkMesh(vertices, 4);
+    Containers::Array<Vector3> positions{NoInit, vertices.size()};
+    Containers::Array<Vector3> normals{NoInit, vertices.size()};
+
+    CORRADE_BENCHMARK(5)
+        skinInto(mesh, joints, positions, normals);
+
+    /* The rotations cancel out, but contribute to the normalization factor
+       of the blended dual quaternion, which scales the translation */
+    CORRADE_COMPARE(positions[0], (Vector3{0.25f, 0.5f, 0.0f}/(0.5f + 0.5f*Constants::sqrtHalf())));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
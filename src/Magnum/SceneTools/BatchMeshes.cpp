@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchMeshes.h"
+
+#include <map>
+#include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/Hierarchy.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Mirrors what MeshTools::concatenate() accepts */
+bool isConcatenable(const Trade::MeshData& mesh) {
+    const MeshPrimitive primitive = mesh.primitive();
+    if(isMeshPrimitiveImplementationSpecific(primitive) ||
+       primitive == MeshPrimitive::LineStrip ||
+       primitive == MeshPrimitive::LineLoop ||
+       primitive == MeshPrimitive::TriangleStrip ||
+       primitive == MeshPrimitive::TriangleFan)
+        return false;
+    if(mesh.isIndexed() && isMeshIndexTypeImplementationSpecific(mesh.indexType()))
+        return false;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        if(isVertexFormatImplementationSpecific(mesh.attributeFormat(i)))
+            return false;
+    return true;
+}
+
+bool isLayoutCompatible(const Trade::MeshData& a, const Trade::MeshData& b) {
+    if(a.primitive() != b.primitive() ||
+       a.attributeCount() != b.attributeCount())
+        return false;
+    for(UnsignedInt i = 0; i != a.attributeCount(); ++i) {
+        if(a.attributeName(i) != b.attributeName(i) ||
+           a.attributeFormat(i) != b.attributeFormat(i) ||
+           a.attributeArraySize(i) != b.attributeArraySize(i) ||
+           a.attributeMorphTargetId(i) != b.attributeMorphTargetId(i))
+            return false;
+    }
+    return true;
+}
+
+/* Same checks as in MeshTools::transform3D(Trade::MeshData&&, ...) */
+bool isTransformableInPlace(const Trade::MeshData& mesh) {
+    const Containers::Optional<UnsignedInt> positionAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Position);
+    const Containers::Optional<UnsignedInt> tangentAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Tangent);
+    const Containers::Optional<UnsignedInt> bitangentAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Bitangent);
+    const Containers::Optional<UnsignedInt> normalAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Normal);
+    return positionAttributeId && mesh.attributeFormat(*positionAttributeId) == VertexFormat::Vector3 &&
+       (!tangentAttributeId || mesh.attributeFormat(*tangentAttributeId) == VertexFormat::Vector3 || mesh.attributeFormat(*tangentAttributeId) == VertexFormat::Vector4) &&
+       (!bitangentAttributeId || mesh.attributeFormat(*bitangentAttributeId) == VertexFormat::Vector3) &&
+       (!normalAttributeId || mesh.attributeFormat(*normalAttributeId) == VertexFormat::Vector3);
+}
+
+/* Equivalent to MeshTools::transform3DInPlace() but restricted to a vertex
+   range. Expects that isTransformableInPlace() returned true for the mesh. */
+void transformVerticesInPlace(Trade::MeshData& mesh, const Matrix4& transformation, const std::size_t offset, const std::size_t count) {
+    /** @todo this needs a proper batch implementation */
+    for(Vector3& position: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Position).sliceSize(offset, count))
+        position = transformation.transformPoint(position);
+
+    const Containers::Optional<UnsignedInt> tangentAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Tangent);
+    const Containers::Optional<UnsignedInt> bitangentAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Bitangent);
+    const Containers::Optional<UnsignedInt> normalAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Normal);
+    if(!tangentAttributeId && !bitangentAttributeId && !normalAttributeId)
+        return;
+
+    const Matrix3x3 normalMatrix = transformation.normalMatrix();
+    if(tangentAttributeId) {
+        if(mesh.attributeFormat(*tangentAttributeId) == VertexFormat::Vector3)
+            for(Vector3& tangent: mesh.mutableAttribute<Vector3>(*tangentAttributeId).sliceSize(offset, count))
+                tangent = normalMatrix*tangent;
+        else for(Vector4& tangent: mesh.mutableAttribute<Vector4>(*tangentAttributeId).sliceSize(offset, count))
+            tangent.xyz() = normalMatrix*tangent.xyz();
+    }
+    if(bitangentAttributeId) for(Vector3& bitangent: mesh.mutableAttribute<Vector3>(*bitangentAttributeId).sliceSize(offset, count))
+        bitangent = normalMatrix*bitangent;
+    if(normalAttributeId) for(Vector3& normal: mesh.mutableAttribute<Vector3>(*normalAttributeId).sliceSize(offset, count))
+        normal = normalMatrix*normal;
+}
+
+}
+
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshes3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes, const Matrix4& globalTransformation) {
+    CORRADE_ASSERT(scene.is3D(),
+        "SceneTools::batchMeshes3D(): the scene is not 3D",
+        (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+    const Containers::Optional<UnsignedInt> meshFieldId = scene.findFieldId(Trade::SceneField::Mesh);
+    CORRADE_ASSERT(meshFieldId,
+        "SceneTools::batchMeshes3D(): the scene has no meshes",
+        (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Parent),
+        "SceneTools::batchMeshes3D(): the scene has no hierarchy",
+        (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+
+    /* Mesh and material assignments together with absolute transformations,
+       both in the order of the mesh field */
+    const Containers::Array<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>> meshesMaterials = scene.meshesMaterialsAsArray();
+    const Containers::Array<Matrix4> transformations = absoluteFieldTransformations3D(scene, *meshFieldId, globalTransformation);
+    CORRADE_INTERNAL_ASSERT(meshesMaterials.size() == transformations.size());
+
+    /* Classify the meshes by their vertex layout. Meshes that can't be
+       concatenated are left unclassified. The layouts are compared one by
+       one, but the count of distinct layouts is usually very small compared
+       to the mesh count. */
+    Containers::Array<UnsignedInt> meshLayouts{NoInit, meshes.size()};
+    Containers::BitArray concatenable{ValueInit, meshes.size()};
+    Containers::Array<UnsignedInt> layoutRepresentatives;
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        if(!isConcatenable(meshes[i])) continue;
+
+        concatenable.set(i);
+        std::size_t layout = 0;
+        for(; layout != layoutRepresentatives.size(); ++layout)
+            if(isLayoutCompatible(meshes[layoutRepresentatives[layout]], meshes[i]))
+                break;
+        if(layout == layoutRepresentatives.size())
+            arrayAppend(layoutRepresentatives, UnsignedInt(i));
+        meshLayouts[i] = layout;
+    }
+
+    /* Assign each mesh instance to a batch, in the order in which they
+       appear. Instances of meshes that can't be concatenated each get a batch
+       of their own. */
+    Containers::Array<UnsignedInt> instanceBatches{NoInit, meshesMaterials.size()};
+    Containers::Array<UnsignedInt> batchInstanceOffsets{ValueInit, 1};
+    std::map<std::pair<Int, UnsignedInt>, UnsignedInt> batchIds;
+    for(std::size_t i = 0; i != meshesMaterials.size(); ++i) {
+        const UnsignedInt meshId = meshesMaterials[i].second().first();
+        CORRADE_ASSERT(meshId < meshes.size(),
+            "SceneTools::batchMeshes3D(): mesh" << meshId << "out of range for" << meshes.size() << "meshes",
+            (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+        CORRADE_ASSERT(meshes[meshId].hasAttribute(Trade::MeshAttribute::Position),
+            "SceneTools::batchMeshes3D(): mesh" << meshId << "has no positions",
+            (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+        #ifndef CORRADE_NO_ASSERT
+        /* Same as what MeshTools::transform3D() asserts on, as it's used for
+           meshes that can't be transformed in-place */
+        {
+            const Trade::MeshData& mesh = meshes[meshId];
+            const VertexFormat positionFormat = mesh.attributeFormat(Trade::MeshAttribute::Position);
+            CORRADE_ASSERT(!isVertexFormatImplementationSpecific(positionFormat),
+                "SceneTools::batchMeshes3D(): mesh" << meshId << "positions have an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(positionFormat)),
+                (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+            CORRADE_ASSERT(vertexFormatComponentCount(positionFormat) == 3,
+                "SceneTools::batchMeshes3D(): expected mesh" << meshId << "to have 3D positions but got" << positionFormat,
+                (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+            for(const Containers::Pair<Trade::MeshAttribute, const char*> attribute: {
+                Containers::pair(Trade::MeshAttribute::Normal, "normals"),
+                Containers::pair(Trade::MeshAttribute::Tangent, "tangents"),
+                Containers::pair(Trade::MeshAttribute::Bitangent, "bitangents")
+            }) {
+                const Containers::Optional<UnsignedInt> attributeId = mesh.findAttributeId(attribute.first());
+                CORRADE_ASSERT(!attributeId || !isVertexFormatImplementationSpecific(mesh.attributeFormat(*attributeId)),
+                    "SceneTools::batchMeshes3D(): mesh" << meshId << attribute.second() << "have an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(mesh.attributeFormat(*attributeId))),
+                    (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, Containers::Array<Trade::MeshData>{}}));
+            }
+        }
+        #endif
+
+        UnsignedInt batchId;
+        if(concatenable[meshId]) {
+            const UnsignedInt nextBatchId = batchInstanceOffsets.size() - 1;
+            batchId = batchIds.emplace(std::make_pair(meshesMaterials[i].second().second(), meshLayouts[meshId]), nextBatchId).first->second;
+        } else batchId = batchInstanceOffsets.size() - 1;
+
+        /* A new batch, the offsets array gets turned into actual offsets
+           below */
+        if(batchId == batchInstanceOffsets.size() - 1)
+            arrayAppend(batchInstanceOffsets, 0u);
+        ++batchInstanceOffsets[batchId + 1];
+        instanceBatches[i] = batchId;
+    }
+
+    /* Turn the counts into offsets and sort the instances by their batch,
+       preserving their relative order */
+    const std::size_t batchCount = batchInstanceOffsets.size() - 1;
+    for(std::size_t i = 0; i != batchCount; ++i)
+        batchInstanceOffsets[i + 1] += batchInstanceOffsets[i];
+    Containers::Array<UnsignedInt> batchInstances{NoInit, meshesMaterials.size()};
+    {
+        Containers::Array<UnsignedInt> batchInstanceCounts{ValueInit, batchCount};
+        for(std::size_t i = 0; i != meshesMaterials.size(); ++i) {
+            const UnsignedInt batchId = instanceBatches[i];
+            batchInstances[batchInstanceOffsets[batchId] + batchInstanceCounts[batchId]++] = i;
+        }
+    }
+
+    /* Allocate the output scene. Every batch is a top-level object with an
+       implicit mapping. */
+    Containers::ArrayView<UnsignedInt> outputMapping;
+    Containers::ArrayView<Int> outputParents;
+    Containers::ArrayView<UnsignedInt> outputMeshes;
+    Containers::ArrayView<Int> outputMaterials;
+    Containers::Array<char> outputData = Containers::ArrayTuple{
+        {NoInit, batchCount, outputMapping},
+        {NoInit, batchCount, outputParents},
+        {NoInit, batchCount, outputMeshes},
+        {NoInit, batchCount, outputMaterials},
+    };
+
+    /* Concatenate the instances in each batch */
+    Containers::Array<Trade::MeshData> outputMeshData;
+    arrayReserve(outputMeshData, batchCount);
+    for(std::size_t i = 0; i != batchCount; ++i) {
+        const Containers::ArrayView<const UnsignedInt> instances = batchInstances.slice(batchInstanceOffsets[i], batchInstanceOffsets[i + 1]);
+        CORRADE_INTERNAL_ASSERT(!instances.isEmpty());
+        const UnsignedInt firstMeshId = meshesMaterials[instances[0]].second().first();
+        const Trade::MeshData& firstMesh = meshes[firstMeshId];
+
+        outputMapping[i] = i;
+        outputParents[i] = -1;
+        outputMeshes[i] = i;
+        outputMaterials[i] = meshesMaterials[instances[0]].second().second();
+
+        /* A mesh that can't be concatenated, just transform it */
+        if(!concatenable[firstMeshId]) {
+            CORRADE_INTERNAL_ASSERT(instances.size() == 1);
+            arrayAppend(outputMeshData, MeshTools::transform3D(firstMesh, transformations[instances[0]]));
+
+        /* If the attributes are in a format that can be transformed in-place,
+           copy all instances into the output just once and transform each
+           vertex range afterwards. The concatenated output is always owned
+           and mutable. */
+        } else if(isTransformableInPlace(firstMesh)) {
+            Containers::Array<Containers::Reference<const Trade::MeshData>> instanceMeshes;
+            arrayReserve(instanceMeshes, instances.size());
+            for(const UnsignedInt instance: instances)
+                arrayAppend(instanceMeshes, InPlaceInit, meshes[meshesMaterials[instance].second().first()]);
+
+            Trade::MeshData batch = MeshTools::concatenate(Containers::arrayView(instanceMeshes));
+            std::size_t vertexOffset = 0;
+            for(std::size_t j = 0; j != instances.size(); ++j) {
+                const UnsignedInt vertexCount = instanceMeshes[j]->vertexCount();
+                transformVerticesInPlace(batch, transformations[instances[j]], vertexOffset, vertexCount);
+                vertexOffset += vertexCount;
+            }
+            CORRADE_INTERNAL_ASSERT(vertexOffset == batch.vertexCount());
+
+            arrayAppend(outputMeshData, Utility::move(batch));
+
+        /* Otherwise transform each instance first, which expands the
+           attributes to floats, and concatenate the result */
+        } else {
+            Containers::Array<Trade::MeshData> transformed;
+            arrayReserve(transformed, instances.size());
+            for(const UnsignedInt instance: instances)
+                arrayAppend(transformed, MeshTools::transform3D(meshes[meshesMaterials[instance].second().first()], transformations[instance]));
+
+            arrayAppend(outputMeshData, MeshTools::concatenate(transformed));
+        }
+    }
+
+    Trade::SceneData outputScene{Trade::SceneMappingType::UnsignedInt, batchCount, Utility::move(outputData), {
+        Trade::SceneFieldData{Trade::SceneField::Parent, outputMapping, outputParents, Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, outputMapping, outputMeshes, Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial, outputMapping, outputMaterials, Trade::SceneFieldFlag::ImplicitMapping},
+    }};
+
+    return {Utility::move(outputScene), Utility::move(outputMeshData)};
+}
+
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshes3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes) {
+    return batchMeshes3D(scene, meshes, {});
+}
+
+}}
@@ -0,0 +1,110 @@
+#ifndef Magnum_SceneTools_BatchMeshes_h
+#define Magnum_SceneTools_BatchMeshes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::batchMeshes3D()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Batch 3D mesh instances by material and vertex layout
+@param scene                Input scene
+@param meshes               Meshes referenced by the scene
+@param globalTransformation Global transformation to prepend
+@return A scene referencing the batched meshes and the batched meshes
+@m_since_latest
+
+Takes all @ref Trade::SceneField::Mesh assignments in @p scene, groups them by
+@ref Trade::SceneField::MeshMaterial and by a compatible vertex layout of the
+referenced mesh --- i.e., the same @ref MeshPrimitive and the same attribute
+names, formats, array sizes and morph target IDs in the same order --- and
+produces a single mesh for each group. Vertices of each mesh instance get
+transformed with its absolute transformation calculated using
+@ref absoluteFieldTransformations3D() and all instances in a group are
+concatenated together with @ref MeshTools::concatenate().
+
+The returned scene has one object for each batched mesh, with a
+@ref Trade::SceneField::Parent, @ref Trade::SceneField::Mesh and
+@ref Trade::SceneField::MeshMaterial field, all of them having
+@ref Trade::SceneFieldFlag::ImplicitMapping. All objects are top-level and
+have an identity transformation. Objects without a mesh and all other fields
+are not present in the output --- in particular, because the object IDs change,
+anything that references the original objects such as
+@ref Trade::SceneField::Skin or animations can't be preserved. The batched
+meshes are in the order in which their first instance appears in the
+@ref Trade::SceneField::Mesh field, material IDs are passed through
+unchanged.
+
+The @p scene is expected to be 3D and contain a @ref Trade::SceneField::Mesh
+and a @ref Trade::SceneField::Parent field. Mesh IDs are expected to be less
+than @p meshes size and all referenced meshes are expected to contain a
+three-dimensional @ref Trade::MeshAttribute::Position. The position,
+@ref Trade::MeshAttribute::Normal, @ref Trade::MeshAttribute::Tangent and
+@ref Trade::MeshAttribute::Bitangent attributes are expected to not have an
+implementation-specific format, as they need to be transformed. Meshes with
+@ref MeshPrimitive::LineStrip, @ref MeshPrimitive::LineLoop,
+@ref MeshPrimitive::TriangleStrip, @ref MeshPrimitive::TriangleFan or with an
+implementation-specific primitive, index type or format of other attributes
+can't be
+concatenated, each instance of those is thus put into a batch of its own with
+just the transformation applied.
+
+If the position, normal and bitangent attributes are
+@ref VertexFormat::Vector3 and tangents @ref VertexFormat::Vector3 or
+@ref VertexFormat::Vector4, the untransformed meshes of a group are copied
+just once into the concatenated output and the transformations are then
+applied in-place on vertex ranges belonging to each instance. Otherwise each
+instance is first transformed using @ref MeshTools::transform3D(), which
+expands the attributes to floating-point types, and the results are
+concatenated afterwards.
+
+@experimental
+
+@see @ref Trade::SceneData::is3D(),
+    @ref Trade::SceneData::meshesMaterialsAsArray()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshes3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes, const Matrix4& globalTransformation = {});
+#else
+/* To avoid including Matrix4 */
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshes3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes, const Matrix4& globalTransformation);
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshes3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes);
+#endif
+
+}}
+
+#endif
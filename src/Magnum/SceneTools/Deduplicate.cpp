@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Deduplicate.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Each item is serialized into a contiguous buffer in a canonical form that
+   doesn't depend on the data layout, which is then hashed or compared */
+
+template<class T> void appendValue(Containers::Array<char>& out, const T value) {
+    arrayAppend(out, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void appendString(Containers::Array<char>& out, const Containers::StringView value) {
+    appendValue(out, value.size());
+    arrayAppend(out, Containers::ArrayView<const char>{value.data(), value.size()});
+}
+
+template<unsigned dimensions> void appendData(Containers::Array<char>& out, const Containers::StridedArrayView<dimensions, const char>& data) {
+    std::size_t size = 1;
+    for(std::size_t i = 0; i != dimensions; ++i)
+        size *= data.size()[i];
+    Utility::copy(data, Containers::StridedArrayView<dimensions, char>{arrayAppend(out, NoInit, size), data.size()});
+}
+
+void serialize(Containers::Array<char>& out, const Trade::MeshData& mesh) {
+    appendValue(out, UnsignedInt(mesh.primitive()));
+    appendValue(out, mesh.vertexCount());
+
+    /* Index types are never zero, so this can't be confused with an indexed
+       mesh */
+    if(mesh.isIndexed()) {
+        appendValue(out, UnsignedInt(mesh.indexType()));
+        appendValue(out, mesh.indexCount());
+        appendData(out, mesh.indices());
+    } else appendValue(out, UnsignedInt{});
+
+    appendValue(out, mesh.attributeCount());
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        appendValue(out, UnsignedShort(mesh.attributeName(i)));
+        appendValue(out, UnsignedInt(mesh.attributeFormat(i)));
+        appendValue(out, mesh.attributeArraySize(i));
+        appendValue(out, mesh.attributeMorphTargetId(i));
+        appendData(out, mesh.attribute(i));
+    }
+}
+
+void serialize(Containers::Array<char>& out, const Trade::MaterialData& material) {
+    appendValue(out, UnsignedInt(material.types()));
+    appendValue(out, material.layerCount());
+    for(UnsignedInt layer = 0; layer != material.layerCount(); ++layer) {
+        appendValue(out, material.attributeCount(layer));
+        for(UnsignedInt i = 0; i != material.attributeCount(layer); ++i) {
+            const Trade::MaterialAttributeType type = material.attributeType(layer, i);
+            appendString(out, material.attributeName(layer, i));
+            appendValue(out, UnsignedByte(type));
+            if(type == Trade::MaterialAttributeType::String)
+                appendString(out, material.attribute<Containers::StringView>(layer, i));
+            else if(type == Trade::MaterialAttributeType::Buffer) {
+                const Containers::ArrayView<const void> buffer = material.attribute<Containers::ArrayView<const void>>(layer, i);
+                appendString(out, {static_cast<const char*>(buffer.data()), buffer.size()});
+            } else arrayAppend(out, Containers::ArrayView<const char>{static_cast<const char*>(material.attribute(layer, i)), Trade::materialAttributeTypeSize(type)});
+        }
+    }
+}
+
+template<UnsignedInt dimensions> void serialize(Containers::Array<char>& out, const Trade::ImageData<dimensions>& image) {
+    appendValue(out, UnsignedShort(image.flags()));
+    appendValue(out, image.size());
+    appendValue(out, UnsignedByte(image.isCompressed()));
+
+    /* The compressed data layout is fully defined by the format and size */
+    if(image.isCompressed()) {
+        appendValue(out, UnsignedInt(image.compressedFormat()));
+        arrayAppend(out, image.data());
+
+    /* For uncompressed images the pixel storage may include arbitrary padding
+       and skip, take just the actual pixels */
+    } else {
+        appendValue(out, UnsignedInt(image.format()));
+        appendValue(out, image.formatExtra());
+        appendValue(out, image.pixelSize());
+        appendData(out, image.pixels());
+    }
+}
+
+template<class T> Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicate(const Containers::Iterable<const T>& items, const UnsignedInt threadCount) {
+    const std::size_t actualThreadCount = Magnum::Implementation::threadCount(threadCount);
+
+    /* Serialization buffers, one for each thread and reused for all items it
+       processes to avoid allocating for each */
+    Containers::Array<Containers::Array<char>> data{actualThreadCount};
+    Containers::Array<Containers::Array<char>> candidateData{actualThreadCount};
+
+    /* Hash each item, together with its index. As opposed to
+       MeshTools::removeDuplicates(), the items can be large, so it's not
+       feasible to keep their serialized form around for comparison. Instead,
+       on a hash match the items are serialized again and compared. */
+    Containers::Array<Containers::Pair<std::size_t, UnsignedInt>> hashes{NoInit, items.size()};
+    Magnum::Implementation::parallelForThread(items.size(), actualThreadCount, [&](const std::size_t thread, const std::size_t i) {
+        arrayResize(data[thread], 0);
+        serialize(data[thread], items[i]);
+        hashes[i] = {*reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(data[thread].data(), data[thread].size()).byteArray()), UnsignedInt(i)};
+    });
+
+    /* Sort by the hash and then by the index, so items with the same hash are
+       next to each other in the order in which they occur */
+    std::sort(hashes.begin(), hashes.end(), [](const Containers::Pair<std::size_t, UnsignedInt>& a, const Containers::Pair<std::size_t, UnsignedInt>& b) {
+        return a.first() < b.first() || (a.first() == b.first() && a.second() < b.second());
+    });
+
+    /* Find where each run of items with the same hash starts, in a single
+       pass over the sorted hashes */
+    Containers::Array<std::size_t> runBegin{NoInit, hashes.size()};
+    for(std::size_t i = 0; i != hashes.size(); ++i)
+        runBegin[i] = i && hashes[i - 1].first() == hashes[i].first() ? runBegin[i - 1] : i;
+
+    /* For each item find the first earlier item that's equal to it. That one
+       is always a first occurrence of a unique item, as if it were a
+       duplicate of an even earlier item, that one would be equal to this item
+       as well. Items with a unique hash are trivially first occurrences. */
+    Containers::Array<UnsignedInt> firstOccurrence{NoInit, items.size()};
+    Magnum::Implementation::parallelForThread(hashes.size(), actualThreadCount, [&](const std::size_t thread, const std::size_t i) {
+        const UnsignedInt index = hashes[i].second();
+        firstOccurrence[index] = index;
+
+        const std::size_t begin = runBegin[i];
+        if(begin == i) return;
+
+        arrayResize(data[thread], 0);
+        serialize(data[thread], items[index]);
+        for(std::size_t j = begin; j != i; ++j) {
+            const UnsignedInt candidate = hashes[j].second();
+            arrayResize(candidateData[thread], 0);
+            serialize(candidateData[thread], items[candidate]);
+            if(candidateData[thread].size() == data[thread].size() && std::memcmp(candidateData[thread].data(), data[thread].data(), data[thread].size()) == 0) {
+                firstOccurrence[index] = candidate;
+                break;
+            }
+        }
+    });
+
+    /* Assign the unique IDs in order of first occurrence */
+    Containers::Array<UnsignedInt> mapping{NoInit, items.size()};
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != items.size(); ++i)
+        mapping[i] = firstOccurrence[i] == i ? uniqueCount++ : mapping[firstOccurrence[i]];
+
+    return {Utility::move(mapping), uniqueCount};
+}
+
+template<class T> void remapInPlace(const Containers::StridedArrayView1D<T>& field, const Containers::StridedArrayView1D<const UnsignedInt>& mapping, const char*
+    #ifndef CORRADE_NO_ASSERT
+    name
+    #endif
+    , const Trade::SceneFieldType
+    #ifndef CORRADE_NO_ASSERT
+    type
+    #endif
+) {
+    for(T& id: field) {
+        /* Materials can be -1. Casting to avoid a warning about the
+           comparison being always false for unsigned types. */
+        if(Long(id) < 0) continue;
+        CORRADE_ASSERT(std::size_t(id) < mapping.size(),
+            "SceneTools::remapMeshesMaterialsInPlace():" << name << id << "out of range for" << mapping.size() << "mapping entries", );
+        const UnsignedInt mapped = mapping[id];
+        CORRADE_ASSERT(mapped <= UnsignedInt(std::numeric_limits<T>::max()),
+            "SceneTools::remapMeshesMaterialsInPlace(): mapped" << name << mapped << "doesn't fit into" << type, );
+        id = T(mapped);
+    }
+}
+
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateMeshes(const Containers::Iterable<const Trade::MeshData>& meshes, const UnsignedInt threadCount) {
+    return deduplicate(meshes, threadCount);
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateMaterials(const Containers::Iterable<const Trade::MaterialData>& materials, const UnsignedInt threadCount) {
+    return deduplicate(materials, threadCount);
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages1D(const Containers::Iterable<const Trade::ImageData1D>& images, const UnsignedInt threadCount) {
+    return deduplicate(images, threadCount);
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages2D(const Containers::Iterable<const Trade::ImageData2D>& images, const UnsignedInt threadCount) {
+    return deduplicate(images, threadCount);
+}
+
+Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages3D(const Containers::Iterable<const Trade::ImageData3D>& images, const UnsignedInt threadCount) {
+    return deduplicate(images, threadCount);
+}
+
+void remapMeshesMaterialsInPlace(Trade::SceneData& scene, const Containers::StridedArrayView1D<const UnsignedInt>& meshMapping, const Containers::StridedArrayView1D<const UnsignedInt>& materialMapping) {
+    CORRADE_ASSERT(scene.dataFlags() & Trade::DataFlag::Mutable,
+        "SceneTools::remapMeshesMaterialsInPlace(): data not mutable", );
+
+    const Containers::Optional<UnsignedInt> meshFieldId = scene.findFieldId(Trade::SceneField::Mesh);
+    if(meshFieldId && !meshMapping.isEmpty()) {
+        const Trade::SceneFieldType type = scene.fieldType(*meshFieldId);
+        if(type == Trade::SceneFieldType::UnsignedInt)
+            remapInPlace(scene.mutableField<UnsignedInt>(*meshFieldId), meshMapping, "mesh", type);
+        else if(type == Trade::SceneFieldType::UnsignedShort)
+            remapInPlace(scene.mutableField<UnsignedShort>(*meshFieldId), meshMapping, "mesh", type);
+        else if(type == Trade::SceneFieldType::UnsignedByte)
+            remapInPlace(scene.mutableField<UnsignedByte>(*meshFieldId), meshMapping, "mesh", type);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    const Containers::Optional<UnsignedInt> materialFieldId = scene.findFieldId(Trade::SceneField::MeshMaterial);
+    if(materialFieldId && !materialMapping.isEmpty()) {
+        const Trade::SceneFieldType type = scene.fieldType(*materialFieldId);
+        if(type == Trade::SceneFieldType::Int)
+            remapInPlace(scene.mutableField<Int>(*materialFieldId), materialMapping, "material", type);
+        else if(type == Trade::SceneFieldType::Short)
+            remapInPlace(scene.mutableField<Short>(*materialFieldId), materialMapping, "material", type);
+        else if(type == Trade::SceneFieldType::Byte)
+            remapInPlace(scene.mutableField<Byte>(*materialFieldId), materialMapping, "material", type);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}}
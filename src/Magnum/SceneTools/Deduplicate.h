@@ -0,0 +1,161 @@
+#ifndef Magnum_SceneTools_Deduplicate_h
+#define Magnum_SceneTools_Deduplicate_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::deduplicateMeshes(), @ref Magnum::SceneTools::deduplicateMaterials(), @ref Magnum::SceneTools::deduplicateImages1D(), @ref Magnum::SceneTools::deduplicateImages2D(), @ref Magnum::SceneTools::deduplicateImages3D(), @ref Magnum::SceneTools::remapMeshesMaterialsInPlace()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Find duplicate meshes
+@param meshes       Meshes to deduplicate
+@param threadCount  Worker thread count. If @cpp 0 @ce, the count is
+    autodetected from available hardware concurrency.
+@return Mapping from each mesh to a unique mesh ID and the unique mesh count
+@m_since_latest
+
+Two meshes are considered equal if they have the same
+@ref MeshPrimitive, vertex count, index type and index values, and the same
+attributes in the same order with the same names, formats, array sizes, morph
+target IDs and data. The actual data layout, i.e. interleaving, strides or
+padding, isn't taken into account. Comparison is bit-exact, if you need
+fuzzy matching of floating-point data, use @ref MeshTools::removeDuplicatesFuzzy()
+on the meshes first.
+
+The first array in the returned pair has the same size as @p meshes. Unique
+IDs are assigned in the order in which each unique mesh first occurs in
+@p meshes, i.e. mesh @cpp i @ce is the first occurrence of a unique mesh if
+and only if the ID at index @cpp i @ce is equal to the count of unique meshes
+found before it. The unique meshes can be thus extracted in a single pass:
+
+@snippet MagnumSceneTools.cpp deduplicateMeshes
+
+Each mesh is serialized into a contiguous buffer and hashed exactly once,
+meshes with a matching hash are then compared byte-by-byte to rule out
+collisions, which is done in an @f$ \mathcal{O}(n) @f$ execution time
+proportional to the total data size. Both the hashing and the comparison is
+done from @p threadCount threads including the calling thread, each thread
+picking the next not-yet-processed mesh once it's done with the previous one,
+similarly to @ref Trade::importMeshes(). The result is the same regardless of
+the thread count. If threads are not available on the platform, everything is
+done serially on the calling thread.
+@see @ref remapMeshesMaterialsInPlace()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateMeshes(const Containers::Iterable<const Trade::MeshData>& meshes, UnsignedInt threadCount = 0);
+
+/**
+@brief Find duplicate materials
+@return Mapping from each material to a unique material ID and the unique
+    material count
+@m_since_latest
+
+Two materials are considered equal if they have the same
+@ref Trade::MaterialTypes, the same layer count and the same attributes with
+the same types and values in each layer. Attribute values are compared
+bit-exact, @ref Trade::MaterialAttributeType::Pointer and
+@relativeref{Trade::MaterialAttributeType,MutablePointer} attributes are
+compared by the pointer value. The returned mapping and the @p threadCount
+parameter have the same semantics as in @ref deduplicateMeshes().
+@see @ref remapMeshesMaterialsInPlace()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateMaterials(const Containers::Iterable<const Trade::MaterialData>& materials, UnsignedInt threadCount = 0);
+
+/**
+@brief Find duplicate 1D images
+@return Mapping from each image to a unique image ID and the unique image
+    count
+@m_since_latest
+
+Two images are considered equal if they have the same size,
+@ref Trade::ImageFlags1D, both are either compressed or uncompressed, and
+they have the same @ref PixelFormat, @ref Trade::ImageData::formatExtra() "formatExtra()",
+@ref Trade::ImageData::pixelSize() "pixelSize()" and pixel data in case of
+uncompressed images or the same @ref CompressedPixelFormat and data in case
+of compressed images. @ref PixelStorage parameters of uncompressed images
+aren't taken into account, only the actual pixels. The returned mapping and
+the @p threadCount parameter have the same semantics as in
+@ref deduplicateMeshes().
+@see @ref deduplicateImages2D(), @ref deduplicateImages3D()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages1D(const Containers::Iterable<const Trade::ImageData1D>& images, UnsignedInt threadCount = 0);
+
+/**
+@brief Find duplicate 2D images
+@return Mapping from each image to a unique image ID and the unique image
+    count
+@m_since_latest
+
+Like @ref deduplicateImages1D(), but for 2D images.
+@see @ref deduplicateImages3D()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages2D(const Containers::Iterable<const Trade::ImageData2D>& images, UnsignedInt threadCount = 0);
+
+/**
+@brief Find duplicate 3D images
+@return Mapping from each image to a unique image ID and the unique image
+    count
+@m_since_latest
+
+Like @ref deduplicateImages1D(), but for 3D images.
+@see @ref deduplicateImages2D()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> deduplicateImages3D(const Containers::Iterable<const Trade::ImageData3D>& images, UnsignedInt threadCount = 0);
+
+/**
+@brief Remap mesh and material references in a scene
+@param[in,out] scene    Scene to operate on
+@param[in] meshMapping  Mapping for @ref Trade::SceneField::Mesh
+@param[in] materialMapping Mapping for @ref Trade::SceneField::MeshMaterial
+@m_since_latest
+
+Replaces each ID in the @ref Trade::SceneField::Mesh field with the value at
+given index in @p meshMapping and each non-negative ID in the
+@ref Trade::SceneField::MeshMaterial field with the value at given index in
+@p materialMapping, usually coming from @ref deduplicateMeshes() and
+@ref deduplicateMaterials(). If a field isn't present in the scene or the
+corresponding mapping is empty, the field is left untouched.
+
+The @p scene is expected to have @ref Trade::DataFlag::Mutable data, use
+@ref copy() to make a mutable copy if it doesn't. All IDs in the fields are
+expected to be less than size of the corresponding mapping and the mapped
+values are expected to fit into the field type.
+*/
+MAGNUM_SCENETOOLS_EXPORT void remapMeshesMaterialsInPlace(Trade::SceneData& scene, const Containers::StridedArrayView1D<const UnsignedInt>& meshMapping, const Containers::StridedArrayView1D<const UnsignedInt>& materialMapping);
+
+}}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Order.h"
+
+#include <algorithm> /* std::stable_sort() */
+#include <map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/SceneTools/Combine.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+struct MappingOrder {
+    /* ID of the first field using this mapping */
+    UnsignedInt fieldId;
+    /* Set to false if any field sharing the mapping is a bit or a string
+       field, which can't be reordered at the moment */
+    bool reorderable = true;
+    bool ordered;
+    bool implicit;
+    /* Permutation to apply, empty if the mapping is already ordered */
+    Containers::Array<UnsignedInt> permutation;
+    /* The mapping with the permutation applied, in the original mapping
+       type. Passed to combineFields() as-is, which ensures fields sharing the
+       mapping stay shared. */
+    Containers::Array<char> mapping;
+};
+
+template<class T> void orderMapping(const Containers::StridedArrayView1D<const T>& mapping, MappingOrder& order) {
+    order.ordered = true;
+    for(std::size_t i = 1; i < mapping.size(); ++i) {
+        if(mapping[i] < mapping[i - 1]) {
+            order.ordered = false;
+            break;
+        }
+    }
+
+    /* If not ordered and it's possible to reorder it, calculate the
+       permutation */
+    if(!order.ordered && order.reorderable) {
+        order.permutation = Containers::Array<UnsignedInt>{NoInit, mapping.size()};
+        for(std::size_t i = 0; i != mapping.size(); ++i)
+            order.permutation[i] = i;
+        std::stable_sort(order.permutation.begin(), order.permutation.end(), [&mapping](UnsignedInt a, UnsignedInt b) {
+            return mapping[a] < mapping[b];
+        });
+    }
+
+    /* Check if the (potentially reordered) mapping is implicit. An unordered
+       mapping that can't be reordered is never implicit. */
+    order.implicit = order.ordered || !order.permutation.isEmpty();
+    for(std::size_t i = 0; order.implicit && i != mapping.size(); ++i) {
+        if(mapping[order.permutation.isEmpty() ? i : order.permutation[i]] != i)
+            order.implicit = false;
+    }
+}
+
+/* Copy of a field with different flags, without touching the data. The bit
+   and string fields need dedicated constructors. */
+Trade::SceneFieldData fieldWithFlags(const Trade::SceneFieldData& field, const Trade::SceneFieldFlags flags) {
+    const Trade::SceneFieldType fieldType = field.fieldType();
+    if(fieldType == Trade::SceneFieldType::Bit) {
+        if(field.fieldArraySize())
+            return Trade::SceneFieldData{field.name(),
+                field.mappingType(), field.mappingData(),
+                field.fieldBitData(), flags};
+        return Trade::SceneFieldData{field.name(),
+            field.mappingType(), field.mappingData(),
+            field.fieldBitData().transposed<0, 1>()[0], flags};
+    }
+
+    if(Trade::Implementation::isSceneFieldTypeString(fieldType))
+        return Trade::SceneFieldData{field.name(),
+            field.mappingType(), field.mappingData(),
+            field.stringData(), fieldType, field.fieldData(), flags};
+
+    return Trade::SceneFieldData{field.name(),
+        field.mappingType(), field.mappingData(),
+        fieldType, field.fieldData(),
+        field.fieldArraySize(), flags};
+}
+
+}
+
+Trade::SceneData orderMappings(const Trade::SceneData& scene) {
+    /* Track unique mapping views (pointer, size, stride) so fields that share
+       a mapping get reordered the same way and stay shared after. A
+       map<tuple> is used for the same reason as in filterFieldEntries(). */
+    std::map<std::tuple<const void*, std::size_t, std::ptrdiff_t>, MappingOrder> uniqueMappings;
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        /* Empty fields are trivially ordered, nothing to share for them */
+        if(!scene.fieldSize(i))
+            continue;
+
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        const std::pair<std::map<std::tuple<const void*, std::size_t, std::ptrdiff_t>, MappingOrder>::iterator, bool> inserted = uniqueMappings.emplace(std::make_tuple(mapping.data(), mapping.size()[0], mapping.stride()[0]), MappingOrder{});
+        MappingOrder& order = inserted.first->second;
+        if(inserted.second)
+            order.fieldId = i;
+
+        const Trade::SceneFieldType fieldType = scene.fieldType(i);
+        if(fieldType == Trade::SceneFieldType::Bit || Trade::Implementation::isSceneFieldTypeString(fieldType))
+            order.reorderable = false;
+    }
+
+    /* Calculate the order of each unique mapping, and for the ones that need
+       reordering prepare the reordered mapping data */
+    const std::size_t mappingTypeSize = Trade::sceneMappingTypeSize(scene.mappingType());
+    for(std::pair<const std::tuple<const void*, std::size_t, std::ptrdiff_t>, MappingOrder>& i: uniqueMappings) {
+        MappingOrder& order = i.second;
+        const Trade::SceneMappingType mappingType = scene.mappingType();
+        if(mappingType == Trade::SceneMappingType::UnsignedByte)
+            orderMapping(scene.mapping<UnsignedByte>(order.fieldId), order);
+        else if(mappingType == Trade::SceneMappingType::UnsignedShort)
+            orderMapping(scene.mapping<UnsignedShort>(order.fieldId), order);
+        else if(mappingType == Trade::SceneMappingType::UnsignedInt)
+            orderMapping(scene.mapping<UnsignedInt>(order.fieldId), order);
+        else if(mappingType == Trade::SceneMappingType::UnsignedLong)
+            orderMapping(scene.mapping<UnsignedLong>(order.fieldId), order);
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+        if(order.permutation.isEmpty())
+            continue;
+
+        const Containers::StridedArrayView2D<const char> src = scene.mapping(order.fieldId);
+        order.mapping = Containers::Array<char>{NoInit, mappingTypeSize*src.size()[0]};
+        const Containers::StridedArrayView2D<char> dst{order.mapping, {src.size()[0], mappingTypeSize}};
+        for(std::size_t j = 0; j != order.permutation.size(); ++j)
+            Utility::copy(src[order.permutation[j]], dst[j]);
+    }
+
+    /* Copy all field metadata, update flags of fields that are ordered and
+       turn reordered fields into placeholders */
+    Containers::Array<Trade::SceneFieldData> fields{ValueInit, scene.fieldCount()};
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        const Trade::SceneFieldData field = scene.fieldData(i);
+        const Trade::SceneFieldType fieldType = field.fieldType();
+
+        /* Empty fields are ordered and implicit, but there's no data to
+           reorder */
+        if(!field.size()) {
+            fields[i] = fieldWithFlags(field, field.flags()|Trade::SceneFieldFlag::ImplicitMapping);
+            continue;
+        }
+
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        const MappingOrder& order = uniqueMappings.at(std::make_tuple(mapping.data(), mapping.size()[0], mapping.stride()[0]));
+
+        /* Unordered bit and string fields, or fields that share a mapping
+           with them, can't be reordered. Pass them through unchanged. */
+        if(!order.ordered && !order.reorderable) {
+            fields[i] = field;
+            continue;
+        }
+
+        const Trade::SceneFieldFlags flags = field.flags()|(order.implicit ?
+            Trade::SceneFieldFlag::ImplicitMapping :
+            Trade::SceneFieldFlag::OrderedMapping);
+
+        /* Already ordered, including bit and string fields, only update the
+           flags */
+        if(order.ordered) {
+            fields[i] = fieldWithFlags(field, flags);
+            continue;
+        }
+
+        /* Otherwise use the reordered mapping and a placeholder for the field
+           data, which get copied after */
+        const std::size_t fieldTypeSize = Trade::sceneFieldTypeSize(fieldType)*(field.fieldArraySize() ? field.fieldArraySize() : 1);
+        fields[i] = Trade::SceneFieldData{field.name(),
+            field.mappingType(), Containers::StridedArrayView1D<const void>{order.mapping, field.size(), std::ptrdiff_t(mappingTypeSize)},
+            fieldType, Containers::StridedArrayView1D<const void>{{nullptr, fieldTypeSize*field.size()}, field.size(), std::ptrdiff_t(fieldTypeSize)},
+            field.fieldArraySize(), flags};
+    }
+
+    Trade::SceneData out = combineFields(scene.mappingType(), scene.mappingBound(), fields);
+
+    /* Copy reordered field data */
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        const Trade::SceneFieldType fieldType = scene.fieldType(i);
+        if(!scene.fieldSize(i) || fieldType == Trade::SceneFieldType::Bit || Trade::Implementation::isSceneFieldTypeString(fieldType))
+            continue;
+
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        const MappingOrder& order = uniqueMappings.at(std::make_tuple(mapping.data(), mapping.size()[0], mapping.stride()[0]));
+        if(order.permutation.isEmpty())
+            continue;
+
+        const Containers::StridedArrayView2D<const char> src = scene.field(i);
+        const Containers::StridedArrayView2D<char> dst = out.mutableField(i);
+        for(std::size_t j = 0; j != order.permutation.size(); ++j)
+            Utility::copy(src[order.permutation[j]], dst[j]);
+    }
+
+    return out;
+}
+
+}}
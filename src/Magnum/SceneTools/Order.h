@@ -0,0 +1,74 @@
+#ifndef Magnum_SceneTools_Order_h
+#define Magnum_SceneTools_Order_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::orderMappings()
+ * @m_since_latest
+ */
+
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Order object mappings of all fields in a scene
+@m_since_latest
+
+Returns a copy of @p scene with entries in every field sorted by the object
+they're mapped to and the field marked with
+@ref Trade::SceneFieldFlag::OrderedMapping. If the sorted mapping is a
+contiguous sequence from @cpp 0 @ce up to the field size, the field is marked
+with @ref Trade::SceneFieldFlag::ImplicitMapping instead. The sorting is
+stable, i.e. entries mapped to the same object keep their relative order.
+Fields that share a mapping view (such as @ref Trade::SceneField::Mesh and
+@relativeref{Trade::SceneField,MeshMaterial}) get reordered the same way and
+the sharing is preserved.
+
+Without any of the above flags, @ref Trade::SceneData::findFieldObjectOffset()
+and all per-object accessors such as @ref Trade::SceneData::parentFor(),
+@relativeref{Trade::SceneData,transformation3DFor()} or
+@relativeref{Trade::SceneData,meshesMaterialsFor()} have to perform a linear
+search, making queries for all objects in a scene an
+@f$ \mathcal{O}(n^2) @f$ operation. After this function they're done with an
+@f$ \mathcal{O}(\log{} n) @f$ or @f$ \mathcal{O}(1) @f$ complexity instead.
+The ordering itself is done in an @f$ \mathcal{O}(n \log{} n) @f$ execution
+time and @f$ \mathcal{O}(n) @f$ memory complexity, with @f$ n @f$ being the
+size of a field.
+
+Reordering of @ref Trade::SceneFieldType::Bit and string fields isn't
+implemented yet --- if such a field isn't already ordered, it and all fields
+sharing a mapping with it are passed through unchanged. The data repacking is
+performed using @ref combineFields(), see its documentation for more
+information.
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Trade::SceneData orderMappings(const Trade::SceneData& scene);
+
+}}
+
+#endif
@@ -0,0 +1,343 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SpatialIndex.h"
+
+#include <algorithm> /* std::sort(), std::nth_element() */
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneTools/Hierarchy.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Max count of entries in a leaf node */
+constexpr UnsignedInt LeafSize = 4;
+
+/* Math::join() ignores zero-size ranges, which would make flat objects such
+   as planes disappear from the hierarchy */
+Range3D joinBounds(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+/* Math::intersects() treats the ranges as open, here touching bounds are
+   considered overlapping */
+bool overlaps(const Range3D& a, const Range3D& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+/* Transforms a box with an affine transformation and returns an axis-aligned
+   box containing it. Instead of transforming all eight corners, the center is
+   transformed and the half-size is projected onto each axis, as described in
+   J. Arvo, Transforming Axis-Aligned Bounding Boxes, Graphics Gems, 1990. */
+Range3D transformBounds(const Matrix4& transformation, const Range3D& bounds) {
+    const Vector3 halfSize = bounds.size()*0.5f;
+    Vector3 extent;
+    for(std::size_t i = 0; i != 3; ++i)
+        extent[i] = Math::abs(transformation[0][i])*halfSize[0] +
+                    Math::abs(transformation[1][i])*halfSize[1] +
+                    Math::abs(transformation[2][i])*halfSize[2];
+    return Range3D::fromCenter(transformation.transformPoint(bounds.center()), extent);
+}
+
+}
+
+struct SpatialIndex3D::State {
+    /* Nodes are stored in a depth-first order, i.e. the first child of an
+       inner node is always right after it */
+    struct Node {
+        Range3D bounds;
+        /* ~UnsignedInt{} for the root */
+        UnsignedInt parent;
+        /* For inner nodes ID of the second child, for leaf nodes offset of
+           the first entry in the order array */
+        UnsignedInt secondChildOrOffset;
+        /* Entry count for leaf nodes, 0 for inner nodes */
+        UnsignedInt count;
+    };
+
+    UnsignedInt build(const Containers::ArrayView<const Vector3> centers, UnsignedInt begin, UnsignedInt end, UnsignedInt parent);
+    void refitNode(UnsignedInt id);
+    template<class F> Containers::Array<UnsignedInt> intersect(const F& test) const;
+
+    /* Indexed by entry ID */
+    Containers::Array<UnsignedInt> objects;
+    Containers::Array<Range3D> localBounds;
+    Containers::Array<Range3D> bounds;
+    Containers::Array<UnsignedInt> entryLeaves;
+
+    /* Entry IDs ordered so entries of each leaf are contiguous */
+    Containers::Array<UnsignedInt> order;
+    Containers::Array<Node> nodes;
+};
+
+UnsignedInt SpatialIndex3D::State::build(const Containers::ArrayView<const Vector3> centers, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt parent) {
+    Range3D nodeBounds = bounds[order[begin]];
+    Range3D centerBounds{centers[order[begin]], centers[order[begin]]};
+    for(UnsignedInt i = begin + 1; i != end; ++i) {
+        nodeBounds = joinBounds(nodeBounds, bounds[order[i]]);
+        centerBounds = joinBounds(centerBounds, {centers[order[i]], centers[order[i]]});
+    }
+
+    const UnsignedInt id = nodes.size();
+    arrayAppend(nodes, Node{nodeBounds, parent, begin, end - begin});
+
+    if(end - begin <= LeafSize) {
+        for(UnsignedInt i = begin; i != end; ++i)
+            entryLeaves[order[i]] = id;
+        return id;
+    }
+
+    /* Split in the median along the longest axis of the centers. Compared to
+       a surface area heuristic this produces a worse hierarchy for unevenly
+       distributed objects, but it's fast to build, the tree is always
+       balanced and its depth is bounded by log2 of the entry count. */
+    const Vector3 size = centerBounds.size();
+    const std::size_t axis = size.x() >= size.y() && size.x() >= size.z() ? 0 :
+        size.y() >= size.z() ? 1 : 2;
+    const UnsignedInt middle = begin + (end - begin)/2;
+    std::nth_element(order.data() + begin, order.data() + middle, order.data() + end, [&](UnsignedInt a, UnsignedInt b) {
+        return centers[a][axis] < centers[b][axis];
+    });
+
+    build(centers, begin, middle, id);
+    const UnsignedInt secondChild = build(centers, middle, end, id);
+
+    /* Not taking a reference earlier as the array may get reallocated in the
+       recursive calls */
+    nodes[id].secondChildOrOffset = secondChild;
+    nodes[id].count = 0;
+    return id;
+}
+
+void SpatialIndex3D::State::refitNode(const UnsignedInt id) {
+    Node& node = nodes[id];
+    if(node.count) {
+        node.bounds = bounds[order[node.secondChildOrOffset]];
+        for(UnsignedInt i = 1; i != node.count; ++i)
+            node.bounds = joinBounds(node.bounds, bounds[order[node.secondChildOrOffset + i]]);
+    } else {
+        node.bounds = joinBounds(nodes[id + 1].bounds, nodes[node.secondChildOrOffset].bounds);
+    }
+}
+
+template<class F> Containers::Array<UnsignedInt> SpatialIndex3D::State::intersect(const F& test) const {
+    Containers::Array<UnsignedInt> out;
+    if(nodes.isEmpty()) return out;
+
+    /* The hierarchy depth is at most log2 of the entry count, with each level
+       adding at most one item to the stack */
+    UnsignedInt stack[64];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const UnsignedInt id = stack[--stackSize];
+        const Node& node = nodes[id];
+        if(!test(node.bounds)) continue;
+
+        if(node.count) {
+            for(UnsignedInt i = 0; i != node.count; ++i) {
+                const UnsignedInt entry = order[node.secondChildOrOffset + i];
+                if(test(bounds[entry])) arrayAppend(out, entry);
+            }
+        } else {
+            CORRADE_INTERNAL_ASSERT(stackSize + 2 <= Containers::arraySize(stack));
+            stack[stackSize++] = node.secondChildOrOffset;
+            stack[stackSize++] = id + 1;
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+
+    /* Convert back to a default deleter so the returned array isn't tied to
+       the growable allocator */
+    arrayShrink(out, DefaultInit);
+    return out;
+}
+
+SpatialIndex3D::SpatialIndex3D(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Range3D>& meshBounds, const Matrix4& globalTransformation): _state{InPlaceInit} {
+    CORRADE_ASSERT(scene.is3D(),
+        "SceneTools::SpatialIndex3D: the scene is not 3D", );
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Mesh),
+        "SceneTools::SpatialIndex3D: the scene has no meshes", );
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Parent),
+        "SceneTools::SpatialIndex3D: the scene has no hierarchy", );
+
+    const Containers::Array<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>> meshesMaterials = scene.meshesMaterialsAsArray();
+    #ifndef CORRADE_NO_ASSERT
+    for(const Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>& meshMaterial: meshesMaterials)
+        CORRADE_ASSERT(meshMaterial.second().first() < meshBounds.size(),
+            "SceneTools::SpatialIndex3D: mesh" << meshMaterial.second().first() << "out of range for" << meshBounds.size() << "bounds", );
+    #endif
+
+    const Containers::Array<Matrix4> transformations = absoluteFieldTransformations3D(scene, Trade::SceneField::Mesh, globalTransformation);
+
+    State& state = *_state;
+    state.objects = Containers::Array<UnsignedInt>{NoInit, meshesMaterials.size()};
+    state.localBounds = Containers::Array<Range3D>{NoInit, meshesMaterials.size()};
+    state.bounds = Containers::Array<Range3D>{NoInit, meshesMaterials.size()};
+    for(std::size_t i = 0; i != meshesMaterials.size(); ++i) {
+        state.objects[i] = meshesMaterials[i].first();
+        state.localBounds[i] = meshBounds[meshesMaterials[i].second().first()];
+        state.bounds[i] = transformBounds(transformations[i], state.localBounds[i]);
+    }
+
+    rebuild();
+}
+
+SpatialIndex3D::SpatialIndex3D(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Range3D>& meshBounds): SpatialIndex3D{scene, meshBounds, {}} {}
+
+SpatialIndex3D::SpatialIndex3D(const Containers::StridedArrayView1D<const UnsignedInt>& objects, const Containers::StridedArrayView1D<const Range3D>& bounds, const Containers::StridedArrayView1D<const Matrix4>& transformations): _state{InPlaceInit} {
+    CORRADE_ASSERT(bounds.size() == objects.size(),
+        "SceneTools::SpatialIndex3D: expected bounds view with" << objects.size() << "elements but got" << bounds.size(), );
+    CORRADE_ASSERT(transformations.size() == objects.size(),
+        "SceneTools::SpatialIndex3D: expected transformation view with" << objects.size() << "elements but got" << transformations.size(), );
+
+    State& state = *_state;
+    state.objects = Containers::Array<UnsignedInt>{NoInit, objects.size()};
+    state.localBounds = Containers::Array<Range3D>{NoInit, objects.size()};
+    state.bounds = Containers::Array<Range3D>{NoInit, objects.size()};
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        state.objects[i] = objects[i];
+        state.localBounds[i] = bounds[i];
+        state.bounds[i] = transformBounds(transformations[i], bounds[i]);
+    }
+
+    rebuild();
+}
+
+SpatialIndex3D::SpatialIndex3D(SpatialIndex3D&&) noexcept = default;
+
+SpatialIndex3D::~SpatialIndex3D() = default;
+
+SpatialIndex3D& SpatialIndex3D::operator=(SpatialIndex3D&&) noexcept = default;
+
+std::size_t SpatialIndex3D::size() const {
+    return _state->objects.size();
+}
+
+std::size_t SpatialIndex3D::nodeCount() const {
+    return _state->nodes.size();
+}
+
+Containers::StridedArrayView1D<const UnsignedInt> SpatialIndex3D::objects() const {
+    return _state->objects;
+}
+
+Containers::StridedArrayView1D<const Range3D> SpatialIndex3D::localBounds() const {
+    return _state->localBounds;
+}
+
+Containers::StridedArrayView1D<const Range3D> SpatialIndex3D::bounds() const {
+    return _state->bounds;
+}
+
+Range3D SpatialIndex3D::range() const {
+    return _state->nodes.isEmpty() ? Range3D{} : _state->nodes[0].bounds;
+}
+
+SpatialIndex3D& SpatialIndex3D::setTransformation(const UnsignedInt id, const Matrix4& transformation) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.objects.size(),
+        "SceneTools::SpatialIndex3D::setTransformation(): index" << id << "out of range for" << state.objects.size() << "entries", *this);
+
+    state.bounds[id] = transformBounds(transformation, state.localBounds[id]);
+
+    /* Refit the leaf and then all its parents up to the root */
+    for(UnsignedInt node = state.entryLeaves[id]; node != ~UnsignedInt{}; node = state.nodes[node].parent)
+        state.refitNode(node);
+
+    return *this;
+}
+
+SpatialIndex3D& SpatialIndex3D::setTransformations(const Containers::StridedArrayView1D<const Matrix4>& transformations) {
+    State& state = *_state;
+    CORRADE_ASSERT(transformations.size() == state.objects.size(),
+        "SceneTools::SpatialIndex3D::setTransformations(): expected transformation view with" << state.objects.size() << "elements but got" << transformations.size(), *this);
+
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        state.bounds[i] = transformBounds(transformations[i], state.localBounds[i]);
+
+    /* Children are always after their parents in the node array, so going
+       backwards refits them before the parents */
+    for(std::size_t i = state.nodes.size(); i != 0; --i)
+        state.refitNode(i - 1);
+
+    return *this;
+}
+
+SpatialIndex3D& SpatialIndex3D::rebuild() {
+    State& state = *_state;
+    const std::size_t size = state.objects.size();
+
+    state.order = Containers::Array<UnsignedInt>{NoInit, size};
+    for(std::size_t i = 0; i != size; ++i)
+        state.order[i] = i;
+    state.entryLeaves = Containers::Array<UnsignedInt>{NoInit, size};
+
+    /* A balanced tree with at most LeafSize entries per leaf has less than
+       2*size nodes, reserve the upper bound to avoid reallocations during the
+       build */
+    state.nodes = {};
+    if(!size) return *this;
+    arrayReserve(state.nodes, 2*size);
+
+    Containers::Array<Vector3> centers{NoInit, size};
+    for(std::size_t i = 0; i != size; ++i)
+        centers[i] = state.bounds[i].center();
+
+    state.build(centers, 0, size, ~UnsignedInt{});
+    return *this;
+}
+
+Containers::Array<UnsignedInt> SpatialIndex3D::intersectRange(const Range3D& range) const {
+    return _state->intersect([&](const Range3D& bounds) {
+        return overlaps(bounds, range);
+    });
+}
+
+Containers::Array<UnsignedInt> SpatialIndex3D::intersectFrustum(const Frustum& frustum) const {
+    return _state->intersect([&](const Range3D& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, frustum);
+    });
+}
+
+Containers::Array<UnsignedInt> SpatialIndex3D::intersectRay(const Vector3& origin, const Vector3& direction) const {
+    const Vector3 inverseDirection = 1.0f/direction;
+    return _state->intersect([&](const Range3D& bounds) {
+        return Math::Intersection::rayRange(origin, inverseDirection, bounds);
+    });
+}
+
+}}
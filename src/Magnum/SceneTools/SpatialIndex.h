@@ -0,0 +1,235 @@
+#ifndef Magnum_SceneTools_SpatialIndex_h
+#define Magnum_SceneTools_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneTools::SpatialIndex3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Bounding volume hierarchy over 3D scene objects
+@m_since_latest
+
+Organizes axis-aligned bounds of objects in a @ref Trade::SceneData into a
+binary bounding volume hierarchy, allowing to efficiently query objects that
+intersect a range, a frustum or a ray without having to test bounds of every
+object in the scene. Each entry in the index is an object together with its
+bounds in local coordinates and an absolute transformation, the queried bounds
+are the local bounds transformed into an axis-aligned box in world space.
+Meant for CPU-side culling or streaming decisions on large scenes without
+having to populate a @ref SceneGraph.
+
+The hierarchy is built by recursively splitting the entries in a median of
+their bounds centers along the longest axis, which is done in an
+@f$ \mathcal{O}(n \log n) @f$ execution time and @f$ \mathcal{O}(n) @f$ memory
+complexity, with @f$ n @f$ being the entry count. Changing transformations of
+entries via @ref setTransformation() or @ref setTransformations() only refits
+the bounds of the hierarchy nodes without changing its structure. If the
+objects move significantly, the queries may become less efficient, in which
+case it's recommended to call @ref rebuild().
+
+@section SceneTools-SpatialIndex3D-usage Usage
+
+The per-mesh bounds can be calculated for example using
+@ref MeshTools::boundingRange() on mesh positions. The index created from
+a scene then contains one entry for each @ref Trade::SceneField::Mesh
+assignment:
+
+@snippet MagnumSceneTools.cpp SpatialIndex3D-usage
+
+@experimental
+*/
+class MAGNUM_SCENETOOLS_EXPORT SpatialIndex3D {
+    public:
+        /**
+         * @brief Construct from a scene
+         * @param scene                 Input scene
+         * @param meshBounds            Bounds of meshes referenced by the
+         *      scene
+         * @param globalTransformation  Global transformation to prepend
+         *
+         * Creates an entry for each item in the @ref Trade::SceneField::Mesh
+         * field, with the local bounds taken from @p meshBounds indexed by the
+         * mesh ID and the transformation calculated using
+         * @ref absoluteFieldTransformations3D(). The @p scene is expected to
+         * be 3D and contain a @ref Trade::SceneField::Mesh and a
+         * @ref Trade::SceneField::Parent field, all mesh IDs are expected to
+         * be less than @p meshBounds size. The entries are in the same order
+         * as the mesh field. The @p scene isn't referenced after the
+         * constructor exits.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit SpatialIndex3D(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Range3D>& meshBounds, const Matrix4& globalTransformation = {});
+        #else
+        /* To avoid including Matrix4 */
+        explicit SpatialIndex3D(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Range3D>& meshBounds, const Matrix4& globalTransformation);
+        explicit SpatialIndex3D(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Range3D>& meshBounds);
+        #endif
+
+        /**
+         * @brief Construct from a list of objects
+         * @param objects           Object IDs
+         * @param bounds            Local object bounds
+         * @param transformations   Absolute object transformations
+         *
+         * Creates an entry for each item in @p objects. The @p bounds and
+         * @p transformations views are expected to have the same size as
+         * @p objects. The transformations are expected to be affine.
+         */
+        explicit SpatialIndex3D(const Containers::StridedArrayView1D<const UnsignedInt>& objects, const Containers::StridedArrayView1D<const Range3D>& bounds, const Containers::StridedArrayView1D<const Matrix4>& transformations);
+
+        /** @brief Copying is not allowed */
+        SpatialIndex3D(const SpatialIndex3D&) = delete;
+
+        /** @brief Move constructor */
+        SpatialIndex3D(SpatialIndex3D&&) noexcept;
+
+        ~SpatialIndex3D();
+
+        /** @brief Copying is not allowed */
+        SpatialIndex3D& operator=(const SpatialIndex3D&) = delete;
+
+        /** @brief Move assignment */
+        SpatialIndex3D& operator=(SpatialIndex3D&&) noexcept;
+
+        /** @brief Entry count */
+        std::size_t size() const;
+
+        /**
+         * @brief Count of nodes in the hierarchy
+         *
+         * Leaf nodes contain up to four entries. If the index is empty, the
+         * count is @cpp 0 @ce.
+         */
+        std::size_t nodeCount() const;
+
+        /**
+         * @brief Object IDs
+         *
+         * Size is equal to @ref size().
+         */
+        Containers::StridedArrayView1D<const UnsignedInt> objects() const;
+
+        /**
+         * @brief Local bounds
+         *
+         * Size is equal to @ref size().
+         */
+        Containers::StridedArrayView1D<const Range3D> localBounds() const;
+
+        /**
+         * @brief World-space bounds
+         *
+         * Local bounds of each entry transformed with its transformation.
+         * Size is equal to @ref size().
+         */
+        Containers::StridedArrayView1D<const Range3D> bounds() const;
+
+        /**
+         * @brief Bounds of all entries
+         *
+         * Returns a default-constructed range if the index is empty.
+         */
+        Range3D range() const;
+
+        /**
+         * @brief Set an absolute transformation of an entry
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p id is less than @ref size(). Recalculates bounds of
+         * the entry and refits bounds of all hierarchy nodes the entry is in,
+         * which is done in an @f$ \mathcal{O}(\log n) @f$ time.
+         */
+        SpatialIndex3D& setTransformation(UnsignedInt id, const Matrix4& transformation);
+
+        /**
+         * @brief Set absolute transformations of all entries
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p transformations has the same size as @ref size().
+         * Recalculates bounds of all entries and refits bounds of all
+         * hierarchy nodes, which is done in an @f$ \mathcal{O}(n) @f$ time.
+         * The transformations can be for example filled by
+         * @ref TransformationCache3D::absoluteFieldTransformationsInto().
+         */
+        SpatialIndex3D& setTransformations(const Containers::StridedArrayView1D<const Matrix4>& transformations);
+
+        /**
+         * @brief Rebuild the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * Builds the hierarchy from scratch using current world-space bounds
+         * of all entries. Useful if the objects moved significantly since the
+         * hierarchy was built.
+         */
+        SpatialIndex3D& rebuild();
+
+        /**
+         * @brief Entries intersecting a range
+         *
+         * Returns IDs of entries whose @ref bounds() overlap @p range, sorted
+         * in an ascending order. The bounds are treated as closed, i.e.
+         * touching ranges are considered overlapping.
+         */
+        Containers::Array<UnsignedInt> intersectRange(const Range3D& range) const;
+
+        /**
+         * @brief Entries intersecting a frustum
+         *
+         * Returns IDs of entries whose @ref bounds() intersect @p frustum,
+         * sorted in an ascending order. Uses
+         * @ref Math::Intersection::rangeFrustum(), which may report false
+         * positives for large bounds near frustum corners.
+         */
+        Containers::Array<UnsignedInt> intersectFrustum(const Frustum& frustum) const;
+
+        /**
+         * @brief Entries intersecting a ray
+         *
+         * Returns IDs of entries whose @ref bounds() intersect a ray with
+         * given @p origin and @p direction, sorted in an ascending order.
+         * Uses @ref Math::Intersection::rayRange(), which treats the ray as an
+         * infinite line.
+         */
+        Containers::Array<UnsignedInt> intersectRay(const Vector3& origin, const Vector3& direction) const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,554 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Format.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneTools/BatchMeshes.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct BatchMeshesTest: TestSuite::Tester {
+    explicit BatchMeshesTest();
+
+    void batch();
+    void batchPackedAttributes();
+    void batchNotConcatenable();
+    void batchEmpty();
+
+    void notThreeDimensional();
+    void noMeshField();
+    void noHierarchy();
+    void meshOutOfRange();
+    void meshNoPositions();
+    void meshTwoDimensionalPositions();
+    void meshImplementationSpecificVertexFormat();
+};
+
+const struct {
+    const char* name;
+    VertexFormat positionFormat;
+    Trade::MeshAttribute otherAttribute;
+    VertexFormat otherAttributeFormat;
+} MeshImplementationSpecificVertexFormatData[]{
+    {"positions", vertexFormatWrap(0xcaca), Trade::MeshAttribute::Color, VertexFormat::Vector3},
+    {"normals", VertexFormat::Vector3, Trade::MeshAttribute::Normal, vertexFormatWrap(0xcaca)},
+    {"tangents", VertexFormat::Vector3, Trade::MeshAttribute::Tangent, vertexFormatWrap(0xcaca)},
+    {"bitangents", VertexFormat::Vector3, Trade::MeshAttribute::Bitangent, vertexFormatWrap(0xcaca)},
+};
+
+BatchMeshesTest::BatchMeshesTest() {
+    addTests({&BatchMeshesTest::batch,
+              &BatchMeshesTest::batchPackedAttributes,
+              &BatchMeshesTest::batchNotConcatenable,
+              &BatchMeshesTest::batchEmpty,
+
+              &BatchMeshesTest::notThreeDimensional,
+              &BatchMeshesTest::noMeshField,
+              &BatchMeshesTest::noHierarchy,
+              &BatchMeshesTest::meshOutOfRange,
+              &BatchMeshesTest::meshNoPositions,
+              &BatchMeshesTest::meshTwoDimensionalPositions});
+
+    addInstancedTests({&BatchMeshesTest::meshImplementationSpecificVertexFormat},
+        Containers::arraySize(MeshImplementationSpecificVertexFormatData));
+}
+
+using namespace Math::Literals;
+
+struct Scene {
+    UnsignedInt parentMapping[4]{0, 1, 2, 3};
+    Int parent[4]{-1, 0, -1, -1};
+    UnsignedInt transformationMapping[3]{0, 1, 3};
+    Matrix4 transformation[3]{
+        Matrix4::translation(Vector3::xAxis(10.0f)),
+        Matrix4::translation(Vector3::yAxis(1.0f)),
+        Matrix4::rotationZ(90.0_degf)
+    };
+    UnsignedInt meshMapping[4]{0, 1, 2, 3};
+    UnsignedInt mesh[4]{0, 1, 0, 2};
+    Int meshMaterial[4]{0, 0, 1, 0};
+};
+
+void BatchMeshesTest::batch() {
+    const Scene data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 4, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->parentMapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->transformationMapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->meshMapping),
+            Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::arrayView(data->meshMapping),
+            Containers::arrayView(data->meshMaterial)},
+    }};
+
+    /* Indexed, instanced twice with different materials */
+    const UnsignedShort indices0[]{0, 1, 2};
+    const Vector3 positions0[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    /* Non-indexed but with the same layout as the first, should get batched
+       together with it */
+    const Vector3 positions1[]{
+        {0.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    /* Same material as the first but with normals, should be in a separate
+       batch */
+    const struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices2[]{
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+        {{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}},
+        {{1.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.0f}}
+    };
+    const auto view2 = Containers::stridedArrayView(vertices2);
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, indices0, Trade::MeshIndexData{indices0},
+            {}, positions0, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions0)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions1, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions1)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, vertices2, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, view2.slice(&Vertex::position)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::Normal, view2.slice(&Vertex::normal)}
+            }},
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshes3D(scene, Containers::arrayView(meshes), Matrix4::translation(Vector3::zAxis(-1.0f)));
+
+    CORRADE_COMPARE(out.first().mappingType(), Trade::SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(out.first().mappingBound(), 3);
+    CORRADE_COMPARE(out.first().fieldCount(), 3);
+    CORRADE_VERIFY(out.first().hasField(Trade::SceneField::Parent));
+    CORRADE_COMPARE(out.first().fieldFlags(Trade::SceneField::Parent), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(out.first().parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, -1},
+        {2, -1}
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().fieldFlags(Trade::SceneField::Mesh), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE(out.first().fieldFlags(Trade::SceneField::MeshMaterial), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 0}},
+        {1, {1, 1}},
+        {2, {2, 0}}
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.second().size(), 3);
+
+    /* First and second mesh concatenated, with the hierarchy applied */
+    CORRADE_COMPARE(out.second()[0].primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(out.second()[0].isIndexed());
+    CORRADE_COMPARE_AS(out.second()[0].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second()[0].attributeCount(), 1);
+    CORRADE_COMPARE_AS(out.second()[0].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {10.0f, 0.0f, -1.0f},
+        {11.0f, 0.0f, -1.0f},
+        {10.0f, 1.0f, -1.0f},
+        {10.0f, 1.0f, -1.0f},
+        {10.0f, 1.0f, 0.0f},
+        {10.0f, 2.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* First mesh again, just with the global transformation */
+    CORRADE_COMPARE_AS(out.second()[1].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[1].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, -1.0f},
+        {0.0f, 1.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Third mesh, rotated, with normals rotated as well */
+    CORRADE_VERIFY(!out.second()[2].isIndexed());
+    CORRADE_COMPARE(out.second()[2].attributeCount(), 2);
+    CORRADE_COMPARE_AS(out.second()[2].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, -1.0f},
+        {0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[2].attribute<Vector3>(Trade::MeshAttribute::Normal), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesTest::batchPackedAttributes() {
+    const struct {
+        UnsignedInt mapping[2]{0, 1};
+        Int parent[2]{-1, -1};
+        Matrix4 transformation[2]{
+            Matrix4::translation(Vector3::xAxis(5.0f)),
+            Matrix4::scaling(Vector3{2.0f})
+        };
+        UnsignedInt mesh[2]{0, 0};
+        Int meshMaterial[2]{3, 3};
+    } data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->meshMaterial)},
+    }};
+
+    /* Packed positions can't be transformed in-place, so this goes through
+       MeshTools::transform3D() and the output is expanded to floats */
+    const Vector3s positions[]{
+        {0, 0, 0},
+        {1, 0, 0},
+        {0, 1, 0}
+    };
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }}
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 3}}
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.second().size(), 1);
+    CORRADE_VERIFY(!out.second()[0].isIndexed());
+    CORRADE_COMPARE(out.second()[0].attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3);
+    CORRADE_COMPARE_AS(out.second()[0].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {5.0f, 0.0f, 0.0f},
+        {6.0f, 0.0f, 0.0f},
+        {5.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesTest::batchNotConcatenable() {
+    const struct {
+        UnsignedInt mapping[2]{0, 1};
+        Int parent[2]{-1, -1};
+        Matrix4 transformation[2]{
+            Matrix4::translation(Vector3::xAxis(5.0f)),
+            Matrix4::translation(Vector3::yAxis(5.0f))
+        };
+        UnsignedInt mesh[2]{0, 0};
+        Int meshMaterial[2]{1, 1};
+    } data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->meshMaterial)},
+    }};
+
+    /* Strips can't be concatenated, so each instance is a separate batch */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f}
+    };
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::TriangleStrip,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }}
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 1}},
+        {1, {1, 1}}
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.second().size(), 2);
+    CORRADE_COMPARE(out.second()[0].primitive(), MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE_AS(out.second()[0].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {5.0f, 0.0f, 0.0f},
+        {6.0f, 0.0f, 0.0f},
+        {5.0f, 1.0f, 0.0f},
+        {6.0f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second()[1].primitive(), MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE_AS(out.second()[1].attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 5.0f, 0.0f},
+        {1.0f, 5.0f, 0.0f},
+        {0.0f, 6.0f, 0.0f},
+        {1.0f, 6.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesTest::batchEmpty() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+    }};
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshes3D(scene, Containers::ArrayView<const Trade::MeshData>{});
+    CORRADE_COMPARE(out.first().mappingBound(), 0);
+    CORRADE_COMPARE(out.first().fieldCount(), 3);
+    CORRADE_COMPARE(out.first().fieldSize(Trade::SceneField::Mesh), 0);
+    CORRADE_COMPARE(out.second().size(), 0);
+}
+
+void BatchMeshesTest::notThreeDimensional() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix3x3, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::ArrayView<const Trade::MeshData>{});
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): the scene is not 3D\n");
+}
+
+void BatchMeshesTest::noMeshField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr},
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::ArrayView<const Trade::MeshData>{});
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): the scene has no meshes\n");
+}
+
+void BatchMeshesTest::noHierarchy() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::ArrayView<const Trade::MeshData>{});
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): the scene has no hierarchy\n");
+}
+
+void BatchMeshesTest::meshOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Scene data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 4, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->parentMapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->transformationMapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->meshMapping),
+            Containers::arrayView(data->mesh)},
+    }};
+
+    const Vector3 positions[3]{};
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): mesh 2 out of range for 2 meshes\n");
+}
+
+void BatchMeshesTest::meshNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Scene data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 4, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->parentMapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->transformationMapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->meshMapping),
+            Containers::arrayView(data->mesh)},
+    }};
+
+    const Vector3 positions[3]{};
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles, 3},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): mesh 1 has no positions\n");
+}
+
+void BatchMeshesTest::meshTwoDimensionalPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Scene data[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 4, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->parentMapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(data->transformationMapping),
+            Containers::arrayView(data->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->meshMapping),
+            Containers::arrayView(data->mesh)},
+    }};
+
+    const Vector3 positions[3]{};
+    const Vector2 positions2D[3]{};
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions2D, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions2D)}
+            }},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE(out.str(), "SceneTools::batchMeshes3D(): expected mesh 2 to have 3D positions but got VertexFormat::Vector2\n");
+}
+
+void BatchMeshesTest::meshImplementationSpecificVertexFormat() {
+    auto&& data = MeshImplementationSpecificVertexFormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Scene sceneData[1]{};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 4, {}, sceneData, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(sceneData->parentMapping),
+            Containers::arrayView(sceneData->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::arrayView(sceneData->transformationMapping),
+            Containers::arrayView(sceneData->transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(sceneData->meshMapping),
+            Containers::arrayView(sceneData->mesh)},
+    }};
+
+    /* Such meshes aren't concatenable and thus would go directly to
+       MeshTools::transform3D(), which would assert */
+    const Vector3 positions[3]{};
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, data.positionFormat, Containers::arrayView(positions)},
+                Trade::MeshAttributeData{data.otherAttribute, data.otherAttributeFormat, Containers::arrayView(positions)}
+            }},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshes3D(scene, Containers::arrayView(meshes));
+    CORRADE_COMPARE(out.str(), Utility::format("SceneTools::batchMeshes3D(): mesh 2 {} have an implementation-specific format 0xcaca\n", data.name));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::BatchMeshesTest)
@@ -0,0 +1,449 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/SceneTools/Deduplicate.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct DeduplicateTest: TestSuite::Tester {
+    explicit DeduplicateTest();
+
+    void meshes();
+    void meshesEmpty();
+    void meshesParallelSameAsSerial();
+    void materials();
+    void images1D();
+    void images2D();
+    void images3D();
+
+    void remapMeshesMaterials();
+    void remapMeshesMaterialsNoMapping();
+    void remapMeshesMaterialsNotMutable();
+    void remapMeshesMaterialsOutOfRange();
+    void remapMeshesMaterialsDoesntFit();
+};
+
+using namespace Containers::Literals;
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadCountData[]{
+    {"single thread", 1},
+    {"three threads", 3},
+    {"all available threads", 0}
+};
+
+DeduplicateTest::DeduplicateTest() {
+    addInstancedTests({&DeduplicateTest::meshes},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&DeduplicateTest::meshesEmpty,
+              &DeduplicateTest::meshesParallelSameAsSerial});
+
+    addInstancedTests({&DeduplicateTest::materials,
+                       &DeduplicateTest::images1D,
+                       &DeduplicateTest::images2D,
+                       &DeduplicateTest::images3D},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&DeduplicateTest::remapMeshesMaterials,
+              &DeduplicateTest::remapMeshesMaterialsNoMapping,
+              &DeduplicateTest::remapMeshesMaterialsNotMutable,
+              &DeduplicateTest::remapMeshesMaterialsOutOfRange,
+              &DeduplicateTest::remapMeshesMaterialsDoesntFit});
+}
+
+void DeduplicateTest::meshes() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const Vector3 positionsModified[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.5f, 0.0f}
+    };
+    const struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } interleaved[]{
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
+    };
+    const UnsignedByte indices[]{0, 1, 2};
+    const UnsignedByte indicesCopy[]{0, 1, 2};
+    const UnsignedShort indicesShort[]{0, 1, 2};
+
+    const auto interleavedView = Containers::stridedArrayView(interleaved);
+
+    const Trade::MeshData meshes[]{
+        /* 0 */
+        Trade::MeshData{MeshPrimitive::Triangles, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }},
+        /* 1, different primitive */
+        Trade::MeshData{MeshPrimitive::Lines, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }},
+        /* Same as 0, but with a different layout */
+        Trade::MeshData{MeshPrimitive::Triangles, {}, interleaved, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, interleavedView.slice(&Vertex::position)}
+        }},
+        /* 2, indexed */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, indices, Trade::MeshIndexData{indices},
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        /* 3, different index type */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, indicesShort, Trade::MeshIndexData{indicesShort},
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        /* Same as 2, with a different index buffer */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, indicesCopy, Trade::MeshIndexData{indicesCopy},
+            {}, positions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+            }},
+        /* 4, different data */
+        Trade::MeshData{MeshPrimitive::Triangles, {}, positionsModified, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positionsModified)}
+        }},
+        /* 5, an extra attribute */
+        Trade::MeshData{MeshPrimitive::Triangles, {}, interleaved, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, interleavedView.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, interleavedView.slice(&Vertex::textureCoordinates)}
+        }},
+    };
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateMeshes(Containers::arrayView(meshes), data.threadCount);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 2, 3, 2, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), 6);
+}
+
+void DeduplicateTest::meshesEmpty() {
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateMeshes(Containers::ArrayView<const Trade::MeshData>{});
+    CORRADE_COMPARE(out.first().size(), 0);
+    CORRADE_COMPARE(out.second(), 0);
+}
+
+void DeduplicateTest::meshesParallelSameAsSerial() {
+    /* Enough meshes for all threads to have something to do, with duplicates
+       spread across the whole range so they're likely processed by a
+       different thread than their first occurrence */
+    Containers::Array<Vector3> positions{NoInit, 7*3};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = Vector3{Float(i), Float(i % 3), 0.0f};
+
+    Containers::Array<Trade::MeshData> meshes;
+    for(std::size_t i = 0; i != 500; ++i) {
+        const Containers::ArrayView<const Vector3> view = positions.sliceSize((i*i % 7)*3, 3);
+        arrayAppend(meshes, Trade::MeshData{MeshPrimitive::Triangles, {}, view, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, view}
+        }});
+    }
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> serial = deduplicateMeshes(Containers::arrayView(meshes), 1);
+    /* 0, 1, 4 and 2 are the only quadratic residues modulo 7 */
+    CORRADE_COMPARE(serial.second(), 4);
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> parallel = deduplicateMeshes(Containers::arrayView(meshes), 8);
+    CORRADE_COMPARE_AS(parallel.first(), serial.first(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(parallel.second(), serial.second());
+}
+
+void DeduplicateTest::materials() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Trade::MaterialData materials[]{
+        /* 0 */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {Trade::MaterialAttribute::DiffuseColor, 0xff3366ff_rgbaf},
+            {Trade::MaterialAttribute::Shininess, 80.0f}
+        }},
+        /* 1, different type */
+        Trade::MaterialData{Trade::MaterialType::PbrMetallicRoughness, {
+            {Trade::MaterialAttribute::DiffuseColor, 0xff3366ff_rgbaf},
+            {Trade::MaterialAttribute::Shininess, 80.0f}
+        }},
+        /* Same as 0, attributes get sorted so the order doesn't matter */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {Trade::MaterialAttribute::Shininess, 80.0f},
+            {Trade::MaterialAttribute::DiffuseColor, 0xff3366ff_rgbaf}
+        }},
+        /* 2, a string attribute */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {"name", "hello"_s}
+        }},
+        /* 3, different value */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {Trade::MaterialAttribute::DiffuseColor, 0xff3366ff_rgbaf},
+            {Trade::MaterialAttribute::Shininess, 79.0f}
+        }},
+        /* 4, different string */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {"name", "hellO"_s}
+        }},
+        /* Same as 2 */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {"name", "hello"_s}
+        }},
+        /* 5, same attributes as 0 but in different layers */
+        Trade::MaterialData{Trade::MaterialType::Phong, {
+            {Trade::MaterialAttribute::DiffuseColor, 0xff3366ff_rgbaf},
+            {Trade::MaterialAttribute::Shininess, 80.0f}
+        }, {1, 2}},
+    };
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateMaterials(Containers::arrayView(materials), data.threadCount);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 2, 3, 4, 2, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), 6);
+}
+
+void DeduplicateTest::images1D() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const char pixels[]{1, 2, 3, 4};
+    const char pixelsCopy[]{1, 2, 3, 4};
+    const char pixelsDifferent[]{1, 2, 3, 5};
+
+    const Trade::ImageData1D images[]{
+        Trade::ImageData1D{PixelFormat::R8Unorm, 4, Trade::DataFlags{}, pixels},
+        Trade::ImageData1D{PixelFormat::R8Unorm, 4, Trade::DataFlags{}, pixelsDifferent},
+        Trade::ImageData1D{PixelFormat::R8Unorm, 4, Trade::DataFlags{}, pixelsCopy},
+        Trade::ImageData1D{PixelFormat::RG8Unorm, 2, Trade::DataFlags{}, pixels},
+    };
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateImages1D(Containers::arrayView(images), data.threadCount);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), 3);
+}
+
+void DeduplicateTest::images2D() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Rows padded to four bytes with garbage, which should be ignored */
+    const char dataPadded[]{
+        1, 2, 3, 4, 5, 6, 'a', 'b',
+        7, 8, 9, 10, 11, 12, 'c', 'd'
+    };
+    const char pixels[]{
+        1, 2, 3, 4, 5, 6,
+        7, 8, 9, 10, 11, 12
+    };
+    const char compressedData[]{1, 2, 3, 4, 5, 6, 7, 8};
+    const char compressedDataCopy[]{1, 2, 3, 4, 5, 6, 7, 8};
+
+    const Trade::ImageData2D images[]{
+        /* 0 */
+        Trade::ImageData2D{PixelFormat::RGB8Unorm, {2, 2}, Trade::DataFlags{}, dataPadded},
+        /* 1, different format */
+        Trade::ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 2}, Trade::DataFlags{}, pixels},
+        /* Same as 0, but without padding */
+        Trade::ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, Trade::DataFlags{}, pixels},
+        /* 2, compressed */
+        Trade::ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Trade::DataFlags{}, compressedData},
+        /* 3, different flags */
+        Trade::ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, Trade::DataFlags{}, pixels, Trade::ImageFlag2D::Array},
+        /* Same as 2 */
+        Trade::ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Trade::DataFlags{}, compressedDataCopy},
+    };
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateImages2D(Containers::arrayView(images), data.threadCount);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 2, 3, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), 4);
+}
+
+void DeduplicateTest::images3D() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Color4ub pixels[]{0xff3366ff_rgba, 0x33ff66ff_rgba};
+    const Color4ub pixelsCopy[]{0xff3366ff_rgba, 0x33ff66ff_rgba};
+
+    const Trade::ImageData3D images[]{
+        Trade::ImageData3D{PixelFormat::RGBA8Unorm, {1, 1, 2}, Trade::DataFlags{}, pixels},
+        Trade::ImageData3D{PixelFormat::RGBA8Unorm, {1, 2, 1}, Trade::DataFlags{}, pixels},
+        Trade::ImageData3D{PixelFormat::RGBA8Unorm, {1, 1, 2}, Trade::DataFlags{}, pixelsCopy},
+    };
+
+    Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> out = deduplicateImages3D(Containers::arrayView(images), data.threadCount);
+    CORRADE_COMPARE_AS(out.first(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), 2);
+}
+
+struct Field {
+    UnsignedInt object;
+    UnsignedShort mesh;
+    Byte material;
+};
+
+Trade::SceneData scene(Field(&data)[4], Trade::DataFlags flags) {
+    const Containers::StridedArrayView1D<Field> view = data;
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 5, flags, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            view.slice(&Field::object),
+            view.slice(&Field::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            view.slice(&Field::object),
+            view.slice(&Field::material)},
+    }};
+}
+
+void DeduplicateTest::remapMeshesMaterials() {
+    Field data[]{
+        {0, 3, 1},
+        {1, 0, -1},
+        {3, 2, 0},
+        {4, 3, 2}
+    };
+    Trade::SceneData scene = Test::scene(data, Trade::DataFlag::Mutable);
+
+    const UnsignedInt meshMapping[]{0, 1, 0, 1};
+    const UnsignedInt materialMapping[]{0, 0, 1};
+    remapMeshesMaterialsInPlace(scene, meshMapping, materialMapping);
+    CORRADE_COMPARE_AS(scene.field<UnsignedShort>(Trade::SceneField::Mesh), Containers::arrayView<UnsignedShort>({
+        1, 0, 0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Byte>(Trade::SceneField::MeshMaterial), Containers::arrayView<Byte>({
+        0, -1, 0, 1
+    }), TestSuite::Compare::Container);
+}
+
+void DeduplicateTest::remapMeshesMaterialsNoMapping() {
+    Field data[]{
+        {0, 3, 1},
+        {1, 0, -1},
+        {3, 2, 0},
+        {4, 3, 2}
+    };
+    Trade::SceneData scene = Test::scene(data, Trade::DataFlag::Mutable);
+
+    /* An empty mapping leaves the field untouched */
+    const UnsignedInt materialMapping[]{2, 1, 0};
+    remapMeshesMaterialsInPlace(scene, nullptr, materialMapping);
+    CORRADE_COMPARE_AS(scene.field<UnsignedShort>(Trade::SceneField::Mesh), Containers::arrayView<UnsignedShort>({
+        3, 0, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Byte>(Trade::SceneField::MeshMaterial), Containers::arrayView<Byte>({
+        1, -1, 2, 0
+    }), TestSuite::Compare::Container);
+}
+
+void DeduplicateTest::remapMeshesMaterialsNotMutable() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Field data[4]{};
+    Trade::SceneData scene = Test::scene(data, {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    remapMeshesMaterialsInPlace(scene, nullptr, nullptr);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::remapMeshesMaterialsInPlace(): data not mutable\n");
+}
+
+void DeduplicateTest::remapMeshesMaterialsOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Field data[]{
+        {0, 3, 1},
+        {1, 0, -1},
+        {3, 2, 0},
+        {4, 3, 2}
+    };
+    Trade::SceneData scene = Test::scene(data, Trade::DataFlag::Mutable);
+
+    const UnsignedInt mapping[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    remapMeshesMaterialsInPlace(scene, mapping, nullptr);
+    remapMeshesMaterialsInPlace(scene, nullptr, Containers::arrayView(mapping).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::remapMeshesMaterialsInPlace(): mesh 3 out of range for 3 mapping entries\n"
+        "SceneTools::remapMeshesMaterialsInPlace(): material 2 out of range for 2 mapping entries\n");
+}
+
+void DeduplicateTest::remapMeshesMaterialsDoesntFit() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Field data[]{
+        {0, 1, 1},
+        {1, 0, -1},
+        {3, 1, 0},
+        {4, 0, 1}
+    };
+    Trade::SceneData scene = Test::scene(data, Trade::DataFlag::Mutable);
+
+    const UnsignedInt mapping[]{0, 200};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    remapMeshesMaterialsInPlace(scene, nullptr, mapping);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::remapMeshesMaterialsInPlace(): mapped material 200 doesn't fit into Trade::SceneFieldType::Byte\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::DeduplicateTest)
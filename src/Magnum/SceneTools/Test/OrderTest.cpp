@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/StringIterable.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/SceneTools/Order.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct OrderTest: TestSuite::Tester {
+    explicit OrderTest();
+
+    void mappings();
+    void mappingsSharedMapping();
+    void mappingsBitStringField();
+    void mappingsEmptyField();
+};
+
+OrderTest::OrderTest() {
+    addTests({&OrderTest::mappings,
+              &OrderTest::mappingsSharedMapping,
+              &OrderTest::mappingsBitStringField,
+              &OrderTest::mappingsEmptyField});
+}
+
+void OrderTest::mappings() {
+    const struct {
+        UnsignedShort parentMapping[4]{3, 0, 2, 1};
+        Int parent[4]{2, -1, 1, 0};
+        UnsignedShort lightMapping[3]{1, 4, 6};
+        UnsignedInt light[3]{5, 6, 7};
+        /* Object 2 has two cameras, their relative order should stay */
+        UnsignedShort cameraMapping[4]{5, 2, 0, 2};
+        UnsignedByte camera[4]{0, 1, 2, 3};
+    } data[1]{};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 7, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::arrayView(data->parentMapping),
+            Containers::arrayView(data->parent)},
+        Trade::SceneFieldData{Trade::SceneField::Light,
+            Containers::arrayView(data->lightMapping),
+            Containers::arrayView(data->light)},
+        Trade::SceneFieldData{Trade::SceneField::Camera,
+            Containers::arrayView(data->cameraMapping),
+            Containers::arrayView(data->camera),
+            Trade::SceneFieldFlag::MultiEntry},
+    }};
+
+    Trade::SceneData ordered = orderMappings(scene);
+    CORRADE_COMPARE(ordered.mappingType(), Trade::SceneMappingType::UnsignedShort);
+    CORRADE_COMPARE(ordered.mappingBound(), 7);
+    CORRADE_COMPARE(ordered.fieldCount(), 3);
+
+    /* Contiguous after sorting, so it's implicit */
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::Parent), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedShort>(Trade::SceneField::Parent),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<Int>(Trade::SceneField::Parent),
+        Containers::arrayView<Int>({-1, 0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Already ordered, only the flag gets added */
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::Light), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedShort>(Trade::SceneField::Light),
+        Containers::arrayView(data->lightMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<UnsignedInt>(Trade::SceneField::Light),
+        Containers::arrayView(data->light),
+        TestSuite::Compare::Container);
+
+    /* Stable sort, original flags preserved */
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::Camera), Trade::SceneFieldFlag::OrderedMapping|Trade::SceneFieldFlag::MultiEntry);
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedShort>(Trade::SceneField::Camera),
+        Containers::arrayView<UnsignedShort>({0, 2, 2, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<UnsignedByte>(Trade::SceneField::Camera),
+        Containers::arrayView<UnsignedByte>({2, 1, 3, 0}),
+        TestSuite::Compare::Container);
+
+    /* Per-object queries give the same results as before */
+    for(UnsignedInt i = 0; i != 7; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(ordered.parentFor(i), scene.parentFor(i));
+        CORRADE_COMPARE_AS(ordered.camerasFor(i), scene.camerasFor(i),
+            TestSuite::Compare::Container);
+    }
+}
+
+void OrderTest::mappingsSharedMapping() {
+    const struct {
+        UnsignedInt meshMaterialMapping[3]{4, 1, 2};
+        UnsignedInt mesh[3]{7, 8, 9};
+        Int meshMaterial[3]{-1, 0, 1};
+        UnsignedInt trsMapping[2]{3, 1};
+        Vector2 translation[2]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+        Vector2 scaling[2]{{5.0f, 6.0f}, {7.0f, 8.0f}};
+    } data[1]{};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::arrayView(data->meshMaterialMapping),
+            Containers::arrayView(data->mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::arrayView(data->meshMaterialMapping),
+            Containers::arrayView(data->meshMaterial)},
+        Trade::SceneFieldData{Trade::SceneField::Translation,
+            Containers::arrayView(data->trsMapping),
+            Containers::arrayView(data->translation)},
+        Trade::SceneFieldData{Trade::SceneField::Scaling,
+            Containers::arrayView(data->trsMapping),
+            Containers::arrayView(data->scaling)},
+    }};
+
+    Trade::SceneData ordered = orderMappings(scene);
+    CORRADE_COMPARE(ordered.fieldCount(), 4);
+
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::Mesh), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::MeshMaterial), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(ordered.mapping(Trade::SceneField::MeshMaterial).data(),
+        ordered.mapping(Trade::SceneField::Mesh).data());
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedInt>(Trade::SceneField::Mesh),
+        Containers::arrayView<UnsignedInt>({1, 2, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<UnsignedInt>(Trade::SceneField::Mesh),
+        Containers::arrayView<UnsignedInt>({8, 9, 7}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<Int>(Trade::SceneField::MeshMaterial),
+        Containers::arrayView<Int>({0, 1, -1}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(ordered.mapping(Trade::SceneField::Scaling).data(),
+        ordered.mapping(Trade::SceneField::Translation).data());
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedInt>(Trade::SceneField::Translation),
+        Containers::arrayView<UnsignedInt>({1, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<Vector2>(Trade::SceneField::Translation),
+        Containers::arrayView<Vector2>({{3.0f, 4.0f}, {1.0f, 2.0f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ordered.field<Vector2>(Trade::SceneField::Scaling),
+        Containers::arrayView<Vector2>({{7.0f, 8.0f}, {5.0f, 6.0f}}),
+        TestSuite::Compare::Container);
+}
+
+void OrderTest::mappingsBitStringField() {
+    const struct {
+        UnsignedByte mapping[3]{2, 0, 1};
+        bool visible[3]{true, false, true};
+        UnsignedByte nameMapping[2]{0, 1};
+        UnsignedByte nameOffsets[2]{3, 6};
+        Float radius[3]{1.0f, 2.0f, 3.0f};
+        char names[6]{'a', 'b', 'c', 'd', 'e', 'f'};
+        UnsignedByte selectedMapping[2]{1, 2};
+        bool selected[2]{false, true};
+    } data[1]{};
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedByte, 3, {}, data, {
+        Trade::SceneFieldData{Trade::sceneFieldCustom(0),
+            Containers::arrayView(data->mapping),
+            Containers::stridedArrayView(data->visible).sliceBit(0)},
+        /* Shares the mapping with a bit field, so can't be reordered */
+        Trade::SceneFieldData{Trade::sceneFieldCustom(1),
+            Containers::arrayView(data->mapping),
+            Containers::arrayView(data->radius)},
+        /* Already ordered string field gets just the flag updated */
+        Trade::SceneFieldData{Trade::sceneFieldCustom(2),
+            Containers::arrayView(data->nameMapping),
+            data->names, Trade::SceneFieldType::StringOffset8,
+            Containers::arrayView(data->nameOffsets)},
+        /* Already ordered bit field gets just the flag updated */
+        Trade::SceneFieldData{Trade::sceneFieldCustom(3),
+            Containers::arrayView(data->selectedMapping),
+            Containers::stridedArrayView(data->selected).sliceBit(0)},
+    }};
+
+    Trade::SceneData ordered = orderMappings(scene);
+    CORRADE_COMPARE(ordered.fieldCount(), 4);
+
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::sceneFieldCustom(0)), Trade::SceneFieldFlags{});
+    CORRADE_COMPARE_AS(ordered.mapping<UnsignedByte>(Trade::sceneFieldCustom(0)),
+        Containers::arrayView(data->mapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::sceneFieldCustom(1)), Trade::SceneFieldFlags{});
+    CORRADE_COMPARE_AS(ordered.field<Float>(Trade::sceneFieldCustom(1)),
+        Containers::arrayView(data->radius),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::sceneFieldCustom(2)), Trade::SceneFieldFlag::ImplicitMapping);
+    CORRADE_COMPARE(ordered.fieldStrings(Trade::sceneFieldCustom(2))[1], "def");
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::sceneFieldCustom(3)), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(ordered.fieldBits(Trade::sceneFieldCustom(3)),
+        Containers::stridedArrayView({false, true}).sliceBit(0),
+        TestSuite::Compare::Container);
+}
+
+void OrderTest::mappingsEmptyField() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr}
+    }};
+
+    Trade::SceneData ordered = orderMappings(scene);
+    CORRADE_COMPARE(ordered.fieldCount(), 1);
+    CORRADE_COMPARE(ordered.fieldSize(Trade::SceneField::Parent), 0);
+    CORRADE_COMPARE(ordered.fieldFlags(Trade::SceneField::Parent), Trade::SceneFieldFlag::ImplicitMapping);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::OrderTest)
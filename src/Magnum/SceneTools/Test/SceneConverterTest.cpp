@@ -235,6 +235,41 @@ const struct {
         "GltfImporter", nullptr, "StanfordSceneConverter", {}, nullptr,
         "quad-duplicates.ply", nullptr,
         {}},
+    {"batch meshes", {InPlaceInit, {
+            /* Forcing the importer and converter to avoid AnySceneImporter /
+               AnySceneConverter delegation messages */
+            "--batch-meshes", "-v", "-I", "GltfImporter", "-C", "StanfordSceneConverter",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/two-triangles-transformed.gltf"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/quad-duplicates.ply")
+        }},
+        "GltfImporter", nullptr, "StanfordSceneConverter", {}, nullptr,
+        /* Both triangles have the same layout and no material, so they end up
+           in a single batch that's the same as with --concatenate-meshes */
+        "quad-duplicates.ply", nullptr,
+        "Mesh batching: 2 mesh instances -> 1 meshes\n"
+        "Ignoring a batched scene not supported by the converter\n"},
+    {"batch meshes with a scene but no default scene", {InPlaceInit, {
+            "--batch-meshes", "-I", "GltfImporter", "-C", "StanfordSceneConverter",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/two-triangles-transformed-no-default-scene.gltf"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/quad-duplicates.ply")
+        }},
+        "GltfImporter", nullptr, "StanfordSceneConverter", {}, nullptr,
+        "quad-duplicates.ply", nullptr,
+        "Ignoring a batched scene not supported by the converter\n"},
+    {"deduplicate, verbose", {InPlaceInit, {
+            /* Forcing the importer and converter to avoid AnySceneImporter /
+               AnySceneConverter delegation messages */
+            "--deduplicate", "-v", "-I", "GltfImporter", "-C", "StanfordSceneConverter",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/two-triangles-duplicates.gltf"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/triangle.ply")
+        }},
+        "GltfImporter", nullptr, "StanfordSceneConverter", {}, nullptr,
+        /* The PLY converter can take just one mesh, so this would fail if the
+           duplicate mesh was passed through as well */
+        nullptr, nullptr,
+        "Deduplication: 2 -> 1 meshes\n"
+        "Deduplication: 0 -> 0 materials\n"
+        "Ignoring 1 scenes not supported by the converter\n"},
     /** @todo drop --mesh once it's not needed anymore again, then add a
         multi-mesh variant */
     {"one mesh, filter mesh attributes", {InPlaceInit, {
@@ -986,6 +1021,16 @@ const struct {
         }},
         nullptr, nullptr, nullptr, nullptr,
         "The --mesh and --concatenate-meshes options are mutually exclusive\n"},
+    {"--batch-meshes and --concatenate-meshes", {InPlaceInit, {
+            "--batch-meshes", "--concatenate-meshes", "a", "b"
+        }},
+        nullptr, nullptr, nullptr, nullptr,
+        "The --batch-meshes option can't be combined with --mesh or --concatenate-meshes\n"},
+    {"--deduplicate and --batch-meshes", {InPlaceInit, {
+            "--deduplicate", "--batch-meshes", "a", "b"
+        }},
+        nullptr, nullptr, nullptr, nullptr,
+        "The --deduplicate option can't be combined with --mesh, --concatenate-meshes or --batch-meshes\n"},
     {"--mesh-level but no --mesh", {InPlaceInit, {
             "--mesh-level", "0", "a", "b"
         }},
@@ -1061,6 +1106,28 @@ const struct {
         }},
         "GltfImporter", nullptr, nullptr, nullptr,
         Utility::format("No meshes found in {}\n", Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/empty.gltf"))},
+    {"no scenes found for mesh batching", {InPlaceInit, {
+            "--batch-meshes",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/empty.gltf"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/whatever.ply")
+        }},
+        "GltfImporter", nullptr, nullptr, nullptr,
+        Utility::format("No scenes found in {} for mesh batching\n", Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/empty.gltf"))},
+    {"no mesh instances for mesh batching", {InPlaceInit, {
+            "--batch-meshes",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/scene-without-meshes.gltf"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/whatever.ply")
+        }},
+        "GltfImporter", nullptr, nullptr, nullptr,
+        "Scene 0 has no mesh instances, nothing to batch\n"},
+    {"can't import a mesh for deduplication", {InPlaceInit, {
+            "-I", "ObjImporter", "--deduplicate",
+            Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/broken-mesh.obj"),
+            Utility::Path::join(SCENETOOLS_TEST_OUTPUT_DIR, "SceneConverterTestFiles/whatever.ply")
+        }},
+        "ObjImporter", nullptr, nullptr, nullptr,
+        "Trade::ObjImporter::mesh(): wrong index count for point\n"
+        "Cannot import mesh 0\n"},
     {"can't import a single mesh", {InPlaceInit, {
             "-I", "ObjImporter", "--mesh", "0",
             Utility::Path::join(SCENETOOLS_TEST_DIR, "SceneConverterTestFiles/broken-mesh.obj"),
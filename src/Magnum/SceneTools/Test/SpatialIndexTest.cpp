@@ -0,0 +1,540 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneTools/SpatialIndex.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void construct();
+    void constructEmpty();
+    void constructInvalidSize();
+    void constructScene();
+    void constructSceneGlobalTransformation();
+    void constructSceneNot3D();
+    void constructSceneNoMeshField();
+    void constructSceneNoParentField();
+    void constructSceneMeshOutOfRange();
+
+    void intersectRange();
+    void intersectRangeFlat();
+    void intersectFrustum();
+    void intersectRay();
+    void intersectMany();
+
+    void setTransformation();
+    void setTransformationOutOfRange();
+    void setTransformations();
+    void setTransformationsInvalidSize();
+    void rebuild();
+};
+
+using namespace Math::Literals;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::construct,
+              &SpatialIndexTest::constructEmpty,
+              &SpatialIndexTest::constructInvalidSize,
+              &SpatialIndexTest::constructScene,
+              &SpatialIndexTest::constructSceneGlobalTransformation,
+              &SpatialIndexTest::constructSceneNot3D,
+              &SpatialIndexTest::constructSceneNoMeshField,
+              &SpatialIndexTest::constructSceneNoParentField,
+              &SpatialIndexTest::constructSceneMeshOutOfRange,
+
+              &SpatialIndexTest::intersectRange,
+              &SpatialIndexTest::intersectRangeFlat,
+              &SpatialIndexTest::intersectFrustum,
+              &SpatialIndexTest::intersectRay,
+              &SpatialIndexTest::intersectMany,
+
+              &SpatialIndexTest::setTransformation,
+              &SpatialIndexTest::setTransformationOutOfRange,
+              &SpatialIndexTest::setTransformations,
+              &SpatialIndexTest::setTransformationsInvalidSize,
+              &SpatialIndexTest::rebuild});
+}
+
+/* Ten unit cubes along the X axis, centered at 0, 2, 4, ... 18 */
+SpatialIndex3D row() {
+    UnsignedInt objects[10];
+    Range3D bounds[10];
+    Matrix4 transformations[10];
+    for(UnsignedInt i = 0; i != 10; ++i) {
+        objects[i] = 100 + i;
+        bounds[i] = {Vector3{-0.5f}, Vector3{0.5f}};
+        transformations[i] = Matrix4::translation(Vector3::xAxis(2.0f*i));
+    }
+
+    return SpatialIndex3D{objects, bounds, transformations};
+}
+
+void SpatialIndexTest::construct() {
+    const UnsignedInt objects[]{3, 7, 1};
+    const Range3D bounds[]{
+        {{0.0f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f}},
+        {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    };
+    const Matrix4 transformations[]{
+        Matrix4::rotationZ(90.0_degf),
+        Matrix4::translation({5.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 1.0f, 1.0f}),
+        Matrix4{},
+    };
+
+    SpatialIndex3D index{objects, bounds, transformations};
+    CORRADE_COMPARE(index.size(), 3);
+    /* Just a single leaf */
+    CORRADE_COMPARE(index.nodeCount(), 1);
+    CORRADE_COMPARE_AS(index.objects(),
+        Containers::arrayView(objects),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(index.localBounds(),
+        Containers::arrayView(bounds),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(index.bounds(), Containers::arrayView<Range3D>({
+        {{-1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 1.0f}},
+        {{3.0f, -1.0f, -1.0f}, {7.0f, 1.0f, 1.0f}},
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(index.range(), (Range3D{{-1.0f, -1.0f, -1.0f}, {7.0f, 2.0f, 1.0f}}));
+}
+
+void SpatialIndexTest::constructEmpty() {
+    SpatialIndex3D index{nullptr, nullptr, nullptr};
+    CORRADE_COMPARE(index.size(), 0);
+    CORRADE_COMPARE(index.nodeCount(), 0);
+    CORRADE_COMPARE(index.range(), Range3D{});
+    CORRADE_COMPARE(index.intersectRange({Vector3{-100.0f}, Vector3{100.0f}}).size(), 0);
+    CORRADE_COMPARE(index.intersectFrustum({}).size(), 0);
+    CORRADE_COMPARE(index.intersectRay({}, Vector3::zAxis()).size(), 0);
+
+    /* Shouldn't crash */
+    index.setTransformations(nullptr)
+         .rebuild();
+    CORRADE_COMPARE(index.nodeCount(), 0);
+}
+
+void SpatialIndexTest::constructInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt objects[3]{};
+    Range3D bounds[3];
+    Range3D boundsInvalid[2];
+    Matrix4 transformations[3];
+    Matrix4 transformationsInvalid[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D{objects, boundsInvalid, transformations};
+    SpatialIndex3D{objects, bounds, transformationsInvalid};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D: expected bounds view with 3 elements but got 2\n"
+        "SceneTools::SpatialIndex3D: expected transformation view with 3 elements but got 4\n");
+}
+
+/*
+      0T      2
+     /  \
+    1M   3TM    4M
+
+   Object 0 is translated by 10 on X, object 3 scaled by 2. Object 4 isn't a
+   part of the hierarchy.
+*/
+const struct Scene {
+    struct Parent {
+        UnsignedInt object;
+        Int parent;
+    } parents[4];
+
+    struct Transformation {
+        UnsignedInt object;
+        Matrix4 transformation;
+    } transforms[2];
+
+    struct Mesh {
+        UnsignedInt object;
+        UnsignedInt mesh;
+    } meshes[4];
+} Data[]{{
+    {{0, -1},
+     {1, 0},
+     {2, -1},
+     {3, 0}},
+    {{0, Matrix4::translation({10.0f, 0.0f, 0.0f})},
+     {3, Matrix4::scaling({2.0f, 2.0f, 2.0f})}},
+    {{1, 1},
+     {2, 0},
+     {3, 1},
+     {4, 0}}
+}};
+
+const Range3D MeshBounds[]{
+    {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+    {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}
+};
+
+Trade::SceneData scene() {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 5, {}, Data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::object),
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::object),
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::transformation)},
+    }};
+}
+
+void SpatialIndexTest::constructScene() {
+    SpatialIndex3D index{scene(), MeshBounds};
+    CORRADE_COMPARE(index.size(), 4);
+    CORRADE_COMPARE_AS(index.objects(), Containers::arrayView<UnsignedInt>({
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(index.localBounds(), Containers::arrayView<Range3D>({
+        MeshBounds[1],
+        MeshBounds[0],
+        MeshBounds[1],
+        MeshBounds[0]
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(index.bounds(), Containers::arrayView<Range3D>({
+        {{10.0f, 0.0f, 0.0f}, {11.0f, 1.0f, 1.0f}},
+        {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+        {{10.0f, 0.0f, 0.0f}, {12.0f, 2.0f, 2.0f}},
+        {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(index.range(), (Range3D{{-1.0f, -1.0f, -1.0f}, {12.0f, 2.0f, 2.0f}}));
+}
+
+void SpatialIndexTest::constructSceneGlobalTransformation() {
+    SpatialIndex3D index{scene(), MeshBounds, Matrix4::translation({0.0f, 0.0f, 5.0f})};
+    CORRADE_COMPARE_AS(index.bounds(), Containers::arrayView<Range3D>({
+        {{10.0f, 0.0f, 5.0f}, {11.0f, 1.0f, 6.0f}},
+        {{-1.0f, -1.0f, 4.0f}, {1.0f, 1.0f, 6.0f}},
+        {{10.0f, 0.0f, 5.0f}, {12.0f, 2.0f, 7.0f}},
+        /* Objects outside of the hierarchy don't get the global
+           transformation applied, consistently with
+           absoluteFieldTransformations3D() */
+        {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}},
+    }), TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::constructSceneNot3D() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix3x3, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D{scene, nullptr};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D: the scene is not 3D\n");
+}
+
+void SpatialIndexTest::constructSceneNoMeshField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D{scene, nullptr};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D: the scene has no meshes\n");
+}
+
+void SpatialIndexTest::constructSceneNoParentField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::UnsignedInt, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D{scene, nullptr};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D: the scene has no hierarchy\n");
+}
+
+void SpatialIndexTest::constructSceneMeshOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D{scene(), Containers::arrayView(MeshBounds).prefix(1)};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D: mesh 1 out of range for 1 bounds\n");
+}
+
+void SpatialIndexTest::intersectRange() {
+    SpatialIndex3D index = row();
+    /* Split into two halves of five and each of them again into two */
+    CORRADE_COMPARE(index.nodeCount(), 7);
+
+    /* Bounds touching the range are included */
+    CORRADE_COMPARE_AS(index.intersectRange({{1.5f, -1.0f, -1.0f}, {4.5f, 1.0f, 1.0f}}),
+        Containers::arrayView<UnsignedInt>({1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Everything */
+    CORRADE_COMPARE_AS(index.intersectRange(index.range()),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+        TestSuite::Compare::Container);
+
+    /* In between the cubes */
+    CORRADE_COMPARE(index.intersectRange({{0.75f, -1.0f, -1.0f}, {1.25f, 1.0f, 1.0f}}).size(), 0);
+
+    /* Outside of everything */
+    CORRADE_COMPARE(index.intersectRange({{-1.0f, 5.0f, -1.0f}, {100.0f, 6.0f, 1.0f}}).size(), 0);
+}
+
+void SpatialIndexTest::intersectRangeFlat() {
+    /* A plane has zero size in one dimension, it shouldn't get lost when
+       calculating node bounds */
+    const UnsignedInt objects[]{0, 1, 2, 3, 4, 5};
+    const Range3D bounds[]{
+        {{-1.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 1.0f}},
+        {Vector3{-0.5f}, Vector3{0.5f}},
+        {Vector3{-0.5f}, Vector3{0.5f}},
+        {Vector3{-0.5f}, Vector3{0.5f}},
+        {Vector3{-0.5f}, Vector3{0.5f}},
+        {Vector3{-0.5f}, Vector3{0.5f}},
+    };
+    const Matrix4 transformations[]{
+        Matrix4::translation({0.0f, -5.0f, 0.0f}),
+        Matrix4::translation({1.0f, 0.0f, 0.0f}),
+        Matrix4::translation({2.0f, 0.0f, 0.0f}),
+        Matrix4::translation({3.0f, 0.0f, 0.0f}),
+        Matrix4::translation({4.0f, 0.0f, 0.0f}),
+        Matrix4::translation({5.0f, 0.0f, 0.0f}),
+    };
+
+    SpatialIndex3D index{objects, bounds, transformations};
+    CORRADE_COMPARE(index.range(), (Range3D{{-1.0f, -5.0f, -1.0f}, {5.5f, 0.5f, 1.0f}}));
+    CORRADE_COMPARE_AS(index.intersectRange({{-0.5f, -5.5f, -0.5f}, {0.5f, -4.5f, 0.5f}}),
+        Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::intersectFrustum() {
+    SpatialIndex3D index = row();
+
+    /* A box frustum spanning -1 to 5 on X and -1 to 1 on Y and Z */
+    const Frustum frustum{
+        { 1.0f,  0.0f,  0.0f, 1.0f},
+        {-1.0f,  0.0f,  0.0f, 5.0f},
+        { 0.0f,  1.0f,  0.0f, 1.0f},
+        { 0.0f, -1.0f,  0.0f, 1.0f},
+        { 0.0f,  0.0f,  1.0f, 1.0f},
+        { 0.0f,  0.0f, -1.0f, 1.0f}};
+    CORRADE_COMPARE_AS(index.intersectFrustum(frustum),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Shifted away on Y */
+    const Frustum frustumOutside{
+        { 1.0f,  0.0f,  0.0f, 1.0f},
+        {-1.0f,  0.0f,  0.0f, 5.0f},
+        { 0.0f,  1.0f,  0.0f, -3.0f},
+        { 0.0f, -1.0f,  0.0f, 5.0f},
+        { 0.0f,  0.0f,  1.0f, 1.0f},
+        { 0.0f,  0.0f, -1.0f, 1.0f}};
+    CORRADE_COMPARE(index.intersectFrustum(frustumOutside).size(), 0);
+}
+
+void SpatialIndexTest::intersectRay() {
+    SpatialIndex3D index = row();
+
+    /* Along the row */
+    CORRADE_COMPARE_AS(index.intersectRay({-10.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+        TestSuite::Compare::Container);
+
+    /* Perpendicular to the row, hitting just one */
+    CORRADE_COMPARE_AS(index.intersectRay({4.0f, -10.0f, 0.0f}, {0.0f, 1.0f, 0.0f}),
+        Containers::arrayView<UnsignedInt>({2}),
+        TestSuite::Compare::Container);
+
+    /* Diagonal, leaving the row after the third */
+    CORRADE_COMPARE_AS(index.intersectRay({0.0f, 0.0f, 0.0f}, {1.0f, 0.1f, 0.0f}),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    /* Missing everything */
+    CORRADE_COMPARE(index.intersectRay({0.0f, 3.0f, 0.0f}, {1.0f, 0.0f, 0.0f}).size(), 0);
+}
+
+void SpatialIndexTest::intersectMany() {
+    /* Pseudo-randomly distributed boxes of varying sizes, results compared to
+       a brute-force test of all bounds */
+    Containers::Array<UnsignedInt> objects;
+    Containers::Array<Range3D> bounds;
+    Containers::Array<Matrix4> transformations;
+    for(UnsignedInt i = 0; i != 1000; ++i) {
+        arrayAppend(objects, i);
+        arrayAppend(bounds, Range3D::fromCenter({}, Vector3{0.5f + (i % 7)*0.25f}));
+        arrayAppend(transformations, Matrix4::translation({
+            Float((i*37) % 101),
+            Float((i*53) % 103),
+            Float((i*71) % 107)}));
+    }
+
+    SpatialIndex3D index{objects, bounds, transformations};
+    CORRADE_COMPARE(index.size(), 1000);
+    CORRADE_COMPARE_AS(index.nodeCount(), 2*index.size(),
+        TestSuite::Compare::Less);
+
+    const Range3D queries[]{
+        {{0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}},
+        {{50.0f, 20.0f, 70.0f}, {70.0f, 60.0f, 80.0f}},
+        {{-5.0f, 30.0f, -5.0f}, {120.0f, 32.0f, 120.0f}},
+    };
+    for(const Range3D& query: queries) {
+        CORRADE_ITERATION(query);
+
+        Containers::Array<UnsignedInt> expected;
+        for(UnsignedInt i = 0; i != index.size(); ++i) {
+            const Range3D& b = index.bounds()[i];
+            if((b.min() <= query.max()).all() && (query.min() <= b.max()).all())
+                arrayAppend(expected, i);
+        }
+        CORRADE_VERIFY(!expected.isEmpty());
+
+        CORRADE_COMPARE_AS(index.intersectRange(query),
+            expected,
+            TestSuite::Compare::Container);
+    }
+}
+
+void SpatialIndexTest::setTransformation() {
+    SpatialIndex3D index = row();
+    const std::size_t nodeCount = index.nodeCount();
+
+    index.setTransformation(0, Matrix4::translation({20.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(index.bounds()[0], (Range3D{{19.5f, -0.5f, -0.5f}, {20.5f, 0.5f, 0.5f}}));
+    CORRADE_COMPARE(index.range(), (Range3D{{1.5f, -0.5f, -0.5f}, {20.5f, 0.5f, 0.5f}}));
+
+    /* The structure stays the same, just the bounds get refit */
+    CORRADE_COMPARE(index.nodeCount(), nodeCount);
+    CORRADE_COMPARE(index.intersectRange({Vector3{-1.0f}, Vector3{1.0f}}).size(), 0);
+    CORRADE_COMPARE_AS(index.intersectRange({{18.5f, -1.0f, -1.0f}, {21.0f, 1.0f, 1.0f}}),
+        Containers::arrayView<UnsignedInt>({0, 9}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::setTransformationOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SpatialIndex3D index = row();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    index.setTransformation(10, {});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D::setTransformation(): index 10 out of range for 10 entries\n");
+}
+
+void SpatialIndexTest::setTransformations() {
+    SpatialIndex3D index = row();
+
+    /* Move everything up by 3 */
+    Matrix4 transformations[10];
+    for(std::size_t i = 0; i != 10; ++i)
+        transformations[i] = Matrix4::translation({2.0f*i, 3.0f, 0.0f});
+    index.setTransformations(transformations);
+    CORRADE_COMPARE(index.range(), (Range3D{{-0.5f, 2.5f, -0.5f}, {18.5f, 3.5f, 0.5f}}));
+    CORRADE_COMPARE(index.intersectRay({-10.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}).size(), 0);
+    CORRADE_COMPARE_AS(index.intersectRay({-10.0f, 3.0f, 0.0f}, {1.0f, 0.0f, 0.0f}),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::setTransformationsInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SpatialIndex3D index = row();
+
+    Matrix4 transformations[9];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    index.setTransformations(transformations);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::SpatialIndex3D::setTransformations(): expected transformation view with 10 elements but got 9\n");
+}
+
+void SpatialIndexTest::rebuild() {
+    SpatialIndex3D index = row();
+
+    /* Reverse the row, which makes the original hierarchy rather bad */
+    Matrix4 transformations[10];
+    for(std::size_t i = 0; i != 10; ++i)
+        transformations[i] = Matrix4::translation(Vector3::xAxis(18.0f - 2.0f*i));
+    index.setTransformations(transformations)
+         .rebuild();
+
+    CORRADE_COMPARE(index.nodeCount(), 7);
+    CORRADE_COMPARE(index.range(), (Range3D{{-0.5f, -0.5f, -0.5f}, {18.5f, 0.5f, 0.5f}}));
+    CORRADE_COMPARE_AS(index.intersectRange({{1.5f, -1.0f, -1.0f}, {4.5f, 1.0f, 1.0f}}),
+        Containers::arrayView<UnsignedInt>({7, 8}),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::SpatialIndexTest)
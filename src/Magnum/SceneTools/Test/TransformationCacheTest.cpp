@@ -0,0 +1,431 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneTools/TransformationCache.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct TransformationCacheTest: TestSuite::Tester {
+    explicit TransformationCacheTest();
+
+    void construct2D();
+    void construct3D();
+    void constructGlobalTransformation();
+    void constructNot2DNot3D();
+    void constructNoParentField();
+
+    void update();
+    void updateNestedDirty();
+    void updateNotInHierarchy();
+    void updateGlobalTransformation();
+    void updateNothingDirty();
+
+    void setLocalTransformationOutOfRange();
+    void setLocalTransformationsInvalidSize();
+
+    void absoluteFieldTransformationsInto();
+    void absoluteFieldTransformationsIntoInvalid();
+};
+
+using namespace Math::Literals;
+
+TransformationCacheTest::TransformationCacheTest() {
+    addTests({&TransformationCacheTest::construct2D,
+              &TransformationCacheTest::construct3D,
+              &TransformationCacheTest::constructGlobalTransformation,
+              &TransformationCacheTest::constructNot2DNot3D,
+              &TransformationCacheTest::constructNoParentField,
+
+              &TransformationCacheTest::update,
+              &TransformationCacheTest::updateNestedDirty,
+              &TransformationCacheTest::updateNotInHierarchy,
+              &TransformationCacheTest::updateGlobalTransformation,
+              &TransformationCacheTest::updateNothingDirty,
+
+              &TransformationCacheTest::setLocalTransformationOutOfRange,
+              &TransformationCacheTest::setLocalTransformationsInvalidSize,
+
+              &TransformationCacheTest::absoluteFieldTransformationsInto,
+              &TransformationCacheTest::absoluteFieldTransformationsIntoInvalid});
+}
+
+/*
+      0T       3
+     /  \      |       6T
+    1T   2T    4T
+    |
+    5
+
+   Depth-first order is 0, 1, 5, 2, 3, 4. Object 6 is not a part of the
+   hierarchy.
+*/
+const struct Scene {
+    struct Parent {
+        UnsignedInt object;
+        Int parent;
+    } parents[6];
+
+    struct Transformation {
+        UnsignedInt object;
+        Matrix3 transformation2D;
+        Matrix4 transformation3D;
+    } transforms[5];
+
+    struct Mesh {
+        UnsignedInt object;
+        UnsignedInt mesh;
+    } meshes[3];
+} Data[]{{
+    {{0, -1},
+     {1, 0},
+     {2, 0},
+     {3, -1},
+     {4, 3},
+     {5, 1}},
+    {{0, Matrix3::translation({1.0f, 0.0f}),
+         Matrix4::translation({1.0f, 0.0f, 0.0f})},
+     {1, Matrix3::scaling({2.0f, 2.0f}),
+         Matrix4::scaling({2.0f, 2.0f, 2.0f})},
+     {2, Matrix3::rotation(90.0_degf),
+         Matrix4::rotationZ(90.0_degf)},
+     {4, Matrix3::translation({0.0f, 2.0f}),
+         Matrix4::translation({0.0f, 2.0f, 0.0f})},
+     {6, Matrix3::translation({0.0f, 3.0f}),
+         Matrix4::translation({0.0f, 0.0f, 3.0f})}},
+    /* Mesh IDs aren't used for anything */
+    {{5, 7},
+     {4, 13},
+     {6, 2}}
+}};
+
+Trade::SceneData scene2D() {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 7, {}, Data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::object),
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::object),
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::transformation2D)},
+    }};
+}
+
+Trade::SceneData scene3D() {
+    return Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 7, {}, Data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::object),
+            Containers::stridedArrayView(Data->parents)
+                .slice(&Scene::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(Data->meshes)
+                .slice(&Scene::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::object),
+            Containers::stridedArrayView(Data->transforms)
+                .slice(&Scene::Transformation::transformation3D)},
+    }};
+}
+
+void TransformationCacheTest::construct2D() {
+    TransformationCache2D cache{scene2D()};
+    CORRADE_COMPARE(cache.objectCount(), 7);
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.globalTransformation(), Matrix3{});
+    CORRADE_COMPARE_AS(cache.childrenDepthFirst(), (Containers::arrayView<Containers::Pair<UnsignedInt, UnsignedInt>>({
+        {0, 3},
+        {1, 1},
+        {5, 0},
+        {2, 0},
+        {3, 1},
+        {4, 0}
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(cache.localTransformations(), Containers::arrayView({
+        Matrix3::translation({1.0f, 0.0f}),
+        Matrix3::scaling({2.0f, 2.0f}),
+        Matrix3::rotation(90.0_degf),
+        Matrix3{},
+        Matrix3::translation({0.0f, 2.0f}),
+        Matrix3{},
+        Matrix3::translation({0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(cache.absoluteTransformations(), Containers::arrayView({
+        Matrix3::translation({1.0f, 0.0f}),
+        Matrix3::translation({1.0f, 0.0f})*
+            Matrix3::scaling({2.0f, 2.0f}),
+        Matrix3::translation({1.0f, 0.0f})*
+            Matrix3::rotation(90.0_degf),
+        Matrix3{},
+        Matrix3::translation({0.0f, 2.0f}),
+        Matrix3::translation({1.0f, 0.0f})*
+            Matrix3::scaling({2.0f, 2.0f}),
+        Matrix3::translation({0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+}
+
+void TransformationCacheTest::construct3D() {
+    TransformationCache3D cache{scene3D()};
+    CORRADE_COMPARE(cache.objectCount(), 7);
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.globalTransformation(), Matrix4{});
+    CORRADE_COMPARE_AS(cache.absoluteTransformations(), Containers::arrayView({
+        Matrix4::translation({1.0f, 0.0f, 0.0f}),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+            Matrix4::rotationZ(90.0_degf),
+        Matrix4{},
+        Matrix4::translation({0.0f, 2.0f, 0.0f}),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::translation({0.0f, 0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+}
+
+void TransformationCacheTest::constructGlobalTransformation() {
+    TransformationCache3D cache{scene3D(), Matrix4::scaling(Vector3{0.5f})};
+    CORRADE_COMPARE(cache.globalTransformation(), Matrix4::scaling(Vector3{0.5f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[5],
+        Matrix4::scaling(Vector3{0.5f})*
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::scaling({2.0f, 2.0f, 2.0f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[4],
+        Matrix4::scaling(Vector3{0.5f})*
+        Matrix4::translation({0.0f, 2.0f, 0.0f}));
+    /* Objects outside of the hierarchy don't get the global transformation
+       applied, consistently with absoluteFieldTransformations3D() */
+    CORRADE_COMPARE(cache.absoluteTransformations()[6],
+        Matrix4::translation({0.0f, 0.0f, 3.0f}));
+}
+
+void TransformationCacheTest::constructNot2DNot3D() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TransformationCache2D{scene};
+    TransformationCache3D{scene};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::TransformationCache: the scene is not 2D\n"
+        "SceneTools::TransformationCache: the scene is not 3D\n");
+}
+
+void TransformationCacheTest::constructNoParentField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix3x3, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TransformationCache2D{scene};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::TransformationCache: the scene has no hierarchy\n");
+}
+
+void TransformationCacheTest::update() {
+    TransformationCache3D cache{scene3D()};
+
+    cache.setLocalTransformation(1, Matrix4::translation({0.0f, 1.0f, 0.0f}));
+    CORRADE_VERIFY(cache.isDirty());
+    CORRADE_COMPARE(cache.localTransformations()[1], Matrix4::translation({0.0f, 1.0f, 0.0f}));
+
+    /* Only object 1 and its child 5 get recalculated */
+    CORRADE_COMPARE(cache.update(), 2);
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE_AS(cache.absoluteTransformations(), Containers::arrayView({
+        Matrix4::translation({1.0f, 0.0f, 0.0f}),
+        Matrix4::translation({1.0f, 1.0f, 0.0f}),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+            Matrix4::rotationZ(90.0_degf),
+        Matrix4{},
+        Matrix4::translation({0.0f, 2.0f, 0.0f}),
+        Matrix4::translation({1.0f, 1.0f, 0.0f}),
+        Matrix4::translation({0.0f, 0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+
+    /* Two independent subtrees */
+    Matrix4 transformations[]{
+        Matrix4::translation({0.0f, 0.0f, 1.0f}),
+        Matrix4::scaling({1.0f, 3.0f, 1.0f})
+    };
+    UnsignedInt objects[]{4, 2};
+    cache.setLocalTransformations(objects, transformations);
+    CORRADE_COMPARE(cache.update(), 2);
+    CORRADE_COMPARE(cache.absoluteTransformations()[4],
+        Matrix4::translation({0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[2],
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::scaling({1.0f, 3.0f, 1.0f}));
+}
+
+void TransformationCacheTest::updateNestedDirty() {
+    TransformationCache3D cache{scene3D()};
+
+    /* Setting the child first, then the parent, and the child again. The
+       child subtree should be processed just once as a part of the parent. */
+    cache.setLocalTransformation(5, Matrix4::translation({0.0f, 0.0f, 2.0f}))
+         .setLocalTransformation(0, Matrix4::translation({3.0f, 0.0f, 0.0f}))
+         .setLocalTransformation(5, Matrix4::translation({0.0f, 0.0f, 4.0f}));
+    CORRADE_COMPARE(cache.update(), 4);
+    CORRADE_COMPARE_AS(cache.absoluteTransformations(), Containers::arrayView({
+        Matrix4::translation({3.0f, 0.0f, 0.0f}),
+        Matrix4::translation({3.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::translation({3.0f, 0.0f, 0.0f})*
+            Matrix4::rotationZ(90.0_degf),
+        Matrix4{},
+        Matrix4::translation({0.0f, 2.0f, 0.0f}),
+        Matrix4::translation({3.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 2.0f, 2.0f})*
+            Matrix4::translation({0.0f, 0.0f, 4.0f}),
+        Matrix4::translation({0.0f, 0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+}
+
+void TransformationCacheTest::updateNotInHierarchy() {
+    TransformationCache3D cache{scene3D()};
+
+    /* Object 6 isn't in the hierarchy, so it's updated right away and nothing
+       is marked as dirty */
+    cache.setLocalTransformation(6, Matrix4::translation({0.0f, 5.0f, 0.0f}));
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.absoluteTransformations()[6],
+        Matrix4::translation({0.0f, 5.0f, 0.0f}));
+    CORRADE_COMPARE(cache.update(), 0);
+}
+
+void TransformationCacheTest::updateGlobalTransformation() {
+    TransformationCache3D cache{scene3D()};
+
+    cache.setGlobalTransformation(Matrix4::translation({0.0f, 0.0f, -1.0f}));
+    CORRADE_VERIFY(cache.isDirty());
+    CORRADE_COMPARE(cache.update(), 6);
+    CORRADE_COMPARE(cache.absoluteTransformations()[3],
+        Matrix4::translation({0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(cache.absoluteTransformations()[2],
+        Matrix4::translation({1.0f, 0.0f, -1.0f})*
+        Matrix4::rotationZ(90.0_degf));
+}
+
+void TransformationCacheTest::updateNothingDirty() {
+    TransformationCache2D cache{scene2D()};
+    CORRADE_VERIFY(!cache.isDirty());
+    CORRADE_COMPARE(cache.update(), 0);
+}
+
+void TransformationCacheTest::setLocalTransformationOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TransformationCache2D cache{scene2D()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setLocalTransformation(7, {});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::TransformationCache::setLocalTransformation(): index 7 out of range for 7 objects\n");
+}
+
+void TransformationCacheTest::setLocalTransformationsInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    TransformationCache2D cache{scene2D()};
+
+    UnsignedInt objects[3]{};
+    Matrix3 transformations[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setLocalTransformations(objects, transformations);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::TransformationCache::setLocalTransformations(): expected transformation view with 3 elements but got 2\n");
+}
+
+void TransformationCacheTest::absoluteFieldTransformationsInto() {
+    Trade::SceneData scene = scene3D();
+    TransformationCache3D cache{scene};
+    cache.setLocalTransformation(3, Matrix4::translation({0.0f, 0.0f, 1.0f}))
+         .update();
+
+    Matrix4 out[3];
+    cache.absoluteFieldTransformationsInto(scene, 1, out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView({
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+            Matrix4::scaling({2.0f, 2.0f, 2.0f}),
+        Matrix4::translation({0.0f, 2.0f, 1.0f}),
+        Matrix4::translation({0.0f, 0.0f, 3.0f})
+    }), TestSuite::Compare::Container);
+}
+
+void TransformationCacheTest::absoluteFieldTransformationsIntoInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene = scene2D();
+    TransformationCache2D cache{scene};
+
+    Trade::SceneData different{Trade::SceneMappingType::UnsignedInt, 8, nullptr, {}};
+
+    Matrix3 transformations[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.absoluteFieldTransformationsInto(different, 0, transformations);
+    cache.absoluteFieldTransformationsInto(scene, 3, transformations);
+    cache.absoluteFieldTransformationsInto(scene, 1, Containers::arrayView(transformations).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): expected a scene with 7 objects but got 8\n"
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): index 3 out of range for 3 fields\n"
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): bad output size, expected 3 but got 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::TransformationCacheTest)
@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransformationCache.h"
+
+#include <algorithm> /* std::sort() */
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneTools/Hierarchy.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+template<UnsignedInt> struct SceneDataDimensionTraits;
+template<> struct SceneDataDimensionTraits<2> {
+    static bool isDimensions(const Trade::SceneData& scene) {
+        return scene.is2D();
+    }
+    static Containers::Array<Containers::Pair<UnsignedInt, Matrix3>> transformationsAsArray(const Trade::SceneData& scene) {
+        return scene.transformations2DAsArray();
+    }
+};
+template<> struct SceneDataDimensionTraits<3> {
+    static bool isDimensions(const Trade::SceneData& scene) {
+        return scene.is3D();
+    }
+    static Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> transformationsAsArray(const Trade::SceneData& scene) {
+        return scene.transformations3DAsArray();
+    }
+};
+
+}
+
+template<UnsignedInt dimensions> struct TransformationCache<dimensions>::State {
+    MatrixTypeFor<dimensions, Float> globalTransformation;
+
+    /* Output of childrenDepthFirst() */
+    Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> childrenDepthFirst;
+    /* Offset of the parent in childrenDepthFirst for each item in
+       childrenDepthFirst, or -1 for top-level objects */
+    Containers::Array<Int> parentOffsets;
+    /* Offset in childrenDepthFirst for each object ID, or ~UnsignedInt{} if
+       the object isn't a part of the hierarchy */
+    Containers::Array<UnsignedInt> objectOffsets;
+
+    /* Indexed by object ID */
+    Containers::Array<MatrixTypeFor<dimensions, Float>> localTransformations;
+    Containers::Array<MatrixTypeFor<dimensions, Float>> absoluteTransformations;
+
+    /* Offsets in childrenDepthFirst that are dirty, the bit array is used to
+       avoid adding the same offset more than once */
+    Containers::BitArray dirtyMask;
+    Containers::Array<UnsignedInt> dirty;
+};
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>::TransformationCache(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation): _state{InPlaceInit} {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::TransformationCache: the scene is not" << dimensions << Debug::nospace << "D", );
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Parent),
+        "SceneTools::TransformationCache: the scene has no hierarchy", );
+
+    State& state = *_state;
+    state.childrenDepthFirst = SceneTools::childrenDepthFirst(scene);
+
+    /* Local transformations indexed by object ID. Since not all objects may
+       have a transformation assigned, the array is initialized to identity
+       first. Absolute transformations of objects that are not in the
+       hierarchy stay equal to the local ones. */
+    const std::size_t objectCount = scene.mappingBound();
+    state.localTransformations = Containers::Array<MatrixTypeFor<dimensions, Float>>{ValueInit, objectCount};
+    for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: SceneDataDimensionTraits<dimensions>::transformationsAsArray(scene)) {
+        CORRADE_INTERNAL_ASSERT(transformation.first() < objectCount);
+        state.localTransformations[transformation.first()] = transformation.second();
+    }
+    state.absoluteTransformations = Containers::Array<MatrixTypeFor<dimensions, Float>>{NoInit, objectCount};
+    for(std::size_t i = 0; i != objectCount; ++i)
+        state.absoluteTransformations[i] = state.localTransformations[i];
+
+    /* Object ID to depth-first offset mapping */
+    state.objectOffsets = Containers::Array<UnsignedInt>{DirectInit, objectCount, ~UnsignedInt{}};
+    for(std::size_t i = 0; i != state.childrenDepthFirst.size(); ++i)
+        state.objectOffsets[state.childrenDepthFirst[i].first()] = i;
+
+    /* Parent offset for each item in the depth-first list. Maintain a stack
+       of (offset, end offset of its subtree) pairs, the parent of an item is
+       the topmost stack item whose subtree still contains it. */
+    state.parentOffsets = Containers::Array<Int>{NoInit, state.childrenDepthFirst.size()};
+    {
+        Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> stack{NoInit, state.childrenDepthFirst.size()};
+        std::size_t stackSize = 0;
+        for(std::size_t i = 0; i != state.childrenDepthFirst.size(); ++i) {
+            while(stackSize && stack[stackSize - 1].second() <= i)
+                --stackSize;
+            state.parentOffsets[i] = stackSize ? Int(stack[stackSize - 1].first()) : -1;
+            stack[stackSize++] = {UnsignedInt(i), UnsignedInt(i + state.childrenDepthFirst[i].second() + 1)};
+        }
+    }
+
+    state.dirtyMask = Containers::BitArray{ValueInit, state.childrenDepthFirst.size()};
+
+    /* Calculate everything for the first time */
+    setGlobalTransformation(globalTransformation);
+    update();
+}
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>::TransformationCache(const Trade::SceneData& scene): TransformationCache{scene, {}} {}
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>::TransformationCache(TransformationCache<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>::~TransformationCache() = default;
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>& TransformationCache<dimensions>::operator=(TransformationCache<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> std::size_t TransformationCache<dimensions>::objectCount() const {
+    return _state->localTransformations.size();
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<const Containers::Pair<UnsignedInt, UnsignedInt>> TransformationCache<dimensions>::childrenDepthFirst() const {
+    return _state->childrenDepthFirst;
+}
+
+template<UnsignedInt dimensions> MatrixTypeFor<dimensions, Float> TransformationCache<dimensions>::globalTransformation() const {
+    return _state->globalTransformation;
+}
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>& TransformationCache<dimensions>::setGlobalTransformation(const MatrixTypeFor<dimensions, Float>& transformation) {
+    State& state = *_state;
+    state.globalTransformation = transformation;
+
+    /* Mark all top-level objects as dirty. They're already in the
+       depth-first order, so update() doesn't need to sort them again. */
+    for(std::size_t i = 0; i < state.childrenDepthFirst.size(); i += state.childrenDepthFirst[i].second() + 1) {
+        if(state.dirtyMask[i]) continue;
+        state.dirtyMask.set(i);
+        arrayAppend(state.dirty, UnsignedInt(i));
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> TransformationCache<dimensions>::localTransformations() const {
+    return _state->localTransformations;
+}
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>& TransformationCache<dimensions>::setLocalTransformation(const UnsignedInt object, const MatrixTypeFor<dimensions, Float>& transformation) {
+    State& state = *_state;
+    CORRADE_ASSERT(object < state.localTransformations.size(),
+        "SceneTools::TransformationCache::setLocalTransformation(): index" << object << "out of range for" << state.localTransformations.size() << "objects", *this);
+
+    state.localTransformations[object] = transformation;
+
+    /* Objects that are not in the hierarchy have the absolute transformation
+       the same as local, no need to mark anything as dirty */
+    const UnsignedInt offset = state.objectOffsets[object];
+    if(offset == ~UnsignedInt{}) {
+        state.absoluteTransformations[object] = transformation;
+        return *this;
+    }
+
+    if(!state.dirtyMask[offset]) {
+        state.dirtyMask.set(offset);
+        arrayAppend(state.dirty, offset);
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> TransformationCache<dimensions>& TransformationCache<dimensions>::setLocalTransformations(const Containers::StridedArrayView1D<const UnsignedInt>& objects, const Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>>& transformations) {
+    CORRADE_ASSERT(objects.size() == transformations.size(),
+        "SceneTools::TransformationCache::setLocalTransformations(): expected transformation view with" << objects.size() << "elements but got" << transformations.size(), *this);
+
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        setLocalTransformation(objects[i], transformations[i]);
+
+    return *this;
+}
+
+template<UnsignedInt dimensions> bool TransformationCache<dimensions>::isDirty() const {
+    return !_state->dirty.isEmpty();
+}
+
+template<UnsignedInt dimensions> std::size_t TransformationCache<dimensions>::update() {
+    State& state = *_state;
+
+    /* Sort the dirty offsets so parents are always processed before their
+       children, which then allows to skip dirty children that got already
+       processed as a part of the parent subtree */
+    std::sort(state.dirty.begin(), state.dirty.end());
+
+    std::size_t count = 0;
+    std::size_t processedEnd = 0;
+    for(const UnsignedInt dirty: state.dirty) {
+        state.dirtyMask.reset(dirty);
+
+        /* Already recalculated as a part of a parent subtree */
+        if(dirty < processedEnd) continue;
+
+        /* The subtree is stored contiguously right after the object itself
+           and the depth-first order guarantees a parent is processed before
+           its children */
+        const std::size_t end = dirty + state.childrenDepthFirst[dirty].second() + 1;
+        for(std::size_t i = dirty; i != end; ++i) {
+            const UnsignedInt object = state.childrenDepthFirst[i].first();
+            const Int parentOffset = state.parentOffsets[i];
+            state.absoluteTransformations[object] =
+                (parentOffset == -1 ? state.globalTransformation :
+                    state.absoluteTransformations[state.childrenDepthFirst[parentOffset].first()])*
+                state.localTransformations[object];
+        }
+
+        count += end - dirty;
+        processedEnd = end;
+    }
+
+    /* Keep the capacity for the next round */
+    arrayResize(state.dirty, 0);
+    return count;
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> TransformationCache<dimensions>::absoluteTransformations() const {
+    return _state->absoluteTransformations;
+}
+
+template<UnsignedInt dimensions> void TransformationCache<dimensions>::absoluteFieldTransformationsInto(const Trade::SceneData& scene, const UnsignedInt fieldId, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& transformations) const {
+    const State& state = *_state;
+    CORRADE_ASSERT(scene.mappingBound() == state.localTransformations.size(),
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): expected a scene with" << state.localTransformations.size() << "objects but got" << scene.mappingBound(), );
+    CORRADE_ASSERT(fieldId < scene.fieldCount(),
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): index" << fieldId << "out of range for" << scene.fieldCount() << "fields", );
+    CORRADE_ASSERT(transformations.size() == scene.fieldSize(fieldId),
+        "SceneTools::TransformationCache::absoluteFieldTransformationsInto(): bad output size, expected" << scene.fieldSize(fieldId) << "but got" << transformations.size(), );
+
+    /* The matrix location is abused for object mapping, which is subsequently
+       replaced by the absolute object transformation, same as in
+       absoluteFieldTransformationsInto() */
+    const auto mapping = Containers::arrayCast<UnsignedInt>(transformations);
+    scene.mappingInto(fieldId, mapping);
+    for(std::size_t i = 0; i != mapping.size(); ++i) {
+        CORRADE_INTERNAL_ASSERT(mapping[i] < state.absoluteTransformations.size());
+        transformations[i] = state.absoluteTransformations[mapping[i]];
+    }
+}
+
+template class MAGNUM_SCENETOOLS_EXPORT TransformationCache<2>;
+template class MAGNUM_SCENETOOLS_EXPORT TransformationCache<3>;
+
+}}
@@ -0,0 +1,225 @@
+#ifndef Magnum_SceneTools_TransformationCache_h
+#define Magnum_SceneTools_TransformationCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneTools::TransformationCache, typedef @ref Magnum::SceneTools::TransformationCache2D, @ref Magnum::SceneTools::TransformationCache3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Incrementally updated absolute transformation cache
+@m_since_latest
+
+Calculates absolute transformations of all objects in a
+@ref Trade::SceneData hierarchy similarly to
+@ref absoluteFieldTransformations2D() / @ref absoluteFieldTransformations3D(),
+but keeps the hierarchy in a depth-first order as returned by
+@ref childrenDepthFirst() together with local and absolute transformations of
+all objects. Subsequent changes of local transformations done through
+@ref setLocalTransformation() / @ref setLocalTransformations() only mark
+affected subtrees as dirty and @ref update() then recalculates just those,
+making the per-frame cost proportional to the size of changed subtrees
+instead of the whole scene.
+
+The @ref Trade::SceneField::Parent field is expected to be contained in the
+scene, having no cycles or duplicates, and the scene is expected to be 2D or 3D
+based on the @p dimensions template parameter. Local transformations of objects
+that don't have any transformation field entry are set to an identity.
+
+The construction is done in an @f$ \mathcal{O}(n) @f$ execution time and
+memory complexity, with @f$ n @f$ being @ref Trade::SceneData::mappingBound().
+The @ref update() is done in an @f$ \mathcal{O}(m \log m + s) @f$ execution
+time, with @f$ m @f$ being the count of objects marked as dirty since the last
+update and @f$ s @f$ the total size of their subtrees.
+
+@experimental
+
+@see @ref TransformationCache2D, @ref TransformationCache3D
+*/
+template<UnsignedInt dimensions> class TransformationCache {
+    public:
+        /**
+         * @brief Construct from a scene
+         * @param scene                 Input scene
+         * @param globalTransformation  Global transformation to prepend
+         *
+         * Calculates absolute transformations of all objects in @p scene. The
+         * @p scene isn't referenced after the constructor exits.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        explicit TransformationCache(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation = {});
+        #else
+        /* To avoid including Matrix3 / Matrix4 */
+        explicit TransformationCache(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation);
+        explicit TransformationCache(const Trade::SceneData& scene);
+        #endif
+
+        /** @brief Copying is not allowed */
+        TransformationCache(const TransformationCache<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        TransformationCache(TransformationCache<dimensions>&&) noexcept;
+
+        ~TransformationCache();
+
+        /** @brief Copying is not allowed */
+        TransformationCache<dimensions>& operator=(const TransformationCache<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        TransformationCache<dimensions>& operator=(TransformationCache<dimensions>&&) noexcept;
+
+        /**
+         * @brief Object count
+         *
+         * Equal to @ref Trade::SceneData::mappingBound() of the scene the
+         * cache was created from.
+         */
+        std::size_t objectCount() const;
+
+        /**
+         * @brief Object hierarchy in a depth-first order
+         *
+         * Same as what @ref childrenDepthFirst() returned for the scene the
+         * cache was created from.
+         */
+        Containers::StridedArrayView1D<const Containers::Pair<UnsignedInt, UnsignedInt>> childrenDepthFirst() const;
+
+        /** @brief Global transformation */
+        MatrixTypeFor<dimensions, Float> globalTransformation() const;
+
+        /**
+         * @brief Set global transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the whole hierarchy as dirty.
+         */
+        TransformationCache<dimensions>& setGlobalTransformation(const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Local transformations
+         *
+         * Indexed by object ID, size is equal to @ref objectCount().
+         */
+        Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> localTransformations() const;
+
+        /**
+         * @brief Set a local transformation of an object
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p object is less than @ref objectCount(). If the
+         * object is a part of the hierarchy, it's marked as dirty together
+         * with all its children. Call @ref update() to recalculate the
+         * absolute transformations.
+         */
+        TransformationCache<dimensions>& setLocalTransformation(UnsignedInt object, const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Set local transformations of multiple objects
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setLocalTransformation() for each pair
+         * of items in @p objects and @p transformations. Expects that both
+         * views have the same size.
+         */
+        TransformationCache<dimensions>& setLocalTransformations(const Containers::StridedArrayView1D<const UnsignedInt>& objects, const Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>>& transformations);
+
+        /**
+         * @brief Whether there are any dirty objects
+         *
+         * Returns @cpp true @ce if a local transformation of an object in
+         * the hierarchy or the global transformation was changed since the
+         * last @ref update(), @cpp false @ce otherwise.
+         */
+        bool isDirty() const;
+
+        /**
+         * @brief Recalculate absolute transformations of dirty subtrees
+         * @return Count of objects for which the absolute transformation was
+         *      recalculated
+         *
+         * Subtrees that are nested in another dirty subtree are processed
+         * just once. If nothing is dirty, the function is a no-op.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Absolute transformations
+         *
+         * Indexed by object ID, size is equal to @ref objectCount().
+         * Transformations of objects that are marked as dirty are not
+         * up-to-date until @ref update() is called. Transformations of
+         * objects that are not a part of the hierarchy are set to their local
+         * transformation.
+         */
+        Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> absoluteTransformations() const;
+
+        /**
+         * @brief Absolute transformations for given field
+         *
+         * Similar to @ref absoluteFieldTransformations2DInto() /
+         * @ref absoluteFieldTransformations3DInto() but takes the absolute
+         * transformations from the cache, without recalculating them. The
+         * @p scene is expected to have the same @ref Trade::SceneData::mappingBound()
+         * as the scene the cache was created from, @p fieldId is expected to
+         * be less than @ref Trade::SceneData::fieldCount() and the
+         * @p transformations view is expected to have the same size as the
+         * field. If the cache is dirty, call @ref update() first.
+         */
+        void absoluteFieldTransformationsInto(const Trade::SceneData& scene, UnsignedInt fieldId, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& transformations) const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Incrementally updated 2D absolute transformation cache
+@m_since_latest
+
+@experimental
+*/
+typedef TransformationCache<2> TransformationCache2D;
+
+/**
+@brief Incrementally updated 3D absolute transformation cache
+@m_since_latest
+
+@experimental
+*/
+typedef TransformationCache<3> TransformationCache3D;
+
+}}
+
+#endif
@@ -38,6 +38,9 @@
 #include "Magnum/MeshTools/Copy.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/BatchMeshes.h"
+#include "Magnum/SceneTools/Copy.h"
+#include "Magnum/SceneTools/Deduplicate.h"
 #include "Magnum/SceneTools/Hierarchy.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData.h"
@@ -183,14 +186,16 @@ magnum-sceneconverter [-h|--help] [-I|--importer PLUGIN]
     [--prefer alias:plugin1,plugin2,…]... [--set plugin:key=val,key2=val2,…]...
     [--map] [--only-mesh-attributes N1,N2-N3…] [--remove-duplicate-vertices]
     [--remove-duplicate-vertices-fuzzy EPSILON] [--phong-to-pbr]
+    [--deduplicate]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]...
     [-p|--image-converter-options key=val,key2=val2,…]...
     [-m|--mesh-converter-options key=val,key2=val2,…]...
     [--passthrough-on-image-converter-failure]
     [--passthrough-on-mesh-converter-failure]
-    [--mesh ID] [--mesh-level INDEX] [--concatenate-meshes] [--info-importer]
-    [--info-converter] [--info-image-converter] [--info-animations]
+    [--mesh ID] [--mesh-level INDEX] [--concatenate-meshes] [--batch-meshes]
+    [--info-importer] [--info-converter] [--info-image-converter]
+    [--info-animations]
     [--info-images] [--info-lights] [--info-cameras] [--info-materials]
     [--info-meshes] [--info-objects] [--info-scenes] [--info-skins]
     [--info-textures] [--info] [--color on|4bit|off|auto] [--bounds]
@@ -226,6 +231,9 @@ Arguments:
     in all meshes after import
 -   `--phong-to-pbr` --- convert Phong materials to PBR metallic/roughness
     using @ref MaterialTools::phongToPbrMetallicRoughness()
+-   `--deduplicate` --- remove content-identical meshes and materials using
+    @ref SceneTools::deduplicateMeshes() and
+    @ref SceneTools::deduplicateMaterials(), updating scene references
 -   `-i`, `--importer-options key=val,key2=val2,…` --- configuration options to
     pass to the importer
 -   `-c`, `--converter-options key=val,key2=val2,…` --- configuration options
@@ -242,6 +250,9 @@ Arguments:
 -   `--mesh-level LEVEL` --- level to select for single-mesh conversion
 -   `--concatenate-meshes` --- flatten mesh hierarchy and concatenate them all
     together @m_class{m-label m-warning} **experimental**
+-   `--batch-meshes` --- flatten mesh hierarchy and concatenate meshes sharing
+    the same material and vertex layout together
+    @m_class{m-label m-warning} **experimental**
 -   `--info-importer` --- print info about the importer plugin and exit
 -   `--info-converter` --- print info about the scene or mesh converter plugin
     and exit
@@ -317,6 +328,22 @@ the scene hierarchy transformation baked in using
 remaining operations. Only attributes that are present in the first mesh are
 taken, if `--only-mesh-attributes` is specified as well, the IDs reference
 attributes of the first mesh.
+
+If `--batch-meshes` is given, mesh instances in the default scene (or the
+first scene, if there's no default) are grouped by their material and vertex
+layout using @ref SceneTools::batchMeshes3D(), with the scene hierarchy
+transformation baked in. The output then contains just the batched meshes and
+a single scene referencing them together with the original materials,
+textures, images, lights and cameras. Other scenes, skins and animations are
+not converted, as the original objects they reference are no longer present.
+If the scene has no mesh instances, the utility exits with an error instead of
+producing an output without any meshes.
+
+If `--deduplicate` is given, all meshes and materials are imported upfront,
+only the first of each set of content-identical meshes and materials is kept
+and mesh and material references in all scenes are updated using
+@ref SceneTools::remapMeshesMaterialsInPlace(). The deduplication happens
+before the `--remove-duplicate-vertices` and `--phong-to-pbr` operations.
 */
 
 }
@@ -430,6 +457,7 @@ int main(int argc, char** argv) {
         .addBooleanOption("remove-duplicate-vertices").setHelp("remove-duplicate-vertices", "remove duplicate vertices in all meshes after import")
         .addOption("remove-duplicate-vertices-fuzzy").setHelp("remove-duplicate-vertices-fuzzy", "remove duplicate vertices with fuzzy comparison in all meshes after import", "EPSILON")
         .addBooleanOption("phong-to-pbr").setHelp("phong-to-pbr", "convert Phong materials to PBR metallic/roughness")
+        .addBooleanOption("deduplicate").setHelp("deduplicate", "remove content-identical meshes and materials, updating scene references")
         .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
         .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
         .addArrayOption('p', "image-converter-options").setHelp("image-converter-options", "configuration options to pass to the image converter(s)", "key=val,key2=val2,…")
@@ -439,6 +467,7 @@ int main(int argc, char** argv) {
         .addOption("mesh").setHelp("mesh", "convert just a single mesh instead of the whole scene, ignored if --concatenate-meshes is specified", "ID")
         .addOption("mesh-level").setHelp("mesh-level", "level to select for single-mesh conversion", "index")
         .addBooleanOption("concatenate-meshes").setHelp("concatenate-meshes", "flatten mesh hierarchy and concatenate them all together")
+        .addBooleanOption("batch-meshes").setHelp("batch-meshes", "flatten mesh hierarchy and concatenate meshes sharing the same material and vertex layout together")
         .addBooleanOption("info-importer").setHelp("info-importer", "print info about the importer plugin and exit")
         .addBooleanOption("info-converter").setHelp("info-converter", "print info about the scene or mesh converter plugin and exit")
         .addBooleanOption("info-image-converter").setHelp("info-image-converter", "print info about the image converter plugin and exit")
@@ -515,7 +544,16 @@ If --concatenate-meshes is given, all meshes of the input file are first
 concatenated into a single mesh, with the scene hierarchy transformation baked
 in, and then passed through the remaining operations. Only attributes that are
 present in the first mesh are taken, if --only-mesh-attributes is specified as
-well, the IDs reference attributes of the first mesh.)")
+well, the IDs reference attributes of the first mesh.
+
+If --batch-meshes is given, mesh instances in the default scene are grouped by
+their material and vertex layout, with the scene hierarchy transformation baked
+in. The output then contains just the batched meshes and a single scene
+referencing them. Other scenes, skins and animations are not converted.
+
+If --deduplicate is given, only the first of each set of content-identical
+meshes and materials is kept and references in all scenes are updated. This
+happens before the --remove-duplicate-vertices and --phong-to-pbr operations.)")
         .parse(argc, argv);
 
     /* Colored output. Enable only if a TTY. */
@@ -561,6 +599,14 @@ well, the IDs reference attributes of the first mesh.)")
         Error{} << "The --mesh and --concatenate-meshes options are mutually exclusive";
         return 1;
     }
+    if(args.isSet("batch-meshes") && (args.isSet("concatenate-meshes") || args.value<Containers::StringView>("mesh"))) {
+        Error{} << "The --batch-meshes option can't be combined with --mesh or --concatenate-meshes";
+        return 1;
+    }
+    if(args.isSet("deduplicate") && (args.isSet("batch-meshes") || args.isSet("concatenate-meshes") || args.value<Containers::StringView>("mesh"))) {
+        Error{} << "The --deduplicate option can't be combined with --mesh, --concatenate-meshes or --batch-meshes";
+        return 1;
+    }
     if(args.value<Containers::StringView>("mesh-level") && !args.value<Containers::StringView>("mesh")) {
         Error{} << "The --mesh-level option can only be used with --mesh";
         return 1;
@@ -995,20 +1041,181 @@ well, the IDs reference attributes of the first mesh.)")
         }
     }
 
+    /* Batch mesh instances by material and vertex layout, if requested. The
+       batched meshes then replace the meshes from the importer and the
+       batched scene replaces all scenes. */
+    Containers::Optional<Trade::SceneData> batchedScene;
+    Containers::Array<Trade::MeshData> batchedMeshes;
+    Containers::String batchedSceneName;
+    if(args.isSet("batch-meshes")) {
+        if(importer->defaultScene() == -1 && !importer->sceneCount()) {
+            Error{} << "No scenes found in" << args.value("input") << "for mesh batching";
+            return 1;
+        }
+
+        Containers::Array<Trade::MeshData> meshesToBatch;
+        arrayReserve(meshesToBatch, importer->meshCount());
+        /** @todo handle mesh levels here, once any plugin is capable of
+            importing them */
+        for(std::size_t i = 0, iMax = importer->meshCount(); i != iMax; ++i) {
+            Trade::Implementation::Duration d{importConversionTime};
+            Containers::Optional<Trade::MeshData> meshToBatch = importer->mesh(i);
+            if(!meshToBatch) {
+                Error{} << "Cannot import mesh" << i;
+                return 1;
+            }
+
+            arrayAppend(meshesToBatch, *Utility::move(meshToBatch));
+        }
+
+        /** @todo make it possible to choose the scene */
+        const UnsignedInt defaultScene = importer->defaultScene() == -1 ? 0 : importer->defaultScene();
+        Containers::Optional<Trade::SceneData> scene;
+        {
+            Trade::Implementation::Duration d{importConversionTime};
+            if(!(scene = importer->scene(defaultScene))) {
+                Error{} << "Cannot import scene" << defaultScene << "for mesh batching";
+                return 1;
+            }
+        }
+
+        /* Check the preconditions here to not hit asserts in the function */
+        if(!scene->is3D() || !scene->hasField(Trade::SceneField::Parent)) {
+            Error{} << "Scene" << defaultScene << "is not a 3D scene with a hierarchy, can't batch meshes";
+            return 1;
+        }
+
+        /* With no mesh instances the output would have no meshes at all,
+           which is most likely not what the user wanted */
+        const std::size_t instanceCount = scene->hasField(Trade::SceneField::Mesh) ? scene->fieldSize(Trade::SceneField::Mesh) : 0;
+        if(!instanceCount) {
+            Error{} << "Scene" << defaultScene << "has no mesh instances, nothing to batch";
+            return 1;
+        }
+        {
+            Trade::Implementation::Duration d{conversionTime};
+            Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batched = SceneTools::batchMeshes3D(*scene, meshesToBatch);
+            batchedScene = Utility::move(batched.first());
+            batchedMeshes = Utility::move(batched.second());
+        }
+        batchedSceneName = importer->sceneName(defaultScene);
+
+        if(args.isSet("verbose"))
+            Debug{} << "Mesh batching:" << instanceCount << "mesh instances ->" << batchedMeshes.size() << "meshes";
+    }
+
+    /* Remove content-identical meshes and materials, if requested. The
+       unique meshes and materials then replace the ones from the importer,
+       together with their original IDs to propagate names, and all scenes
+       get their references updated. */
+    /** @todo deduplicate also images, needs remapping textures */
+    Containers::Array<Trade::MeshData> deduplicatedMeshes;
+    Containers::Array<UnsignedInt> deduplicatedMeshIds;
+    Containers::Array<Trade::MaterialData> deduplicatedMaterials;
+    Containers::Array<UnsignedInt> deduplicatedMaterialIds;
+    Containers::Array<Trade::SceneData> deduplicatedScenes;
+    if(args.isSet("deduplicate")) {
+        /** @todo handle mesh levels here, once any plugin is capable of
+            importing them */
+        Containers::Array<Trade::MeshData> allMeshes;
+        arrayReserve(allMeshes, importer->meshCount());
+        for(UnsignedInt i = 0; i != importer->meshCount(); ++i) {
+            Trade::Implementation::Duration d{importConversionTime};
+            Containers::Optional<Trade::MeshData> mesh = importer->mesh(i);
+            if(!mesh) {
+                Error{} << "Cannot import mesh" << i;
+                return 1;
+            }
+
+            arrayAppend(allMeshes, *Utility::move(mesh));
+        }
+
+        Containers::Array<Trade::MaterialData> allMaterials;
+        arrayReserve(allMaterials, importer->materialCount());
+        for(UnsignedInt i = 0; i != importer->materialCount(); ++i) {
+            Trade::Implementation::Duration d{importConversionTime};
+            Containers::Optional<Trade::MaterialData> material = importer->material(i);
+            if(!material) {
+                Error{} << "Cannot import material" << i;
+                return 1;
+            }
+
+            arrayAppend(allMaterials, *Utility::move(material));
+        }
+
+        Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> meshMapping;
+        Containers::Pair<Containers::Array<UnsignedInt>, std::size_t> materialMapping;
+        {
+            Trade::Implementation::Duration d{conversionTime};
+            meshMapping = SceneTools::deduplicateMeshes(allMeshes);
+            materialMapping = SceneTools::deduplicateMaterials(allMaterials);
+        }
+
+        /* Unique IDs are assigned in order of first occurrence, so the item
+           is unique if its ID is equal to the count of unique items so far */
+        arrayReserve(deduplicatedMeshes, meshMapping.second());
+        arrayReserve(deduplicatedMeshIds, meshMapping.second());
+        for(UnsignedInt i = 0; i != allMeshes.size(); ++i) {
+            if(meshMapping.first()[i] != deduplicatedMeshes.size()) continue;
+            arrayAppend(deduplicatedMeshes, Utility::move(allMeshes[i]));
+            arrayAppend(deduplicatedMeshIds, i);
+        }
+        arrayReserve(deduplicatedMaterials, materialMapping.second());
+        arrayReserve(deduplicatedMaterialIds, materialMapping.second());
+        for(UnsignedInt i = 0; i != allMaterials.size(); ++i) {
+            if(materialMapping.first()[i] != deduplicatedMaterials.size()) continue;
+            arrayAppend(deduplicatedMaterials, Utility::move(allMaterials[i]));
+            arrayAppend(deduplicatedMaterialIds, i);
+        }
+
+        arrayReserve(deduplicatedScenes, importer->sceneCount());
+        for(UnsignedInt i = 0; i != importer->sceneCount(); ++i) {
+            Containers::Optional<Trade::SceneData> scene;
+            {
+                Trade::Implementation::Duration d{importConversionTime};
+                if(!(scene = importer->scene(i))) {
+                    Error{} << "Cannot import scene" << i;
+                    return 1;
+                }
+            }
+
+            Trade::Implementation::Duration d{conversionTime};
+            /* The imported data may not be mutable, make a copy */
+            Trade::SceneData copy = SceneTools::copy(*Utility::move(scene));
+            SceneTools::remapMeshesMaterialsInPlace(copy, meshMapping.first(), materialMapping.first());
+            arrayAppend(deduplicatedScenes, Utility::move(copy));
+        }
+
+        if(args.isSet("verbose")) {
+            Debug{} << "Deduplication:" << allMeshes.size() << "->" << deduplicatedMeshes.size() << "meshes";
+            Debug{} << "Deduplication:" << allMaterials.size() << "->" << deduplicatedMaterials.size() << "materials";
+        }
+    }
+
     /* Operations to perform on all meshes in the importer. If there are any,
        meshes are supplied manually to the converter from the array below. */
     Containers::Array<Trade::MeshData> meshes;
-    if(args.isSet("remove-duplicate-vertices") ||
+    if(batchedScene ||
+       args.isSet("deduplicate") ||
+       args.isSet("remove-duplicate-vertices") ||
        args.value<Containers::StringView>("remove-duplicate-vertices-fuzzy") ||
        args.arrayValueCount("mesh-converter"))
     {
         const bool passthroughOnConversionFailure = args.isSet("passthrough-on-mesh-converter-failure");
 
-        arrayReserve(meshes, importer->meshCount());
+        const UnsignedInt meshCount =
+            batchedScene ? batchedMeshes.size() :
+            args.isSet("deduplicate") ? deduplicatedMeshes.size() :
+            importer->meshCount();
+        arrayReserve(meshes, meshCount);
 
-        for(UnsignedInt i = 0; i != importer->meshCount(); ++i) {
+        for(UnsignedInt i = 0; i != meshCount; ++i) {
             Containers::Optional<Trade::MeshData> mesh;
-            {
+            if(batchedScene) {
+                mesh = Utility::move(batchedMeshes[i]);
+            } else if(args.isSet("deduplicate")) {
+                mesh = Utility::move(deduplicatedMeshes[i]);
+            } else {
                 /** @todo handle mesh levels here, once any plugin is capable
                     of importing them */
                 Trade::Implementation::Duration d{importConversionTime};
@@ -1097,12 +1304,16 @@ well, the IDs reference attributes of the first mesh.)")
        any, materials are supplied manually to the converter from the array
        below. */
     Containers::Array<Trade::MaterialData> materials;
-    if(args.isSet("phong-to-pbr")) {
-        arrayReserve(materials, importer->materialCount());
+    if(args.isSet("phong-to-pbr") || args.isSet("deduplicate")) {
+        const UnsignedInt materialCount = args.isSet("deduplicate") ?
+            deduplicatedMaterials.size() : importer->materialCount();
+        arrayReserve(materials, materialCount);
 
-        for(UnsignedInt i = 0; i != importer->materialCount(); ++i) {
+        for(UnsignedInt i = 0; i != materialCount; ++i) {
             Containers::Optional<Trade::MaterialData> material;
-            {
+            if(args.isSet("deduplicate")) {
+                material = Utility::move(deduplicatedMaterials[i]);
+            } else {
                 Trade::Implementation::Duration d{importConversionTime};
                 if(!(material = importer->material(i))) {
                     Error{} << "Cannot import material" << i;
@@ -1277,7 +1488,10 @@ well, the IDs reference attributes of the first mesh.)")
                     }
                 }
 
-                if(!converter->add(mesh, contents & Trade::SceneContent::Names ? importer->meshName(j) : Containers::String{})) {
+                /* Batched meshes have no correspondence to the meshes in
+                   the importer, so they don't get any names. Deduplicated
+                   meshes take the name of the first occurrence. */
+                if(!converter->add(mesh, contents & Trade::SceneContent::Names && !batchedScene ? importer->meshName(deduplicatedMeshIds ? deduplicatedMeshIds[j] : j) : Containers::String{})) {
                     Error{} << "Cannot add mesh" << j;
                     return 1;
                 }
@@ -1295,6 +1509,7 @@ well, the IDs reference attributes of the first mesh.)")
                 that each change the output to verify the old meshes don't get
                 reused in the next step again */
             meshes = {};
+            deduplicatedMeshIds = {};
         }
 
         /* If there are any loose materials from previous conversion steps, add
@@ -1329,7 +1544,7 @@ well, the IDs reference attributes of the first mesh.)")
             } else for(UnsignedInt i = 0; i != materials.size(); ++i) {
                 Trade::Implementation::Duration d{conversionTime};
 
-                if(!converter->add(materials[i], contents & Trade::SceneContent::Names ? importer->materialName(i) : Containers::String{})) {
+                if(!converter->add(materials[i], contents & Trade::SceneContent::Names ? importer->materialName(deduplicatedMaterialIds ? deduplicatedMaterialIds[i] : i) : Containers::String{})) {
                     Error{} << "Cannot add material" << i;
                     return 1;
                 }
@@ -1348,6 +1563,88 @@ well, the IDs reference attributes of the first mesh.)")
                 that each change the output to verify the old materials don't
                 get reused in the next step again */
             materials = {};
+            deduplicatedMaterialIds = {};
+        }
+
+        /* If there's a batched scene from the --batch-meshes step, add all
+           its dependencies first, and then the scene itself. Skins and
+           animations reference the original objects so they're dropped. The
+           original meshes are replaced by the batched ones, so they're never
+           added even if the above didn't add any. */
+        if(batchedScene) {
+            {
+                const Trade::SceneContents sceneDependencies = contents &
+                    ~(Trade::SceneContent::Scenes|
+                      Trade::SceneContent::Meshes|
+                      Trade::SceneContent::MeshLevels|
+                      Trade::SceneContent::Animations|
+                      Trade::SceneContent::Skins2D|
+                      Trade::SceneContent::Skins3D);
+
+                Trade::Implementation::Duration d{importConversionTime};
+                if(!converter->addSupportedImporterContents(*importer, sceneDependencies)) {
+                    Error{} << "Cannot add batched scene dependencies";
+                    return 5;
+                }
+            }
+
+            /* Ensure nothing is added by addSupportedImporterContents()
+               again below */
+            contents = {};
+
+            if(!(Trade::sceneContentsFor(*converter) & Trade::SceneContent::Scenes)) {
+                Warning{} << "Ignoring a batched scene not supported by the converter";
+            } else {
+                Trade::Implementation::Duration d{conversionTime};
+                const Containers::Optional<UnsignedInt> id = converter->add(*batchedScene, batchedSceneName);
+                if(!id) {
+                    Error{} << "Cannot add the batched scene";
+                    return 1;
+                }
+                converter->setDefaultScene(*id);
+            }
+
+            /* Delete the scene to avoid adding it again for the next
+               converter, at which point it'd be taken from the importer */
+            batchedScene = Containers::NullOpt;
+        }
+
+        /* If there are scenes with references updated by the --deduplicate
+           step, add all their dependencies first, and then the scenes
+           themselves. Objects stay the same, so skins and animations are
+           added unchanged. */
+        if(deduplicatedScenes) {
+            {
+                const Trade::SceneContents sceneDependencies = contents & ~Trade::SceneContent::Scenes;
+
+                Trade::Implementation::Duration d{importConversionTime};
+                if(!converter->addSupportedImporterContents(*importer, sceneDependencies)) {
+                    Error{} << "Cannot add deduplicated scene dependencies";
+                    return 5;
+                }
+            }
+
+            if(!(Trade::sceneContentsFor(*converter) & Trade::SceneContent::Scenes)) {
+                Warning{} << "Ignoring" << deduplicatedScenes.size() << "scenes not supported by the converter";
+            } else {
+                for(UnsignedInt j = 0; j != deduplicatedScenes.size(); ++j) {
+                    Trade::Implementation::Duration d{conversionTime};
+                    if(!converter->add(deduplicatedScenes[j], contents & Trade::SceneContent::Names ? importer->sceneName(j) : Containers::String{})) {
+                        Error{} << "Cannot add scene" << j;
+                        return 1;
+                    }
+                }
+                if(importer->defaultScene() != -1)
+                    converter->setDefaultScene(importer->defaultScene());
+            }
+
+            /* Ensure nothing is added by addSupportedImporterContents()
+               again below */
+            contents = {};
+
+            /* Delete the list to avoid adding them again for the next
+               converter, at which point they'd be taken from the importer */
+            deduplicatedScenes = {};
         }
 
         {
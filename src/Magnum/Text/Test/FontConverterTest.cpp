@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringIterable.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/Text/AbstractFontConverter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct FontConverterTest: TestSuite::Tester {
+    explicit FontConverterTest();
+
+    void cpu();
+    void cpuMatchesGpu();
+};
+
+using namespace Containers::Literals;
+
+FontConverterTest::FontConverterTest() {
+    addTests({&FontConverterTest::cpu,
+              &FontConverterTest::cpuMatchesGpu});
+
+    /* Create output dir, if doesn't already exist */
+    Utility::Path::make(Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles"));
+}
+
+#ifdef FONTCONVERTER_EXECUTABLE_FILENAME
+Containers::Pair<bool, Containers::String> call(const Containers::StringIterable& arguments) {
+    const Containers::String outputFilename = Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles/output.txt");
+    /** @todo clean up once Utility::System::execute() with output redirection
+        exists */
+    /* Implicitly pass the plugin directory override and the test font, the
+       input is the same as in DistanceFieldGLTest, split into four glyphs
+       by the font. The ratio between the atlas and output size is the same
+       as in DistanceFieldGLTest as well. */
+    const bool success = std::system(Utility::format("{} --plugin-dir {} --font {} --converter MagnumFontConverter --characters abcd --atlas-size \"512 512\" --output-size \"128 128\" --radius 32 {} {} > {} 2>&1",
+        FONTCONVERTER_EXECUTABLE_FILENAME,
+        MAGNUM_PLUGINS_INSTALL_DIR,
+        TILEFONT_PLUGIN_FILENAME,
+        " "_s.join(arguments), /** @todo handle space escaping here? */
+        Utility::Path::join(TEXTURETOOLS_DISTANCEFIELDGLTEST_DIR, "input.tga"),
+        outputFilename
+    ).data()) == 0;
+
+    const Containers::Optional<Containers::String> output = Utility::Path::readString(outputFilename);
+    CORRADE_VERIFY(output);
+
+    return {success, Utility::move(*output)};
+}
+
+bool checkPlugins() {
+    PluginManager::Manager<Trade::AbstractImageConverter> imageConverterManager{MAGNUM_PLUGINS_IMAGECONVERTER_INSTALL_DIR};
+    PluginManager::Manager<AbstractFontConverter> converterManager{MAGNUM_PLUGINS_FONTCONVERTER_INSTALL_DIR};
+    converterManager.registerExternalManager(imageConverterManager);
+    return converterManager.load("MagnumFontConverter") & PluginManager::LoadState::Loaded;
+}
+#endif
+
+void FontConverterTest::cpu() {
+    #ifndef FONTCONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-fontconverter not built, can't test");
+    #else
+    if(!checkPlugins())
+        CORRADE_SKIP("MagnumFontConverter plugin can't be loaded.");
+
+    const Containers::String serial = Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles/cpu-serial");
+    const Containers::String parallel = Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles/cpu-parallel");
+
+    /* With one thread all glyphs are rasterized by a single font instance,
+       with four each glyph is rasterized by a different one */
+    {
+        Containers::Pair<bool, Containers::String> output = call({"--cpu", "--threads", "1", serial});
+        CORRADE_VERIFY(output.first());
+        CORRADE_COMPARE_AS(output.second(), "Rasterizing 4 characters in 1 threads...",
+            TestSuite::Compare::StringContains);
+    } {
+        Containers::Pair<bool, Containers::String> output = call({"--cpu", "--threads", "4", parallel});
+        CORRADE_VERIFY(output.first());
+        CORRADE_COMPARE_AS(output.second(), "Rasterizing 4 characters in 4 threads...",
+            TestSuite::Compare::StringContains);
+    }
+
+    /* The output should be the same regardless of the thread count */
+    CORRADE_COMPARE_AS(parallel + ".conf"_s, serial + ".conf"_s,
+        TestSuite::Compare::File);
+    CORRADE_COMPARE_AS(parallel + ".tga"_s, serial + ".tga"_s,
+        TestSuite::Compare::File);
+    #endif
+}
+
+void FontConverterTest::cpuMatchesGpu() {
+    #ifndef FONTCONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-fontconverter not built, can't test");
+    #elif !defined(FONTCONVERTER_GPU_TESTS)
+    CORRADE_SKIP("GL tests not enabled, can't test");
+    #else
+    if(!checkPlugins())
+        CORRADE_SKIP("MagnumFontConverter plugin can't be loaded.");
+
+    PluginManager::Manager<Trade::AbstractImporter> importerManager{MAGNUM_PLUGINS_IMPORTER_INSTALL_DIR};
+    if(!(importerManager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(importerManager.load("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins can't be loaded.");
+
+    const Containers::String cpu = Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles/cpu");
+    const Containers::String gpu = Utility::Path::join(TEXT_TEST_OUTPUT_DIR, "FontConverterTestFiles/gpu");
+
+    {
+        Containers::Pair<bool, Containers::String> output = call({"--cpu", "--threads", "4", cpu});
+        CORRADE_VERIFY(output.first());
+    } {
+        Containers::Pair<bool, Containers::String> output = call({gpu});
+        CORRADE_VERIFY(output.first());
+    }
+
+    /* The glyphs should be placed the same in both and the config file
+       referencing the image is named the same in both */
+    const Containers::Optional<Containers::String> cpuConf = Utility::Path::readString(cpu + ".conf"_s);
+    const Containers::Optional<Containers::String> gpuConf = Utility::Path::readString(gpu + ".conf"_s);
+    CORRADE_VERIFY(cpuConf);
+    CORRADE_VERIFY(gpuConf);
+    CORRADE_COMPARE(*cpuConf, Utility::String::replaceAll(*gpuConf, "gpu.tga", "cpu.tga"));
+
+    /* Same thresholds as in DistanceFieldGLTest, which compares the GPU
+       output with the CPU-calculated ground truth */
+    CORRADE_COMPARE_WITH(cpu + ".tga"_s, gpu + ".tga"_s,
+        (DebugTools::CompareImageFile{importerManager, 1.0f, 0.178f}));
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::FontConverterTest)
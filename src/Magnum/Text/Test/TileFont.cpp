@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/AbstractManager.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/TextureTools/Atlas.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+/* Font used by FontConverterTest to test magnum-fontconverter without
+   depending on an external font plugin. It opens an uncompressed grayscale
+   TGA and exposes its 2x2 tiles as glyphs for characters a, b, c and d,
+   glyph 0 is the invalid glyph. */
+class TileFont: public AbstractFont {
+    public:
+        explicit TileFont(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractFont{manager, plugin} {}
+
+    private:
+        FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+
+        bool doIsOpened() const override { return !_pixels.isEmpty(); }
+
+        Properties doOpenData(const Containers::ArrayView<const char> data, const Float size) override {
+            /* Just the bare minimum, an 18-byte header followed by an
+               optional image ID and 8-bit grayscale pixels */
+            if(data.size() < 18 || data[2] != 3 || data[16] != 8) {
+                Error{} << "TileFont::openData(): expected an uncompressed 8-bit grayscale TGA";
+                return {};
+            }
+            Vector2i imageSize;
+            for(std::size_t i: {0, 1}) {
+                UnsignedShort value;
+                Utility::copy(data.sliceSize(12 + i*2, 2), Containers::arrayView(reinterpret_cast<char*>(&value), 2));
+                imageSize[i] = Utility::Endianness::littleEndian(value);
+            }
+            const std::size_t offset = 18 + UnsignedByte(data[0]);
+            if(imageSize.isZero() || data.size() < offset + imageSize.product()) {
+                Error{} << "TileFont::openData(): file too short";
+                return {};
+            }
+
+            _imageSize = imageSize;
+            _pixels = Containers::Array<char>{NoInit, std::size_t(imageSize.product())};
+            Utility::copy(data.sliceSize(offset, _pixels.size()), _pixels);
+            return {size, size, 0.0f, size, 5};
+        }
+
+        void doClose() override {
+            _pixels = nullptr;
+        }
+
+        UnsignedInt doGlyphId(const char32_t character) override {
+            return character >= U'a' && character <= U'd' ? character - U'a' + 1 : 0;
+        }
+
+        Vector2 doGlyphSize(UnsignedInt) override {
+            return Vector2{_imageSize/2};
+        }
+
+        Vector2 doGlyphAdvance(UnsignedInt) override {
+            return {Float(_imageSize.x()/2), 0.0f};
+        }
+
+        void doFillGlyphCache(AbstractGlyphCache& cache, const Containers::ArrayView<const char32_t> characters) override {
+            /* Collect unique glyphs for given characters */
+            bool used[5]{};
+            for(const char32_t character: characters)
+                used[doGlyphId(character)] = true;
+            Containers::Array<UnsignedInt> glyphs;
+            for(UnsignedInt i = 1; i != 5; ++i)
+                if(used[i]) arrayAppend(glyphs, i);
+
+            /* Pack them into the atlas, all have the same size */
+            const Vector2i tileSize = _imageSize/2;
+            Containers::Array<Vector2i> sizes{DirectInit, glyphs.size(), tileSize};
+            Containers::Array<Vector2i> offsets{NoInit, glyphs.size()};
+            cache.atlas().clearFlags(
+                TextureTools::AtlasLandfillFlag::RotatePortrait|
+                TextureTools::AtlasLandfillFlag::RotateLandscape);
+            CORRADE_INTERNAL_ASSERT_OUTPUT(cache.atlas().add(sizes, offsets));
+
+            /* Copy the tiles. The input is bottom-up same as the cache. */
+            const UnsignedInt fontId = cache.addFont(glyphCount(), this);
+            const Containers::StridedArrayView2D<const char> src{_pixels, {std::size_t(_imageSize.y()), std::size_t(_imageSize.x())}};
+            const Containers::StridedArrayView2D<char> dst = cache.image().pixels<char>()[0];
+            for(std::size_t i = 0; i != glyphs.size(); ++i) {
+                const Vector2i tileOffset = tileSize*Vector2i{Int((glyphs[i] - 1) % 2), Int((glyphs[i] - 1)/2)};
+                cache.addGlyph(fontId, glyphs[i], {}, Range2Di::fromSize(offsets[i], tileSize));
+                Utility::copy(
+                    src.sliceSize({std::size_t(tileOffset.y()), std::size_t(tileOffset.x())}, {std::size_t(tileSize.y()), std::size_t(tileSize.x())}),
+                    dst.sliceSize({std::size_t(offsets[i].y()), std::size_t(offsets[i].x())}, {std::size_t(tileSize.y()), std::size_t(tileSize.x())}));
+            }
+
+            /* Process the whole image so the glyphs are surrounded by zeros
+               in all cases */
+            cache.flushImage(Range2Di{{}, cache.size().xy()});
+        }
+
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, Containers::StringView) override {
+            return {};
+        }
+
+        Vector2i _imageSize;
+        Containers::Array<char> _pixels;
+};
+
+}}}}
+
+CORRADE_PLUGIN_REGISTER(TileFont, Magnum::Text::Test::TileFont,
+    MAGNUM_TEXT_ABSTRACTFONT_PLUGIN_INTERFACE)
@@ -23,16 +23,32 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <string>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Unicode.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/ConfigurationValue.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractFontConverter.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/TextureTools/Atlas.h"
+#include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #ifdef MAGNUM_TARGET_EGL
@@ -92,13 +108,35 @@ documentation, this will generate files `myfont.conf` and `myfont.tga` in
 current directory. You can then load and use them via the
 @ref Text::MagnumFont "MagnumFont" plugin.
 
+@subsection magnum-fontconverter-example-cpu Offline processing on the CPU
+
+By default, the glyphs are rasterized into a single glyph cache and the
+distance field is then calculated on the GPU using
+@ref TextureTools::DistanceField, which needs a GL context. With `--cpu`, the
+glyph set is split into batches that get rasterized on multiple threads, each
+glyph is then converted to a distance field independently using the CPU
+@ref TextureTools::distanceField() and the results are packed into the output
+atlas using @ref TextureTools::AtlasLandfill. No GL context is created in that
+case, making it possible to bake fonts on headless build machines:
+
+@code{.sh}
+magnum-fontconverter DejaVuSans.ttf myfont \
+    --font FreeTypeFont --converter MagnumFontConverter --cpu
+@endcode
+
+For the output to match the GPU implementation, `--atlas-size` has to be a
+multiple of `--output-size`. Each thread rasterizes with its own instance of
+the font plugin, which assumes the plugin instances can be used independently
+from each other. If that's not the case for a particular plugin, pass
+`--threads 1`.
+
 @section magnum-fontconverter-usage Full usage documentation
 
 @code{.sh}
 magnum-fontconverter [--magnum-...] [-h|--help] --font FONT
     --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS]
     [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N]
-    [--] input output
+    [--cpu] [--threads N] [--] input output
 @endcode
 
 Arguments:
@@ -116,6 +154,11 @@ Arguments:
 -   `--output-size "X Y"` --- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` --- distance field computation radius (default: `24`)
+-   `--cpu` --- rasterize and calculate the distance field on the CPU without
+    creating a GL context. See @ref magnum-fontconverter-example-cpu for more
+    information.
+-   `--threads N` --- number of threads to use with `--cpu`. If set to `0`,
+    @ref std::thread::hardware_concurrency() is used. (default: `0`)
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-usage-command-line for details)
 
@@ -125,6 +168,48 @@ The resulting font files can be then used as specified in the documentation of
 
 namespace Text {
 
+namespace {
+
+/* Glyph cache that only keeps the rasterized glyphs in the CPU-side image,
+   used for rasterization in the --cpu mode */
+class CpuGlyphCache: public AbstractGlyphCache {
+    public:
+        explicit CpuGlyphCache(const Vector2i& size, const Vector2i& padding = {}): AbstractGlyphCache{PixelFormat::R8Unorm, size, padding} {}
+
+    private:
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+/* Glyph cache with the distance field image calculated externally, passed to
+   the font converter in the --cpu mode. Similarly to DistanceFieldGlyphCache
+   the glyph positions are in the input atlas coordinates while the processed
+   image has the output size. */
+class CpuDistanceFieldGlyphCache: public AbstractGlyphCache {
+    public:
+        explicit CpuDistanceFieldGlyphCache(const Vector2i& size, const Vector2i& processedSize, UnsignedInt radius): AbstractGlyphCache{PixelFormat::R8Unorm, size, Vector2i(radius)}, _processedSize{processedSize}, _processedData{ValueInit, std::size_t(processedSize.product())} {}
+
+        MutableImageView2D processedImageView() {
+            return MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, _processedSize, _processedData};
+        }
+
+    private:
+        GlyphCacheFeatures doFeatures() const override {
+            return GlyphCacheFeature::ImageProcessing|GlyphCacheFeature::ProcessedImageDownload;
+        }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        Image3D doProcessedImage() override {
+            Containers::Array<char> data{NoInit, _processedData.size()};
+            Utility::copy(_processedData, data);
+            return Image3D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {_processedSize, 1}, std::move(data)};
+        }
+
+        Vector2i _processedSize;
+        Containers::Array<char> _processedData;
+};
+
+}
+
 class FontConverter: public Platform::WindowlessApplication {
     public:
         explicit FontConverter(const Arguments& arguments);
@@ -132,6 +217,8 @@ class FontConverter: public Platform::WindowlessApplication {
         int exec() override;
 
     private:
+        int execCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFont& font, AbstractFontConverter& converter);
+
         Utility::Arguments args;
 };
 
@@ -150,11 +237,14 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "rasterize and calculate the distance field on the CPU without creating a GL context")
+        .addOption("threads", "0").setHelp("threads", "number of threads to use with --cpu, 0 for all available", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    /* The CPU path doesn't need any GL context */
+    if(!args.isSet("cpu")) createContext();
 }
 
 int FontConverter::exec() {
@@ -196,6 +286,10 @@ int FontConverter::exec() {
         return 3;
     }
 
+    /* Offline processing on the CPU */
+    if(args.isSet("cpu"))
+        return execCpu(fontManager, *font, *converter);
+
     /* Create distance field glyph cache if radius is specified */
     Containers::Pointer<GlyphCache> cache;
     if(!args.value<Vector2i>("output-size").isZero()) {
@@ -229,6 +323,177 @@ int FontConverter::exec() {
     return 0;
 }
 
+int FontConverter::execCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFont& font, AbstractFontConverter& converter) {
+    const Vector2i atlasSize = args.value<Vector2i>("atlas-size");
+    const Vector2i outputSize = args.value<Vector2i>("output-size");
+    const UnsignedInt radius = args.value<UnsignedInt>("radius");
+    const std::string characters = args.value("characters");
+
+    /* Without a distance field there's nothing to parallelize, rasterize
+       everything into a single cache */
+    if(outputSize.isZero()) {
+        Debug() << "Zero-size distance field output specified, populating normal glyph cache...";
+
+        CpuGlyphCache cache{atlasSize};
+        font.fillGlyphCache(cache, characters);
+
+        Debug() << "Converting font...";
+
+        if(!converter.exportFontToFile(font, cache, args.value("output"), characters)) {
+            Error() << "Cannot export font to" << args.value("output");
+            return 1;
+        }
+
+        Debug() << "Done.";
+
+        return 0;
+    }
+
+    /* Each output pixel has to correspond to a whole block of input pixels,
+       otherwise the per-glyph results wouldn't be equivalent to processing the
+       whole atlas at once */
+    if(!outputSize.product() || (atlasSize/outputSize)*outputSize != atlasSize) {
+        Error() << "Atlas size" << atlasSize << "is not a multiple of output size" << outputSize;
+        return 4;
+    }
+    const Vector2i ratio = atlasSize/outputSize;
+
+    /* Unique the character set so each batch gets distinct characters */
+    Containers::Optional<Containers::Array<char32_t>> utf32 = Utility::Unicode::utf32(characters);
+    if(!utf32) {
+        Error() << "Characters are not a valid UTF-8 string";
+        return 4;
+    }
+    std::sort(utf32->begin(), utf32->end());
+    const std::size_t characterCount = std::unique(utf32->begin(), utf32->end()) - utf32->begin();
+
+    const std::size_t threadCount = Math::max(Math::min(Magnum::Implementation::threadCount(args.value<UnsignedInt>("threads")), characterCount), std::size_t{1});
+
+    /* Split the characters into batches, each rasterized by a dedicated font
+       instance into a dedicated cache. The first batch uses the already
+       opened font, the others open the same file again. Opening is done
+       serially, as plugins may not expect that to happen from multiple
+       threads at once. */
+    Containers::Array<Containers::Pointer<AbstractFont>> extraFonts{ValueInit, threadCount - 1};
+    Containers::Array<AbstractFont*> fonts{NoInit, threadCount};
+    Containers::Array<Containers::Pointer<CpuGlyphCache>> caches{ValueInit, threadCount};
+    Containers::Array<std::string> batches{ValueInit, threadCount};
+    for(std::size_t i = 0; i != threadCount; ++i) {
+        if(i == 0) fonts[i] = &font;
+        else {
+            extraFonts[i - 1] = fontManager.instantiate(args.value("font"));
+            if(!extraFonts[i - 1]->openFile(args.value("input"), args.value<Float>("font-size"))) {
+                Error() << "Cannot open font" << args.value("input");
+                return 3;
+            }
+            fonts[i] = extraFonts[i - 1].get();
+        }
+
+        caches[i].emplace(atlasSize, Vector2i(radius));
+
+        for(std::size_t j = i*characterCount/threadCount, jEnd = (i + 1)*characterCount/threadCount; j != jEnd; ++j) {
+            char utf8[4];
+            batches[i].append(utf8, Utility::Unicode::utf8((*utf32)[j], utf8));
+        }
+    }
+
+    Debug() << "Rasterizing" << characterCount << "characters in" << threadCount << "threads...";
+
+    Magnum::Implementation::parallelFor(threadCount, threadCount, [&](const std::size_t i) {
+        fonts[i]->fillGlyphCache(*caches[i], batches[i]);
+    });
+
+    /* Gather the rasterized glyphs. Different characters can map to the same
+       glyph, so a glyph may be present in more than one batch. */
+    struct Glyph {
+        UnsignedInt fontGlyphId;
+        UnsignedInt batch;
+        Vector2i offset;
+        Range2Di rectangle;
+        Vector2i outputSize;
+        Vector2i outputOffset;
+    };
+    Containers::Array<Glyph> glyphs;
+    Containers::BitArray seen{ValueInit, font.glyphCount()};
+    for(std::size_t i = 0; i != threadCount; ++i) {
+        /* The font is the only one in the cache */
+        for(UnsignedInt fontGlyphId = 0; fontGlyphId != caches[i]->fontGlyphCount(0); ++fontGlyphId) {
+            if(seen[fontGlyphId] || !caches[i]->glyphId(0, fontGlyphId))
+                continue;
+            seen.set(fontGlyphId);
+
+            const Containers::Triple<Vector2i, Int, Range2Di> glyph = caches[i]->glyph(0, fontGlyphId);
+            arrayAppend(glyphs, Glyph{fontGlyphId, UnsignedInt(i),
+                glyph.first(), glyph.third(),
+                /* Round up to whole output pixels */
+                (glyph.third().size() + ratio - Vector2i{1})/ratio,
+                Vector2i{}});
+        }
+    }
+
+    Debug() << "Packing" << glyphs.size() << "glyphs into a" << outputSize << "distance field atlas...";
+
+    TextureTools::AtlasLandfill atlas{outputSize};
+    atlas.clearFlags(TextureTools::AtlasLandfillFlag::RotatePortrait|TextureTools::AtlasLandfillFlag::RotateLandscape);
+    if(!atlas.add(
+        stridedArrayView(glyphs).slice(&Glyph::outputSize),
+        stridedArrayView(glyphs).slice(&Glyph::outputOffset)))
+    {
+        Error() << "Cannot fit" << glyphs.size() << "glyphs into a distance field atlas of size" << outputSize;
+        return 4;
+    }
+
+    Debug() << "Calculating distance field in" << Math::min(threadCount, glyphs.size()) << "threads...";
+
+    CpuDistanceFieldGlyphCache cache{atlasSize, outputSize, radius};
+    {
+        const MutableImageView2D output = cache.processedImageView();
+        Magnum::Implementation::parallelFor(glyphs.size(), threadCount, [&](const std::size_t i) {
+            const Glyph& glyph = glyphs[i];
+            const Vector2i glyphSize = glyph.rectangle.size();
+
+            /* Copy the glyph into a zero-filled image with the size being
+               a multiple of the output size, so the input pixels map to
+               the output pixels the same way as with the whole atlas */
+            Containers::Array<char> inputData{ValueInit, std::size_t((glyph.outputSize*ratio).product())};
+            const MutableImageView2D input{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, glyph.outputSize*ratio, inputData};
+            Utility::copy(
+                static_cast<const AbstractGlyphCache&>(*caches[glyph.batch]).image().pixels<UnsignedByte>()[0].sliceSize(
+                    {std::size_t(glyph.rectangle.min().y()), std::size_t(glyph.rectangle.min().x())},
+                    {std::size_t(glyphSize.y()), std::size_t(glyphSize.x())}),
+                input.pixels<UnsignedByte>().sliceSize({},
+                    {std::size_t(glyphSize.y()), std::size_t(glyphSize.x())}));
+
+            /* Each glyph writes to a distinct part of the output */
+            TextureTools::distanceField(input, MutableImageView2D{
+                PixelStorage{}
+                    .setAlignment(1)
+                    .setRowLength(outputSize.x())
+                    .setSkip({glyph.outputOffset, 0}),
+                PixelFormat::R8Unorm, glyph.outputSize, output.data()}, radius);
+        });
+    }
+
+    /* Add the glyphs with rectangles in the input atlas space, like they'd be
+       in a DistanceFieldGlyphCache. The offset and rectangle queried from the
+       rasterization caches have the padding applied, while addGlyph() expects
+       them without, so undo it. Both caches have the same padding. */
+    const UnsignedInt fontId = cache.addFont(font.glyphCount(), &font);
+    for(const Glyph& glyph: glyphs)
+        cache.addGlyph(fontId, glyph.fontGlyphId, glyph.offset + cache.padding(), Range2Di::fromSize(glyph.outputOffset*ratio, glyph.rectangle.size()).padded(-cache.padding()));
+
+    Debug() << "Converting font...";
+
+    if(!converter.exportFontToFile(font, cache, args.value("output"), characters)) {
+        Error() << "Cannot export font to" << args.value("output");
+        return 1;
+    }
+
+    Debug() << "Done.";
+
+    return 0;
+}
+
 }
 
 }
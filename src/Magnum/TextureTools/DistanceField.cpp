@@ -25,6 +25,15 @@
 
 #include "DistanceField.h"
 
+#include <cmath>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector2.h"
+
+#ifdef MAGNUM_TARGET_GL
 #include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Utility/Format.h>
@@ -45,9 +54,106 @@ static void importTextureToolResources() {
     CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RESOURCES)
 }
 #endif
+#endif
 
 namespace Magnum { namespace TextureTools {
 
+namespace {
+
+/* A CPU port of DistanceFieldShader.frag, see it for a detailed description
+   of the search pattern. Keep the two in sync so both produce the same
+   output. */
+
+inline bool hasValue(const Containers::StridedArrayView2D<const UnsignedByte>& input, const Vector2i& position) {
+    /* Out-of-bounds pixels are treated as black */
+    return position.x() >= 0 && position.y() >= 0 &&
+        std::size_t(position.x()) < input.size()[1] &&
+        std::size_t(position.y()) < input.size()[0] &&
+        input[position.y()][position.x()] > 127;
+}
+
+Int findMinDistanceSquared(const Containers::StridedArrayView2D<const UnsignedByte>& input, const Vector2i& position, const bool isInside, const Int radius) {
+    /* Initialize minimal distance to a value just outside the radius */
+    Int minDistanceSquared = (radius + 1)*(radius + 1);
+
+    /* Go in cocentric squares around the point */
+    for(Int i = 1; i <= radius; ++i) {
+        /* First check the four nearest points, if any of them is opposite of
+           what is on `position`, it's the nearest value */
+        const Int centerDistanceSquared = i*i;
+        if(centerDistanceSquared >= minDistanceSquared)
+            return minDistanceSquared;
+        if(hasValue(input, position + Vector2i{ 0,  i}) != isInside ||
+           hasValue(input, position + Vector2i{-i,  0}) != isInside ||
+           hasValue(input, position + Vector2i{ 0, -i}) != isInside ||
+           hasValue(input, position + Vector2i{ i,  0}) != isInside)
+            return centerDistanceSquared;
+
+        /* Then points further away, except for the corner points, all eight
+           rotations/reflections at the same distance at once */
+        for(Int j = 1; j < i; ++j) {
+            const Int sideDistanceSquared = i*i + j*j;
+            if(sideDistanceSquared >= minDistanceSquared)
+                break;
+            if(hasValue(input, position + Vector2i{ j,  i}) != isInside ||
+               hasValue(input, position + Vector2i{-j,  i}) != isInside ||
+               hasValue(input, position + Vector2i{-i,  j}) != isInside ||
+               hasValue(input, position + Vector2i{-i, -j}) != isInside ||
+               hasValue(input, position + Vector2i{-j, -i}) != isInside ||
+               hasValue(input, position + Vector2i{ j, -i}) != isInside ||
+               hasValue(input, position + Vector2i{ i, -j}) != isInside ||
+               hasValue(input, position + Vector2i{ i,  j}) != isInside) {
+                minDistanceSquared = sideDistanceSquared;
+                break;
+            }
+        }
+
+        /* Finally the corners */
+        const Int cornerDistanceSquared = 2*i*i;
+        if(cornerDistanceSquared >= minDistanceSquared)
+            continue;
+        if(hasValue(input, position + Vector2i{ i,  i}) != isInside ||
+           hasValue(input, position + Vector2i{-i,  i}) != isInside ||
+           hasValue(input, position + Vector2i{-i, -i}) != isInside ||
+           hasValue(input, position + Vector2i{ i, -i}) != isInside)
+            minDistanceSquared = cornerDistanceSquared;
+    }
+
+    return minDistanceSquared;
+}
+
+}
+
+void distanceField(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm,
+        "TextureTools::distanceField(): expected a" << PixelFormat::R8Unorm << "input but got" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::R8Unorm,
+        "TextureTools::distanceField(): expected a" << PixelFormat::R8Unorm << "output but got" << output.format(), );
+
+    const Containers::StridedArrayView2D<const UnsignedByte> inputPixels = input.pixels<UnsignedByte>();
+    const Containers::StridedArrayView2D<UnsignedByte> outputPixels = output.pixels<UnsignedByte>();
+    const Vector2 scaling = Vector2{input.size()}/Vector2{output.size()};
+    for(std::size_t y = 0; y != outputPixels.size()[0]; ++y) {
+        for(std::size_t x = 0; x != outputPixels.size()[1]; ++x) {
+            /* Same as with gl_FragCoord and pixel_center_integer in the
+               shader */
+            const Vector2i position{Vector2{Float(x), Float(y)}*scaling};
+
+            /* If the pixel at the position is inside, we're looking for the
+               nearest pixel outside and the value will be > 0.5, otherwise
+               for the nearest pixel inside and the value will be < 0.5 */
+            const bool isInside = hasValue(inputPixels, position);
+            const Float minDistance = std::sqrt(Float(findMinDistanceSquared(inputPixels, position, isInside, Int(radius))));
+
+            /* Final signed distance, normalized from [-radius-1, radius+1] to
+               [0, 1] */
+            const Float halfSign = isInside ? 0.5f : -0.5f;
+            outputPixels[y][x] = Math::pack<UnsignedByte>(halfSign*minDistance/Float(radius + 1) + 0.5f);
+        }
+    }
+}
+
+#ifdef MAGNUM_TARGET_GL
 using namespace Containers::Literals;
 
 namespace {
@@ -243,4 +349,6 @@ void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, cons
         );
 }
 
+#endif
+
 }}
@@ -26,23 +26,45 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::TextureTools::DistanceField
+ * @brief Class @ref Magnum::TextureTools::DistanceField, function @ref Magnum::TextureTools::distanceField()
  */
 
-#include "Magnum/configure.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
 
 #ifdef MAGNUM_TARGET_GL
 #include <Corrade/Containers/Pointer.h>
 
-#include "Magnum/Magnum.h"
 #include "Magnum/GL/GL.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/Math/Vector2.h"
 #endif
-#include "Magnum/TextureTools/visibility.h"
+#endif
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Create a signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param radius       Max lookup radius in the input image
+@m_since_latest
+
+A CPU counterpart to the @ref DistanceField class, producing the same output
+without requiring a GL context. Converts a binary black/white @p input image
+to a signed distance field in @p output, with @p input scaled to the size of
+@p output. See @ref TextureTools-DistanceField-algorithm for details about the
+algorithm. Pixels outside of @p input are treated as black. Both @p input and
+@p output are expected to be @ref PixelFormat::R8Unorm.
+
+The function operates only on the passed views and has no internal state, so
+it can be called from multiple threads at once as long as the outputs don't
+overlap. That's useful for example to process glyphs of a large font atlas in
+parallel, each with a view on its own sub-rectangle of the output image.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void distanceField(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius);
+
+#ifdef MAGNUM_TARGET_GL
 /**
 @brief Create a signed distance field
 
@@ -78,8 +100,9 @@ Based on: *Chris Green - Improved Alpha-Tested Magnification for Vector Textures
 and Special Effects, SIGGRAPH 2007,
 http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf*
 
-@attention This is a GPU-only implementation, so it expects an active GL
-    context.
+@attention This is a GPU implementation, so it expects an active GL context.
+    Use @ref distanceField(const ImageView2D&, const MutableImageView2D&, UnsignedInt)
+    for a CPU implementation.
 
 @note If internal format of @p output texture is not renderable, this function
     prints a message to error output and does nothing. On desktop OpenGL and
@@ -90,7 +113,7 @@ http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnifica
     rendering to @ref GL::TextureFormat::Luminance is not supported in most
     cases.
 
-@note This function is available only if Magnum is compiled with
+@note This class is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
     for more information.
 */
@@ -163,10 +186,8 @@ inline CORRADE_DEPRECATED("use the DistanceField class instead") void distanceFi
     DistanceField{UnsignedInt(radius)}(input, output, rectangle, imageSize);
 }
 #endif
+#endif
 
 }}
-#else
-#error this header is available only in the OpenGL build
-#endif
 
 #endif
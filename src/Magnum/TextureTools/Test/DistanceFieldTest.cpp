@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/TextureTools/DistanceField.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DistanceFieldTest: TestSuite::Tester {
+    explicit DistanceFieldTest();
+
+    void test();
+    void invalidFormat();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    Vector2i size;
+    Vector2i offset;
+} TestData[]{
+    {"", {64, 64}, {}},
+    {"with offset", {128, 96}, {64, 32}},
+};
+
+DistanceFieldTest::DistanceFieldTest() {
+    addInstancedTests({&DistanceFieldTest::test},
+        Containers::arraySize(TestData));
+
+    addTests({&DistanceFieldTest::invalidFormat});
+
+    /* Load the plugin directly from the build tree. Otherwise it's either
+       static and already loaded or not present in the build tree */
+    #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(ANYIMAGEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void DistanceFieldTest::test() {
+    auto&& data = TestData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(TEXTURETOOLS_TEST_DIR, "DistanceFieldGLTestFiles/input.tga")));
+    Containers::Optional<Trade::ImageData2D> input = importer->image2D(0);
+    CORRADE_VERIFY(input);
+    CORRADE_COMPARE(input->format(), PixelFormat::R8Unorm);
+
+    /* Process into a sub-rectangle of a larger image to verify the output
+       view is correctly respected. Unlike with the GL implementation, a
+       non-zero offset works here. */
+    Image2D output{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, data.size, Containers::Array<char>{ValueInit, std::size_t(data.size.product())}};
+    distanceField(*input, MutableImageView2D{
+        PixelStorage{}
+            .setAlignment(1)
+            .setRowLength(data.size.x())
+            .setSkip({data.offset.x(), data.offset.y(), 0}),
+        PixelFormat::R8Unorm, Vector2i{64}, output.data()}, 32);
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter plugin not found.");
+
+    /* The CPU implementation is an exact port of the shader, so no delta is
+       expected compared to the ground truth */
+    CORRADE_COMPARE_WITH(
+        output.pixels<UnsignedByte>().sliceSize(
+            {std::size_t(data.offset.y()), std::size_t(data.offset.x())},
+            {64, 64}),
+        Utility::Path::join(TEXTURETOOLS_TEST_DIR, "DistanceFieldGLTestFiles/output.tga"),
+        (DebugTools::CompareImageToFile{_manager}));
+}
+
+void DistanceFieldTest::invalidFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char data[4]{};
+    char outputData[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    distanceField(ImageView2D{PixelFormat::RG8Unorm, {1, 1}, data}, MutableImageView2D{PixelFormat::R8Unorm, {1, 1}, outputData}, 4);
+    distanceField(ImageView2D{PixelFormat::R8Unorm, {1, 1}, data}, MutableImageView2D{PixelFormat::R8Snorm, {1, 1}, outputData}, 4);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::distanceField(): expected a PixelFormat::R8Unorm input but got PixelFormat::RG8Unorm\n"
+        "TextureTools::distanceField(): expected a PixelFormat::R8Unorm output but got PixelFormat::R8Snorm\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldTest)
@@ -38,6 +38,7 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/profilerScope.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Trade/configure.h"
@@ -86,6 +87,8 @@ AbstractImageConverter::AbstractImageConverter(PluginManager::Manager<AbstractIm
 
 AbstractImageConverter::AbstractImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): PluginManager::AbstractManagingPlugin<AbstractImageConverter>{manager, plugin} {}
 
+AbstractImageConverter::~AbstractImageConverter() = default;
+
 void AbstractImageConverter::setFlags(ImageConverterFlags flags) {
     _flags = flags;
     doSetFlags(flags);
@@ -135,6 +138,20 @@ Containers::String AbstractImageConverter::mimeType() const {
 
 Containers::String AbstractImageConverter::doMimeType() const { return {}; }
 
+namespace {
+
+template<class T> std::size_t imageDataSize(const T& image) {
+    return image.data().size();
+}
+
+template<class T> std::size_t imageLevelsDataSize(const Containers::ArrayView<const T> imageLevels) {
+    std::size_t size = 0;
+    for(const T& image: imageLevels) size += image.data().size();
+    return size;
+}
+
+}
+
 Containers::Optional<ImageData1D> AbstractImageConverter::convert(const ImageView1D& image) {
     CORRADE_ASSERT(features() & ImageConverterFeature::Convert1D,
         "Trade::AbstractImageConverter::convert(): 1D image conversion not supported", {});
@@ -157,7 +174,9 @@ Containers::Optional<ImageData1D> AbstractImageConverter::convert(const ImageVie
        themselves, and since that's then a plugin-specific behavior, it should
        be a runtime error, not an assert. */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData1D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -173,7 +192,9 @@ Containers::Optional<ImageData2D> AbstractImageConverter::convert(const ImageVie
     /* No zero size / nullptr checks here, see convert(const ImageView1D&) for
        reasons why */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData2D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -221,7 +242,9 @@ Containers::Optional<ImageData3D> AbstractImageConverter::convert(const ImageVie
     /* No zero size / nullptr checks here, see convert(const ImageView1D&) for
        reasons why */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData3D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -237,7 +260,9 @@ Containers::Optional<ImageData1D> AbstractImageConverter::convert(const Compress
     /* No zero size / nullptr checks here, see convert(const ImageView1D&) for
        reasons why */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData1D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -253,7 +278,9 @@ Containers::Optional<ImageData2D> AbstractImageConverter::convert(const Compress
     /* No zero size / nullptr checks here, see convert(const ImageView1D&) for
        reasons why */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData2D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -269,7 +296,9 @@ Containers::Optional<ImageData3D> AbstractImageConverter::convert(const Compress
     /* No zero size / nullptr checks here, see convert(const ImageView1D&) for
        reasons why */
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convert()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<ImageData3D> out = doConvert(image);
+    if(out) profile.setBytesOut(out->data().size());
     CORRADE_ASSERT(!out || !out->_data.deleter(), "Trade::AbstractImageConverter::convert(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
@@ -331,7 +360,9 @@ AbstractImageConverter::convertToData(const ImageView1D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -364,7 +395,9 @@ AbstractImageConverter::convertToData(const ImageView2D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -404,7 +437,9 @@ AbstractImageConverter::convertToData(const ImageView3D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -437,7 +472,9 @@ AbstractImageConverter::convertToData(const CompressedImageView1D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -470,7 +507,9 @@ AbstractImageConverter::convertToData(const CompressedImageView2D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -510,7 +549,9 @@ AbstractImageConverter::convertToData(const CompressedImageView3D& image) {
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(image);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -642,7 +683,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const ImageVie
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -681,7 +724,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const ImageVie
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -720,7 +765,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const ImageVie
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -759,7 +806,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const Compress
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -798,7 +847,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const Compress
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -837,7 +888,9 @@ AbstractImageConverter::convertToData(const Containers::ArrayView<const Compress
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToData()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     Containers::Optional<Containers::Array<char>> out = doConvertToData(imageLevels);
+    if(out) profile.setBytesOut(out->size());
     CORRADE_ASSERT(!out || !out->deleter(), "Trade::AbstractImageConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
     /* GCC 4.8 needs an explicit conversion here */
@@ -871,6 +924,7 @@ bool AbstractImageConverter::convertToFile(const ImageView1D& image, const Conta
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -905,6 +959,7 @@ bool AbstractImageConverter::convertToFile(const ImageView2D& image, const Conta
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -945,6 +1000,7 @@ bool AbstractImageConverter::convertToFile(const ImageView3D& image, const Conta
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -979,6 +1035,7 @@ bool AbstractImageConverter::convertToFile(const CompressedImageView1D& image, c
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -1013,6 +1070,7 @@ bool AbstractImageConverter::convertToFile(const CompressedImageView2D& image, c
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -1053,6 +1111,7 @@ bool AbstractImageConverter::convertToFile(const CompressedImageView3D& image, c
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageDataSize(image)};
     return doConvertToFile(image, filename);
 }
 
@@ -1105,6 +1164,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Ima
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1137,6 +1197,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Ima
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1169,6 +1230,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Ima
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1201,6 +1263,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Com
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1233,6 +1296,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Com
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1265,6 +1329,7 @@ bool AbstractImageConverter::convertToFile(const Containers::ArrayView<const Com
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImageConverter::convertToFile()", plugin(), ~UnsignedInt{}, imageLevelsDataSize(imageLevels)};
     return doConvertToFile(imageLevels, filename);
 }
 
@@ -1287,6 +1352,83 @@ bool AbstractImageConverter::doConvertToFile(const Containers::ArrayView<const C
     return true;
 }
 
+struct AbstractImageConverter::StreamingState {
+    PixelFormat format;
+    Vector2i size;
+    Int rowsAdded;
+};
+
+void AbstractImageConverter::abort() {
+    if(!_streamingState) return;
+
+    doAbort();
+    _streamingState = {};
+}
+
+void AbstractImageConverter::doAbort() {}
+
+bool AbstractImageConverter::beginFile(const Containers::StringView filename, const PixelFormat format, const Vector2i& size, const ImageFlags2D flags) {
+    CORRADE_ASSERT(features() & ImageConverterFeature::Stream2DToFile,
+        "Trade::AbstractImageConverter::beginFile(): streaming 2D image conversion not supported", {});
+    CORRADE_ASSERT(size.product(),
+        "Trade::AbstractImageConverter::beginFile(): can't convert image with a zero size:" << size, {});
+
+    abort();
+
+    if(!doBeginFile(filename, format, size, flags)) {
+        doAbort();
+        return false;
+    }
+
+    _streamingState.emplace(StreamingState{format, size, 0});
+    return true;
+}
+
+bool AbstractImageConverter::doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::beginFile(): streaming 2D image conversion advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::addRows(const ImageView2D& rows) {
+    CORRADE_ASSERT(_streamingState,
+        "Trade::AbstractImageConverter::addRows(): no conversion in progress", {});
+    CORRADE_ASSERT(rows.data(),
+        "Trade::AbstractImageConverter::addRows(): can't add rows with a nullptr view", {});
+    CORRADE_ASSERT(rows.size().y(),
+        "Trade::AbstractImageConverter::addRows(): can't add zero rows", {});
+    CORRADE_ASSERT(rows.format() == _streamingState->format,
+        "Trade::AbstractImageConverter::addRows(): expected format" << _streamingState->format << "but got" << rows.format(), {});
+    CORRADE_ASSERT(rows.size().x() == _streamingState->size.x(),
+        "Trade::AbstractImageConverter::addRows(): expected width" << _streamingState->size.x() << "but got" << rows.size().x(), {});
+    CORRADE_ASSERT(_streamingState->rowsAdded + rows.size().y() <= _streamingState->size.y(),
+        "Trade::AbstractImageConverter::addRows(): adding" << rows.size().y() << "rows to" << _streamingState->rowsAdded << "would exceed image height" << _streamingState->size.y(), {});
+
+    if(!doAddRows(rows)) {
+        abort();
+        return false;
+    }
+
+    _streamingState->rowsAdded += rows.size().y();
+    return true;
+}
+
+bool AbstractImageConverter::doAddRows(const ImageView2D&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::addRows(): streaming 2D image conversion advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::endFile() {
+    CORRADE_ASSERT(_streamingState,
+        "Trade::AbstractImageConverter::endFile(): no conversion in progress", {});
+    CORRADE_ASSERT(_streamingState->rowsAdded == _streamingState->size.y(),
+        "Trade::AbstractImageConverter::endFile(): expected" << _streamingState->size.y() << "rows but got" << _streamingState->rowsAdded, {});
+
+    _streamingState = {};
+    return doEndFile();
+}
+
+bool AbstractImageConverter::doEndFile() {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::endFile(): streaming 2D image conversion advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
     const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
 
@@ -1322,6 +1464,7 @@ Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
         _c(ConvertCompressed2DToData)
         _c(ConvertCompressed3DToData)
         _c(Levels)
+        _c(Stream2DToFile)
         #undef _c
         /* LCOV_EXCL_STOP */
 
@@ -1371,7 +1514,8 @@ Debug& operator<<(Debug& debug, const ImageConverterFeatures value) {
         ImageConverterFeature::ConvertCompressed1DToFile,
         ImageConverterFeature::ConvertCompressed2DToFile,
         ImageConverterFeature::ConvertCompressed3DToFile,
-        ImageConverterFeature::Levels});
+        ImageConverterFeature::Levels,
+        ImageConverterFeature::Stream2DToFile});
 }
 
 Debug& operator<<(Debug& debug, const ImageConverterFlag value) {
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AbstractImageConverter, enum @ref Magnum::Trade::ImageConverterFeature, enum set @ref Magnum::Trade::ImageConverterFeatures
  */
 
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -277,6 +278,16 @@ enum class ImageConverterFeature: UnsignedInt {
      */
     Levels = 1 << 14,
 
+    /**
+     * Stream a 2D image to a file in bands of rows with
+     * @ref AbstractImageConverter::beginFile(),
+     * @relativeref{AbstractImageConverter,addRows()} and
+     * @relativeref{AbstractImageConverter,endFile()}, without having the
+     * whole image in memory at once.
+     * @m_since_latest
+     */
+    Stream2DToFile = 1 << 15,
+
     #ifdef MAGNUM_BUILD_DEPRECATED
     /**
      * @m_deprecated_since_latest Use
@@ -615,6 +626,15 @@ checked by the implementation:
     layout flags. Since file formats have varying requirements on image level
     sizes and their order and some don't impose any requirements at all, the
     plugin implementation is expected to check the sizes on its own.
+-   The @ref doBeginFile(), @ref doAddRows() and @ref doEndFile() functions
+    are called only if @ref ImageConverterFeature::Stream2DToFile is
+    supported. The @ref doBeginFile() function is called only if the size is
+    non-zero, @ref doAddRows() only if a conversion is in progress and the
+    rows are not @cpp nullptr @ce, have a non-zero height, the same width and
+    pixel format as passed to @ref beginFile() and don't exceed the image
+    height, and @ref doEndFile() only if all rows were added. If
+    @ref doBeginFile() or @ref doAddRows() fails, @ref doAbort() is called
+    for the plugin to clean up any state.
 
 @m_class{m-block m-warning}
 
@@ -678,6 +698,8 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
            header. */
         explicit AbstractImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
+        ~AbstractImageConverter();
+
         /** @brief Features supported by this converter */
         ImageConverterFeatures features() const { return doFeatures(); }
 
@@ -722,6 +744,27 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         void clearFlags(ImageConverterFlags flags);
 
+        /**
+         * @brief Profiler
+         * @m_since_latest
+         *
+         * @see @ref setProfiler()
+         */
+        Profiler* profiler() const { return _profiler; }
+
+        /**
+         * @brief Set a profiler
+         * @m_since_latest
+         *
+         * If non-null, wall time, input and output data sizes and optionally
+         * peak allocation of profiled calls made on this converter get recorded
+         * into @p profiler. See the @ref Profiler class documentation for a
+         * list of profiled functions. The profiler is expected to outlive
+         * the converter or be reset back to @cpp nullptr @ce before it's
+         * destroyed. By default no profiler is set.
+         */
+        void setProfiler(Profiler* profiler) { _profiler = profiler; }
+
         /**
          * @brief File extension
          * @m_since_latest
@@ -1605,6 +1648,70 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         bool convertToFile(std::initializer_list<CompressedImageView3D> imageLevels, Containers::StringView filename);
 
+        /**
+         * @brief Whether any streaming conversion is in progress
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if any conversion started by
+         * @ref beginFile() has not ended yet, @cpp false @ce otherwise.
+         */
+        bool isConverting() const { return !!_streamingState; }
+
+        /**
+         * @brief Abort any in-progress streaming conversion
+         * @m_since_latest
+         *
+         * On particular implementations an explicit call to this function may
+         * result in freed memory or a partially written file being removed.
+         * If no conversion is currently in progress, does nothing. After this
+         * function is called, @ref isConverting() returns @cpp false @ce.
+         */
+        void abort();
+
+        /**
+         * @brief Begin streaming a 2D image to a file
+         * @m_since_latest
+         *
+         * Available only if @ref ImageConverterFeature::Stream2DToFile is
+         * supported. If a conversion is currently in progress, calls
+         * @ref abort() first. The @p size is expected to be non-zero. The
+         * image data is then supplied in bands of rows via @ref addRows()
+         * and the conversion is finished with @ref endFile(). Compared to
+         * @ref convertToFile(const ImageView2D&, Containers::StringView) the
+         * whole image doesn't need to be in memory at once, making it
+         * possible to convert images larger than available memory. On
+         * failure prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce.
+         * @see @ref features(), @ref isConverting()
+         */
+        bool beginFile(Containers::StringView filename, PixelFormat format, const Vector2i& size, ImageFlags2D flags = {});
+
+        /**
+         * @brief Add a band of rows to a streamed image
+         * @m_since_latest
+         *
+         * Expects that @ref beginFile() was called before. The rows are
+         * supplied in order starting from the bottom of the image, the view
+         * is expected to not be @cpp nullptr @ce, have a non-zero height, the
+         * same width and pixel format as was passed to @ref beginFile() and
+         * the total count of rows added so far is expected to not exceed the
+         * image height. The band height can be different for each call. On
+         * failure prints a message to @relativeref{Magnum,Error}, aborts the
+         * conversion and returns @cpp false @ce.
+         */
+        bool addRows(const ImageView2D& rows);
+
+        /**
+         * @brief End streaming a 2D image to a file
+         * @m_since_latest
+         *
+         * Expects that @ref beginFile() was called before and that all rows
+         * of the image were added with @ref addRows(). On failure prints a
+         * message to @relativeref{Magnum,Error} and returns @cpp false @ce. In
+         * both cases, @ref isConverting() returns @cpp false @ce afterwards.
+         */
+        bool endFile();
+
     protected:
         /**
          * @brief Implementation for @ref convertToFile(const ImageView1D&, Containers::StringView)
@@ -1946,7 +2053,47 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         virtual Containers::Optional<Containers::Array<char>> doConvertToData(Containers::ArrayView<const CompressedImageView3D> imageLevels);
 
+        /**
+         * @brief Implementation for @ref abort()
+         * @m_since_latest
+         *
+         * Called only if @ref isConverting() is @cpp true @ce, and also when
+         * @ref doBeginFile() or @ref doAddRows() fails. Default implementation
+         * does nothing.
+         */
+        virtual void doAbort();
+
+        /**
+         * @brief Implementation for @ref beginFile()
+         * @m_since_latest
+         *
+         * Called only if @ref ImageConverterFeature::Stream2DToFile is
+         * supported and @p size is non-zero.
+         */
+        virtual bool doBeginFile(Containers::StringView filename, PixelFormat format, const Vector2i& size, ImageFlags2D flags);
+
+        /**
+         * @brief Implementation for @ref addRows()
+         * @m_since_latest
+         *
+         * The @p rows are guaranteed to match the format and width passed to
+         * @ref doBeginFile() and to not exceed the image height.
+         */
+        virtual bool doAddRows(const ImageView2D& rows);
+
+        /**
+         * @brief Implementation for @ref endFile()
+         * @m_since_latest
+         *
+         * Called only after all rows were added.
+         */
+        virtual bool doEndFile();
+
+        struct StreamingState;
+
         ImageConverterFlags _flags;
+        Profiler* _profiler{};
+        Containers::Pointer<StreamingState> _streamingState;
 };
 
 /**
@@ -1967,7 +2114,7 @@ updated interface string.
 */
 /* Silly indentation to make the string appear in pluginInterface() docs */
 #define MAGNUM_TRADE_ABSTRACTIMAGECONVERTER_PLUGIN_INTERFACE /* [interface] */ \
-"cz.mosra.magnum.Trade.AbstractImageConverter/0.3.3"
+"cz.mosra.magnum.Trade.AbstractImageConverter/0.3.5"
 /* [interface] */
 
 }}
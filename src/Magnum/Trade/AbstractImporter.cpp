@@ -46,6 +46,7 @@
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/SkinData.h"
 #include "Magnum/Trade/TextureData.h"
+#include "Magnum/Trade/Implementation/profilerScope.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <string> /* for object2DName() etc., not going to change those */
@@ -113,11 +114,16 @@ AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& man
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
-#ifdef MAGNUM_BUILD_DEPRECATED
-/* These twp needed because of the Array<CachedScenes> member */
+struct AbstractImporter::MappedFile {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Path::MapDeleter> data;
+    #endif
+};
+
+/* These two needed because of the Pointer<MappedFile> and
+   Array<CachedScenes> members */
 AbstractImporter::AbstractImporter(AbstractImporter&&) noexcept = default;
 AbstractImporter::~AbstractImporter() = default;
-#endif
 
 void AbstractImporter::setFlags(ImporterFlags flags) {
     CORRADE_ASSERT(!isOpened(),
@@ -155,6 +161,8 @@ bool AbstractImporter::openData(Containers::ArrayView<const void> data) {
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
     close();
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::openData()", plugin(), ~UnsignedInt{}, data.size()};
+    ArrayArenaScope arena{_arrayArena};
     doOpenData(Containers::Array<char>{const_cast<char*>(static_cast<const char*>(data.data())), data.size(), Implementation::nonOwnedArrayDeleter}, {});
     return isOpened();
 }
@@ -184,6 +192,8 @@ bool AbstractImporter::openMemory(Containers::ArrayView<const void> memory) {
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
     close();
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::openMemory()", plugin(), ~UnsignedInt{}, memory.size()};
+    ArrayArenaScope arena{_arrayArena};
     doOpenData(Containers::Array<char>{const_cast<char*>(static_cast<const char*>(memory.data())), memory.size(), Implementation::nonOwnedArrayDeleter}, DataFlag::ExternallyOwned);
     return isOpened();
 }
@@ -208,6 +218,11 @@ void AbstractImporter::doOpenState(const void*, const Containers::StringView) {
 bool AbstractImporter::openFile(const Containers::StringView filename) {
     close();
 
+    /* The file size isn't known here, as it may be read by the
+       implementation itself */
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::openFile()", plugin()};
+    ArrayArenaScope arena{_arrayArena};
+
     /* If file loading callbacks are not set or the importer supports handling
        them directly, call into the implementation */
     if(!_fileCallback || (doFeatures() & ImporterFeature::FileCallback)) {
@@ -244,6 +259,10 @@ bool AbstractImporter::openFile(const Containers::StringView filename) {
     /* Shouldn't get here, the assert is fired already in setFileCallback() */
     } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
+    /* If the file was mapped with ImporterFlag::MapFile but opening failed,
+       there's nothing referencing the mapping anymore */
+    if(!isOpened()) _mappedFile = nullptr;
+
     return isOpened();
 }
 
@@ -261,8 +280,24 @@ void AbstractImporter::doOpenFile(const Containers::StringView filename) {
         doOpenData(Containers::Array<char>{const_cast<char*>(data->data()), data->size(), Implementation::nonOwnedArrayDeleter}, {});
         _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
 
-    /* Otherwise open the file directly */
-    } else {
+    /* Otherwise, if requested, memory-map the file and keep the mapping alive
+       until the file is closed */
+    }
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    else if(_flags & ImporterFlag::MapFile) {
+        Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> data = Utility::Path::mapRead(filename);
+        if(!data) {
+            Error() << "Trade::AbstractImporter::openFile(): cannot map file" << filename;
+            return;
+        }
+
+        _mappedFile = Containers::Pointer<MappedFile>{new MappedFile{*Utility::move(data)}};
+        doOpenData(Containers::Array<char>{const_cast<char*>(_mappedFile->data.data()), _mappedFile->data.size(), Implementation::nonOwnedArrayDeleter}, DataFlag::ExternallyOwned);
+    }
+    #endif
+
+    /* Otherwise read the file into a newly allocated array */
+    else {
         Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
         if(!data) {
             Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
@@ -278,6 +313,10 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    /* Release the mapping from ImporterFlag::MapFile only after the
+       implementation is done with it */
+    _mappedFile = nullptr;
 }
 
 Int AbstractImporter::defaultScene() const {
@@ -349,7 +388,10 @@ Containers::String AbstractImporter::doObjectName(UnsignedLong) { return {}; }
 Containers::Optional<SceneData> AbstractImporter::scene(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::scene(): no file opened", {});
     CORRADE_ASSERT(id < doSceneCount(), "Trade::AbstractImporter::scene(): index" << id << "out of range for" << doSceneCount() << "entries", {});
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::scene()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<SceneData> scene = doScene(id);
+    if(scene) profile.setBytesOut(scene->data().size());
     CORRADE_ASSERT(!scene || (
         (!scene->_data.deleter() || scene->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter)) &&
         (!scene->_fields.deleter() || scene->_fields.deleter() == static_cast<void(*)(SceneFieldData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
@@ -424,11 +466,14 @@ Containers::String AbstractImporter::doAnimationName(UnsignedInt) { return {}; }
 Containers::Optional<AnimationData> AbstractImporter::animation(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animation(): no file opened", {});
     CORRADE_ASSERT(id < doAnimationCount(), "Trade::AbstractImporter::animation(): index" << id << "out of range for" << doAnimationCount() << "entries", {});
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::animation()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<AnimationData> animation = doAnimation(id);
+    if(animation) profile.setBytesOut(animation->data().size());
     /** @todo maybe this should also disallow custom interpolators? since thise
         would be dangling on plugin unload */
     CORRADE_ASSERT(!animation ||
-        ((!animation->_data.deleter() || animation->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || animation->_data.deleter() == ArrayAllocator<char>::deleter) &&
+        ((!animation->_data.deleter() || animation->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || animation->_data.deleter() == ArrayAllocator<char>::deleter || animation->_data.deleter() == ArrayArenaAllocator<char>::deleter) &&
         (!animation->_tracks.deleter() || animation->_tracks.deleter() == static_cast<void(*)(AnimationTrackData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::animation(): implementation is not allowed to use a custom Array deleter", {});
     return animation;
@@ -1138,10 +1183,13 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const UnsignedInt id, cons
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::mesh(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::mesh()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<MeshData> mesh = doMesh(id, level);
+    if(mesh) profile.setBytesOut(mesh->indexData().size() + mesh->vertexData().size());
     CORRADE_ASSERT(!mesh || (
-        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
-        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter) &&
+        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter || mesh->_indexData.deleter() == ArrayArenaAllocator<char>::deleter) &&
+        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter || mesh->_vertexData.deleter() == ArrayArenaAllocator<char>::deleter) &&
         (!mesh->_attributes.deleter() || mesh->_attributes.deleter() == static_cast<void(*)(MeshAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::mesh(): implementation is not allowed to use a custom Array deleter", {});
     return mesh;
@@ -1310,6 +1358,8 @@ AbstractImporter::material(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::material(): no file opened", {});
     CORRADE_ASSERT(id < doMaterialCount(), "Trade::AbstractImporter::material(): index" << id << "out of range for" << doMaterialCount() << "entries", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::material()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<MaterialData> material = doMaterial(id);
     CORRADE_ASSERT(!material || (
         (!material->_data.deleter() || material->_data.deleter() == static_cast<void(*)(MaterialAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter)) &&
@@ -1444,8 +1494,11 @@ Containers::Optional<ImageData1D> AbstractImporter::image1D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image1D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::image1D()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<ImageData1D> image = doImage1D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image) profile.setBytesOut(image->data().size());
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == ArrayArenaAllocator<char>::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1517,8 +1570,11 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::image2D()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<ImageData2D> image = doImage2D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image) profile.setBytesOut(image->data().size());
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == ArrayArenaAllocator<char>::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1590,8 +1646,11 @@ Containers::Optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image3D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractImporter::image3D()", plugin(), id};
+    ArrayArenaScope arena{_arrayArena};
     Containers::Optional<ImageData3D> image = doImage3D(id, level);
-    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image) profile.setBytesOut(image->data().size());
+    CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || image->_data.deleter() == ArrayAllocator<char>::deleter || image->_data.deleter() == ArrayArenaAllocator<char>::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
 }
 
@@ -1629,6 +1688,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         _c(OpenData)
         _c(OpenState)
         _c(FileCallback)
+        _c(ThreadSafe)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1640,7 +1700,8 @@ Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, debug.immediateFlags() >= Debug::Flag::Packed ? "{}" : "Trade::ImporterFeatures{}", {
         ImporterFeature::OpenData,
         ImporterFeature::OpenState,
-        ImporterFeature::FileCallback});
+        ImporterFeature::FileCallback,
+        ImporterFeature::ThreadSafe});
 }
 
 Debug& operator<<(Debug& debug, const ImporterFlag value) {
@@ -1651,6 +1712,7 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
         #define _c(v) case ImporterFlag::v: return debug << "::" #v;
         _c(Quiet)
         _c(Verbose)
+        _c(MapFile)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1661,7 +1723,8 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
 Debug& operator<<(Debug& debug, const ImporterFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFlags{}", {
         ImporterFlag::Quiet,
-        ImporterFlag::Verbose});
+        ImporterFlag::Verbose,
+        ImporterFlag::MapFile});
 }
 
 }}
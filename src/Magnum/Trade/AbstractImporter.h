@@ -30,6 +30,7 @@
  */
 
 #include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 #include <Corrade/Utility/StlForwardString.h> /** @todo remove once file callbacks are std::string-free */
 
@@ -72,7 +73,23 @@ enum class ImporterFeature: UnsignedByte {
      * See @ref Trade-AbstractImporter-usage-callbacks and particular importer
      * documentation for more information.
      */
-    FileCallback = 1 << 2
+    FileCallback = 1 << 2,
+
+    /**
+     * Data import functions such as @ref AbstractImporter::mesh(),
+     * @relativeref{AbstractImporter,material()} or
+     * @relativeref{AbstractImporter,image2D()} can be called concurrently
+     * from multiple threads while a file is opened. Functions that open or
+     * close a file or change importer flags, options or callbacks are still
+     * expected to be called from a single thread with no import in progress.
+     *
+     * The @ref importMeshes(), @ref importMaterials() and
+     * @ref importImages2D() "importImages*D()" functions use this to import
+     * multiple items in parallel. Note that distinct importer instances can
+     * be always used from different threads, independently of this feature.
+     * @m_since_latest
+     */
+    ThreadSafe = 1 << 3
 };
 
 /**
@@ -124,6 +141,40 @@ enum class ImporterFlag: UnsignedByte {
      */
     Verbose = 1 << 0,
 
+    /**
+     * Memory-map files opened with @ref AbstractImporter::openFile() instead
+     * of reading them into a newly allocated array. Affects only importers
+     * that use the default @ref AbstractImporter::doOpenFile() implementation
+     * or delegate to it, and only if file callbacks aren't set. The mapped
+     * memory is then passed to @ref AbstractImporter::doOpenData() as
+     * @ref DataFlag::ExternallyOwned, same as with
+     * @ref AbstractImporter::openMemory(), so importers supporting zero-copy
+     * import can return data referencing it directly instead of making a
+     * copy. Compared to calling @relativeref{AbstractImporter,openMemory()}
+     * with a mapped file, the importer still knows the filename, so files
+     * referencing external data can be opened this way as well. The mapping
+     * is released on @ref AbstractImporter::close(), when another file is
+     * opened or when the importer is destroyed.
+     *
+     * @m_class{m-block m-warning}
+     *
+     * @par Lifetime of returned data
+     *      Data returned by the importer while this flag is set may be views
+     *      into the mapped memory, i.e. images or meshes whose
+     *      @ref ImageData::dataFlags() or @ref MeshData::vertexDataFlags()
+     *      don't contain @ref DataFlag::Owned. Such data becomes dangling once
+     *      the mapping is released, i.e. after
+     *      @ref AbstractImporter::close(), after opening another file or
+     *      after the importer is destroyed. Copy the data if it needs to
+     *      outlive the opened file.
+     *
+     * Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+     * @ref CORRADE_TARGET_WINDOWS "Windows" platforms, elsewhere the file is
+     * read into a newly allocated array as usual.
+     * @m_since_latest
+     */
+    MapFile = 1 << 2,
+
     /** @todo is warning as error (like in ShaderConverter) usable for anything
         here? in case of a compiler it makes sense, in case of an importer not
         so much probably? it'd also mean expanding each and every Warning
@@ -433,9 +484,10 @@ checked by the implementation:
     As @ref Trade-AbstractImporter-data-dependency "mentioned above",
     @relativeref{Corrade,Containers::Array} instances returned from plugin
     implementations are not allowed to use anything else than the default
-    deleter or the deleter used by @ref Trade::ArrayAllocator, otherwise this
-    could cause dangling function pointer call on array destruction if the
-    plugin gets unloaded before the array is destroyed. This is asserted by the
+    deleter or the deleters used by @ref Trade::ArrayAllocator and
+    @ref Trade::ArrayArenaAllocator, otherwise this could cause dangling
+    function pointer call on array destruction if the plugin gets unloaded
+    before the array is destroyed. This is asserted by the
     base implementation on return.
 @par
     Similarly for interpolator functions passed through
@@ -500,10 +552,10 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
            header. */
         explicit AbstractImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
-        #if defined(MAGNUM_BUILD_DEPRECATED) && !defined(DOXYGEN_GENERATING_OUTPUT)
-        /* These twp needed because of the Array<CachedScenes> member
-           (AnyImageImporter relies on the move), move assignment disabled by
-           AbstractPlugin already */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* These two needed because of the Pointer<MappedFile> and
+           Array<CachedScenes> members (AnyImageImporter relies on the move),
+           move assignment disabled by AbstractPlugin already */
         AbstractImporter(AbstractImporter&&) noexcept;
         ~AbstractImporter();
         #endif
@@ -555,6 +607,54 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         void clearFlags(ImporterFlags flags);
 
+        /**
+         * @brief Profiler
+         * @m_since_latest
+         *
+         * @see @ref setProfiler()
+         */
+        Profiler* profiler() const { return _profiler; }
+
+        /**
+         * @brief Set a profiler
+         * @m_since_latest
+         *
+         * If non-null, wall time, input and output data sizes and optionally
+         * peak allocation of profiled calls made on this importer get recorded
+         * into @p profiler. See the @ref Profiler class documentation for a
+         * list of profiled functions. The profiler is expected to outlive
+         * the importer or be reset back to @cpp nullptr @ce before it's
+         * destroyed. By default no profiler is set.
+         */
+        void setProfiler(Profiler* profiler) { _profiler = profiler; }
+
+        /**
+         * @brief Array arena
+         * @m_since_latest
+         *
+         * @see @ref setArrayArena()
+         */
+        ArrayArena* arrayArena() const { return _arrayArena; }
+
+        /**
+         * @brief Set an array arena
+         * @m_since_latest
+         *
+         * If non-null, the arena is made current using an
+         * @ref ArrayArenaScope for the duration of @ref openData(),
+         * @ref openMemory(), @ref openFile(), @ref scene(),
+         * @ref animation(), @ref mesh(), @ref material(), @ref image1D(),
+         * @ref image2D() and @ref image3D() calls, causing data the plugin
+         * allocates with @ref ArrayArenaAllocator to be allocated from it.
+         * Use a dedicated arena for each importer instance, or each opened
+         * file, and @ref ArrayArena::release() it once the imported data are
+         * no longer needed. The arena is thread-safe, so it can be used with
+         * @ref importMeshes() and other parallel functions as well. The arena
+         * is expected to outlive the importer or be reset back to
+         * @cpp nullptr @ce before it's destroyed. By default no arena is set.
+         */
+        void setArrayArena(ArrayArena* arena) { _arrayArena = arena; }
+
         /**
          * @brief File opening callback function
          *
@@ -1856,7 +1956,9 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * -    If @p dataFlags is @ref DataFlag::ExternallyOwned, it can be
          *      assumed that @p data will stay in scope until @ref doClose() is
          *      called or the importer is destructed. This happens when the
-         *      function is called from @ref openMemory().
+         *      function is called from @ref openMemory() or from the default
+         *      @ref doOpenFile() implementation if
+         *      @ref ImporterFlag::MapFile is set.
          *
          * Example workflow in a plugin that needs to preserve access to the
          * input data but wants to avoid allocating a copy if possible:
@@ -2601,6 +2703,8 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         virtual const void* doImporterState() const;
 
         ImporterFlags _flags;
+        Profiler* _profiler{};
+        ArrayArena* _arrayArena{};
 
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
@@ -2612,6 +2716,10 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /* GCC 4.8 complains loudly about missing initializers otherwise */
         } _fileCallbackTemplate{nullptr, nullptr};
 
+        /* Used by the default doOpenFile() with ImporterFlag::MapFile */
+        struct MappedFile;
+        Containers::Pointer<MappedFile> _mappedFile;
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         struct CachedScenes;
         Containers::Pointer<CachedScenes> _cachedScenes;
@@ -2637,7 +2745,7 @@ updated interface string.
 */
 /* Silly indentation to make the string appear in pluginInterface() docs */
 #define MAGNUM_TRADE_ABSTRACTIMPORTER_PLUGIN_INTERFACE /* [interface] */ \
-"cz.mosra.magnum.Trade.AbstractImporter/0.5.2"
+"cz.mosra.magnum.Trade.AbstractImporter/0.5.4"
 /* [interface] */
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
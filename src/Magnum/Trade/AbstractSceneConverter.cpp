@@ -25,6 +25,7 @@
 
 #include "AbstractSceneConverter.h"
 
+#include <atomic>
 #include <Corrade/Containers/AnyReference.h>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
@@ -37,6 +38,7 @@
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/AnimationData.h"
@@ -48,6 +50,7 @@
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/SkinData.h"
 #include "Magnum/Trade/TextureData.h"
+#include "Magnum/Trade/Implementation/profilerScope.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 /* needed by deprecated convertToFile() that takes a std::string */
@@ -262,13 +265,37 @@ void AbstractSceneConverter::clearFlags(SceneConverterFlags flags) {
     setFlags(_flags & ~flags);
 }
 
+namespace {
+
+std::size_t meshDataSize(const MeshData& mesh) {
+    return mesh.indexData().size() + mesh.vertexData().size();
+}
+
+std::size_t meshDataSize(const Containers::Iterable<const MeshData>& meshLevels) {
+    std::size_t size = 0;
+    for(const MeshData& mesh: meshLevels)
+        size += meshDataSize(mesh);
+    return size;
+}
+
+template<UnsignedInt dimensions> std::size_t imageDataSize(const Containers::Iterable<const ImageData<dimensions>>& imageLevels) {
+    std::size_t size = 0;
+    for(const ImageData<dimensions>& image: imageLevels)
+        size += image.data().size();
+    return size;
+}
+
+}
+
 Containers::Optional<MeshData> AbstractSceneConverter::convert(const MeshData& mesh) {
     abort();
 
     CORRADE_ASSERT(features() & SceneConverterFeature::ConvertMesh,
         "Trade::AbstractSceneConverter::convert(): mesh conversion not supported", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::convert()", plugin(), ~UnsignedInt{}, meshDataSize(mesh)};
     Containers::Optional<MeshData> out = doConvert(mesh);
+    if(out) profile.setBytesOut(meshDataSize(*out));
     CORRADE_ASSERT(!out || (
         (!out->_indexData.deleter() || out->_indexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || out->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
         (!out->_vertexData.deleter() || out->_vertexData.deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || out->_vertexData.deleter() == ArrayAllocator<char>::deleter) &&
@@ -287,7 +314,10 @@ bool AbstractSceneConverter::convertInPlace(MeshData& mesh) {
     CORRADE_ASSERT(features() & SceneConverterFeature::ConvertMeshInPlace,
         "Trade::AbstractSceneConverter::convertInPlace(): mesh conversion not supported", {});
 
-    return doConvertInPlace(mesh);
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::convertInPlace()", plugin(), ~UnsignedInt{}, meshDataSize(mesh)};
+    if(!doConvertInPlace(mesh)) return false;
+    profile.setBytesOut(meshDataSize(mesh));
+    return true;
 }
 
 bool AbstractSceneConverter::doConvertInPlace(MeshData&) {
@@ -302,8 +332,11 @@ Implementation::SceneConverterOptionalButAlsoArray<char>
 AbstractSceneConverter::convertToData(const MeshData& mesh) {
     abort();
 
+    /* Output size is known only if the conversion is done directly */
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::convertToData()", plugin(), ~UnsignedInt{}, meshDataSize(mesh)};
     if(features() >= SceneConverterFeature::ConvertMeshToData) {
         Containers::Optional<Containers::Array<char>> out = doConvertToData(mesh);
+        if(out) profile.setBytesOut(out->size());
         CORRADE_ASSERT(!out || !out->deleter() || out->deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || out->deleter() == ArrayAllocator<char>::deleter,
             "Trade::AbstractSceneConverter::convertToData(): implementation is not allowed to use a custom Array deleter", {});
 
@@ -317,7 +350,11 @@ AbstractSceneConverter::convertToData(const MeshData& mesh) {
     } else if(features() >= (SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes)) {
         beginData();
 
-        if(add(mesh)) return endData();
+        if(add(mesh)) {
+            Containers::Optional<Containers::Array<char>> out = endData();
+            if(out) profile.setBytesOut(out->size());
+            return out;
+        }
 
         /* Finish the conversion even if add() fails -- this API shouldn't
            leave it in an in-progress state */
@@ -334,6 +371,7 @@ Containers::Optional<Containers::Array<char>> AbstractSceneConverter::doConvertT
 bool AbstractSceneConverter::convertToFile(const MeshData& mesh, const Containers::StringView filename) {
     abort();
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::convertToFile()", plugin(), ~UnsignedInt{}, meshDataSize(mesh)};
     if(features() >= SceneConverterFeature::ConvertMeshToFile) {
         return doConvertToFile(mesh, filename);
 
@@ -387,6 +425,7 @@ void AbstractSceneConverter::doAbort() {}
 bool AbstractSceneConverter::begin() {
     abort();
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::begin()", plugin()};
     _state.emplace(State::Type::Convert);
 
     if(features() >= SceneConverterFeature::ConvertMultiple) {
@@ -412,6 +451,7 @@ Containers::Pointer<AbstractImporter> AbstractSceneConverter::end() {
     CORRADE_ASSERT(_state && _state->type == State::Type::Convert,
         "Trade::AbstractSceneConverter::end(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::end()", plugin()};
     Containers::ScopeGuard deleteState{this, [](AbstractSceneConverter* self) {
         self->_state = {};
     }};
@@ -470,6 +510,7 @@ Containers::Pointer<AbstractImporter> AbstractSceneConverter::doEnd() {
 bool AbstractSceneConverter::beginData() {
     abort();
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::beginData()", plugin()};
     _state.emplace(State::Type::ConvertToData);
 
     if(features() >= SceneConverterFeature::ConvertMultipleToData) {
@@ -495,12 +536,14 @@ Containers::Optional<Containers::Array<char>> AbstractSceneConverter::endData()
     CORRADE_ASSERT(_state && _state->type == State::Type::ConvertToData,
         "Trade::AbstractSceneConverter::endData(): no data conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::endData()", plugin()};
     Containers::ScopeGuard deleteState{this, [](AbstractSceneConverter* self) {
         self->_state = {};
     }};
 
     if(features() >= SceneConverterFeature::ConvertMultipleToData) {
         Containers::Optional<Containers::Array<char>> out = doEndData();
+        if(out) profile.setBytesOut(out->size());
         CORRADE_ASSERT(!out || !out->deleter() || out->deleter() == static_cast<void(*)(char*, std::size_t)>(Implementation::nonOwnedArrayDeleter) || out->deleter() == ArrayAllocator<char>::deleter,
             "Trade::AbstractSceneConverter::endData(): implementation is not allowed to use a custom Array deleter", {});
 
@@ -515,6 +558,8 @@ Containers::Optional<Containers::Array<char>> AbstractSceneConverter::endData()
         /* No deleter validity checks here, those were performed in
            convertToData(const MeshData&) already */
 
+        if(_state->converted.meshToData)
+            profile.setBytesOut(_state->converted.meshToData->size());
         return Utility::move(_state->converted.meshToData);
 
     } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -527,6 +572,7 @@ Containers::Optional<Containers::Array<char>> AbstractSceneConverter::doEndData(
 bool AbstractSceneConverter::beginFile(const Containers::StringView filename) {
     abort();
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::beginFile()", plugin()};
     _state.emplace(State::Type::ConvertToFile);
     _state->filename = Containers::String::nullTerminatedGlobalView(filename);
 
@@ -556,6 +602,7 @@ bool AbstractSceneConverter::endFile() {
     CORRADE_ASSERT(_state && _state->type == State::Type::ConvertToFile,
         "Trade::AbstractSceneConverter::endFile(): no file conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::endFile()", plugin()};
     Containers::ScopeGuard deleteState{this, [](AbstractSceneConverter* self) {
         self->_state = {};
     }};
@@ -601,6 +648,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const SceneData& s
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->sceneCount, scene.data().size()};
     if(doAdd(_state->sceneCount, scene, name))
         return _state->sceneCount++;
     return {};
@@ -662,6 +710,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const AnimationDat
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->animationCount, animation.data().size()};
     if(doAdd(_state->animationCount, animation, name))
         return _state->animationCount++;
     return {};
@@ -699,6 +748,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const LightData& l
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->lightCount};
     if(doAdd(_state->lightCount, light, name))
         return _state->lightCount++;
     return {};
@@ -723,6 +773,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const CameraData&
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->cameraCount};
     if(doAdd(_state->cameraCount, camera, name))
         return _state->cameraCount++;
     return {};
@@ -747,6 +798,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const SkinData2D&
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->skin2DCount};
     if(doAdd(_state->skin2DCount, skin, name))
         return _state->skin2DCount++;
     return {};
@@ -771,6 +823,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const SkinData3D&
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->skin3DCount};
     if(doAdd(_state->skin3DCount, skin, name))
         return _state->skin3DCount++;
     return {};
@@ -793,6 +846,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const MeshData& me
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->meshCount, meshDataSize(mesh)};
     if(features() >= SceneConverterFeature::AddMeshes) {
         if(!doAdd(_state->meshCount, mesh, name)) return {};
 
@@ -841,6 +895,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const Containers::
     CORRADE_ASSERT(!meshLevels.isEmpty(),
         "Trade::AbstractSceneConverter::add(): at least one mesh level has to be specified", false);
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->meshCount, meshDataSize(meshLevels)};
     if(doAdd(_state->meshCount, meshLevels, name))
         return _state->meshCount++;
     return {};
@@ -854,6 +909,42 @@ bool AbstractSceneConverter::doAdd(UnsignedInt, const Containers::Iterable<const
     CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::add(): multi-level mesh conversion advertised but not implemented", {});
 }
 
+namespace {
+
+/* Calls add() for all items, from multiple threads if parallel is true.
+   Returns false if any of the calls failed, in which case the items not yet
+   picked are skipped. */
+template<class Add> bool addParallel(const std::size_t count, const bool parallel, const UnsignedInt threadCount, Add add) {
+    std::atomic<bool> failed{false};
+    Magnum::Implementation::parallelFor(count, parallel ? Magnum::Implementation::threadCount(threadCount) : 1, [&](const std::size_t i) {
+        if(!failed && !add(i)) failed = true;
+    });
+    return !failed;
+}
+
+}
+
+Containers::Optional<UnsignedInt> AbstractSceneConverter::addMeshes(const Containers::Iterable<const MeshData>& meshes, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::AddMeshes,
+        "Trade::AbstractSceneConverter::addMeshes(): mesh conversion not supported", {});
+    CORRADE_ASSERT(_state,
+        "Trade::AbstractSceneConverter::addMeshes(): no conversion in progress", {});
+
+    /* The IDs are assigned upfront, the count is increased only once all
+       meshes are processed */
+    const UnsignedInt first = _state->meshCount;
+    if(!addParallel(meshes.size(), features() >= SceneConverterFeature::AddParallel, threadCount, [&](const std::size_t i) {
+        Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::addMeshes()", plugin(), first + UnsignedInt(i), meshDataSize(meshes[i])};
+        return doAdd(first + UnsignedInt(i), meshes[i], {});
+    })) {
+        abort();
+        return {};
+    }
+
+    _state->meshCount += meshes.size();
+    return first;
+}
+
 void AbstractSceneConverter::setMeshAttributeName(const MeshAttribute attribute, const Containers::StringView name) {
     CORRADE_ASSERT(features() & (SceneConverterFeature::AddMeshes|
                                  SceneConverterFeature::ConvertMesh|
@@ -887,6 +978,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const MaterialData
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->materialCount};
     if(doAdd(_state->materialCount, material, name))
         return _state->materialCount++;
     return {};
@@ -911,6 +1003,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const TextureData&
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->textureCount};
     if(doAdd(_state->textureCount, texture, name))
         return _state->textureCount++;
     return {};
@@ -1006,6 +1099,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const ImageData1D&
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image1DCount, image.data().size()};
     if(doAdd(_state->image1DCount, image, name))
         return _state->image1DCount++;
     return {};
@@ -1050,6 +1144,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const Containers::
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image1DCount, imageDataSize(imageLevels)};
     if(doAdd(_state->image1DCount, imageLevels, name))
         return _state->image1DCount++;
     return {};
@@ -1107,6 +1202,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const ImageData2D&
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image2DCount, image.data().size()};
     if(doAdd(_state->image2DCount, image, name))
         return _state->image2DCount++;
     return {};
@@ -1151,6 +1247,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const Containers::
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image2DCount, imageDataSize(imageLevels)};
     if(doAdd(_state->image2DCount, imageLevels, name))
         return _state->image2DCount++;
     return {};
@@ -1164,6 +1261,36 @@ bool AbstractSceneConverter::doAdd(UnsignedInt, const Containers::Iterable<const
     CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::add(): multi-level 2D image conversion advertised but not implemented", {});
 }
 
+Containers::Optional<UnsignedInt> AbstractSceneConverter::addImages2D(const Containers::Iterable<const ImageData2D>& images, const UnsignedInt threadCount) {
+    #ifndef CORRADE_NO_ASSERT
+    for(const ImageData2D& image: images)
+        CORRADE_ASSERT(features() & (image.isCompressed() ? SceneConverterFeature::AddCompressedImages2D : SceneConverterFeature::AddImages2D),
+            "Trade::AbstractSceneConverter::addImages2D():" << (image.isCompressed() ? "compressed 2D" : "2D") << "image conversion not supported", {});
+    #endif
+    CORRADE_ASSERT(_state,
+        "Trade::AbstractSceneConverter::addImages2D(): no conversion in progress", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* Explicitly return if checks fail for CORRADE_GRACEFUL_ASSERT builds */
+    for(const ImageData2D& image: images)
+        if(!checkImageValidity("Trade::AbstractSceneConverter::addImages2D():", image))
+            return {};
+    #endif
+
+    /* The IDs are assigned upfront, the count is increased only once all
+       images are processed */
+    const UnsignedInt first = _state->image2DCount;
+    if(!addParallel(images.size(), features() >= SceneConverterFeature::AddParallel, threadCount, [&](const std::size_t i) {
+        Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::addImages2D()", plugin(), first + UnsignedInt(i), images[i].data().size()};
+        return doAdd(first + UnsignedInt(i), images[i], {});
+    })) {
+        abort();
+        return {};
+    }
+
+    _state->image2DCount += images.size();
+    return first;
+}
+
 Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const Containers::Iterable<const ImageView2D>& imageLevels, const Containers::StringView name) {
     Containers::Array<ImageData2D> data{NoInit, imageLevels.size()};
     for(std::size_t i = 0; i != imageLevels.size(); ++i) {
@@ -1208,6 +1335,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const ImageData3D&
         return {};
     #endif
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image3DCount, image.data().size()};
     if(doAdd(_state->image3DCount, image, name))
         return _state->image3DCount++;
     return {};
@@ -1252,6 +1380,7 @@ Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const Containers::
     CORRADE_ASSERT(_state,
         "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
 
+    Implementation::ProfilerScope profile{_profiler, "Trade::AbstractSceneConverter::add()", plugin(), _state->image3DCount, imageDataSize(imageLevels)};
     if(doAdd(_state->image3DCount, imageLevels, name))
         return _state->image3DCount++;
     return {};
@@ -1748,6 +1877,7 @@ Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
         _c(AddCompressedImages3D)
         _c(MeshLevels)
         _c(ImageLevels)
+        _c(AddParallel)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1782,7 +1912,8 @@ Debug& operator<<(Debug& debug, const SceneConverterFeatures value) {
         SceneConverterFeature::AddCompressedImages2D,
         SceneConverterFeature::AddCompressedImages3D,
         SceneConverterFeature::MeshLevels,
-        SceneConverterFeature::ImageLevels});
+        SceneConverterFeature::ImageLevels,
+        SceneConverterFeature::AddParallel});
 }
 
 Debug& operator<<(Debug& debug, const SceneConverterFlag value) {
@@ -261,7 +261,19 @@ enum class SceneConverterFeature: UnsignedInt {
      * supported.
      * @m_since_latest
      */
-    ImageLevels = 1 << 23
+    ImageLevels = 1 << 23,
+
+    /**
+     * The @ref AbstractSceneConverter::doAdd(UnsignedInt, const MeshData&, Containers::StringView)
+     * and @ref AbstractSceneConverter::doAdd(UnsignedInt, const ImageData2D&, Containers::StringView)
+     * implementations are safe to be called concurrently from multiple
+     * threads for different IDs, making
+     * @ref AbstractSceneConverter::addMeshes() and
+     * @ref AbstractSceneConverter::addImages2D() process the items in
+     * parallel.
+     * @m_since_latest
+     */
+    AddParallel = 1 << 24
 };
 
 /**
@@ -906,6 +918,27 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
          */
         void clearFlags(SceneConverterFlags flags);
 
+        /**
+         * @brief Profiler
+         * @m_since_latest
+         *
+         * @see @ref setProfiler()
+         */
+        Profiler* profiler() const { return _profiler; }
+
+        /**
+         * @brief Set a profiler
+         * @m_since_latest
+         *
+         * If non-null, wall time, input and output data sizes and optionally
+         * peak allocation of profiled calls made on this converter get recorded
+         * into @p profiler. See the @ref Profiler class documentation for a
+         * list of profiled functions. The profiler is expected to outlive
+         * the converter or be reset back to @cpp nullptr @ce before it's
+         * destroyed. By default no profiler is set.
+         */
+        void setProfiler(Profiler* profiler) { _profiler = profiler; }
+
         /**
          * @brief Convert a mesh
          *
@@ -1509,6 +1542,42 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         Containers::Optional<UnsignedInt> add(const Containers::Iterable<const MeshData>& meshLevels);
         #endif
 
+        /**
+         * @brief Add multiple meshes
+         * @param meshes        Meshes to add
+         * @param threadCount   Worker thread count. If @cpp 0 @ce, the count
+         *      is autodetected from available hardware concurrency.
+         * @return ID of the first added mesh, or @ref Containers::NullOpt on
+         *      failure
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref add(const MeshData&, Containers::StringView)
+         * with an empty name for each item in @p meshes, with the IDs being
+         * consecutive and in the same order as @p meshes. Expects that a
+         * conversion is currently in progress and
+         * @ref SceneConverterFeature::AddMeshes is supported.
+         *
+         * If @ref SceneConverterFeature::AddParallel is supported as well,
+         * the meshes are passed to the implementation from @p threadCount
+         * threads including the calling thread, each picking the next
+         * not-yet-added mesh once it's done with the previous one. The
+         * implementation is responsible for placing the output based on the
+         * passed ID, so the result is the same regardless of the order in
+         * which the items get processed. The thread count is capped to the
+         * count of @p meshes. If the feature isn't supported or threads are
+         * not available on the platform, the meshes are added serially on the
+         * calling thread.
+         *
+         * The @ref meshCount() is increased by the count of @p meshes only
+         * once all of them are processed. If adding any of the meshes fails,
+         * the remaining meshes are skipped, @ref abort() is called and
+         * @ref Containers::NullOpt is returned. Error and warning messages
+         * from worker threads are printed to the default output, as
+         * @relativeref{Corrade,Utility::Error} redirection is thread-local.
+         * @see @ref isConverting(), @ref features(), @ref addImages2D()
+         */
+        Containers::Optional<UnsignedInt> addMeshes(const Containers::Iterable<const MeshData>& meshes, UnsignedInt threadCount = 0);
+
         /**
          * @brief Set name of a custom mesh attribute
          * @m_since_latest
@@ -1882,6 +1951,31 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         Containers::Optional<UnsignedInt> add(const Containers::Iterable<const CompressedImageView2D>& imageLevels);
         #endif
 
+        /**
+         * @brief Add multiple 2D images
+         * @param images        Images to add
+         * @param threadCount   Worker thread count. If @cpp 0 @ce, the count
+         *      is autodetected from available hardware concurrency.
+         * @return ID of the first added image, or @ref Containers::NullOpt
+         *      on failure
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref add(const ImageData2D&, Containers::StringView)
+         * with an empty name for each item in @p images, with the IDs being
+         * consecutive and in the same order as @p images. The images are
+         * expected to not have @cpp nullptr @ce data or zero size in any
+         * dimension. Expects that a conversion is currently in progress and
+         * @ref SceneConverterFeature::AddImages2D or
+         * @relativeref{SceneConverterFeature,AddCompressedImages2D} is
+         * supported based on whether each image is compressed.
+         *
+         * Parallelization, ID assignment and failure handling is the same as
+         * in @ref addMeshes(), with the @ref image2DCount() being increased
+         * only once all images are processed.
+         * @see @ref isConverting(), @ref features()
+         */
+        Containers::Optional<UnsignedInt> addImages2D(const Containers::Iterable<const ImageData2D>& images, UnsignedInt threadCount = 0);
+
         /**
          * @brief Count of added 3D images
          * @m_since_latest
@@ -2460,6 +2554,7 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         MAGNUM_TRADE_LOCAL bool addImporterContentsInternal(AbstractImporter& importer, SceneContents contents, bool noLevelsIfUnsupported);
 
         SceneConverterFlags _flags;
+        Profiler* _profiler{};
         Containers::Pointer<State> _state;
 };
 
@@ -2481,7 +2576,7 @@ updated interface string.
 */
 /* Silly indentation to make the string appear in pluginInterface() docs */
 #define MAGNUM_TRADE_ABSTRACTSCENECONVERTER_PLUGIN_INTERFACE /* [interface] */ \
-"cz.mosra.magnum.Trade.AbstractSceneConverter/0.2.2"
+"cz.mosra.magnum.Trade.AbstractSceneConverter/0.2.3"
 /* [interface] */
 
 }}
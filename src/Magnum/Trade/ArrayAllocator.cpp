@@ -25,10 +25,228 @@
 
 #include "ArrayAllocator.h"
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Macros.h> /* CORRADE_THREAD_LOCAL */
+#include <Corrade/Utility/Move.h>
+
 namespace Magnum { namespace Trade {
 
 void ArrayAllocator<char>::deleter(char* const data, std::size_t) {
     deallocate(data);
 }
 
+namespace Implementation {
+
+struct ArrayArenaChunk {
+    /* Count of live allocations from this chunk plus one if the chunk is
+       still held by an arena. The chunk is freed when it reaches zero. Atomic
+       as arrays can be destroyed from any thread. */
+    std::atomic<std::size_t> references;
+    /* Size of the memory following the chunk header and how much of it is
+       used. Modified only by the arena that holds the chunk. */
+    std::size_t size;
+    std::size_t used;
+};
+
+}
+
+namespace {
+
+using Implementation::ArrayArenaChunk;
+
+struct AllocationHeader {
+    /* Null for heap allocations */
+    ArrayArenaChunk* chunk;
+    std::size_t capacity;
+};
+
+static_assert(sizeof(AllocationHeader) == ArrayArenaAllocator<char>::AllocationOffset, "unexpected allocation header size");
+
+constexpr std::size_t ChunkHeaderSize = (sizeof(ArrayArenaChunk) + ArrayArenaAllocator<char>::AllocationOffset - 1)/ArrayArenaAllocator<char>::AllocationOffset*ArrayArenaAllocator<char>::AllocationOffset;
+
+inline AllocationHeader& allocationHeader(char* const array) {
+    return *reinterpret_cast<AllocationHeader*>(array - ArrayArenaAllocator<char>::AllocationOffset);
+}
+
+inline char* chunkData(ArrayArenaChunk* const chunk) {
+    return reinterpret_cast<char*>(chunk) + ChunkHeaderSize;
+}
+
+/* Keeps all arena allocations aligned the same as heap allocations */
+inline std::size_t alignedCapacity(const std::size_t capacity) {
+    return (capacity + ArrayArenaAllocator<char>::AllocationOffset - 1)/ArrayArenaAllocator<char>::AllocationOffset*ArrayArenaAllocator<char>::AllocationOffset;
+}
+
+void releaseChunkReference(ArrayArenaChunk* const chunk) {
+    if(chunk->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    chunk->~ArrayArenaChunk();
+    std::free(chunk);
+}
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+CORRADE_THREAD_LOCAL
+#endif
+ArrayArena* currentArena = nullptr;
+
+}
+
+char* ArrayArenaAllocator<char>::allocate(const std::size_t capacity) {
+    if(ArrayArena* const arena = currentArena)
+        return arena->allocate(capacity);
+
+    char* const memory = static_cast<char*>(std::malloc(capacity + AllocationOffset));
+    CORRADE_INTERNAL_ASSERT(memory);
+    AllocationHeader& header = *reinterpret_cast<AllocationHeader*>(memory);
+    header.chunk = nullptr;
+    header.capacity = capacity;
+    return memory + AllocationOffset;
+}
+
+void ArrayArenaAllocator<char>::reallocate(char*& array, const std::size_t prevSize, const std::size_t newCapacity) {
+    AllocationHeader& header = allocationHeader(array);
+    ArrayArena* const arena = currentArena;
+
+    /* Heap allocation with no arena current, reallocate on the heap */
+    if(!header.chunk && !arena) {
+        char* const memory = static_cast<char*>(std::realloc(array - AllocationOffset, newCapacity + AllocationOffset));
+        CORRADE_INTERNAL_ASSERT(memory);
+        reinterpret_cast<AllocationHeader*>(memory)->capacity = newCapacity;
+        array = memory + AllocationOffset;
+        return;
+    }
+
+    /* The most recent allocation from the current arena, try to grow it
+       without copying */
+    if(header.chunk && arena && arena->growInPlace(header.chunk, array, newCapacity))
+        return;
+
+    /* Otherwise allocate anew (from the current arena, if any), copy the
+       contents and drop the original */
+    char* const newArray = allocate(newCapacity);
+    std::memcpy(newArray, array, prevSize);
+    deleter(array, prevSize);
+    array = newArray;
+}
+
+void ArrayArenaAllocator<char>::deleter(char* const data, std::size_t) {
+    if(!data) return;
+
+    if(ArrayArenaChunk* const chunk = allocationHeader(data).chunk)
+        releaseChunkReference(chunk);
+    else
+        std::free(data - AllocationOffset);
+}
+
+std::size_t ArrayArenaAllocator<char>::grow(char* const array, const std::size_t desired) {
+    /* Same growth strategy as in ArrayAllocator -- double
+       the size for small allocations, grow by 50% for larger */
+    const std::size_t currentInBytes = (array ? capacity(array) : 0) + AllocationOffset;
+    const std::size_t grown = currentInBytes < 64 ? currentInBytes*2 : currentInBytes + currentInBytes/2;
+    return desired > grown - AllocationOffset ? desired : grown - AllocationOffset;
+}
+
+std::size_t ArrayArenaAllocator<char>::capacity(char* const array) {
+    return allocationHeader(array).capacity;
+}
+
+void* ArrayArenaAllocator<char>::base(char* const array) {
+    return array - AllocationOffset;
+}
+
+struct ArrayArena::Mutex {
+    std::mutex mutex;
+};
+
+ArrayArena::ArrayArena(const std::size_t chunkSize): _chunkSize{chunkSize}, _mutex{InPlaceInit} {}
+
+ArrayArena::~ArrayArena() { release(); }
+
+void ArrayArena::release() {
+    std::lock_guard<std::mutex> lock{_mutex->mutex};
+    for(ArrayArenaChunk* const chunk: _chunks)
+        releaseChunkReference(chunk);
+    _chunks = {};
+    _allocatedSize = 0;
+    _reservedSize = 0;
+}
+
+char* ArrayArena::allocate(const std::size_t capacity) {
+    const std::size_t aligned = alignedCapacity(capacity);
+    const std::size_t size = aligned + ArrayArenaAllocator<char>::AllocationOffset;
+
+    std::lock_guard<std::mutex> lock{_mutex->mutex};
+    ArrayArenaChunk* chunk = _chunks.isEmpty() ? nullptr : _chunks.back();
+    if(!chunk || chunk->size - chunk->used < size) {
+        const std::size_t chunkSize = size > _chunkSize ? size : _chunkSize;
+        void* const memory = std::malloc(ChunkHeaderSize + chunkSize);
+        CORRADE_INTERNAL_ASSERT(memory);
+        ArrayArenaChunk* const newChunk = new(memory) ArrayArenaChunk{};
+        newChunk->references.store(1, std::memory_order_relaxed);
+        newChunk->size = chunkSize;
+        newChunk->used = 0;
+        _reservedSize += ChunkHeaderSize + chunkSize;
+        arrayAppend(_chunks, newChunk);
+
+        /* If the allocation doesn't fit into a regular chunk, it gets a
+           dedicated one, and the current chunk stays the last so the space
+           remaining in it is still used for subsequent allocations */
+        if(size > _chunkSize && chunk)
+            Utility::swap(_chunks[_chunks.size() - 2], _chunks.back());
+        chunk = newChunk;
+    }
+
+    char* const memory = chunkData(chunk) + chunk->used;
+    chunk->used += size;
+    chunk->references.fetch_add(1, std::memory_order_relaxed);
+    _allocatedSize += size;
+    if(_allocatedSize > _peakAllocatedSize)
+        _peakAllocatedSize = _allocatedSize;
+
+    AllocationHeader& header = *reinterpret_cast<AllocationHeader*>(memory);
+    header.chunk = chunk;
+    header.capacity = aligned;
+    return memory + ArrayArenaAllocator<char>::AllocationOffset;
+}
+
+bool ArrayArena::growInPlace(ArrayArenaChunk* const chunk, char* const array, const std::size_t capacity) {
+    AllocationHeader& header = allocationHeader(array);
+
+    std::lock_guard<std::mutex> lock{_mutex->mutex};
+
+    /* Only the last allocation from the chunk allocations are made from can
+       be grown */
+    if(_chunks.isEmpty() || _chunks.back() != chunk || array + header.capacity != chunkData(chunk) + chunk->used)
+        return false;
+
+    const std::size_t aligned = alignedCapacity(capacity);
+    if(aligned <= header.capacity) return true;
+
+    const std::size_t extra = aligned - header.capacity;
+    if(chunk->size - chunk->used < extra) return false;
+
+    chunk->used += extra;
+    _allocatedSize += extra;
+    if(_allocatedSize > _peakAllocatedSize)
+        _peakAllocatedSize = _allocatedSize;
+    header.capacity = aligned;
+    return true;
+}
+
+ArrayArenaScope::ArrayArenaScope(ArrayArena* const arena): _previous{currentArena} {
+    if(arena) currentArena = arena;
+}
+
+ArrayArenaScope::~ArrayArenaScope() {
+    currentArena = _previous;
+}
+
+ArrayArena* ArrayArenaScope::current() {
+    return currentArena;
+}
+
 }}
@@ -26,11 +26,12 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Trade::ArrayAllocator
+ * @brief Class @ref Magnum::Trade::ArrayAllocator, @ref Magnum::Trade::ArrayArenaAllocator, @ref Magnum::Trade::ArrayArena, @ref Magnum::Trade::ArrayArenaScope
  * @m_since{2020,06}
  */
 
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Trade/visibility.h"
@@ -46,6 +47,9 @@ the @relativeref{Corrade,Containers::Array} deleter function pointer is defined
 in the @ref Trade library and not in the plugin binary itself, avoiding
 dangling function pointer call when the data array is destructed after the
 plugin has been unloaded. Other than that the behavior is identical.
+
+The allocator is never affected by an @ref ArrayArena, use
+@ref ArrayArenaAllocator for that.
 */
 template<class T> struct ArrayAllocator: Containers::ArrayMallocAllocator<T> {};
 
@@ -55,6 +59,218 @@ template<> struct ArrayAllocator<char>: Containers::ArrayMallocAllocator<char> {
 };
 #endif
 
+/**
+@brief Growable array allocator using an arena if current
+@m_since_latest
+
+Like @ref ArrayAllocator, but if an @ref ArrayArena is made current on the
+calling thread using an @ref ArrayArenaScope or set on an importer via
+@ref AbstractImporter::setArrayArena(), @cpp char @ce arrays are allocated
+from the arena instead of the heap. Reallocations of the most recently
+allocated array are then done in-place without any copy, which makes
+incremental building of @ref MeshData, @ref SceneData and other data using
+@relativeref{Corrade,Containers::arrayAppend()} significantly cheaper. If no
+arena is current, the arrays are allocated on the heap.
+
+The allocation header is different from
+@relativeref{Corrade,Containers::ArrayMallocAllocator}, so the arrays can't be
+passed to @relativeref{Corrade,Containers::arrayAllocatorCast()} or grown with
+other allocators. The @ref ArrayArenaAllocator<char>::deleter() is accepted by
+@ref AbstractImporter the same way as @ref ArrayAllocator<char>::deleter(), so
+the arrays can be returned from importer plugins. See the @ref ArrayArena
+documentation for details. Other types than @cpp char @ce are always allocated
+on the heap, same as with @ref ArrayAllocator.
+*/
+template<class T> struct ArrayArenaAllocator: ArrayAllocator<T> {};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation { struct ArrayArenaChunk; }
+
+template<> struct MAGNUM_TRADE_EXPORT ArrayArenaAllocator<char> {
+    typedef char Type;
+
+    /* Arena chunk pointer (or null if heap-allocated) followed by the
+       capacity. Twice the pointer size, so the data are aligned the same as
+       returned by malloc() on most platforms. */
+    enum: std::size_t {
+        AllocationOffset = 2*sizeof(std::size_t)
+    };
+
+    static char* allocate(std::size_t capacity);
+    static void reallocate(char*& array, std::size_t prevSize, std::size_t newCapacity);
+    static void deleter(char* data, std::size_t size);
+    static std::size_t grow(char* array, std::size_t desired);
+    static std::size_t capacity(char* array);
+    static void* base(char* array);
+};
+#endif
+
+/**
+@brief Arena for growable array allocations
+@m_since_latest
+
+Bump allocator that serves @cpp char @ce allocations done through
+@ref ArrayArenaAllocator while it's made current on a thread using
+@ref ArrayArenaScope, or while it's set on an importer via
+@ref AbstractImporter::setArrayArena(). Memory is taken from the heap in
+chunks of @ref chunkSize() bytes, allocations larger than that get a dedicated
+chunk. Reallocating the most recently allocated array grows it in-place if
+there's enough space left in the chunk, other reallocations copy the data to a
+new allocation.
+
+Individual arrays don't free anything on destruction. Instead, each chunk is
+returned back to the heap at once, when the arena is destroyed or
+@ref release() is called and all arrays allocated from it are destroyed. It's
+thus safe to keep arrays allocated from an arena alive after the arena itself
+is gone, however as long as a single array from a chunk is alive, the whole
+chunk stays allocated.
+
+@snippet MagnumTrade.cpp ArrayArena
+
+Allocations are guarded by a mutex, so the arena can be current on multiple
+threads at once, such as when it's set on an importer with
+@ref ImporterFeature::ThreadSafe that's used with @ref importMeshes() and
+other parallel functions. For the least contention it's however still
+preferable to use a dedicated arena for each thread. The @ref chunkCount(),
+@ref allocatedSize(), @ref peakAllocatedSize() and @ref reservedSize()
+queries aren't synchronized and are not meant to be called while other threads
+are allocating. Arrays allocated from the arena can be destroyed from any
+thread.
+*/
+class MAGNUM_TRADE_EXPORT ArrayArena {
+    public:
+        /**
+         * @brief Constructor
+         * @param chunkSize     Size of a single chunk in bytes
+         *
+         * Doesn't allocate anything until the first allocation is made.
+         */
+        explicit ArrayArena(std::size_t chunkSize = 1024*1024);
+
+        /** @brief Copying is not allowed */
+        ArrayArena(const ArrayArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArena(ArrayArena&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref release().
+         */
+        ~ArrayArena();
+
+        /** @brief Copying is not allowed */
+        ArrayArena& operator=(const ArrayArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArena& operator=(ArrayArena&&) = delete;
+
+        /** @brief Chunk size */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /**
+         * @brief Chunk count
+         *
+         * Count of chunks currently held by the arena.
+         */
+        std::size_t chunkCount() const { return _chunks.size(); }
+
+        /**
+         * @brief Allocated size
+         *
+         * Total byte size of allocations made from chunks currently held by
+         * the arena, including per-allocation headers and space abandoned by
+         * reallocations.
+         * @see @ref peakAllocatedSize(), @ref reservedSize()
+         */
+        std::size_t allocatedSize() const { return _allocatedSize; }
+
+        /**
+         * @brief Peak allocated size
+         *
+         * Maximum value of @ref allocatedSize() since the arena was
+         * constructed, not reset by @ref release().
+         */
+        std::size_t peakAllocatedSize() const { return _peakAllocatedSize; }
+
+        /**
+         * @brief Reserved size
+         *
+         * Total byte size of chunks currently held by the arena.
+         * @see @ref allocatedSize()
+         */
+        std::size_t reservedSize() const { return _reservedSize; }
+
+        /**
+         * @brief Release all chunks
+         *
+         * Chunks that have no live arrays allocated from them are returned to
+         * the heap immediately, the remaining chunks are returned once the
+         * last array allocated from them gets destroyed. Resets
+         * @ref chunkCount(), @ref allocatedSize() and @ref reservedSize() to
+         * @cpp 0 @ce. If the arena is current on some thread, subsequent
+         * allocations are made from newly allocated chunks.
+         */
+        void release();
+
+    private:
+        friend struct ArrayArenaAllocator<char>;
+
+        MAGNUM_TRADE_LOCAL char* allocate(std::size_t size);
+        MAGNUM_TRADE_LOCAL bool growInPlace(Implementation::ArrayArenaChunk* chunk, char* end, std::size_t size);
+
+        struct Mutex;
+
+        std::size_t _chunkSize;
+        std::size_t _allocatedSize{}, _peakAllocatedSize{}, _reservedSize{};
+        Containers::Pointer<Mutex> _mutex;
+        /* The last chunk is the one allocations are made from */
+        Containers::Array<Implementation::ArrayArenaChunk*> _chunks;
+};
+
+/**
+@brief Scope making an array arena current
+@m_since_latest
+
+While alive, @cpp char @ce allocations done through @ref ArrayArenaAllocator on
+the calling thread are served from the arena passed in the constructor. Scopes can
+be nested, the previous arena (or none) is made current again on destruction.
+Passing a @cpp nullptr @ce leaves the currently active arena (if any)
+unchanged, which allows the scope to be put unconditionally into code paths
+where an arena is optional.
+*/
+class MAGNUM_TRADE_EXPORT ArrayArenaScope {
+    public:
+        /** @brief Constructor */
+        explicit ArrayArenaScope(ArrayArena* arena);
+
+        /** @brief Copying is not allowed */
+        ArrayArenaScope(const ArrayArenaScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArenaScope(ArrayArenaScope&&) = delete;
+
+        /** @brief Destructor */
+        ~ArrayArenaScope();
+
+        /** @brief Copying is not allowed */
+        ArrayArenaScope& operator=(const ArrayArenaScope&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayArenaScope& operator=(ArrayArenaScope&&) = delete;
+
+        /**
+         * @brief Arena current on the calling thread
+         *
+         * Returns @cpp nullptr @ce if there's no arena current.
+         */
+        static ArrayArena* current();
+
+    private:
+        ArrayArena* _previous;
+};
+
 }}
 
 #endif
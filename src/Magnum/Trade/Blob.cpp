@@ -0,0 +1,626 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Blob.h"
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade {
+
+Debug& operator<<(Debug& debug, const BlobType value) {
+    const bool packed = debug.immediateFlags() >= Debug::Flag::Packed;
+
+    if(!packed)
+        debug << "Trade::BlobType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case BlobType::v: return debug << (packed ? "" : "::") << Debug::nospace << #v;
+        _c(Mesh)
+        _c(Scene)
+        _c(Material)
+        _c(Image1D)
+        _c(Image2D)
+        _c(Image3D)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << (packed ? "" : "(") << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << (packed ? "" : ")");
+}
+
+namespace {
+
+/* All data arrays in a blob are aligned to this value, which is also the
+   minimal expected alignment of the blob itself */
+constexpr std::size_t BlobAlignment = 8;
+
+constexpr UnsignedByte BlobVersion = 1;
+
+constexpr char BlobEndianness =
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    'L'
+    #else
+    'B'
+    #endif
+    ;
+
+/* All structures are explicitly padded to have the same layout on both 32-
+   and 64-bit platforms, where 64-bit types may have a 4-byte alignment */
+
+struct BlobHeader {
+    char magic[4];
+    UnsignedByte version;
+    char endianness;
+    BlobType type;
+    UnsignedByte padding;
+    UnsignedInt padding2;
+    UnsignedLong size;
+};
+
+static_assert(sizeof(BlobHeader) == 16, "improper size of BlobHeader");
+
+struct MeshBlobHeader {
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+    /* Relative to the index data */
+    UnsignedLong indexOffset;
+    UnsignedInt primitive;
+    /* Zero for non-indexed meshes */
+    UnsignedInt indexType;
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    Short indexStride;
+    UnsignedShort padding;
+};
+
+static_assert(sizeof(MeshBlobHeader) == 64, "improper size of MeshBlobHeader");
+
+struct MeshBlobAttribute {
+    /* Relative to the vertex data */
+    UnsignedLong offset;
+    UnsignedInt format;
+    Int morphTargetId;
+    UnsignedShort name;
+    Short stride;
+    UnsignedShort arraySize;
+    UnsignedShort padding;
+};
+
+static_assert(sizeof(MeshBlobAttribute) == 24, "improper size of MeshBlobAttribute");
+
+struct SceneBlobHeader {
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+    UnsignedLong mappingBound;
+    UnsignedInt fieldCount;
+    UnsignedByte mappingType;
+    UnsignedByte padding[3];
+};
+
+static_assert(sizeof(SceneBlobHeader) == 32, "improper size of SceneBlobHeader");
+
+struct SceneBlobField {
+    UnsignedLong size;
+    /* All offsets are relative to the data */
+    UnsignedLong mappingOffset;
+    UnsignedLong fieldOffset;
+    /* Used only by string fields */
+    UnsignedLong stringOffset;
+    Long mappingStride;
+    /* In bits for bit fields */
+    Long fieldStride;
+    UnsignedInt name;
+    UnsignedShort fieldType;
+    UnsignedShort fieldArraySize;
+    UnsignedByte flags;
+    /* Used only by bit fields */
+    UnsignedByte fieldBitOffset;
+    UnsignedByte padding[6];
+};
+
+static_assert(sizeof(SceneBlobField) == 64, "improper size of SceneBlobField");
+
+struct MaterialBlobHeader {
+    UnsignedLong attributeDataOffset;
+    UnsignedLong layerDataOffset;
+    UnsignedInt types;
+    UnsignedInt attributeCount;
+    UnsignedInt layerCount;
+    UnsignedInt padding;
+};
+
+static_assert(sizeof(MaterialBlobHeader) == 32, "improper size of MaterialBlobHeader");
+
+struct ImageBlobHeader {
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+    Int size[3];
+    UnsignedInt format;
+    /* Used only by uncompressed images */
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    Int alignment;
+    Int rowLength;
+    Int imageHeight;
+    Int skip[3];
+    /* Used only by compressed images */
+    Int compressedBlockSize[3];
+    Int compressedBlockDataSize;
+    UnsignedShort flags;
+    UnsignedByte compressed;
+    UnsignedByte padding[5];
+};
+
+static_assert(sizeof(ImageBlobHeader) == 88, "improper size of ImageBlobHeader");
+
+std::size_t alignBlob(const std::size_t offset) {
+    return (offset + BlobAlignment - 1) & ~(BlobAlignment - 1);
+}
+
+Containers::Array<char> allocateBlob(const BlobType type, const std::size_t size) {
+    /* Zero-initialized so the padding doesn't contain random memory */
+    Containers::Array<char> out{ValueInit, size};
+    BlobHeader& header = *reinterpret_cast<BlobHeader*>(out.data());
+    std::memcpy(header.magic, "MGNB", 4);
+    header.version = BlobVersion;
+    header.endianness = BlobEndianness;
+    header.type = type;
+    header.size = size;
+    return out;
+}
+
+const BlobHeader* checkBlob(const char* const prefix, const Containers::ArrayView<const void> data) {
+    /* Check alignment first so the header isn't read from an unaligned
+       location */
+    if(reinterpret_cast<std::uintptr_t>(data.data()) % BlobAlignment) {
+        Error{} << prefix << "data not aligned to" << BlobAlignment << "bytes";
+        return nullptr;
+    }
+    if(data.size() < sizeof(BlobHeader)) {
+        Error{} << prefix << "expected at least" << sizeof(BlobHeader) << "bytes for a header but got" << data.size();
+        return nullptr;
+    }
+
+    const BlobHeader& header = *static_cast<const BlobHeader*>(data.data());
+    if(std::memcmp(header.magic, "MGNB", 4) != 0) {
+        Error{} << prefix << "invalid header";
+        return nullptr;
+    }
+    if(header.version != BlobVersion) {
+        Error{} << prefix << "unsupported version" << header.version << Debug::nospace << ", expected" << BlobVersion;
+        return nullptr;
+    }
+    if(header.endianness != BlobEndianness) {
+        Error{} << prefix << "expected" << (BlobEndianness == 'L' ? "Little-Endian" : "Big-Endian") << "data";
+        return nullptr;
+    }
+    if(header.size < sizeof(BlobHeader) || header.size % BlobAlignment) {
+        Error{} << prefix << "invalid blob size" << header.size;
+        return nullptr;
+    }
+    if(header.size > data.size()) {
+        Error{} << prefix << "expected" << header.size << "bytes but got only" << data.size();
+        return nullptr;
+    }
+
+    return &header;
+}
+
+template<class T> const T* checkBlob(const char* const prefix, const Containers::ArrayView<const void> data, const BlobType type) {
+    const BlobHeader* const header = checkBlob(prefix, data);
+    if(!header) return nullptr;
+
+    if(header->type != type) {
+        Error{} << prefix << "expected a" << type << "blob but got" << header->type;
+        return nullptr;
+    }
+    if(header->size < sizeof(BlobHeader) + sizeof(T)) {
+        Error{} << prefix << "expected at least" << sizeof(BlobHeader) + sizeof(T) << "bytes for a" << type << "header but got" << header->size;
+        return nullptr;
+    }
+
+    return reinterpret_cast<const T*>(header + 1);
+}
+
+bool checkRange(const char* const prefix, const char* const what, const UnsignedLong offset, const UnsignedLong size, const UnsignedLong blobSize) {
+    if(offset % BlobAlignment) {
+        Error{} << prefix << what << "offset" << offset << "not aligned to" << BlobAlignment << "bytes";
+        return false;
+    }
+    if(offset > blobSize || size > blobSize - offset) {
+        Error{} << prefix << what << "of" << size << "bytes at offset" << offset << "out of bounds for a blob of" << blobSize << "bytes";
+        return false;
+    }
+    return true;
+}
+
+void serializeStorage(ImageBlobHeader& header, const PixelStorage& storage) {
+    header.alignment = storage.alignment();
+    header.rowLength = storage.rowLength();
+    header.imageHeight = storage.imageHeight();
+    for(std::size_t i = 0; i != 3; ++i)
+        header.skip[i] = storage.skip()[i];
+}
+
+void deserializeStorage(PixelStorage& storage, const ImageBlobHeader& header) {
+    storage.setAlignment(header.alignment);
+    storage.setRowLength(header.rowLength);
+    storage.setImageHeight(header.imageHeight);
+    storage.setSkip({header.skip[0], header.skip[1], header.skip[2]});
+}
+
+template<UnsignedInt dimensions> Containers::Optional<Containers::Array<char>> serializeImageBlob(const ImageData<dimensions>& image, const BlobType type) {
+    const std::size_t dataOffset = alignBlob(sizeof(BlobHeader) + sizeof(ImageBlobHeader));
+    const std::size_t size = alignBlob(dataOffset + image.data().size());
+
+    Containers::Array<char> out = allocateBlob(type, size);
+    ImageBlobHeader& header = *reinterpret_cast<ImageBlobHeader*>(out.data() + sizeof(BlobHeader));
+    header.dataOffset = dataOffset;
+    header.dataSize = image.data().size();
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        header.size[i] = image.size()[i];
+    header.flags = UnsignedShort(image.flags());
+
+    if(image.isCompressed()) {
+        const CompressedPixelStorage storage = image.compressedStorage();
+        header.compressed = 1;
+        header.format = UnsignedInt(image.compressedFormat());
+        serializeStorage(header, storage);
+        for(std::size_t i = 0; i != 3; ++i)
+            header.compressedBlockSize[i] = storage.compressedBlockSize()[i];
+        header.compressedBlockDataSize = storage.compressedBlockDataSize();
+    } else {
+        header.format = UnsignedInt(image.format());
+        header.formatExtra = image.formatExtra();
+        header.pixelSize = image.pixelSize();
+        serializeStorage(header, image.storage());
+    }
+
+    Utility::copy(image.data(), out.sliceSize(dataOffset, image.data().size()));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+template<UnsignedInt dimensions> Containers::Optional<ImageData<dimensions>> deserializeImageBlob(const char* const prefix, const Containers::ArrayView<const void> data, const DataFlags dataFlags, const BlobType type) {
+    const ImageBlobHeader* const header = checkBlob<ImageBlobHeader>(prefix, data, type);
+    if(!header || !checkRange(prefix, "image data", header->dataOffset, header->dataSize, static_cast<const BlobHeader*>(data.data())->size))
+        return {};
+
+    const Containers::ArrayView<const char> imageData{static_cast<const char*>(data.data()) + header->dataOffset, std::size_t(header->dataSize)};
+    VectorTypeFor<dimensions, Int> size;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        size[i] = header->size[i];
+    const ImageFlags<dimensions> flags = ImageFlag<dimensions>(header->flags);
+
+    if(header->compressed) {
+        CompressedPixelStorage storage;
+        deserializeStorage(storage, *header);
+        storage.setCompressedBlockSize({header->compressedBlockSize[0], header->compressedBlockSize[1], header->compressedBlockSize[2]});
+        storage.setCompressedBlockDataSize(header->compressedBlockDataSize);
+        return ImageData<dimensions>{storage, CompressedPixelFormat(header->format), size, dataFlags, imageData, flags};
+    }
+
+    PixelStorage storage;
+    deserializeStorage(storage, *header);
+    return ImageData<dimensions>{storage, PixelFormat(header->format), header->formatExtra, header->pixelSize, size, dataFlags, imageData, flags};
+}
+
+}
+
+Containers::Optional<Containers::Pair<BlobType, std::size_t>> blobInfo(const Containers::ArrayView<const void> data) {
+    const BlobHeader* const header = checkBlob("Trade::blobInfo():", data);
+    if(!header) return {};
+
+    if(UnsignedByte(header->type) < UnsignedByte(BlobType::Mesh) ||
+       UnsignedByte(header->type) > UnsignedByte(BlobType::Image3D)) {
+        Error{} << "Trade::blobInfo(): unknown blob type" << header->type;
+        return {};
+    }
+
+    return Containers::pair(header->type, std::size_t(header->size));
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const MeshData& mesh) {
+    const std::size_t attributeOffset = sizeof(BlobHeader) + sizeof(MeshBlobHeader);
+    const std::size_t indexDataOffset = alignBlob(attributeOffset + mesh.attributeCount()*sizeof(MeshBlobAttribute));
+    const std::size_t vertexDataOffset = alignBlob(indexDataOffset + mesh.indexData().size());
+    const std::size_t size = alignBlob(vertexDataOffset + mesh.vertexData().size());
+
+    Containers::Array<char> out = allocateBlob(BlobType::Mesh, size);
+    MeshBlobHeader& header = *reinterpret_cast<MeshBlobHeader*>(out.data() + sizeof(BlobHeader));
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = mesh.indexData().size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = mesh.vertexData().size();
+    header.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        header.indexOffset = mesh.indexOffset();
+        header.indexStride = mesh.indexStride();
+    }
+    header.vertexCount = mesh.vertexCount();
+    header.attributeCount = mesh.attributeCount();
+
+    const Containers::ArrayView<MeshBlobAttribute> attributes = Containers::arrayCast<MeshBlobAttribute>(out.sliceSize(attributeOffset, mesh.attributeCount()*sizeof(MeshBlobAttribute)));
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        MeshBlobAttribute& attribute = attributes[i];
+        /* With no vertices the attribute offset can be anything, including
+           a null pointer, so don't even try to calculate it */
+        if(mesh.vertexCount())
+            attribute.offset = mesh.attributeOffset(i);
+        attribute.format = UnsignedInt(mesh.attributeFormat(i));
+        attribute.morphTargetId = mesh.attributeMorphTargetId(i);
+        attribute.name = UnsignedShort(mesh.attributeName(i));
+        attribute.stride = mesh.attributeStride(i);
+        attribute.arraySize = mesh.attributeArraySize(i);
+    }
+
+    Utility::copy(mesh.indexData(), out.sliceSize(indexDataOffset, mesh.indexData().size()));
+    Utility::copy(mesh.vertexData(), out.sliceSize(vertexDataOffset, mesh.vertexData().size()));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const SceneData& scene) {
+    const Containers::ArrayView<const char> data = scene.data();
+    const std::size_t fieldOffset = sizeof(BlobHeader) + sizeof(SceneBlobHeader);
+    const std::size_t dataOffset = alignBlob(fieldOffset + scene.fieldCount()*sizeof(SceneBlobField));
+    const std::size_t size = alignBlob(dataOffset + data.size());
+
+    Containers::Array<char> out = allocateBlob(BlobType::Scene, size);
+    SceneBlobHeader& header = *reinterpret_cast<SceneBlobHeader*>(out.data() + sizeof(BlobHeader));
+    header.dataOffset = dataOffset;
+    header.dataSize = data.size();
+    header.mappingBound = scene.mappingBound();
+    header.fieldCount = scene.fieldCount();
+    header.mappingType = UnsignedByte(scene.mappingType());
+
+    const Containers::ArrayView<SceneBlobField> fields = Containers::arrayCast<SceneBlobField>(out.sliceSize(fieldOffset, scene.fieldCount()*sizeof(SceneBlobField)));
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        /* Unlike the internal representation, this always contains absolute
+           pointers, with SceneFieldFlag::OffsetOnly removed */
+        const SceneFieldData fieldData = scene.fieldData(i);
+        const SceneFieldType type = fieldData.fieldType();
+        if(type == SceneFieldType::Pointer || type == SceneFieldType::MutablePointer) {
+            Error{} << "Trade::serializeBlob(): can't serialize a" << type << "field" << fieldData.name();
+            return {};
+        }
+
+        SceneBlobField& field = fields[i];
+        field.size = fieldData.size();
+        field.name = UnsignedInt(fieldData.name());
+        field.fieldType = UnsignedShort(type);
+        field.fieldArraySize = fieldData.fieldArraySize();
+        field.flags = UnsignedByte(fieldData.flags());
+
+        /* With no entries the views can point anywhere, including a null
+           pointer, so don't even try to calculate the offsets */
+        if(!fieldData.size()) continue;
+
+        const Containers::StridedArrayView1D<const void> mapping = fieldData.mappingData();
+        field.mappingOffset = static_cast<const char*>(mapping.data()) - data.data();
+        field.mappingStride = mapping.stride();
+        if(type == SceneFieldType::Bit) {
+            const Containers::StridedBitArrayView2D bits = fieldData.fieldBitData();
+            field.fieldOffset = static_cast<const char*>(bits.data()) - data.data();
+            field.fieldBitOffset = bits.offset();
+            field.fieldStride = bits.stride()[0];
+        } else {
+            const Containers::StridedArrayView1D<const void> view = fieldData.fieldData();
+            field.fieldOffset = static_cast<const char*>(view.data()) - data.data();
+            field.fieldStride = view.stride();
+            if(Implementation::isSceneFieldTypeString(type))
+                field.stringOffset = fieldData.stringData() - data.data();
+        }
+    }
+
+    Utility::copy(data, out.sliceSize(dataOffset, data.size()));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const MaterialData& material) {
+    const Containers::ArrayView<const MaterialAttributeData> attributeData = material.attributeData();
+    const Containers::ArrayView<const UnsignedInt> layerData = material.layerData();
+    for(const MaterialAttributeData& attribute: attributeData) {
+        const MaterialAttributeType type = attribute.type();
+        if(type == MaterialAttributeType::Pointer || type == MaterialAttributeType::MutablePointer) {
+            Error{} << "Trade::serializeBlob(): can't serialize a" << type << "attribute" << attribute.name();
+            return {};
+        }
+    }
+
+    const std::size_t attributeDataOffset = alignBlob(sizeof(BlobHeader) + sizeof(MaterialBlobHeader));
+    const std::size_t layerDataOffset = alignBlob(attributeDataOffset + attributeData.size()*sizeof(MaterialAttributeData));
+    const std::size_t size = alignBlob(layerDataOffset + layerData.size()*sizeof(UnsignedInt));
+
+    Containers::Array<char> out = allocateBlob(BlobType::Material, size);
+    MaterialBlobHeader& header = *reinterpret_cast<MaterialBlobHeader*>(out.data() + sizeof(BlobHeader));
+    header.attributeDataOffset = attributeDataOffset;
+    header.layerDataOffset = layerDataOffset;
+    header.types = UnsignedInt(material.types());
+    header.attributeCount = attributeData.size();
+    header.layerCount = layerData.size();
+
+    /* The attributes are self-contained 64-byte values with no pointers to
+       external memory, so they can be copied directly */
+    if(!attributeData.isEmpty())
+        std::memcpy(out.data() + attributeDataOffset, attributeData.data(), attributeData.size()*sizeof(MaterialAttributeData));
+    if(!layerData.isEmpty())
+        std::memcpy(out.data() + layerDataOffset, layerData.data(), layerData.size()*sizeof(UnsignedInt));
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData1D& image) {
+    return serializeImageBlob(image, BlobType::Image1D);
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData2D& image) {
+    return serializeImageBlob(image, BlobType::Image2D);
+}
+
+Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData3D& image) {
+    return serializeImageBlob(image, BlobType::Image3D);
+}
+
+Containers::Optional<MeshData> deserializeMeshBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeMeshBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+
+    constexpr const char* prefix = "Trade::deserializeMeshBlob():";
+    const MeshBlobHeader* const header = checkBlob<MeshBlobHeader>(prefix, data, BlobType::Mesh);
+    if(!header) return {};
+
+    const char* const blob = static_cast<const char*>(data.data());
+    const UnsignedLong blobSize = reinterpret_cast<const BlobHeader*>(blob)->size;
+    const std::size_t attributeOffset = sizeof(BlobHeader) + sizeof(MeshBlobHeader);
+    if(!checkRange(prefix, "attribute data", attributeOffset, UnsignedLong{header->attributeCount}*sizeof(MeshBlobAttribute), blobSize) ||
+       !checkRange(prefix, "index data", header->indexDataOffset, header->indexDataSize, blobSize) ||
+       !checkRange(prefix, "vertex data", header->vertexDataOffset, header->vertexDataSize, blobSize))
+        return {};
+
+    const Containers::ArrayView<const char> indexData{blob + header->indexDataOffset, std::size_t(header->indexDataSize)};
+    const Containers::ArrayView<const char> vertexData{blob + header->vertexDataOffset, std::size_t(header->vertexDataSize)};
+
+    MeshIndexData indices;
+    if(header->indexType)
+        indices = MeshIndexData{MeshIndexType(header->indexType), Containers::StridedArrayView1D<const void>{indexData, indexData.data() + header->indexOffset, header->indexCount, header->indexStride}};
+
+    /* Only the attribute metadata are allocated, all of them are offset-only
+       and point into the vertex data. Using ValueInit so the array has a
+       default deleter and isn't problematic to use in plugins. */
+    const MeshBlobAttribute* const blobAttributes = reinterpret_cast<const MeshBlobAttribute*>(blob + attributeOffset);
+    Containers::Array<MeshAttributeData> attributes{ValueInit, header->attributeCount};
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const MeshBlobAttribute& attribute = blobAttributes[i];
+        attributes[i] = MeshAttributeData{MeshAttribute(attribute.name), VertexFormat(attribute.format), std::size_t(attribute.offset), header->vertexCount, attribute.stride, attribute.arraySize, attribute.morphTargetId};
+    }
+
+    return MeshData{MeshPrimitive(header->primitive),
+        dataFlags, indexData, indices,
+        dataFlags, vertexData, Utility::move(attributes),
+        header->vertexCount};
+}
+
+Containers::Optional<SceneData> deserializeSceneBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeSceneBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+
+    constexpr const char* prefix = "Trade::deserializeSceneBlob():";
+    const SceneBlobHeader* const header = checkBlob<SceneBlobHeader>(prefix, data, BlobType::Scene);
+    if(!header) return {};
+
+    const char* const blob = static_cast<const char*>(data.data());
+    const UnsignedLong blobSize = reinterpret_cast<const BlobHeader*>(blob)->size;
+    const std::size_t fieldOffset = sizeof(BlobHeader) + sizeof(SceneBlobHeader);
+    if(!checkRange(prefix, "field data", fieldOffset, UnsignedLong{header->fieldCount}*sizeof(SceneBlobField), blobSize) ||
+       !checkRange(prefix, "data", header->dataOffset, header->dataSize, blobSize))
+        return {};
+
+    /* Only the field metadata are allocated, all of them are offset-only and
+       point into the data. Using ValueInit so the array has a default
+       deleter and isn't problematic to use in plugins. */
+    const SceneMappingType mappingType = SceneMappingType(header->mappingType);
+    const SceneBlobField* const blobFields = reinterpret_cast<const SceneBlobField*>(blob + fieldOffset);
+    Containers::Array<SceneFieldData> fields{ValueInit, header->fieldCount};
+    for(std::size_t i = 0; i != fields.size(); ++i) {
+        const SceneBlobField& field = blobFields[i];
+        const SceneField name = SceneField(field.name);
+        const SceneFieldType type = SceneFieldType(field.fieldType);
+        const SceneFieldFlags flags = SceneFieldFlag(field.flags);
+        if(type == SceneFieldType::Bit)
+            fields[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), std::size_t(field.fieldOffset), std::size_t(field.fieldBitOffset), std::ptrdiff_t(field.fieldStride), field.fieldArraySize, flags};
+        else if(Implementation::isSceneFieldTypeString(type))
+            fields[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), std::size_t(field.stringOffset), type, std::size_t(field.fieldOffset), std::ptrdiff_t(field.fieldStride), flags};
+        else
+            fields[i] = SceneFieldData{name, std::size_t(field.size), mappingType, std::size_t(field.mappingOffset), std::ptrdiff_t(field.mappingStride), type, std::size_t(field.fieldOffset), std::ptrdiff_t(field.fieldStride), field.fieldArraySize, flags};
+    }
+
+    return SceneData{mappingType, header->mappingBound, dataFlags,
+        Containers::ArrayView<const char>{blob + header->dataOffset, std::size_t(header->dataSize)},
+        Utility::move(fields)};
+}
+
+Containers::Optional<MaterialData> deserializeMaterialBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeMaterialBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+
+    constexpr const char* prefix = "Trade::deserializeMaterialBlob():";
+    const MaterialBlobHeader* const header = checkBlob<MaterialBlobHeader>(prefix, data, BlobType::Material);
+    if(!header) return {};
+
+    const char* const blob = static_cast<const char*>(data.data());
+    const UnsignedLong blobSize = reinterpret_cast<const BlobHeader*>(blob)->size;
+    if(!checkRange(prefix, "attribute data", header->attributeDataOffset, UnsignedLong{header->attributeCount}*sizeof(MaterialAttributeData), blobSize) ||
+       !checkRange(prefix, "layer data", header->layerDataOffset, UnsignedLong{header->layerCount}*sizeof(UnsignedInt), blobSize))
+        return {};
+
+    /* As opposed to meshes and scenes, there's nothing to allocate here */
+    return MaterialData{MaterialType(header->types),
+        dataFlags, {reinterpret_cast<const MaterialAttributeData*>(blob + header->attributeDataOffset), header->attributeCount},
+        dataFlags, {reinterpret_cast<const UnsignedInt*>(blob + header->layerDataOffset), header->layerCount}};
+}
+
+Containers::Optional<ImageData1D> deserializeImage1DBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeImage1DBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+    return deserializeImageBlob<1>("Trade::deserializeImage1DBlob():", data, dataFlags, BlobType::Image1D);
+}
+
+Containers::Optional<ImageData2D> deserializeImage2DBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeImage2DBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+    return deserializeImageBlob<2>("Trade::deserializeImage2DBlob():", data, dataFlags, BlobType::Image2D);
+}
+
+Containers::Optional<ImageData3D> deserializeImage3DBlob(const Containers::ArrayView<const void> data, const DataFlags dataFlags) {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::deserializeImage3DBlob(): can't deserialize with" << (dataFlags & DataFlag::Owned), {});
+    return deserializeImageBlob<3>("Trade::deserializeImage3DBlob():", data, dataFlags, BlobType::Image3D);
+}
+
+}}
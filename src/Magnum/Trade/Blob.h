@@ -0,0 +1,285 @@
+#ifndef Magnum_Trade_Blob_h
+#define Magnum_Trade_Blob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::Trade::BlobType, function @ref Magnum::Trade::blobInfo(), @ref Magnum::Trade::serializeBlob(), @ref Magnum::Trade::deserializeMeshBlob(), @ref Magnum::Trade::deserializeSceneBlob(), @ref Magnum::Trade::deserializeMaterialBlob(), @ref Magnum::Trade::deserializeImage1DBlob(), @ref Magnum::Trade::deserializeImage2DBlob(), @ref Magnum::Trade::deserializeImage3DBlob()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Data.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Blob type
+@m_since_latest
+
+@see @ref blobInfo(), @ref serializeBlob()
+*/
+enum class BlobType: UnsignedByte {
+    /* Zero reserved for an invalid value */
+
+    /** Mesh, deserialized with @ref deserializeMeshBlob() */
+    Mesh = 1,
+
+    /** Scene, deserialized with @ref deserializeSceneBlob() */
+    Scene,
+
+    /** Material, deserialized with @ref deserializeMaterialBlob() */
+    Material,
+
+    /** 1D image, deserialized with @ref deserializeImage1DBlob() */
+    Image1D,
+
+    /** 2D image, deserialized with @ref deserializeImage2DBlob() */
+    Image2D,
+
+    /** 3D image, deserialized with @ref deserializeImage3DBlob() */
+    Image3D
+};
+
+/**
+@debugoperatorenum{BlobType}
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, BlobType value);
+
+/**
+@brief Blob type and size
+@m_since_latest
+
+Checks the header at the beginning of @p data and returns the blob type and
+its total size in bytes, including header and padding. The size is always a
+multiple of 8, so if multiple blobs are concatenated together, the next blob
+starts right at given size and is suitably aligned. Prints a message to
+@relativeref{Magnum,Error} and returns @relativeref{Corrade,Containers::NullOpt}
+if the header is invalid, the blob was serialized on a platform with different
+endianness or @p data isn't large enough to contain the whole blob.
+@see @ref Trade-serializeBlob-format
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Pair<BlobType, std::size_t>> blobInfo(Containers::ArrayView<const void> data);
+
+/**
+@brief Serialize a mesh into a blob
+@m_since_latest
+
+The output contains a header describing the mesh and its attributes, followed
+by the whole @ref MeshData::indexData() and @ref MeshData::vertexData() arrays
+copied as-is, so the serialization is just a few copies with no per-element
+processing. Names, @ref MeshData::importerState() and data flags are not
+preserved. Deserialize the output with @ref deserializeMeshBlob().
+
+@section Trade-serializeBlob-format Blob format
+
+All data in a blob are stored in the native endianness, there's no attempt at
+portability between platforms with different endianness. Each blob starts
+with a 16-byte header:
+
+-   4 bytes with the `MGNB` magic,
+-   a 8-bit format version, currently @cpp 1 @ce,
+-   a 8-bit endianness marker, @cpp 'L' @ce for Little-Endian and
+    @cpp 'B' @ce for Big-Endian,
+-   a 8-bit @ref BlobType,
+-   a 8-bit padding,
+-   a 32-bit padding,
+-   a 64-bit total blob size in bytes, including the header and padding at
+    the end. It's always a multiple of 8.
+
+The header is followed by a type-specific fixed-size description of the data,
+for example a mesh primitive, index type and counts, followed by a
+variable-length list of attribute, field or layer descriptions. All data
+arrays are then placed at offsets aligned to 8 bytes, with all positions
+stored as offsets relative to the blob start or to the data array. Thus, as
+long as the blob is loaded to a 8-byte-aligned location, such as by
+memory-mapping a file, the deserialization is just a matter of creating a few
+views on top of the blob memory, without any parsing or copying.
+@see @ref serializeBlob(const SceneData&),
+    @ref serializeBlob(const MaterialData&),
+    @ref serializeBlob(const ImageData1D&),
+    @ref serializeBlob(const ImageData2D&),
+    @ref serializeBlob(const ImageData3D&)
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const MeshData& mesh);
+
+/**
+@brief Serialize a scene into a blob
+@m_since_latest
+
+The output contains a header describing the scene and its fields, followed by
+the whole @ref SceneData::data() array copied as-is. Fields of
+@ref SceneFieldType::Pointer and @relativeref{SceneFieldType,MutablePointer}
+type can't be serialized, in which case the function prints a message to
+@relativeref{Magnum,Error} and returns @relativeref{Corrade,Containers::NullOpt}.
+Object names, @ref SceneData::importerState() and data flags are not
+preserved. Deserialize the output with @ref deserializeSceneBlob(). See
+@ref Trade-serializeBlob-format for details about the format.
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const SceneData& scene);
+
+/**
+@brief Serialize a material into a blob
+@m_since_latest
+
+The output contains a header, followed by the @ref MaterialData::attributeData()
+and @ref MaterialData::layerData() arrays copied as-is. Attributes of
+@ref MaterialAttributeType::Pointer and
+@relativeref{MaterialAttributeType,MutablePointer} type can't be serialized,
+in which case the function prints a message to @relativeref{Magnum,Error} and
+returns @relativeref{Corrade,Containers::NullOpt}. Name,
+@ref MaterialData::importerState() and data flags are not preserved.
+Deserialize the output with @ref deserializeMaterialBlob(). See
+@ref Trade-serializeBlob-format for details about the format.
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const MaterialData& material);
+
+/**
+@brief Serialize a 1D image into a blob
+@m_since_latest
+
+The output contains a header describing the image format, size, flags and
+@ref PixelStorage or @ref CompressedPixelStorage parameters, followed by the
+whole @ref ImageData::data() array copied as-is. Both compressed and
+uncompressed images are supported. Name, @ref ImageData::importerState() and
+data flags are not preserved. Deserialize the output with
+@ref deserializeImage1DBlob(). See @ref Trade-serializeBlob-format for details
+about the format.
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData1D& image);
+
+/**
+@brief Serialize a 2D image into a blob
+@m_since_latest
+
+Like @ref serializeBlob(const ImageData1D&), but for 2D images. Deserialize
+the output with @ref deserializeImage2DBlob().
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData2D& image);
+
+/**
+@brief Serialize a 3D image into a blob
+@m_since_latest
+
+Like @ref serializeBlob(const ImageData1D&), but for 3D images. Deserialize
+the output with @ref deserializeImage3DBlob().
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> serializeBlob(const ImageData3D& image);
+
+/**
+@brief Deserialize a mesh from a blob
+@param data         Blob data
+@param dataFlags    Flags for the returned index and vertex data
+@m_since_latest
+
+Expects that @p data is a blob produced by @ref serializeBlob(const MeshData&),
+aligned to 8 bytes. Returns a @ref MeshData with index and vertex data
+referencing @p data directly, with no copies involved. The @p dataFlags are
+used as @ref MeshData::indexDataFlags() and
+@relativeref{MeshData,vertexDataFlags()} and are expected to not contain
+@ref DataFlag::Owned --- pass for example @ref DataFlag::ExternallyOwned if
+@p data is a memory-mapped file, and add @ref DataFlag::Mutable if the memory
+can be modified. Only the attribute metadata are allocated.
+
+If @p data isn't a valid mesh blob, is not aligned or any of the described
+arrays is out of the blob bounds, prints a message to
+@relativeref{Magnum,Error} and returns @relativeref{Corrade,Containers::NullOpt}.
+Contents of the blob beyond that aren't verified, passing a corrupted blob may
+lead to assertions in the @ref MeshData constructor.
+@see @ref blobInfo()
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<MeshData> deserializeMeshBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+/**
+@brief Deserialize a scene from a blob
+@param data         Blob data
+@param dataFlags    Flags for the returned data
+@m_since_latest
+
+Expects that @p data is a blob produced by @ref serializeBlob(const SceneData&),
+aligned to 8 bytes. Returns a @ref SceneData with data referencing @p data
+directly and all fields being offset-only. Only the field metadata are
+allocated. The @p dataFlags have the same semantics as in
+@ref deserializeMeshBlob(), error handling is the same as well.
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<SceneData> deserializeSceneBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+/**
+@brief Deserialize a material from a blob
+@param data         Blob data
+@param dataFlags    Flags for the returned attribute and layer data
+@m_since_latest
+
+Expects that @p data is a blob produced by @ref serializeBlob(const MaterialData&),
+aligned to 8 bytes. Returns a @ref MaterialData with attribute and layer data
+referencing @p data directly, with no allocations involved. The @p dataFlags
+have the same semantics as in @ref deserializeMeshBlob(), error handling is
+the same as well.
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<MaterialData> deserializeMaterialBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+/**
+@brief Deserialize a 1D image from a blob
+@param data         Blob data
+@param dataFlags    Flags for the returned image data
+@m_since_latest
+
+Expects that @p data is a blob produced by @ref serializeBlob(const ImageData1D&),
+aligned to 8 bytes. Returns an @ref ImageData with data referencing @p data
+directly, with no allocations involved. The @p dataFlags have the same
+semantics as in @ref deserializeMeshBlob(), error handling is the same as
+well.
+@see @ref deserializeImage2DBlob(), @ref deserializeImage3DBlob()
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<ImageData1D> deserializeImage1DBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+/**
+@brief Deserialize a 2D image from a blob
+@m_since_latest
+
+Like @ref deserializeImage1DBlob(), but for a blob produced by
+@ref serializeBlob(const ImageData2D&).
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<ImageData2D> deserializeImage2DBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+/**
+@brief Deserialize a 3D image from a blob
+@m_since_latest
+
+Like @ref deserializeImage1DBlob(), but for a blob produced by
+@ref serializeBlob(const ImageData3D&).
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<ImageData3D> deserializeImage3DBlob(Containers::ArrayView<const void> data, DataFlags dataFlags = {});
+
+}}
+
+#endif
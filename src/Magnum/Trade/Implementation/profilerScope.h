@@ -0,0 +1,74 @@
+#ifndef Magnum_Trade_Implementation_profilerScope_h
+#define Magnum_Trade_Implementation_profilerScope_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Trade/Profiler.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Records a profiled call into a Profiler on destruction. Does nothing if
+   the profiler is null, so it can be put unconditionally into all profiled
+   functions. */
+struct ProfilerScope {
+    explicit ProfilerScope(Profiler* const profiler, const char* const function, const Containers::StringView plugin, const UnsignedInt id = ~UnsignedInt{}, const std::size_t bytesIn = 0): _profiler{profiler} {
+        if(!_profiler) return;
+
+        _record.function = function;
+        _record.plugin = Containers::String{plugin};
+        _record.id = id;
+        _record.bytesIn = bytesIn;
+        /* Reset the peak allocation counter first so the callback itself
+           isn't included in the time */
+        _profiler->peakAllocation();
+        _record.begin = _profiler->time();
+    }
+
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+    ~ProfilerScope() {
+        if(!_profiler) return;
+
+        _record.duration = _profiler->time() - _record.begin;
+        _record.peakAllocation = _profiler->peakAllocation();
+        _profiler->addRecord(Utility::move(_record));
+    }
+
+    void setBytesOut(const std::size_t bytes) {
+        _record.bytesOut = bytes;
+    }
+
+    private:
+        Profiler* _profiler;
+        ProfilerRecord _record{};
+};
+
+}}}
+
+#endif
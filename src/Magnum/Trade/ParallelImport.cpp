@@ -0,0 +1,137 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParallelImport.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+template<class T, class Import> Containers::Array<Containers::Optional<T>> importParallel(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount, Import import) {
+    Containers::Array<Containers::Optional<T>> out{ids.size()};
+
+    /* Each thread picks the next ID once it's done with the previous one,
+       which balances the load better than splitting the IDs into fixed-size
+       chunks upfront, as the items can vary wildly in size */
+    Magnum::Implementation::parallelFor(ids.size(),
+        importer.features() & ImporterFeature::ThreadSafe ?
+            Magnum::Implementation::threadCount(threadCount) : 1,
+        [&](const std::size_t i) {
+            out[i] = import(ids[i]);
+        });
+
+    return out;
+}
+
+}
+
+Containers::Array<Containers::Optional<MeshData>> importMeshes(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::importMeshes(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.meshCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::importMeshes(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return importParallel<MeshData>(importer, ids, threadCount, [&importer](UnsignedInt id) {
+        return importer.mesh(id);
+    });
+}
+
+Containers::Array<Containers::Optional<MaterialData>> importMaterials(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::importMaterials(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.materialCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::importMaterials(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return importParallel<MaterialData>(importer, ids, threadCount, [&importer](UnsignedInt id) {
+        /* The importer returns a type that's convertible to both
+           Optional<MaterialData> and (deprecated) Pointer<MaterialData>,
+           convert explicitly */
+        return Containers::Optional<MaterialData>{importer.material(id)};
+    });
+}
+
+Containers::Array<Containers::Optional<ImageData1D>> importImages1D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::importImages1D(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.image1DCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::importImages1D(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return importParallel<ImageData1D>(importer, ids, threadCount, [&importer](UnsignedInt id) {
+        return importer.image1D(id);
+    });
+}
+
+Containers::Array<Containers::Optional<ImageData2D>> importImages2D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::importImages2D(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.image2DCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::importImages2D(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return importParallel<ImageData2D>(importer, ids, threadCount, [&importer](UnsignedInt id) {
+        return importer.image2D(id);
+    });
+}
+
+Containers::Array<Containers::Optional<ImageData3D>> importImages3D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::importImages3D(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt count = importer.image3DCount();
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < count,
+            "Trade::importImages3D(): index" << id << "out of range for" << count << "entries", {});
+    #endif
+
+    return importParallel<ImageData3D>(importer, ids, threadCount, [&importer](UnsignedInt id) {
+        return importer.image3D(id);
+    });
+}
+
+}}
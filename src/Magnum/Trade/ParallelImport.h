@@ -0,0 +1,114 @@
+#ifndef Magnum_Trade_ParallelImport_h
+#define Magnum_Trade_ParallelImport_h
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::importMeshes(), @ref Magnum::Trade::importMaterials(), @ref Magnum::Trade::importImages1D(), @ref Magnum::Trade::importImages2D(), @ref Magnum::Trade::importImages3D()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Import multiple meshes in parallel
+@param importer     Importer with a file opened
+@param ids          Mesh IDs to import
+@param threadCount  Worker thread count. If @cpp 0 @ce, the count is
+    autodetected from available hardware concurrency.
+@return Imported meshes in the same order as @p ids, failed imports are
+    @relativeref{Corrade,Containers::NullOpt}
+@m_since_latest
+
+If @p importer supports @ref ImporterFeature::ThreadSafe, the meshes are
+imported using @ref AbstractImporter::mesh() from @p threadCount threads
+including the calling thread, each thread picking the next not-yet-imported
+ID once it's done with the previous one. The thread count is capped to the
+count of @p ids. If the feature isn't supported or threads are not available
+on the platform, the meshes are imported serially on the calling thread.
+
+@snippet MagnumTrade.cpp importMeshes
+
+The @p importer is expected to have a file opened and all @p ids are expected
+to be in range for @ref AbstractImporter::meshCount(). Error and warning
+messages from worker threads are printed to the default output, as
+@relativeref{Corrade,Utility::Error} redirection is thread-local.
+@see @ref importMaterials(), @ref importImages2D()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<MeshData>> importMeshes(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, UnsignedInt threadCount = 0);
+
+/**
+@brief Import multiple materials in parallel
+@m_since_latest
+
+Like @ref importMeshes(), but using @ref AbstractImporter::material(). All
+@p ids are expected to be in range for @ref AbstractImporter::materialCount().
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<MaterialData>> importMaterials(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, UnsignedInt threadCount = 0);
+
+/**
+@brief Import multiple 1D images in parallel
+@m_since_latest
+
+Like @ref importMeshes(), but using @ref AbstractImporter::image1D() to
+import the first level of each image. All @p ids are expected to be in range
+for @ref AbstractImporter::image1DCount().
+@see @ref importImages2D(), @ref importImages3D()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<ImageData1D>> importImages1D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, UnsignedInt threadCount = 0);
+
+/**
+@brief Import multiple 2D images in parallel
+@m_since_latest
+
+Like @ref importMeshes(), but using @ref AbstractImporter::image2D() to
+import the first level of each image. All @p ids are expected to be in range
+for @ref AbstractImporter::image2DCount().
+@see @ref importImages1D(), @ref importImages3D()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<ImageData2D>> importImages2D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, UnsignedInt threadCount = 0);
+
+/**
+@brief Import multiple 3D images in parallel
+@m_since_latest
+
+Like @ref importMeshes(), but using @ref AbstractImporter::image3D() to
+import the first level of each image. All @p ids are expected to be in range
+for @ref AbstractImporter::image3DCount().
+@see @ref importImages1D(), @ref importImages2D()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<Containers::Optional<ImageData3D>> importImages3D(AbstractImporter& importer, const Containers::StridedArrayView1D<const UnsignedInt>& ids, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
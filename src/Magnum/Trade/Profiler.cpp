@@ -0,0 +1,134 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+#include "Profiler.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Move.h>
+
+namespace Magnum { namespace Trade {
+
+struct Profiler::State {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t(*peakAllocationCallback)(void*){};
+    void* peakAllocationUserData{};
+
+    std::mutex mutex;
+    Containers::Array<std::thread::id> threads;
+    Containers::Array<ProfilerRecord> records;
+};
+
+Profiler::Profiler(): _state{InPlaceInit} {}
+
+Profiler::~Profiler() = default;
+
+void Profiler::setPeakAllocationCallback(std::size_t(*const callback)(void*), void* const userData) {
+    _state->peakAllocationCallback = callback;
+    _state->peakAllocationUserData = userData;
+}
+
+UnsignedLong Profiler::time() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _state->start).count();
+}
+
+std::size_t Profiler::peakAllocation() const {
+    return _state->peakAllocationCallback ? _state->peakAllocationCallback(_state->peakAllocationUserData) : 0;
+}
+
+void Profiler::addRecord(ProfilerRecord&& record) {
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    /* There's usually just a handful of threads, a linear search is fine */
+    std::size_t thread = 0;
+    for(; thread != _state->threads.size(); ++thread)
+        if(_state->threads[thread] == threadId) break;
+    if(thread == _state->threads.size())
+        arrayAppend(_state->threads, threadId);
+
+    record.thread = UnsignedInt(thread);
+    arrayAppend(_state->records, Utility::move(record));
+}
+
+Containers::ArrayView<const ProfilerRecord> Profiler::records() const {
+    return _state->records;
+}
+
+void Profiler::clear() {
+    arrayClear(_state->records);
+}
+
+namespace {
+
+void appendJsonString(Containers::Array<char>& out, const Containers::StringView string) {
+    arrayAppend(out, '"');
+    for(const char c: string) {
+        if(c == '"' || c == '\\') {
+            arrayAppend(out, '\\');
+            arrayAppend(out, c);
+        } else if(UnsignedByte(c) < 0x20) {
+            constexpr const char Hex[]{"0123456789abcdef"};
+            arrayAppend(out, Containers::arrayView({'\\', 'u', '0', '0', Hex[c >> 4], Hex[c & 0xf]}));
+        } else arrayAppend(out, c);
+    }
+    arrayAppend(out, '"');
+}
+
+}
+
+Containers::String Profiler::chromeTrace() const {
+    using namespace Containers::Literals;
+
+    Containers::Array<char> out;
+    arrayAppend(out, "{\"traceEvents\":["_s);
+    for(std::size_t i = 0; i != _state->records.size(); ++i) {
+        const ProfilerRecord& record = _state->records[i];
+        if(i) arrayAppend(out, ',');
+        arrayAppend(out, "\n{\"name\":"_s);
+        appendJsonString(out, record.function);
+        arrayAppend(out, ",\"cat\":"_s);
+        appendJsonString(out, record.plugin.isEmpty() ? "Magnum"_s : Containers::StringView{record.plugin});
+        /* Timestamps are in microseconds */
+        arrayAppend(out, Containers::StringView{Utility::format(
+            ",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{",
+            record.thread, record.begin/1000.0, record.duration/1000.0)});
+        if(record.id != ~UnsignedInt{})
+            arrayAppend(out, Containers::StringView{Utility::format("\"id\":{},", record.id)});
+        arrayAppend(out, Containers::StringView{Utility::format(
+            "\"bytesIn\":{},\"bytesOut\":{},\"peakAllocation\":{}}}}}",
+            record.bytesIn, record.bytesOut, record.peakAllocation)});
+    }
+    arrayAppend(out, "\n]}\n"_s);
+
+    return Containers::String{out.data(), out.size()};
+}
+
+}}
@@ -0,0 +1,277 @@
+#ifndef Magnum_Trade_Profiler_h
+#define Magnum_Trade_Profiler_h
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+
+/** @file
+ * @brief Class @ref Magnum::Trade::Profiler, struct @ref Magnum::Trade::ProfilerRecord
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Profiler record
+@m_since_latest
+
+@see @ref Profiler::records()
+*/
+struct ProfilerRecord {
+    /**
+     * @brief Profiled function name
+     *
+     * Such as @cpp "Trade::AbstractImporter::mesh()" @ce. Global,
+     * null-terminated string.
+     */
+    const char* function;
+
+    /**
+     * @brief Plugin name
+     *
+     * Name of the plugin the record comes from, as returned by
+     * @relativeref{Corrade,PluginManager::AbstractPlugin::plugin()}. Empty if
+     * the plugin wasn't instantiated through a plugin manager.
+     */
+    Containers::String plugin;
+
+    /**
+     * @brief Data ID
+     *
+     * ID of the mesh, image or other data passed to the profiled function,
+     * @cpp 0xffffffffu @ce if the function doesn't operate on a particular
+     * ID, such as @ref AbstractImporter::openData().
+     */
+    UnsignedInt id;
+
+    /**
+     * @brief Thread index
+     *
+     * Index of the thread the call was made from, assigned sequentially in
+     * order threads first made a profiled call. Useful for distinguishing
+     * calls made with @ref importMeshes() and other parallel functions.
+     */
+    UnsignedInt thread;
+
+    /** @brief Call start in nanoseconds since the profiler was created */
+    UnsignedLong begin;
+
+    /** @brief Call duration in nanoseconds */
+    UnsignedLong duration;
+
+    /**
+     * @brief Input size in bytes
+     *
+     * Size of the data passed to the function, such as the file data in
+     * @ref AbstractImporter::openData() or the image data in
+     * @ref AbstractImageConverter::convert(). @cpp 0 @ce if not applicable
+     * or not known.
+     */
+    std::size_t bytesIn;
+
+    /**
+     * @brief Output size in bytes
+     *
+     * Size of the data returned from the function, such as vertex and index
+     * data of a @ref MeshData returned from @ref AbstractImporter::mesh().
+     * @cpp 0 @ce if the call failed, if not applicable or not known.
+     */
+    std::size_t bytesOut;
+
+    /**
+     * @brief Peak allocation in bytes
+     *
+     * Value returned from the callback passed to
+     * @ref Profiler::setPeakAllocationCallback() at the end of the call,
+     * @cpp 0 @ce if no callback is set.
+     */
+    std::size_t peakAllocation;
+};
+
+/**
+@brief Profiler for importer and converter plugin calls
+@m_since_latest
+
+Records wall time, input and output data sizes and optionally peak
+allocation of individual calls to @ref AbstractImporter,
+@ref AbstractImageConverter and @ref AbstractSceneConverter instances it's
+set on using @ref AbstractImporter::setProfiler(),
+@ref AbstractImageConverter::setProfiler() and
+@ref AbstractSceneConverter::setProfiler(). A single profiler can be shared
+among multiple plugin instances to get a combined timeline. Records can be
+queried with @ref records() or exported to a Chrome trace with
+@ref chromeTrace():
+
+@snippet MagnumTrade.cpp Profiler
+
+The following calls are profiled:
+
+-   @ref AbstractImporter::openData(),
+    @relativeref{AbstractImporter,openMemory()},
+    @relativeref{AbstractImporter,openFile()},
+    @relativeref{AbstractImporter,scene()},
+    @relativeref{AbstractImporter,animation()},
+    @relativeref{AbstractImporter,mesh()},
+    @relativeref{AbstractImporter,material()},
+    @relativeref{AbstractImporter,image1D()},
+    @relativeref{AbstractImporter,image2D()} and
+    @relativeref{AbstractImporter,image3D()}
+-   all @ref AbstractImageConverter::convert(),
+    @relativeref{AbstractImageConverter,convertToData()} and
+    @relativeref{AbstractImageConverter,convertToFile()} overloads
+-   @ref AbstractSceneConverter::convert(),
+    @relativeref{AbstractSceneConverter,convertInPlace()},
+    @relativeref{AbstractSceneConverter,convertToData()} and
+    @relativeref{AbstractSceneConverter,convertToFile()} taking a
+    @ref MeshData
+-   @ref AbstractSceneConverter::begin(),
+    @relativeref{AbstractSceneConverter,beginData()},
+    @relativeref{AbstractSceneConverter,beginFile()},
+    @relativeref{AbstractSceneConverter,end()},
+    @relativeref{AbstractSceneConverter,endData()} and
+    @relativeref{AbstractSceneConverter,endFile()}
+-   all @ref AbstractSceneConverter::add() overloads, with each item added
+    through @relativeref{AbstractSceneConverter,addMeshes()} and
+    @relativeref{AbstractSceneConverter,addImages2D()} recorded separately
+
+Calls that are implemented on top of other profiled calls, such as
+@ref AbstractSceneConverter::convertToData() on a converter that supports
+only @ref SceneConverterFeature::ConvertMultipleToData, record the nested calls
+as well. As a record is added only once a call finishes, the nested records
+precede the outer one.
+
+When a plugin delegates to another plugin, such as @ref AnySceneImporter,
+only the outer calls are recorded unless the profiler is set on the
+delegated instance as well.
+
+@section Trade-Profiler-peak-allocation Peak allocation tracking
+
+Magnum doesn't hook into the global allocator, so peak allocation tracking
+requires an application-provided callback set via
+@ref setPeakAllocationCallback(). It's called once at the start of each
+profiled call, with the return value ignored, and once at the end, with the
+return value saved to @ref ProfilerRecord::peakAllocation. The callback is
+expected to return the peak allocated size since its previous invocation,
+which is commonly implemented by resetting a high-water mark counter
+maintained by a custom @cpp operator new @ce or a @cpp malloc() @ce hook.
+
+@section Trade-Profiler-thread-safety Thread safety
+
+Adding records is thread-safe, so the profiler can be used together with
+@ref importMeshes() and other parallel functions. The peak allocation callback
+is called from the thread making the profiled call, and it's up to the
+callback to decide whether the counter is per-thread or global. The
+@ref records(), @ref chromeTrace() and @ref clear() functions are not meant
+to be called while other threads are still making profiled calls.
+*/
+class MAGNUM_TRADE_EXPORT Profiler {
+    public:
+        /** @brief Constructor */
+        explicit Profiler();
+
+        /** @brief Copying is not allowed */
+        Profiler(const Profiler&) = delete;
+
+        /** @brief Moving is not allowed */
+        Profiler(Profiler&&) = delete;
+
+        ~Profiler();
+
+        /** @brief Copying is not allowed */
+        Profiler& operator=(const Profiler&) = delete;
+
+        /** @brief Moving is not allowed */
+        Profiler& operator=(Profiler&&) = delete;
+
+        /**
+         * @brief Set a peak allocation callback
+         *
+         * See @ref Trade-Profiler-peak-allocation for more information.
+         * Passing @cpp nullptr @ce disables the tracking.
+         */
+        void setPeakAllocationCallback(std::size_t(*callback)(void*), void* userData = nullptr);
+
+        /**
+         * @brief Current time
+         *
+         * Nanoseconds since the profiler was created. Used as
+         * @ref ProfilerRecord::begin.
+         */
+        UnsignedLong time() const;
+
+        /**
+         * @brief Peak allocation
+         *
+         * Returns the value from the callback set via
+         * @ref setPeakAllocationCallback(), or @cpp 0 @ce if no callback is
+         * set.
+         */
+        std::size_t peakAllocation() const;
+
+        /**
+         * @brief Add a record
+         *
+         * Called by plugin interfaces for each profiled call, can be used to
+         * add also application-specific records. The
+         * @ref ProfilerRecord::thread field is ignored and filled with index
+         * of the calling thread.
+         */
+        void addRecord(ProfilerRecord&& record);
+
+        /** @brief Records in order they were added */
+        Containers::ArrayView<const ProfilerRecord> records() const;
+
+        /**
+         * @brief Clear all records
+         *
+         * Doesn't reset the time or the thread indices.
+         */
+        void clear();
+
+        /**
+         * @brief Export records to a Chrome trace
+         *
+         * Produces a JSON in the
+         * [Trace Event Format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview)
+         * that can be opened in `chrome://tracing` or
+         * [Perfetto](https://ui.perfetto.dev/). Each record is a complete
+         * event named after @ref ProfilerRecord::function with
+         * @ref ProfilerRecord::plugin as a category, the remaining fields
+         * are in event arguments.
+         */
+        Containers::String chromeTrace() const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -295,6 +295,18 @@ struct AbstractImageConverterTest: TestSuite::Tester {
     void convertCompressed2DToFileThroughLevels();
     void convertCompressed3DToFileThroughLevels();
 
+    void stream2DToFile();
+    void stream2DToFileBeginFailed();
+    void stream2DToFileAddFailed();
+    void stream2DToFileAbort();
+    void stream2DToFileBeginAbortsPrevious();
+    void stream2DToFileNotSupported();
+    void stream2DToFileNotImplemented();
+    void stream2DToFileInvalidSize();
+    void stream2DToFileNoConversionInProgress();
+    void stream2DToFileInvalidRows();
+    void stream2DToFileNotAllRowsAdded();
+
     void debugFeature();
     void debugFeaturePacked();
     #ifdef MAGNUM_BUILD_DEPRECATED
@@ -537,6 +549,18 @@ AbstractImageConverterTest::AbstractImageConverterTest() {
               &AbstractImageConverterTest::convertCompressed2DToFileThroughLevels,
               &AbstractImageConverterTest::convertCompressed3DToFileThroughLevels,
 
+              &AbstractImageConverterTest::stream2DToFile,
+              &AbstractImageConverterTest::stream2DToFileBeginFailed,
+              &AbstractImageConverterTest::stream2DToFileAddFailed,
+              &AbstractImageConverterTest::stream2DToFileAbort,
+              &AbstractImageConverterTest::stream2DToFileBeginAbortsPrevious,
+              &AbstractImageConverterTest::stream2DToFileNotSupported,
+              &AbstractImageConverterTest::stream2DToFileNotImplemented,
+              &AbstractImageConverterTest::stream2DToFileInvalidSize,
+              &AbstractImageConverterTest::stream2DToFileNoConversionInProgress,
+              &AbstractImageConverterTest::stream2DToFileInvalidRows,
+              &AbstractImageConverterTest::stream2DToFileNotAllRowsAdded,
+
               &AbstractImageConverterTest::debugFeature,
               &AbstractImageConverterTest::debugFeaturePacked,
               #ifdef MAGNUM_BUILD_DEPRECATED
@@ -4514,6 +4538,262 @@ void AbstractImageConverterTest::convertCompressed3DToFileThroughLevels() {
         "\x0f\x0d\x0e\x01", TestSuite::Compare::FileToString);
 }
 
+void AbstractImageConverterTest::stream2DToFile() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView filename, PixelFormat format, const Vector2i& size, ImageFlags2D flags) override {
+            CORRADE_COMPARE(filename, "image.out");
+            CORRADE_COMPARE(format, PixelFormat::RG8Unorm);
+            CORRADE_COMPARE(size, (Vector2i{2, 3}));
+            CORRADE_COMPARE(flags, ImageFlag2D::Array);
+            beginCalled = true;
+            return true;
+        }
+
+        bool doAddRows(const ImageView2D& rows) override {
+            rowsAdded += rows.size().y();
+            return true;
+        }
+
+        bool doEndFile() override {
+            endCalled = true;
+            return true;
+        }
+
+        bool beginCalled = false, endCalled = false;
+        Int rowsAdded = 0;
+    } converter;
+
+    const char data[12]{};
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}, ImageFlag2D::Array));
+    CORRADE_VERIFY(converter.beginCalled);
+    CORRADE_VERIFY(converter.isConverting());
+
+    CORRADE_VERIFY(converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 2}, data}));
+    CORRADE_VERIFY(converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 1}, data}));
+    CORRADE_COMPARE(converter.rowsAdded, 3);
+    CORRADE_VERIFY(converter.isConverting());
+
+    CORRADE_VERIFY(converter.endFile());
+    CORRADE_VERIFY(converter.endCalled);
+    CORRADE_VERIFY(!converter.isConverting());
+}
+
+void AbstractImageConverterTest::stream2DToFileBeginFailed() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return false;
+        }
+
+        void doAbort() override {
+            abortCalled = true;
+        }
+
+        bool abortCalled = false;
+    } converter;
+
+    CORRADE_VERIFY(!converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_VERIFY(converter.abortCalled);
+    CORRADE_VERIFY(!converter.isConverting());
+}
+
+void AbstractImageConverterTest::stream2DToFileAddFailed() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return true;
+        }
+
+        bool doAddRows(const ImageView2D&) override {
+            return false;
+        }
+
+        void doAbort() override {
+            abortCalled = true;
+        }
+
+        bool abortCalled = false;
+    } converter;
+
+    const char data[4]{};
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_VERIFY(!converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 1}, data}));
+    CORRADE_VERIFY(converter.abortCalled);
+    CORRADE_VERIFY(!converter.isConverting());
+}
+
+void AbstractImageConverterTest::stream2DToFileAbort() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return true;
+        }
+
+        void doAbort() override {
+            ++abortCalled;
+        }
+
+        Int abortCalled = 0;
+    } converter;
+
+    /* Aborting with no conversion in progress does nothing */
+    converter.abort();
+    CORRADE_COMPARE(converter.abortCalled, 0);
+
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    converter.abort();
+    CORRADE_COMPARE(converter.abortCalled, 1);
+    CORRADE_VERIFY(!converter.isConverting());
+
+    /* Aborting again does nothing */
+    converter.abort();
+    CORRADE_COMPARE(converter.abortCalled, 1);
+}
+
+void AbstractImageConverterTest::stream2DToFileBeginAbortsPrevious() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return true;
+        }
+
+        void doAbort() override {
+            ++abortCalled;
+        }
+
+        Int abortCalled = 0;
+    } converter;
+
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_COMPARE(converter.abortCalled, 0);
+
+    CORRADE_VERIFY(converter.beginFile("image2.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_COMPARE(converter.abortCalled, 1);
+    CORRADE_VERIFY(converter.isConverting());
+}
+
+void AbstractImageConverterTest::stream2DToFileNotSupported() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Convert2DToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginFile(): streaming 2D image conversion not supported\n");
+}
+
+void AbstractImageConverterTest::stream2DToFileNotImplemented() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginFile(): streaming 2D image conversion advertised but not implemented\n");
+}
+
+void AbstractImageConverterTest::stream2DToFileInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 0});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginFile(): can't convert image with a zero size: Vector(2, 0)\n");
+}
+
+void AbstractImageConverterTest::stream2DToFileNoConversionInProgress() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+    } converter;
+
+    const char data[4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 1}, data});
+    converter.endFile();
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImageConverter::addRows(): no conversion in progress\n"
+        "Trade::AbstractImageConverter::endFile(): no conversion in progress\n");
+}
+
+void AbstractImageConverterTest::stream2DToFileInvalidRows() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return true;
+        }
+
+        bool doAddRows(const ImageView2D&) override {
+            return true;
+        }
+    } converter;
+
+    const char data[16]{};
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_VERIFY(converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 2}, data}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 1}, {nullptr, 4}});
+    converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 0}, data});
+    converter.addRows(ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, data});
+    converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {1, 1}, data});
+    converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 2}, data});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImageConverter::addRows(): can't add rows with a nullptr view\n"
+        "Trade::AbstractImageConverter::addRows(): can't add zero rows\n"
+        "Trade::AbstractImageConverter::addRows(): expected format PixelFormat::RG8Unorm but got PixelFormat::RGBA8Unorm\n"
+        "Trade::AbstractImageConverter::addRows(): expected width 2 but got 1\n"
+        "Trade::AbstractImageConverter::addRows(): adding 2 rows to 2 would exceed image height 3\n");
+}
+
+void AbstractImageConverterTest::stream2DToFileNotAllRowsAdded() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::Stream2DToFile; }
+
+        bool doBeginFile(Containers::StringView, PixelFormat, const Vector2i&, ImageFlags2D) override {
+            return true;
+        }
+
+        bool doAddRows(const ImageView2D&) override {
+            return true;
+        }
+    } converter;
+
+    const char data[4]{};
+    CORRADE_VERIFY(converter.beginFile("image.out", PixelFormat::RG8Unorm, {2, 3}));
+    CORRADE_VERIFY(converter.addRows(ImageView2D{PixelFormat::RG8Unorm, {2, 1}, data}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.endFile();
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::endFile(): expected 3 rows but got 1\n");
+}
+
 void AbstractImageConverterTest::debugFeature() {
     std::ostringstream out;
 
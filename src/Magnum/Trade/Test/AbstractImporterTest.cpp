@@ -90,6 +90,9 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openFileFailed();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openFileMapped();
+    void openFileMappedFailed();
+    void openFileMappedNotFound();
     void openState();
     void openStateFailed();
 
@@ -414,6 +417,9 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openFileFailed,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openFileMapped,
+              &AbstractImporterTest::openFileMappedFailed,
+              &AbstractImporterTest::openFileMappedNotFound,
               &AbstractImporterTest::openState,
               &AbstractImporterTest::openStateFailed,
 
@@ -1017,6 +1023,97 @@ void AbstractImporterTest::openFileAsDataNotFound() {
         TestSuite::Compare::StringHasSuffix);
 }
 
+void AbstractImporterTest::openFileMapped() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory-mapping is not available on this platform.");
+    #else
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return !_data.isEmpty(); }
+        void doClose() override {
+            /* The mapping should be still alive at this point */
+            CORRADE_COMPARE_AS(_data,
+                Containers::arrayView({'\xa5'}),
+                TestSuite::Compare::Container);
+            _data = nullptr;
+        }
+
+        void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override {
+            CORRADE_COMPARE(dataFlags, DataFlag::ExternallyOwned);
+            /* I.e., it's just a view on the mapped memory */
+            CORRADE_VERIFY(data.deleter());
+            _data = data;
+        }
+
+        Containers::ArrayView<const char> _data;
+    } importer;
+    importer.addFlags(ImporterFlag::MapFile);
+
+    /* doOpenFile() should map the file and call doOpenData() */
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_VERIFY(importer.openFile(Utility::Path::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(importer.isOpened());
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+    #endif
+}
+
+void AbstractImporterTest::openFileMappedFailed() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory-mapping is not available on this platform.");
+    #else
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        void doOpenData(Containers::Array<char>&&, DataFlags) override {
+            ++called;
+        }
+
+        Int called = 0;
+    } importer;
+    importer.addFlags(ImporterFlag::MapFile);
+
+    /* The mapping gets released right away if the opening fails. Can't
+       really verify that from the outside, at least check that opening again
+       works. */
+    CORRADE_VERIFY(!importer.openFile(Utility::Path::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(!importer.openFile(Utility::Path::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_COMPARE(importer.called, 2);
+    #endif
+}
+
+void AbstractImporterTest::openFileMappedNotFound() {
+    #if !defined(CORRADE_TARGET_UNIX) && (!defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_SKIP("Memory-mapping is not available on this platform.");
+    #else
+    struct Importer: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::Array<char>&&, DataFlags) override {
+            _opened = true;
+        }
+
+        bool _opened = false;
+    } importer;
+    importer.addFlags(ImporterFlag::MapFile);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openFile("nonexistent.bin"));
+    CORRADE_VERIFY(!importer.isOpened());
+    /* There's an error message from Path::mapRead() before */
+    CORRADE_COMPARE_AS(out.str(),
+        "\nTrade::AbstractImporter::openFile(): cannot map file nonexistent.bin\n",
+        TestSuite::Compare::StringHasSuffix);
+    #endif
+}
+
 void AbstractImporterTest::openState() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override {
@@ -7805,8 +7902,8 @@ void AbstractImporterTest::debugFeaturesPacked() {
 void AbstractImporterTest::debugFlag() {
     std::ostringstream out;
 
-    Debug{&out} << ImporterFlag::Verbose << ImporterFlag(0xf0);
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag(0xf0)\n");
+    Debug{&out} << ImporterFlag::Verbose << ImporterFlag::MapFile << ImporterFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag::MapFile Trade::ImporterFlag(0xf0)\n");
 }
 
 void AbstractImporterTest::debugFlags() {
@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
@@ -212,6 +214,11 @@ struct AbstractSceneConverterTest: TestSuite::Tester {
 
     void addMeshThroughLevels();
 
+    void addMeshes();
+    void addMeshesParallel();
+    void addMeshesFailed();
+    void addMeshesEmpty();
+
     void setMeshAttributeName();
     void setMeshAttributeNameNotImplemented();
     void setMeshAttributeNameNotCustom();
@@ -288,6 +295,10 @@ struct AbstractSceneConverterTest: TestSuite::Tester {
     void addImage2DThroughLevels();
     void addImage3DThroughLevels();
 
+    void addImages2DParallel();
+    void addImages2DFailed();
+    void addImages2DInvalidImage();
+
     void addImporterContents();
     void addImporterContentsCustomSceneFields();
     void addImporterContentsCustomMeshAttributes();
@@ -774,7 +785,12 @@ AbstractSceneConverterTest::AbstractSceneConverterTest() {
               &AbstractSceneConverterTest::addMeshLevelsNoLevels,
               &AbstractSceneConverterTest::addMeshLevelsNotImplemented,
 
-              &AbstractSceneConverterTest::addMeshThroughLevels});
+              &AbstractSceneConverterTest::addMeshThroughLevels,
+
+              &AbstractSceneConverterTest::addMeshes,
+              &AbstractSceneConverterTest::addMeshesParallel,
+              &AbstractSceneConverterTest::addMeshesFailed,
+              &AbstractSceneConverterTest::addMeshesEmpty});
 
     addInstancedTests({&AbstractSceneConverterTest::setMeshAttributeName},
         Containers::arraySize(SetMeshAttributeData));
@@ -842,7 +858,11 @@ AbstractSceneConverterTest::AbstractSceneConverterTest() {
 
               &AbstractSceneConverterTest::addImage1DThroughLevels,
               &AbstractSceneConverterTest::addImage2DThroughLevels,
-              &AbstractSceneConverterTest::addImage3DThroughLevels});
+              &AbstractSceneConverterTest::addImage3DThroughLevels,
+
+              &AbstractSceneConverterTest::addImages2DParallel,
+              &AbstractSceneConverterTest::addImages2DFailed,
+              &AbstractSceneConverterTest::addImages2DInvalidImage});
 
     addInstancedTests({&AbstractSceneConverterTest::addImporterContents},
         Containers::arraySize(AddImporterContentsData));
@@ -1111,6 +1131,7 @@ void AbstractSceneConverterTest::thingNotSupported() {
 
     converter.add(mesh);
     converter.add({mesh, mesh});
+    converter.addMeshes({mesh, mesh});
     converter.setMeshAttributeName({}, {});
 
     converter.add(MaterialData{{}, nullptr});
@@ -1125,6 +1146,8 @@ void AbstractSceneConverterTest::thingNotSupported() {
     converter.add(compressedImage2D);
     converter.add({image2D, image2D});
     converter.add({compressedImage2D, compressedImage2D});
+    converter.addImages2D({image2D, image2D});
+    converter.addImages2D({compressedImage2D, compressedImage2D});
 
     converter.add(image3D);
     converter.add(compressedImage3D);
@@ -1156,6 +1179,7 @@ void AbstractSceneConverterTest::thingNotSupported() {
 
         "Trade::AbstractSceneConverter::add(): mesh conversion not supported\n"
         "Trade::AbstractSceneConverter::add(): multi-level mesh conversion not supported\n"
+        "Trade::AbstractSceneConverter::addMeshes(): mesh conversion not supported\n"
         "Trade::AbstractSceneConverter::setMeshAttributeName(): feature not supported\n"
 
         "Trade::AbstractSceneConverter::add(): material conversion not supported\n"
@@ -1170,6 +1194,8 @@ void AbstractSceneConverterTest::thingNotSupported() {
         "Trade::AbstractSceneConverter::add(): compressed 2D image conversion not supported\n"
         "Trade::AbstractSceneConverter::add(): multi-level 2D image conversion not supported\n"
         "Trade::AbstractSceneConverter::add(): multi-level compressed 2D image conversion not supported\n"
+        "Trade::AbstractSceneConverter::addImages2D(): 2D image conversion not supported\n"
+        "Trade::AbstractSceneConverter::addImages2D(): compressed 2D image conversion not supported\n"
 
         "Trade::AbstractSceneConverter::add(): 3D image conversion not supported\n"
         "Trade::AbstractSceneConverter::add(): compressed 3D image conversion not supported\n"
@@ -2627,6 +2653,8 @@ void AbstractSceneConverterTest::thingNoBegin() {
     converter.add(MeshData{MeshPrimitive::Triangles, 0});
     converter.add({MeshData{MeshPrimitive::Triangles, 0},
                    MeshData{MeshPrimitive::Triangles, 0}});
+    converter.addMeshes({MeshData{MeshPrimitive::Triangles, 0},
+                         MeshData{MeshPrimitive::Triangles, 0}});
     converter.setMeshAttributeName({}, {});
 
     converter.materialCount();
@@ -2646,6 +2674,8 @@ void AbstractSceneConverterTest::thingNoBegin() {
     converter.add(ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData});
     converter.add({ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData},
                    ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData}});
+    converter.addImages2D({ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData},
+                           ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData}});
 
     converter.image3DCount();
     converter.add(ImageData3D{PixelFormat::RGBA8Unorm, {1, 1, 1}, DataFlags{}, imageData});
@@ -2682,6 +2712,7 @@ void AbstractSceneConverterTest::thingNoBegin() {
         "Trade::AbstractSceneConverter::meshCount(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
+        "Trade::AbstractSceneConverter::addMeshes(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::setMeshAttributeName(): no conversion in progress\n"
 
         "Trade::AbstractSceneConverter::materialCount(): no conversion in progress\n"
@@ -2697,6 +2728,7 @@ void AbstractSceneConverterTest::thingNoBegin() {
         "Trade::AbstractSceneConverter::image2DCount(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
+        "Trade::AbstractSceneConverter::addImages2D(): no conversion in progress\n"
 
         "Trade::AbstractSceneConverter::image3DCount(): no conversion in progress\n"
         "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
@@ -4203,6 +4235,161 @@ void AbstractSceneConverterTest::addMeshThroughLevels() {
     CORRADE_COMPARE(converter.meshCount(), 1);
 }
 
+void AbstractSceneConverterTest::addMeshes() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddMeshes;
+        }
+
+        bool doBegin() override { return true; }
+
+        bool doAdd(UnsignedInt id, const MeshData& mesh, Containers::StringView name) override {
+            /* Mesh count should not be increased until all meshes are
+               added */
+            CORRADE_COMPARE(meshCount(), 1);
+            CORRADE_COMPARE(name, "");
+
+            arrayAppend(ids, id);
+            arrayAppend(states, mesh.importerState());
+            return true;
+        }
+
+        Containers::Array<UnsignedInt> ids;
+        Containers::Array<const void*> states;
+    } converter;
+
+    CORRADE_VERIFY(converter.begin());
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 0}), 0);
+    arrayClear(converter.ids);
+    arrayClear(converter.states);
+
+    /* Without SceneConverterFeature::AddParallel it's done serially, in
+       order */
+    CORRADE_COMPARE(converter.addMeshes({
+        MeshData{MeshPrimitive::Triangles, 0, reinterpret_cast<const void*>(0xdead)},
+        MeshData{MeshPrimitive::Triangles, 0, reinterpret_cast<const void*>(0xbeef)},
+        MeshData{MeshPrimitive::Triangles, 0, reinterpret_cast<const void*>(0xcafe)}
+    }, 4), 1);
+    CORRADE_COMPARE(converter.meshCount(), 4);
+    CORRADE_COMPARE_AS(converter.ids, Containers::arrayView<UnsignedInt>({
+        1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(converter.states, Containers::arrayView<const void*>({
+        reinterpret_cast<const void*>(0xdead),
+        reinterpret_cast<const void*>(0xbeef),
+        reinterpret_cast<const void*>(0xcafe)
+    }), TestSuite::Compare::Container);
+}
+
+void AbstractSceneConverterTest::addMeshesParallel() {
+    struct Converter: AbstractSceneConverter {
+        explicit Converter(std::size_t count): states{ValueInit, count} {}
+
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddMeshes|
+                   SceneConverterFeature::AddParallel;
+        }
+
+        bool doBegin() override { return true; }
+
+        /* Called from multiple threads, so not checking anything here
+           directly. Each ID gets written to a different location. */
+        bool doAdd(UnsignedInt id, const MeshData& mesh, Containers::StringView) override {
+            ++calls;
+            states[id - 1] = mesh.importerState();
+            return true;
+        }
+
+        std::atomic<UnsignedInt> calls{0};
+        Containers::Array<const void*> states;
+    } converter{100};
+
+    Containers::Array<MeshData> meshes;
+    for(std::size_t i = 0; i != 100; ++i)
+        arrayAppend(meshes, InPlaceInit, MeshPrimitive::Triangles, 0, reinterpret_cast<const void*>(i + 1));
+
+    CORRADE_VERIFY(converter.begin());
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 0}), 0);
+    converter.calls = 0;
+
+    CORRADE_COMPARE(converter.addMeshes(meshes, 4), 1);
+    CORRADE_COMPARE(converter.calls.load(), 100);
+    CORRADE_COMPARE(converter.meshCount(), 101);
+    for(std::size_t i = 0; i != 100; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(converter.states[i], reinterpret_cast<const void*>(i + 1));
+    }
+}
+
+void AbstractSceneConverterTest::addMeshesFailed() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddMeshes;
+        }
+
+        bool doBegin() override { return true; }
+
+        bool doAdd(UnsignedInt id, const MeshData&, Containers::StringView) override {
+            arrayAppend(ids, id);
+            return id != 1;
+        }
+
+        void doAbort() override {
+            abortCalled = true;
+        }
+
+        Containers::Array<UnsignedInt> ids;
+        bool abortCalled = false;
+    } converter;
+
+    CORRADE_VERIFY(converter.begin());
+
+    /* The implementation is expected to print an error message on its own */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter.addMeshes({
+            MeshData{MeshPrimitive::Triangles, 0},
+            MeshData{MeshPrimitive::Triangles, 0},
+            MeshData{MeshPrimitive::Triangles, 0}
+        }));
+        CORRADE_COMPARE(out.str(), "");
+    }
+
+    /* The remaining meshes are skipped and the whole process is aborted, as
+       it's not possible to undo meshes already added by other threads */
+    CORRADE_COMPARE_AS(converter.ids, Containers::arrayView<UnsignedInt>({
+        0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(converter.abortCalled);
+    CORRADE_VERIFY(!converter.isConverting());
+}
+
+void AbstractSceneConverterTest::addMeshesEmpty() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddMeshes|
+                   SceneConverterFeature::AddParallel;
+        }
+
+        bool doBegin() override { return true; }
+
+        bool doAdd(UnsignedInt, const MeshData&, Containers::StringView) override {
+            CORRADE_FAIL("This shouldn't be called");
+            return false;
+        }
+    } converter;
+
+    CORRADE_VERIFY(converter.begin());
+    CORRADE_COMPARE(converter.addMeshes({}), 0);
+    CORRADE_COMPARE(converter.meshCount(), 0);
+    CORRADE_VERIFY(converter.isConverting());
+}
+
 void AbstractSceneConverterTest::setMeshAttributeName() {
     auto&& data = SetMeshAttributeData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -5955,6 +6142,119 @@ void AbstractSceneConverterTest::addImage3DThroughLevels() {
     CORRADE_COMPARE(converter.image3DCount(), 1);
 }
 
+void AbstractSceneConverterTest::addImages2DParallel() {
+    struct Converter: AbstractSceneConverter {
+        explicit Converter(std::size_t count): states{ValueInit, count} {}
+
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddImages2D|
+                   SceneConverterFeature::AddCompressedImages2D|
+                   SceneConverterFeature::AddParallel;
+        }
+
+        bool doBegin() override { return true; }
+
+        /* Called from multiple threads, so not checking anything here
+           directly. Each ID gets written to a different location. */
+        bool doAdd(UnsignedInt id, const ImageData2D& image, Containers::StringView) override {
+            ++calls;
+            states[id] = image.importerState();
+            return true;
+        }
+
+        std::atomic<UnsignedInt> calls{0};
+        Containers::Array<const void*> states;
+    } converter{50};
+
+    const char imageData[16]{};
+    Containers::Array<ImageData2D> images;
+    for(std::size_t i = 0; i != 50; ++i) {
+        if(i % 2)
+            arrayAppend(images, InPlaceInit, PixelFormat::RGBA8Unorm, Vector2i{1, 1}, DataFlags{}, imageData, ImageFlags2D{}, reinterpret_cast<const void*>(i + 1));
+        else
+            arrayAppend(images, InPlaceInit, CompressedPixelFormat::Astc4x4RGBAF, Vector2i{1, 1}, DataFlags{}, imageData, ImageFlags2D{}, reinterpret_cast<const void*>(i + 1));
+    }
+
+    CORRADE_VERIFY(converter.begin());
+    CORRADE_COMPARE(converter.addImages2D(images, 3), 0);
+    CORRADE_COMPARE(converter.calls.load(), 50);
+    CORRADE_COMPARE(converter.image2DCount(), 50);
+    for(std::size_t i = 0; i != 50; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(converter.states[i], reinterpret_cast<const void*>(i + 1));
+    }
+}
+
+void AbstractSceneConverterTest::addImages2DFailed() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddImages2D|
+                   SceneConverterFeature::AddParallel;
+        }
+
+        bool doBegin() override { return true; }
+
+        bool doAdd(UnsignedInt, const ImageData2D&, Containers::StringView) override {
+            return false;
+        }
+    } converter;
+
+    const char imageData[4]{};
+
+    CORRADE_VERIFY(converter.begin());
+
+    /* The implementation is expected to print an error message on its own */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!converter.addImages2D({
+            ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData},
+            ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData}
+        }));
+        CORRADE_COMPARE(out.str(), "");
+    }
+
+    CORRADE_VERIFY(!converter.isConverting());
+}
+
+void AbstractSceneConverterTest::addImages2DInvalidImage() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultiple|
+                   SceneConverterFeature::AddImages2D|
+                   SceneConverterFeature::AddParallel;
+        }
+
+        bool doBegin() override { return true; }
+
+        bool doAdd(UnsignedInt, const ImageData2D&, Containers::StringView) override {
+            CORRADE_FAIL("This shouldn't be called");
+            return false;
+        }
+    } converter;
+
+    const char imageData[4]{};
+
+    CORRADE_VERIFY(converter.begin());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.addImages2D({
+        ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, imageData},
+        ImageData2D{PixelFormat::RGBA8Unorm, {1, 0}, DataFlags{}, imageData}
+    });
+    converter.addImages2D({
+        ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, {nullptr, 4}}
+    });
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractSceneConverter::addImages2D(): can't add image with a zero size: Vector(1, 0)\n"
+        "Trade::AbstractSceneConverter::addImages2D(): can't add image with a nullptr view\n");
+}
+
 void AbstractSceneConverterTest::addImporterContents() {
     auto&& data = AddImporterContentsData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
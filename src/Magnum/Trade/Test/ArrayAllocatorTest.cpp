@@ -0,0 +1,431 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+#include <cstdint>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ArrayAllocator.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelImport.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ArrayAllocatorTest: TestSuite::Tester {
+    explicit ArrayAllocatorTest();
+
+    void mallocCompatible();
+    void heap();
+
+    void arenaConstruct();
+    void arena();
+    void arenaGrowInPlace();
+    void arenaGrowNotLast();
+    void arenaLargeAllocation();
+    void arenaGrowOutsideScope();
+    void arenaHeapArrayInsideScope();
+    void arenaRelease();
+    void arenaArrayOutlivesArena();
+
+    void scope();
+    void scopeNull();
+
+    void importer();
+    void importerNoArena();
+    void importerParallel();
+};
+
+ArrayAllocatorTest::ArrayAllocatorTest() {
+    addTests({&ArrayAllocatorTest::mallocCompatible,
+              &ArrayAllocatorTest::heap,
+
+              &ArrayAllocatorTest::arenaConstruct,
+              &ArrayAllocatorTest::arena,
+              &ArrayAllocatorTest::arenaGrowInPlace,
+              &ArrayAllocatorTest::arenaGrowNotLast,
+              &ArrayAllocatorTest::arenaLargeAllocation,
+              &ArrayAllocatorTest::arenaGrowOutsideScope,
+              &ArrayAllocatorTest::arenaHeapArrayInsideScope,
+              &ArrayAllocatorTest::arenaRelease,
+              &ArrayAllocatorTest::arenaArrayOutlivesArena,
+
+              &ArrayAllocatorTest::scope,
+              &ArrayAllocatorTest::scopeNull,
+
+              &ArrayAllocatorTest::importer,
+              &ArrayAllocatorTest::importerNoArena,
+              &ArrayAllocatorTest::importerParallel});
+}
+
+void ArrayAllocatorTest::mallocCompatible() {
+    /* The arena isn't used by the ArrayAllocator even if current */
+    ArrayArena arena{4096};
+    ArrayArenaScope scope{&arena};
+
+    Containers::Array<Vector3> a;
+    arrayAppend<ArrayAllocator>(a, {Vector3{1.0f, 2.0f, 3.0f}, Vector3{4.0f, 5.0f, 6.0f}});
+
+    /* The layout is the same as of Containers::ArrayMallocAllocator, so the
+       array can be cast and grown further */
+    Containers::Array<char> b = Containers::arrayAllocatorCast<char, ArrayAllocator>(Utility::move(a));
+    CORRADE_COMPARE(b.size(), 2*sizeof(Vector3));
+    CORRADE_VERIFY(b.deleter() == ArrayAllocator<char>::deleter);
+    arrayAppend<ArrayAllocator>(b, '\xff');
+    CORRADE_COMPARE(b.size(), 2*sizeof(Vector3) + 1);
+    CORRADE_COMPARE(Containers::arrayCast<const Vector3>(b.prefix(2*sizeof(Vector3)))[1], (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(b.back(), '\xff');
+
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 0);
+}
+
+void ArrayAllocatorTest::heap() {
+    Containers::Array<char> a;
+    for(char i = 0; i != 100; ++i)
+        arrayAppend<ArrayArenaAllocator>(a, i);
+
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_VERIFY(a.deleter() == ArrayArenaAllocator<char>::deleter);
+    CORRADE_COMPARE_AS(arrayCapacity<ArrayArenaAllocator>(a), 100,
+        TestSuite::Compare::GreaterOrEqual);
+    for(char i = 0; i != 100; ++i)
+        CORRADE_COMPARE(a[i], i);
+
+    /* Data should be aligned the same as returned by malloc() */
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % ArrayArenaAllocator<char>::AllocationOffset, 0);
+}
+
+void ArrayAllocatorTest::arenaConstruct() {
+    ArrayArena arena{4096};
+    CORRADE_COMPARE(arena.chunkSize(), 4096);
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 0);
+    CORRADE_COMPARE(arena.peakAllocatedSize(), 0);
+    CORRADE_COMPARE(arena.reservedSize(), 0);
+}
+
+void ArrayAllocatorTest::arena() {
+    ArrayArena arena{4096};
+
+    Containers::Array<char> a, b;
+    {
+        ArrayArenaScope scope{&arena};
+        arrayAppend<ArrayArenaAllocator>(a, {'a', 'b', 'c'});
+        arrayAppend<ArrayArenaAllocator>(b, {'d', 'e'});
+    }
+
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+    CORRADE_COMPARE_AS(arena.reservedSize(), 4096,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(arena.allocatedSize(), 2*ArrayArenaAllocator<char>::AllocationOffset + 5,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(arena.peakAllocatedSize(), arena.allocatedSize());
+
+    CORRADE_VERIFY(a.deleter() == ArrayArenaAllocator<char>::deleter);
+    CORRADE_VERIFY(b.deleter() == ArrayArenaAllocator<char>::deleter);
+    CORRADE_COMPARE_AS(a, Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(b, Containers::arrayView({'d', 'e'}),
+        TestSuite::Compare::Container);
+
+    /* Both allocations are from the same chunk, one after another */
+    CORRADE_VERIFY(b.data() > a.data());
+    CORRADE_VERIFY(b.data() < a.data() + 4096);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % ArrayArenaAllocator<char>::AllocationOffset, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % ArrayArenaAllocator<char>::AllocationOffset, 0);
+}
+
+void ArrayAllocatorTest::arenaGrowInPlace() {
+    ArrayArena arena{4096};
+    ArrayArenaScope scope{&arena};
+
+    Containers::Array<char> a;
+    arrayAppend<ArrayArenaAllocator>(a, 'a');
+    const char* data = a.data();
+    const std::size_t allocated = arena.allocatedSize();
+
+    /* Growing the last allocation doesn't move it anywhere */
+    for(std::size_t i = 0; i != 1000; ++i)
+        arrayAppend<ArrayArenaAllocator>(a, 'b');
+    CORRADE_COMPARE(a.size(), 1001);
+    CORRADE_VERIFY(a.data() == data);
+    CORRADE_COMPARE(a[0], 'a');
+    CORRADE_COMPARE(a[1000], 'b');
+
+    /* Only the difference got allocated, no abandoned copies */
+    CORRADE_COMPARE(allocated, 2*ArrayArenaAllocator<char>::AllocationOffset);
+    CORRADE_COMPARE(arena.allocatedSize(), arrayCapacity<ArrayArenaAllocator>(a) + ArrayArenaAllocator<char>::AllocationOffset);
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+}
+
+void ArrayAllocatorTest::arenaGrowNotLast() {
+    ArrayArena arena{4096};
+    ArrayArenaScope scope{&arena};
+
+    Containers::Array<char> a, b;
+    arrayAppend<ArrayArenaAllocator>(a, {'a', 'b', 'c'});
+    arrayAppend<ArrayArenaAllocator>(b, 'd');
+    const char* data = a.data();
+
+    /* The allocation isn't the last anymore, so it gets copied */
+    arrayReserve<ArrayArenaAllocator>(a, 100);
+    CORRADE_VERIFY(a.data() != data);
+    CORRADE_VERIFY(a.data() > b.data());
+    CORRADE_COMPARE_AS(a, Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(b[0], 'd');
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+}
+
+void ArrayAllocatorTest::arenaLargeAllocation() {
+    ArrayArena arena{256};
+    ArrayArenaScope scope{&arena};
+
+    Containers::Array<char> a, b, c;
+    arrayAppend<ArrayArenaAllocator>(a, 'a');
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+
+    /* Too large for a chunk, gets a dedicated one */
+    arrayReserve<ArrayArenaAllocator>(b, 1024);
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    CORRADE_COMPARE_AS(arena.reservedSize(), 256 + 1024,
+        TestSuite::Compare::Greater);
+
+    /* Subsequent small allocations are still made from the original chunk,
+       right after the first allocation */
+    arrayAppend<ArrayArenaAllocator>(c, 'c');
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    CORRADE_VERIFY(c.data() == a.data() + arrayCapacity<ArrayArenaAllocator>(a) + ArrayArenaAllocator<char>::AllocationOffset);
+}
+
+void ArrayAllocatorTest::arenaGrowOutsideScope() {
+    ArrayArena arena{4096};
+
+    Containers::Array<char> a;
+    {
+        ArrayArenaScope scope{&arena};
+        arrayAppend<ArrayArenaAllocator>(a, {'a', 'b', 'c'});
+    }
+    const std::size_t allocated = arena.allocatedSize();
+
+    /* With no arena current, the data get moved to the heap */
+    arrayReserve<ArrayArenaAllocator>(a, 100);
+    CORRADE_COMPARE_AS(a, Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(arena.allocatedSize(), allocated);
+    CORRADE_VERIFY(a.deleter() == ArrayArenaAllocator<char>::deleter);
+}
+
+void ArrayAllocatorTest::arenaHeapArrayInsideScope() {
+    Containers::Array<char> a;
+    arrayAppend<ArrayArenaAllocator>(a, {'a', 'b', 'c'});
+
+    /* With an arena current, heap data get moved to the arena */
+    ArrayArena arena{4096};
+    ArrayArenaScope scope{&arena};
+    arrayReserve<ArrayArenaAllocator>(a, 100);
+    CORRADE_COMPARE_AS(a, Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(arena.allocatedSize(), 100,
+        TestSuite::Compare::Greater);
+}
+
+void ArrayAllocatorTest::arenaRelease() {
+    ArrayArena arena{256};
+    {
+        ArrayArenaScope scope{&arena};
+        Containers::Array<char> a, b;
+        arrayReserve<ArrayArenaAllocator>(a, 100);
+        arrayReserve<ArrayArenaAllocator>(b, 1000);
+    }
+
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    const std::size_t peak = arena.peakAllocatedSize();
+    CORRADE_COMPARE_AS(peak, 1100,
+        TestSuite::Compare::Greater);
+
+    arena.release();
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 0);
+    CORRADE_COMPARE(arena.reservedSize(), 0);
+    /* Peak is kept */
+    CORRADE_COMPARE(arena.peakAllocatedSize(), peak);
+
+    /* The arena is usable again after */
+    Containers::Array<char> c;
+    {
+        ArrayArenaScope scope{&arena};
+        arrayAppend<ArrayArenaAllocator>(c, 'c');
+    }
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+    CORRADE_COMPARE(arena.peakAllocatedSize(), peak);
+}
+
+void ArrayAllocatorTest::arenaArrayOutlivesArena() {
+    Containers::Array<char> a;
+    {
+        ArrayArena arena{4096};
+        ArrayArenaScope scope{&arena};
+        arrayAppend<ArrayArenaAllocator>(a, {'a', 'b', 'c'});
+
+        /* Release with a live array, the chunk should stay */
+        arena.release();
+        CORRADE_COMPARE(arena.chunkCount(), 0);
+    }
+
+    /* The chunk is freed only now, verified by ASan or Valgrind */
+    CORRADE_COMPARE_AS(a, Containers::arrayView({'a', 'b', 'c'}),
+        TestSuite::Compare::Container);
+    a = {};
+}
+
+void ArrayAllocatorTest::scope() {
+    CORRADE_VERIFY(!ArrayArenaScope::current());
+
+    ArrayArena a, b;
+    {
+        ArrayArenaScope scopeA{&a};
+        CORRADE_COMPARE(ArrayArenaScope::current(), &a);
+        {
+            ArrayArenaScope scopeB{&b};
+            CORRADE_COMPARE(ArrayArenaScope::current(), &b);
+        }
+        CORRADE_COMPARE(ArrayArenaScope::current(), &a);
+    }
+
+    CORRADE_VERIFY(!ArrayArenaScope::current());
+}
+
+void ArrayAllocatorTest::scopeNull() {
+    ArrayArena a;
+    ArrayArenaScope scopeA{&a};
+    {
+        /* Null leaves the current arena unchanged */
+        ArrayArenaScope scope{nullptr};
+        CORRADE_COMPARE(ArrayArenaScope::current(), &a);
+    }
+    CORRADE_COMPARE(ArrayArenaScope::current(), &a);
+}
+
+struct Importer: AbstractImporter {
+    explicit Importer(ImporterFeatures features = {}): _features{features} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData|_features; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+    void doOpenData(Containers::Array<char>&&, DataFlags) override {
+        _opened = true;
+    }
+
+    UnsignedInt doMeshCount() const override { return 64; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+        /* Build the data incrementally like an importer would */
+        Containers::Array<char> vertexData;
+        for(Float i: {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f})
+            arrayAppend<ArrayArenaAllocator>(vertexData, Containers::arrayView(reinterpret_cast<const char*>(&i), sizeof(Float)));
+        Containers::StridedArrayView1D<const Vector3> positions = Containers::arrayCast<const Vector3>(vertexData);
+        return MeshData{MeshPrimitive::Lines, Utility::move(vertexData), {
+            MeshAttributeData{MeshAttribute::Position, positions}
+        }};
+    }
+
+    ImporterFeatures _features;
+    bool _opened = false;
+};
+
+void ArrayAllocatorTest::importer() {
+    ArrayArena arena;
+
+    Importer importer;
+    CORRADE_VERIFY(!importer.arrayArena());
+    importer.setArrayArena(&arena);
+    CORRADE_COMPARE(importer.arrayArena(), &arena);
+
+    CORRADE_VERIFY(importer.openData(nullptr));
+    Containers::Optional<MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 2);
+    CORRADE_COMPARE(mesh->attribute<Vector3>(MeshAttribute::Position)[1], (Vector3{4.0f, 5.0f, 6.0f}));
+
+    /* The data got allocated from the arena and the arena isn't current
+       anymore after */
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+    CORRADE_COMPARE_AS(arena.allocatedSize(), 24,
+        TestSuite::Compare::Greater);
+    CORRADE_VERIFY(!ArrayArenaScope::current());
+}
+
+void ArrayAllocatorTest::importerNoArena() {
+    ArrayArena arena;
+    ArrayArenaScope scope{&arena};
+
+    /* With no arena set on the importer, an arena current on the calling
+       thread is used */
+    Importer importer;
+    CORRADE_VERIFY(importer.openData(nullptr));
+    CORRADE_VERIFY(importer.mesh(0));
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+}
+
+void ArrayAllocatorTest::importerParallel() {
+    /* Small chunks so the threads also race on creating new ones */
+    ArrayArena arena{256};
+
+    Importer importer{ImporterFeature::ThreadSafe};
+    importer.setArrayArena(&arena);
+    CORRADE_VERIFY(importer.openData(nullptr));
+
+    UnsignedInt ids[64];
+    for(UnsignedInt i = 0; i != Containers::arraySize(ids); ++i)
+        ids[i] = i;
+
+    /* Each mesh gets built incrementally from multiple threads at once,
+       which would corrupt the data if the arena wasn't thread-safe */
+    Containers::Array<Containers::Optional<MeshData>> meshes = importMeshes(importer, ids, 4);
+    CORRADE_COMPARE(meshes.size(), 64);
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(meshes[i]);
+        CORRADE_COMPARE_AS(meshes[i]->attribute<Vector3>(MeshAttribute::Position), Containers::arrayView({
+            Vector3{1.0f, 2.0f, 3.0f},
+            Vector3{4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+    }
+
+    CORRADE_COMPARE_AS(arena.chunkCount(), 1,
+        TestSuite::Compare::Greater);
+    CORRADE_VERIFY(!ArrayArenaScope::current());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ArrayAllocatorTest)
@@ -0,0 +1,611 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/StringIterable.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BlobTest: TestSuite::Tester {
+    explicit BlobTest();
+
+    void debugBlobType();
+    void debugBlobTypePacked();
+
+    void info();
+    void infoInvalid();
+
+    void mesh();
+    void meshNonIndexed();
+    void meshNoAttributes();
+
+    void scene();
+    void scenePointerField();
+
+    void material();
+    void materialPointerAttribute();
+
+    void image1D();
+    void image2D();
+    void image3D();
+    void imageCompressed();
+
+    void deserializeInvalid();
+    void deserializeWrongType();
+    void deserializeOutOfBounds();
+    void deserializeOwnedFlag();
+};
+
+const struct {
+    const char* name;
+    std::size_t offset;
+    std::size_t size;
+    const char* data;
+    const char* message;
+} InfoInvalidData[]{
+    {"misaligned", 1, ~std::size_t{}, nullptr,
+        "data not aligned to 8 bytes"},
+    {"too short", 0, 15, nullptr,
+        "expected at least 16 bytes for a header but got 15"},
+    {"invalid magic", 0, ~std::size_t{}, "MGNA",
+        "invalid header"},
+    {"invalid version", 0, ~std::size_t{}, "MGNB\x02",
+        "unsupported version 2, expected 1"},
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    {"wrong endianness", 0, ~std::size_t{}, "MGNB\x01""B",
+        "expected Little-Endian data"},
+    {"unknown type", 0, ~std::size_t{}, "MGNB\x01""L""\x07",
+        "unknown blob type Trade::BlobType(0x7)"},
+    #else
+    {"wrong endianness", 0, ~std::size_t{}, "MGNB\x01""L",
+        "expected Big-Endian data"},
+    {"unknown type", 0, ~std::size_t{}, "MGNB\x01""B""\x07",
+        "unknown blob type Trade::BlobType(0x7)"},
+    #endif
+    {"truncated", 0, 40, nullptr,
+        "expected 48 bytes but got only 40"},
+};
+
+BlobTest::BlobTest() {
+    addTests({&BlobTest::debugBlobType,
+              &BlobTest::debugBlobTypePacked,
+
+              &BlobTest::info});
+
+    addInstancedTests({&BlobTest::infoInvalid},
+        Containers::arraySize(InfoInvalidData));
+
+    addTests({&BlobTest::mesh,
+              &BlobTest::meshNonIndexed,
+              &BlobTest::meshNoAttributes,
+
+              &BlobTest::scene,
+              &BlobTest::scenePointerField,
+
+              &BlobTest::material,
+              &BlobTest::materialPointerAttribute,
+
+              &BlobTest::image1D,
+              &BlobTest::image2D,
+              &BlobTest::image3D,
+              &BlobTest::imageCompressed,
+
+              &BlobTest::deserializeInvalid,
+              &BlobTest::deserializeWrongType,
+              &BlobTest::deserializeOutOfBounds,
+              &BlobTest::deserializeOwnedFlag});
+}
+
+using namespace Math::Literals;
+
+void BlobTest::debugBlobType() {
+    std::ostringstream out;
+    Debug{&out} << BlobType::Scene << BlobType(0xde);
+    CORRADE_COMPARE(out.str(), "Trade::BlobType::Scene Trade::BlobType(0xde)\n");
+}
+
+void BlobTest::debugBlobTypePacked() {
+    std::ostringstream out;
+    /* Last is not packed, ones before should not make any flags persistent */
+    Debug{&out} << Debug::packed << BlobType::Image3D << Debug::packed << BlobType(0xde) << BlobType::Material;
+    CORRADE_COMPARE(out.str(), "Image3D 0xde Trade::BlobType::Material\n");
+}
+
+/* Creates a minimal valid blob to test blobInfo() and error handling on */
+Containers::Array<char> materialBlob() {
+    MaterialData material{{}, {}};
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(material);
+    CORRADE_INTERNAL_ASSERT(blob);
+    return *Utility::move(blob);
+}
+
+void BlobTest::info() {
+    Containers::Array<char> blob = materialBlob();
+    /* 16 + 32 bytes for the headers, no attribute or layer data */
+    CORRADE_COMPARE(blob.size(), 48);
+
+    Containers::Optional<Containers::Pair<BlobType, std::size_t>> info = blobInfo(blob);
+    CORRADE_VERIFY(info);
+    CORRADE_COMPARE(info->first(), BlobType::Material);
+    CORRADE_COMPARE(info->second(), 48);
+
+    /* Trailing data after the blob are ignored, which allows the blobs to be
+       concatenated */
+    Containers::Array<char> twoBlobs{ValueInit, 2*blob.size()};
+    Utility::copy(blob, twoBlobs.prefix(blob.size()));
+    Utility::copy(blob, twoBlobs.exceptPrefix(blob.size()));
+    Containers::Optional<Containers::Pair<BlobType, std::size_t>> info2 = blobInfo(twoBlobs);
+    CORRADE_VERIFY(info2);
+    CORRADE_COMPARE(info2->first(), BlobType::Material);
+    CORRADE_COMPARE(info2->second(), 48);
+}
+
+void BlobTest::infoInvalid() {
+    auto&& data = InfoInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> blob = materialBlob();
+    /* Make space for a misaligned copy */
+    Containers::Array<char> copy{ValueInit, blob.size() + 8};
+    Containers::ArrayView<char> view = copy.sliceSize(data.offset, blob.size());
+    Utility::copy(blob, view);
+    if(data.data)
+        Utility::copy(Containers::arrayView(data.data, std::strlen(data.data)), view.prefix(std::strlen(data.data)));
+    if(data.size != ~std::size_t{})
+        view = view.prefix(data.size);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!blobInfo(view));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::blobInfo(): {}\n", data.message));
+}
+
+void BlobTest::mesh() {
+    struct Vertex {
+        Vector3 position;
+        Color4ub color;
+    };
+    Containers::Array<char> vertexData{ValueInit, 3*sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+    vertices[0] = {{1.0f, 2.0f, 3.0f}, 0xff3366ff_rgba};
+    vertices[1] = {{4.0f, 5.0f, 6.0f}, 0x33ff66cc_rgba};
+    vertices[2] = {{7.0f, 8.0f, 9.0f}, 0x6633ff99_rgba};
+
+    /* Indices at an offset, to verify it's preserved */
+    Containers::Array<char> indexData{ValueInit, 2 + 4*2};
+    Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData.exceptPrefix(2));
+    indices[0] = 2;
+    indices[1] = 0;
+    indices[2] = 1;
+    indices[3] = 2;
+
+    MeshData mesh{MeshPrimitive::TriangleStrip,
+        Utility::move(indexData), MeshIndexData{indices},
+        Utility::move(vertexData), {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::Color, vertices.slice(&Vertex::color)},
+            /* Morph targets and array attributes should be preserved too */
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position), 37},
+            MeshAttributeData{meshAttributeCustom(15), VertexFormat::UnsignedByte, vertices.slice(&Vertex::color), 4}
+        }};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(mesh);
+    CORRADE_VERIFY(blob);
+    /* 16 + 64 bytes for the headers, 4*24 for attributes, 16 for aligned
+       index data, 48 for vertex data */
+    CORRADE_COMPARE(blob->size(), 16 + 64 + 4*24 + 16 + 48);
+
+    Containers::Optional<MeshData> out = deserializeMeshBlob(*blob, DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->primitive(), MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE(out->indexDataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(out->vertexDataFlags(), DataFlag::ExternallyOwned);
+
+    /* The data should point to the blob, not be a copy */
+    CORRADE_VERIFY(out->indexData().data() > blob->data());
+    CORRADE_VERIFY(out->vertexData().data() > out->indexData().data());
+    CORRADE_VERIFY(out->vertexData().end() <= blob->end());
+
+    CORRADE_VERIFY(out->isIndexed());
+    CORRADE_COMPARE(out->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(out->indexOffset(), 2);
+    CORRADE_COMPARE_AS(out->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->vertexCount(), 3);
+    CORRADE_COMPARE(out->attributeCount(), 4);
+    CORRADE_COMPARE(out->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(out->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(out->attributeOffset(0), 0);
+    CORRADE_COMPARE(out->attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE_AS(out->attribute<Vector3>(0), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->attributeName(1), MeshAttribute::Color);
+    CORRADE_COMPARE(out->attributeFormat(1), VertexFormat::Vector4ubNormalized);
+    CORRADE_COMPARE(out->attributeOffset(1), sizeof(Vector3));
+    CORRADE_COMPARE_AS(out->attribute<Color4ub>(1), Containers::arrayView<Color4ub>({
+        0xff3366ff_rgba, 0x33ff66cc_rgba, 0x6633ff99_rgba
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->attributeName(2), MeshAttribute::Position);
+    CORRADE_COMPARE(out->attributeMorphTargetId(2), 37);
+
+    CORRADE_COMPARE(out->attributeName(3), meshAttributeCustom(15));
+    CORRADE_COMPARE(out->attributeFormat(3), VertexFormat::UnsignedByte);
+    CORRADE_COMPARE(out->attributeArraySize(3), 4);
+    CORRADE_COMPARE(out->attributeMorphTargetId(3), -1);
+}
+
+void BlobTest::meshNonIndexed() {
+    const Vector2 positions[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    MeshData mesh{MeshPrimitive::Lines, {}, positions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(mesh);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<MeshData> out = deserializeMeshBlob(*blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(out->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(out->vertexDataFlags(), DataFlags{});
+    CORRADE_VERIFY(!out->isIndexed());
+    CORRADE_COMPARE(out->vertexCount(), 2);
+    CORRADE_COMPARE_AS(out->attribute<Vector2>(MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
+void BlobTest::meshNoAttributes() {
+    MeshData mesh{MeshPrimitive::Points, 37};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(mesh);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->size(), 16 + 64);
+
+    Containers::Optional<MeshData> out = deserializeMeshBlob(*blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!out->isIndexed());
+    CORRADE_COMPARE(out->attributeCount(), 0);
+    CORRADE_COMPARE(out->vertexCount(), 37);
+}
+
+void BlobTest::scene() {
+    struct Data {
+        UnsignedInt mapping[3];
+        Int parent[3];
+        UnsignedInt nameOffsets[3];
+        char names[12];
+        UnsignedByte visible[1];
+    };
+    Containers::Array<char> data{ValueInit, sizeof(Data)};
+    Data& d = *reinterpret_cast<Data*>(data.data());
+    d.mapping[0] = 0;
+    d.mapping[1] = 2;
+    d.mapping[2] = 4;
+    d.parent[0] = -1;
+    d.parent[1] = 0;
+    d.parent[2] = 2;
+    /* String end offsets */
+    d.nameOffsets[0] = 3;
+    d.nameOffsets[1] = 7;
+    d.nameOffsets[2] = 10;
+    std::memcpy(d.names, "armhandleg", 10);
+    d.visible[0] = 0x0a; /* 0b1010, bits 1 to 3 */
+
+    SceneData scene{SceneMappingType::UnsignedInt, 5, Utility::move(data), {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(d.mapping), Containers::arrayView(d.parent), SceneFieldFlag::OrderedMapping},
+        SceneFieldData{sceneFieldCustom(3), SceneMappingType::UnsignedInt, Containers::stridedArrayView(d.mapping), d.names, SceneFieldType::StringOffset32, Containers::stridedArrayView(d.nameOffsets)},
+        SceneFieldData{sceneFieldCustom(5), Containers::arrayView(d.mapping), Containers::StridedBitArrayView1D{Containers::BitArrayView{d.visible, 1, 3}}},
+        /* Empty fields shouldn't cause any issues */
+        SceneFieldData{SceneField::Translation, SceneMappingType::UnsignedInt, nullptr, SceneFieldType::Vector3, nullptr},
+    }};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(scene);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<SceneData> out = deserializeSceneBlob(*blob, DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(out->mappingType(), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(out->mappingBound(), 5);
+    CORRADE_COMPARE(out->fieldCount(), 4);
+    CORRADE_VERIFY(out->data().data() > blob->data());
+    CORRADE_VERIFY(out->data().end() <= blob->end());
+
+    CORRADE_COMPARE(out->fieldName(0), SceneField::Parent);
+    CORRADE_COMPARE(out->fieldFlags(0), SceneFieldFlag::OffsetOnly|SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(out->mapping<UnsignedInt>(0),
+        Containers::arrayView<UnsignedInt>({0, 2, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out->field<Int>(0),
+        Containers::arrayView<Int>({-1, 0, 2}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->fieldName(1), sceneFieldCustom(3));
+    CORRADE_COMPARE(out->fieldType(1), SceneFieldType::StringOffset32);
+    Containers::StringIterable strings = out->fieldStrings(1);
+    CORRADE_COMPARE(strings.size(), 3);
+    CORRADE_COMPARE(strings[0], "arm");
+    CORRADE_COMPARE(strings[1], "hand");
+    CORRADE_COMPARE(strings[2], "leg");
+
+    CORRADE_COMPARE(out->fieldName(2), sceneFieldCustom(5));
+    CORRADE_COMPARE(out->fieldType(2), SceneFieldType::Bit);
+    Containers::StridedBitArrayView1D bits = out->fieldBits(2);
+    CORRADE_COMPARE(bits.size(), 3);
+    CORRADE_VERIFY(bits[0]);
+    CORRADE_VERIFY(!bits[1]);
+    CORRADE_VERIFY(bits[2]);
+
+    CORRADE_COMPARE(out->fieldName(3), SceneField::Translation);
+    CORRADE_COMPARE(out->fieldType(3), SceneFieldType::Vector3);
+    CORRADE_COMPARE(out->fieldSize(3), 0);
+}
+
+void BlobTest::scenePointerField() {
+    const struct Data {
+        const void* pointer[1];
+        UnsignedByte mapping[1];
+    } data{{this}, {0}};
+    SceneData scene{SceneMappingType::UnsignedByte, 1, {}, Containers::ArrayView<const void>{&data, sizeof(Data)}, {
+        SceneFieldData{sceneFieldCustom(7), Containers::arrayView(data.mapping), Containers::arrayView(data.pointer)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!serializeBlob(scene));
+    CORRADE_COMPARE(out.str(), "Trade::serializeBlob(): can't serialize a Trade::SceneFieldType::Pointer field Trade::SceneField::Custom(7)\n");
+}
+
+void BlobTest::material() {
+    MaterialData material{MaterialType::Phong|MaterialType::PbrClearCoat, {
+        {MaterialAttribute::DiffuseColor, 0x3bd26799_rgbaf},
+        {MaterialAttribute::DiffuseTexture, 5u},
+        {"highlightColor", 0x335566ff_rgbaf},
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::LayerFactor, 0.5f}
+    }, {3, 5}};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(material);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<MaterialData> out = deserializeMaterialBlob(*blob, DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->types(), MaterialType::Phong|MaterialType::PbrClearCoat);
+    CORRADE_COMPARE(out->attributeDataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(out->layerDataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out->attributeData().data() > static_cast<const void*>(blob->data()));
+    CORRADE_COMPARE(out->layerCount(), 2);
+    CORRADE_COMPARE(out->attributeCount(0), 3);
+    CORRADE_COMPARE(out->attributeCount(1), 2);
+    CORRADE_COMPARE(out->attribute<Color4>(MaterialAttribute::DiffuseColor), 0x3bd26799_rgbaf);
+    CORRADE_COMPARE(out->attribute<UnsignedInt>(MaterialAttribute::DiffuseTexture), 5);
+    CORRADE_COMPARE(out->attribute<Color4>("highlightColor"), 0x335566ff_rgbaf);
+    CORRADE_COMPARE(out->layerName(1), "ClearCoat");
+    CORRADE_COMPARE(out->attribute<Float>(1, MaterialAttribute::LayerFactor), 0.5f);
+}
+
+void BlobTest::materialPointerAttribute() {
+    MaterialData material{{}, {
+        {MaterialAttribute::DiffuseColor, 0x3bd26799_rgbaf},
+        {"pointer", static_cast<const void*>(this)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!serializeBlob(material));
+    CORRADE_COMPARE(out.str(), "Trade::serializeBlob(): can't serialize a Trade::MaterialAttributeType::Pointer attribute pointer\n");
+}
+
+void BlobTest::image1D() {
+    const Color4ub pixels[]{0xff3366ff_rgba, 0x33ff66cc_rgba, 0x6633ff99_rgba};
+    ImageData1D image{PixelFormat::RGBA8Unorm, 3, {}, pixels};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(image);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<ImageData1D> out = deserializeImage1DBlob(*blob, DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out);
+    CORRADE_VERIFY(!out->isCompressed());
+    CORRADE_COMPARE(out->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(out->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(out->size(), 3);
+    CORRADE_COMPARE_AS(out->pixels<Color4ub>(),
+        Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void BlobTest::image2D() {
+    /* Custom storage, implementation-specific format and flags should all be
+       preserved */
+    const char data[4*3*2]{
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+        13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24
+    };
+    ImageData2D image{PixelStorage{}.setAlignment(1).setSkip({0, 1, 0}),
+        0xdeadu, 0xbeefu, 6, {2, 1}, {}, data, ImageFlag2D::Array};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(image);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<ImageData2D> out = deserializeImage2DBlob(*blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->storage().alignment(), 1);
+    CORRADE_COMPARE(out->storage().skip(), (Vector3i{0, 1, 0}));
+    CORRADE_COMPARE(out->format(), pixelFormatWrap(0xdead));
+    CORRADE_COMPARE(out->formatExtra(), 0xbeef);
+    CORRADE_COMPARE(out->pixelSize(), 6);
+    CORRADE_COMPARE(out->size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out->flags(), ImageFlag2D::Array);
+    CORRADE_COMPARE_AS(out->data(),
+        Containers::arrayView(data),
+        TestSuite::Compare::Container);
+}
+
+void BlobTest::image3D() {
+    const UnsignedShort pixels[]{1, 2, 3, 4, 5, 6, 7, 8};
+    ImageData3D image{PixelFormat::R16UI, {2, 2, 2}, {}, pixels, ImageFlag3D::Array};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(image);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<ImageData3D> out = deserializeImage3DBlob(*blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->format(), PixelFormat::R16UI);
+    CORRADE_COMPARE(out->size(), (Vector3i{2, 2, 2}));
+    CORRADE_COMPARE(out->flags(), ImageFlag3D::Array);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(out->data()),
+        Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void BlobTest::imageCompressed() {
+    const char data[16]{
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+    };
+    ImageData2D image{CompressedPixelStorage{}
+        .setCompressedBlockSize({4, 4, 1})
+        .setCompressedBlockDataSize(16),
+        CompressedPixelFormat::Bc3RGBAUnorm, {4, 4}, {}, data};
+
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(image);
+    CORRADE_VERIFY(blob);
+
+    Containers::Optional<ImageData2D> out = deserializeImage2DBlob(*blob, DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(out);
+    CORRADE_VERIFY(out->isCompressed());
+    CORRADE_COMPARE(out->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(out->compressedFormat(), CompressedPixelFormat::Bc3RGBAUnorm);
+    CORRADE_COMPARE(out->compressedStorage().compressedBlockSize(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE(out->compressedStorage().compressedBlockDataSize(), 16);
+    CORRADE_COMPARE(out->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE_AS(out->data(),
+        Containers::arrayView(data),
+        TestSuite::Compare::Container);
+}
+
+void BlobTest::deserializeInvalid() {
+    /* Just to verify that header checks are done for all, the actual checks
+       are tested in infoInvalid() */
+    Containers::Array<char> data{ValueInit, 16};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!deserializeMeshBlob(data));
+    CORRADE_VERIFY(!deserializeSceneBlob(data));
+    CORRADE_VERIFY(!deserializeMaterialBlob(data));
+    CORRADE_VERIFY(!deserializeImage1DBlob(data));
+    CORRADE_VERIFY(!deserializeImage2DBlob(data));
+    CORRADE_VERIFY(!deserializeImage3DBlob(data));
+    CORRADE_COMPARE(out.str(),
+        "Trade::deserializeMeshBlob(): invalid header\n"
+        "Trade::deserializeSceneBlob(): invalid header\n"
+        "Trade::deserializeMaterialBlob(): invalid header\n"
+        "Trade::deserializeImage1DBlob(): invalid header\n"
+        "Trade::deserializeImage2DBlob(): invalid header\n"
+        "Trade::deserializeImage3DBlob(): invalid header\n");
+}
+
+void BlobTest::deserializeWrongType() {
+    Containers::Array<char> blob = materialBlob();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!deserializeMeshBlob(blob));
+    CORRADE_VERIFY(!deserializeImage2DBlob(blob));
+    CORRADE_COMPARE(out.str(),
+        "Trade::deserializeMeshBlob(): expected a Trade::BlobType::Mesh blob but got Trade::BlobType::Material\n"
+        "Trade::deserializeImage2DBlob(): expected a Trade::BlobType::Image2D blob but got Trade::BlobType::Material\n");
+}
+
+void BlobTest::deserializeOutOfBounds() {
+    const Color4ub pixels[]{0xff3366ff_rgba, 0x33ff66cc_rgba, 0x6633ff99_rgba};
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(ImageData1D{PixelFormat::RGBA8Unorm, 3, {}, pixels});
+    CORRADE_VERIFY(blob);
+
+    /* Data size is right after the data offset in the image header */
+    UnsignedLong& dataSize = *reinterpret_cast<UnsignedLong*>(blob->data() + 16 + 8);
+    CORRADE_COMPARE(dataSize, 12);
+    dataSize = 200;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!deserializeImage1DBlob(*blob));
+    CORRADE_COMPARE(out.str(), "Trade::deserializeImage1DBlob(): image data of 200 bytes at offset 104 out of bounds for a blob of 120 bytes\n");
+}
+
+void BlobTest::deserializeOwnedFlag() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::Array<char> blob = materialBlob();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    deserializeMeshBlob(blob, DataFlag::Owned);
+    deserializeSceneBlob(blob, DataFlag::Owned|DataFlag::Mutable);
+    deserializeMaterialBlob(blob, DataFlag::Owned);
+    deserializeImage1DBlob(blob, DataFlag::Owned);
+    deserializeImage2DBlob(blob, DataFlag::Owned);
+    deserializeImage3DBlob(blob, DataFlag::Owned);
+    CORRADE_COMPARE(out.str(),
+        "Trade::deserializeMeshBlob(): can't deserialize with Trade::DataFlag::Owned\n"
+        "Trade::deserializeSceneBlob(): can't deserialize with Trade::DataFlag::Owned\n"
+        "Trade::deserializeMaterialBlob(): can't deserialize with Trade::DataFlag::Owned\n"
+        "Trade::deserializeImage1DBlob(): can't deserialize with Trade::DataFlag::Owned\n"
+        "Trade::deserializeImage2DBlob(): can't deserialize with Trade::DataFlag::Owned\n"
+        "Trade::deserializeImage3DBlob(): can't deserialize with Trade::DataFlag::Owned\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlobTest)
@@ -25,11 +25,16 @@
 
 #include <cstdlib>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringIterable.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/TestSuite/Compare/StringToFile.h>
 #include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Path.h>
@@ -45,6 +50,11 @@ struct ImageConverterTest: TestSuite::Tester {
     explicit ImageConverterTest();
 
     void info();
+    void streamRows();
+
+    void batch();
+    void batchFailed();
+    void batchProfile();
 };
 
 using namespace Containers::Literals;
@@ -95,10 +105,38 @@ const struct {
         "info-data-ignored-output.txt"}
 };
 
+const struct {
+    const char* name;
+    const char* options;
+} StreamRowsData[]{
+    {"", "rle=false"},
+    /* With rleAcrossScanlines disabled the RLE output is the same as well */
+    {"RLE", "rle=true,rleFallbackIfLarger=false"}
+};
+
+const struct {
+    const char* name;
+    Containers::Array<Containers::String> args;
+} BatchData[]{
+    {"", {}},
+    {"single thread", {InPlaceInit, {"--threads", "1"}}},
+    {"more threads than files", {InPlaceInit, {"--threads", "16"}}},
+    {"map", {InPlaceInit, {"--map"}}}
+};
+
 ImageConverterTest::ImageConverterTest() {
     addInstancedTests({&ImageConverterTest::info},
         Containers::arraySize(InfoData));
 
+    addInstancedTests({&ImageConverterTest::streamRows},
+        Containers::arraySize(StreamRowsData));
+
+    addInstancedTests({&ImageConverterTest::batch},
+        Containers::arraySize(BatchData));
+
+    addTests({&ImageConverterTest::batchFailed,
+              &ImageConverterTest::batchProfile});
+
     /* Create output dir, if doesn't already exist */
     Utility::Path::make(Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles"));
 }
@@ -123,6 +161,18 @@ Containers::Pair<bool, Containers::String> call(const Containers::StringIterable
 
     return {success, Utility::move(*output)};
 }
+
+/* The conversion tests go through TgaImporter and TgaImageConverter, returns
+   the first of them that can't be loaded or nullptr if both can */
+const char* missingTgaPlugin() {
+    PluginManager::Manager<Trade::AbstractImporter> importerManager{MAGNUM_PLUGINS_IMPORTER_INSTALL_DIR};
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager{MAGNUM_PLUGINS_IMAGECONVERTER_INSTALL_DIR};
+    if(!(importerManager.load("TgaImporter") & PluginManager::LoadState::Loaded))
+        return "TgaImporter";
+    if(!(converterManager.load("TgaImageConverter") & PluginManager::LoadState::Loaded))
+        return "TgaImageConverter";
+    return nullptr;
+}
 #endif
 
 }
@@ -153,6 +203,181 @@ void ImageConverterTest::info() {
     #endif
 }
 
+void ImageConverterTest::streamRows() {
+    auto&& data = StreamRowsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef IMAGECONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-imageconverter not built, can't test");
+    #else
+    if(const char* plugin = missingTgaPlugin())
+        CORRADE_SKIP(plugin << "plugin can't be loaded.");
+
+    const Containers::String input = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/file.tga");
+    const Containers::String expected = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/stream-rows-expected.tga");
+    const Containers::String actual = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/stream-rows.tga");
+    for(const Containers::String& file: {expected, actual})
+        if(Utility::Path::exists(file))
+            CORRADE_VERIFY(Utility::Path::remove(file));
+
+    /* Convert the whole image at once first to have something to compare
+       to */
+    {
+        Containers::Pair<bool, Containers::String> output = call({"-I", "TgaImporter", "-C", "TgaImageConverter", "-c", data.options, input, expected});
+        CORRADE_COMPARE(output.second(), "");
+        CORRADE_VERIFY(output.first());
+    }
+
+    /* The image has three rows, so this results in a full band and a
+       partial one */
+    {
+        Containers::Pair<bool, Containers::String> output = call({"-I", "TgaImporter", "-C", "TgaImageConverter", "-c", data.options, "--stream-rows", "2", input, actual});
+        CORRADE_COMPARE(output.second(), "");
+        CORRADE_VERIFY(output.first());
+    }
+
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::File);
+    #endif
+}
+
+void ImageConverterTest::batch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef IMAGECONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-imageconverter not built, can't test");
+    #else
+    if(const char* plugin = missingTgaPlugin())
+        CORRADE_SKIP(plugin << "plugin can't be loaded.");
+
+    const Containers::String input = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/file.tga");
+    const Containers::String expected = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-expected.tga");
+    const Containers::String manifest = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch.txt");
+    Containers::String actual[3];
+    for(std::size_t i = 0; i != Containers::arraySize(actual); ++i) {
+        actual[i] = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, Utility::format("ImageConverterTestFiles/batch{}.tga", i));
+        if(Utility::Path::exists(actual[i]))
+            CORRADE_VERIFY(Utility::Path::remove(actual[i]));
+    }
+
+    /* Convert the file alone first to have something to compare to */
+    {
+        Containers::Pair<bool, Containers::String> output = call({"-I", "TgaImporter", "-C", "TgaImageConverter", input, expected});
+        CORRADE_COMPARE(output.second(), "");
+        CORRADE_VERIFY(output.first());
+    }
+
+    /* Comments and empty lines are skipped, the separator is any
+       whitespace */
+    CORRADE_VERIFY(Utility::Path::write(manifest, Containers::StringView{Utility::format(
+        "# input output\n"
+        "{} {}\n"
+        "\n"
+        "  {}\t\t{}\n"
+        "{}   {}", input, actual[0], input, actual[1], input, actual[2])}));
+
+    Containers::Array<Containers::String> args{InPlaceInit, {"-I", "TgaImporter", "-C", "TgaImageConverter", "--batch", manifest}};
+    for(const Containers::String& arg: data.args)
+        arrayAppend(args, arg);
+    Containers::Pair<bool, Containers::String> output = call(args);
+    CORRADE_COMPARE(output.second(), "");
+    CORRADE_VERIFY(output.first());
+
+    for(const Containers::String& file: actual) {
+        CORRADE_ITERATION(file);
+        CORRADE_COMPARE_AS(file, expected, TestSuite::Compare::File);
+    }
+    #endif
+}
+
+void ImageConverterTest::batchFailed() {
+    #ifndef IMAGECONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-imageconverter not built, can't test");
+    #else
+    if(const char* plugin = missingTgaPlugin())
+        CORRADE_SKIP(plugin << "plugin can't be loaded.");
+
+    const Containers::String input = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/file.tga");
+    const Containers::String nonexistent = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/nonexistent.tga");
+    const Containers::String manifest = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-failed.txt");
+    const Containers::String failed = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-failed0.tga");
+    const Containers::String succeeded = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-failed1.tga");
+    for(const Containers::String& file: {failed, succeeded})
+        if(Utility::Path::exists(file))
+            CORRADE_VERIFY(Utility::Path::remove(file));
+
+    CORRADE_VERIFY(Utility::Path::write(manifest, Containers::StringView{Utility::format(
+        "{} {}\n"
+        "{} {}\n", nonexistent, failed, input, succeeded)}));
+
+    /* Single thread to have the messages in a predictable order */
+    Containers::Pair<bool, Containers::String> output = call({"-I", "TgaImporter", "-C", "TgaImageConverter", "--threads", "1", "--batch", manifest});
+    CORRADE_COMPARE_AS(output.second(),
+        Utility::format("Cannot open file {}\n", nonexistent),
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(output.second(),
+        Utility::format("Failed to convert 1 out of 2 files listed in {}\n", manifest),
+        TestSuite::Compare::StringHasSuffix);
+    CORRADE_VERIFY(!output.first());
+
+    /* The failure doesn't prevent the other file from being converted */
+    CORRADE_VERIFY(!Utility::Path::exists(failed));
+    CORRADE_VERIFY(Utility::Path::exists(succeeded));
+    #endif
+}
+
+void ImageConverterTest::batchProfile() {
+    #ifndef IMAGECONVERTER_EXECUTABLE_FILENAME
+    CORRADE_SKIP("magnum-imageconverter not built, can't test");
+    #else
+    if(const char* plugin = missingTgaPlugin())
+        CORRADE_SKIP(plugin << "plugin can't be loaded.");
+
+    const Containers::String input = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/file.tga");
+    const Containers::String nonexistent = Utility::Path::join(TRADE_TEST_DIR, "ImageConverterTestFiles/nonexistent.tga");
+    const Containers::String manifest = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-profile.txt");
+    const Containers::String output0 = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-profile0.tga");
+    const Containers::String output1 = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-profile1.tga");
+    const Containers::String output2 = Utility::Path::join(TRADE_TEST_OUTPUT_DIR, "ImageConverterTestFiles/batch-profile2.tga");
+
+    CORRADE_VERIFY(Utility::Path::write(manifest, Containers::StringView{Utility::format(
+        "{} {}\n"
+        "{} {}\n"
+        "{} {}\n", input, output0, nonexistent, output1, input, output2)}));
+
+    Containers::Pair<bool, Containers::String> output = call({"-I", "TgaImporter", "-C", "TgaImageConverter", "--threads", "2", "--batch", manifest, "--profile"});
+    CORRADE_VERIFY(!output.first());
+
+    /* The timing is different every time, so check just the structure. The
+       per-file lines are in the manifest order regardless of which thread
+       converted which file, and are printed after all errors. */
+    const Containers::Array<Containers::StringView> lines = output.second().splitWithoutEmptyParts('\n');
+    CORRADE_COMPARE_AS(lines.size(), std::size_t{5},
+        TestSuite::Compare::GreaterOrEqual);
+    const Containers::ArrayView<const Containers::StringView> profile = lines.exceptPrefix(lines.size() - 5);
+    CORRADE_COMPARE_AS(profile[0],
+        Utility::format("{} -> {}: import took ", input, output0),
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(profile[1],
+        Utility::format("{} -> {}: (failed) import took ", nonexistent, output1),
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(profile[2],
+        Utility::format("{} -> {}: import took ", input, output2),
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(profile[3],
+        "Import took ",
+        TestSuite::Compare::StringHasPrefix);
+    CORRADE_COMPARE_AS(profile[3],
+        "seconds in total, batch of 3 files took ",
+        TestSuite::Compare::StringContains);
+    CORRADE_COMPARE_AS(profile[3],
+        " seconds in 2 threads",
+        TestSuite::Compare::StringHasSuffix);
+    CORRADE_COMPARE(profile[4],
+        Utility::format("Failed to convert 1 out of 3 files listed in {}", manifest));
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ImageConverterTest)
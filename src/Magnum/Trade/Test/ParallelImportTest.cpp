@@ -0,0 +1,279 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelImport.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ParallelImportTest: TestSuite::Tester {
+    explicit ParallelImportTest();
+
+    void meshes();
+    void materials();
+    void images();
+    void notThreadSafe();
+    void empty();
+
+    void noFile();
+    void outOfRange();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadCountData[]{
+    {"autodetected thread count", 0},
+    {"single thread", 1},
+    {"three threads", 3},
+    {"more threads than items", 64}
+};
+
+/* Returns data derived from the ID and fails for ID 3 */
+struct Importer: AbstractImporter {
+    explicit Importer(ImporterFeatures features): _features{features} {}
+
+    ImporterFeatures doFeatures() const override { return _features; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 6; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+        record();
+        if(id == 3) return {};
+        return MeshData{MeshPrimitive::Points, id*10};
+    }
+
+    UnsignedInt doMaterialCount() const override { return 6; }
+    Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override {
+        record();
+        if(id == 3) return {};
+        return MaterialData{{}, {
+            {"id", id*10}
+        }};
+    }
+
+    UnsignedInt doImage1DCount() const override { return 6; }
+    Containers::Optional<ImageData1D> doImage1D(UnsignedInt id, UnsignedInt) override {
+        record();
+        if(id == 3) return {};
+        return ImageData1D{PixelFormat::R8Unorm, Int(4*(id + 1)), Containers::Array<char>{ValueInit, 4*(id + 1)}};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 6; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        record();
+        if(id == 3) return {};
+        return ImageData2D{PixelFormat::R8Unorm, {4, Int(id + 1)}, Containers::Array<char>{ValueInit, 4*(id + 1)}};
+    }
+
+    UnsignedInt doImage3DCount() const override { return 6; }
+    Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt) override {
+        record();
+        if(id == 3) return {};
+        return ImageData3D{PixelFormat::R8Unorm, {4, 1, Int(id + 1)}, Containers::Array<char>{ValueInit, 4*(id + 1)}};
+    }
+
+    void record() {
+        ++callCount;
+        if(std::this_thread::get_id() != mainThread)
+            calledFromOtherThread = true;
+    }
+
+    ImporterFeatures _features;
+    bool _opened = true;
+    std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<UnsignedInt> callCount{0};
+    std::atomic<bool> calledFromOtherThread{false};
+};
+
+ParallelImportTest::ParallelImportTest() {
+    addInstancedTests({&ParallelImportTest::meshes,
+                       &ParallelImportTest::materials,
+                       &ParallelImportTest::images},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&ParallelImportTest::notThreadSafe,
+              &ParallelImportTest::empty,
+
+              &ParallelImportTest::noFile,
+              &ParallelImportTest::outOfRange});
+}
+
+void ParallelImportTest::meshes() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer{ImporterFeature::ThreadSafe};
+
+    const UnsignedInt ids[]{5, 0, 3, 2, 2, 4, 1};
+    Containers::Array<Containers::Optional<MeshData>> out = importMeshes(importer, ids, data.threadCount);
+    CORRADE_COMPARE(out.size(), 7);
+    CORRADE_COMPARE(importer.callCount.load(), 7);
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        CORRADE_ITERATION(i);
+        if(ids[i] == 3) {
+            CORRADE_VERIFY(!out[i]);
+        } else {
+            CORRADE_VERIFY(out[i]);
+            CORRADE_COMPARE(out[i]->vertexCount(), ids[i]*10);
+        }
+    }
+}
+
+void ParallelImportTest::materials() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer{ImporterFeature::ThreadSafe};
+
+    const UnsignedInt ids[]{5, 0, 3, 2, 2, 4, 1};
+    Containers::Array<Containers::Optional<MaterialData>> out = importMaterials(importer, ids, data.threadCount);
+    CORRADE_COMPARE(out.size(), 7);
+    CORRADE_COMPARE(importer.callCount.load(), 7);
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        CORRADE_ITERATION(i);
+        if(ids[i] == 3) {
+            CORRADE_VERIFY(!out[i]);
+        } else {
+            CORRADE_VERIFY(out[i]);
+            CORRADE_COMPARE(out[i]->attribute<UnsignedInt>("id"), ids[i]*10);
+        }
+    }
+}
+
+void ParallelImportTest::images() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer{ImporterFeature::ThreadSafe};
+
+    const UnsignedInt ids[]{5, 0, 3, 2, 2, 4, 1};
+    Containers::Array<Containers::Optional<ImageData1D>> out1D = importImages1D(importer, ids, data.threadCount);
+    Containers::Array<Containers::Optional<ImageData2D>> out2D = importImages2D(importer, ids, data.threadCount);
+    Containers::Array<Containers::Optional<ImageData3D>> out3D = importImages3D(importer, ids, data.threadCount);
+    CORRADE_COMPARE(out1D.size(), 7);
+    CORRADE_COMPARE(out2D.size(), 7);
+    CORRADE_COMPARE(out3D.size(), 7);
+    CORRADE_COMPARE(importer.callCount.load(), 21);
+    for(std::size_t i = 0; i != out1D.size(); ++i) {
+        CORRADE_ITERATION(i);
+        if(ids[i] == 3) {
+            CORRADE_VERIFY(!out1D[i]);
+            CORRADE_VERIFY(!out2D[i]);
+            CORRADE_VERIFY(!out3D[i]);
+        } else {
+            CORRADE_VERIFY(out1D[i]);
+            CORRADE_VERIFY(out2D[i]);
+            CORRADE_VERIFY(out3D[i]);
+            CORRADE_COMPARE(out1D[i]->size(), Int(4*(ids[i] + 1)));
+            CORRADE_COMPARE(out2D[i]->size(), (Vector2i{4, Int(ids[i] + 1)}));
+            CORRADE_COMPARE(out3D[i]->size(), (Vector3i{4, 1, Int(ids[i] + 1)}));
+        }
+    }
+}
+
+void ParallelImportTest::notThreadSafe() {
+    Importer importer{ImporterFeatures{}};
+
+    /* Even though more threads are requested, everything should be imported
+       on the calling thread */
+    const UnsignedInt ids[]{5, 0, 3, 2, 2, 4, 1};
+    Containers::Array<Containers::Optional<MeshData>> out = importMeshes(importer, ids, 4);
+    CORRADE_COMPARE(out.size(), 7);
+    CORRADE_COMPARE(importer.callCount.load(), 7);
+    CORRADE_VERIFY(!importer.calledFromOtherThread);
+    CORRADE_VERIFY(out[0]);
+    CORRADE_COMPARE(out[0]->vertexCount(), 50);
+}
+
+void ParallelImportTest::empty() {
+    Importer importer{ImporterFeature::ThreadSafe};
+
+    Containers::Array<Containers::Optional<MeshData>> out = importMeshes(importer, nullptr);
+    CORRADE_COMPARE(out.size(), 0);
+    CORRADE_COMPARE(importer.callCount.load(), 0);
+}
+
+void ParallelImportTest::noFile() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafe};
+    importer._opened = false;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importMeshes(importer, nullptr);
+    importMaterials(importer, nullptr);
+    importImages1D(importer, nullptr);
+    importImages2D(importer, nullptr);
+    importImages3D(importer, nullptr);
+    CORRADE_COMPARE(out.str(),
+        "Trade::importMeshes(): no file opened\n"
+        "Trade::importMaterials(): no file opened\n"
+        "Trade::importImages1D(): no file opened\n"
+        "Trade::importImages2D(): no file opened\n"
+        "Trade::importImages3D(): no file opened\n");
+}
+
+void ParallelImportTest::outOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Importer importer{ImporterFeature::ThreadSafe};
+
+    const UnsignedInt ids[]{5, 0, 6, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importMeshes(importer, ids);
+    importMaterials(importer, ids);
+    importImages1D(importer, ids);
+    importImages2D(importer, ids);
+    importImages3D(importer, ids);
+    CORRADE_COMPARE(importer.callCount.load(), 0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::importMeshes(): index 6 out of range for 6 entries\n"
+        "Trade::importMaterials(): index 6 out of range for 6 entries\n"
+        "Trade::importImages1D(): index 6 out of range for 6 entries\n"
+        "Trade::importImages2D(): index 6 out of range for 6 entries\n"
+        "Trade::importImages3D(): index 6 out of range for 6 entries\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ParallelImportTest)
@@ -0,0 +1,403 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/ParallelImport.h"
+#include "Magnum/Trade/Profiler.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ProfilerTest: TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void construct();
+    void addRecord();
+    void clear();
+    void peakAllocation();
+    void chromeTrace();
+    void chromeTraceEscaping();
+
+    void importer();
+    void importerNoProfiler();
+    void importerParallel();
+    void imageConverter();
+    void sceneConverter();
+    void sceneConverterMultiple();
+};
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::construct,
+              &ProfilerTest::addRecord,
+              &ProfilerTest::clear,
+              &ProfilerTest::peakAllocation,
+              &ProfilerTest::chromeTrace,
+              &ProfilerTest::chromeTraceEscaping,
+
+              &ProfilerTest::importer,
+              &ProfilerTest::importerNoProfiler,
+              &ProfilerTest::importerParallel,
+              &ProfilerTest::imageConverter,
+              &ProfilerTest::sceneConverter,
+              &ProfilerTest::sceneConverterMultiple});
+}
+
+/* Vertex data size is 12 bytes for each vertex, fails for ID 3 */
+struct Importer: AbstractImporter {
+    explicit Importer(ImporterFeatures features = {}): _features{features} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData|_features; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+    void doOpenData(Containers::Array<char>&&, DataFlags) override {
+        _opened = true;
+    }
+
+    UnsignedInt doMeshCount() const override { return 6; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+        if(id == 3) return {};
+        return MeshData{MeshPrimitive::Points, Containers::Array<char>{id*12}, {
+            MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 0, id, 12}
+        }};
+    }
+
+    private:
+        ImporterFeatures _features;
+        bool _opened = false;
+};
+
+void ProfilerTest::construct() {
+    Profiler profiler;
+    CORRADE_VERIFY(profiler.records().isEmpty());
+    CORRADE_COMPARE(profiler.peakAllocation(), 0);
+
+    const UnsignedLong time = profiler.time();
+    CORRADE_COMPARE_AS(profiler.time(), time,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void ProfilerTest::addRecord() {
+    Profiler profiler;
+    profiler.addRecord({"first()", "SomePlugin", 3, 777, 15, 20, 1, 2, 3});
+    profiler.addRecord({"second()", {}, ~UnsignedInt{}, 777, 25, 30, 4, 5, 6});
+    CORRADE_COMPARE(profiler.records().size(), 2);
+
+    const ProfilerRecord& first = profiler.records()[0];
+    CORRADE_COMPARE(Containers::StringView{first.function}, "first()");
+    CORRADE_COMPARE(first.plugin, "SomePlugin");
+    CORRADE_COMPARE(first.id, 3);
+    /* The thread index gets overwritten */
+    CORRADE_COMPARE(first.thread, 0);
+    CORRADE_COMPARE(first.begin, 15);
+    CORRADE_COMPARE(first.duration, 20);
+    CORRADE_COMPARE(first.bytesIn, 1);
+    CORRADE_COMPARE(first.bytesOut, 2);
+    CORRADE_COMPARE(first.peakAllocation, 3);
+
+    const ProfilerRecord& second = profiler.records()[1];
+    CORRADE_COMPARE(Containers::StringView{second.function}, "second()");
+    CORRADE_COMPARE(second.plugin, "");
+    CORRADE_COMPARE(second.id, ~UnsignedInt{});
+    CORRADE_COMPARE(second.thread, 0);
+}
+
+void ProfilerTest::clear() {
+    Profiler profiler;
+    profiler.addRecord({"first()", {}, 0, 0, 0, 0, 0, 0, 0});
+    profiler.addRecord({"second()", {}, 0, 0, 0, 0, 0, 0, 0});
+    CORRADE_COMPARE(profiler.records().size(), 2);
+
+    profiler.clear();
+    CORRADE_VERIFY(profiler.records().isEmpty());
+}
+
+void ProfilerTest::peakAllocation() {
+    Importer importer;
+    Profiler profiler;
+    importer.setProfiler(&profiler);
+
+    /* Returns increasing values, odd ones on the start of each call, even on
+       the end */
+    std::size_t counter = 0;
+    profiler.setPeakAllocationCallback([](void* userData) {
+        return ++*static_cast<std::size_t*>(userData);
+    }, &counter);
+
+    CORRADE_VERIFY(importer.openData(nullptr));
+    CORRADE_VERIFY(importer.mesh(2));
+    CORRADE_COMPARE(counter, 4);
+    CORRADE_COMPARE(profiler.records().size(), 2);
+    CORRADE_COMPARE(profiler.records()[0].peakAllocation, 2);
+    CORRADE_COMPARE(profiler.records()[1].peakAllocation, 4);
+
+    /* Resetting the callback makes the peak allocation zero again */
+    profiler.setPeakAllocationCallback(nullptr);
+    CORRADE_VERIFY(importer.mesh(2));
+    CORRADE_COMPARE(counter, 4);
+    CORRADE_COMPARE(profiler.records().size(), 3);
+    CORRADE_COMPARE(profiler.records()[2].peakAllocation, 0);
+}
+
+void ProfilerTest::chromeTrace() {
+    Profiler profiler;
+    profiler.addRecord({"Trade::AbstractImporter::mesh()", "TgaImporter", 3, 0, 1500, 2000000, 0, 48, 0});
+    profiler.addRecord({"custom()", {}, ~UnsignedInt{}, 0, 0, 1, 16, 0, 1024});
+
+    CORRADE_COMPARE(profiler.chromeTrace(),
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"Trade::AbstractImporter::mesh()\",\"cat\":\"TgaImporter\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":1.500,\"dur\":2000.000,\"args\":{\"id\":3,\"bytesIn\":0,\"bytesOut\":48,\"peakAllocation\":0}},\n"
+        "{\"name\":\"custom()\",\"cat\":\"Magnum\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":0.001,\"args\":{\"bytesIn\":16,\"bytesOut\":0,\"peakAllocation\":1024}}\n"
+        "]}\n");
+}
+
+void ProfilerTest::chromeTraceEscaping() {
+    Profiler profiler;
+    profiler.addRecord({"\"quoted\"\\path\n", "Plugin\t", ~UnsignedInt{}, 0, 0, 0, 0, 0, 0});
+
+    CORRADE_COMPARE(profiler.chromeTrace(),
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"\\\"quoted\\\"\\\\path\\u000a\",\"cat\":\"Plugin\\u0009\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":0.000,\"args\":{\"bytesIn\":0,\"bytesOut\":0,\"peakAllocation\":0}}\n"
+        "]}\n");
+}
+
+void ProfilerTest::importer() {
+    Importer importer;
+    Profiler profiler;
+    CORRADE_VERIFY(!importer.profiler());
+
+    importer.setProfiler(&profiler);
+    CORRADE_COMPARE(importer.profiler(), &profiler);
+
+    const char data[7]{};
+    CORRADE_VERIFY(importer.openData(data));
+    CORRADE_VERIFY(importer.mesh(4));
+    CORRADE_VERIFY(!importer.mesh(3));
+
+    Containers::ArrayView<const ProfilerRecord> records = profiler.records();
+    CORRADE_COMPARE(records.size(), 3);
+
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractImporter::openData()");
+    /* Not instantiated through a plugin manager */
+    CORRADE_COMPARE(records[0].plugin, "");
+    CORRADE_COMPARE(records[0].id, ~UnsignedInt{});
+    CORRADE_COMPARE(records[0].bytesIn, 7);
+    CORRADE_COMPARE(records[0].bytesOut, 0);
+
+    CORRADE_COMPARE(Containers::StringView{records[1].function}, "Trade::AbstractImporter::mesh()");
+    CORRADE_COMPARE(records[1].id, 4);
+    CORRADE_COMPARE(records[1].bytesIn, 0);
+    CORRADE_COMPARE(records[1].bytesOut, 48);
+    CORRADE_COMPARE_AS(records[1].begin, records[0].begin,
+        TestSuite::Compare::GreaterOrEqual);
+
+    /* Failed calls are recorded too, just with no output */
+    CORRADE_COMPARE(Containers::StringView{records[2].function}, "Trade::AbstractImporter::mesh()");
+    CORRADE_COMPARE(records[2].id, 3);
+    CORRADE_COMPARE(records[2].bytesOut, 0);
+
+    /* Opening memory is recorded as well */
+    profiler.clear();
+    CORRADE_VERIFY(importer.openMemory(data));
+    records = profiler.records();
+    CORRADE_COMPARE(records.size(), 1);
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractImporter::openMemory()");
+    CORRADE_COMPARE(records[0].bytesIn, 7);
+}
+
+void ProfilerTest::importerNoProfiler() {
+    Importer importer;
+    Profiler profiler;
+    importer.setProfiler(&profiler);
+    importer.setProfiler(nullptr);
+
+    CORRADE_VERIFY(importer.openData(nullptr));
+    CORRADE_VERIFY(importer.mesh(4));
+    CORRADE_VERIFY(profiler.records().isEmpty());
+}
+
+void ProfilerTest::importerParallel() {
+    Importer importer{ImporterFeature::ThreadSafe};
+    CORRADE_VERIFY(importer.openData(nullptr));
+
+    Profiler profiler;
+    importer.setProfiler(&profiler);
+
+    const UnsignedInt ids[]{0, 1, 2, 3, 4, 5};
+    CORRADE_COMPARE(importMeshes(importer, ids, 3).size(), 6);
+
+    /* The order isn't deterministic, so just verify all records are there
+       and come from at most three threads */
+    CORRADE_COMPARE(profiler.records().size(), 6);
+    UnsignedInt idMask = 0;
+    for(const ProfilerRecord& record: profiler.records()) {
+        CORRADE_ITERATION(record.id);
+        CORRADE_COMPARE_AS(record.thread, 3,
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE(record.bytesOut, record.id == 3 ? 0 : record.id*12);
+        idMask |= 1 << record.id;
+    }
+    CORRADE_COMPARE(idMask, 0x3f);
+}
+
+void ProfilerTest::imageConverter() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override {
+            return ImageConverterFeature::Convert2D|ImageConverterFeature::Convert2DToData;
+        }
+
+        Containers::Optional<ImageData2D> doConvert(const ImageView2D& image) override {
+            return ImageData2D{PixelFormat::R8Unorm, image.size(), Containers::Array<char>{std::size_t(image.size().product())}};
+        }
+
+        Containers::Optional<Containers::Array<char>> doConvertToData(const ImageView2D&) override {
+            return Containers::Array<char>{5};
+        }
+    } converter;
+
+    Profiler profiler;
+    converter.setProfiler(&profiler);
+    CORRADE_COMPARE(converter.profiler(), &profiler);
+
+    const char data[4*2*4]{};
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 2}, data};
+    CORRADE_VERIFY(converter.convert(image));
+    CORRADE_VERIFY(converter.convertToData(image));
+
+    Containers::ArrayView<const ProfilerRecord> records = profiler.records();
+    CORRADE_COMPARE(records.size(), 2);
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractImageConverter::convert()");
+    CORRADE_COMPARE(records[0].id, ~UnsignedInt{});
+    CORRADE_COMPARE(records[0].bytesIn, 32);
+    CORRADE_COMPARE(records[0].bytesOut, 8);
+    CORRADE_COMPARE(Containers::StringView{records[1].function}, "Trade::AbstractImageConverter::convertToData()");
+    CORRADE_COMPARE(records[1].bytesIn, 32);
+    CORRADE_COMPARE(records[1].bytesOut, 5);
+}
+
+void ProfilerTest::sceneConverter() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMesh|SceneConverterFeature::ConvertMeshInPlace;
+        }
+
+        Containers::Optional<MeshData> doConvert(const MeshData& mesh) override {
+            return MeshData{mesh.primitive(), Containers::Array<char>{mesh.vertexData().size()*2}, {
+                MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 0, mesh.vertexCount(), 24}
+            }};
+        }
+
+        bool doConvertInPlace(MeshData&) override {
+            return true;
+        }
+    } converter;
+
+    Profiler profiler;
+    converter.setProfiler(&profiler);
+    CORRADE_COMPARE(converter.profiler(), &profiler);
+
+    Vector3 positions[3];
+    MeshData mesh{MeshPrimitive::Points, {}, positions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+    CORRADE_VERIFY(converter.convert(mesh));
+    CORRADE_VERIFY(converter.convertInPlace(mesh));
+
+    Containers::ArrayView<const ProfilerRecord> records = profiler.records();
+    CORRADE_COMPARE(records.size(), 2);
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractSceneConverter::convert()");
+    CORRADE_COMPARE(records[0].bytesIn, 36);
+    CORRADE_COMPARE(records[0].bytesOut, 72);
+    CORRADE_COMPARE(Containers::StringView{records[1].function}, "Trade::AbstractSceneConverter::convertInPlace()");
+    CORRADE_COMPARE(records[1].bytesIn, 36);
+    CORRADE_COMPARE(records[1].bytesOut, 36);
+}
+
+void ProfilerTest::sceneConverterMultiple() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override {
+            return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes;
+        }
+
+        bool doBeginData() override { return true; }
+        bool doAdd(UnsignedInt, const MeshData&, Containers::StringView) override {
+            return true;
+        }
+        Containers::Optional<Containers::Array<char>> doEndData() override {
+            return Containers::Array<char>{5};
+        }
+    } converter;
+
+    Profiler profiler;
+    converter.setProfiler(&profiler);
+
+    Vector3 positions[3];
+    MeshData mesh{MeshPrimitive::Points, {}, positions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+    CORRADE_VERIFY(converter.beginData());
+    CORRADE_VERIFY(converter.add(mesh));
+    CORRADE_VERIFY(converter.add(mesh));
+    CORRADE_VERIFY(converter.endData());
+
+    Containers::ArrayView<const ProfilerRecord> records = profiler.records();
+    CORRADE_COMPARE(records.size(), 4);
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractSceneConverter::beginData()");
+    CORRADE_COMPARE(Containers::StringView{records[1].function}, "Trade::AbstractSceneConverter::add()");
+    CORRADE_COMPARE(records[1].id, 0);
+    CORRADE_COMPARE(records[1].bytesIn, 36);
+    CORRADE_COMPARE(Containers::StringView{records[2].function}, "Trade::AbstractSceneConverter::add()");
+    CORRADE_COMPARE(records[2].id, 1);
+    CORRADE_COMPARE(Containers::StringView{records[3].function}, "Trade::AbstractSceneConverter::endData()");
+    CORRADE_COMPARE(records[3].bytesOut, 5);
+
+    /* A single-mesh conversion going through the above records the nested
+       calls first, as a record is added only once the call finishes */
+    profiler.clear();
+    CORRADE_VERIFY(converter.convertToData(mesh));
+    records = profiler.records();
+    CORRADE_COMPARE(records.size(), 4);
+    CORRADE_COMPARE(Containers::StringView{records[0].function}, "Trade::AbstractSceneConverter::beginData()");
+    CORRADE_COMPARE(Containers::StringView{records[1].function}, "Trade::AbstractSceneConverter::add()");
+    CORRADE_COMPARE(Containers::StringView{records[2].function}, "Trade::AbstractSceneConverter::endData()");
+    CORRADE_COMPARE(Containers::StringView{records[3].function}, "Trade::AbstractSceneConverter::convertToData()");
+    CORRADE_COMPARE(records[3].bytesIn, 36);
+    CORRADE_COMPARE(records[3].bytesOut, 5);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ProfilerTest)
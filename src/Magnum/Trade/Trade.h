@@ -69,6 +69,8 @@ enum class AnimationTrackType: UnsignedByte;
 class AnimationTrackData;
 class AnimationData;
 
+enum class BlobType: UnsignedByte;
+
 enum class CameraType: UnsignedByte;
 class CameraData;
 
@@ -104,6 +106,12 @@ class PbrSpecularGlossinessMaterialData;
 class PhongMaterialData;
 class TextureData;
 
+class ArrayArena;
+class ArrayArenaScope;
+
+class Profiler;
+struct ProfilerRecord;
+
 enum class SceneMappingType: UnsignedByte;
 enum class SceneField: UnsignedInt;
 enum class SceneFieldType: UnsignedShort;
@@ -26,6 +26,7 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/ScopeGuard.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -39,6 +40,7 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/converterUtilities.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -207,6 +209,40 @@ file again:
 magnum-imageconverter cube-mips.exr --layer 2 --level 1 +x-128.exr
 @endcode
 
+@subsection magnum-imageconverter-example-batch Batch conversion
+
+Converting many files in a single invocation, with the importer and converter
+plugins loaded just once and the files processed on multiple threads. The
+manifest lists an input and an output file on each line, separated by
+whitespace; empty lines and lines starting with `#` are ignored and relative
+paths are taken relative to the current working directory:
+
+@code{.sh}
+magnum-imageconverter --batch textures.txt \
+    -C StbResizeImageConverter -c size="512 512" --profile
+@endcode
+
+@code{.txt}
+# input                 output
+textures/brick.png      out/brick.ktx2
+textures/grass.jpg      out/grass.ktx2
+@endcode
+
+Each thread uses its own plugin manager with dedicated importer and converter
+instances, which assumes the plugin instances can be used independently from
+each other. If that's not the case for a particular plugin, pass `--threads 1`.
+If the plugins have the `instancePool` configuration option, such as
+@relativeref{Trade,AnyImageImporter} and @relativeref{Trade,AnyImageConverter},
+it's enabled so the concrete plugins get reused across files as well. Passing
+`-i instancePool=false` or `-c instancePool=false` disables that again.
+Similarly, if more than one thread is used and the plugins have the `threads`
+configuration option, it's set to @cpp 1 @ce to not oversubscribe the CPU,
+which can be again overridden with for example `-c threads=4`. With
+`--profile`, the import and conversion time is printed for each file in the
+manifest order, followed by the total. A failure to convert one file doesn't
+stop the others from being converted, the utility however returns a non-zero
+exit code at the end.
+
 @section magnum-imageconverter-usage Full usage documentation
 
 @code{.sh}
@@ -215,15 +251,16 @@ magnum-imageconverter [-h|--help] [-I|--importer PLUGIN]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [-D|--dimensions N]
     [--image N] [--level N] [--layer N] [--layers] [--levels] [--in-place]
-    [--info-importer] [--info-converter] [--info] [--color on|off|auto]
-    [-v|--verbose] [--profile] [--] input output
+    [--stream-rows N] [--batch MANIFEST] [--threads N] [--info-importer]
+    [--info-converter] [--info] [--color on|off|auto] [-v|--verbose]
+    [--profile] [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input image
+-   `input` --- input image; disallowed for `--batch`
 -   `output` --- output image; ignored if `--info` is present, disallowed for
-    `--in-place`
+    `--in-place` and `--batch`
 -   `-h`, `--help` --- display this help message and exit
 -   `-I`, `--importer PLUGIN` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
@@ -245,6 +282,15 @@ Arguments:
     more
 -   `--levels` --- combine multiple image levels into a single file
 -   `--in-place` --- overwrite the input image with the output
+-   `--stream-rows N` --- stream the output to a file in bands of @p N rows
+    (single uncompressed 2D images only)
+-   `--batch MANIFEST` --- convert all input / output pairs listed in a
+    manifest file. See @ref magnum-imageconverter-example-batch for more
+    information.
+-   `--threads N` --- number of threads to use with `--batch`. If set to `0`,
+    @ref std::thread::hardware_concurrency() is used. If more than one thread
+    is used, the `threads` option of the plugins is set to @cpp 1 @ce, unless
+    overridden with `-i` or `-c`. (default: `0`)
 -   `--info-importer` --- print info about the importer plugin and exit
 -   `--info-converter` --- print info about the image converter plugin and exit
 -   `--info` --- print info about the input file and exit
@@ -257,9 +303,18 @@ tightly-packed square of pixels in given @ref PixelFormat. Specifying `-C` /
 `--converter raw` will save raw imported data instead of using a converter
 plugin.
 
+If `--stream-rows` is given, the output is written using
+@ref Trade::AbstractImageConverter::beginFile(),
+@relativeref{Trade::AbstractImageConverter,addRows()} and
+@relativeref{Trade::AbstractImageConverter,endFile()} in bands of given row
+count, which requires the converter to support
+@ref Trade::ImageConverterFeature::Stream2DToFile. The converter then doesn't
+need to produce the whole output file in memory. The input image is still
+imported whole, however.
+
 If the `--info-importer` or `--info-converter` option is given, the utility
 will print information about given plugin specified via the `-I` or `-C`
-option, including its configuration options potentially overriden with
+option, including its configuration options potentially overridden with
 `-i` or `-c`. In this case no file is read and no conversion is done and
 neither the input nor the output file needs to be specified.
 
@@ -369,6 +424,21 @@ template<UnsignedInt dimensions> bool convertOneOrMoreImagesToFile(Trade::Abstra
         return convertOneOrMoreImagesToFile<ImageView, dimensions>(converter, outputImages, output);
 }
 
+bool streamImageToFile(Trade::AbstractImageConverter& converter, const Trade::ImageData2D& image, const Int bandRows, const Containers::StringView output) {
+    if(!converter.beginFile(output, image.format(), image.size(), image.flags()))
+        return false;
+
+    /* Each band is a view on the whole image with the skip adjusted */
+    for(Int y = 0; y < image.size().y(); y += bandRows) {
+        PixelStorage storage = image.storage();
+        storage.setSkip(storage.skip() + Vector3i::yAxis(y));
+        if(!converter.addRows(ImageView2D{storage, image.format(), image.formatExtra(), image.pixelSize(), {image.size().x(), Math::min(bandRows, image.size().y() - y)}, image.data()}))
+            return false;
+    }
+
+    return converter.endFile();
+}
+
 template<UnsignedInt dimensions> bool convertImages(Trade::AbstractImageConverter& converter, Containers::Array<Trade::ImageData<dimensions>>& images) {
     CORRADE_INTERNAL_ASSERT(!images.isEmpty());
     for(Trade::ImageData<dimensions>& image: images) {
@@ -380,6 +450,398 @@ template<UnsignedInt dimensions> bool convertImages(Trade::AbstractImageConverte
     return true;
 }
 
+/* Dimension-specific importer APIs and converter features for the --batch
+   mode, which doesn't have the per-dimension branches of the main code path */
+template<UnsignedInt> struct BatchImage;
+template<> struct BatchImage<1> {
+    static UnsignedInt count(Trade::AbstractImporter& importer) {
+        return importer.image1DCount();
+    }
+    static UnsignedInt levelCount(Trade::AbstractImporter& importer, UnsignedInt id) {
+        return importer.image1DLevelCount(id);
+    }
+    static Containers::Optional<Trade::ImageData1D> image(Trade::AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image1D(id, level);
+    }
+    static Trade::ImageConverterFeature convertFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed1D :
+            Trade::ImageConverterFeature::Convert1D;
+    }
+    static Trade::ImageConverterFeature convertToFileFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed1DToFile :
+            Trade::ImageConverterFeature::Convert1DToFile;
+    }
+};
+template<> struct BatchImage<2> {
+    static UnsignedInt count(Trade::AbstractImporter& importer) {
+        return importer.image2DCount();
+    }
+    static UnsignedInt levelCount(Trade::AbstractImporter& importer, UnsignedInt id) {
+        return importer.image2DLevelCount(id);
+    }
+    static Containers::Optional<Trade::ImageData2D> image(Trade::AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image2D(id, level);
+    }
+    static Trade::ImageConverterFeature convertFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed2D :
+            Trade::ImageConverterFeature::Convert2D;
+    }
+    static Trade::ImageConverterFeature convertToFileFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed2DToFile :
+            Trade::ImageConverterFeature::Convert2DToFile;
+    }
+};
+template<> struct BatchImage<3> {
+    static UnsignedInt count(Trade::AbstractImporter& importer) {
+        return importer.image3DCount();
+    }
+    static UnsignedInt levelCount(Trade::AbstractImporter& importer, UnsignedInt id) {
+        return importer.image3DLevelCount(id);
+    }
+    static Containers::Optional<Trade::ImageData3D> image(Trade::AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image3D(id, level);
+    }
+    static Trade::ImageConverterFeature convertFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed3D :
+            Trade::ImageConverterFeature::Convert3D;
+    }
+    static Trade::ImageConverterFeature convertToFileFeature(bool compressed) {
+        return compressed ?
+            Trade::ImageConverterFeature::ConvertCompressed3DToFile :
+            Trade::ImageConverterFeature::Convert3DToFile;
+    }
+};
+
+struct BatchEntry {
+    /* Wow, C++, you suck. The durations implicitly initialize to random
+       shit?! */
+    explicit BatchEntry(Containers::StringView input, Containers::StringView output): input{input}, output{output}, importTime{}, conversionTime{}, succeeded{} {}
+
+    Containers::StringView input;
+    Containers::StringView output;
+    std::chrono::high_resolution_clock::duration importTime;
+    std::chrono::high_resolution_clock::duration conversionTime;
+    bool succeeded;
+};
+
+/* Plugin managers and instances used by a single --batch thread. The Any*
+   plugins load and instantiate concrete plugins through their manager on
+   every opened or converted file and managers aren't thread-safe, so each
+   thread except the first has its own. */
+struct BatchWorker {
+    PluginManager::Manager<Trade::AbstractImporter>* importerManager;
+    PluginManager::Manager<Trade::AbstractImageConverter>* converterManager;
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractImporter>> ownImporterManager;
+    Containers::Pointer<PluginManager::Manager<Trade::AbstractImageConverter>> ownConverterManager;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* All -C converters followed by an implicit AnyImageConverter if the last
+       of them can't convert to a file, same as in the main code path */
+    Containers::Array<Containers::Pointer<Trade::AbstractImageConverter>> converters;
+    Containers::Array<Containers::StringView> converterNames;
+};
+
+template<UnsignedInt dimensions> bool convertBatchEntry(BatchWorker& worker, BatchEntry& entry, const UnsignedInt image, const Containers::Optional<UnsignedInt> level, const bool map) {
+    Trade::AbstractImporter& importer = *worker.importer;
+
+    /* Kept alive until the end as the imported images may reference it */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+    #else
+    static_cast<void>(map);
+    #endif
+
+    Containers::Array<Trade::ImageData<dimensions>> images;
+    {
+        Trade::Implementation::Duration d{entry.importTime};
+
+        /* Close the importer on every path out of here, including failures.
+           Otherwise it'd keep the file open until the worker gets to the next
+           entry and, with --map, reference memory that gets unmapped once
+           this function returns. */
+        Containers::ScopeGuard closeImporter{&importer, [](Trade::AbstractImporter* importer) {
+            importer->close();
+        }};
+
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        if(map) {
+            if(!(mapped = Utility::Path::mapRead(entry.input)) || !importer.openMemory(*mapped)) {
+                Error() << "Cannot memory-map file" << entry.input;
+                return false;
+            }
+        } else
+        #endif
+        {
+            if(!importer.openFile(entry.input)) {
+                Error{} << "Cannot open file" << entry.input;
+                return false;
+            }
+        }
+
+        const UnsignedInt count = BatchImage<dimensions>::count(importer);
+        if(image >= count) {
+            Error{} << dimensions << Debug::nospace << "D image number" << image << "not found in" << entry.input << Debug::nospace << ", the file has only" << count << dimensions << Debug::nospace << "D images";
+            return false;
+        }
+
+        /* Import all levels of the input or just one if specified */
+        UnsignedInt minLevel, maxLevel;
+        if(level) {
+            minLevel = *level;
+            maxLevel = *level + 1;
+            const UnsignedInt levelCount = BatchImage<dimensions>::levelCount(importer, image);
+            if(*level >= levelCount) {
+                Error{} << dimensions << Debug::nospace << "D image" << image << "in" << entry.input << "doesn't have a level number" << *level << Debug::nospace << ", only" << levelCount << "levels";
+                return false;
+            }
+        } else {
+            minLevel = 0;
+            maxLevel = BatchImage<dimensions>::levelCount(importer, image);
+        }
+        for(UnsignedInt i = minLevel; i != maxLevel; ++i) {
+            Containers::Optional<Trade::ImageData<dimensions>> imported = BatchImage<dimensions>::image(importer, image, i);
+            if(!imported) {
+                Error{} << "Cannot import image" << image << Debug::nospace << ":" << Debug::nospace << i << "from" << entry.input;
+                return false;
+            }
+            arrayAppend(images, Utility::move(*imported));
+        }
+    }
+
+    Trade::Implementation::Duration d{entry.conversionTime};
+
+    /* All converters except the last one are image-to-image */
+    const std::size_t last = worker.converters.size() - 1;
+    for(std::size_t i = 0; i != last; ++i) {
+        Trade::AbstractImageConverter& converter = *worker.converters[i];
+        const bool compressed = images.front().isCompressed();
+        if(!(converter.features() >= BatchImage<dimensions>::convertFeature(compressed))) {
+            Error err;
+            err << worker.converterNames[i] << "doesn't support";
+            if(compressed)
+                err << "compressed";
+            err << dimensions << Debug::nospace << "D image conversion, only" << converter.features();
+            return false;
+        }
+
+        if(!convertImages(converter, images)) {
+            Error{} << worker.converterNames[i] << "cannot convert" << entry.input;
+            return false;
+        }
+    }
+
+    /* The last one outputs to a file */
+    Trade::AbstractImageConverter& converter = *worker.converters[last];
+    const bool compressed = images.front().isCompressed();
+    Trade::ImageConverterFeatures expectedFeatures = BatchImage<dimensions>::convertToFileFeature(compressed);
+    if(images.size() > 1)
+        expectedFeatures |= Trade::ImageConverterFeature::Levels;
+    if(!(converter.features() >= expectedFeatures)) {
+        Error err;
+        err << worker.converterNames[last] << "doesn't support";
+        if(images.size() > 1)
+            err << "multi-level";
+        if(compressed)
+            err << "compressed";
+        err << dimensions << Debug::nospace << "D image to file conversion, only" << converter.features();
+        return false;
+    }
+
+    if(!convertOneOrMoreImagesToFile(converter, images, entry.output)) {
+        Error{} << "Cannot save file" << entry.output;
+        return false;
+    }
+
+    return true;
+}
+
+int convertBatch(const Utility::Arguments& args, PluginManager::Manager<Trade::AbstractImporter>& importerManager, PluginManager::Manager<Trade::AbstractImageConverter>& converterManager) {
+    const Int dimensions = args.value<Int>("dimensions");
+    if(dimensions < 1 || dimensions > 3) {
+        Error{} << "Invalid --dimensions option:" << args.value("dimensions");
+        return 1;
+    }
+
+    /* Parse the manifest. The entries reference its contents, so it has to
+       stay alive until the end. */
+    const Containers::StringView manifestFilename = args.value<Containers::StringView>("batch");
+    const Containers::Optional<Containers::String> manifest = Utility::Path::readString(manifestFilename);
+    if(!manifest) {
+        Error{} << "Cannot read batch manifest" << manifestFilename;
+        return 3;
+    }
+    Containers::Array<BatchEntry> entries;
+    {
+        const Containers::Array<Containers::StringView> lines = manifest->split('\n');
+        for(std::size_t i = 0; i != lines.size(); ++i) {
+            const Containers::StringView line = lines[i].trimmed();
+            if(line.isEmpty() || line.hasPrefix('#'))
+                continue;
+
+            const Containers::Array<Containers::StringView> files = line.splitOnWhitespaceWithoutEmptyParts();
+            if(files.size() != 2) {
+                Error{} << "Expected an input and an output file on line" << i + 1 << "of" << manifestFilename << Debug::nospace << ", got" << line;
+                return 1;
+            }
+
+            arrayAppend(entries, InPlaceInit, files[0], files[1]);
+        }
+    }
+    if(entries.isEmpty()) {
+        Warning{} << "No files to convert in" << manifestFilename;
+        return 0;
+    }
+
+    const std::size_t threadCount = Math::min(Magnum::Implementation::threadCount(args.value<UnsignedInt>("threads")), entries.size());
+
+    /* Load the plugins and set up the instances for all threads serially
+       upfront. The first thread uses the managers from the caller, the others
+       get their own. */
+    Containers::Array<BatchWorker> workers{ValueInit, threadCount};
+    for(std::size_t i = 0; i != threadCount; ++i) {
+        BatchWorker& worker = workers[i];
+        if(i == 0) {
+            worker.importerManager = &importerManager;
+            worker.converterManager = &converterManager;
+        } else {
+            worker.importerManager = &worker.ownImporterManager.emplace(
+                #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+                importerManager.pluginDirectory()
+                #endif
+            );
+            worker.converterManager = &worker.ownConverterManager.emplace(
+                #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+                converterManager.pluginDirectory()
+                #endif
+            );
+        }
+
+        /* Warnings about unrecognized options would be the same for all
+           threads, print them just once */
+        Containers::Optional<Warning> silenceWarnings;
+        if(i != 0) silenceWarnings.emplace(nullptr);
+
+        if(!(worker.importer = worker.importerManager->loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << ", "_s.join(worker.importerManager->aliasList());
+            return 1;
+        }
+
+        /* The Any* proxies are going to be used for many files, reuse the
+           concrete plugin instances if they support it. Done before setting
+           the options to make it possible to override. */
+        if(worker.importer->configuration().hasValue("instancePool"))
+            worker.importer->configuration().setValue("instancePool", true);
+        /* The files are converted in parallel already, so plugins using
+           threads of their own would only oversubscribe the CPU */
+        if(threadCount > 1 && worker.importer->configuration().hasValue("threads"))
+            worker.importer->configuration().setValue("threads", 1);
+
+        /* Set options, if passed */
+        if(args.isSet("verbose")) worker.importer->addFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*worker.importer, "AnyImageImporter", args.value("importer-options"));
+
+        for(std::size_t j = 0, converterCount = args.arrayValueCount("converter"); j <= converterCount; ++j) {
+            const Containers::StringView converterName = j == converterCount ?
+                "AnyImageConverter"_s : args.arrayValue<Containers::StringView>("converter", j);
+
+            Containers::Pointer<Trade::AbstractImageConverter> converter = worker.converterManager->loadAndInstantiate(converterName);
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << ", "_s.join(worker.converterManager->aliasList());
+                return 2;
+            }
+
+            if(converter->configuration().hasValue("instancePool"))
+                converter->configuration().setValue("instancePool", true);
+            if(threadCount > 1 && converter->configuration().hasValue("threads"))
+                converter->configuration().setValue("threads", 1);
+
+            /* Set options, if passed */
+            if(args.isSet("verbose")) converter->addFlags(Trade::ImageConverterFlag::Verbose);
+            if(j < args.arrayValueCount("converter-options"))
+                Implementation::setOptions(*converter, "AnyImageConverter", args.arrayValue("converter-options", j));
+
+            const bool toFile = converter->features() & (
+                Trade::ImageConverterFeature::Convert1DToFile|
+                Trade::ImageConverterFeature::Convert2DToFile|
+                Trade::ImageConverterFeature::Convert3DToFile|
+                Trade::ImageConverterFeature::ConvertCompressed1DToFile|
+                Trade::ImageConverterFeature::ConvertCompressed2DToFile|
+                Trade::ImageConverterFeature::ConvertCompressed3DToFile);
+            arrayAppend(worker.converters, Utility::move(converter));
+            arrayAppend(worker.converterNames, converterName);
+
+            /* The last --converter is capable of converting to a file, no
+               need for the implicit AnyImageConverter */
+            if(j + 1 >= converterCount && toFile)
+                break;
+        }
+    }
+
+    if(args.isSet("verbose"))
+        Debug{} << "Converting" << entries.size() << "files in" << threadCount << "threads...";
+
+    const UnsignedInt image = args.value<UnsignedInt>("image");
+    Containers::Optional<UnsignedInt> level;
+    if(!args.value("level").empty()) level = args.value<UnsignedInt>("level");
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    const bool map = args.isSet("map");
+    #else
+    const bool map = false;
+    #endif
+
+    /* Wow, C++, you suck. This implicitly initializes to random shit?! */
+    std::chrono::high_resolution_clock::duration wallTime{};
+    {
+        Trade::Implementation::Duration d{wallTime};
+
+        Magnum::Implementation::parallelForThread(entries.size(), threadCount, [&](const std::size_t thread, const std::size_t i) {
+            BatchEntry& entry = entries[i];
+            if(dimensions == 1)
+                entry.succeeded = convertBatchEntry<1>(workers[thread], entry, image, level, map);
+            else if(dimensions == 2)
+                entry.succeeded = convertBatchEntry<2>(workers[thread], entry, image, level, map);
+            else if(dimensions == 3)
+                entry.succeeded = convertBatchEntry<3>(workers[thread], entry, image, level, map);
+            else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+        });
+    }
+
+    /* Print the timing in the manifest order once everything is done, so it
+       isn't interleaved between threads */
+    std::size_t failedCount = 0;
+    std::chrono::high_resolution_clock::duration importTime{};
+    std::chrono::high_resolution_clock::duration conversionTime{};
+    for(const BatchEntry& entry: entries) {
+        if(!entry.succeeded) ++failedCount;
+        importTime += entry.importTime;
+        conversionTime += entry.conversionTime;
+
+        if(args.isSet("profile")) {
+            Debug d;
+            d << entry.input << "->" << entry.output << Debug::nospace << ":";
+            if(!entry.succeeded) d << "(failed)";
+            d << "import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(entry.importTime).count())/1.0e3f << "seconds, conversion"
+                << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(entry.conversionTime).count())/1.0e3f << "seconds";
+        }
+    }
+
+    if(args.isSet("profile")) {
+        Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
+            << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds in total, batch of" << entries.size() << "files took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(wallTime).count())/1.0e3f << "seconds in" << threadCount << "threads";
+    }
+
+    if(failedCount) {
+        Error{} << "Failed to convert" << failedCount << "out of" << entries.size() << "files listed in" << manifestFilename;
+        return 1;
+    }
+
+    return 0;
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -403,6 +865,9 @@ int main(int argc, char** argv) {
         .addBooleanOption("layers").setHelp("layers", "combine multiple layers into an image with one dimension more")
         .addBooleanOption("levels").setHelp("layers", "combine multiple image levels into a single file")
         .addBooleanOption("in-place").setHelp("in-place", "overwrite the input image with the output")
+        .addOption("stream-rows").setHelp("stream-rows", "stream the output to a file in bands of N rows (single uncompressed 2D images only)", "N")
+        .addOption("batch").setHelp("batch", "convert all input / output pairs listed in a manifest file", "MANIFEST")
+        .addOption("threads", "0").setHelp("threads", "number of threads to use with --batch, 0 for all available, sets the threads option of plugins to 1 if more than one", "N")
         .addBooleanOption("info-importer").setHelp("info-importer", "print info about the importer plugin and exit")
         .addBooleanOption("info-converter").setHelp("info-converter", "print info about the image converter plugin and exit")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
@@ -410,14 +875,15 @@ int main(int argc, char** argv) {
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
-            /* If --info for plugins is passed, we don't need the input */
+            /* If --info for plugins or --batch is passed, we don't need the
+               input */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-               key == "input" && isPluginInfoRequested(args))
+               key == "input" && (isPluginInfoRequested(args) || !args.value("batch").empty()))
                 return true;
-            /* If --in-place or --info for plugins or data is passed, we don't
-               need the output argument */
+            /* If --in-place, --info for plugins or data or --batch is passed,
+               we don't need the output argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-               key == "output" && (args.isSet("in-place") || isPluginInfoRequested(args) || args.isSet("info")))
+               key == "output" && (args.isSet("in-place") || isPluginInfoRequested(args) || args.isSet("info") || !args.value("batch").empty()))
                 return true;
 
             /* Handle all other errors as usual */
@@ -431,13 +897,22 @@ save raw imported data instead of using a converter plugin.
 
 If the --info-importer or --info-converter option is given, the utility will
 print information about given plugin specified via the -I or -C option,
-including its configuration options potentially overriden with -i or -c. In
+including its configuration options potentially overridden with -i or -c. In
 this case no file is read and no conversion is done and neither the input nor
 the output file needs to be specified.
 
 If --info is given, the utility will print information about given data, independently of the -D / --dimensions option. In this case the input file is
 read but no conversion is done and output file doesn't need to be specified.
 
+If --batch is given, the input and output files are taken from given manifest
+file instead, each line containing an input and an output filename separated
+by whitespace. Empty lines and lines starting with # are ignored. The plugins
+are loaded just once and the files are converted on --threads threads, each
+having its own importer and converter instances. With --profile, import and
+conversion time is reported for each file. The --layer, --layers, --levels,
+--in-place, --stream-rows and --info options and raw input and output aren't
+supported in this mode.
+
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
 plugin configuration. If the = character is omitted, it's equivalent to saying
@@ -513,6 +988,28 @@ no -C / --converter is specified, AnyImageConverter is used.)")
         Error{} << "The --levels option can't be combined with raw data output";
         return 1;
     }
+    if(!args.value("stream-rows").empty() && args.value<Int>("stream-rows") <= 0) {
+        Error{} << "The --stream-rows option expects a positive row count, got" << args.value<Containers::StringView>("stream-rows");
+        return 1;
+    }
+    if(!args.value("stream-rows").empty() && args.isSet("levels")) {
+        Error{} << "The --stream-rows option can't be combined with --levels";
+        return 1;
+    }
+    if(!args.value("batch").empty()) {
+        if(args.arrayValueCount("input") || args.value<Containers::StringView>("output")) {
+            Error{} << "Input and output files shouldn't be set for --batch";
+            return 1;
+        }
+        if(args.isSet("layers") || args.isSet("levels") || !args.value("layer").empty() || args.isSet("in-place") || !args.value("stream-rows").empty() || args.isSet("info")) {
+            Error{} << "The --batch option can't be combined with --layer, --layers, --levels, --in-place, --stream-rows or --info";
+            return 1;
+        }
+        if(args.value<Containers::StringView>("importer").hasPrefix("raw:"_s) || (args.arrayValueCount("converter") && args.arrayValue("converter", args.arrayValueCount("converter") - 1) == "raw")) {
+            Error{} << "The --batch option can't be combined with raw data input or output";
+            return 1;
+        }
+    }
     if(!args.isSet("layers") && !args.isSet("levels") && args.arrayValueCount("input") > 1 && !isPluginInfoRequested(args)) {
         Error{} << "Multiple input files require the --layers / --levels option to be set";
         return 1;
@@ -561,6 +1058,10 @@ no -C / --converter is specified, AnyImageConverter is used.)")
         return 0;
     }
 
+    /* Convert files listed in a manifest, if requested */
+    if(!args.value("batch").empty())
+        return convertBatch(args, importerManager, converterManager);
+
     const Int dimensions = args.value<Int>("dimensions");
     /** @todo make them array options as well? */
     const UnsignedInt image = args.value<UnsignedInt>("image");
@@ -1059,8 +1560,17 @@ no -C / --converter is specified, AnyImageConverter is used.)")
             Trade::ImageConverterFeature::Convert3DToFile|
             Trade::ImageConverterFeature::ConvertCompressed1DToFile|
             Trade::ImageConverterFeature::ConvertCompressed2DToFile|
-            Trade::ImageConverterFeature::ConvertCompressed3DToFile))))
+            Trade::ImageConverterFeature::ConvertCompressed3DToFile|
+            Trade::ImageConverterFeature::Stream2DToFile))))
         {
+            /* Streaming is possible only for a single uncompressed 2D image
+               and not to a raw output */
+            const Int streamRows = args.value("stream-rows").empty() ? 0 : args.value<Int>("stream-rows");
+            if(streamRows && (converterName == "raw"_s || outputDimensions != 2 || outputIsCompressed || outputImages2D.size() != 1)) {
+                Error{} << "The --stream-rows option is supported only for a single uncompressed 2D image and a non-raw output";
+                return 1;
+            }
+
             /* Decide what converter feature we should look for for given
                dimension count. This has to be redone each iteration, as a
                converted could have converted an uncompressed image to a
@@ -1082,9 +1592,13 @@ no -C / --converter is specified, AnyImageConverter is used.)")
                 } else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
                 if(outputIsMultiLevel)
                     expectedFeatures |= Trade::ImageConverterFeature::Levels;
+                if(streamRows)
+                    expectedFeatures = Trade::ImageConverterFeature::Stream2DToFile;
                 if(!(converter->features() >= expectedFeatures)) {
                     Error err;
                     err << converterName << "doesn't support";
+                    if(streamRows)
+                        err << "streaming";
                     if(outputIsMultiLevel)
                         err << "multi-level";
                     if(outputIsCompressed)
@@ -1159,7 +1673,9 @@ no -C / --converter is specified, AnyImageConverter is used.)")
             } else {
                 bool converted;
                 Trade::Implementation::Duration d{conversionTime};
-                if(outputDimensions == 1)
+                if(streamRows)
+                    converted = streamImageToFile(*converter, outputImages2D.front(), streamRows, output);
+                else if(outputDimensions == 1)
                     converted = convertOneOrMoreImagesToFile(*converter, outputImages1D, output);
                 else if(outputDimensions == 2)
                     converted = convertOneOrMoreImagesToFile(*converter, outputImages2D, output);
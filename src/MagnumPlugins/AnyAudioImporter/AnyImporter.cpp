@@ -45,7 +45,11 @@ AnyImporter::AnyImporter(PluginManager::AbstractManager& manager, const std::str
 
 AnyImporter::~AnyImporter() = default;
 
-ImporterFeatures AnyImporter::doFeatures() const { return {}; }
+ImporterFeatures AnyImporter::doFeatures() const {
+    /* Streaming is known to be supported only once the concrete plugin is
+       loaded */
+    return _in ? _in->features() & ImporterFeature::Stream : ImporterFeatures{};
+}
 
 bool AnyImporter::doIsOpened() const { return !!_in; }
 
@@ -104,6 +108,12 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+std::size_t AnyImporter::doDataSize() const { return _in->dataSize(); }
+
+std::size_t AnyImporter::doRead(const Containers::ArrayView<char> data) { return _in->read(data); }
+
+bool AnyImporter::doSeek(const std::size_t offset) { return _in->seek(offset); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
@@ -118,6 +118,10 @@ configuration of the target plugin.
 Calls to the @ref format(), @ref frequency() and @ref data() functions are then
 proxied to the concrete implementation. The @ref close() function closes and
 discards the internally instantiated plugin; @ref isOpened() works as usual.
+
+If the concrete implementation supports @ref ImporterFeature::Stream, the
+feature is advertised while a file is opened and calls to @ref dataSize(),
+@ref read() and @ref seek() are proxied as well.
 */
 class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
     public:
@@ -139,6 +143,10 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doDataSize() const override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doRead(Containers::ArrayView<char> data) override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL bool doSeek(std::size_t offset) override;
+
         Containers::Pointer<AbstractImporter> _in;
 };
 
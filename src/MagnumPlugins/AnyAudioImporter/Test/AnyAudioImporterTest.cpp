@@ -108,6 +108,15 @@ void AnyImporterTest::load() {
     CORRADE_COMPARE(importer->frequency(), 96000);
     CORRADE_COMPARE(importer->data().size(), 4);
 
+    /* Streaming is proxied as well */
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Stream);
+    CORRADE_COMPARE(importer->dataSize(), 4);
+    char buffer[4];
+    CORRADE_COMPARE(importer->read(buffer), 4);
+    CORRADE_COMPARE(importer->read(buffer), 0);
+    CORRADE_VERIFY(importer->seek(2));
+    CORRADE_COMPARE(importer->read(buffer), 2);
+
     importer->close();
     CORRADE_VERIFY(!importer->isOpened());
 }
@@ -34,6 +34,7 @@
 #include <Corrade/Utility/String.h> /* lowercase() */
 
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/Implementation/PluginInstancePool.h"
 #include "MagnumPlugins/Implementation/propagateConfiguration.h"
 
 namespace Magnum { namespace Trade {
@@ -46,6 +47,54 @@ AnyImageConverter::AnyImageConverter(PluginManager::AbstractManager& manager, co
 
 AnyImageConverter::~AnyImageConverter() = default;
 
+UnsignedInt AnyImageConverter::instancePoolHitCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->hitCount(plugin) : 0;
+}
+
+UnsignedInt AnyImageConverter::instancePoolMissCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->missCount(plugin) : 0;
+}
+
+namespace {
+
+/* Options of the plugin itself, not propagated to the concrete plugin */
+constexpr Containers::StringView OwnOptions[]{
+    "instancePool"_s
+};
+
+}
+
+Containers::Pointer<AbstractImageConverter> AnyImageConverter::instantiate(const Containers::StringView plugin, const Containers::StringView metadataName, const char* const messagePrefix) {
+    /* Reuse a pooled instance if there's one. The configuration was
+       propagated to it already when it was created. */
+    if(configuration().value<bool>("instancePool")) {
+        if(!_pool) _pool.emplace();
+        if(Containers::Pointer<AbstractImageConverter> converter = _pool->take(plugin)) {
+            if(flags() & ImageConverterFlag::Verbose)
+                Debug{} << messagePrefix << "reusing a pooled" << plugin << "instance";
+            converter->setFlags(flags());
+            return converter;
+        }
+    }
+
+    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
+    converter->setFlags(flags());
+
+    /* Propagate configuration */
+    Magnum::Implementation::propagateConfiguration(messagePrefix, {}, metadataName, configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet), OwnOptions);
+
+    return converter;
+}
+
+void AnyImageConverter::release(const Containers::StringView plugin, Containers::Pointer<AbstractImageConverter>&& converter) {
+    /* Without pooling the instance gets simply destroyed */
+    Containers::Pointer<AbstractImageConverter> released = Utility::move(converter);
+    if(!configuration().value<bool>("instancePool")) return;
+
+    if(!_pool) _pool.emplace();
+    _pool->put(plugin, Utility::move(released));
+}
+
 ImageConverterFeatures AnyImageConverter::doFeatures() const {
     return
         ImageConverterFeature::Convert1DToFile|
@@ -54,7 +103,8 @@ ImageConverterFeatures AnyImageConverter::doFeatures() const {
         ImageConverterFeature::ConvertCompressed1DToFile|
         ImageConverterFeature::ConvertCompressed2DToFile|
         ImageConverterFeature::ConvertCompressed3DToFile|
-        ImageConverterFeature::Levels;
+        ImageConverterFeature::Levels|
+        ImageConverterFeature::Stream2DToFile;
 }
 
 bool AnyImageConverter::doConvertToFile(const ImageView1D& image, const Containers::StringView filename) {
@@ -89,16 +139,15 @@ bool AnyImageConverter::doConvertToFile(const ImageView1D& image, const Containe
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const ImageView2D& image, const Containers::StringView filename) {
@@ -152,16 +201,15 @@ bool AnyImageConverter::doConvertToFile(const ImageView2D& image, const Containe
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const ImageView3D& image, const Containers::StringView filename) {
@@ -202,16 +250,15 @@ bool AnyImageConverter::doConvertToFile(const ImageView3D& image, const Containe
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const CompressedImageView1D& image, const Containers::StringView filename) {
@@ -246,16 +293,15 @@ bool AnyImageConverter::doConvertToFile(const CompressedImageView1D& image, cons
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const CompressedImageView2D& image, const Containers::StringView filename) {
@@ -290,16 +336,15 @@ bool AnyImageConverter::doConvertToFile(const CompressedImageView2D& image, cons
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const CompressedImageView3D& image, const Containers::StringView filename) {
@@ -334,16 +379,15 @@ bool AnyImageConverter::doConvertToFile(const CompressedImageView3D& image, cons
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(image, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(image, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageView1D> imageLevels, const Containers::StringView filename) {
@@ -378,16 +422,15 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageV
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(imageLevels, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageView2D> imageLevels, const Containers::StringView filename) {
@@ -426,16 +469,15 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageV
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(imageLevels, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageView3D> imageLevels, const Containers::StringView filename) {
@@ -474,16 +516,15 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const ImageV
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(imageLevels, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const CompressedImageView1D> imageLevels, const Containers::StringView filename) {
@@ -518,16 +559,15 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const Compre
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(imageLevels, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const CompressedImageView2D> imageLevels, const Containers::StringView filename) {
@@ -562,16 +602,15 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const Compre
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(imageLevels, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const CompressedImageView3D> imageLevels, const Containers::StringView filename) {
@@ -606,16 +645,111 @@ bool AnyImageConverter::doConvertToFile(const Containers::ArrayView<const Compre
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & ImageConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(imageLevels, filename);
+    release(plugin, Utility::move(converter));
+    return out;
+}
+
+void AnyImageConverter::doAbort() {
+    /* Called also if doBeginFile() fails, in which case there's no instance
+       yet */
+    if(_converter) {
+        _converter->abort();
+        release(_converterPlugin, Utility::move(_converter));
+    }
+}
+
+bool AnyImageConverter::doBeginFile(const Containers::StringView filename, const PixelFormat format, const Vector2i& size, const ImageFlags2D imageFlags) {
+    CORRADE_INTERNAL_ASSERT(manager());
+
+    /* We don't detect any double extensions yet, so we can normalize just the
+       extension. In case we eventually might, it'd have to be split() instead
+       to save at least by normalizing just the filename and not the path. */
+    const Containers::String normalizedExtension = Utility::String::lowercase(Utility::Path::splitExtension(filename).second());
+
+    /* Detect the plugin from extension. Same as in
+       doConvertToFile(const ImageView2D&), the plugin is then checked for
+       streaming support below. */
+    Containers::StringView plugin;
+    if(normalizedExtension == ".bmp"_s)
+        plugin = "BmpImageConverter"_s;
+    else if(normalizedExtension == ".basis"_s)
+        plugin = "BasisImageConverter"_s;
+    else if(normalizedExtension == ".exr"_s)
+        plugin = "OpenExrImageConverter"_s;
+    else if(normalizedExtension == ".hdr"_s)
+        plugin = "HdrImageConverter"_s;
+    else if(normalizedExtension == ".jpg"_s ||
+            normalizedExtension == ".jpeg"_s ||
+            normalizedExtension == ".jpe"_s)
+        plugin = "JpegImageConverter"_s;
+    else if(normalizedExtension == ".ktx2"_s)
+        plugin = "KtxImageConverter"_s;
+    else if(normalizedExtension == ".png"_s)
+        plugin = "PngImageConverter"_s;
+    else if(normalizedExtension == ".tga"_s ||
+            normalizedExtension == ".vda"_s ||
+            normalizedExtension == ".icb"_s ||
+            normalizedExtension ==  ".vst"_s)
+        plugin = "TgaImageConverter"_s;
+    else {
+        Error{} << "Trade::AnyImageConverter::beginFile(): cannot determine the format of" << filename << "for a 2D image";
+        return false;
+    }
+
+    /* Try to load the plugin */
+    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Trade::AnyImageConverter::beginFile(): cannot load the" << plugin << "plugin";
+        return false;
+    }
+
+    const PluginManager::PluginMetadata* const metadata = manager()->metadata(plugin);
+    CORRADE_INTERNAL_ASSERT(metadata);
+    if(flags() & ImageConverterFlag::Verbose) {
+        Debug d;
+        d << "Trade::AnyImageConverter::beginFile(): using" << plugin;
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Instantiate the plugin or take it from the pool, check that it can
+       stream, propagate flags and configuration */
+    Containers::Pointer<AbstractImageConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnyImageConverter::beginFile():");
+    if(!(converter->features() & ImageConverterFeature::Stream2DToFile)) {
+        Error{} << "Trade::AnyImageConverter::beginFile():" << metadata->name() << "doesn't support streaming conversion";
+        release(plugin, Utility::move(converter));
+        return false;
+    }
+
+    /* Try to begin the file (error output should be printed by the plugin
        itself) */
-    return converter->convertToFile(imageLevels, filename);
+    if(!converter->beginFile(filename, format, size, imageFlags)) {
+        release(plugin, Utility::move(converter));
+        return false;
+    }
+
+    /* Success, save the instance */
+    _converter = Utility::move(converter);
+    _converterPlugin = plugin;
+    return true;
+}
+
+bool AnyImageConverter::doAddRows(const ImageView2D& rows) {
+    return _converter->addRows(rows);
+}
+
+bool AnyImageConverter::doEndFile() {
+    /* Destroy the converter instance after the operation finishes to avoid
+       keeping now-useless state around, or put it back to the pool */
+    const bool out = _converter->endFile();
+    release(_converterPlugin, Utility::move(_converter));
+    return out;
 }
 
 }}
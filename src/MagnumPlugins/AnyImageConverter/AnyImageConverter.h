@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnyImageConverter
  */
 
+#include <Corrade/Containers/StringView.h>
+
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "MagnumPlugins/AnyImageConverter/configure.h"
 
@@ -48,6 +50,12 @@
 #define MAGNUM_ANYIMAGECONVERTER_LOCAL
 #endif
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace Implementation {
+    template<class> class PluginInstancePool;
+}}
+#endif
+
 namespace Magnum { namespace Trade {
 
 /**
@@ -133,12 +141,46 @@ they depend on the plugin chosen inside @ref convertToFile(). Both return an
 empty string.
 
 The output of the @ref convertToFile() function called on the concrete
-implementation is then proxied back.
+implementation is then proxied back. The concrete plugin instance is discarded
+afterwards, unless @ref Trade-AnyImageConverter-pool "instance pooling" is
+enabled.
+
+Streaming 2D conversion through @ref beginFile() is proxied the same way,
+with the target plugin detected from the extension passed to
+@ref beginFile() and all subsequent @ref addRows(), @ref endFile() and
+@ref abort() calls delegated to it. If the target plugin doesn't advertise
+@ref ImageConverterFeature::Stream2DToFile, @ref beginFile() fails.
 
 Besides delegating the flags, the @ref AnyImageConverter itself recognizes
 @ref ImageConverterFlag::Verbose, printing info about the concrete plugin being
 used when the flag is enabled. @ref ImageConverterFlag::Quiet is recognized as
 well and causes all warnings to be suppressed.
+
+@section Trade-AnyImageConverter-pool Instance pooling
+
+By default, a new instance of the concrete plugin is created on every
+@ref convertToFile() and @ref beginFile() call. When converting a large amount
+of small images, the instantiation and option propagation can become a
+significant part of the conversion time. If the @cb{.ini} instancePool @ce
+@ref Trade-AnyImageConverter-configuration "configuration option" is enabled,
+the concrete plugin is kept after the conversion finishes and reused by the
+next conversion to the same format. At most one idle instance is kept per
+concrete plugin.
+
+Flags are set on every reuse, but the configuration is propagated only when
+the instance is created. Changes to @ref configuration() done after a
+particular format was first used are thus not reflected by its pooled
+instance. Counts of reused and newly created instances are available through
+@ref instancePoolHitCount() and @ref instancePoolMissCount().
+
+@section Trade-AnyImageConverter-configuration Plugin-specific configuration
+
+Apart from the options that are propagated to the concrete implementation, the
+plugin recognizes the following option, which isn't propagated. See
+@ref plugins-configuration for more information and an example showing how to
+edit the configuration values.
+
+@snippet MagnumPlugins/AnyImageConverter/AnyImageConverter.conf configuration_
 */
 class MAGNUM_ANYIMAGECONVERTER_EXPORT AnyImageConverter: public AbstractImageConverter {
     public:
@@ -150,6 +192,34 @@ class MAGNUM_ANYIMAGECONVERTER_EXPORT AnyImageConverter: public AbstractImageCon
 
         ~AnyImageConverter();
 
+        /**
+         * @brief Count of pooled instance reuses for given plugin
+         * @m_since_latest
+         *
+         * Count of conversions done with a pooled instance of @p plugin
+         * instead of a newly created one. The @p plugin is the name the file
+         * format was detected as, such as @cpp "PngImageConverter" @ce.
+         * Always @cpp 0 @ce if the @cb{.ini} instancePool @ce
+         * @ref Trade-AnyImageConverter-configuration "configuration option"
+         * isn't enabled. See @ref Trade-AnyImageConverter-pool for more
+         * information.
+         * @see @ref instancePoolMissCount()
+         */
+        UnsignedInt instancePoolHitCount(Containers::StringView plugin) const;
+
+        /**
+         * @brief Count of instance creations for given plugin
+         * @m_since_latest
+         *
+         * Count of conversions for which a new instance of @p plugin had to
+         * be created because there was no pooled one. Always @cpp 0 @ce if
+         * the @cb{.ini} instancePool @ce
+         * @ref Trade-AnyImageConverter-configuration "configuration option"
+         * isn't enabled.
+         * @see @ref instancePoolHitCount()
+         */
+        UnsignedInt instancePoolMissCount(Containers::StringView plugin) const;
+
     private:
         MAGNUM_ANYIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
         MAGNUM_ANYIMAGECONVERTER_LOCAL bool doConvertToFile(const ImageView1D& image, Containers::StringView filename) override;
@@ -164,6 +234,17 @@ class MAGNUM_ANYIMAGECONVERTER_EXPORT AnyImageConverter: public AbstractImageCon
         MAGNUM_ANYIMAGECONVERTER_LOCAL bool doConvertToFile(Containers::ArrayView<const CompressedImageView1D> imageLevels, Containers::StringView filename) override;
         MAGNUM_ANYIMAGECONVERTER_LOCAL bool doConvertToFile(Containers::ArrayView<const CompressedImageView2D> imageLevels, Containers::StringView filename) override;
         MAGNUM_ANYIMAGECONVERTER_LOCAL bool doConvertToFile(Containers::ArrayView<const CompressedImageView3D> imageLevels, Containers::StringView filename) override;
+        MAGNUM_ANYIMAGECONVERTER_LOCAL void doAbort() override;
+        MAGNUM_ANYIMAGECONVERTER_LOCAL bool doBeginFile(Containers::StringView filename, PixelFormat format, const Vector2i& size, ImageFlags2D flags) override;
+        MAGNUM_ANYIMAGECONVERTER_LOCAL bool doAddRows(const ImageView2D& rows) override;
+        MAGNUM_ANYIMAGECONVERTER_LOCAL bool doEndFile() override;
+
+        MAGNUM_ANYIMAGECONVERTER_LOCAL Containers::Pointer<AbstractImageConverter> instantiate(Containers::StringView plugin, Containers::StringView metadataName, const char* messagePrefix);
+        MAGNUM_ANYIMAGECONVERTER_LOCAL void release(Containers::StringView plugin, Containers::Pointer<AbstractImageConverter>&& converter);
+
+        Containers::Pointer<AbstractImageConverter> _converter;
+        Containers::StringView _converterPlugin;
+        Containers::Pointer<Magnum::Implementation::PluginInstancePool<AbstractImageConverter>> _pool;
 };
 
 }}
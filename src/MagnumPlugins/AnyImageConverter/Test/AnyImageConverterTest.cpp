@@ -43,6 +43,10 @@
 
 #include "configure.h"
 
+#ifndef ANYIMAGECONVERTER_PLUGIN_FILENAME
+#include "MagnumPlugins/AnyImageConverter/AnyImageConverter.h"
+#endif
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct AnyImageConverterTest: TestSuite::Tester {
@@ -130,6 +134,12 @@ struct AnyImageConverterTest: TestSuite::Tester {
     void propagateConfigurationCompressedUnknownLevels2D();
     void propagateConfigurationCompressedUnknownLevels3D();
 
+    void stream2D();
+    void stream2DUnknown();
+    void stream2DAbort();
+
+    void instancePool();
+
     /* configuration propagation fully tested in AnySceneImporter, as there the
        plugins have configuration subgroups as well */
 
@@ -402,6 +412,12 @@ AnyImageConverterTest::AnyImageConverterTest() {
         &AnyImageConverterTest::propagateConfigurationCompressedUnknownLevels3D},
         Containers::arraySize(PropagateConfigurationUnknownData));
 
+    addTests({&AnyImageConverterTest::stream2D,
+              &AnyImageConverterTest::stream2DUnknown,
+              &AnyImageConverterTest::stream2DAbort,
+
+              &AnyImageConverterTest::instancePool});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef ANYIMAGECONVERTER_PLUGIN_FILENAME
@@ -1888,6 +1904,122 @@ void AnyImageConverterTest::propagateConfigurationCompressedUnknownLevels3D() {
         CORRADE_COMPARE(out.str(), "Trade::AnyImageConverter::convertToFile(): option noSuchOption not recognized by KtxImageConverter\n");
 }
 
+void AnyImageConverterTest::stream2D() {
+    if(!(_manager.loadState("TgaImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImageConverter plugin not enabled, cannot test");
+
+    Containers::String filename = Utility::Path::join(ANYIMAGECONVERTER_TEST_OUTPUT_DIR, "2d-stream.tga");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+    CORRADE_VERIFY(converter->features() & ImageConverterFeature::Stream2DToFile);
+    converter->setFlags(ImageConverterFlag::Verbose);
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(converter->beginFile(filename, Image2D.format(), Image2D.size()));
+    }
+    CORRADE_VERIFY(converter->isConverting());
+    /* Add the image row by row */
+    for(Int y = 0; y != Image2D.size().y(); ++y)
+        CORRADE_VERIFY(converter->addRows(ImageView2D{PixelStorage{}.setSkip({0, y, 0}), Image2D.format(), {Image2D.size().x(), 1}, Data}));
+    CORRADE_VERIFY(converter->endFile());
+    CORRADE_VERIFY(!converter->isConverting());
+    CORRADE_COMPARE(out.str(),
+        "Trade::AnyImageConverter::beginFile(): using TgaImageConverter\n"
+        "Trade::TgaImageConverter::beginFile(): converting from RGB to BGR\n");
+
+    /* Verify the output is the same as with a non-streaming conversion */
+    Containers::Pointer<AbstractImageConverter> tgaConverter = _manager.instantiate("TgaImageConverter");
+    tgaConverter->configuration().setValue("rleFallbackIfLarger", false);
+    Containers::Optional<Containers::Array<char>> expected = tgaConverter->convertToData(Image2D);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE_AS(filename,
+        Containers::StringView{*expected},
+        TestSuite::Compare::FileToString);
+}
+
+void AnyImageConverterTest::stream2DUnknown() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->beginFile("image.xcf", PixelFormat::RGB8Unorm, {2, 3}));
+    CORRADE_VERIFY(!converter->isConverting());
+    CORRADE_COMPARE(out.str(), "Trade::AnyImageConverter::beginFile(): cannot determine the format of image.xcf for a 2D image\n");
+}
+
+void AnyImageConverterTest::stream2DAbort() {
+    if(!(_manager.loadState("TgaImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImageConverter plugin not enabled, cannot test");
+
+    Containers::String filename = Utility::Path::join(ANYIMAGECONVERTER_TEST_OUTPUT_DIR, "2d-stream-abort.tga");
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+    CORRADE_VERIFY(converter->beginFile(filename, Image2D.format(), Image2D.size()));
+    CORRADE_VERIFY(Utility::Path::exists(filename));
+
+    /* The abort gets propagated to the TgaImageConverter, which removes the
+       file */
+    converter->abort();
+    CORRADE_VERIFY(!converter->isConverting());
+    CORRADE_VERIFY(!Utility::Path::exists(filename));
+}
+
+void AnyImageConverterTest::instancePool() {
+    if(!(_manager.loadState("TgaImageConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImageConverter plugin not enabled, cannot test");
+
+    Containers::String filename = Utility::Path::join(ANYIMAGECONVERTER_TEST_OUTPUT_DIR, "pool.tga");
+    Containers::String filenameStream = Utility::Path::join(ANYIMAGECONVERTER_TEST_OUTPUT_DIR, "pool-stream.tga");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+    if(Utility::Path::exists(filenameStream))
+        CORRADE_VERIFY(Utility::Path::remove(filenameStream));
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+    converter->configuration().setValue("instancePool", true);
+    converter->setFlags(ImageConverterFlag::Verbose);
+
+    /* The first conversion creates a new instance, the second and the
+       streaming one reuse it. The option isn't propagated to the concrete
+       plugin, so there should be no warning about it not being recognized. */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(converter->convertToFile(Image2D, filename));
+        CORRADE_VERIFY(converter->convertToFile(Image2D, filename));
+        CORRADE_VERIFY(converter->beginFile(filenameStream, Image2D.format(), Image2D.size()));
+    }
+    CORRADE_VERIFY(converter->addRows(Image2D));
+    CORRADE_VERIFY(converter->endFile());
+    CORRADE_VERIFY(Utility::Path::exists(filename));
+    CORRADE_VERIFY(Utility::Path::exists(filenameStream));
+    CORRADE_COMPARE(out.str(),
+        "Trade::AnyImageConverter::convertToFile(): using TgaImageConverter\n"
+        "Trade::TgaImageConverter::convertToData(): converting from RGB to BGR\n"
+        "Trade::TgaImageConverter::convertToData(): RLE output 3 bytes larger than uncompressed, falling back to uncompressed\n"
+        "Trade::AnyImageConverter::convertToFile(): using TgaImageConverter\n"
+        "Trade::AnyImageConverter::convertToFile(): reusing a pooled TgaImageConverter instance\n"
+        "Trade::TgaImageConverter::convertToData(): converting from RGB to BGR\n"
+        "Trade::TgaImageConverter::convertToData(): RLE output 3 bytes larger than uncompressed, falling back to uncompressed\n"
+        "Trade::AnyImageConverter::beginFile(): using TgaImageConverter\n"
+        "Trade::AnyImageConverter::beginFile(): reusing a pooled TgaImageConverter instance\n"
+        "Trade::TgaImageConverter::beginFile(): converting from RGB to BGR\n");
+
+    /* The counters are accessible only if the plugin is linked directly */
+    #ifndef ANYIMAGECONVERTER_PLUGIN_FILENAME
+    AnyImageConverter& anyConverter = static_cast<AnyImageConverter&>(*converter);
+    CORRADE_COMPARE(anyConverter.instancePoolMissCount("TgaImageConverter"), 1);
+    CORRADE_COMPARE(anyConverter.instancePoolHitCount("TgaImageConverter"), 2);
+    CORRADE_COMPARE(anyConverter.instancePoolMissCount("PngImageConverter"), 0);
+    CORRADE_COMPARE(anyConverter.instancePoolHitCount("PngImageConverter"), 0);
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AnyImageConverterTest)
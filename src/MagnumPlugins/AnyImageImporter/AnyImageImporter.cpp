@@ -37,6 +37,7 @@
 #include <Corrade/Utility/String.h> /* lowercase() */
 
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/Implementation/PluginInstancePool.h"
 #include "MagnumPlugins/Implementation/propagateConfiguration.h"
 
 namespace Magnum { namespace Trade {
@@ -55,10 +56,62 @@ ImporterFeatures AnyImageImporter::doFeatures() const {
     return ImporterFeature::OpenData|ImporterFeature::FileCallback;
 }
 
+UnsignedInt AnyImageImporter::instancePoolHitCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->hitCount(plugin) : 0;
+}
+
+UnsignedInt AnyImageImporter::instancePoolMissCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->missCount(plugin) : 0;
+}
+
+namespace {
+
+/* Options of the plugin itself, not propagated to the concrete plugin */
+constexpr Containers::StringView OwnOptions[]{
+    "instancePool"_s
+};
+
+}
+
+Containers::Pointer<AbstractImporter> AnyImageImporter::instantiate(const Containers::StringView plugin, const Containers::StringView metadataName, const char* const messagePrefix) {
+    /* Reuse a pooled instance if there's one. The configuration was
+       propagated to it already when it was created. */
+    if(configuration().value<bool>("instancePool")) {
+        if(!_pool) _pool.emplace();
+        if(Containers::Pointer<AbstractImporter> importer = _pool->take(plugin)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << messagePrefix << "reusing a pooled" << plugin << "instance";
+            importer->setFlags(flags());
+            return importer;
+        }
+    }
+
+    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
+    importer->setFlags(flags());
+
+    /* Propagate configuration */
+    Magnum::Implementation::propagateConfiguration(messagePrefix, {}, metadataName, configuration(), importer->configuration(), !(flags() & ImporterFlag::Quiet), OwnOptions);
+
+    return importer;
+}
+
+void AnyImageImporter::release(const Containers::StringView plugin, Containers::Pointer<AbstractImporter>&& importer) {
+    /* Without pooling the instance gets simply destroyed */
+    Containers::Pointer<AbstractImporter> released = Utility::move(importer);
+    if(!configuration().value<bool>("instancePool")) return;
+
+    /* Otherwise close it and reset the file callback so it doesn't leak to
+       the next use, which may not have any */
+    released->close();
+    if(released->fileCallback()) released->setFileCallback(nullptr);
+    if(!_pool) _pool.emplace();
+    _pool->put(plugin, Utility::move(released));
+}
+
 bool AnyImageImporter::doIsOpened() const { return !!_in; }
 
 void AnyImageImporter::doClose() {
-    _in = nullptr;
+    release(_inPlugin, Utility::move(_in));
 }
 
 void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
@@ -173,20 +226,21 @@ void AnyImageImporter::doOpenFile(const Containers::StringView filename) {
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags and the file callback, if set */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+    /* Instantiate the plugin or take it from the pool, propagate flags,
+       configuration and the file callback, if set */
+    Containers::Pointer<AbstractImporter> importer = instantiate(plugin, metadata->name(), "Trade::AnyImageImporter::openFile():");
     if(fileCallback()) importer->setFileCallback(fileCallback(), fileCallbackUserData());
 
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageImporter::openFile():", {}, metadata->name(), configuration(), importer->configuration(), !(flags() & ImporterFlag::Quiet));
-
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    if(!importer->openFile(filename)) return;
+    if(!importer->openFile(filename)) {
+        release(plugin, Utility::move(importer));
+        return;
+    }
 
     /* Success, save the instance */
     _in = Utility::move(importer);
+    _inPlugin = plugin;
 }
 
 void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
@@ -298,22 +352,23 @@ void AnyImageImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags. File callbacks not propagated
-       here as no image importers currently load any extra files. */
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration. File callbacks not propagated here as no image importers
+       currently load any extra files. */
     /** @todo revisit callbacks when that becomes true (such as loading XMP
         files accompanying RAWs) */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnyImageImporter::openData():", {}, metadata->name(), configuration(), importer->configuration(), !(flags() & ImporterFlag::Quiet));
+    Containers::Pointer<AbstractImporter> importer = instantiate(plugin, metadata->name(), "Trade::AnyImageImporter::openData():");
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    if(!importer->openData(data)) return;
+    if(!importer->openData(data)) {
+        release(plugin, Utility::move(importer));
+        return;
+    }
 
     /* Success, save the instance */
     _in = Utility::move(importer);
+    _inPlugin = plugin;
 }
 
 UnsignedInt AnyImageImporter::doImage1DCount() const { return _in->image1DCount(); }
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnyImageImporter
  */
 
+#include <Corrade/Containers/StringView.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
 #include "MagnumPlugins/AnyImageImporter/configure.h"
 
@@ -48,6 +50,12 @@
 #define MAGNUM_ANYIMAGEIMPORTER_LOCAL
 #endif
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace Implementation {
+    template<class> class PluginInstancePool;
+}}
+#endif
+
 namespace Magnum { namespace Trade {
 
 /**
@@ -160,12 +168,40 @@ Calls to the @ref image1DCount() / @ref image2DCount() / @ref image3DCount(),
 @ref image1DLevelCount() / @ref image2DLevelCount() / @ref image3DLevelCount()
 and @ref image1D() / @ref image2D() / @ref image3D() functions are then proxied
 to the concrete implementation. The @ref close() function closes and discards
-the internally instantiated plugin; @ref isOpened() works as usual.
+the internally instantiated plugin, unless
+@ref Trade-AnyImageImporter-pool "instance pooling" is enabled;
+@ref isOpened() works as usual.
 
 Besides delegating the flags, the @ref AnyImageImporter itself recognizes
 @ref ImporterFlag::Verbose, printing info about the concrete plugin being used
 when the flag is enabled. @ref ImporterFlag::Quiet is recognized as well and
 causes all warnings to be suppressed.
+
+@section Trade-AnyImageImporter-pool Instance pooling
+
+By default, a new instance of the concrete plugin is created on every
+@ref openFile() / @ref openData() call. When importing a large amount of small
+files, the instantiation and option propagation can become a significant part
+of the import time. If the @cb{.ini} instancePool @ce
+@ref Trade-AnyImageImporter-configuration "configuration option" is enabled,
+the concrete plugin is only closed on @ref close() and kept for reuse by the
+next file of the same format. At most one idle instance is kept per concrete
+plugin.
+
+Flags and file callbacks are set on every reuse, but the configuration is
+propagated only when the instance is created. Changes to @ref configuration()
+done after a particular format was first used are thus not reflected by its
+pooled instance. Counts of reused and newly created instances are available
+through @ref instancePoolHitCount() and @ref instancePoolMissCount().
+
+@section Trade-AnyImageImporter-configuration Plugin-specific configuration
+
+Apart from the options that are propagated to the concrete implementation, the
+plugin recognizes the following option, which isn't propagated. See
+@ref plugins-configuration for more information and an example showing how to
+edit the configuration values.
+
+@snippet MagnumPlugins/AnyImageImporter/AnyImageImporter.conf configuration_
 */
 class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
     public:
@@ -194,6 +230,34 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
 
         ~AnyImageImporter();
 
+        /**
+         * @brief Count of pooled instance reuses for given plugin
+         * @m_since_latest
+         *
+         * Count of files opened with a pooled instance of @p plugin instead
+         * of a newly created one. The @p plugin is the name the file format
+         * was detected as, such as @cpp "PngImporter" @ce. Always
+         * @cpp 0 @ce if the @cb{.ini} instancePool @ce
+         * @ref Trade-AnyImageImporter-configuration "configuration option"
+         * isn't enabled. See @ref Trade-AnyImageImporter-pool for more
+         * information.
+         * @see @ref instancePoolMissCount()
+         */
+        UnsignedInt instancePoolHitCount(Containers::StringView plugin) const;
+
+        /**
+         * @brief Count of instance creations for given plugin
+         * @m_since_latest
+         *
+         * Count of files for which a new instance of @p plugin had to be
+         * created because there was no pooled one. Always @cpp 0 @ce if the
+         * @cb{.ini} instancePool @ce
+         * @ref Trade-AnyImageImporter-configuration "configuration option"
+         * isn't enabled.
+         * @see @ref instancePoolHitCount()
+         */
+        UnsignedInt instancePoolMissCount(Containers::StringView plugin) const;
+
     private:
         MAGNUM_ANYIMAGEIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL bool doIsOpened() const override;
@@ -213,7 +277,12 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage3DLevelCount(UnsignedInt id) override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Pointer<AbstractImporter> instantiate(Containers::StringView plugin, Containers::StringView metadataName, const char* messagePrefix);
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL void release(Containers::StringView plugin, Containers::Pointer<AbstractImporter>&& importer);
+
         Containers::Pointer<AbstractImporter> _in;
+        Containers::StringView _inPlugin;
+        Containers::Pointer<Magnum::Implementation::PluginInstancePool<AbstractImporter>> _pool;
 };
 
 }}
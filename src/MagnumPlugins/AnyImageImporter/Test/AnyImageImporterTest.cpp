@@ -42,6 +42,10 @@
 
 #include "configure.h"
 
+#ifndef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/AnyImageImporter/AnyImageImporter.h"
+#endif
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct AnyImageImporterTest: TestSuite::Tester {
@@ -64,6 +68,8 @@ struct AnyImageImporterTest: TestSuite::Tester {
        plugins have configuration subgroups as well */
     void propagateFileCallback();
 
+    void instancePool();
+
     void images1D();
     void images2D();
     void images3D();
@@ -215,8 +221,12 @@ AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::propagateConfigurationUnknown},
         Containers::arraySize(PropagateConfigurationUnknownData));
 
-    addTests({&AnyImageImporterTest::propagateFileCallback,
+    addTests({&AnyImageImporterTest::propagateFileCallback});
+
+    addInstancedTests({&AnyImageImporterTest::instancePool},
+        Containers::arraySize(LoadData));
 
+    addTests({
               &AnyImageImporterTest::images1D,
               &AnyImageImporterTest::images2D,
               &AnyImageImporterTest::images3D,
@@ -422,6 +432,58 @@ void AnyImageImporterTest::propagateFlags() {
         data.messageFunctionName));
 }
 
+void AnyImageImporterTest::instancePool() {
+    auto&& data = LoadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    importer->configuration().setValue("instancePool", true);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    const Containers::String filename = Utility::Path::join(ANYIMAGEIMPORTER_TEST_DIR, data.filename);
+    Containers::Optional<Containers::Array<char>> read = Utility::Path::read(filename);
+    CORRADE_VERIFY(read);
+
+    /* The option isn't propagated to the concrete plugin, so there should be
+       no warning about it not being recognized */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+
+        /* The first open creates a new instance, the second reuses it after
+           an explicit close(), the third after an implicit one */
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(i == 1) importer->close();
+            if(data.asData)
+                CORRADE_VERIFY(importer->openData(*read));
+            else
+                CORRADE_VERIFY(importer->openFile(filename));
+        }
+        CORRADE_VERIFY(importer->image2D(0));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnyImageImporter::{0}(): using TgaImporter\n"
+        "Trade::AnyImageImporter::{0}(): using TgaImporter\n"
+        "Trade::AnyImageImporter::{0}(): reusing a pooled TgaImporter instance\n"
+        "Trade::AnyImageImporter::{0}(): using TgaImporter\n"
+        "Trade::AnyImageImporter::{0}(): reusing a pooled TgaImporter instance\n"
+        "Trade::TgaImporter::image2D(): converting from BGR to RGB\n",
+        data.messageFunctionName));
+
+    /* The counters are accessible only if the plugin is linked directly */
+    #ifndef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+    AnyImageImporter& anyImporter = static_cast<AnyImageImporter&>(*importer);
+    CORRADE_COMPARE(anyImporter.instancePoolMissCount("TgaImporter"), 1);
+    CORRADE_COMPARE(anyImporter.instancePoolHitCount("TgaImporter"), 2);
+    CORRADE_COMPARE(anyImporter.instancePoolMissCount("PngImporter"), 0);
+    CORRADE_COMPARE(anyImporter.instancePoolHitCount("PngImporter"), 0);
+    #endif
+}
+
 void AnyImageImporterTest::propagateConfiguration() {
     auto&& data = PropagateConfigurationData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
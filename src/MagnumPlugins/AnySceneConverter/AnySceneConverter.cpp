@@ -38,6 +38,7 @@
 
 #include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/Implementation/PluginInstancePool.h"
 #include "MagnumPlugins/Implementation/propagateConfiguration.h"
 
 namespace Magnum { namespace Trade {
@@ -50,6 +51,54 @@ AnySceneConverter::AnySceneConverter(PluginManager::AbstractManager& manager, co
 
 AnySceneConverter::~AnySceneConverter() = default;
 
+UnsignedInt AnySceneConverter::instancePoolHitCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->hitCount(plugin) : 0;
+}
+
+UnsignedInt AnySceneConverter::instancePoolMissCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->missCount(plugin) : 0;
+}
+
+namespace {
+
+/* Options of the plugin itself, not propagated to the concrete plugin */
+constexpr Containers::StringView OwnOptions[]{
+    "instancePool"_s
+};
+
+}
+
+Containers::Pointer<AbstractSceneConverter> AnySceneConverter::instantiate(const Containers::StringView plugin, const Containers::StringView metadataName, const char* const messagePrefix) {
+    /* Reuse a pooled instance if there's one. The configuration was
+       propagated to it already when it was created. */
+    if(configuration().value<bool>("instancePool")) {
+        if(!_pool) _pool.emplace();
+        if(Containers::Pointer<AbstractSceneConverter> converter = _pool->take(plugin)) {
+            if(flags() & SceneConverterFlag::Verbose)
+                Debug{} << messagePrefix << "reusing a pooled" << plugin << "instance";
+            converter->setFlags(flags());
+            return converter;
+        }
+    }
+
+    Containers::Pointer<AbstractSceneConverter> converter = static_cast<PluginManager::Manager<AbstractSceneConverter>*>(manager())->instantiate(plugin);
+    converter->setFlags(flags());
+
+    /* Propagate configuration */
+    Magnum::Implementation::propagateConfiguration(messagePrefix, {}, metadataName, configuration(), converter->configuration(), !(flags() & SceneConverterFlag::Quiet), OwnOptions);
+
+    return converter;
+}
+
+void AnySceneConverter::release(const Containers::StringView plugin, Containers::Pointer<AbstractSceneConverter>&& converter) {
+    /* Without pooling the instance gets simply destroyed */
+    Containers::Pointer<AbstractSceneConverter> released = Utility::move(converter);
+    if(!configuration().value<bool>("instancePool")) return;
+
+    if(!_pool) _pool.emplace();
+    _pool->put(plugin, Utility::move(released));
+}
+
 SceneConverterFeatures AnySceneConverter::doFeatures() const {
     /* Report that we can convert meshes and scenes to files, because that the
        plugin can do always as it dispatches there. But everything else is
@@ -108,21 +157,20 @@ bool AnySceneConverter::doConvertToFile(const MeshData& mesh, const Containers::
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractSceneConverter> converter = static_cast<PluginManager::Manager<AbstractSceneConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnySceneConverter::convertToFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & SceneConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractSceneConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnySceneConverter::convertToFile():");
 
     /* Try to convert the file (error output should be printed by the plugin
-       itself) */
-    return converter->convertToFile(mesh, filename);
+       itself), then put the instance back to the pool, if enabled */
+    const bool out = converter->convertToFile(mesh, filename);
+    release(plugin, Utility::move(converter));
+    return out;
 }
 
 void AnySceneConverter::doAbort() {
     _converter->abort();
-    _converter = {};
+    release(_converterPlugin, Utility::move(_converter));
 }
 
 bool AnySceneConverter::doBeginFile(const Containers::StringView filename) {
@@ -160,27 +208,28 @@ bool AnySceneConverter::doBeginFile(const Containers::StringView filename) {
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractSceneConverter> converter = static_cast<PluginManager::Manager<AbstractSceneConverter>*>(manager())->instantiate(plugin);
-    converter->setFlags(flags());
-
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnySceneConverter::beginFile():", {}, metadata->name(), configuration(), converter->configuration(), !(flags() & SceneConverterFlag::Quiet));
+    /* Instantiate the plugin or take it from the pool, propagate flags and
+       configuration */
+    Containers::Pointer<AbstractSceneConverter> converter = instantiate(plugin, metadata->name(), "Trade::AnySceneConverter::beginFile():");
 
     /* Try to begin the file (error output should be printed by the plugin
        itself) */
-    if(!converter->beginFile(filename)) return false;
+    if(!converter->beginFile(filename)) {
+        release(plugin, Utility::move(converter));
+        return false;
+    }
 
     /* Success, save the instance */
     _converter = Utility::move(converter);
+    _converterPlugin = plugin;
     return true;
 }
 
 bool AnySceneConverter::doEndFile(Containers::StringView) {
     /* Destroy the converter instance after the operation finishes to avoid
-       keeping now-useless state around */
+       keeping now-useless state around, or put it back to the pool */
     const bool out = _converter->endFile();
-    _converter = {};
+    release(_converterPlugin, Utility::move(_converter));
     return out;
 }
 
@@ -31,6 +31,7 @@
  */
 
 #include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
 
 #include "Magnum/Trade/AbstractSceneConverter.h"
 #include "MagnumPlugins/AnySceneConverter/configure.h"
@@ -51,6 +52,12 @@
 #define MAGNUM_ANYSCENECONVERTER_LOCAL
 #endif
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace Implementation {
+    template<class> class PluginInstancePool;
+}}
+#endif
+
 namespace Magnum { namespace Trade {
 
 /**
@@ -120,12 +127,40 @@ advertising support for any actual data types. These are included only once
 
 Calls to the @ref endFile(), @ref add() and related functions are then proxied
 to the concrete implementation. The @ref abort() function aborts and destroys
-the internally instantiated plugin; @ref isConverting() works as usual.
+the internally instantiated plugin, unless
+@ref Trade-AnySceneConverter-pool "instance pooling" is enabled;
+@ref isConverting() works as usual.
 
 Besides delegating the flags, the @ref AnySceneConverter itself recognizes
 @ref SceneConverterFlag::Verbose, printing info about the concrete plugin being
 used when the flag is enabled. @ref SceneConverterFlag::Quiet is recognized as
 well and causes all warnings to be suppressed.
+
+@section Trade-AnySceneConverter-pool Instance pooling
+
+By default, a new instance of the concrete plugin is created on every
+@ref convertToFile() and @ref beginFile() call. When converting a large amount
+of small files, the instantiation and option propagation can become a
+significant part of the conversion time. If the @cb{.ini} instancePool @ce
+@ref Trade-AnySceneConverter-configuration "configuration option" is enabled,
+the concrete plugin is kept after the conversion finishes or is aborted and
+reused by the next conversion to the same format. At most one idle instance is
+kept per concrete plugin.
+
+Flags are set on every reuse, but the configuration is propagated only when
+the instance is created. Changes to @ref configuration() done after a
+particular format was first used are thus not reflected by its pooled
+instance. Counts of reused and newly created instances are available through
+@ref instancePoolHitCount() and @ref instancePoolMissCount().
+
+@section Trade-AnySceneConverter-configuration Plugin-specific configuration
+
+Apart from the options that are propagated to the concrete implementation, the
+plugin recognizes the following option, which isn't propagated. See
+@ref plugins-configuration for more information and an example showing how to
+edit the configuration values.
+
+@snippet MagnumPlugins/AnySceneConverter/AnySceneConverter.conf configuration_
 */
 class MAGNUM_ANYSCENECONVERTER_EXPORT AnySceneConverter: public AbstractSceneConverter {
     public:
@@ -137,6 +172,34 @@ class MAGNUM_ANYSCENECONVERTER_EXPORT AnySceneConverter: public AbstractSceneCon
 
         ~AnySceneConverter();
 
+        /**
+         * @brief Count of pooled instance reuses for given plugin
+         * @m_since_latest
+         *
+         * Count of conversions done with a pooled instance of @p plugin
+         * instead of a newly created one. The @p plugin is the name the file
+         * format was detected as, such as @cpp "GltfSceneConverter" @ce.
+         * Always @cpp 0 @ce if the @cb{.ini} instancePool @ce
+         * @ref Trade-AnySceneConverter-configuration "configuration option"
+         * isn't enabled. See @ref Trade-AnySceneConverter-pool for more
+         * information.
+         * @see @ref instancePoolMissCount()
+         */
+        UnsignedInt instancePoolHitCount(Containers::StringView plugin) const;
+
+        /**
+         * @brief Count of instance creations for given plugin
+         * @m_since_latest
+         *
+         * Count of conversions for which a new instance of @p plugin had to
+         * be created because there was no pooled one. Always @cpp 0 @ce if
+         * the @cb{.ini} instancePool @ce
+         * @ref Trade-AnySceneConverter-configuration "configuration option"
+         * isn't enabled.
+         * @see @ref instancePoolHitCount()
+         */
+        UnsignedInt instancePoolMissCount(Containers::StringView plugin) const;
+
     private:
         MAGNUM_ANYSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
         MAGNUM_ANYSCENECONVERTER_LOCAL bool doConvertToFile(const MeshData& mesh, Containers::StringView filename) override;
@@ -174,7 +237,12 @@ class MAGNUM_ANYSCENECONVERTER_EXPORT AnySceneConverter: public AbstractSceneCon
         MAGNUM_ANYSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData3D& image, Containers::StringView name) override;
         MAGNUM_ANYSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const Containers::Iterable<const ImageData3D>& imageLevels, Containers::StringView name) override;
 
+        MAGNUM_ANYSCENECONVERTER_LOCAL Containers::Pointer<AbstractSceneConverter> instantiate(Containers::StringView plugin, Containers::StringView metadataName, const char* messagePrefix);
+        MAGNUM_ANYSCENECONVERTER_LOCAL void release(Containers::StringView plugin, Containers::Pointer<AbstractSceneConverter>&& converter);
+
         Containers::Pointer<AbstractSceneConverter> _converter;
+        Containers::StringView _converterPlugin;
+        Containers::Pointer<Magnum::Implementation::PluginInstancePool<AbstractSceneConverter>> _pool;
 };
 
 }}
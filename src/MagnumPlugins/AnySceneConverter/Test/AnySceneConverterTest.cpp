@@ -49,6 +49,10 @@
 
 #include "configure.h"
 
+#ifndef ANYSCENECONVERTER_PLUGIN_FILENAME
+#include "MagnumPlugins/AnySceneConverter/AnySceneConverter.h"
+#endif
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct AnySceneConverterTest: TestSuite::Tester {
@@ -56,6 +60,7 @@ struct AnySceneConverterTest: TestSuite::Tester {
 
     void convert();
     void convertBeginEnd();
+    void convertInstancePool();
 
     void detectConvert();
     void detectBeginEnd();
@@ -141,6 +146,8 @@ AnySceneConverterTest::AnySceneConverterTest() {
     addInstancedTests({&AnySceneConverterTest::convertBeginEnd},
         Containers::arraySize(ConvertBeginEndData));
 
+    addTests({&AnySceneConverterTest::convertInstancePool});
+
     addInstancedTests({&AnySceneConverterTest::detectConvert},
         Containers::arraySize(DetectConvertData));
 
@@ -258,6 +265,64 @@ void AnySceneConverterTest::convertBeginEnd() {
     CORRADE_COMPARE_AS(filename, Utility::Path::join(ANYSCENECONVERTER_TEST_DIR, "triangle.ply"), TestSuite::Compare::File);
 }
 
+void AnySceneConverterTest::convertInstancePool() {
+    PluginManager::Manager<AbstractSceneConverter> manager{MAGNUM_PLUGINS_SCENECONVERTER_INSTALL_DIR};
+    #ifdef ANYSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(ANYSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Catch also ABI and interface mismatch errors */
+    if(!(manager.load("StanfordSceneConverter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("StanfordSceneConverter plugin can't be loaded.");
+
+    Containers::String filename = Utility::Path::join(ANYSCENECONVERTER_TEST_OUTPUT_DIR, "file-pool.ply");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    const Vector3 positions[] {
+        {-0.5f, -0.5f, 0.0f},
+        { 0.5f, -0.5f, 0.0f},
+        { 0.0f,  0.5f, 0.0f}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    Containers::Pointer<AbstractSceneConverter> converter = manager.instantiate("AnySceneConverter");
+    converter->configuration().setValue("instancePool", true);
+    converter->setFlags(SceneConverterFlag::Verbose);
+
+    /* The first conversion creates a new instance, the second and the
+       begin/end one reuse it. The option isn't propagated to the concrete
+       plugin, so there should be no warning about it not being recognized. */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(converter->convertToFile(mesh, filename));
+        CORRADE_VERIFY(converter->convertToFile(mesh, filename));
+        CORRADE_VERIFY(converter->beginFile(filename));
+    }
+    CORRADE_VERIFY(converter->add(mesh));
+    CORRADE_VERIFY(converter->endFile());
+    CORRADE_COMPARE_AS(filename, Utility::Path::join(ANYSCENECONVERTER_TEST_DIR, "triangle.ply"), TestSuite::Compare::File);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AnySceneConverter::convertToFile(): using StanfordSceneConverter\n"
+        "Trade::AnySceneConverter::convertToFile(): using StanfordSceneConverter\n"
+        "Trade::AnySceneConverter::convertToFile(): reusing a pooled StanfordSceneConverter instance\n"
+        "Trade::AnySceneConverter::beginFile(): using StanfordSceneConverter\n"
+        "Trade::AnySceneConverter::beginFile(): reusing a pooled StanfordSceneConverter instance\n");
+
+    /* The counters are accessible only if the plugin is linked directly */
+    #ifndef ANYSCENECONVERTER_PLUGIN_FILENAME
+    AnySceneConverter& anyConverter = static_cast<AnySceneConverter&>(*converter);
+    CORRADE_COMPARE(anyConverter.instancePoolMissCount("StanfordSceneConverter"), 1);
+    CORRADE_COMPARE(anyConverter.instancePoolHitCount("StanfordSceneConverter"), 2);
+    CORRADE_COMPARE(anyConverter.instancePoolMissCount("GltfSceneConverter"), 0);
+    CORRADE_COMPARE(anyConverter.instancePoolHitCount("GltfSceneConverter"), 0);
+    #endif
+}
+
 void AnySceneConverterTest::detectConvert() {
     auto&& data = DetectConvertData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
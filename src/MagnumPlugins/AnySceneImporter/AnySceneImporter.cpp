@@ -42,6 +42,7 @@
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/SkinData.h"
 #include "Magnum/Trade/TextureData.h"
+#include "MagnumPlugins/Implementation/PluginInstancePool.h"
 #include "MagnumPlugins/Implementation/propagateConfiguration.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -68,10 +69,62 @@ ImporterFeatures AnySceneImporter::doFeatures() const {
     return ImporterFeature::FileCallback;
 }
 
+UnsignedInt AnySceneImporter::instancePoolHitCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->hitCount(plugin) : 0;
+}
+
+UnsignedInt AnySceneImporter::instancePoolMissCount(const Containers::StringView plugin) const {
+    return _pool ? _pool->missCount(plugin) : 0;
+}
+
+namespace {
+
+/* Options of the plugin itself, not propagated to the concrete plugin */
+constexpr Containers::StringView OwnOptions[]{
+    "instancePool"_s
+};
+
+}
+
+Containers::Pointer<AbstractImporter> AnySceneImporter::instantiate(const Containers::StringView plugin, const Containers::StringView metadataName) {
+    /* Reuse a pooled instance if there's one. The configuration was
+       propagated to it already when it was created. */
+    if(configuration().value<bool>("instancePool")) {
+        if(!_pool) _pool.emplace();
+        if(Containers::Pointer<AbstractImporter> importer = _pool->take(plugin)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << "Trade::AnySceneImporter::openFile(): reusing a pooled" << plugin << "instance";
+            importer->setFlags(flags());
+            return importer;
+        }
+    }
+
+    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
+    importer->setFlags(flags());
+
+    /* Propagate configuration */
+    Magnum::Implementation::propagateConfiguration("Trade::AnySceneImporter::openFile():", {}, metadataName, configuration(), importer->configuration(), !(flags() & ImporterFlag::Quiet), OwnOptions);
+
+    return importer;
+}
+
+void AnySceneImporter::release(const Containers::StringView plugin, Containers::Pointer<AbstractImporter>&& importer) {
+    /* Without pooling the instance gets simply destroyed */
+    Containers::Pointer<AbstractImporter> released = Utility::move(importer);
+    if(!configuration().value<bool>("instancePool")) return;
+
+    /* Otherwise close it and reset the file callback so it doesn't leak to
+       the next use, which may not have any */
+    released->close();
+    if(released->fileCallback()) released->setFileCallback(nullptr);
+    if(!_pool) _pool.emplace();
+    _pool->put(plugin, Utility::move(released));
+}
+
 bool AnySceneImporter::doIsOpened() const { return !!_in; }
 
 void AnySceneImporter::doClose() {
-    _in = nullptr;
+    release(_inPlugin, Utility::move(_in));
 }
 
 void AnySceneImporter::doOpenFile(const Containers::StringView filename) {
@@ -164,20 +217,21 @@ void AnySceneImporter::doOpenFile(const Containers::StringView filename) {
             d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags and the file callback, if set */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+    /* Instantiate the plugin or take it from the pool, propagate flags,
+       configuration and the file callback, if set */
+    Containers::Pointer<AbstractImporter> importer = instantiate(plugin, metadata->name());
     if(fileCallback()) importer->setFileCallback(fileCallback(), fileCallbackUserData());
 
-    /* Propagate configuration */
-    Magnum::Implementation::propagateConfiguration("Trade::AnySceneImporter::openFile():", {}, metadata->name(), configuration(), importer->configuration(), !(flags() & ImporterFlag::Quiet));
-
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    if(!importer->openFile(filename)) return;
+    if(!importer->openFile(filename)) {
+        release(plugin, Utility::move(importer));
+        return;
+    }
 
     /* Success, save the instance */
     _in = Utility::move(importer);
+    _inPlugin = plugin;
 }
 
 UnsignedInt AnySceneImporter::doAnimationCount() const { return _in->animationCount(); }
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnySceneImporter
  */
 
+#include <Corrade/Containers/StringView.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
 #include "MagnumPlugins/AnySceneImporter/configure.h"
 
@@ -48,6 +50,12 @@
 #define MAGNUM_ANYSCENEIMPORTER_LOCAL
 #endif
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace Implementation {
+    template<class> class PluginInstancePool;
+}}
+#endif
+
 namespace Magnum { namespace Trade {
 
 /**
@@ -152,7 +160,8 @@ Calls to the @ref animation(), @ref scene(), @ref light(), @ref camera(),
 @ref image1D(), @ref image2D(), @ref image3D() and corresponding
 count-/name-related functions are then proxied to the concrete implementation.
 The @ref close() function closes and discards the internally instantiated
-plugin; @ref isOpened() works as usual.
+plugin, unless @ref Trade-AnySceneImporter-pool "instance pooling" is enabled;
+@ref isOpened() works as usual.
 
 While the @ref meshAttributeName(), @ref meshAttributeForName(),
 @ref sceneFieldName() and @ref sceneFieldForName() APIs can be called without a
@@ -162,6 +171,32 @@ Besides delegating the flags, the @ref AnySceneImporter itself recognizes
 @ref ImporterFlag::Verbose, printing info about the concrete plugin being used
 when the flag is enabled. @ref ImporterFlag::Quiet is recognized as well and
 causes all warnings to be suppressed.
+
+@section Trade-AnySceneImporter-pool Instance pooling
+
+By default, a new instance of the concrete plugin is created on every
+@ref openFile() call. When importing a large amount of small files, the
+instantiation and option propagation can become a significant part of the
+import time. If the @cb{.ini} instancePool @ce
+@ref Trade-AnySceneImporter-configuration "configuration option" is enabled,
+the concrete plugin is only closed on @ref close() and kept for reuse by the
+next file of the same format. At most one idle instance is kept per concrete
+plugin.
+
+Flags and file callbacks are set on every reuse, but the configuration is
+propagated only when the instance is created. Changes to @ref configuration()
+done after a particular format was first used are thus not reflected by its
+pooled instance. Counts of reused and newly created instances are available
+through @ref instancePoolHitCount() and @ref instancePoolMissCount().
+
+@section Trade-AnySceneImporter-configuration Plugin-specific configuration
+
+Apart from the options that are propagated to the concrete implementation, the
+plugin recognizes the following option, which isn't propagated. See
+@ref plugins-configuration for more information and an example showing how to
+edit the configuration values.
+
+@snippet MagnumPlugins/AnySceneImporter/AnySceneImporter.conf configuration_
 */
 class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
     public:
@@ -173,6 +208,34 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
 
         ~AnySceneImporter();
 
+        /**
+         * @brief Count of pooled instance reuses for given plugin
+         * @m_since_latest
+         *
+         * Count of files opened with a pooled instance of @p plugin instead
+         * of a newly created one. The @p plugin is the name the file format
+         * was detected as, such as @cpp "GltfImporter" @ce. Always
+         * @cpp 0 @ce if the @cb{.ini} instancePool @ce
+         * @ref Trade-AnySceneImporter-configuration "configuration option"
+         * isn't enabled. See @ref Trade-AnySceneImporter-pool for more
+         * information.
+         * @see @ref instancePoolMissCount()
+         */
+        UnsignedInt instancePoolHitCount(Containers::StringView plugin) const;
+
+        /**
+         * @brief Count of instance creations for given plugin
+         * @m_since_latest
+         *
+         * Count of files for which a new instance of @p plugin had to be
+         * created because there was no pooled one. Always @cpp 0 @ce if the
+         * @cb{.ini} instancePool @ce
+         * @ref Trade-AnySceneImporter-configuration "configuration option"
+         * isn't enabled.
+         * @see @ref instancePoolHitCount()
+         */
+        UnsignedInt instancePoolMissCount(Containers::StringView plugin) const;
+
     private:
         MAGNUM_ANYSCENEIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL bool doIsOpened() const override;
@@ -287,7 +350,12 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::String doImage3DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
+        MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Pointer<AbstractImporter> instantiate(Containers::StringView plugin, Containers::StringView metadataName);
+        MAGNUM_ANYSCENEIMPORTER_LOCAL void release(Containers::StringView plugin, Containers::Pointer<AbstractImporter>&& importer);
+
         Containers::Pointer<AbstractImporter> _in;
+        Containers::StringView _inPlugin;
+        Containers::Pointer<Magnum::Implementation::PluginInstancePool<AbstractImporter>> _pool;
 };
 
 }}
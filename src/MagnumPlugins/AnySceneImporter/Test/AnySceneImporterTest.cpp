@@ -57,6 +57,10 @@
 
 #include "configure.h"
 
+#ifndef ANYSCENEIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/AnySceneImporter/AnySceneImporter.h"
+#endif
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct AnySceneImporterTest: TestSuite::Tester {
@@ -73,6 +77,8 @@ struct AnySceneImporterTest: TestSuite::Tester {
     void propagateConfigurationUnknownInEmptySubgroup();
     void propagateFileCallback();
 
+    void instancePool();
+
     void animations();
     void animationTrackTargetNameNoFileOpened();
 
@@ -161,6 +167,8 @@ AnySceneImporterTest::AnySceneImporterTest() {
     addTests({&AnySceneImporterTest::propagateConfigurationUnknownInEmptySubgroup,
               &AnySceneImporterTest::propagateFileCallback,
 
+              &AnySceneImporterTest::instancePool,
+
               &AnySceneImporterTest::animations,
               &AnySceneImporterTest::animationTrackTargetNameNoFileOpened,
 
@@ -375,6 +383,49 @@ void AnySceneImporterTest::propagateConfigurationUnknownInEmptySubgroup() {
         "Trade::AnySceneImporter::openFile(): option customSceneFieldTypes/notFound/noHereNotEither not recognized by GltfImporter\n");
 }
 
+void AnySceneImporterTest::instancePool() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    importer->configuration().setValue("instancePool", true);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    /* The option isn't propagated to the concrete plugin, so there should be
+       no warning about it not being recognized */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        Warning redirectWarning{&out};
+
+        /* The first open creates a new instance, the second reuses it after
+           an explicit close(), the third after an implicit one */
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(i == 1) importer->close();
+            CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-multiple.obj")));
+        }
+
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 2);
+    }
+    CORRADE_COMPARE(out.str(),
+        "Trade::AnySceneImporter::openFile(): using ObjImporter\n"
+        "Trade::AnySceneImporter::openFile(): using ObjImporter\n"
+        "Trade::AnySceneImporter::openFile(): reusing a pooled ObjImporter instance\n"
+        "Trade::AnySceneImporter::openFile(): using ObjImporter\n"
+        "Trade::AnySceneImporter::openFile(): reusing a pooled ObjImporter instance\n");
+
+    /* The counters are accessible only if the plugin is linked directly */
+    #ifndef ANYSCENEIMPORTER_PLUGIN_FILENAME
+    AnySceneImporter& anyImporter = static_cast<AnySceneImporter&>(*importer);
+    CORRADE_COMPARE(anyImporter.instancePoolMissCount("ObjImporter"), 1);
+    CORRADE_COMPARE(anyImporter.instancePoolHitCount("ObjImporter"), 2);
+    CORRADE_COMPARE(anyImporter.instancePoolMissCount("GltfImporter"), 0);
+    CORRADE_COMPARE(anyImporter.instancePoolHitCount("GltfImporter"), 0);
+    #endif
+}
+
 void AnySceneImporterTest::propagateFileCallback() {
     if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
@@ -0,0 +1,444 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CachingImporter.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h> /* for PluginMetadata::name() */
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Trade/AnimationData.h"
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/CameraData.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "Magnum/Trade/SkinData.h"
+#include "Magnum/Trade/TextureData.h"
+#include "MagnumPlugins/Implementation/propagateConfiguration.h"
+#include "MagnumPlugins/Implementation/temporaryFilename.h"
+
+namespace Magnum { namespace Trade {
+
+using namespace Containers::Literals;
+
+CachingImporter::CachingImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+CachingImporter::~CachingImporter() = default;
+
+ImporterFeatures CachingImporter::doFeatures() const { return {}; }
+
+namespace {
+
+/* Version of the cache layout, bump when the blob format or the way the data
+   are put together changes to invalidate all existing cache entries */
+constexpr Containers::StringView CacheVersion = "CachingImporter2"_s;
+
+/* The cache file starts with a header, followed by textureCount
+   CacheTexture entries and then by blobs for MagnumImporter. Both structs
+   have a size that's a multiple of 8 so the blobs stay aligned. */
+struct CacheHeader {
+    char magic[4];
+    UnsignedInt textureCount;
+    Int defaultScene;
+    UnsignedInt:32;
+};
+
+struct CacheTexture {
+    UnsignedInt type;
+    UnsignedInt minificationFilter;
+    UnsignedInt magnificationFilter;
+    UnsignedInt mipmapFilter;
+    UnsignedInt wrapping[3];
+    UnsignedInt image;
+};
+
+static_assert(sizeof(CacheHeader) == 16 && sizeof(CacheTexture) == 32,
+    "cache file header size is not a multiple of 8");
+
+constexpr const char CacheMagic[4]{'M', 'G', 'N', 'C'};
+
+}
+
+struct CachingImporter::Cache {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Path::MapDeleter> data;
+    #else
+    Containers::Array<char> data;
+    #endif
+    Int defaultScene;
+    Containers::ArrayView<const CacheTexture> textures;
+};
+
+bool CachingImporter::doIsOpened() const { return !!_in; }
+
+void CachingImporter::doClose() {
+    /* The importer references the cache data, so it has to go first */
+    _in = nullptr;
+    _cache = nullptr;
+}
+
+namespace {
+
+/* Each string is terminated with a null byte so e.g. a value "ab" with
+   subsequent "c" hashes differently from "a" and "bc" */
+void appendKey(Containers::Array<char>& out, const Containers::StringView string) {
+    arrayAppend(out, Containers::arrayView(string.data(), string.size()));
+    arrayAppend(out, '\0');
+}
+
+void appendKey(Containers::Array<char>& out, const Utility::ConfigurationGroup& group) {
+    for(Containers::Pair<Containers::StringView, Containers::StringView> value: group.values()) {
+        appendKey(out, value.first());
+        appendKey(out, value.second());
+    }
+    for(Containers::Pair<Containers::StringView, Containers::Reference<const Utility::ConfigurationGroup>> subgroup: group.groups()) {
+        appendKey(out, "["_s);
+        appendKey(out, subgroup.first());
+        appendKey(out, subgroup.second());
+        appendKey(out, "]"_s);
+    }
+}
+
+/* Returns a description of the first thing in the file that can't be stored
+   in the cache, or nullptr if everything can */
+const char* uncacheableData(AbstractImporter& importer) {
+    if(importer.animationCount()) return "animations";
+    if(importer.cameraCount()) return "cameras";
+    if(importer.lightCount()) return "lights";
+    if(importer.skin2DCount() || importer.skin3DCount()) return "skins";
+    for(UnsignedInt i = 0, count = importer.meshCount(); i != count; ++i)
+        if(importer.meshLevelCount(i) > 1) return "mesh levels";
+    for(UnsignedInt i = 0, count = importer.image1DCount(); i != count; ++i)
+        if(importer.image1DLevelCount(i) > 1) return "1D image levels";
+    for(UnsignedInt i = 0, count = importer.image2DCount(); i != count; ++i)
+        if(importer.image2DLevelCount(i) > 1) return "2D image levels";
+    for(UnsignedInt i = 0, count = importer.image3DCount(); i != count; ++i)
+        if(importer.image3DLevelCount(i) > 1) return "3D image levels";
+    return nullptr;
+}
+
+template<class T> bool appendBlob(Containers::Array<char>& out, const Containers::Optional<T>& data) {
+    if(!data) return false;
+    Containers::Optional<Containers::Array<char>> blob = serializeBlob(*data);
+    if(!blob) return false;
+    arrayAppend(out, *blob);
+    return true;
+}
+
+}
+
+void CachingImporter::doOpenFile(const Containers::StringView filename) {
+    CORRADE_INTERNAL_ASSERT(manager());
+    PluginManager::Manager<AbstractImporter>& manager = *static_cast<PluginManager::Manager<AbstractImporter>*>(this->manager());
+
+    const Containers::String cacheDirectory = configuration().value("cacheDirectory");
+    if(!cacheDirectory) {
+        Error{} << "Trade::CachingImporter::openFile(): the cacheDirectory option is not set";
+        return;
+    }
+
+    /* The cache needs the MagnumImporter in any case, check that it's
+       available before doing anything else */
+    if(!(manager.load("MagnumImporter"_s) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Trade::CachingImporter::openFile(): cannot load the MagnumImporter plugin";
+        return;
+    }
+
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data) {
+        Error{} << "Trade::CachingImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    /* Hash the file together with everything that affects the imported
+       data */
+    const Containers::String plugin = configuration().value("plugin");
+    const Utility::ConfigurationGroup& options = *configuration().group("options");
+    Containers::String cacheFilename;
+    {
+        Containers::Array<char> key;
+        appendKey(key, CacheVersion);
+        appendKey(key, plugin);
+        appendKey(key, options);
+
+        Utility::Sha1 sha1;
+        sha1 << *data << key;
+        const Utility::Sha1::Digest digest = sha1.digest();
+
+        constexpr const char Hex[] = "0123456789abcdef";
+        Containers::String hash{NoInit, Utility::Sha1::DigestSize*2};
+        for(std::size_t i = 0; i != Utility::Sha1::DigestSize; ++i) {
+            const UnsignedByte byte = digest.byteArray()[i];
+            hash[i*2 + 0] = Hex[byte >> 4];
+            hash[i*2 + 1] = Hex[byte & 0x0f];
+        }
+
+        cacheFilename = Utility::Path::join(cacheDirectory, hash + ".blob"_s);
+    }
+
+    /* Memory-maps the cache file where possible, parses the header and the
+       textures and opens the remaining blobs with a MagnumImporter. On
+       failure leaves the outputs in an unspecified state. */
+    const auto openCache = [&](Containers::Pointer<Cache>& cache, Containers::Pointer<AbstractImporter>& importer) -> bool {
+        cache.emplace();
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> data = Utility::Path::mapRead(cacheFilename);
+        #else
+        Containers::Optional<Containers::Array<char>> data = Utility::Path::read(cacheFilename);
+        #endif
+        if(!data) return false;
+        cache->data = *Utility::move(data);
+
+        if(cache->data.size() < sizeof(CacheHeader)) return false;
+        const CacheHeader& header = *reinterpret_cast<const CacheHeader*>(cache->data.data());
+        /* Comparing the count against the remaining size instead of
+           multiplying it so it can't overflow on 32-bit */
+        if(Containers::StringView{header.magic, 4} != Containers::StringView{CacheMagic, 4} ||
+           header.textureCount > (cache->data.size() - sizeof(CacheHeader))/sizeof(CacheTexture))
+            return false;
+        cache->defaultScene = header.defaultScene;
+        cache->textures = Containers::arrayCast<const CacheTexture>(cache->data.sliceSize(sizeof(CacheHeader), header.textureCount*sizeof(CacheTexture)));
+
+        importer = manager.instantiate("MagnumImporter"_s);
+        importer->setFlags(flags() & ~(ImporterFlag::Verbose|ImporterFlag::MapFile));
+        if(!importer->openMemory(cache->data.exceptPrefix(sizeof(CacheHeader) + cache->textures.size()*sizeof(CacheTexture))))
+            return false;
+
+        /* The default scene is the only thing that can reference data from
+           the blobs, the texture image IDs aren't validated by the
+           AbstractImporter either */
+        return cache->defaultScene >= -1 && cache->defaultScene < Int(importer->sceneCount());
+    };
+
+    /* Cache hit */
+    if(Utility::Path::exists(cacheFilename)) {
+        Containers::Pointer<Cache> cache;
+        Containers::Pointer<AbstractImporter> importer;
+        bool opened;
+        {
+            Error redirectError{nullptr};
+            opened = openCache(cache, importer);
+        }
+        if(opened) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << "Trade::CachingImporter::openFile(): cache hit for" << filename;
+            _in = Utility::move(importer);
+            _cache = Utility::move(cache);
+            return;
+        }
+
+        if(!(flags() & ImporterFlag::Quiet))
+            Warning{} << "Trade::CachingImporter::openFile(): invalid cache file" << cacheFilename << Debug::nospace << ", overwriting";
+    }
+
+    /* Cache miss, load the plugin that does the actual import */
+    if(!(manager.load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Trade::CachingImporter::openFile(): cannot load the" << plugin << "plugin";
+        return;
+    }
+
+    const PluginManager::PluginMetadata* const metadata = manager.metadata(plugin);
+    CORRADE_INTERNAL_ASSERT(metadata);
+    if(flags() & ImporterFlag::Verbose) {
+        Debug d;
+        d << "Trade::CachingImporter::openFile(): cache miss for" << filename << Debug::nospace << ", importing with" << plugin;
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Instantiate the plugin, propagate flags and options */
+    Containers::Pointer<AbstractImporter> importer = manager.instantiate(plugin);
+    importer->setFlags(flags());
+    Magnum::Implementation::propagateConfiguration("Trade::CachingImporter::openFile():", {}, metadata->name(), options, importer->configuration(), !(flags() & ImporterFlag::Quiet));
+
+    /* Try to open the file (error output should be printed by the plugin
+       itself) */
+    if(!importer->openFile(filename)) return;
+
+    /* The cache can store only the first level of scenes, meshes, materials
+       and images. If the file has anything else, use the importer directly
+       instead so nothing gets lost. */
+    if(const char* const what = uncacheableData(*importer)) {
+        if(!(flags() & ImporterFlag::Quiet))
+            Warning{} << "Trade::CachingImporter::openFile(): can't cache" << what << Debug::nospace << ", using" << plugin << "directly";
+        _in = Utility::move(importer);
+        return;
+    }
+
+    /* Import and serialize everything. If anything fails, use the importer
+       directly instead. The header is filled first, the texture count is
+       known upfront. */
+    Containers::Array<char> out;
+    {
+        CacheHeader& header = *reinterpret_cast<CacheHeader*>(arrayAppend(out, ValueInit, sizeof(CacheHeader)).data());
+        Utility::copy(Containers::arrayView(CacheMagic), header.magic);
+        header.textureCount = importer->textureCount();
+        header.defaultScene = importer->defaultScene();
+    }
+    const auto fail = [&](const char* what, const UnsignedInt id) {
+        if(!(flags() & ImporterFlag::Quiet))
+            Warning{} << "Trade::CachingImporter::openFile(): can't cache" << what << id << Debug::nospace << ", using" << plugin << "directly";
+        _in = Utility::move(importer);
+    };
+    for(UnsignedInt i = 0, count = importer->textureCount(); i != count; ++i) {
+        const Containers::Optional<TextureData> texture = importer->texture(i);
+        if(!texture) return fail("texture", i);
+        CacheTexture& cacheTexture = *reinterpret_cast<CacheTexture*>(arrayAppend(out, NoInit, sizeof(CacheTexture)).data());
+        cacheTexture.type = UnsignedInt(texture->type());
+        cacheTexture.minificationFilter = UnsignedInt(texture->minificationFilter());
+        cacheTexture.magnificationFilter = UnsignedInt(texture->magnificationFilter());
+        cacheTexture.mipmapFilter = UnsignedInt(texture->mipmapFilter());
+        for(std::size_t j = 0; j != 3; ++j)
+            cacheTexture.wrapping[j] = UnsignedInt(texture->wrapping()[j]);
+        cacheTexture.image = texture->image();
+    }
+    for(UnsignedInt i = 0, count = importer->sceneCount(); i != count; ++i)
+        if(!appendBlob(out, importer->scene(i)))
+            return fail("scene", i);
+    for(UnsignedInt i = 0, count = importer->meshCount(); i != count; ++i)
+        if(!appendBlob(out, importer->mesh(i)))
+            return fail("mesh", i);
+    for(UnsignedInt i = 0, count = importer->materialCount(); i != count; ++i)
+        if(!appendBlob(out, importer->material(i)))
+            return fail("material", i);
+    for(UnsignedInt i = 0, count = importer->image1DCount(); i != count; ++i)
+        if(!appendBlob(out, importer->image1D(i)))
+            return fail("1D image", i);
+    for(UnsignedInt i = 0, count = importer->image2DCount(); i != count; ++i)
+        if(!appendBlob(out, importer->image2D(i)))
+            return fail("2D image", i);
+    for(UnsignedInt i = 0, count = importer->image3DCount(); i != count; ++i)
+        if(!appendBlob(out, importer->image3D(i)))
+            return fail("3D image", i);
+
+    /* Write under a temporary name unique to this process and thread first so
+       concurrent writers of the same entry don't overwrite each other's
+       partial output and a partially written file is never picked up by
+       another instance */
+    const Containers::String temporaryFilename = Magnum::Implementation::temporaryFilename(cacheFilename);
+    if(!Utility::Path::make(cacheDirectory) ||
+       !Utility::Path::write(temporaryFilename, out) ||
+       !Utility::Path::move(temporaryFilename, cacheFilename)) {
+        /* Don't leave a partially written file behind. If it wasn't even
+           created, the removal fails, which is fine. */
+        if(Utility::Path::exists(temporaryFilename))
+            Utility::Path::remove(temporaryFilename);
+        if(!(flags() & ImporterFlag::Quiet))
+            Warning{} << "Trade::CachingImporter::openFile(): can't write" << cacheFilename << Debug::nospace << ", using" << plugin << "directly";
+        _in = Utility::move(importer);
+        return;
+    }
+
+    /* Serve the data from the newly written cache file so they're the same
+       as on a cache hit and the original importer can be closed. If that
+       fails, for example because the file got replaced by something else in
+       the meantime, stay with the original importer. */
+    Containers::Pointer<Cache> cache;
+    Containers::Pointer<AbstractImporter> cacheImporter;
+    if(!openCache(cache, cacheImporter)) {
+        if(!(flags() & ImporterFlag::Quiet))
+            Warning{} << "Trade::CachingImporter::openFile(): can't open" << cacheFilename << Debug::nospace << ", using" << plugin << "directly";
+        _in = Utility::move(importer);
+        return;
+    }
+    _in = Utility::move(cacheImporter);
+    _cache = Utility::move(cache);
+}
+
+Int CachingImporter::doDefaultScene() const {
+    return _cache ? _cache->defaultScene : _in->defaultScene();
+}
+
+UnsignedInt CachingImporter::doSceneCount() const { return _in->sceneCount(); }
+Containers::Optional<SceneData> CachingImporter::doScene(const UnsignedInt id) { return _in->scene(id); }
+
+UnsignedInt CachingImporter::doAnimationCount() const { return _in->animationCount(); }
+Containers::Optional<AnimationData> CachingImporter::doAnimation(const UnsignedInt id) { return _in->animation(id); }
+
+UnsignedInt CachingImporter::doLightCount() const { return _in->lightCount(); }
+Containers::Optional<LightData> CachingImporter::doLight(const UnsignedInt id) { return _in->light(id); }
+
+UnsignedInt CachingImporter::doCameraCount() const { return _in->cameraCount(); }
+Containers::Optional<CameraData> CachingImporter::doCamera(const UnsignedInt id) { return _in->camera(id); }
+
+UnsignedInt CachingImporter::doSkin2DCount() const { return _in->skin2DCount(); }
+Containers::Optional<SkinData2D> CachingImporter::doSkin2D(const UnsignedInt id) { return _in->skin2D(id); }
+
+UnsignedInt CachingImporter::doSkin3DCount() const { return _in->skin3DCount(); }
+Containers::Optional<SkinData3D> CachingImporter::doSkin3D(const UnsignedInt id) { return _in->skin3D(id); }
+
+UnsignedInt CachingImporter::doMeshCount() const { return _in->meshCount(); }
+UnsignedInt CachingImporter::doMeshLevelCount(const UnsignedInt id) { return _in->meshLevelCount(id); }
+Containers::Optional<MeshData> CachingImporter::doMesh(const UnsignedInt id, const UnsignedInt level) { return _in->mesh(id, level); }
+
+UnsignedInt CachingImporter::doMaterialCount() const { return _in->materialCount(); }
+Containers::Optional<MaterialData> CachingImporter::doMaterial(const UnsignedInt id) { return _in->material(id); }
+
+UnsignedInt CachingImporter::doTextureCount() const {
+    return _cache ? UnsignedInt(_cache->textures.size()) : _in->textureCount();
+}
+
+Containers::Optional<TextureData> CachingImporter::doTexture(const UnsignedInt id) {
+    if(!_cache) return _in->texture(id);
+
+    const CacheTexture& texture = _cache->textures[id];
+    return TextureData{TextureType(texture.type),
+        SamplerFilter(texture.minificationFilter),
+        SamplerFilter(texture.magnificationFilter),
+        SamplerMipmap(texture.mipmapFilter),
+        {SamplerWrapping(texture.wrapping[0]),
+         SamplerWrapping(texture.wrapping[1]),
+         SamplerWrapping(texture.wrapping[2])},
+        texture.image};
+}
+
+UnsignedInt CachingImporter::doImage1DCount() const { return _in->image1DCount(); }
+UnsignedInt CachingImporter::doImage1DLevelCount(const UnsignedInt id) { return _in->image1DLevelCount(id); }
+Containers::Optional<ImageData1D> CachingImporter::doImage1D(const UnsignedInt id, const UnsignedInt level) { return _in->image1D(id, level); }
+
+UnsignedInt CachingImporter::doImage2DCount() const { return _in->image2DCount(); }
+UnsignedInt CachingImporter::doImage2DLevelCount(const UnsignedInt id) { return _in->image2DLevelCount(id); }
+Containers::Optional<ImageData2D> CachingImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) { return _in->image2D(id, level); }
+
+UnsignedInt CachingImporter::doImage3DCount() const { return _in->image3DCount(); }
+UnsignedInt CachingImporter::doImage3DLevelCount(const UnsignedInt id) { return _in->image3DLevelCount(id); }
+Containers::Optional<ImageData3D> CachingImporter::doImage3D(const UnsignedInt id, const UnsignedInt level) { return _in->image3D(id, level); }
+
+}}
+
+CORRADE_PLUGIN_REGISTER(CachingImporter, Magnum::Trade::CachingImporter,
+    MAGNUM_TRADE_ABSTRACTIMPORTER_PLUGIN_INTERFACE)
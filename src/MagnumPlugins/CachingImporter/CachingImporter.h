@@ -0,0 +1,222 @@
+#ifndef Magnum_Trade_CachingImporter_h
+#define Magnum_Trade_CachingImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::CachingImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/CachingImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_CACHINGIMPORTER_BUILD_STATIC
+    #ifdef CachingImporter_EXPORTS
+        #define MAGNUM_CACHINGIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_CACHINGIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_CACHINGIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_CACHINGIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_CACHINGIMPORTER_EXPORT
+#define MAGNUM_CACHINGIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Caching importer plugin
+@m_since_latest
+
+Caches meshes, scenes, materials, textures and 1D, 2D and 3D images imported
+by another importer plugin in an on-disk cache directory. On subsequent
+imports of the same file with the same options the data are served directly
+from the memory-mapped cache, without invoking the original importer at all.
+
+@section Trade-CachingImporter-usage Usage
+
+@m_class{m-note m-success}
+
+@par
+    This class is a plugin that's meant to be dynamically loaded and used
+    through the base @ref AbstractImporter interface. See its documentation for
+    introduction and usage examples.
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_CACHINGIMPORTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "CachingImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_CACHINGIMPORTER ON CACHE BOOL "" FORCE)
+set(MAGNUM_WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugins get built implicitly
+add_dependencies(your-app Magnum::CachingImporter Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `CachingImporter` component of the `Magnum`
+package and link to the `Magnum::CachingImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED CachingImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::CachingImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-CachingImporter-behavior Behavior and limitations
+
+The @ref configuration() option @cb{.ini} cacheDirectory @ce has to be set
+before opening a file. On @ref openFile(), the file contents are hashed with
+SHA-1 together with the @cb{.ini} plugin @ce name and all values in the
+@cb{.ini} options @ce group, and the hash is used as a filename in the cache
+directory.
+
+If such file doesn't exist yet, the @cb{.ini} plugin @ce is loaded, flags set
+via @ref setFlags() and the @cb{.ini} options @ce are propagated to it, and the
+file is opened with it. All scenes, meshes, materials and images are imported,
+stored using @ref serializeBlob() into a new cache file and the importer is
+closed again. The @ref defaultScene() and all @ref TextureData are stored in
+a small header at the beginning of the cache file.
+
+The cache file is then memory-mapped and the blobs in it opened with the
+@ref MagnumImporter plugin, so importing the data from it is just a matter of
+creating a few views on the memory-mapped file. The imported data
+thus have @ref DataFlag::ExternallyOwned set, are immutable and stay valid only
+until the importer is closed or destroyed. If the cache file is invalid, it's
+treated as a cache miss and overwritten.
+
+Only the data supported by @ref serializeBlob() can be cached, which is
+scenes, meshes, materials and images with a single level each, together with
+textures and the default scene. If the file contains animations, lights,
+cameras, skins or multiple levels of any mesh or image, a warning is printed,
+nothing is written to the cache and the original importer is used directly
+instead, exposing all its data. The same happens if any of the data fail to
+import or can't be serialized, for example because they contain pointer scene
+fields, or if the cache file can't be written. Data names and importer state
+are not cached and are thus always empty.
+
+The cache directory is never cleaned up by the plugin. The cache files are
+first written under a temporary name unique to given process and thread and
+then moved into place, so concurrent instances never write to the same file
+and a partially written file is never picked up by another instance. If
+writing fails, the temporary file is removed again.
+
+Besides delegating the flags, the @ref CachingImporter itself recognizes
+@ref ImporterFlag::Verbose, printing info about cache hits and misses when the
+flag is enabled. @ref ImporterFlag::Quiet is recognized as well and causes all
+warnings to be suppressed.
+
+@section Trade-CachingImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/CachingImporter/CachingImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
+*/
+class MAGNUM_CACHINGIMPORTER_EXPORT CachingImporter: public AbstractImporter {
+    public:
+        /** @brief Plugin manager constructor */
+        explicit CachingImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~CachingImporter();
+
+    private:
+        MAGNUM_CACHINGIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
+        MAGNUM_CACHINGIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL Int doDefaultScene() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doSceneCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<SceneData> doScene(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doAnimationCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<AnimationData> doAnimation(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doLightCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<LightData> doLight(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doCameraCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<CameraData> doCamera(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doSkin2DCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<SkinData2D> doSkin2D(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doSkin3DCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<SkinData3D> doSkin3D(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doMeshLevelCount(UnsignedInt id) override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doMaterialCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doTextureCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<TextureData> doTexture(UnsignedInt id) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage1DCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage1DLevelCount(UnsignedInt id) override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<ImageData1D> doImage1D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
+        MAGNUM_CACHINGIMPORTER_LOCAL UnsignedInt doImage3DLevelCount(UnsignedInt id) override;
+        MAGNUM_CACHINGIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
+
+        struct Cache;
+
+        Containers::Pointer<AbstractImporter> _in;
+        /* Null if the data are served by the original importer directly */
+        Containers::Pointer<Cache> _cache;
+};
+
+}}
+
+#endif
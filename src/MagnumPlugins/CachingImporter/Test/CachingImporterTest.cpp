@@ -0,0 +1,415 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "Magnum/Trade/TextureData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct CachingImporterTest: TestSuite::Tester {
+    explicit CachingImporterTest();
+
+    void noCacheDirectory();
+    void fileNotFound();
+
+    void missThenHit();
+    void differentOptions();
+    void invalidCacheFile();
+    void defaultSceneTextures();
+    void uncacheable();
+    void writeFailed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+CachingImporterTest::CachingImporterTest() {
+    addTests({&CachingImporterTest::noCacheDirectory,
+              &CachingImporterTest::fileNotFound,
+
+              &CachingImporterTest::missThenHit,
+              &CachingImporterTest::differentOptions,
+              &CachingImporterTest::invalidCacheFile,
+              &CachingImporterTest::defaultSceneTextures,
+              &CachingImporterTest::uncacheable,
+              &CachingImporterTest::writeFailed});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef CACHINGIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(CACHINGIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef CACHINGTESTIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(CACHINGTESTIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+/* Returns an empty per-test cache directory. Removes also empty
+   subdirectories, which writeFailed() creates. */
+Containers::String cacheDirectory(const Containers::StringView name) {
+    const Containers::String directory = Utility::Path::join({CACHINGIMPORTER_TEST_OUTPUT_DIR, "cache", name});
+    if(Utility::Path::exists(directory)) {
+        const Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDotAndDotDot);
+        CORRADE_INTERNAL_ASSERT(files);
+        for(const Containers::String& file: *files)
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::remove(Utility::Path::join(directory, file)));
+    }
+    return directory;
+}
+
+/* Returns all files in given cache directory */
+Containers::Array<Containers::String> cacheFiles(const Containers::StringView directory) {
+    Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SortAscending);
+    CORRADE_INTERNAL_ASSERT(files);
+    return *Utility::move(files);
+}
+
+void CachingImporterTest::noCacheDirectory() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile(Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj")));
+    CORRADE_COMPARE(out.str(), "Trade::CachingImporter::openFile(): the cacheDirectory option is not set\n");
+}
+
+void CachingImporterTest::fileNotFound() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", cacheDirectory("fileNotFound"));
+
+    Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "nonexistent.obj");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile(filename));
+    /* There's an error from Path::read() before */
+    CORRADE_COMPARE_AS(out.str(),
+        Utility::formatString("\nTrade::CachingImporter::openFile(): cannot open file {}\n", filename),
+        TestSuite::Compare::StringHasSuffix);
+}
+
+void CachingImporterTest::missThenHit() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("missThenHit");
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "ObjImporter");
+    importer->setFlags(ImporterFlag::Verbose);
+
+    for(const char* expected: {
+        "Trade::CachingImporter::openFile(): cache miss for {}, importing with ObjImporter\n",
+        "Trade::CachingImporter::openFile(): cache hit for {}\n"
+    }) {
+        CORRADE_ITERATION(expected);
+
+        std::ostringstream out;
+        {
+            Debug redirectOutput{&out};
+            CORRADE_VERIFY(importer->openFile(filename));
+        }
+        CORRADE_COMPARE(out.str(), Utility::formatString(expected, filename));
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+
+        /* In both cases the data are coming from the cache file */
+        CORRADE_COMPARE(importer->meshCount(), 1);
+        CORRADE_COMPARE(importer->meshLevelCount(0), 1);
+        CORRADE_COMPARE(importer->defaultScene(), -1);
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE_AS(mesh->indicesAsArray(), Containers::arrayView<UnsignedInt>({
+            0, 1, 2, 3, 1, 0
+        }), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(mesh->positions3DAsArray(), Containers::arrayView<Vector3>({
+            {0.5f, 2.0f, 3.0f},
+            {0.0f, 1.5f, 1.0f},
+            {2.0f, 3.0f, 5.0f},
+            {2.5f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+
+        importer->close();
+    }
+}
+
+void CachingImporterTest::differentOptions() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("differentOptions");
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "ObjImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+
+    /* An option that the plugin doesn't know about still makes it a different
+       cache entry */
+    importer->configuration().group("options")->setValue("unknownOption", 3);
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), "Trade::CachingImporter::openFile(): option unknownOption not recognized by ObjImporter\n");
+    CORRADE_COMPARE(cacheFiles(directory).size(), 2);
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    /* Same options as before is a cache hit */
+    importer->close();
+    importer->setFlags(ImporterFlag::Verbose);
+    out.str({});
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::CachingImporter::openFile(): cache hit for {}\n", filename));
+    CORRADE_COMPARE(cacheFiles(directory).size(), 2);
+}
+
+void CachingImporterTest::invalidCacheFile() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("invalidCacheFile");
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "ObjImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+    importer->close();
+
+    /* Corrupt the cache file */
+    Containers::Array<Containers::String> files = cacheFiles(directory);
+    CORRADE_COMPARE(files.size(), 1);
+    const Containers::String cacheFilename = Utility::Path::join(directory, files[0]);
+    CORRADE_VERIFY(Utility::Path::write(cacheFilename, Containers::arrayView("this is not a blob")));
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::CachingImporter::openFile(): invalid cache file {}, overwriting\n", cacheFilename));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_VERIFY(importer->mesh(0));
+    CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+}
+
+void CachingImporterTest::defaultSceneTextures() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("CachingTestImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("CachingTestImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("defaultSceneTextures");
+    /* The test importer doesn't care about the contents */
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "CachingTestImporter");
+    importer->setFlags(ImporterFlag::Verbose);
+
+    for(const char* expected: {
+        "Trade::CachingImporter::openFile(): cache miss for {}, importing with CachingTestImporter\n",
+        "Trade::CachingImporter::openFile(): cache hit for {}\n"
+    }) {
+        CORRADE_ITERATION(expected);
+
+        std::ostringstream out;
+        {
+            Debug redirectOutput{&out};
+            CORRADE_VERIFY(importer->openFile(filename));
+        }
+        CORRADE_COMPARE(out.str(), Utility::formatString(expected, filename));
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+
+        CORRADE_COMPARE(importer->sceneCount(), 2);
+        CORRADE_COMPARE(importer->defaultScene(), 1);
+        Containers::Optional<SceneData> scene = importer->scene(1);
+        CORRADE_VERIFY(scene);
+        CORRADE_COMPARE(scene->mappingBound(), 2);
+        CORRADE_COMPARE_AS(scene->parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+            {0, -1},
+            {1, 0}
+        })), TestSuite::Compare::Container);
+
+        CORRADE_COMPARE(importer->textureCount(), 2);
+        Containers::Optional<TextureData> texture0 = importer->texture(0);
+        CORRADE_VERIFY(texture0);
+        CORRADE_COMPARE(texture0->type(), TextureType::Texture2D);
+        CORRADE_COMPARE(texture0->minificationFilter(), SamplerFilter::Nearest);
+        CORRADE_COMPARE(texture0->magnificationFilter(), SamplerFilter::Linear);
+        CORRADE_COMPARE(texture0->mipmapFilter(), SamplerMipmap::Base);
+        CORRADE_COMPARE(texture0->wrapping(), (Math::Vector3<SamplerWrapping>{SamplerWrapping::Repeat, SamplerWrapping::ClampToEdge, SamplerWrapping::MirroredRepeat}));
+        CORRADE_COMPARE(texture0->image(), 0);
+
+        Containers::Optional<TextureData> texture1 = importer->texture(1);
+        CORRADE_VERIFY(texture1);
+        CORRADE_COMPARE(texture1->type(), TextureType::CubeMap);
+        CORRADE_COMPARE(texture1->minificationFilter(), SamplerFilter::Linear);
+        CORRADE_COMPARE(texture1->magnificationFilter(), SamplerFilter::Nearest);
+        CORRADE_COMPARE(texture1->mipmapFilter(), SamplerMipmap::Linear);
+        CORRADE_COMPARE(texture1->wrapping(), Math::Vector3<SamplerWrapping>{SamplerWrapping::ClampToBorder});
+        CORRADE_COMPARE(texture1->image(), 5);
+
+        importer->close();
+    }
+}
+
+void CachingImporterTest::uncacheable() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("CachingTestImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("CachingTestImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("uncacheable");
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "CachingTestImporter");
+    importer->configuration().group("options")->setValue("animationCount", 1);
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), "Trade::CachingImporter::openFile(): can't cache animations, using CachingTestImporter directly\n");
+
+    /* Nothing got written, the data come from the original importer */
+    CORRADE_VERIFY(!Utility::Path::exists(directory) || cacheFiles(directory).isEmpty());
+    CORRADE_COMPARE(importer->animationCount(), 1);
+    CORRADE_COMPARE(importer->defaultScene(), 1);
+    CORRADE_COMPARE(importer->textureCount(), 2);
+    Containers::Optional<SceneData> scene = importer->scene(1);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->dataFlags(), DataFlags{});
+
+    /* A quiet importer doesn't print anything */
+    importer->close();
+    importer->setFlags(ImporterFlag::Quiet);
+    out.str({});
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), "");
+    CORRADE_COMPARE(importer->animationCount(), 1);
+}
+
+void CachingImporterTest::writeFailed() {
+    if(!(_manager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test");
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    const Containers::String directory = cacheDirectory("writeFailed");
+    const Containers::String filename = Utility::Path::join(CACHINGIMPORTER_TEST_DIR, "mesh.obj");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CachingImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("plugin", "ObjImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+    importer->close();
+
+    /* Replace the cache file with a directory of the same name, so writing
+       the temporary file succeeds but moving it in place doesn't */
+    Containers::Array<Containers::String> files = cacheFiles(directory);
+    CORRADE_COMPARE(files.size(), 1);
+    const Containers::String cacheFilename = Utility::Path::join(directory, files[0]);
+    CORRADE_VERIFY(Utility::Path::remove(cacheFilename));
+    CORRADE_VERIFY(Utility::Path::make(cacheFilename));
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        /* Utility::Path prints its own errors, not interesting here */
+        Error redirectError{nullptr};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::CachingImporter::openFile(): invalid cache file {0}, overwriting\n"
+        "Trade::CachingImporter::openFile(): can't write {0}, using ObjImporter directly\n", cacheFilename));
+
+    /* The temporary file got removed again and the data come from the
+       original importer */
+    CORRADE_COMPARE(cacheFiles(directory).size(), 0);
+    CORRADE_VERIFY(Utility::Path::exists(cacheFilename));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexCount(), 4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::CachingImporterTest)
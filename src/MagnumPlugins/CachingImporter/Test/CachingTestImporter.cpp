@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/AbstractManager.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/SceneData.h"
+#include "Magnum/Trade/TextureData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Importer used by CachingImporterTest for data that no importer in this
+   repository produces. Accepts any file and exposes two scenes, the second
+   being the default, two textures and as many animations as set in the
+   animationCount option. */
+class CachingTestImporter: public AbstractImporter {
+    public:
+        explicit CachingTestImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+    private:
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+
+        bool doIsOpened() const override { return _opened; }
+
+        void doOpenData(Containers::Array<char>&&, DataFlags) override {
+            _opened = true;
+        }
+
+        void doClose() override { _opened = false; }
+
+        Int doDefaultScene() const override { return 1; }
+
+        UnsignedInt doSceneCount() const override { return 2; }
+
+        Containers::Optional<SceneData> doScene(const UnsignedInt id) override {
+            /* Scene 0 has a single root object, scene 1 two */
+            struct Data {
+                UnsignedInt mapping[2];
+                Int parent[2];
+            };
+            static const Data data[]{
+                {{0, 0}, {-1, -1}},
+                {{0, 1}, {-1, 0}}
+            };
+            const Data& scene = data[id];
+            return SceneData{SceneMappingType::UnsignedInt, id + 1, DataFlags{}, Containers::arrayView(&scene, 1), {
+                SceneFieldData{SceneField::Parent,
+                    Containers::arrayView(scene.mapping).prefix(id + 1),
+                    Containers::arrayView(scene.parent).prefix(id + 1)}
+            }};
+        }
+
+        UnsignedInt doAnimationCount() const override {
+            return configuration().value<UnsignedInt>("animationCount");
+        }
+
+        UnsignedInt doTextureCount() const override { return 2; }
+
+        Containers::Optional<TextureData> doTexture(const UnsignedInt id) override {
+            if(id == 0) return TextureData{TextureType::Texture2D,
+                SamplerFilter::Nearest, SamplerFilter::Linear,
+                SamplerMipmap::Base,
+                {SamplerWrapping::Repeat, SamplerWrapping::ClampToEdge, SamplerWrapping::MirroredRepeat},
+                0};
+            return TextureData{TextureType::CubeMap,
+                SamplerFilter::Linear, SamplerFilter::Nearest,
+                SamplerMipmap::Linear,
+                SamplerWrapping::ClampToBorder,
+                5};
+        }
+
+        bool _opened = false;
+};
+
+}}}}
+
+CORRADE_PLUGIN_REGISTER(CachingTestImporter, Magnum::Trade::Test::CachingTestImporter,
+    MAGNUM_TRADE_ABSTRACTIMPORTER_PLUGIN_INTERFACE)
@@ -0,0 +1,404 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CachingConverter.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h> /* for PluginMetadata::name() */
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "MagnumPlugins/Implementation/propagateConfiguration.h"
+#include "MagnumPlugins/Implementation/temporaryFilename.h"
+
+namespace Magnum { namespace ShaderTools {
+
+using namespace Containers::Literals;
+
+struct CachingConverter::State {
+    Format inputFormat, outputFormat;
+    Containers::String inputVersion, outputVersion;
+
+    Containers::Array<Containers::Pair<Containers::String, Containers::String>> definitions;
+    Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>> definitionViews;
+
+    Containers::String debugInfoLevel, optimizationLevel;
+};
+
+CachingConverter::CachingConverter(PluginManager::Manager<AbstractConverter>& manager): AbstractConverter{manager}, _state{InPlaceInit} {}
+
+CachingConverter::CachingConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractConverter{manager, plugin}, _state{InPlaceInit} {}
+
+CachingConverter::~CachingConverter() = default;
+
+ConverterFeatures CachingConverter::doFeatures() const {
+    return ConverterFeature::ValidateFile|ConverterFeature::ValidateData|ConverterFeature::ConvertFile|ConverterFeature::ConvertData|ConverterFeature::Preprocess|ConverterFeature::DebugInfo|ConverterFeature::Optimize;
+}
+
+void CachingConverter::doSetInputFormat(const Format format, const Containers::StringView version) {
+    _state->inputFormat = format;
+    _state->inputVersion = Containers::String::nullTerminatedGlobalView(version);
+}
+
+void CachingConverter::doSetOutputFormat(Format format, Containers::StringView version) {
+    _state->outputFormat = format;
+    _state->outputVersion = Containers::String::nullTerminatedGlobalView(version);
+}
+
+void CachingConverter::doSetDefinitions(const Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) {
+    /* We have to make a local copy, unfortunately, and then a view on that
+       local copy */
+    _state->definitions = Containers::Array<Containers::Pair<Containers::String, Containers::String>>{definitions.size()};
+    _state->definitionViews = Containers::Array<Containers::Pair<Containers::StringView, Containers::StringView>>{definitions.size()};
+    for(std::size_t i = 0; i != definitions.size(); ++i) {
+        /* Avoid a copy if the input is a global string literal */
+        _state->definitions[i] = {
+            Containers::String::nullTerminatedGlobalView(definitions[i].first()),
+            Containers::String::nullTerminatedGlobalView(definitions[i].second())
+        };
+        /* Preserve the distinction between empty defines ("") and undefines
+           (nullptr or default constructor) */
+        _state->definitionViews[i] = {
+            _state->definitions[i].first(),
+            definitions[i].second().data() ?
+                Containers::StringView{_state->definitions[i].second()} :
+                Containers::StringView{}
+        };
+    }
+}
+
+void CachingConverter::doSetDebugInfoLevel(const Containers::StringView level) {
+    _state->debugInfoLevel = Containers::String::nullTerminatedGlobalView(level);
+}
+
+void CachingConverter::doSetOptimizationLevel(const Containers::StringView level) {
+    _state->optimizationLevel = Containers::String::nullTerminatedGlobalView(level);
+}
+
+namespace {
+
+/* Version of the cache layout, bump when the file format or the way the key
+   is put together changes to invalidate all existing cache entries */
+constexpr Containers::StringView CacheVersion = "CachingShaderConverter1"_s;
+
+/* Each string is terminated with a null byte so e.g. a value "ab" with
+   subsequent "c" hashes differently from "a" and "bc" */
+void appendKey(Containers::Array<char>& out, const Containers::StringView string) {
+    arrayAppend(out, Containers::arrayView(string.data(), string.size()));
+    arrayAppend(out, '\0');
+}
+
+void appendKey(Containers::Array<char>& out, const UnsignedInt value) {
+    arrayAppend(out, Containers::arrayCast<const char>(Containers::arrayView(&value, 1)));
+}
+
+void appendKey(Containers::Array<char>& out, const Utility::ConfigurationGroup& group) {
+    for(Containers::Pair<Containers::StringView, Containers::StringView> value: group.values()) {
+        appendKey(out, value.first());
+        appendKey(out, value.second());
+    }
+    for(Containers::Pair<Containers::StringView, Containers::Reference<const Utility::ConfigurationGroup>> subgroup: group.groups()) {
+        appendKey(out, "["_s);
+        appendKey(out, subgroup.first());
+        appendKey(out, subgroup.second());
+        appendKey(out, "]"_s);
+    }
+}
+
+}
+
+Containers::String CachingConverter::cacheFilename(const char* const prefix, const Containers::StringView operation, const Stage stage, const Containers::ArrayView<const char> data, const Containers::StringView from, const Containers::StringView to) const {
+    const Containers::String cacheDirectory = configuration().value("cacheDirectory");
+    if(!cacheDirectory) {
+        Error{} << prefix << "the cacheDirectory option is not set";
+        return {};
+    }
+
+    /* Hash the source together with everything that affects the output.
+       Verbose only affects what's printed, not the result, so it's not a part
+       of the key. */
+    Containers::Array<char> key;
+    appendKey(key, CacheVersion);
+    appendKey(key, operation);
+    appendKey(key, configuration().value("plugin"));
+    appendKey(key, configuration().value("version"));
+    appendKey(key, *configuration().group("options"));
+    appendKey(key, UnsignedInt(stage));
+    appendKey(key, UnsignedInt(flags() & ~ConverterFlag::Verbose));
+    appendKey(key, UnsignedInt(_state->inputFormat));
+    appendKey(key, _state->inputVersion);
+    appendKey(key, UnsignedInt(_state->outputFormat));
+    appendKey(key, _state->outputVersion);
+    appendKey(key, UnsignedInt(_state->definitionViews.size()));
+    for(const Containers::Pair<Containers::StringView, Containers::StringView>& definition: _state->definitionViews) {
+        appendKey(key, definition.first());
+        /* Distinguish between an empty define and an undefine */
+        appendKey(key, UnsignedInt(definition.second().data() ? 1 : 0));
+        appendKey(key, definition.second());
+    }
+    appendKey(key, _state->debugInfoLevel);
+    appendKey(key, _state->optimizationLevel);
+    /* The plugin may detect the format from the file extensions, so the file
+       names are a part of the key as well. The directory isn't, to allow
+       the same file to be found at a different location. */
+    appendKey(key, Utility::Path::split(from).second());
+    appendKey(key, Utility::Path::split(to).second());
+
+    Utility::Sha1 sha1;
+    sha1 << data << key;
+    const Utility::Sha1::Digest digest = sha1.digest();
+
+    constexpr const char Hex[] = "0123456789abcdef";
+    Containers::String hash{NoInit, Utility::Sha1::DigestSize*2};
+    for(std::size_t i = 0; i != Utility::Sha1::DigestSize; ++i) {
+        const UnsignedByte byte = digest.byteArray()[i];
+        hash[i*2 + 0] = Hex[byte >> 4];
+        hash[i*2 + 1] = Hex[byte & 0x0f];
+    }
+
+    return Utility::Path::join(cacheDirectory, hash + "."_s + operation);
+}
+
+Containers::Pointer<AbstractConverter> CachingConverter::instantiate(const char* const prefix, const Containers::StringView filename, const ConverterFeatures features) {
+    CORRADE_INTERNAL_ASSERT(manager());
+    PluginManager::Manager<AbstractConverter>& manager = *static_cast<PluginManager::Manager<AbstractConverter>*>(this->manager());
+
+    /* Try to load the plugin */
+    const Containers::String plugin = configuration().value("plugin");
+    if(!(manager.load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << prefix << "cannot load the" << plugin << "plugin";
+        return {};
+    }
+
+    const PluginManager::PluginMetadata* const metadata = manager.metadata(plugin);
+    CORRADE_INTERNAL_ASSERT(metadata);
+    if(flags() & ConverterFlag::Verbose) {
+        Debug d;
+        d << prefix << "cache miss";
+        if(!filename.isEmpty())
+            d << "for" << filename;
+        d << Debug::nospace << ", using" << plugin;
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Instantiate the plugin */
+    Containers::Pointer<AbstractConverter> converter = manager.instantiate(plugin);
+
+    /* Check that it can actually do the operation */
+    if(!(converter->features() >= features)) {
+        Error{} << prefix << metadata->name() << "does not support" << (features & ConverterFeature::ValidateFile ? "validation" : "conversion");
+        return {};
+    }
+
+    /* Check that it can preprocess, in case we were asked to preprocess */
+    if((!_state->definitionViews.isEmpty() || (flags() & ConverterFlag::PreprocessOnly)) && !(converter->features() & ConverterFeature::Preprocess)) {
+        Error{} << prefix << metadata->name() << "does not support preprocessing";
+        return {};
+    }
+
+    /* Check that it can output debug info, in case we were asked to */
+    if(!_state->debugInfoLevel.isEmpty() && !(converter->features() & ConverterFeature::DebugInfo)) {
+        Error{} << prefix << metadata->name() << "does not support controlling debug info output";
+        return {};
+    }
+
+    /* Check that it can optimize, in case we were asked to */
+    if(!_state->optimizationLevel.isEmpty() && !(converter->features() & ConverterFeature::Optimize)) {
+        Error{} << prefix << metadata->name() << "does not support optimization";
+        return {};
+    }
+
+    /* Propagate input/output version and flags */
+    converter->setFlags(flags());
+    converter->setInputFormat(_state->inputFormat, _state->inputVersion);
+    converter->setOutputFormat(_state->outputFormat, _state->outputVersion);
+
+    /* Propagate definitions and debug info, if any */
+    if(!_state->definitionViews.isEmpty())
+        converter->setDefinitions(_state->definitionViews);
+    if(!_state->debugInfoLevel.isEmpty())
+        converter->setDebugInfoLevel(_state->debugInfoLevel);
+    if(!_state->optimizationLevel.isEmpty())
+        converter->setOptimizationLevel(_state->optimizationLevel);
+
+    /* Propagate configuration */
+    Magnum::Implementation::propagateConfiguration(prefix, {}, metadata->name(), *configuration().group("options"), converter->configuration(), !(flags() & ConverterFlag::Quiet));
+
+    return converter;
+}
+
+void CachingConverter::writeCache(const char* const prefix, const Containers::StringView filename, const Containers::ArrayView<const char> data) const {
+    /* Each writer gets its own temporary file, so two instances converting
+       the same source at the same time can't interleave their output. The
+       final move replaces the entry as a whole wherever the rename is atomic,
+       which is the case for local filesystems. */
+    const Containers::String temporaryFilename = Magnum::Implementation::temporaryFilename(filename);
+    if(!Utility::Path::make(Utility::Path::split(filename).first()) ||
+       !Utility::Path::write(temporaryFilename, data) ||
+       !Utility::Path::move(temporaryFilename, filename)) {
+        /* Don't leave the temporary file behind if the write or move failed */
+        if(Utility::Path::exists(temporaryFilename))
+            Utility::Path::remove(temporaryFilename);
+        if(!(flags() & ConverterFlag::Quiet))
+            Warning{} << prefix << "can't write" << filename;
+    }
+}
+
+Containers::Pair<bool, Containers::String> CachingConverter::validate(const char* const prefix, const Stage stage, const Containers::ArrayView<const char> data, const Containers::StringView filename) {
+    const Containers::String cacheFilename = this->cacheFilename(prefix, "validation"_s, stage, data, filename, {});
+    if(!cacheFilename) return {};
+
+    /* Cache hit. The first byte is the validation result, the rest is the
+       message. */
+    if(Utility::Path::exists(cacheFilename)) {
+        const Containers::Optional<Containers::String> cached = Utility::Path::readString(cacheFilename);
+        if(cached && !cached->isEmpty() && ((*cached)[0] == '0' || (*cached)[0] == '1')) {
+            if(flags() & ConverterFlag::Verbose) {
+                Debug d;
+                d << prefix << "cache hit";
+                if(!filename.isEmpty())
+                    d << "for" << filename;
+            }
+            return {(*cached)[0] == '1', cached->exceptPrefix(1)};
+        }
+
+        if(!(flags() & ConverterFlag::Quiet))
+            Warning{} << prefix << "invalid cache file" << cacheFilename << Debug::nospace << ", overwriting";
+    }
+
+    /* Cache miss, delegate to the plugin */
+    Containers::Pointer<AbstractConverter> converter = instantiate(prefix, filename, filename.isEmpty() ? ConverterFeature::ValidateData : ConverterFeature::ValidateFile);
+    if(!converter) return {};
+
+    /* Error output should be printed by the plugin itself */
+    Containers::Pair<bool, Containers::String> out = filename.isEmpty() ?
+        converter->validateData(stage, data) :
+        converter->validateFile(stage, filename);
+
+    /* A failure without any message is what plugins return on errors
+       unrelated to the validation itself, such as a file that can't be
+       opened, don't cache those */
+    if(out.first() || !out.second().isEmpty())
+        writeCache(prefix, cacheFilename, (out.first() ? "1"_s : "0"_s) + out.second());
+
+    return out;
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::convert(const char* const prefix, const Stage stage, const Containers::ArrayView<const char> data, const Containers::StringView from, const Containers::StringView to) {
+    const Containers::String cacheFilename = this->cacheFilename(prefix, "conversion"_s, stage, data, from, to);
+    if(!cacheFilename) return {};
+
+    /* Cache hit */
+    if(Utility::Path::exists(cacheFilename)) {
+        if(Containers::Optional<Containers::Array<char>> out = Utility::Path::read(cacheFilename)) {
+            if(flags() & ConverterFlag::Verbose) {
+                Debug d;
+                d << prefix << "cache hit";
+                if(!from.isEmpty())
+                    d << "for" << from;
+            }
+
+            if(!to.isEmpty() && !Utility::Path::write(to, *out)) {
+                Error{} << prefix << "cannot write to file" << to;
+                return {};
+            }
+
+            return out;
+        }
+
+        if(!(flags() & ConverterFlag::Quiet))
+            Warning{} << prefix << "invalid cache file" << cacheFilename << Debug::nospace << ", overwriting";
+    }
+
+    /* Cache miss, delegate to the plugin */
+    Containers::Pointer<AbstractConverter> converter = instantiate(prefix, from, from.isEmpty() || to.isEmpty() ? ConverterFeature::ConvertData : ConverterFeature::ConvertFile);
+    if(!converter) return {};
+
+    /* Error output should be printed by the plugin itself. For a file output
+       read the file back to put it into the cache. */
+    Containers::Optional<Containers::Array<char>> out;
+    if(from.isEmpty())
+        out = converter->convertDataToData(stage, data);
+    else if(to.isEmpty())
+        out = converter->convertFileToData(stage, from);
+    else if(converter->convertFileToFile(stage, from, to))
+        out = Utility::Path::read(to);
+    if(!out) return {};
+
+    writeCache(prefix, cacheFilename, *out);
+    return out;
+}
+
+Containers::Pair<bool, Containers::String> CachingConverter::doValidateFile(const Stage stage, const Containers::StringView filename) {
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data) {
+        Error{} << "ShaderTools::CachingConverter::validateFile(): cannot open file" << filename;
+        return {};
+    }
+
+    return validate("ShaderTools::CachingConverter::validateFile():", stage, *data, filename);
+}
+
+Containers::Pair<bool, Containers::String> CachingConverter::doValidateData(const Stage stage, const Containers::ArrayView<const char> data) {
+    return validate("ShaderTools::CachingConverter::validateData():", stage, data, {});
+}
+
+bool CachingConverter::doConvertFileToFile(const Stage stage, const Containers::StringView from, const Containers::StringView to) {
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(from);
+    if(!data) {
+        Error{} << "ShaderTools::CachingConverter::convertFileToFile(): cannot open file" << from;
+        return {};
+    }
+
+    return !!convert("ShaderTools::CachingConverter::convertFileToFile():", stage, *data, from, to);
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doConvertFileToData(const Stage stage, const Containers::StringView filename) {
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data) {
+        Error{} << "ShaderTools::CachingConverter::convertFileToData(): cannot open file" << filename;
+        return {};
+    }
+
+    return convert("ShaderTools::CachingConverter::convertFileToData():", stage, *data, filename, {});
+}
+
+Containers::Optional<Containers::Array<char>> CachingConverter::doConvertDataToData(const Stage stage, const Containers::ArrayView<const char> data) {
+    return convert("ShaderTools::CachingConverter::convertDataToData():", stage, data, {}, {});
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(CachingShaderConverter, Magnum::ShaderTools::CachingConverter,
+    MAGNUM_SHADERTOOLS_ABSTRACTCONVERTER_PLUGIN_INTERFACE)
@@ -0,0 +1,212 @@
+#ifndef Magnum_ShaderTools_CachingConverter_h
+#define Magnum_ShaderTools_CachingConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ShaderTools::CachingConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/ShaderTools/AbstractConverter.h"
+#include "MagnumPlugins/CachingShaderConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_CACHINGSHADERCONVERTER_BUILD_STATIC
+    #ifdef CachingShaderConverter_EXPORTS
+        #define MAGNUM_CACHINGSHADERCONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_CACHINGSHADERCONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_CACHINGSHADERCONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_CACHINGSHADERCONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_CACHINGSHADERCONVERTER_EXPORT
+#define MAGNUM_CACHINGSHADERCONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace ShaderTools {
+
+/**
+@brief Caching shader converter plugin
+@m_since_latest
+
+@m_keywords{CachingShaderConverter}
+
+Caches validation and conversion results produced by another shader converter
+plugin in an on-disk cache directory. On subsequent validation or conversion
+of the same source with the same formats, definitions and options the result
+is served directly from the cache, without loading the original plugin at
+all.
+
+@section ShaderTools-CachingConverter-usage Usage
+
+@m_class{m-note m-success}
+
+@par
+    This class is a plugin that's meant to be dynamically loaded and used
+    through the base @ref AbstractConverter interface. See its documentation
+    for introduction and usage examples.
+
+This plugin depends on the @ref ShaderTools library and is built if
+`MAGNUM_WITH_CACHINGSHADERCONVERTER` is enabled when building Magnum. To use
+as a dynamic plugin, load @cpp "CachingShaderConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_CACHINGSHADERCONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::CachingShaderConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `CachingShaderConverter` component of the `Magnum` package
+and link to the `Magnum::CachingShaderConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED CachingShaderConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::CachingShaderConverter)
+@endcode
+
+See @ref building, @ref cmake and @ref plugins for more information.
+
+@section ShaderTools-CachingConverter-behavior Behavior and limitations
+
+The @ref configuration() option @cb{.ini} cacheDirectory @ce has to be set
+before validating or converting anything. On a call to @ref validateFile() /
+@ref validateData(), @ref convertFileToFile() / @ref convertFileToData() /
+@ref convertDataToData(), the source is hashed with SHA-1 together with the
+@ref Stage, everything set via @ref setInputFormat(), @ref setOutputFormat(),
+@ref setDefinitions(), @ref setDebugInfoLevel(), @ref setOptimizationLevel()
+and @ref setFlags() except for @ref ConverterFlag::Verbose, the
+@cb{.ini} plugin @ce name, the @cb{.ini} version @ce string and all values in
+the @cb{.ini} options @ce group.
+For the file variants the input and output file names without the directory
+are a part of the key as well, as the @cb{.ini} plugin @ce may use them for
+format detection. The hash is then used as a filename in the cache directory.
+
+If such file doesn't exist yet, the @cb{.ini} plugin @ce is loaded, everything
+set via the above functions and the @cb{.ini} options @ce are propagated to it,
+with an error emitted in case the target plugin doesn't support given feature,
+and the operation is executed with it. A successful conversion output is then
+stored in the cache. Validation results are stored both if the validation
+passes and if it fails, together with the validation message, but not when the
+plugin fails without producing any message, as that's usually a sign of an
+unrelated error such as a file that can't be opened.
+
+Only the top-level source is hashed. If the source includes other files, for
+example through @cpp #include @ce directives resolved by the plugin, changes in
+them don't result in a cache miss and the cache directory has to be cleared
+manually. Warnings printed by the plugin during a conversion are printed only
+on a cache miss. Input file callbacks are supported, in which case the file
+goes through @ref validateData() / @ref convertDataToData() and thus the
+@cb{.ini} plugin @ce may need @ref setInputFormat() / @ref setOutputFormat() to
+be set explicitly.
+
+Neither the version of the @cb{.ini} plugin @ce nor of the tools it delegates
+to is a part of the key, so upgrading them keeps serving outputs produced by
+the old version. Change the @cb{.ini} version @ce option, for example to the
+new backend version, to make all such entries a cache miss, or clear the cache
+directory.
+
+The cache directory is never cleaned up by the plugin. Each cache file is
+written to a temporary file with a name specific to given process and thread,
+and then renamed to its final name. Concurrent conversions of the same source
+thus never write into the same file, and as long as the rename is atomic, which
+is the case on local filesystems, an entry is either seen whole or not at all.
+
+Besides delegating the flags, the @ref CachingConverter itself recognizes
+@ref ConverterFlag::Verbose, printing info about cache hits and misses when
+the flag is enabled. @ref ConverterFlag::Quiet is recognized as well and causes
+all warnings to be suppressed.
+
+@section ShaderTools-CachingConverter-configuration Plugin-specific configuration
+
+It's possible to tune various options through @ref configuration(). See below
+for all options and their default values:
+
+@snippet MagnumPlugins/CachingShaderConverter/CachingConverter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
+*/
+class MAGNUM_CACHINGSHADERCONVERTER_EXPORT CachingConverter: public AbstractConverter {
+    public:
+        /** @brief Constructor with access to plugin manager */
+        explicit CachingConverter(PluginManager::Manager<AbstractConverter>& manager);
+
+        /** @brief Plugin manager constructor */
+        explicit CachingConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~CachingConverter();
+
+    private:
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL ConverterFeatures doFeatures() const override;
+
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void doSetInputFormat(Format, Containers::StringView version) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void doSetOutputFormat(Format, Containers::StringView version) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void doSetDefinitions(Containers::ArrayView<const Containers::Pair<Containers::StringView, Containers::StringView>> definitions) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void doSetDebugInfoLevel(Containers::StringView level) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void doSetOptimizationLevel(Containers::StringView level) override;
+
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Pair<bool, Containers::String> doValidateFile(Stage stage, Containers::StringView filename) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Pair<bool, Containers::String> doValidateData(Stage stage, Containers::ArrayView<const char> data) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL bool doConvertFileToFile(Stage stage, Containers::StringView from, Containers::StringView to) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertFileToData(Magnum::ShaderTools::Stage stage, Containers::StringView filename) override;
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertDataToData(Magnum::ShaderTools::Stage stage, Containers::ArrayView<const char> data) override;
+
+        /* Calculates the cache file name, returns an empty string if the
+           cache directory isn't set */
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::String cacheFilename(const char* prefix, Containers::StringView operation, Stage stage, Containers::ArrayView<const char> data, Containers::StringView from, Containers::StringView to) const;
+
+        /* Loads and sets up the delegate plugin, returns nullptr on failure */
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Pointer<AbstractConverter> instantiate(const char* prefix, Containers::StringView filename, ConverterFeatures features);
+
+        /* Writes a cache file, prints a warning on failure */
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL void writeCache(const char* prefix, Containers::StringView filename, Containers::ArrayView<const char> data) const;
+
+        /* Shared implementation of the data and file variants. If filename /
+           from is empty, the data are passed to the delegate directly, if to
+           is empty, the output is returned instead of written to a file. */
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Pair<bool, Containers::String> validate(const char* prefix, Stage stage, Containers::ArrayView<const char> data, Containers::StringView filename);
+        MAGNUM_CACHINGSHADERCONVERTER_LOCAL Containers::Optional<Containers::Array<char>> convert(const char* prefix, Stage stage, Containers::ArrayView<const char> data, Containers::StringView from, Containers::StringView to);
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,353 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/ShaderTools/AbstractConverter.h"
+#include "Magnum/ShaderTools/Stage.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace ShaderTools { namespace Test { namespace {
+
+struct CachingConverterTest: TestSuite::Tester {
+    explicit CachingConverterTest();
+
+    void noCacheDirectory();
+    void pluginLoadFailed();
+
+    void validateDataMissThenHit();
+    void convertFileToFileMissThenHit();
+    void convertDataToDataDifferentDefinitions();
+    void convertDataToDataDifferentVersion();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractConverter> _manager{"nonexistent"};
+};
+
+CachingConverterTest::CachingConverterTest() {
+    addTests({&CachingConverterTest::noCacheDirectory,
+              &CachingConverterTest::pluginLoadFailed,
+
+              &CachingConverterTest::validateDataMissThenHit,
+              &CachingConverterTest::convertFileToFileMissThenHit,
+              &CachingConverterTest::convertDataToDataDifferentDefinitions,
+              &CachingConverterTest::convertDataToDataDifferentVersion});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef CACHINGSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(CACHINGSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(CACHINGSHADERCONVERTER_TEST_OUTPUT_DIR));
+}
+
+/* Returns an empty per-test cache directory */
+Containers::String cacheDirectory(const Containers::StringView name) {
+    const Containers::String directory = Utility::Path::join({CACHINGSHADERCONVERTER_TEST_OUTPUT_DIR, "cache", name});
+    if(Utility::Path::exists(directory)) {
+        const Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories);
+        CORRADE_INTERNAL_ASSERT(files);
+        for(const Containers::String& file: *files)
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::remove(Utility::Path::join(directory, file)));
+    }
+    return directory;
+}
+
+/* Returns all files in given cache directory */
+Containers::Array<Containers::String> cacheFiles(const Containers::StringView directory) {
+    Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SortAscending);
+    CORRADE_INTERNAL_ASSERT(files);
+    return *Utility::move(files);
+}
+
+void CachingConverterTest::noCacheDirectory() {
+    Containers::Pointer<AbstractConverter> converter = _manager.instantiate("CachingShaderConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(converter->validateData(Stage::Fragment, "void main() {}"),
+        Containers::pair(false, Containers::String{}));
+    CORRADE_COMPARE(out.str(), "ShaderTools::CachingConverter::validateData(): the cacheDirectory option is not set\n");
+}
+
+void CachingConverterTest::pluginLoadFailed() {
+    Containers::Pointer<AbstractConverter> converter = _manager.instantiate("CachingShaderConverter");
+    converter->configuration().setValue("cacheDirectory", cacheDirectory("pluginLoadFailed"));
+    converter->configuration().setValue("plugin", "NonexistentShaderConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertDataToData(Stage::Fragment, "void main() {}"));
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::Manager::load(): plugin NonexistentShaderConverter is not static and was not found in nonexistent\n"
+        "ShaderTools::CachingConverter::convertDataToData(): cannot load the NonexistentShaderConverter plugin\n");
+    #else
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::Manager::load(): plugin NonexistentShaderConverter was not found\n"
+        "ShaderTools::CachingConverter::convertDataToData(): cannot load the NonexistentShaderConverter plugin\n");
+    #endif
+}
+
+void CachingConverterTest::validateDataMissThenHit() {
+    PluginManager::Manager<AbstractConverter> manager{MAGNUM_PLUGINS_SHADERCONVERTER_INSTALL_DIR};
+    #ifdef CACHINGSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(CACHINGSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    if(manager.load("GlslangShaderConverter") < PluginManager::LoadState::Loaded)
+        CORRADE_SKIP("GlslangShaderConverter plugin can't be loaded.");
+
+    const Containers::String directory = cacheDirectory("validateDataMissThenHit");
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(CACHINGSHADERCONVERTER_TEST_DIR, "file.glsl"));
+    CORRADE_VERIFY(data);
+
+    /* The validation message is stored in the cache as well */
+    const Containers::Pair<bool, Containers::String> expected{true, "WARNING: 0:10: 'reserved__identifier' : identifiers containing consecutive underscores (\"__\") are reserved"};
+
+    /* Cache miss, delegating to the plugin */
+    {
+        Containers::Pointer<AbstractConverter> converter = manager.instantiate("CachingShaderConverter");
+        converter->configuration().setValue("cacheDirectory", directory);
+        converter->configuration().setValue("plugin", "GlslangShaderConverter");
+        converter->setFlags(ConverterFlag::Verbose);
+
+        std::ostringstream out;
+        {
+            Debug redirectOutput{&out};
+            CORRADE_COMPARE(converter->validateData(Stage::Fragment, *data), expected);
+        }
+        CORRADE_COMPARE_AS(out.str(),
+            "ShaderTools::CachingConverter::validateData(): cache miss, using GlslangShaderConverter\n",
+            TestSuite::Compare::StringHasPrefix);
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+    }
+
+    /* Cache hit, served even though the plugin can't be loaded at all */
+    {
+        Containers::Pointer<AbstractConverter> converter = _manager.instantiate("CachingShaderConverter");
+        converter->configuration().setValue("cacheDirectory", directory);
+        converter->configuration().setValue("plugin", "GlslangShaderConverter");
+        converter->setFlags(ConverterFlag::Verbose);
+
+        std::ostringstream out;
+        {
+            Debug redirectOutput{&out};
+            CORRADE_COMPARE(converter->validateData(Stage::Fragment, *data), expected);
+        }
+        CORRADE_COMPARE(out.str(), "ShaderTools::CachingConverter::validateData(): cache hit\n");
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+        CORRADE_COMPARE(_manager.loadState("GlslangShaderConverter"), PluginManager::LoadState::NotFound);
+    }
+}
+
+void CachingConverterTest::convertFileToFileMissThenHit() {
+    PluginManager::Manager<AbstractConverter> manager{MAGNUM_PLUGINS_SHADERCONVERTER_INSTALL_DIR};
+    #ifdef CACHINGSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(CACHINGSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    if(manager.load("GlslangShaderConverter") < PluginManager::LoadState::Loaded)
+        CORRADE_SKIP("GlslangShaderConverter plugin can't be loaded.");
+
+    const Containers::String directory = cacheDirectory("convertFileToFileMissThenHit");
+    const Containers::String inputFilename = Utility::Path::join(CACHINGSHADERCONVERTER_TEST_DIR, "file.glsl");
+    const Containers::String outputFilename = Utility::Path::join(CACHINGSHADERCONVERTER_TEST_OUTPUT_DIR, "file.spv");
+    const Containers::String outputFilenameHit = Utility::Path::join(CACHINGSHADERCONVERTER_TEST_OUTPUT_DIR, "hit/file.spv");
+    if(Utility::Path::exists(outputFilename))
+        CORRADE_VERIFY(Utility::Path::remove(outputFilename));
+    if(Utility::Path::exists(outputFilenameHit))
+        CORRADE_VERIFY(Utility::Path::remove(outputFilenameHit));
+    CORRADE_VERIFY(Utility::Path::make(Utility::Path::join(CACHINGSHADERCONVERTER_TEST_OUTPUT_DIR, "hit")));
+
+    /* Cache miss, delegating to the plugin. It prints a warning. */
+    {
+        Containers::Pointer<AbstractConverter> converter = manager.instantiate("CachingShaderConverter");
+        converter->configuration().setValue("cacheDirectory", directory);
+        converter->configuration().setValue("plugin", "GlslangShaderConverter");
+
+        std::ostringstream out;
+        {
+            Warning redirectWarning{&out};
+            CORRADE_VERIFY(converter->convertFileToFile(Stage::Fragment, inputFilename, outputFilename));
+        }
+        CORRADE_VERIFY(Utility::Path::exists(outputFilename));
+        CORRADE_COMPARE(out.str(), Utility::formatString(
+            "ShaderTools::GlslangConverter::convertDataToData(): compilation succeeded with the following message:\n"
+            "WARNING: {}:10: 'reserved__identifier' : identifiers containing consecutive underscores (\"__\") are reserved\n", inputFilename));
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+    }
+
+    /* Cache hit, served even though the plugin can't be loaded at all. The
+       output directory isn't a part of the key, only the filename. */
+    {
+        Containers::Pointer<AbstractConverter> converter = _manager.instantiate("CachingShaderConverter");
+        converter->configuration().setValue("cacheDirectory", directory);
+        converter->configuration().setValue("plugin", "GlslangShaderConverter");
+        converter->setFlags(ConverterFlag::Verbose);
+
+        std::ostringstream out;
+        {
+            Debug redirectOutput{&out};
+            Warning redirectWarning{&out};
+            CORRADE_VERIFY(converter->convertFileToFile(Stage::Fragment, inputFilename, outputFilenameHit));
+        }
+        CORRADE_COMPARE(out.str(), Utility::formatString("ShaderTools::CachingConverter::convertFileToFile(): cache hit for {}\n", inputFilename));
+        CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+        CORRADE_COMPARE_AS(outputFilenameHit, outputFilename, TestSuite::Compare::File);
+    }
+}
+
+void CachingConverterTest::convertDataToDataDifferentDefinitions() {
+    PluginManager::Manager<AbstractConverter> manager{MAGNUM_PLUGINS_SHADERCONVERTER_INSTALL_DIR};
+    #ifdef CACHINGSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(CACHINGSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    if(manager.load("GlslangShaderConverter") < PluginManager::LoadState::Loaded)
+        CORRADE_SKIP("GlslangShaderConverter plugin can't be loaded.");
+
+    const Containers::String directory = cacheDirectory("convertDataToDataDifferentDefinitions");
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(CACHINGSHADERCONVERTER_TEST_DIR, "file.glsl"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractConverter> converter = manager.instantiate("CachingShaderConverter");
+    converter->configuration().setValue("cacheDirectory", directory);
+    converter->configuration().setValue("plugin", "GlslangShaderConverter");
+    converter->setInputFormat(Format::Glsl);
+    converter->setOutputFormat(Format::Spirv);
+
+    /* Silence the warning about reserved identifiers */
+    Warning redirectWarning{nullptr};
+
+    Containers::Optional<Containers::Array<char>> first = converter->convertDataToData(Stage::Fragment, *data);
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+
+    /* A definition makes it a different cache entry, even though it doesn't
+       affect the output in any way */
+    converter->setDefinitions({
+        {"DEFINE", "hahahahah"}
+    });
+    CORRADE_VERIFY(converter->convertDataToData(Stage::Fragment, *data));
+    CORRADE_COMPARE(cacheFiles(directory).size(), 2);
+
+    /* Undefining instead of defining is a different entry as well */
+    converter->setDefinitions({
+        {"DEFINE", nullptr}
+    });
+    CORRADE_VERIFY(converter->convertDataToData(Stage::Fragment, *data));
+    CORRADE_COMPARE(cacheFiles(directory).size(), 3);
+
+    /* Going back to no definitions is a cache hit with the same output */
+    converter->setDefinitions({});
+    converter->setFlags(ConverterFlag::Verbose);
+    std::ostringstream out;
+    Containers::Optional<Containers::Array<char>> second;
+    {
+        Debug redirectOutput{&out};
+        second = converter->convertDataToData(Stage::Fragment, *data);
+    }
+    CORRADE_VERIFY(second);
+    CORRADE_COMPARE(out.str(), "ShaderTools::CachingConverter::convertDataToData(): cache hit\n");
+    CORRADE_COMPARE(cacheFiles(directory).size(), 3);
+    CORRADE_COMPARE_AS(*second, *first, TestSuite::Compare::Container);
+}
+
+void CachingConverterTest::convertDataToDataDifferentVersion() {
+    PluginManager::Manager<AbstractConverter> manager{MAGNUM_PLUGINS_SHADERCONVERTER_INSTALL_DIR};
+    #ifdef CACHINGSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(CACHINGSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    if(manager.load("GlslangShaderConverter") < PluginManager::LoadState::Loaded)
+        CORRADE_SKIP("GlslangShaderConverter plugin can't be loaded.");
+
+    const Containers::String directory = cacheDirectory("convertDataToDataDifferentVersion");
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(CACHINGSHADERCONVERTER_TEST_DIR, "file.glsl"));
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractConverter> converter = manager.instantiate("CachingShaderConverter");
+    converter->configuration().setValue("cacheDirectory", directory);
+    converter->configuration().setValue("plugin", "GlslangShaderConverter");
+    converter->setInputFormat(Format::Glsl);
+    converter->setOutputFormat(Format::Spirv);
+    converter->setFlags(ConverterFlag::Verbose);
+
+    /* Silence the warning about reserved identifiers */
+    Warning redirectWarning{nullptr};
+
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(converter->convertDataToData(Stage::Fragment, *data));
+        CORRADE_COMPARE_AS(out.str(),
+            "ShaderTools::CachingConverter::convertDataToData(): cache miss, using GlslangShaderConverter\n",
+            TestSuite::Compare::StringHasPrefix);
+    }
+    CORRADE_COMPARE(cacheFiles(directory).size(), 1);
+
+    /* Same input with a different version, such as after a backend upgrade,
+       is a cache miss */
+    converter->configuration().setValue("version", "2");
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(converter->convertDataToData(Stage::Fragment, *data));
+        CORRADE_COMPARE_AS(out.str(),
+            "ShaderTools::CachingConverter::convertDataToData(): cache miss, using GlslangShaderConverter\n",
+            TestSuite::Compare::StringHasPrefix);
+    }
+    CORRADE_COMPARE(cacheFiles(directory).size(), 2);
+
+    /* Same version again is a hit */
+    {
+        std::ostringstream out;
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(converter->convertDataToData(Stage::Fragment, *data));
+        CORRADE_COMPARE(out.str(), "ShaderTools::CachingConverter::convertDataToData(): cache hit\n");
+    }
+    CORRADE_COMPARE(cacheFiles(directory).size(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ShaderTools::Test::CachingConverterTest)
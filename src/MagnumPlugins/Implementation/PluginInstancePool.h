@@ -0,0 +1,102 @@
+#ifndef Magnum_Implementation_PluginInstancePool_h
+#define Magnum_Implementation_PluginInstancePool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Move.h>
+
+#include "Magnum/Magnum.h"
+
+/* Used by Any* plugins to keep idle instances of concrete plugins around
+   for reuse across opened / converted files, if the instancePool
+   configuration option is enabled. At most one idle instance is kept per
+   plugin, as the Any* plugins use at most one concrete instance at a time.
+
+   The plugin names are expected to be global string literals, which allows
+   them to be stored without copying. The count of distinct plugins is small,
+   so a linear search is fine. */
+
+namespace Magnum { namespace Implementation {
+
+template<class T> class PluginInstancePool {
+    public:
+        /* If there's an idle instance of given plugin, returns it and counts
+           a hit. Otherwise returns a null pointer and counts a miss. */
+        Containers::Pointer<T> take(const Containers::StringView plugin) {
+            Entry& e = entry(plugin);
+            if(e.instance) {
+                ++e.hitCount;
+                return Utility::move(e.instance);
+            }
+
+            ++e.missCount;
+            return nullptr;
+        }
+
+        /* Puts an instance back into the pool, replacing a previous idle
+           instance of the same plugin, if any */
+        void put(const Containers::StringView plugin, Containers::Pointer<T>&& instance) {
+            entry(plugin).instance = Utility::move(instance);
+        }
+
+        UnsignedInt hitCount(const Containers::StringView plugin) const {
+            const Entry* const e = find(plugin);
+            return e ? e->hitCount : 0;
+        }
+
+        UnsignedInt missCount(const Containers::StringView plugin) const {
+            const Entry* const e = find(plugin);
+            return e ? e->missCount : 0;
+        }
+
+    private:
+        struct Entry {
+            Containers::String plugin;
+            Containers::Pointer<T> instance;
+            UnsignedInt hitCount;
+            UnsignedInt missCount;
+        };
+
+        const Entry* find(const Containers::StringView plugin) const {
+            for(const Entry& e: _entries)
+                if(e.plugin == plugin) return &e;
+            return nullptr;
+        }
+
+        Entry& entry(const Containers::StringView plugin) {
+            for(Entry& e: _entries)
+                if(e.plugin == plugin) return e;
+            return arrayAppend(_entries, Entry{Containers::String::nullTerminatedGlobalView(plugin), nullptr, 0, 0});
+        }
+
+        Containers::Array<Entry> _entries;
+};
+
+}}
+
+#endif
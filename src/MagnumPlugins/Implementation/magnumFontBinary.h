@@ -0,0 +1,89 @@
+#ifndef Magnum_Text_Implementation_magnumFontBinary_h
+#define Magnum_Text_Implementation_magnumFontBinary_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+
+/* Binary variant of the MagnumFont metadata, written by MagnumFontConverter
+   and read by MagnumFont. The layout is documented in the MagnumFont class
+   docs, keep the two in sync. */
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+constexpr char MagnumFontBinaryMagic[4]{'M', 'G', 'N', 'F'};
+
+constexpr UnsignedByte MagnumFontBinaryVersion = 1;
+
+constexpr char MagnumFontBinaryEndianness =
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    'L'
+    #else
+    'B'
+    #endif
+    ;
+
+/* All members and all arrays following the header are 4-byte types, so as
+   long as the file is loaded to a 4-byte-aligned location, such as by
+   memory-mapping it, the arrays can be used directly */
+struct MagnumFontBinaryHeader {
+    char magic[4];
+    UnsignedByte version;
+    char endianness;
+    UnsignedShort imageNameSize;
+    UnsignedInt glyphCount;
+    UnsignedInt characterCount;
+    Int originalImageSize[2];
+    Int padding[2];
+    Float fontSize;
+    Float ascent;
+    Float descent;
+    Float lineHeight;
+};
+
+static_assert(sizeof(MagnumFontBinaryHeader) == 48, "improper size of MagnumFontBinaryHeader");
+
+/* The header is followed by, in order:
+
+    - characterCount UnsignedInt codepoints, sorted and unique
+    - characterCount UnsignedInt glyph IDs corresponding to the codepoints
+    - glyphCount Vector2 glyph advances
+    - glyphCount Vector2i glyph positions
+    - glyphCount Range2Di glyph rectangles
+    - imageNameSize chars with the image filename, not null-terminated
+
+   Calculated in 64 bits as the counts come from untrusted data and the
+   result could overflow std::size_t on 32-bit platforms, wrapping around to
+   a value that matches the actual data size. */
+inline UnsignedLong magnumFontBinarySize(const MagnumFontBinaryHeader& header) {
+    return sizeof(MagnumFontBinaryHeader) +
+        UnsignedLong(header.characterCount)*2*sizeof(UnsignedInt) +
+        UnsignedLong(header.glyphCount)*(2 + 2 + 4)*sizeof(Int) +
+        header.imageNameSize;
+}
+
+}}}
+
+#endif
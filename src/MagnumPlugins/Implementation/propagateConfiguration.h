@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StringIterable.h>
@@ -33,10 +34,10 @@
 #include "Magnum/Magnum.h"
 
 /* Used by Any* plugins to propagate configuration to the concrete
-   implementation. Assumes that the Any* plugin itself doesn't have any
-   configuration options and so propagates all groups and values that were
-   set, emitting a warning if the target doesn't have such option in its
-   default configuration.
+   implementation. Propagates all groups and values that were set, emitting a
+   warning if the target doesn't have such option in its default
+   configuration. Top-level values listed in `ownValues` are options of the
+   Any* plugin itself and are skipped.
 
    Thoroughly tested in AnySceneImporterTest. */
 
@@ -45,11 +46,18 @@ namespace Magnum { namespace Implementation {
 /* Used only in plugins where we don't want it to be exported */
 namespace {
 
-void propagateConfiguration(const char* warningPrefix, const Containers::String& groupPrefix, const Containers::StringView plugin, const Utility::ConfigurationGroup& src, Utility::ConfigurationGroup& dst, bool warnUnrecognized, bool warnUnrecognizedNested) {
+void propagateConfiguration(const char* warningPrefix, const Containers::String& groupPrefix, const Containers::StringView plugin, const Utility::ConfigurationGroup& src, Utility::ConfigurationGroup& dst, bool warnUnrecognized, bool warnUnrecognizedNested, const Containers::ArrayView<const Containers::StringView> ownValues = {}) {
     using namespace Containers::Literals;
 
     /* Propagate values */
     for(Containers::Pair<Containers::StringView, Containers::StringView> value: src.values()) {
+        bool own = false;
+        for(const Containers::StringView ownValue: ownValues) if(value.first() == ownValue) {
+            own = true;
+            break;
+        }
+        if(own) continue;
+
         if(!dst.hasValue(value.first()) && warnUnrecognized) {
             Warning{} << warningPrefix << "option" << "/"_s.joinWithoutEmptyParts({groupPrefix, value.first()}) << "not recognized by" << plugin;
         }
@@ -77,8 +85,8 @@ void propagateConfiguration(const char* warningPrefix, const Containers::String&
     }
 }
 
-void propagateConfiguration(const char* warningPrefix, const Containers::String& groupPrefix, const Containers::StringView plugin, const Utility::ConfigurationGroup& src, Utility::ConfigurationGroup& dst, bool warnUnrecognized = true) {
-    propagateConfiguration(warningPrefix, groupPrefix, plugin, src, dst, warnUnrecognized, warnUnrecognized);
+void propagateConfiguration(const char* warningPrefix, const Containers::String& groupPrefix, const Containers::StringView plugin, const Utility::ConfigurationGroup& src, Utility::ConfigurationGroup& dst, bool warnUnrecognized = true, const Containers::ArrayView<const Containers::StringView> ownValues = {}) {
+    propagateConfiguration(warningPrefix, groupPrefix, plugin, src, dst, warnUnrecognized, warnUnrecognized, ownValues);
 }
 
 }
@@ -0,0 +1,64 @@
+#ifndef Magnum_Implementation_temporaryFilename_h
+#define Magnum_Implementation_temporaryFilename_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Format.h>
+
+#include "Magnum/Magnum.h"
+
+#ifdef CORRADE_TARGET_WINDOWS
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+/* Used by the Caching* plugins to write a cache file under a temporary name
+   before moving it into place. The name includes the process ID and a
+   per-process counter so concurrent writers in different processes or on
+   different threads never write to the same temporary file. */
+
+namespace Magnum { namespace Implementation {
+
+/* Used only in plugins where we don't want it to be exported */
+namespace {
+
+Containers::String temporaryFilename(const Containers::StringView filename) {
+    static std::atomic<unsigned> counter{0};
+    #ifdef CORRADE_TARGET_WINDOWS
+    const int pid = _getpid();
+    #else
+    const int pid = getpid();
+    #endif
+    return Utility::format("{}.{}.{}.tmp", filename, pid, counter++);
+}
+
+}
+
+}}
+
+#endif
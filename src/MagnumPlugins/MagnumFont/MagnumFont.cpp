@@ -25,14 +25,18 @@
 
 #include "MagnumFont.h"
 
+#include <cstring>
+#include <algorithm> /* std::lower_bound(), std::stable_sort() */
 #include <sstream>
-#include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/Unicode.h>
@@ -41,25 +45,36 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/Implementation/magnumFontBinary.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_MAGNUMFONT_USE_MAP
+#endif
+
 namespace Magnum { namespace Text {
 
 struct MagnumFont::Data {
-    /* Otherwise Clang complains about Utility::Configuration having explicit
-       constructor when emplace()ing the Pointer. Using = default works on
-       newer Clang but not older versions. */
-    explicit Data() {}
-
-    Utility::Configuration conf;
     Containers::Optional<Trade::ImageData2D> image;
     Containers::Optional<Containers::String> filePath;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
-    struct Glyph {
-        Vector2i size;
-        Vector2 advance;
-    };
-    Containers::Array<Glyph> glyphs;
+
+    /* The binary metadata the views below point into. If the file was opened
+       through openFile() without a file callback, it's the memory-mapped
+       file in the binary format, otherwise it's either a copy of the binary
+       data or the text format converted to the binary one. */
+    #ifdef MAGNUM_MAGNUMFONT_USE_MAP
+    Containers::Array<const char, Utility::Path::MapDeleter> mappedData;
+    #endif
+    Containers::Array<char> data;
+
+    Vector2i originalImageSize;
+    Vector2i padding;
+    /* Sorted, for a binary search in glyphId() */
+    Containers::ArrayView<const UnsignedInt> characters;
+    Containers::ArrayView<const UnsignedInt> characterGlyphs;
+    Containers::ArrayView<const Vector2> glyphAdvances;
+    Containers::ArrayView<const Vector2i> glyphPositions;
+    Containers::ArrayView<const Range2Di> glyphRectangles;
 };
 
 namespace {
@@ -90,15 +105,11 @@ bool MagnumFont::doIsOpened() const { return _opened && _opened->image; }
 
 void MagnumFont::doClose() { _opened = nullptr; }
 
-auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const Float) -> Properties {
-    if(!_opened) _opened.emplace();
-
-    if(!_opened->filePath && !fileCallback()) {
-        Error{} << "Text::MagnumFont::openData(): the font can be opened only from the filesystem or if a file callback is present";
-        return {};
-    }
+namespace {
 
-    /* Open the configuration file */
+/* Converts the text format to the binary one so both are handled by the same
+   code path afterwards */
+Containers::Array<char> textToBinary(const Containers::ArrayView<const char> data) {
     /* MSVC 2017 requires explicit std::string constructor. MSVC 2015 doesn't. */
     std::istringstream in(std::string{data.begin(), data.size()});
     Utility::Configuration conf(in, Utility::Configuration::Flag::SkipComments);
@@ -114,67 +125,246 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
         return {};
     }
 
+    const std::string image = conf.value("image");
+    if(image.size() > 0xffff) {
+        Error{} << "Text::MagnumFont::openData(): image filename too long, expected at most 65535 bytes but got" << image.size();
+        return {};
+    }
+
+    /* Sort the character->glyph mapping by codepoint. A stable sort so if a
+       codepoint is listed more than once, the first occurence wins, same as
+       was the case with the original hashmap-based implementation. */
+    const std::vector<Utility::ConfigurationGroup*> chars = conf.groups("char");
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> sortedChars;
+    sortedChars.reserve(chars.size());
+    for(const Utility::ConfigurationGroup* const c: chars)
+        sortedChars.emplace_back(c->value<char32_t>("unicode"), c->value<UnsignedInt>("glyph"));
+    std::stable_sort(sortedChars.begin(), sortedChars.end(),
+        [](const std::pair<UnsignedInt, UnsignedInt>& a,
+           const std::pair<UnsignedInt, UnsignedInt>& b) {
+            return a.first < b.first;
+        });
+    sortedChars.erase(std::unique(sortedChars.begin(), sortedChars.end(),
+        [](const std::pair<UnsignedInt, UnsignedInt>& a,
+           const std::pair<UnsignedInt, UnsignedInt>& b) {
+            return a.first == b.first;
+        }), sortedChars.end());
+
+    const std::vector<Utility::ConfigurationGroup*> glyphs = conf.groups("glyph");
+
+    Implementation::MagnumFontBinaryHeader header{};
+    Utility::copy(Implementation::MagnumFontBinaryMagic, header.magic);
+    header.version = Implementation::MagnumFontBinaryVersion;
+    header.endianness = Implementation::MagnumFontBinaryEndianness;
+    header.imageNameSize = UnsignedShort(image.size());
+    header.glyphCount = glyphs.size();
+    header.characterCount = sortedChars.size();
+    const Vector2i originalImageSize = conf.value<Vector2i>("originalImageSize");
+    const Vector2i padding = conf.value<Vector2i>("padding");
+    header.originalImageSize[0] = originalImageSize.x();
+    header.originalImageSize[1] = originalImageSize.y();
+    header.padding[0] = padding.x();
+    header.padding[1] = padding.y();
+    header.fontSize = conf.value<Float>("fontSize");
+    header.ascent = conf.value<Float>("ascent");
+    header.descent = conf.value<Float>("descent");
+    header.lineHeight = conf.value<Float>("lineHeight");
+
+    Containers::Array<char> out{ValueInit, std::size_t(Implementation::magnumFontBinarySize(header))};
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::size_t offset = sizeof(header);
+    const Containers::ArrayView<UnsignedInt> characters = Containers::arrayCast<UnsignedInt>(out.sliceSize(offset, sortedChars.size()*sizeof(UnsignedInt)));
+    offset += sortedChars.size()*sizeof(UnsignedInt);
+    const Containers::ArrayView<UnsignedInt> characterGlyphs = Containers::arrayCast<UnsignedInt>(out.sliceSize(offset, sortedChars.size()*sizeof(UnsignedInt)));
+    offset += sortedChars.size()*sizeof(UnsignedInt);
+    for(std::size_t i = 0; i != sortedChars.size(); ++i) {
+        characters[i] = sortedChars[i].first;
+        characterGlyphs[i] = sortedChars[i].second;
+    }
+
+    const Containers::ArrayView<Vector2> glyphAdvances = Containers::arrayCast<Vector2>(out.sliceSize(offset, glyphs.size()*sizeof(Vector2)));
+    offset += glyphs.size()*sizeof(Vector2);
+    const Containers::ArrayView<Vector2i> glyphPositions = Containers::arrayCast<Vector2i>(out.sliceSize(offset, glyphs.size()*sizeof(Vector2i)));
+    offset += glyphs.size()*sizeof(Vector2i);
+    const Containers::ArrayView<Range2Di> glyphRectangles = Containers::arrayCast<Range2Di>(out.sliceSize(offset, glyphs.size()*sizeof(Range2Di)));
+    offset += glyphs.size()*sizeof(Range2Di);
+    for(std::size_t i = 0; i != glyphs.size(); ++i) {
+        glyphAdvances[i] = glyphs[i]->value<Vector2>("advance");
+        glyphPositions[i] = glyphs[i]->value<Vector2i>("position");
+        glyphRectangles[i] = glyphs[i]->value<Range2Di>("rectangle");
+    }
+
+    Utility::copy(Containers::arrayView(image.data(), image.size()), out.exceptPrefix(offset));
+
+    return out;
+}
+
+/* Returns false if the binary data are invalid */
+bool validateBinary(const Containers::ArrayView<const char> data) {
+    if(data.size() < sizeof(Implementation::MagnumFontBinaryHeader)) {
+        Error{} << "Text::MagnumFont::openData(): expected at least" << sizeof(Implementation::MagnumFontBinaryHeader) << "bytes for a header but got" << data.size();
+        return false;
+    }
+
+    const auto& header = *reinterpret_cast<const Implementation::MagnumFontBinaryHeader*>(data.data());
+    if(header.version != Implementation::MagnumFontBinaryVersion) {
+        Error{} << "Text::MagnumFont::openData(): unsupported binary version" << header.version << Debug::nospace << ", expected" << Implementation::MagnumFontBinaryVersion;
+        return false;
+    }
+    if(header.endianness != Implementation::MagnumFontBinaryEndianness) {
+        Error{} << "Text::MagnumFont::openData(): expected" << (Implementation::MagnumFontBinaryEndianness == 'L' ? "Little-Endian" : "Big-Endian") << "data";
+        return false;
+    }
+    /* Glyph 0 is the fallback for characters not found in the font, so
+       there has to be at least that one */
+    if(!header.glyphCount) {
+        Error{} << "Text::MagnumFont::openData(): expected at least one glyph";
+        return false;
+    }
+    const UnsignedLong expectedSize = Implementation::magnumFontBinarySize(header);
+    if(data.size() != expectedSize) {
+        Error{} << "Text::MagnumFont::openData(): expected" << expectedSize << "bytes for" << header.characterCount << "characters," << header.glyphCount << "glyphs and a" << header.imageNameSize << Debug::nospace << "-byte image filename but got" << data.size();
+        return false;
+    }
+
+    /* Check that the characters are sorted and map to valid glyphs, as the
+       lookup relies on that */
+    const Containers::ArrayView<const UnsignedInt> characters = Containers::arrayCast<const UnsignedInt>(data.sliceSize(sizeof(header), header.characterCount*sizeof(UnsignedInt)));
+    const Containers::ArrayView<const UnsignedInt> characterGlyphs = Containers::arrayCast<const UnsignedInt>(data.sliceSize(sizeof(header) + header.characterCount*sizeof(UnsignedInt), header.characterCount*sizeof(UnsignedInt)));
+    for(std::size_t i = 0; i != characters.size(); ++i) {
+        if(i && characters[i - 1] >= characters[i]) {
+            Error{} << "Text::MagnumFont::openData(): character" << i << "not sorted";
+            return false;
+        }
+        if(characterGlyphs[i] >= header.glyphCount) {
+            Error{} << "Text::MagnumFont::openData(): character" << i << "references glyph" << characterGlyphs[i] << "but there's" << header.glyphCount << "glyphs";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const Float) -> Properties {
+    if(!_opened) _opened.emplace();
+
+    if(!_opened->filePath && !fileCallback()) {
+        Error{} << "Text::MagnumFont::openData(): the font can be opened only from the filesystem or if a file callback is present";
+        return {};
+    }
+
+    /* If the data start with the binary magic, use them directly if they're
+       memory-mapped by openFile(), otherwise make a copy as there's no
+       guarantee the data stay in scope or are suitably aligned. If it's the
+       text format, convert it to the binary one. */
+    Containers::ArrayView<const char> binary;
+    if(data.size() >= sizeof(Implementation::MagnumFontBinaryMagic) && std::memcmp(data.data(), Implementation::MagnumFontBinaryMagic, sizeof(Implementation::MagnumFontBinaryMagic)) == 0) {
+        #ifdef MAGNUM_MAGNUMFONT_USE_MAP
+        if(data.data() == _opened->mappedData.data())
+            binary = data;
+        else
+        #endif
+        {
+            _opened->data = Containers::Array<char>{NoInit, data.size()};
+            Utility::copy(data, _opened->data);
+            binary = _opened->data;
+        }
+    } else {
+        _opened->data = textToBinary(data);
+        if(_opened->data.isEmpty()) return {};
+        binary = _opened->data;
+
+        #ifdef MAGNUM_MAGNUMFONT_USE_MAP
+        /* The mapping isn't needed anymore */
+        _opened->mappedData = nullptr;
+        #endif
+    }
+
+    /* For the text format this checks just the glyph IDs, everything else is
+       valid by construction */
+    if(!validateBinary(binary)) return {};
+
+    const auto& header = *reinterpret_cast<const Implementation::MagnumFontBinaryHeader*>(binary.data());
+    std::size_t offset = sizeof(header);
+    const Containers::ArrayView<const UnsignedInt> characters = Containers::arrayCast<const UnsignedInt>(binary.sliceSize(offset, header.characterCount*sizeof(UnsignedInt)));
+    offset += header.characterCount*sizeof(UnsignedInt);
+    const Containers::ArrayView<const UnsignedInt> characterGlyphs = Containers::arrayCast<const UnsignedInt>(binary.sliceSize(offset, header.characterCount*sizeof(UnsignedInt)));
+    offset += header.characterCount*sizeof(UnsignedInt);
+    const Containers::ArrayView<const Vector2> glyphAdvances = Containers::arrayCast<const Vector2>(binary.sliceSize(offset, header.glyphCount*sizeof(Vector2)));
+    offset += header.glyphCount*sizeof(Vector2);
+    const Containers::ArrayView<const Vector2i> glyphPositions = Containers::arrayCast<const Vector2i>(binary.sliceSize(offset, header.glyphCount*sizeof(Vector2i)));
+    offset += header.glyphCount*sizeof(Vector2i);
+    const Containers::ArrayView<const Range2Di> glyphRectangles = Containers::arrayCast<const Range2Di>(binary.sliceSize(offset, header.glyphCount*sizeof(Range2Di)));
+    offset += header.glyphCount*sizeof(Range2Di);
+    const Containers::StringView imageName{binary.data() + offset, header.imageNameSize};
+
     /* Open and load image file. Error messages should be printed by the
        TgaImporter already, no need to repeat them again. */
     Trade::TgaImporter importer;
     importer.setFileCallback(fileCallback(), fileCallbackUserData());
-    if(!importer.openFile(Utility::Path::join(_opened->filePath ? *_opened->filePath : "", conf.value("image")))) return {};
+    if(!importer.openFile(Utility::Path::join(_opened->filePath ? *_opened->filePath : "", imageName))) return {};
     _opened->image = importer.image2D(0);
     if(!_opened->image) return {};
 
-    /* Everything okay, save the data internally */
-    _opened->conf = Utility::move(conf);
-
-    /* Glyph advances */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    _opened->glyphs = Containers::Array<Data::Glyph>{NoInit, glyphs.size()};
-    for(std::size_t i = 0; i != glyphs.size(); ++i)
-        _opened->glyphs[i] = {
-            glyphs[i]->value<Range2Di>("rectangle").size(),
-            glyphs[i]->value<Vector2>("advance")
-        };
-
-    /* Fill character->glyph map */
-    const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
-    for(const Utility::ConfigurationGroup* const c: chars) {
-        const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
-        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphs.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
-    }
-
-    return {_opened->conf.value<Float>("fontSize"),
-            _opened->conf.value<Float>("ascent"),
-            _opened->conf.value<Float>("descent"),
-            _opened->conf.value<Float>("lineHeight"),
-            UnsignedInt(glyphs.size())};
+    /* Everything okay, save the views internally */
+    _opened->originalImageSize = Vector2i::from(header.originalImageSize);
+    _opened->padding = Vector2i::from(header.padding);
+    _opened->characters = characters;
+    _opened->characterGlyphs = characterGlyphs;
+    _opened->glyphAdvances = glyphAdvances;
+    _opened->glyphPositions = glyphPositions;
+    _opened->glyphRectangles = glyphRectangles;
+
+    return {header.fontSize,
+            header.ascent,
+            header.descent,
+            header.lineHeight,
+            header.glyphCount};
 }
 
 auto MagnumFont::doOpenFile(const Containers::StringView filename, const Float size) -> Properties {
     _opened.emplace();
     _opened->filePath.emplace(Utility::Path::split(filename).first());
 
+    /* If there's no file callback, memory-map the file. In case of the binary
+       format, the mapping is then used directly without any copy. */
+    #ifdef MAGNUM_MAGNUMFONT_USE_MAP
+    if(!fileCallback()) {
+        Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+        if(!mapped) {
+            Error{} << "Text::MagnumFont::openFile(): cannot open file" << filename;
+            return {};
+        }
+
+        _opened->mappedData = *Utility::move(mapped);
+        return doOpenData(_opened->mappedData, size);
+    }
+    #endif
+
     return AbstractFont::doOpenFile(filename, size);
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    const UnsignedInt* const found = std::lower_bound(_opened->characters.begin(), _opened->characters.end(), UnsignedInt(character));
+    return found != _opened->characters.end() && *found == UnsignedInt(character) ? _opened->characterGlyphs[found - _opened->characters.begin()] : 0;
 }
 
 Vector2 MagnumFont::doGlyphSize(const UnsignedInt glyph) {
-    return Vector2{_opened->glyphs[glyph].size};
+    return Vector2{_opened->glyphRectangles[glyph].size()};
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
-    return _opened->glyphs[glyph].advance;
+    return _opened->glyphAdvances[glyph];
 }
 
 Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
     /* Set cache image */
     Containers::Pointer<GlyphCache> cache{InPlaceInit,
-        _opened->conf.value<Vector2i>("originalImageSize"),
+        _opened->originalImageSize,
         _opened->image->size(),
-        _opened->conf.value<Vector2i>("padding")};
+        _opened->padding};
     /* Copy the opened image data directly to the GL texture because (unlike
        image()) it matches the actual image size if it differs from
        originalImageSize. A potential other way would be to create a
@@ -185,17 +375,15 @@ Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
         directly from the base class */
     cache->texture().setSubImage(0, {}, *_opened->image);
 
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-
     /* Set the global invalid glyph to the same as the per-font invalid
        glyph. */
-    if(!glyphs.empty())
-        cache->setInvalidGlyph(glyphs[0]->value<Vector2i>("position"), glyphs[0]->value<Range2Di>("rectangle"));
+    if(!_opened->glyphRectangles.isEmpty())
+        cache->setInvalidGlyph(_opened->glyphPositions[0], _opened->glyphRectangles[0]);
 
     /* Add a font, fill the glyph map */
-    const UnsignedInt fontId = cache->addFont(glyphs.size(), this);
-    for(std::size_t i = 0; i < glyphs.size(); ++i)
-        cache->addGlyph(fontId, i, glyphs[i]->value<Vector2i>("position"), glyphs[i]->value<Range2Di>("rectangle"));
+    const UnsignedInt fontId = cache->addFont(_opened->glyphRectangles.size(), this);
+    for(std::size_t i = 0; i < _opened->glyphRectangles.size(); ++i)
+        cache->addGlyph(fontId, i, _opened->glyphPositions[i], _opened->glyphRectangles[i]);
 
     /* GCC 4.8 needs extra help here */
     return Containers::Pointer<AbstractGlyphCache>{Utility::move(cache)};
@@ -220,12 +408,11 @@ Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCa
     arrayReserve(glyphs, text.size());
     for(std::size_t i = 0; i != text.size(); ) {
         const Containers::Pair<char32_t, std::size_t> codepointNext = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepointNext.first());
-        arrayAppend(glyphs, it == _opened->glyphId.end() ? 0 : it->second);
+        arrayAppend(glyphs, doGlyphId(codepointNext.first()));
         i = codepointNext.second();
     }
 
-    return Containers::pointer<MagnumFontLayouter>(stridedArrayView(_opened->glyphs).slice(&Data::Glyph::advance), cache, *fontId, this->size(), size, Utility::move(glyphs));
+    return Containers::pointer<MagnumFontLayouter>(_opened->glyphAdvances, cache, *fontId, this->size(), size, Utility::move(glyphs));
 }
 
 namespace {
@@ -116,6 +116,45 @@ rectangle=45 0 44 25
 # ...
 @endcode
 
+@section Text-MagnumFont-binary Binary metadata format
+
+Besides the text format, the metadata can be stored in a compact binary file,
+produced by @ref MagnumFontConverter with the @cb{.ini} binary @ce
+@ref Text-MagnumFontConverter-configuration "configuration option" enabled.
+The plugin detects the format from the file contents, so the binary file can
+be passed to @ref openFile() or @ref openData() the same way as the text one.
+When opened from the filesystem without a
+@ref Text-AbstractFont-usage-callbacks "file callback", the file is
+memory-mapped and the glyph data are used directly from the mapped memory,
+with no parsing and no copies. The text format is converted to the binary one
+internally on opening, so lookups behave the same for both.
+
+All data are stored in the native endianness, there's no attempt at
+portability between platforms with different endianness. The file starts with
+a 48-byte header:
+
+-   4 bytes with the `MGNF` magic,
+-   a 8-bit format version, currently @cpp 1 @ce,
+-   a 8-bit endianness marker, @cpp 'L' @ce for Little-Endian and
+    @cpp 'B' @ce for Big-Endian,
+-   a 16-bit image filename size,
+-   a 32-bit glyph count,
+-   a 32-bit character count,
+-   two 32-bit integers with the unscaled font image size,
+-   two 32-bit integers with the glyph padding,
+-   32-bit floats with the font size, ascent, descent and line height.
+
+The header is followed by these arrays, tightly packed:
+
+-   character count 32-bit UTF-32 codepoints, sorted and unique,
+-   character count 32-bit glyph IDs corresponding to the codepoints,
+-   glyph count pairs of 32-bit floats with glyph advances,
+-   glyph count pairs of 32-bit integers with glyph texture positions
+    relative to baseline,
+-   glyph count quadruples of 32-bit integers with glyph rectangles in the
+    font image (left, bottom, right, top),
+-   the image filename, not null-terminated.
+
 @section Text-MagnumFont-usage Usage
 
 @m_class{m-note m-success}
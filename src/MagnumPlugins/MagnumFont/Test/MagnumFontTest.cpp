@@ -30,7 +30,9 @@
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractFont is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
 
 #include "Magnum/FileCallback.h"
@@ -49,6 +51,7 @@ struct MagnumFontTest: TestSuite::Tester {
 
     void nonexistent();
     void properties();
+    void binaryInvalid();
     void layout();
     void layoutNoGlyphsInCache();
     void layoutNoFontInCache();
@@ -62,6 +65,47 @@ struct MagnumFontTest: TestSuite::Tester {
     PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    const char* filename;
+    bool binary;
+} FileData[]{
+    {"text", "font.conf", false},
+    {"binary", "font.magnumfont", true},
+};
+
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    char value;
+    const char* message;
+} BinaryInvalidData[]{
+    {"too short for a header", 47, 0, 'M',
+        "expected at least 48 bytes for a header but got 47"},
+    {"unsupported version", 224, 4, 2,
+        "unsupported binary version 2, expected 1"},
+    {"different endianness", 224, 5, 'B',
+        "expected Little-Endian data"},
+    /* Glyph count changed from 4 to 0 */
+    {"no glyphs", 224, 8, 0,
+        "expected at least one glyph"},
+    /* Glyph count changed from 0x00000004 to 0x10000004. With the size
+       calculated in 32 bits it'd wrap around to exactly 224 bytes. */
+    {"glyph count overflowing 32 bits", 224, 11, 0x10,
+        "expected 8589934816 bytes for 5 characters, 268435460 glyphs and a 8-byte image filename but got 224"},
+    {"too short", 223, 0, 'M',
+        "expected 224 bytes for 5 characters, 4 glyphs and a 8-byte image filename but got 223"},
+    {"too long", 225, 0, 'M',
+        "expected 224 bytes for 5 characters, 4 glyphs and a 8-byte image filename but got 225"},
+    /* Second codepoint changed from 0x61 to 0x57, the same as the first */
+    {"characters not sorted", 224, 52, 0x57,
+        "character 1 not sorted"},
+    /* Third glyph ID changed from 1 to 4 */
+    {"glyph out of range", 224, 76, 4,
+        "character 2 references glyph 4 but there's 4 glyphs"},
+};
+
 const struct {
     const char* name;
     const char* string;
@@ -71,18 +115,25 @@ const struct {
 };
 
 MagnumFontTest::MagnumFontTest() {
-    addTests({&MagnumFontTest::nonexistent,
-              &MagnumFontTest::properties});
+    addTests({&MagnumFontTest::nonexistent});
+
+    addInstancedTests({&MagnumFontTest::properties},
+        Containers::arraySize(FileData));
+
+    addInstancedTests({&MagnumFontTest::binaryInvalid},
+        Containers::arraySize(BinaryInvalidData));
 
     addInstancedTests({&MagnumFontTest::layout},
         Containers::arraySize(LayoutData));
 
     addTests({&MagnumFontTest::layoutNoGlyphsInCache,
               &MagnumFontTest::layoutNoFontInCache,
-              &MagnumFontTest::layoutArrayCache,
+              &MagnumFontTest::layoutArrayCache});
 
-              &MagnumFontTest::fileCallbackImage,
-              &MagnumFontTest::fileCallbackImageNotFound});
+    addInstancedTests({&MagnumFontTest::fileCallbackImage},
+        Containers::arraySize(FileData));
+
+    addTests({&MagnumFontTest::fileCallbackImageNotFound});
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -99,16 +150,28 @@ void MagnumFontTest::nonexistent() {
     std::ostringstream out;
     Error redirectError{&out};
     CORRADE_VERIFY(!font->openFile("nonexistent.conf", 0.0f));
-    /* There's an error message from Path::read() before */
+    /* There's an error message from Path::mapRead() or Path::read() before */
     CORRADE_COMPARE_AS(out.str(),
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        "\nText::MagnumFont::openFile(): cannot open file nonexistent.conf\n",
+        #else
         "\nText::AbstractFont::openFile(): cannot open file nonexistent.conf\n",
+        #endif
         TestSuite::Compare::StringHasSuffix);
 }
 
 void MagnumFontTest::properties() {
+    auto&& data = FileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    if(data.binary)
+        CORRADE_SKIP("The binary test file is Little-Endian, can't test on a Big-Endian platform.");
+    #endif
+
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
 
-    CORRADE_VERIFY(font->openFile(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    CORRADE_VERIFY(font->openFile(Utility::Path::join(MAGNUMFONT_TEST_DIR, data.filename), 0.0f));
     CORRADE_COMPARE(font->size(), 16.0f);
     CORRADE_COMPARE(font->ascent(), 25.0f);
     CORRADE_COMPARE(font->descent(), -10.0f);
@@ -130,6 +193,40 @@ void MagnumFontTest::properties() {
     CORRADE_COMPARE(eId, 3);
     CORRADE_COMPARE(font->glyphSize(font->glyphId(U'W')), (Vector2{8.0f, 44.0f}));
     CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), (Vector2{23.0f, 0.0f}));
+
+    /* Characters not in the font, below, between and above the listed ones */
+    CORRADE_COMPARE(font->glyphId(U'!'), 0);
+    CORRADE_COMPARE(font->glyphId(U'X'), 0);
+    CORRADE_COMPARE(font->glyphId(U'\U0001F600'), 0);
+}
+
+void MagnumFontTest::binaryInvalid() {
+    auto&& data = BinaryInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The binary test file is Little-Endian, can't test on a Big-Endian platform.");
+    #endif
+
+    Containers::Optional<Containers::Array<char>> file = Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"));
+    CORRADE_VERIFY(file);
+    CORRADE_COMPARE(file->size(), 224);
+
+    /* Zero-initialized so the extra byte in the too long case is defined */
+    Containers::Array<char> in{ValueInit, data.size};
+    Utility::copy(file->prefix(data.size < file->size() ? data.size : file->size()), in.prefix(data.size < file->size() ? data.size : file->size()));
+    in[data.offset] = data.value;
+
+    /* The image is never loaded so the callback can be a no-op */
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+    font->setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) {
+            return Containers::Optional<Containers::ArrayView<const char>>{};
+        });
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openData(in, 0.0f));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Text::MagnumFont::openData(): {}\n", data.message));
 }
 
 void MagnumFontTest::layout() {
@@ -282,16 +379,24 @@ void MagnumFontTest::layoutArrayCache() {
 }
 
 void MagnumFontTest::fileCallbackImage() {
+    auto&& data = FileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    if(data.binary)
+        CORRADE_SKIP("The binary test file is Little-Endian, can't test on a Big-Endian platform.");
+    #endif
+
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
     CORRADE_VERIFY(font->features() & FontFeature::FileCallback);
 
     std::unordered_map<std::string, Containers::Array<char>> files;
-    Containers::Optional<Containers::Array<char>> conf = Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.conf"));
+    Containers::Optional<Containers::Array<char>> conf = Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, data.filename));
     Containers::Optional<Containers::Array<char>> tga =
     Utility::Path::read(Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.tga"));
     CORRADE_VERIFY(conf);
     CORRADE_VERIFY(tga);
-    files["not/a/path/font.conf"] = *Utility::move(conf);
+    files[Utility::Path::join("not/a/path", data.filename)] = *Utility::move(conf);
     files["not/a/path/font.tga"] = *Utility::move(tga);
     font->setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy,
         std::unordered_map<std::string, Containers::Array<char>>& files) {
@@ -299,7 +404,7 @@ void MagnumFontTest::fileCallbackImage() {
             return Containers::optional(Containers::ArrayView<const char>(files.at(filename)));
         }, files);
 
-    CORRADE_VERIFY(font->openFile("not/a/path/font.conf", 13.0f));
+    CORRADE_VERIFY(font->openFile(Utility::Path::join("not/a/path", data.filename), 13.0f));
     CORRADE_COMPARE(font->size(), 16.0f);
     CORRADE_COMPARE(font->ascent(), 25.0f);
     CORRADE_COMPARE(font->descent(), -10.0f);
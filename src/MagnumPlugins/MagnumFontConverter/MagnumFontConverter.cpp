@@ -25,13 +25,16 @@
 
 #include "MagnumFontConverter.h"
 
+#include <cstring>
 #include <algorithm> /* std::sort() */
 #include <sstream>
 #include <unordered_map>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Path.h>
 
@@ -41,6 +44,7 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractGlyphCache.h"
+#include "MagnumPlugins/Implementation/magnumFontBinary.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
@@ -75,16 +79,7 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         return {};
     }
 
-    Utility::Configuration configuration;
-
-    configuration.setValue("version", 1);
-    configuration.setValue("image", Utility::Path::split(filename).second() + ".tga");
-    configuration.setValue("originalImageSize", cache.size().xy());
-    configuration.setValue("padding", cache.padding());
-    configuration.setValue("fontSize", font.size());
-    configuration.setValue("ascent", font.ascent());
-    configuration.setValue("descent", font.descent());
-    configuration.setValue("lineHeight", font.lineHeight());
+    const std::string imageFilename = Utility::Path::split(filename).second() + ".tga";
 
     /* Get the glyphs and sort them for predictable output */
     std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> sortedGlyphs;
@@ -114,37 +109,120 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     for(const std::pair<const UnsignedInt, UnsignedInt>& map: glyphIdMap)
         inverseGlyphIdMap[map.second] = map.first;
 
-    /* Character->glyph map, map glyph IDs to new ones */
+    /* Character->glyph map, map glyph IDs to new ones. The characters are
+       already sorted and unique, which the binary format relies on. */
+    std::vector<UnsignedInt> characterGlyphs;
+    characterGlyphs.reserve(characters.size());
     for(const char32_t c: characters) {
-        Utility::ConfigurationGroup* group = configuration.addGroup("char");
-        const UnsignedInt glyphId = font.glyphId(c);
-        group->setValue("unicode", c);
-
         /* Map old glyph ID to new, if not found, map to glyph 0 */
-        auto found = glyphIdMap.find(glyphId);
-        group->setValue("glyph", found == glyphIdMap.end() ? 0 : glyphIdMap.at(glyphId));
+        auto found = glyphIdMap.find(font.glyphId(c));
+        characterGlyphs.push_back(found == glyphIdMap.end() ? 0 : found->second);
     }
 
-    /* Save glyph properties in order which preserves their IDs, remove padding
+    /* Glyph properties in order which preserves their IDs, remove padding
        from the values so they aren't added twice when using the font later */
     /** @todo Some better way to handle this padding stuff */
+    std::vector<Vector2> glyphAdvances;
+    std::vector<Vector2i> glyphPositions;
+    std::vector<Range2Di> glyphRectangles;
+    glyphAdvances.reserve(inverseGlyphIdMap.size());
+    glyphPositions.reserve(inverseGlyphIdMap.size());
+    glyphRectangles.reserve(inverseGlyphIdMap.size());
     for(UnsignedInt oldGlyphId: inverseGlyphIdMap) {
         /** @todo this branch is messy, clean up; also there's now a
             distinction between a cache-global invalid glyph and font-local,
             what to do there? */
         Containers::Triple<Vector2i, Int, Range2Di> glyph =
             oldGlyphId ? cache.glyph(*fontId, oldGlyphId) : cache.glyph(0);
-        Utility::ConfigurationGroup* group = configuration.addGroup("glyph");
-        group->setValue("advance", font.glyphAdvance(oldGlyphId));
-        group->setValue("position", glyph.first() + cache.padding());
-        group->setValue("rectangle", glyph.third().padded(-cache.padding()));
+        glyphAdvances.push_back(font.glyphAdvance(oldGlyphId));
+        glyphPositions.push_back(glyph.first() + cache.padding());
+        glyphRectangles.push_back(glyph.third().padded(-cache.padding()));
     }
 
-    std::ostringstream confOut;
-    configuration.save(confOut);
-    std::string confStr = confOut.str();
-    Containers::Array<char> confData{confStr.size()};
-    std::copy(confStr.begin(), confStr.end(), confData.begin());
+    std::string metadataFilename;
+    Containers::Array<char> metadata;
+
+    /* Binary metadata, in the layout described in the MagnumFont docs */
+    if(configuration().value<bool>("binary")) {
+        if(imageFilename.size() > 0xffff) {
+            Error{} << "Text::MagnumFontConverter::exportFontToData(): image filename too long, expected at most 65535 bytes but got" << imageFilename.size();
+            return {};
+        }
+
+        Implementation::MagnumFontBinaryHeader header{};
+        Utility::copy(Implementation::MagnumFontBinaryMagic, header.magic);
+        header.version = Implementation::MagnumFontBinaryVersion;
+        header.endianness = Implementation::MagnumFontBinaryEndianness;
+        header.imageNameSize = UnsignedShort(imageFilename.size());
+        header.glyphCount = UnsignedInt(glyphAdvances.size());
+        header.characterCount = UnsignedInt(characters.size());
+        header.originalImageSize[0] = cache.size().x();
+        header.originalImageSize[1] = cache.size().y();
+        header.padding[0] = cache.padding().x();
+        header.padding[1] = cache.padding().y();
+        header.fontSize = font.size();
+        header.ascent = font.ascent();
+        header.descent = font.descent();
+        header.lineHeight = font.lineHeight();
+
+        /* Zero-initialized so the output is deterministic even if the header
+           had some padding */
+        metadata = Containers::Array<char>{ValueInit, std::size_t(Implementation::magnumFontBinarySize(header))};
+        std::memcpy(metadata.data(), &header, sizeof(header));
+        std::size_t offset = sizeof(header);
+        Utility::copy(Containers::arrayView(reinterpret_cast<const UnsignedInt*>(characters.data()), characters.size()),
+            Containers::arrayCast<UnsignedInt>(metadata.sliceSize(offset, characters.size()*sizeof(UnsignedInt))));
+        offset += characters.size()*sizeof(UnsignedInt);
+        Utility::copy(Containers::arrayView(characterGlyphs),
+            Containers::arrayCast<UnsignedInt>(metadata.sliceSize(offset, characterGlyphs.size()*sizeof(UnsignedInt))));
+        offset += characterGlyphs.size()*sizeof(UnsignedInt);
+        Utility::copy(Containers::arrayView(glyphAdvances),
+            Containers::arrayCast<Vector2>(metadata.sliceSize(offset, glyphAdvances.size()*sizeof(Vector2))));
+        offset += glyphAdvances.size()*sizeof(Vector2);
+        Utility::copy(Containers::arrayView(glyphPositions),
+            Containers::arrayCast<Vector2i>(metadata.sliceSize(offset, glyphPositions.size()*sizeof(Vector2i))));
+        offset += glyphPositions.size()*sizeof(Vector2i);
+        Utility::copy(Containers::arrayView(glyphRectangles),
+            Containers::arrayCast<Range2Di>(metadata.sliceSize(offset, glyphRectangles.size()*sizeof(Range2Di))));
+        offset += glyphRectangles.size()*sizeof(Range2Di);
+        Utility::copy(Containers::arrayView(imageFilename.data(), imageFilename.size()), metadata.exceptPrefix(offset));
+
+        metadataFilename = filename + ".magnumfont";
+
+    /* Text metadata */
+    } else {
+        Utility::Configuration configuration;
+
+        configuration.setValue("version", 1);
+        configuration.setValue("image", imageFilename);
+        configuration.setValue("originalImageSize", cache.size().xy());
+        configuration.setValue("padding", cache.padding());
+        configuration.setValue("fontSize", font.size());
+        configuration.setValue("ascent", font.ascent());
+        configuration.setValue("descent", font.descent());
+        configuration.setValue("lineHeight", font.lineHeight());
+
+        for(std::size_t i = 0; i != characters.size(); ++i) {
+            Utility::ConfigurationGroup* group = configuration.addGroup("char");
+            group->setValue("unicode", characters[i]);
+            group->setValue("glyph", characterGlyphs[i]);
+        }
+
+        for(std::size_t i = 0; i != glyphAdvances.size(); ++i) {
+            Utility::ConfigurationGroup* group = configuration.addGroup("glyph");
+            group->setValue("advance", glyphAdvances[i]);
+            group->setValue("position", glyphPositions[i]);
+            group->setValue("rectangle", glyphRectangles[i]);
+        }
+
+        std::ostringstream confOut;
+        configuration.save(confOut);
+        std::string confStr = confOut.str();
+        metadata = Containers::Array<char>{NoInit, confStr.size()};
+        std::copy(confStr.begin(), confStr.end(), metadata.begin());
+
+        metadataFilename = filename + ".conf";
+    }
 
     /* Save cache image. Either the source image or the processed one if the
        cache has image processing. */
@@ -162,7 +240,7 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     }
 
     std::vector<std::pair<std::string, Containers::Array<char>>> out;
-    out.emplace_back(filename + ".conf", Utility::move(confData));
+    out.emplace_back(metadataFilename, Utility::move(metadata));
     out.emplace_back(filename + ".tga", *Utility::move(tgaData));
     return out;
 }
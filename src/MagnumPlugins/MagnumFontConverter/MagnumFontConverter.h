@@ -54,8 +54,11 @@ namespace Magnum { namespace Text {
 /**
 @brief MagnumFont converter plugin
 
-Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
-@ref MagnumFont for more information about the font. The plugin requires the
+Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`,
+or `prefix.magnumfont` and `prefix.tga` if the
+@cb{.ini} binary @ce @ref Text-MagnumFontConverter-configuration "configuration option"
+is enabled. See @ref MagnumFont for more information about the font and the
+@ref Text-MagnumFont-binary "binary metadata format". The plugin requires the
 passed @ref AbstractGlyphCache to be 2D, have a format compatible with the
 @relativeref{Trade,TgaImageConverter} plugin and either not have
 @ref GlyphCacheFeature::ImageProcessing or support both
@@ -107,6 +110,16 @@ you need to instantiate a manager for them and register it with
 @snippet plugins.cpp MagnumFontConverter-imageconverter-register
 
 See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Text-MagnumFontConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/MagnumFontConverter/MagnumFontConverter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_MAGNUMFONTCONVERTER_EXPORT MagnumFontConverter: public Text::AbstractFontConverter {
     public:
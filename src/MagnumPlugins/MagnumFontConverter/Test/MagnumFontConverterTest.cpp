@@ -71,8 +71,20 @@ struct MagnumFontConverterTest: TestSuite::Tester {
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    bool binary;
+    const char* filename;
+} ExportFontData[]{
+    {"", false, "font.conf"},
+    {"binary", true, "font.magnumfont"},
+};
+
 MagnumFontConverterTest::MagnumFontConverterTest() {
-    addTests({&MagnumFontConverterTest::exportFont,
+    addInstancedTests({&MagnumFontConverterTest::exportFont},
+        Containers::arraySize(ExportFontData));
+
+    addTests({
               #ifdef MAGNUM_BUILD_DEPRECATED
               &MagnumFontConverterTest::exportFontOldStyleCache,
               #endif
@@ -151,7 +163,15 @@ class MyFont: public Text::AbstractFont {
 };
 
 void MagnumFontConverterTest::exportFont() {
-    Containers::String confFilename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf");
+    auto&& data = ExportFontData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    if(data.binary)
+        CORRADE_SKIP("The binary test file is Little-Endian, can't test on a Big-Endian platform.");
+    #endif
+
+    Containers::String confFilename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, data.filename);
     Containers::String tgaFilename = Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga");
     /* Remove previously created files */
     if(Utility::Path::exists(confFilename))
@@ -210,11 +230,12 @@ void MagnumFontConverterTest::exportFont() {
 
     /* Convert the file */
     Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    converter->configuration().setValue("binary", data.binary);
     CORRADE_VERIFY(converter->exportFontToFile(font, cache, Utility::Path::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font"), "Waveě"));
 
     /* Verify font parameters */
     CORRADE_COMPARE_AS(confFilename,
-        Utility::Path::join(MAGNUMFONT_TEST_DIR, "font.conf"),
+        Utility::Path::join(MAGNUMFONT_TEST_DIR, data.filename),
         TestSuite::Compare::File);
 
     if(!(_importerManager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImporter.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade {
+
+struct MagnumImporter::State {
+    Containers::Array<char> in;
+
+    /* Offsets of all blobs of given type in the input */
+    Containers::Array<std::size_t> meshes;
+    Containers::Array<std::size_t> scenes;
+    Containers::Array<std::size_t> materials;
+    Containers::Array<std::size_t> images1D;
+    Containers::Array<std::size_t> images2D;
+    Containers::Array<std::size_t> images3D;
+};
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafe; }
+
+bool MagnumImporter::doIsOpened() const { return !!_state; }
+
+void MagnumImporter::doClose() { _state = nullptr; }
+
+void MagnumImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    Containers::Pointer<State> state{InPlaceInit};
+
+    /* Take over the existing array if it's suitably aligned, which is always
+       the case with memory-mapped files, otherwise copy the data */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned) && reinterpret_cast<std::uintptr_t>(data.data()) % 8 == 0) {
+        state->in = Utility::move(data);
+    } else {
+        state->in = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, state->in);
+    }
+
+    /* Go through all blob headers and remember where each blob starts. The
+       contents are verified only when importing the actual data. */
+    std::size_t offset = 0;
+    while(offset < state->in.size()) {
+        const Containers::Optional<Containers::Pair<BlobType, std::size_t>> info = blobInfo(state->in.exceptPrefix(offset));
+        if(!info) {
+            Error{} << "Trade::MagnumImporter::openData(): invalid blob at offset" << offset;
+            return;
+        }
+
+        Containers::Array<std::size_t>* offsets{};
+        switch(info->first()) {
+            case BlobType::Mesh: offsets = &state->meshes; break;
+            case BlobType::Scene: offsets = &state->scenes; break;
+            case BlobType::Material: offsets = &state->materials; break;
+            case BlobType::Image1D: offsets = &state->images1D; break;
+            case BlobType::Image2D: offsets = &state->images2D; break;
+            case BlobType::Image3D: offsets = &state->images3D; break;
+        }
+        /* blobInfo() fails for unknown types */
+        CORRADE_INTERNAL_ASSERT(offsets);
+        arrayAppend(*offsets, offset);
+
+        offset += info->second();
+    }
+
+    _state = Utility::move(state);
+}
+
+UnsignedInt MagnumImporter::doSceneCount() const { return _state->scenes.size(); }
+
+Containers::Optional<SceneData> MagnumImporter::doScene(const UnsignedInt id) {
+    return deserializeSceneBlob(_state->in.exceptPrefix(_state->scenes[id]), DataFlag::ExternallyOwned);
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return _state->meshes.size(); }
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    return deserializeMeshBlob(_state->in.exceptPrefix(_state->meshes[id]), DataFlag::ExternallyOwned);
+}
+
+UnsignedInt MagnumImporter::doMaterialCount() const { return _state->materials.size(); }
+
+Containers::Optional<MaterialData> MagnumImporter::doMaterial(const UnsignedInt id) {
+    return deserializeMaterialBlob(_state->in.exceptPrefix(_state->materials[id]), DataFlag::ExternallyOwned);
+}
+
+UnsignedInt MagnumImporter::doImage1DCount() const { return _state->images1D.size(); }
+
+Containers::Optional<ImageData1D> MagnumImporter::doImage1D(const UnsignedInt id, UnsignedInt) {
+    return deserializeImage1DBlob(_state->in.exceptPrefix(_state->images1D[id]), DataFlag::ExternallyOwned);
+}
+
+UnsignedInt MagnumImporter::doImage2DCount() const { return _state->images2D.size(); }
+
+Containers::Optional<ImageData2D> MagnumImporter::doImage2D(const UnsignedInt id, UnsignedInt) {
+    return deserializeImage2DBlob(_state->in.exceptPrefix(_state->images2D[id]), DataFlag::ExternallyOwned);
+}
+
+UnsignedInt MagnumImporter::doImage3DCount() const { return _state->images3D.size(); }
+
+Containers::Optional<ImageData3D> MagnumImporter::doImage3D(const UnsignedInt id, UnsignedInt) {
+    return deserializeImage3DBlob(_state->in.exceptPrefix(_state->images3D[id]), DataFlag::ExternallyOwned);
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    MAGNUM_TRADE_ABSTRACTIMPORTER_PLUGIN_INTERFACE)
@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void empty();
+    void invalid();
+
+    void import();
+    void openMemoryZeroCopy();
+    void openDataUnaligned();
+
+    void openTwice();
+    void importTwice();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+using namespace Math::Literals;
+
+const Vector3 Positions[]{
+    {1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, 6.0f},
+    {7.0f, 8.0f, 9.0f}
+};
+
+const UnsignedShort Indices[]{2, 1, 0, 0};
+
+const Color4ub Pixels[]{
+    0xff3366ff_rgba, 0x33ff66cc_rgba,
+    0x6633ff99_rgba, 0x336699ff_rgba
+};
+
+/* Creates a file with two meshes, a material and an image */
+Containers::Array<char> file() {
+    Containers::Optional<Containers::Array<char>> mesh1 = serializeBlob(MeshData{MeshPrimitive::Triangles,
+        {}, Indices, MeshIndexData{Indices},
+        {}, Positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(Positions)}
+        }});
+    Containers::Optional<Containers::Array<char>> mesh2 = serializeBlob(MeshData{MeshPrimitive::Points, 15});
+    Containers::Optional<Containers::Array<char>> material = serializeBlob(MaterialData{MaterialType::Phong, {
+        {MaterialAttribute::DiffuseColor, 0x3bd26799_rgbaf}
+    }});
+    Containers::Optional<Containers::Array<char>> image = serializeBlob(ImageData2D{PixelFormat::RGBA8Unorm, {2, 2}, {}, Pixels});
+    CORRADE_INTERNAL_ASSERT(mesh1 && mesh2 && material && image);
+
+    /* Interleave the types to verify they're all picked up correctly */
+    Containers::Array<char> out{NoInit, mesh1->size() + material->size() + image->size() + mesh2->size()};
+    std::size_t offset = 0;
+    for(const Containers::Array<char>* blob: {&*mesh1, &*material, &*image, &*mesh2}) {
+        Utility::copy(*blob, out.sliceSize(offset, blob->size()));
+        offset += blob->size();
+    }
+    return out;
+}
+
+MagnumImporterTest::MagnumImporterTest() {
+    addTests({&MagnumImporterTest::empty,
+              &MagnumImporterTest::invalid,
+
+              &MagnumImporterTest::import,
+              &MagnumImporterTest::openMemoryZeroCopy,
+              &MagnumImporterTest::openDataUnaligned,
+
+              &MagnumImporterTest::openTwice,
+              &MagnumImporterTest::importTwice});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumImporterTest::empty() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* An empty file is a valid sequence of zero blobs */
+    CORRADE_VERIFY(importer->openData(nullptr));
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->materialCount(), 0);
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 0);
+    CORRADE_COMPARE(importer->image3DCount(), 0);
+}
+
+void MagnumImporterTest::invalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* A valid file followed by garbage */
+    Containers::Array<char> data = file();
+    Containers::Array<char> dataGarbage{ValueInit, data.size() + 16};
+    Utility::copy(data, dataGarbage.prefix(data.size()));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(dataGarbage));
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::blobInfo(): invalid header\n"
+        "Trade::MagnumImporter::openData(): invalid blob at offset {}\n", data.size()));
+}
+
+void MagnumImporterTest::import() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    Containers::Array<char> data = file();
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image3DCount(), 0);
+
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+            Containers::arrayView(Indices),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView(Positions),
+            TestSuite::Compare::Container);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+        CORRADE_COMPARE(mesh->vertexCount(), 15);
+    } {
+        Containers::Optional<MaterialData> material = importer->material(0);
+        CORRADE_VERIFY(material);
+        CORRADE_COMPARE(material->types(), MaterialType::Phong);
+        CORRADE_COMPARE(material->attributeDataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(material->attribute<Color4>(MaterialAttribute::DiffuseColor), 0x3bd26799_rgbaf);
+    } {
+        Containers::Optional<ImageData2D> image = importer->image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(image->format(), PixelFormat::RGBA8Unorm);
+        CORRADE_COMPARE(image->size(), (Vector2i{2, 2}));
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image->data()),
+            Containers::arrayView(Pixels),
+            TestSuite::Compare::Container);
+    }
+}
+
+void MagnumImporterTest::openMemoryZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Array allocations are always at least 8-byte aligned, so the importer
+       should reference the memory directly */
+    Containers::Array<char> data = file();
+    CORRADE_VERIFY(importer->openMemory(data));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->vertexData().data() > static_cast<const void*>(data.data()));
+    CORRADE_VERIFY(mesh->vertexData().end() <= static_cast<const void*>(data.end()));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->data().data() > data.data());
+    CORRADE_VERIFY(image->data().end() <= data.end());
+}
+
+void MagnumImporterTest::openDataUnaligned() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Misaligned input should get copied to an aligned location */
+    Containers::Array<char> data = file();
+    Containers::Array<char> misaligned{NoInit, data.size() + 1};
+    Utility::copy(data, misaligned.exceptPrefix(1));
+    CORRADE_VERIFY(importer->openMemory(misaligned.exceptPrefix(1)));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!(mesh->vertexData().data() >= static_cast<const void*>(misaligned.data()) && mesh->vertexData().data() < static_cast<const void*>(misaligned.end())));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::openTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = file();
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+
+    /* Shouldn't crash, leak or anything */
+}
+
+void MagnumImporterTest::importTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    Containers::Array<char> data = file();
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* Verify that everything is working the same way on second use */
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumSceneConverter.h"
+
+#include <mutex>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+enum: std::size_t {
+    Scenes,
+    Meshes,
+    Materials,
+    Images1D,
+    Images2D,
+    Images3D,
+    DataTypeCount
+};
+
+}
+
+struct MagnumSceneConverter::State {
+    bool add(std::size_t type, UnsignedInt id, Containers::Optional<Containers::Array<char>>&& blob);
+
+    /* Guards all members below, as add() can be called from multiple threads
+       with SceneConverterFeature::AddParallel */
+    std::mutex mutex;
+    /* Serialized blobs in the order they get concatenated to the output */
+    Containers::Array<Containers::Array<char>> blobs;
+    /* Index into blobs for every added ID of given data type */
+    Containers::Array<std::size_t> slots[DataTypeCount];
+};
+
+bool MagnumSceneConverter::State::add(const std::size_t type, const UnsignedInt id, Containers::Optional<Containers::Array<char>>&& blob) {
+    if(!blob) return false;
+
+    /* The serialization is done by the caller without holding the lock,
+       which is where the parallelism comes from. Slots are reserved for all
+       IDs up to the current one in order, so when adding serially the blobs
+       end up in the order they were added, and when addMeshes() or
+       addImages2D() process their items on multiple threads, the items end up
+       in the order of their IDs regardless of which thread finished first. */
+    std::lock_guard<std::mutex> lock{mutex};
+    Containers::Array<std::size_t>& typeSlots = slots[type];
+    while(typeSlots.size() <= id) {
+        arrayAppend(typeSlots, blobs.size());
+        arrayAppend(blobs, Containers::Array<char>{});
+    }
+    blobs[typeSlots[id]] = Utility::move(*blob);
+    return true;
+}
+
+MagnumSceneConverter::MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractSceneConverter{manager, plugin}, _out{InPlaceInit} {}
+
+MagnumSceneConverter::~MagnumSceneConverter() = default;
+
+SceneConverterFeatures MagnumSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMultipleToData|
+           SceneConverterFeature::AddScenes|
+           SceneConverterFeature::AddMeshes|
+           SceneConverterFeature::AddMaterials|
+           SceneConverterFeature::AddImages1D|
+           SceneConverterFeature::AddImages2D|
+           SceneConverterFeature::AddImages3D|
+           SceneConverterFeature::AddCompressedImages1D|
+           SceneConverterFeature::AddCompressedImages2D|
+           SceneConverterFeature::AddCompressedImages3D|
+           SceneConverterFeature::AddParallel;
+}
+
+void MagnumSceneConverter::doAbort() {
+    _out->blobs = nullptr;
+    for(Containers::Array<std::size_t>& slots: _out->slots)
+        slots = nullptr;
+}
+
+bool MagnumSceneConverter::doBeginData() {
+    doAbort();
+    return true;
+}
+
+Containers::Optional<Containers::Array<char>> MagnumSceneConverter::doEndData() {
+    std::size_t size = 0;
+    for(const Containers::Array<char>& blob: _out->blobs)
+        size += blob.size();
+
+    /* Blob sizes are all multiples of 8 so each blob in the output stays
+       aligned. The array is empty if nothing was added, which is a valid
+       output as well. */
+    Containers::Array<char> out{NoInit, size};
+    std::size_t offset = 0;
+    for(const Containers::Array<char>& blob: _out->blobs) {
+        Utility::copy(blob, out.sliceSize(offset, blob.size()));
+        offset += blob.size();
+    }
+    doAbort();
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(Utility::move(out));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const SceneData& scene, Containers::StringView) {
+    return _out->add(Scenes, id, serializeBlob(scene));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const MeshData& mesh, Containers::StringView) {
+    return _out->add(Meshes, id, serializeBlob(mesh));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const MaterialData& material, Containers::StringView) {
+    return _out->add(Materials, id, serializeBlob(material));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const ImageData1D& image, Containers::StringView) {
+    return _out->add(Images1D, id, serializeBlob(image));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const ImageData2D& image, Containers::StringView) {
+    return _out->add(Images2D, id, serializeBlob(image));
+}
+
+bool MagnumSceneConverter::doAdd(const UnsignedInt id, const ImageData3D& image, Containers::StringView) {
+    return _out->add(Images3D, id, serializeBlob(image));
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumSceneConverter, Magnum::Trade::MagnumSceneConverter,
+    MAGNUM_TRADE_ABSTRACTSCENECONVERTER_PLUGIN_INTERFACE)
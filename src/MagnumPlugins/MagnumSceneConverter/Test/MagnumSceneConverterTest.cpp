@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/Blob.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumSceneConverterTest: TestSuite::Tester {
+    explicit MagnumSceneConverterTest();
+
+    void mesh();
+    void multiple();
+    void addMeshesParallel();
+    void empty();
+    void addFailed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+using namespace Math::Literals;
+
+const Vector3 Positions[]{
+    {1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, 6.0f},
+    {7.0f, 8.0f, 9.0f}
+};
+
+MagnumSceneConverterTest::MagnumSceneConverterTest() {
+    addTests({&MagnumSceneConverterTest::mesh,
+              &MagnumSceneConverterTest::multiple,
+              &MagnumSceneConverterTest::addMeshesParallel,
+              &MagnumSceneConverterTest::empty,
+              &MagnumSceneConverterTest::addFailed});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumSceneConverterTest::mesh() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MeshData mesh{MeshPrimitive::Triangles, {}, Positions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(Positions)}
+    }};
+
+    /* The output should be exactly the same as the serialized blob */
+    Containers::Optional<Containers::Array<char>> out = converter->convertToData(mesh);
+    CORRADE_VERIFY(out);
+    Containers::Optional<Containers::Array<char>> expected = serializeBlob(mesh);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE_AS(*out, *expected,
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::multiple() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MeshData mesh{MeshPrimitive::Triangles, {}, Positions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(Positions)}
+    }};
+    MaterialData material{MaterialType::Flat, {
+        {MaterialAttribute::BaseColor, 0x3bd26799_rgbaf}
+    }};
+    const Color4ub pixels[]{0xff3366ff_rgba, 0x33ff66cc_rgba};
+    ImageData2D image{PixelFormat::RGBA8Unorm, {1, 2}, {}, pixels};
+    const char blockData[8]{};
+    ImageData3D compressedImage{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4, 1}, {}, blockData};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(mesh));
+    CORRADE_VERIFY(converter->add(image));
+    CORRADE_VERIFY(converter->add(material));
+    CORRADE_VERIFY(converter->add(compressedImage));
+    CORRADE_VERIFY(converter->add(mesh));
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    Containers::Optional<Containers::Array<char>> meshBlob = serializeBlob(mesh);
+    Containers::Optional<Containers::Array<char>> imageBlob = serializeBlob(image);
+    Containers::Optional<Containers::Array<char>> materialBlob = serializeBlob(material);
+    Containers::Optional<Containers::Array<char>> compressedImageBlob = serializeBlob(compressedImage);
+    CORRADE_VERIFY(meshBlob && imageBlob && materialBlob && compressedImageBlob);
+    CORRADE_COMPARE(out->size(), 2*meshBlob->size() + imageBlob->size() + materialBlob->size() + compressedImageBlob->size());
+    CORRADE_COMPARE_AS(out->prefix(meshBlob->size()), *meshBlob,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out->suffix(meshBlob->size()), *meshBlob,
+        TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test a rountrip");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image3DCount(), 1);
+
+    Containers::Optional<MeshData> importedMesh = importer->mesh(1);
+    CORRADE_VERIFY(importedMesh);
+    CORRADE_COMPARE_AS(importedMesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<MaterialData> importedMaterial = importer->material(0);
+    CORRADE_VERIFY(importedMaterial);
+    CORRADE_COMPARE(importedMaterial->types(), MaterialType::Flat);
+    CORRADE_COMPARE(importedMaterial->attribute<Color4>(MaterialAttribute::BaseColor), 0x3bd26799_rgbaf);
+
+    Containers::Optional<ImageData2D> importedImage = importer->image2D(0);
+    CORRADE_VERIFY(importedImage);
+    CORRADE_COMPARE(importedImage->size(), (Vector2i{1, 2}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(importedImage->data()),
+        Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData3D> importedCompressedImage = importer->image3D(0);
+    CORRADE_VERIFY(importedCompressedImage);
+    CORRADE_VERIFY(importedCompressedImage->isCompressed());
+    CORRADE_COMPARE(importedCompressedImage->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(importedCompressedImage->size(), (Vector3i{4, 4, 1}));
+}
+
+void MagnumSceneConverterTest::addMeshesParallel() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    CORRADE_VERIFY(converter->features() & SceneConverterFeature::AddParallel);
+
+    /* Meshes of different sizes so the threads don't finish in order */
+    Vector3 positions[32*33/2];
+    Containers::Array<MeshData> meshes;
+    for(std::size_t i = 0, offset = 0; i != 32; ++i) {
+        Containers::ArrayView<Vector3> meshPositions{positions + offset, i + 1};
+        for(std::size_t j = 0; j != meshPositions.size(); ++j)
+            meshPositions[j] = {Float(i), Float(j), 1.0f};
+        offset += meshPositions.size();
+
+        arrayAppend(meshes, InPlaceInit, MeshPrimitive::Points, DataFlags{}, meshPositions, Containers::Array<MeshAttributeData>{InPlaceInit, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(meshPositions)}
+        }});
+    }
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(meshes[0]));
+    CORRADE_COMPARE(converter->addMeshes(meshes.exceptPrefix(1), 4), 1);
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+
+    /* The output should be the same as if the meshes were added serially */
+    CORRADE_VERIFY(converter->beginData());
+    for(const MeshData& mesh: meshes)
+        CORRADE_VERIFY(converter->add(mesh));
+    Containers::Optional<Containers::Array<char>> expected = converter->endData();
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE_AS(*out, *expected,
+        TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not found, cannot test a rountrip");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*out));
+    CORRADE_COMPARE(importer->meshCount(), 32);
+    for(UnsignedInt i = 0; i != 32; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<MeshData> importedMesh = importer->mesh(i);
+        CORRADE_VERIFY(importedMesh);
+        CORRADE_COMPARE_AS(importedMesh->attribute<Vector3>(MeshAttribute::Position),
+            meshes[i].attribute<Vector3>(MeshAttribute::Position),
+            TestSuite::Compare::Container);
+    }
+}
+
+void MagnumSceneConverterTest::empty() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    CORRADE_VERIFY(converter->beginData());
+    Containers::Optional<Containers::Array<char>> out = converter->endData();
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->size(), 0);
+}
+
+void MagnumSceneConverterTest::addFailed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MaterialData material{{}, {
+        {"pointer", static_cast<const void*>(this)}
+    }};
+
+    CORRADE_VERIFY(converter->beginData());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->add(material));
+    CORRADE_COMPARE(out.str(), "Trade::serializeBlob(): can't serialize a Trade::MaterialAttributeType::Pointer attribute pointer\n");
+
+    /* The conversion should be still in progress and continuing with other
+       data should work */
+    CORRADE_VERIFY(converter->isConverting());
+    MaterialData another{MaterialType::Flat, {
+        {MaterialAttribute::BaseColor, 0x3bd26799_rgbaf}
+    }};
+    CORRADE_VERIFY(converter->add(another));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+    Containers::Optional<Containers::Array<char>> expected = serializeBlob(another);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE_AS(*data, *expected,
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumSceneConverterTest)
@@ -25,60 +25,377 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
-#include <Corrade/Containers/StringStl.h> /** @todo remove once iostream is dropped */
-#include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace Trade {
 
+using namespace Containers::Literals;
+
+namespace {
+
+/* Location of a mesh in the file, filled in a single pass on open */
+struct ObjMesh {
+    /* Points into File::data */
+    Containers::StringView name;
+    /* Byte range of the mesh in File::data, excluding the name line */
+    std::size_t begin, end;
+    /* OBJ indices are global for the whole file, these are offsets of the
+       first position, texture coordinate and normal of this mesh */
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+    /* Used to reserve memory upfront when parsing the mesh */
+    UnsignedInt positionCount, textureCoordinateCount, normalCount;
+};
+
+}
+
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
-    std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    Containers::Array<ObjMesh> meshes;
+    /* Kept for the whole lifetime of the opened file, doMesh() parses a
+       view on its own range so multiple meshes can be imported from
+       different threads at once */
+    Containers::Array<char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* Same as std::isspace() in the C locale, which is what operator>> used to
+   split the keyword on */
+bool isSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/* Splits off the next space-delimited token, skipping empty parts the same
+   way as Utility::String::splitWithoutEmptyParts() did. Returns false if
+   there are no more tokens. */
+bool nextToken(const char*& it, const char* const end, Containers::StringView& token) {
+    while(it != end && *it == ' ') ++it;
+    if(it == end) return false;
+
+    const char* const begin = it;
+    while(it != end && *it != ' ') ++it;
+    token = {begin, std::size_t(it - begin)};
+    return true;
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+/* The token is a view into the file data, which isn't null-terminated. Copy
+   it to a stack buffer for strtof() / strtoul(), falling back to a heap copy
+   only for unreasonably long tokens. std::from_chars() would avoid the copy
+   but isn't available in C++11. */
+const char* nullTerminated(const Containers::StringView token, char(&buffer)[128], Containers::String& heap) {
+    if(token.size() < sizeof(buffer)) {
+        std::memcpy(buffer, token.data(), token.size());
+        buffer[token.size()] = '\0';
+        return buffer;
     }
 
-    Math::Vector<size, Float> output;
+    heap = Containers::String{token};
+    return heap.data();
+}
+
+/* Same semantics as std::stof() -- leading whitespace is skipped, trailing
+   garbage ignored and out-of-range values are an error -- but without
+   exceptions and allocations */
+bool parseFloat(const Containers::StringView token, Float& out) {
+    char buffer[128];
+    Containers::String heap;
+    const char* const string = nullTerminated(token, buffer, heap);
+    char* end;
+    errno = 0;
+    out = std::strtof(string, &end);
+    return end != string && errno != ERANGE;
+}
+
+/* Same semantics as std::stoul() */
+bool parseUnsigned(const Containers::StringView token, unsigned long& out) {
+    char buffer[128];
+    Containers::String heap;
+    const char* const string = nullTerminated(token, buffer, heap);
+    char* end;
+    errno = 0;
+    out = std::strtoul(string, &end, 10);
+    return end != string && errno != ERANGE;
+}
+
+enum class ParseError: UnsignedByte {
+    None,
+    InvalidFloatArraySize,
+    HomogeneousCoordinates,
+    TextureCoordinates3D,
+    MixedPrimitive,
+    WrongPointIndexCount,
+    WrongLineIndexCount,
+    WrongTriangleIndexCount,
+    Polygons,
+    InvalidIndexData,
+    UnknownKeyword,
+    NumericConversion
+};
+
+template<std::size_t size> ParseError extractFloatData(const Containers::StringView contents, Math::Vector<size, Float>& output, Float* const extra = nullptr) {
+    Containers::StringView tokens[size + 1];
+    std::size_t count = 0;
+    Containers::StringView token;
+    for(const char* it = contents.begin(); nextToken(it, contents.end(), token); ++count)
+        if(count < size + 1) tokens[count] = token;
+
+    if(count < size || count > size + (extra ? 1 : 0))
+        return ParseError::InvalidFloatArraySize;
 
     for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+        if(!parseFloat(tokens[i], output[i])) return ParseError::NumericConversion;
 
-    if(data.size() == size+1) {
+    if(count == size + 1) {
         /* This should be obvious from the first if, but add this just to make
            Clang Analyzer happy */
         CORRADE_INTERNAL_ASSERT(extra);
 
-        *extra = std::stof(data.back());
+        if(!parseFloat(tokens[size], *extra))
+            return ParseError::NumericConversion;
     }
 
-    return output;
+    return ParseError::None;
+}
+
+/* Result of parsing a line-aligned chunk of a mesh */
+struct Chunk {
+    Containers::Array<Vector3> positions;
+    Containers::Array<Vector3> normals;
+    Containers::Array<Vector2> textureCoordinates;
+    /* Taking a shortcut as there's fortunately nothing else than just 3 types
+       of data. First positions, then normals, then texture coordinates. */
+    Containers::Array<Vector3ui> indices;
+    std::size_t textureCoordinateIndexCount{}, normalIndexCount{};
+
+    /* First primitive in this chunk and the line it appeared on. Recorded
+       before the index count is checked so a mix with a primitive from a
+       previous chunk gets reported in the same order as in a serial parse. */
+    Containers::Optional<MeshPrimitive> primitive;
+    const char* primitiveLine{};
+
+    /* Parsing stops at the first error. It's printed only after all chunks
+       are merged, as a primitive mix with a previous chunk may precede it
+       and as Error redirection is thread-local. */
+    ParseError error{};
+    const char* errorLine{};
+    MeshPrimitive errorPrimitive{};
+    Containers::StringView errorKeyword;
+};
+
+void printError(const Chunk& chunk) {
+    Error e;
+    e << "Trade::ObjImporter::mesh():";
+    switch(chunk.error) {
+        case ParseError::InvalidFloatArraySize:
+            e << "invalid float array size";
+            return;
+        case ParseError::HomogeneousCoordinates:
+            e << "homogeneous coordinates are not supported";
+            return;
+        case ParseError::TextureCoordinates3D:
+            e << "3D texture coordinates are not supported";
+            return;
+        case ParseError::MixedPrimitive:
+            e << "mixed primitive" << *chunk.primitive << "and" << chunk.errorPrimitive;
+            return;
+        case ParseError::WrongPointIndexCount:
+            e << "wrong index count for point";
+            return;
+        case ParseError::WrongLineIndexCount:
+            e << "wrong index count for line";
+            return;
+        case ParseError::WrongTriangleIndexCount:
+            e << "wrong index count for triangle";
+            return;
+        case ParseError::Polygons:
+            e << "polygons are not supported";
+            return;
+        case ParseError::InvalidIndexData:
+            e << "invalid index data";
+            return;
+        case ParseError::UnknownKeyword:
+            e << "unknown keyword" << chunk.errorKeyword;
+            return;
+        case ParseError::NumericConversion:
+            e << "error while converting numeric data";
+            return;
+        case ParseError::None: break; /* LCOV_EXCL_LINE */
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void parseChunk(const Containers::StringView data, const UnsignedInt positionIndexOffset, const UnsignedInt textureCoordinateIndexOffset, const UnsignedInt normalIndexOffset, Chunk& chunk) {
+    const char* const end = data.end();
+    for(const char* it = data.begin(); it != end; ) {
+        /* Get the line */
+        const char* const lineBegin = it;
+        const char* lineEnd = static_cast<const char*>(std::memchr(it, '\n', end - it));
+        if(lineEnd) it = lineEnd + 1;
+        else it = lineEnd = end;
+
+        /* Ignore comments */
+        if(*lineBegin == '#') continue;
+
+        const Containers::StringView line = Containers::StringView{lineBegin, std::size_t(lineEnd - lineBegin)}.trimmed();
+
+        /* Ignore empty lines */
+        if(line.isEmpty()) continue;
+
+        /* Split the line into keyword and contents */
+        const char* keywordEnd = line.begin();
+        while(keywordEnd != line.end() && *keywordEnd != ' ') ++keywordEnd;
+        const Containers::StringView keyword{line.begin(), std::size_t(keywordEnd - line.begin())};
+        const Containers::StringView contents = Containers::StringView{keywordEnd, std::size_t(line.end() - keywordEnd)}.trimmedPrefix();
+
+        ParseError error = ParseError::None;
+
+        /* Vertex position */
+        if(keyword == "v"_s) {
+            Vector3 position;
+            Float extra{1.0f};
+            error = extractFloatData(contents, position, &extra);
+            if(error == ParseError::None && !Math::TypeTraits<Float>::equals(extra, 1.0f))
+                error = ParseError::HomogeneousCoordinates;
+            if(error == ParseError::None)
+                arrayAppend(chunk.positions, position);
+
+        /* Texture coordinate */
+        } else if(keyword == "vt"_s) {
+            Vector2 textureCoordinate;
+            Float extra{0.0f};
+            error = extractFloatData(contents, textureCoordinate, &extra);
+            if(error == ParseError::None && !Math::TypeTraits<Float>::equals(extra, 0.0f))
+                error = ParseError::TextureCoordinates3D;
+            if(error == ParseError::None)
+                arrayAppend(chunk.textureCoordinates, textureCoordinate);
+
+        /* Normal */
+        } else if(keyword == "vn"_s) {
+            Vector3 normal;
+            error = extractFloatData(contents, normal);
+            if(error == ParseError::None)
+                arrayAppend(chunk.normals, normal);
+
+        /* Indices */
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            Containers::StringView indexTuples[4];
+            std::size_t indexTupleCount = 0;
+            Containers::StringView token;
+            for(const char* i = contents.begin(); nextToken(i, contents.end(), token); ++indexTupleCount)
+                if(indexTupleCount < Containers::arraySize(indexTuples))
+                    indexTuples[indexTupleCount] = token;
+
+            const MeshPrimitive primitive =
+                keyword == "p"_s ? MeshPrimitive::Points :
+                keyword == "l"_s ? MeshPrimitive::Lines :
+                                   MeshPrimitive::Triangles;
+
+            /* Check that we don't mix the primitives in one mesh */
+            if(!chunk.primitive) {
+                chunk.primitive = primitive;
+                chunk.primitiveLine = lineBegin;
+            } else if(*chunk.primitive != primitive) {
+                chunk.error = ParseError::MixedPrimitive;
+                chunk.errorLine = lineBegin;
+                chunk.errorPrimitive = primitive;
+                return;
+            }
+
+            /* Check vertex count per primitive */
+            if(primitive == MeshPrimitive::Points) {
+                if(indexTupleCount != 1)
+                    error = ParseError::WrongPointIndexCount;
+            } else if(primitive == MeshPrimitive::Lines) {
+                if(indexTupleCount != 2)
+                    error = ParseError::WrongLineIndexCount;
+            } else {
+                if(indexTupleCount < 3)
+                    error = ParseError::WrongTriangleIndexCount;
+                else if(indexTupleCount != 3)
+                    error = ParseError::Polygons;
+            }
+
+            for(std::size_t i = 0; i != indexTupleCount && error == ParseError::None; ++i) {
+                const Containers::StringView indexTuple = indexTuples[i];
+                Containers::StringView indexStrings[3];
+                std::size_t indexStringCount = 0;
+                for(const char *j = indexTuple.begin(), *partBegin = j; ; ++j) {
+                    if(j != indexTuple.end() && *j != '/') continue;
+
+                    if(indexStringCount == Containers::arraySize(indexStrings)) {
+                        error = ParseError::InvalidIndexData;
+                        break;
+                    }
+                    indexStrings[indexStringCount++] = {partBegin, std::size_t(j - partBegin)};
+                    if(j == indexTuple.end()) break;
+                    partBegin = j + 1;
+                }
+                if(error != ParseError::None) break;
+
+                Vector3ui index;
+                unsigned long value;
+
+                /* Position indices */
+                if(!parseUnsigned(indexStrings[0], value)) {
+                    error = ParseError::NumericConversion;
+                    break;
+                }
+                index[0] = value - positionIndexOffset;
+
+                /* Texture coordinates */
+                if(indexStringCount == 2 || (indexStringCount == 3 && !indexStrings[1].isEmpty())) {
+                    if(!parseUnsigned(indexStrings[1], value)) {
+                        error = ParseError::NumericConversion;
+                        break;
+                    }
+                    index[2] = value - textureCoordinateIndexOffset;
+                    ++chunk.textureCoordinateIndexCount;
+                }
+
+                /* Normal indices */
+                if(indexStringCount == 3) {
+                    if(!parseUnsigned(indexStrings[2], value)) {
+                        error = ParseError::NumericConversion;
+                        break;
+                    }
+                    index[1] = value - normalIndexOffset;
+                    ++chunk.normalIndexCount;
+                }
+
+                arrayAppend(chunk.indices, index);
+            }
+
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(keyword != "mtllib"_s && keyword != "usemtl"_s && keyword != "g"_s && keyword != "s"_s) {
+            error = ParseError::UnknownKeyword;
+            chunk.errorKeyword = keyword;
+        }
+
+        if(error != ParseError::None) {
+            chunk.error = error;
+            chunk.errorLine = lineBegin;
+            return;
+        }
+    }
 }
 
 }
@@ -89,124 +406,116 @@ ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const Containe
 
 ObjImporter::~ObjImporter() = default;
 
-ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafe; }
 
 void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const Containers::StringView filename) {
-    /** @todo ARGH clean this up, won't work with UTF-8 */
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
+void ObjImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     _file.reset(new File);
-    _file->in = Utility::move(in);
-    parseMeshNames();
-}
 
-void ObjImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
-    _file.reset(new File);
-    /** @todo ARGH MY EYES what is this cursed thing, burn it to the ground */
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    /* Take over the existing array or copy the data if we can't */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        _file->data = Utility::move(data);
+    } else {
+        _file->data = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _file->data);
+    }
 
-    parseMeshNames();
+    indexMeshes();
 }
 
-void ObjImporter::parseMeshNames() {
+void ObjImporter::indexMeshes() {
+    const Containers::StringView data{_file->data.data(), _file->data.size()};
+
     /* First mesh starts at the beginning, its indices start from 1. The end
-       offset will be updated to proper value later. */
+       offset and vertex counts will be updated to proper values later. */
     UnsignedInt positionIndexOffset = 1;
-    UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    UnsignedInt normalIndexOffset = 1;
+    arrayAppend(_file->meshes, ObjMesh{{}, 0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
-    _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
-        /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+    for(const char* it = data.begin(); it != data.end(); ) {
+        /* Get the line. The previous object might end at its beginning. */
+        const char* const lineBegin = it;
+        const char* lineEnd = static_cast<const char*>(std::memchr(it, '\n', data.end() - it));
+        if(lineEnd) it = lineEnd + 1;
+        else it = lineEnd = data.end();
 
         /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        if(*lineBegin == '#') continue;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        /* Parse the keyword, delimited by any whitespace */
+        const char* keywordBegin = lineBegin;
+        while(keywordBegin != lineEnd && isSpace(*keywordBegin)) ++keywordBegin;
+        const char* keywordEnd = keywordBegin;
+        while(keywordEnd != lineEnd && !isSpace(*keywordEnd)) ++keywordEnd;
+        const Containers::StringView keyword{keywordBegin, std::size_t(keywordEnd - keywordBegin)};
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(keyword == "o"_s) {
+            const Containers::StringView name = Containers::StringView{keywordEnd, std::size_t(lineEnd - keywordEnd)}.trimmed();
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
                 thisIsFirstMeshAndItHasNoData = false;
 
                 /* Update its name and add it to name map */
-                if(!name.empty())
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size() - 1);
-                _file->meshNames.back() = Utility::move(name);
+                _file->meshes.back().name = name;
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                _file->meshes.back().begin = it - data.begin();
 
             /* Otherwise this is a name of new mesh */
             } else {
-                /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
-
-                /* Save name and offset of the new one. The end offset will be
-                   updated later. */
-                if(!name.empty())
+                /* Set end and vertex counts of the previous one */
+                ObjMesh& previous = _file->meshes.back();
+                previous.end = lineBegin - data.begin();
+                previous.positionCount = positionIndexOffset - previous.positionIndexOffset;
+                previous.textureCoordinateCount = textureCoordinateIndexOffset - previous.textureCoordinateIndexOffset;
+                previous.normalCount = normalIndexOffset - previous.normalIndexOffset;
+
+                /* Save name and offset of the new one. The end offset and
+                   counts will be updated later. */
+                if(!name.isEmpty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
-                _file->meshNames.emplace_back(Utility::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                arrayAppend(_file->meshes, ObjMesh{name, std::size_t(it - data.begin()), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(keyword == "v"_s) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(keyword == "vn"_s) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
-    /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    /* Set end and vertex counts of the last object */
+    ObjMesh& last = _file->meshes.back();
+    last.end = data.size();
+    last.positionCount = positionIndexOffset - last.positionIndexOffset;
+    last.textureCoordinateCount = textureCoordinateIndexOffset - last.textureCoordinateIndexOffset;
+    last.normalCount = normalIndexOffset - last.normalIndexOffset;
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -217,7 +526,7 @@ Int ObjImporter::doMeshForName(const Containers::StringView name) {
 }
 
 Containers::String ObjImporter::doMeshName(UnsignedInt id) {
-    return _file->meshNames[id];
+    return _file->meshes[id].name;
 }
 
 namespace {
@@ -237,169 +546,99 @@ template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1
 }
 
 Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    /* Set mesh parsing parameters and get a view on the mesh range. Nothing
+       is stored in the importer state to make this function safe to call
+       from multiple threads. */
+    const ObjMesh& mesh = _file->meshes[id];
+    const UnsignedInt positionIndexOffset = mesh.positionIndexOffset;
+    const UnsignedInt textureCoordinateIndexOffset = mesh.textureCoordinateIndexOffset;
+    const UnsignedInt normalIndexOffset = mesh.normalIndexOffset;
+    const Containers::StringView data{_file->data.data() + mesh.begin, mesh.end - mesh.begin};
+
+    /* Decide on the chunk count. There's at most one chunk per thread and
+       each chunk has at least minimalChunkSize bytes. */
+    const std::size_t threadCount = Magnum::Implementation::threadCount(configuration().value<UnsignedInt>("threads"));
+    const std::size_t minimalChunkSize = configuration().value<std::size_t>("minimalChunkSize");
+    std::size_t chunkCount = minimalChunkSize ? data.size()/minimalChunkSize : data.size();
+    if(chunkCount > threadCount) chunkCount = threadCount;
+    if(!chunkCount) chunkCount = 1;
+
+    /* Split the data at line boundaries. Some chunks may end up empty if the
+       lines are longer than the chunk size, that's fine. */
+    Containers::Array<Containers::StringView> chunkData{chunkCount};
+    {
+        const char* chunkBegin = data.begin();
+        for(std::size_t i = 0; i != chunkCount - 1; ++i) {
+            const char* chunkEnd = data.begin() + (i + 1)*data.size()/chunkCount;
+            if(chunkEnd < chunkBegin) chunkEnd = chunkBegin;
+            if(const void* const lineEnd = std::memchr(chunkEnd, '\n', data.end() - chunkEnd))
+                chunkEnd = static_cast<const char*>(lineEnd) + 1;
+            else chunkEnd = data.end();
+            chunkData[i] = {chunkBegin, std::size_t(chunkEnd - chunkBegin)};
+            chunkBegin = chunkEnd;
+        }
+        chunkData[chunkCount - 1] = {chunkBegin, std::size_t(data.end() - chunkBegin)};
+    }
+
+    /* Parse the chunks, one per thread. If there's just one, the vertex
+       counts are known from indexing the file on open so reserve the memory
+       upfront. */
+    Containers::Array<Chunk> chunks{chunkCount};
+    if(chunkCount == 1) {
+        arrayReserve(chunks[0].positions, mesh.positionCount);
+        arrayReserve(chunks[0].textureCoordinates, mesh.textureCoordinateCount);
+        arrayReserve(chunks[0].normals, mesh.normalCount);
+    }
+    Magnum::Implementation::parallelFor(chunkCount, chunkCount, [&](const std::size_t i) {
+        parseChunk(chunkData[i], positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunks[i]);
+    });
 
+    /* Check the chunks in order, printing the first error that a serial
+       parse would encounter */
     Containers::Optional<MeshPrimitive> primitive;
-    Containers::Array<Vector3> positions;
-    Containers::Array<Vector3> normals;
-    Containers::Array<Vector2> textureCoordinates;
-    /* Taking a shortcut as there's fortunately nothing else than just 3 types
-       of data. First positions, then normals, then texture coordinates. */
-    Containers::Array<Vector3ui> indices;
+    std::size_t positionCount = 0, normalCount = 0, textureCoordinateCount = 0, indexCount = 0;
     std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
-
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+    for(const Chunk& chunk: chunks) {
+        if(primitive && chunk.primitive && *primitive != *chunk.primitive && (chunk.error == ParseError::None || chunk.primitiveLine <= chunk.errorLine)) {
+            Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << *chunk.primitive;
+            return Containers::NullOpt;
         }
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
-
-        /* Vertex position */
-        if(keyword == "v") {
-            Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
-            }
-
-            arrayAppend(positions, data);
-
-        /* Texture coordinate */
-        } else if(keyword == "vt") {
-            Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
-            }
-
-            arrayAppend(textureCoordinates, data);
-
-        /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
-
-        /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Triangles;
-
-            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
-                }
-
-                Vector3ui index;
-
-                /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
-
-                /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
-                }
-
-                /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
-                }
-
-                arrayAppend(indices, index);
-            }
-
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+        if(chunk.error != ParseError::None) {
+            printError(chunk);
             return Containers::NullOpt;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        if(!primitive) primitive = chunk.primitive;
+        positionCount += chunk.positions.size();
+        normalCount += chunk.normals.size();
+        textureCoordinateCount += chunk.textureCoordinates.size();
+        indexCount += chunk.indices.size();
+        textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+        normalIndexCount += chunk.normalIndexCount;
+    }
+
+    /* Merge the chunk data. With just one chunk the arrays are taken as-is. */
+    Containers::Array<Vector3> positions;
+    Containers::Array<Vector3> normals;
+    Containers::Array<Vector2> textureCoordinates;
+    Containers::Array<Vector3ui> indices;
+    if(chunkCount == 1) {
+        positions = Utility::move(chunks[0].positions);
+        normals = Utility::move(chunks[0].normals);
+        textureCoordinates = Utility::move(chunks[0].textureCoordinates);
+        indices = Utility::move(chunks[0].indices);
+    } else {
+        arrayReserve(positions, positionCount);
+        arrayReserve(normals, normalCount);
+        arrayReserve(textureCoordinates, textureCoordinateCount);
+        arrayReserve(indices, indexCount);
+        for(const Chunk& chunk: chunks) {
+            arrayAppend(positions, chunk.positions);
+            arrayAppend(normals, chunk.normals);
+            arrayAppend(textureCoordinates, chunk.textureCoordinates);
+            arrayAppend(indices, chunk.indices);
+        }
     }
 
     /* There should be at least indexed position data */
@@ -105,6 +105,32 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+On open, the file is scanned just once to find mesh names, their byte ranges
+and vertex index offsets. Mesh data are parsed only when requested through
+@ref mesh(), so the cost of importing a subset of meshes from a large
+multi-object file is proportional to the size of the meshes requested.
+
+The importer supports @ref ImporterFeature::ThreadSafe, meshes can be thus
+imported from multiple threads at once, for example using
+@ref importMeshes().
+
+Large meshes are additionally split into line-aligned chunks that are parsed
+in parallel and then merged in order, with the result and reported errors
+being the same as with a serial parse. The parser works directly on the file
+data without any per-line allocations. See the
+@ref Trade-ObjImporter-configuration "configuration options below" for
+controlling the thread count and chunk size.
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -123,7 +149,6 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
-        MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
@@ -131,7 +156,7 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
         MAGNUM_OBJIMPORTER_LOCAL Containers::String doMeshName(UnsignedInt id) override;
         MAGNUM_OBJIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
 
-        MAGNUM_OBJIMPORTER_LOCAL void parseMeshNames();
+        MAGNUM_OBJIMPORTER_LOCAL void indexMeshes();
 
         Containers::Pointer<File> _file;
 };
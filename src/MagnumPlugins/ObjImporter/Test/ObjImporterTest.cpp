@@ -28,6 +28,7 @@
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -63,6 +64,7 @@ struct ObjImporterTest: TestSuite::Tester {
     void meshNamedFirstUnnamed();
 
     void moreMeshes();
+    void moreMeshesCrLfNoTrailingNewline();
 
     /* Technically, all invalid cases could be put into a single file, but
        because the indexing is global, it would get increasingly hard to
@@ -77,6 +79,9 @@ struct ObjImporterTest: TestSuite::Tester {
     void invalidIncompleteData();
     void invalidOptionalCoordinate();
 
+    void parallel();
+    void parallelInvalid();
+
     void openTwice();
     void importTwice();
 
@@ -92,6 +97,30 @@ const struct {
     {"index first", "mesh-named-first-unnamed-index-first.obj"},
 };
 
+const struct {
+    const char* filename;
+} ParallelData[]{
+    {"mesh-primitive-points.obj"},
+    {"mesh-primitive-lines.obj"},
+    {"mesh-primitive-triangles.obj"},
+    {"mesh-texture-coordinates-normals.obj"},
+    {"mesh-ignored-keyword.obj"},
+    {"mesh-multiple.obj"},
+    {"mesh-named-first-unnamed-index-first.obj"},
+};
+
+const struct {
+    const char* filename;
+} ParallelInvalidData[]{
+    {"invalid-keyword.obj"},
+    {"invalid-mixed-primitives.obj"},
+    {"invalid-numbers.obj"},
+    {"invalid-number-count.obj"},
+    {"invalid-inconsistent-index-tuple.obj"},
+    {"invalid-incomplete-data.obj"},
+    {"invalid-optional-coordinate.obj"},
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -187,7 +216,8 @@ ObjImporterTest::ObjImporterTest() {
     addInstancedTests({&ObjImporterTest::meshNamedFirstUnnamed},
         Containers::arraySize(MeshNamedFirstUnnamedData));
 
-    addTests({&ObjImporterTest::moreMeshes});
+    addTests({&ObjImporterTest::moreMeshes,
+              &ObjImporterTest::moreMeshesCrLfNoTrailingNewline});
 
     addInstancedTests({&ObjImporterTest::invalid},
         Containers::arraySize(InvalidData));
@@ -210,6 +240,12 @@ ObjImporterTest::ObjImporterTest() {
     addInstancedTests({&ObjImporterTest::invalidOptionalCoordinate},
         Containers::arraySize(InvalidOptionalCoordinateData));
 
+    addInstancedTests({&ObjImporterTest::parallel},
+        Containers::arraySize(ParallelData));
+
+    addInstancedTests({&ObjImporterTest::parallelInvalid},
+        Containers::arraySize(ParallelInvalidData));
+
     addTests({&ObjImporterTest::openTwice,
               &ObjImporterTest::importTwice});
 
@@ -555,6 +591,54 @@ void ObjImporterTest::moreMeshes() {
         TestSuite::Compare::Container);
 }
 
+void ObjImporterTest::moreMeshesCrLfNoTrailingNewline() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The name is delimited by a tab, the last mesh has no data and no
+       newline at the end */
+    const char data[] =
+        "v 1 2 3\r\n"
+        "p 1\r\n"
+        "o\tsecond \r\n"
+        "# comment\r\n"
+        "v 4 5 6\r\n"
+        "\r\n"
+        "p 2\r\n"
+        "o last";
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(data, sizeof(data) - 1)));
+    CORRADE_COMPARE(importer->meshCount(), 3);
+    CORRADE_COMPARE(importer->meshName(0), "");
+    CORRADE_COMPARE(importer->meshName(1), "second");
+    CORRADE_COMPARE(importer->meshName(2), "last");
+    CORRADE_COMPARE(importer->meshForName("second"), 1);
+    CORRADE_COMPARE(importer->meshForName("last"), 2);
+
+    /* Import out of order to verify there's no state carried over from
+       previous meshes */
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView<Vector3>({
+                {4.0f, 5.0f, 6.0f}
+            }), TestSuite::Compare::Container);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView<Vector3>({
+                {1.0f, 2.0f, 3.0f}
+            }), TestSuite::Compare::Container);
+    } {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->mesh(2));
+        CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): incomplete position data\n");
+    }
+}
+
 void ObjImporterTest::invalid() {
     auto&& data = InvalidData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -666,6 +750,70 @@ void ObjImporterTest::invalidOptionalCoordinate() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
 }
 
+void ObjImporterTest::parallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.filename);
+
+    Containers::Pointer<AbstractImporter> serialImporter = _manager.instantiate("ObjImporter");
+    serialImporter->configuration().setValue("threads", 1);
+    CORRADE_VERIFY(serialImporter->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, data.filename)));
+
+    /* A single-byte chunk size makes every thread get a chunk, with some
+       chunks being empty as they're aligned to line boundaries */
+    Containers::Pointer<AbstractImporter> parallelImporter = _manager.instantiate("ObjImporter");
+    parallelImporter->configuration().setValue("threads", 4);
+    parallelImporter->configuration().setValue("minimalChunkSize", 1);
+    CORRADE_VERIFY(parallelImporter->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, data.filename)));
+
+    CORRADE_COMPARE(parallelImporter->meshCount(), serialImporter->meshCount());
+    for(UnsignedInt i = 0; i != serialImporter->meshCount(); ++i) {
+        CORRADE_ITERATION(i);
+
+        Containers::Optional<MeshData> serial = serialImporter->mesh(i);
+        Containers::Optional<MeshData> parallel = parallelImporter->mesh(i);
+        CORRADE_VERIFY(serial);
+        CORRADE_VERIFY(parallel);
+        CORRADE_COMPARE(parallel->primitive(), serial->primitive());
+        CORRADE_COMPARE(parallel->attributeCount(), serial->attributeCount());
+        CORRADE_COMPARE_AS(parallel->indexData(), serial->indexData(),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(parallel->vertexData(), serial->vertexData(),
+            TestSuite::Compare::Container);
+    }
+}
+
+void ObjImporterTest::parallelInvalid() {
+    auto&& data = ParallelInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.filename);
+
+    Containers::Pointer<AbstractImporter> serialImporter = _manager.instantiate("ObjImporter");
+    serialImporter->configuration().setValue("threads", 1);
+    CORRADE_VERIFY(serialImporter->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, data.filename)));
+
+    Containers::Pointer<AbstractImporter> parallelImporter = _manager.instantiate("ObjImporter");
+    parallelImporter->configuration().setValue("threads", 4);
+    parallelImporter->configuration().setValue("minimalChunkSize", 1);
+    CORRADE_VERIFY(parallelImporter->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, data.filename)));
+
+    /* The errors should be exactly the same as with a serial parse, even if
+       they happen in different chunks or depend on a previous chunk */
+    CORRADE_COMPARE(parallelImporter->meshCount(), serialImporter->meshCount());
+    for(UnsignedInt i = 0; i != serialImporter->meshCount(); ++i) {
+        CORRADE_ITERATION(serialImporter->meshName(i));
+
+        std::ostringstream serialOut, parallelOut;
+        {
+            Error redirectError{&serialOut};
+            CORRADE_VERIFY(!serialImporter->mesh(i));
+        } {
+            Error redirectError{&parallelOut};
+            CORRADE_VERIFY(!parallelImporter->mesh(i));
+        }
+        CORRADE_VERIFY(!serialOut.str().empty());
+        CORRADE_COMPARE(parallelOut.str(), serialOut.str());
+    }
+}
+
 void ObjImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
 
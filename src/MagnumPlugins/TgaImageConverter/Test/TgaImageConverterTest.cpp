@@ -29,7 +29,9 @@
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/File.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
 #include <Corrade/Utility/FormatStl.h>
@@ -61,9 +63,15 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rleRgba();
     void rleDisabled();
     void rleFallbackIfLarger();
+    void rleParallel();
 
     void unsupportedMetadata();
 
+    void stream();
+    void streamWrongFormat();
+    void streamCannotWrite();
+    void streamAbort();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -267,7 +275,7 @@ const struct {
         }}, {}, {}, {}, ""},
     {"uncompressed smaller, verbose", {7, 13}, {InPlaceInit, {
             7, 13
-        }}, {}, {}, ImageConverterFlag::Verbose, "Trade::TgaImageConverter::convertToData(): RLE output 1 bytes larger than uncompressed, falling back to uncompressed\n"},
+        }}, {}, {}, ImageConverterFlag::Verbose, "Trade::TgaImageConverter::convertToData(): RLE output larger than 20 bytes, falling back to uncompressed\n"},
     {"uncompressed smaller, fallback disabled, verbose", {7, 13}, {InPlaceInit, {
             0x00|1, 7, 13
         }}, {}, false, ImageConverterFlag::Verbose, ""},
@@ -276,6 +284,16 @@ const struct {
         }}, false, false, ImageConverterFlag::Verbose, ""},
 };
 
+const struct {
+    const char* name;
+    bool compressible;
+    const char* message;
+} RleParallelData[]{
+    {"RLE smaller", true, ""},
+    {"uncompressed smaller", false,
+        "Trade::TgaImageConverter::convertToData(): RLE output larger than 207 bytes, falling back to uncompressed\n"},
+};
+
 const struct {
     const char* name;
     ImageFlags2D imageFlags;
@@ -288,6 +306,23 @@ const struct {
         nullptr}
 };
 
+const struct {
+    const char* name;
+    PixelFormat format;
+    bool rle;
+    Containers::Optional<bool> rleAcrossScanlines;
+    Int bandHeight;
+} StreamData[]{
+    {"RGB, uncompressed", PixelFormat::RGB8Unorm, false, {}, 1},
+    {"RGBA, uncompressed, uneven bands", PixelFormat::RGBA8Unorm, false, {}, 3},
+    {"R, RLE", PixelFormat::R8Unorm, true, {}, 2},
+    {"RGBA, RLE", PixelFormat::RGBA8Unorm, true, {}, 1},
+    {"RGBA, RLE, single band", PixelFormat::RGBA8Unorm, true, {}, 4},
+    /* With a band size equal to the image height the output is the same as
+       from convertToData() even when RLE runs across scanlines */
+    {"RGB, RLE across scanlines, single band", PixelFormat::RGB8Unorm, true, true, 4},
+};
+
 TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat});
 
@@ -308,9 +343,19 @@ TgaImageConverterTest::TgaImageConverterTest() {
     addInstancedTests({&TgaImageConverterTest::rleFallbackIfLarger},
         Containers::arraySize(RleFallbackIfLargerData));
 
+    addInstancedTests({&TgaImageConverterTest::rleParallel},
+        Containers::arraySize(RleParallelData));
+
     addInstancedTests({&TgaImageConverterTest::unsupportedMetadata},
         Containers::arraySize(UnsupportedMetadataData));
 
+    addInstancedTests({&TgaImageConverterTest::stream},
+        Containers::arraySize(StreamData));
+
+    addTests({&TgaImageConverterTest::streamWrongFormat,
+              &TgaImageConverterTest::streamCannotWrite,
+              &TgaImageConverterTest::streamAbort});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -320,6 +365,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(TGAIMAGECONVERTER_TEST_OUTPUT_DIR));
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -648,6 +696,50 @@ void TgaImageConverterTest::rleFallbackIfLarger() {
         TestSuite::Compare::Container);
 }
 
+void TgaImageConverterTest::rleParallel() {
+    auto&& data = RleParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 7x9 RGB pixels, either in runs of the same color or all different,
+       with a 1-pixel row padding to verify the bands are sliced correctly */
+    Containers::Array<char> pixels{ValueInit, 9*(7*3 + 1)};
+    for(std::size_t y = 0; y != 9; ++y) for(std::size_t x = 0; x != 7; ++x) {
+        for(std::size_t i = 0; i != 3; ++i)
+            pixels[y*(7*3 + 1) + x*3 + i] = data.compressible ?
+                char(y*3 + i) : char(y*21 + x*3 + i);
+    }
+    ImageView2D image{PixelStorage{}.setAlignment(2), PixelFormat::RGB8Unorm, {7, 9}, pixels};
+
+    Containers::Pointer<AbstractImageConverter> serialConverter = _converterManager.instantiate("TgaImageConverter");
+    serialConverter->setFlags(ImageConverterFlag::Verbose);
+    serialConverter->configuration().setValue("threads", 1);
+
+    /* A single-byte band size makes each thread get at least one band */
+    Containers::Pointer<AbstractImageConverter> parallelConverter = _converterManager.instantiate("TgaImageConverter");
+    parallelConverter->setFlags(ImageConverterFlag::Verbose);
+    parallelConverter->configuration().setValue("threads", 4);
+    parallelConverter->configuration().setValue("minimalBandSize", 1);
+
+    std::ostringstream serialOut, parallelOut;
+    Containers::Optional<Containers::Array<char>> serial, parallel;
+    {
+        Debug redirectOutput{&serialOut};
+        serial = serialConverter->convertToData(image);
+    } {
+        Debug redirectOutput{&parallelOut};
+        parallel = parallelConverter->convertToData(image);
+    }
+    CORRADE_VERIFY(serial);
+    CORRADE_VERIFY(parallel);
+    CORRADE_COMPARE_AS(*parallel, *serial,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(serialOut.str(), data.message);
+    CORRADE_COMPARE(parallelOut.str(), data.message);
+
+    /* Verify that the RLE output is actually used or not */
+    CORRADE_COMPARE(Int(reinterpret_cast<const Implementation::TgaHeader*>(parallel->data())->imageType), data.compressible ? 10 : 2);
+}
+
 void TgaImageConverterTest::unsupportedMetadata() {
     auto&& data = UnsupportedMetadataData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -667,6 +759,89 @@ void TgaImageConverterTest::unsupportedMetadata() {
         CORRADE_COMPARE(out.str(), Utility::formatString("Trade::TgaImageConverter::convertToData(): {}\n", data.message));
 }
 
+/* Data with both repeat and sequence runs, some crossing scanlines. Large
+   enough for a 5x4 RGBA image, the RGB and R variants use just a prefix. */
+constexpr UnsignedByte StreamImageData[]{
+    1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5,
+    6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9,
+    9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9
+};
+
+void TgaImageConverterTest::stream() {
+    auto&& data = StreamData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    CORRADE_VERIFY(converter->features() & ImageConverterFeature::Stream2DToFile);
+    converter->configuration().setValue("rle", data.rle);
+    /* Streaming doesn't know the total size upfront so there's no fallback,
+       disable it for the reference data as well */
+    converter->configuration().setValue("rleFallbackIfLarger", false);
+    if(data.rleAcrossScanlines)
+        converter->configuration().setValue("rleAcrossScanlines", *data.rleAcrossScanlines);
+
+    const ImageView2D image{PixelStorage{}.setAlignment(1), data.format, {5, 4}, StreamImageData};
+    const std::size_t rowSize = pixelFormatSize(data.format)*5;
+
+    const Containers::Optional<Containers::Array<char>> expected = converter->convertToData(image);
+    CORRADE_VERIFY(expected);
+
+    const Containers::String filename = Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "stream.tga");
+    if(Utility::Path::exists(filename))
+        CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    CORRADE_VERIFY(converter->beginFile(filename, data.format, {5, 4}));
+    CORRADE_VERIFY(converter->isConverting());
+    for(Int y = 0; y < 4; y += data.bandHeight) {
+        const Int height = Math::min(data.bandHeight, 4 - y);
+        CORRADE_VERIFY(converter->addRows(ImageView2D{PixelStorage{}.setAlignment(1), data.format, {5, height}, Containers::arrayView(StreamImageData).sliceSize(y*rowSize, height*rowSize)}));
+    }
+    CORRADE_VERIFY(converter->endFile());
+    CORRADE_VERIFY(!converter->isConverting());
+
+    CORRADE_COMPARE_AS(filename,
+        Containers::StringView{*expected},
+        TestSuite::Compare::FileToString);
+}
+
+void TgaImageConverterTest::streamWrongFormat() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->beginFile(Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "stream.tga"), PixelFormat::RG8Unorm, {1, 1}));
+    CORRADE_VERIFY(!converter->isConverting());
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::beginFile(): unsupported pixel format PixelFormat::RG8Unorm\n");
+}
+
+void TgaImageConverterTest::streamCannotWrite() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->beginFile("/some/path/that/does/not/exist.tga", PixelFormat::RGBA8Unorm, {1, 1}));
+    CORRADE_VERIFY(!converter->isConverting());
+    /* There's an error from Path::write() before */
+    CORRADE_COMPARE_AS(out.str(),
+        "\nTrade::TgaImageConverter::beginFile(): cannot write to file /some/path/that/does/not/exist.tga\n",
+        TestSuite::Compare::StringHasSuffix);
+}
+
+void TgaImageConverterTest::streamAbort() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    const Containers::String filename = Utility::Path::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "stream-abort.tga");
+    CORRADE_VERIFY(converter->beginFile(filename, PixelFormat::RGBA8Unorm, {5, 4}));
+    CORRADE_VERIFY(converter->addRows(ImageView2D{PixelFormat::RGBA8Unorm, {5, 1}, StreamImageData}));
+    CORRADE_VERIFY(Utility::Path::exists(filename));
+
+    /* Aborting removes the partially written file */
+    converter->abort();
+    CORRADE_VERIFY(!converter->isConverting());
+    CORRADE_VERIFY(!Utility::Path::exists(filename));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
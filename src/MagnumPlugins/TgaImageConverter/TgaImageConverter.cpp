@@ -25,6 +25,7 @@
 
 #include "TgaImageConverter.h"
 
+#include <atomic>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
@@ -32,8 +33,10 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/Path.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
@@ -47,9 +50,25 @@ using namespace Containers::Literals;
     MagnumFontConverter currently) */
 TgaImageConverter::TgaImageConverter() = default;
 
+struct TgaImageConverter::State {
+    Containers::String filename;
+    PixelFormat format;
+    bool rle;
+    bool rleAcrossScanlines;
+    /* Reused for every band to avoid allocating again for each */
+    Containers::Array<char> band;
+};
+
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImageConverter{manager, plugin} {}
 
-ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData; }
+TgaImageConverter::~TgaImageConverter() {
+    /* The base destructor can't call the virtual doAbort() anymore, so
+       remove the partially written file here if a conversion is still in
+       progress */
+    abort();
+}
+
+ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData|ImageConverterFeature::Stream2DToFile; }
 
 Containers::String TgaImageConverter::doExtension() const { return "tga"_s; }
 
@@ -71,10 +90,11 @@ template<> inline Vector4ub swizzle(const Vector4ub& value) {
     return Math::gather<'b', 'g', 'r', 'a'>(value);
 }
 
-template<class T> void rleEncode(Containers::Array<char>& data, const ImageView2D& image, const bool rleAcrossScanlines) {
-    /* Pixel array and current position in it. Can't iterate linearly in data()
+/* Returns false if the output got larger than sizeLimit, in which case the
+   encoding was stopped early and the data are incomplete */
+template<class T> bool rleEncode(Containers::Array<char>& data, const Containers::StridedArrayView2D<const T>& pixels, const bool rleAcrossScanlines, const std::size_t sizeLimit) {
+    /* Current position in the pixel array. Can't iterate linearly in data()
        because the input may have arbitrary padding between rows. */
-    const Containers::StridedArrayView2D<const T> pixels = image.pixels<T>();
     std::size_t y = 0;
     std::size_t x = 1;
     if(pixels.size()[1] == 1) {
@@ -102,7 +122,12 @@ template<class T> void rleEncode(Containers::Array<char>& data, const ImageView2
        builds */
     Containers::StridedArrayView1D<const T> currentRow;
     while(y < pixels.size()[0]) {
-        if(!currentRow) currentRow = pixels[y];
+        if(!currentRow) {
+            /* Checking the output size just once per row to not slow down
+               the inner loop */
+            if(data.size() > sizeLimit) return false;
+            currentRow = pixels[y];
+        }
         /* Current pixel, again pre-swizzled so we don't need to swizzle in
            each arrayAppend() call */
         const T current = swizzle(currentRow[x]);
@@ -207,6 +232,24 @@ template<class T> void rleEncode(Containers::Array<char>& data, const ImageView2
         arrayAppend(data, count == 1 ? '\x00' : char(UnsignedByte(0x80|(count - 1))));
         arrayAppend(data, prev.data);
     }
+
+    return data.size() <= sizeLimit;
+}
+
+namespace {
+
+bool rleEncodeInto(Containers::Array<char>& data, const ImageView2D& image, const std::size_t rowBegin, const std::size_t rowEnd, const bool rleAcrossScanlines, const std::size_t sizeLimit) {
+    switch(image.format()) {
+        case PixelFormat::R8Unorm:
+            return rleEncode<UnsignedByte>(data, image.pixels<UnsignedByte>().slice(rowBegin, rowEnd), rleAcrossScanlines, sizeLimit);
+        case PixelFormat::RGB8Unorm:
+            return rleEncode<Vector3ub>(data, image.pixels<Vector3ub>().slice(rowBegin, rowEnd), rleAcrossScanlines, sizeLimit);
+        case PixelFormat::RGBA8Unorm:
+            return rleEncode<Vector4ub>(data, image.pixels<Vector4ub>().slice(rowBegin, rowEnd), rleAcrossScanlines, sizeLimit);
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
 }
 
 Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData(const ImageView2D& image) {
@@ -255,33 +298,72 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
     header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
 
     /* Perform RLE encoding */
+    bool uncompressed = !rle;
     if(rle) {
         header.imageType |= 8;
 
+        /* If falling back to an uncompressed output, stop encoding as soon as
+           the output gets larger, as it'd be discarded anyway */
         const bool rleAcrossScanlines = configuration().value<bool>("rleAcrossScanlines");
-        switch(image.format()) {
-            case PixelFormat::R8Unorm:
-                rleEncode<UnsignedByte>(data, image, rleAcrossScanlines);
-                break;
-            case PixelFormat::RGB8Unorm:
-                rleEncode<Vector3ub>(data, image, rleAcrossScanlines);
-                break;
-            case PixelFormat::RGBA8Unorm:
-                rleEncode<Vector4ub>(data, image, rleAcrossScanlines);
-                break;
-            default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        const std::size_t sizeLimit = configuration().value<bool>("rleFallbackIfLarger") ? uncompressedSize : ~std::size_t{};
+        const std::size_t height = image.size().y();
+
+        /* If RLE runs don't go across scanlines, bands of rows are encoded
+           independently of each other, and can be thus encoded in parallel
+           with the same output as a serial encoding */
+        std::size_t bandCount = 1;
+        if(!rleAcrossScanlines) {
+            const std::size_t threadCount = Magnum::Implementation::threadCount(configuration().value<UnsignedInt>("threads"));
+            const std::size_t minimalBandSize = configuration().value<std::size_t>("minimalBandSize");
+            const std::size_t pixelDataSize = uncompressedSize - sizeof(Implementation::TgaHeader);
+            bandCount = minimalBandSize ? pixelDataSize/minimalBandSize : threadCount;
+            if(bandCount > threadCount) bandCount = threadCount;
+            if(bandCount > height) bandCount = height;
+            if(!bandCount) bandCount = 1;
+        }
+
+        /* Encode a single band directly into the output. Reserve for the
+           uncompressed size, which is the size the output is expected to
+           stay under. */
+        if(bandCount == 1) {
+            arrayReserve(data, uncompressedSize);
+            uncompressed = !rleEncodeInto(data, image, 0, height, rleAcrossScanlines, sizeLimit);
+        }
+        /* Otherwise encode each band on its own thread, skipping the
+           remaining ones once the output gets over the limit */
+        else {
+            Containers::Array<Containers::Array<char>> bands{bandCount};
+            std::atomic<std::size_t> encodedSize{data.size()};
+            std::atomic<bool> overLimit{false};
+            Magnum::Implementation::parallelFor(bandCount, bandCount, [&](const std::size_t i) {
+                if(overLimit) return;
+
+                /* Completed bands are a part of the output, so a band can't
+                   be larger than what's left until the limit */
+                const std::size_t completedSize = encodedSize;
+                if(completedSize > sizeLimit || !rleEncodeInto(bands[i], image, i*height/bandCount, (i + 1)*height/bandCount, false, sizeLimit - completedSize) || (encodedSize += bands[i].size()) > sizeLimit)
+                    overLimit = true;
+            });
+
+            if(overLimit) uncompressed = true;
+            else {
+                arrayReserve(data, encodedSize);
+                for(const Containers::Array<char>& band: bands)
+                    arrayAppend(data, band);
+            }
         }
     }
 
     /* If RLE wasn't used or if a RLE output is larger than uncompressed
        output, write an uncompressed output instead */
-    if(!rle || (data.size() > uncompressedSize && configuration().value<bool>("rleFallbackIfLarger"))) {
+    if(uncompressed) {
         if(rle) {
             if(flags() & ImageConverterFlag::Verbose)
-                Debug{} << "Trade::TgaImageConverter::convertToData(): RLE output" << data.size() - uncompressedSize << "bytes larger than uncompressed, falling back to uncompressed";
+                Debug{} << "Trade::TgaImageConverter::convertToData(): RLE output larger than" << uncompressedSize << "bytes, falling back to uncompressed";
 
-            /* Resize the array to exactly the uncompressed size (this will
-               always shrink, never grow) */
+            /* Resize the array to exactly the uncompressed size. As the
+               encoding may have been stopped early or the bands weren't
+               copied to the output at all, this can both shrink and grow. */
             arrayResize(data, NoInit, uncompressedSize);
 
             /* Remove the RLE bit from the header. Can't use the header
@@ -310,6 +392,101 @@ Containers::Optional<Containers::Array<char>> TgaImageConverter::doConvertToData
     return Containers::optional(Utility::move(data));
 }
 
+bool TgaImageConverter::doBeginFile(const Containers::StringView filename, const PixelFormat format, const Vector2i& size, const ImageFlags2D flags) {
+    /* Warn about lost metadata */
+    if((flags & ImageFlag2D::Array) && !(this->flags() & ImageConverterFlag::Quiet)) {
+        Warning{} << "Trade::TgaImageConverter::beginFile(): 1D array images are unrepresentable in TGA, saving as a regular 2D image";
+    }
+
+    Implementation::TgaHeader header{};
+    switch(format) {
+        case PixelFormat::RGB8Unorm:
+            if(this->flags() & ImageConverterFlag::Verbose)
+                Debug{} << "Trade::TgaImageConverter::beginFile(): converting from RGB to BGR";
+            header.imageType = 2;
+            break;
+        case PixelFormat::RGBA8Unorm:
+            if(this->flags() & ImageConverterFlag::Verbose)
+                Debug{} << "Trade::TgaImageConverter::beginFile(): converting from RGBA to BGRA";
+            header.imageType = 2;
+            break;
+        case PixelFormat::R8Unorm:
+            header.imageType = 3;
+            break;
+        default:
+            Error() << "Trade::TgaImageConverter::beginFile(): unsupported pixel format" << format;
+            return false;
+    }
+
+    /* As the total size isn't known upfront, there's no way to fall back to
+       an uncompressed output if RLE is larger, so rleFallbackIfLarger is
+       ignored here */
+    const bool rle = configuration().value<bool>("rle");
+    if(rle) header.imageType |= 8;
+    header.bpp = UnsignedByte(pixelFormatSize(format)*8);
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(size.x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(size.y()));
+
+    if(!Utility::Path::write(filename, Containers::arrayView(reinterpret_cast<const char*>(&header), sizeof(header)))) {
+        Error{} << "Trade::TgaImageConverter::beginFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    _state.emplace();
+    _state->filename = Containers::String::nullTerminatedGlobalView(filename);
+    _state->format = format;
+    _state->rle = rle;
+    _state->rleAcrossScanlines = configuration().value<bool>("rleAcrossScanlines");
+    return true;
+}
+
+bool TgaImageConverter::doAddRows(const ImageView2D& rows) {
+    /* Rows are added bottom-up, which is the default TGA origin, so each band
+       can be simply appended to the file. Each band is encoded separately,
+       which means a RLE run never crosses a band boundary. With
+       rleAcrossScanlines disabled, which is the default, the output is thus
+       the same as from convertToData(). */
+    Containers::Array<char>& band = _state->band;
+    if(_state->rle) {
+        arrayResize(band, NoInit, 0);
+        rleEncodeInto(band, rows, 0, rows.size().y(), _state->rleAcrossScanlines, ~std::size_t{});
+    } else {
+        const std::size_t pixelSize = rows.pixelSize();
+        arrayResize(band, NoInit, pixelSize*rows.size().product());
+        Utility::copy(rows.pixels(), Containers::StridedArrayView3D<char>{band,
+            {std::size_t(rows.size().y()), std::size_t(rows.size().x()), pixelSize}});
+
+        if(_state->format == PixelFormat::RGB8Unorm) {
+            for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(band))
+                pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        } else if(_state->format == PixelFormat::RGBA8Unorm) {
+            for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(band))
+                pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        }
+    }
+
+    if(!Utility::Path::append(_state->filename, band)) {
+        Error{} << "Trade::TgaImageConverter::addRows(): cannot write to file" << _state->filename;
+        return false;
+    }
+
+    return true;
+}
+
+bool TgaImageConverter::doEndFile() {
+    /* Everything is written already, just discard the state */
+    _state = {};
+    return true;
+}
+
+void TgaImageConverter::doAbort() {
+    /* Remove the partially written file, if there's any */
+    if(_state) {
+        Utility::Path::remove(_state->filename);
+        _state = {};
+    }
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImageConverter, Magnum::Trade::TgaImageConverter,
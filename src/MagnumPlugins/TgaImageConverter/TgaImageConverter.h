@@ -106,6 +106,24 @@ smaller than RLE. You can always produce uncompressed files by disabling the
 [such files are considered invalid in the TGA 2.0 spec](https://en.wikipedia.org/wiki/Truevision_TGA#Specification_discrepancies)
 and thus may cause issues in certain importers.
 
+With @cb{.ini} rleAcrossScanlines @ce disabled, larger images are split into
+bands of rows that are RLE-encoded in parallel, producing the same output as a
+serial encoding. The thread count and the minimal band size can be controlled
+with the @cb{.ini} threads @ce and @cb{.ini} minimalBandSize @ce options. With
+@cb{.ini} rleFallbackIfLarger @ce enabled, the encoding is stopped as soon as
+the output gets larger than an uncompressed output would be, avoiding work
+that would be discarded anyway.
+
+The image can be also streamed to a file in bands of rows using
+@ref beginFile(), @ref addRows() and @ref endFile(), which avoids having
+the whole image in memory at once. As the total output size isn't known
+upfront in this case, the @cb{.ini} rleFallbackIfLarger @ce option is ignored
+and each band is RLE-encoded independently, i.e. with
+@cb{.ini} rleAcrossScanlines @ce enabled the runs still don't cross band
+boundaries. Aborting the conversion with @ref abort() or destroying the
+converter while a conversion is in progress removes the partially written
+file.
+
 The TGA file format doesn't have a way to distinguish between 2D and 1D array
 images. If an image has @ref ImageFlag2D::Array set, a warning is printed and
 the file is saved as a regular 2D image.
@@ -136,11 +154,21 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
         /** @brief Plugin manager constructor */
         explicit TgaImageConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
+        ~TgaImageConverter();
+
     private:
+        struct State;
+
         MAGNUM_TGAIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
         MAGNUM_TGAIMAGECONVERTER_LOCAL Containers::String doExtension() const override;
         MAGNUM_TGAIMAGECONVERTER_LOCAL Containers::String doMimeType() const override;
         MAGNUM_TGAIMAGECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doConvertToData(const ImageView2D& image) override;
+        MAGNUM_TGAIMAGECONVERTER_LOCAL bool doBeginFile(Containers::StringView filename, PixelFormat format, const Vector2i& size, ImageFlags2D flags) override;
+        MAGNUM_TGAIMAGECONVERTER_LOCAL bool doAddRows(const ImageView2D& rows) override;
+        MAGNUM_TGAIMAGECONVERTER_LOCAL bool doEndFile() override;
+        MAGNUM_TGAIMAGECONVERTER_LOCAL void doAbort() override;
+
+        Containers::Pointer<State> _state;
 };
 
 }}
@@ -25,11 +25,13 @@
 
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -56,11 +58,13 @@ struct TgaImporterTest: TestSuite::Tester {
     void color32Rle();
     void grayscale8();
     void grayscale8Rle();
+    void colorLarge();
 
     void tga2();
     void fileTooLong();
 
     void openMemory();
+    void zeroCopy();
     void openTwice();
     void importTwice();
 
@@ -253,6 +257,18 @@ const struct {
     }}, ImporterFlag::Quiet, true},
 };
 
+const struct {
+    const char* name;
+    UnsignedByte bpp;
+    PixelFormat format;
+    bool rle;
+} ColorLargeData[]{
+    {"24-bit", 24, PixelFormat::RGB8Unorm, false},
+    {"24-bit RLE", 24, PixelFormat::RGB8Unorm, true},
+    {"32-bit", 32, PixelFormat::RGBA8Unorm, false},
+    {"32-bit RLE", 32, PixelFormat::RGBA8Unorm, true},
+};
+
 /* Shared among all plugins that implement data copying optimizations */
 const struct {
     const char* name;
@@ -291,13 +307,17 @@ TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle});
 
+    addInstancedTests({&TgaImporterTest::colorLarge},
+        Containers::arraySize(ColorLargeData));
+
     addInstancedTests({&TgaImporterTest::tga2},
         Containers::arraySize(Tga2Data));
 
     addInstancedTests({&TgaImporterTest::fileTooLong},
         Containers::arraySize(FileTooLongData));
 
-    addInstancedTests({&TgaImporterTest::openMemory},
+    addInstancedTests({&TgaImporterTest::openMemory,
+                       &TgaImporterTest::zeroCopy},
         Containers::arraySize(OpenMemoryData));
 
     addTests({&TgaImporterTest::openTwice,
@@ -523,6 +543,45 @@ void TgaImporterTest::grayscale8Rle() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::colorLarge() {
+    auto&& data = ColorLargeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 13x3 pixels, which isn't a multiple of the count of pixels processed
+       at once by the optimized BGR(A) to RGB(A) conversion, so the remainder
+       gets tested as well */
+    Containers::Array<char> file;
+    arrayAppend(file, {0, 0, char(data.rle ? 10 : 2), 0, 0, 0, 0, 0, 0, 0, 0, 0, 13, 0, 3, 0, char(data.bpp), 0});
+
+    const std::size_t pixelSize = data.bpp/8;
+    Containers::Array<char> expected;
+    for(std::size_t i = 0; i != 13*3; ++i) {
+        const char value = data.rle && i < 20 ? 0 : char(4*i);
+        const char bgra[]{char(value + 1), char(value + 2), char(value + 3), char(value + 4)};
+        const char rgba[]{bgra[2], bgra[1], bgra[0], bgra[3]};
+        arrayAppend(expected, Containers::arrayView(rgba).prefix(pixelSize));
+
+        /* With RLE, the first 20 pixels are a single repeated pixel, the
+           remaining 19 pixels are stored as-is */
+        if(data.rle && i == 0)
+            arrayAppend(file, '\x93');
+        if(data.rle && i == 20)
+            arrayAppend(file, '\x12');
+        if(!data.rle || i == 0 || i >= 20)
+            arrayAppend(file, Containers::arrayView(bgra).prefix(pixelSize));
+    }
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(file));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), data.format);
+    CORRADE_COMPARE(image->size(), (Vector2i{13, 3}));
+    CORRADE_COMPARE_AS(image->data(), expected,
+        TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::tga2() {
     auto&& data = Tga2Data[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -606,6 +665,39 @@ void TgaImporterTest::openMemory() {
     }), TestSuite::Compare::Container);
 }
 
+void TgaImporterTest::zeroCopy() {
+    auto&& data = OpenMemoryData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->configuration().setValue("zeroCopy", true);
+    CORRADE_VERIFY(data.open(*importer, Containers::arrayView(Grayscale8)));
+
+    {
+        Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+        CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+        CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+            1, 2, 3, 4, 5, 6
+        }), TestSuite::Compare::Container);
+
+        /* With openMemory() the view points directly to the original memory */
+        if(Containers::StringView{data.name} == "memory")
+            CORRADE_VERIFY(image->data().data() == Grayscale8 + 18);
+    }
+
+    /* Color images still need a BGR to RGB conversion, so they're copied */
+    CORRADE_VERIFY(data.open(*importer, Containers::arrayView(Color24)));
+    {
+        Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+        CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    }
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
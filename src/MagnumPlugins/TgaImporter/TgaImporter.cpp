@@ -25,29 +25,100 @@
 
 #include "TgaImporter.h"
 
+#include <cstring>
+#include <Corrade/Cpu.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Vector2.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
+#ifdef CORRADE_ENABLE_SSSE3
+#include <tmmintrin.h>
+#endif
+
 namespace Magnum { namespace Trade {
 
 using namespace Containers::Literals;
 
+namespace {
+
+/* Copies BGR(A) pixels from src to dst, swizzling them to RGB(A). The src and
+   dst can be the same memory for an in-place conversion. */
+template<std::size_t pixelSize> void swizzleIntoScalar(const char* src, char* dst, std::size_t size) {
+    for(std::size_t i = 0; i != size; i += pixelSize) {
+        const char b = src[i + 0];
+        const char g = src[i + 1];
+        const char r = src[i + 2];
+        dst[i + 0] = r;
+        dst[i + 1] = g;
+        dst[i + 2] = b;
+        if(pixelSize == 4) dst[i + 3] = src[i + 3];
+    }
+}
+
+#ifdef CORRADE_ENABLE_SSSE3
+/* Processes 16 bytes at a time, for RGB it's five pixels and the last byte is
+   kept in place, and gets overwritten by the next iteration. The scalar
+   variant handles the remaining pixels. Same as above, src and dst can be the
+   same memory. */
+template<std::size_t pixelSize> CORRADE_ENABLE_SSSE3 void swizzleIntoSsse3(const char* src, char* dst, std::size_t size) {
+    const __m128i shuffle = pixelSize == 4 ?
+        _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15) :
+        _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    constexpr std::size_t step = pixelSize == 4 ? 16 : 15;
+
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += step) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(in, shuffle));
+    }
+
+    swizzleIntoScalar<pixelSize>(src + i, dst + i, size - i);
+}
+#endif
+
+template<std::size_t pixelSize> void swizzleInto(const char* src, char* dst, std::size_t size) {
+    #ifdef CORRADE_ENABLE_SSSE3
+    if(Cpu::runtimeFeatures() & Cpu::Ssse3)
+        return swizzleIntoSsse3<pixelSize>(src, dst, size);
+    #endif
+    swizzleIntoScalar<pixelSize>(src, dst, size);
+}
+
+/* Fills dst with count copies of pixelSize bytes from src. Instead of
+   copying one pixel at a time, the already filled part is copied over and
+   over, doubling in size each time. */
+void fillInto(const char* src, char* dst, std::size_t pixelSize, std::size_t count) {
+    if(pixelSize == 1) {
+        std::memset(dst, *src, count);
+        return;
+    }
+
+    const std::size_t size = pixelSize*count;
+    std::memcpy(dst, src, pixelSize);
+    for(std::size_t filled = pixelSize; filled < size; ) {
+        const std::size_t copy = filled < size - filled ? filled : size - filled;
+        std::memcpy(dst + filled, dst, copy);
+        filled += copy;
+    }
+}
+
+}
+
 TgaImporter::TgaImporter() = default;
 
 TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
 
 TgaImporter::~TgaImporter() = default;
 
-ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ThreadSafe; }
 
 bool TgaImporter::doIsOpened() const { return _in; }
 
@@ -181,8 +252,11 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
-    /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((size.x()*header.bpp/8)%4 != 0)
+        storage.setAlignment(1);
+
     if(!rle) {
         if(srcPixels.size() < outputSize) {
             Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
@@ -196,65 +270,79 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             Warning{} << "Trade::TgaImporter::image2D(): ignoring" << srcPixels.size() - outputSize << "extra bytes at the end of image data";
         }
 
-        Utility::copy(srcPixels.prefix(data.size()), data);
+        /* Grayscale data don't need any processing, so if enabled, return
+           just a view on the data we have. Those stay alive until close(). */
+        if(format == PixelFormat::R8Unorm && configuration().value<bool>("zeroCopy"))
+            return ImageData2D{storage, format, size, DataFlag::ExternallyOwned, srcPixels.prefix(outputSize)};
+    }
 
-    /* Otherwise decode */
-    } else {
-        Containers::ArrayView<char> dstPixels = data;
-        while(!srcPixels.isEmpty()) {
-            /* Reference: http://www.paulbourke.net/dataformats/tga/ */
-
-            /* 8-bit RLE header. First bit denotes the operation, last 7 bits
-               denotes operation count minus 1. */
-            const UnsignedByte rleHeader = srcPixels[0];
-            const std::size_t count = (rleHeader & ~0x80) + 1;
-
-            /* First bit set to 1 means copying the following pixel given
-               number of times, 0 means copying the following number of
-               pixels once. We represent that operation with a stride. */
-            const std::size_t dataSize = (rleHeader & 0x80 ? 1 : count)*pixelSize;
-            const std::ptrdiff_t stride = rleHeader & 0x80 ? 0 : pixelSize;
-
-            /* Check bounds */
-            if(1 + dataSize > srcPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE file too short at pixel" << (dstPixels.begin() - data.begin())/pixelSize;
-                return {};
-            }
-            if(count*pixelSize > dstPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE data at byte" << (srcPixels.data() - _in.data()) << "contains" << count << "pixels but only" << dstPixels.size()/pixelSize << "left to decode";
-                return {};
-            }
+    /* The output gets fully overwritten below, no need to zero-initialize */
+    Containers::Array<char> data{NoInit, outputSize};
+
+    /* Not RLE, copy the data directly. Color data get swizzled while being
+       copied to avoid going over the memory twice. */
+    if(!rle) {
+        if(format == PixelFormat::RGB8Unorm) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
+            swizzleInto<3>(srcPixels.data(), data.data(), data.size());
+        } else if(format == PixelFormat::RGBA8Unorm) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
+            swizzleInto<4>(srcPixels.data(), data.data(), data.size());
+        } else Utility::copy(srcPixels.prefix(data.size()), data);
+
+        return ImageData2D{storage, format, size, Utility::move(data)};
+    }
 
-            /* Copy the data */
-            Containers::StridedArrayView2D<const char> src{
-                srcPixels.slice(1, 1 + dataSize),
-                {count, pixelSize}, {stride, 1}};
-            Containers::StridedArrayView2D<char> dst{
-                dstPixels.prefix(count*pixelSize),
-                {count, pixelSize}};
-            Utility::copy(src, dst);
-
-            /* Update views for the next round */
-            srcPixels = srcPixels.exceptPrefix(1 + dataSize);
-            dstPixels = dstPixels.exceptPrefix(count*pixelSize);
+    /* Otherwise decode */
+    Containers::ArrayView<char> dstPixels = data;
+    while(!srcPixels.isEmpty()) {
+        /* Reference: http://www.paulbourke.net/dataformats/tga/ */
+
+        /* 8-bit RLE header. First bit denotes the operation, last 7 bits
+           denotes operation count minus 1. */
+        const UnsignedByte rleHeader = srcPixels[0];
+        const std::size_t count = (rleHeader & ~0x80) + 1;
+
+        /* First bit set to 1 means copying the following pixel given number
+           of times, 0 means copying the following number of pixels once */
+        const bool repeat = rleHeader & 0x80;
+        const std::size_t dataSize = (repeat ? 1 : count)*pixelSize;
+
+        /* Check bounds */
+        if(1 + dataSize > srcPixels.size()) {
+            Error{} << "Trade::TgaImporter::image2D(): RLE file too short at pixel" << (dstPixels.begin() - data.begin())/pixelSize;
+            return {};
         }
+        if(count*pixelSize > dstPixels.size()) {
+            Error{} << "Trade::TgaImporter::image2D(): RLE data at byte" << (srcPixels.data() - _in.data()) << "contains" << count << "pixels but only" << dstPixels.size()/pixelSize << "left to decode";
+            return {};
+        }
+
+        /* Copy the data */
+        if(repeat)
+            fillInto(srcPixels.data() + 1, dstPixels.data(), pixelSize, count);
+        else
+            std::memcpy(dstPixels.data(), srcPixels.data() + 1, dataSize);
+
+        /* Update views for the next round */
+        srcPixels = srcPixels.exceptPrefix(1 + dataSize);
+        dstPixels = dstPixels.exceptPrefix(count*pixelSize);
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
+    /* If the RLE data ended early, the rest of the image is zero-filled */
+    if(!dstPixels.isEmpty())
+        std::memset(dstPixels.data(), 0, dstPixels.size());
 
     if(format == PixelFormat::RGB8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        swizzleInto<3>(data.data(), data.data(), data.size());
     } else if(format == PixelFormat::RGBA8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        swizzleInto<4>(data.data(), data.data(), data.size());
     }
 
     return ImageData2D{storage, format, size, Utility::move(data)};
@@ -106,12 +106,36 @@ which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
 
+The BGR(A) to RGB(A) conversion of color images is done while copying the data
+from the file, and uses SSSE3 if the CPU supports it. If the
+@cb{.ini} zeroCopy @ce @ref Trade-TgaImporter-configuration "configuration option"
+is enabled, uncompressed grayscale images are not copied at all and are
+returned as views on the file data, with @ref DataFlag::ExternallyOwned set.
+Such data stay valid only until the importer is closed or destroyed. This is
+especially useful in combination with @ref openMemory() or
+@ref ImporterFlag::MapFile, where the file data aren't copied either.
+
 If a TGA 2 footer is recognized in the file, the optional extension and
 developer area blocks at the end of the file are ignored.
 
 The importer recognizes @ref ImporterFlag::Verbose, printing additional info
 when the flag is enabled. @ref ImporterFlag::Quiet is recognized as well and
 causes all import warnings to be suppressed.
+
+The importer supports @ref ImporterFeature::ThreadSafe. As there's just a
+single image in a file, it's mainly useful for importing the same file
+concurrently, for a bulk import of many files use a separate importer instance
+for each thread instead.
+
+@section Trade-TgaImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImporter/TgaImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
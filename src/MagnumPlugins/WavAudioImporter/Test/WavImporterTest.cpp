@@ -26,10 +26,12 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Path.h>
 
@@ -80,10 +82,37 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void stream();
+    void streamSeek();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    const char* filename;
+    bool openFile;
+    /* Deliberately not a multiple of the frame size for most files */
+    std::size_t bufferSize;
+    std::size_t seekOffset, expectedSeekOffset;
+} StreamData[]{
+    {"mono8, file", "mono8.wav", true, 333, 1001, 1001},
+    {"mono8, data", "mono8.wav", false, 333, 1001, 1001},
+    {"mono8 A-Law, file", "mono8ALaw.wav", true, 100, 17, 17},
+    {"mono8 μ-Law, file", "mono8MuLaw.wav", true, 100, 17, 17},
+    {"mono16 big-endian, file", "mono16be.wav", true, 3, 3, 2},
+    {"mono16 big-endian, data", "mono16be.wav", false, 3, 3, 2},
+    {"stereo8 A-Law, data", "stereo8ALaw.wav", false, 333, 1001, 1000},
+    {"stereo8 μ-Law, file", "stereo8MuLaw.wav", true, 333, 1001, 1000},
+    {"stereo16, file", "stereo16.wav", true, 5, 3, 0},
+    {"mono32f, file", "mono32f.wav", true, 333, 1001, 1000},
+    {"mono32f big-endian, file", "mono32fbe.wav", true, 7, 9, 8},
+    {"stereo32f, data", "stereo32f.wav", false, 333, 1001, 1000},
+    {"stereo64f, file", "stereo64f.wav", true, 4096, 65, 64},
+    {"stereo64f big-endian, file", "stereo64fbe.wav", true, 20, 17, 16},
+};
+
 WavImporterTest::WavImporterTest() {
     addTests({&WavImporterTest::empty,
               &WavImporterTest::wrongSignature,
@@ -123,6 +152,10 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::surround51Channel16,
               &WavImporterTest::surround71Channel24});
 
+    addInstancedTests({&WavImporterTest::stream,
+                       &WavImporterTest::streamSeek},
+        Containers::arraySize(StreamData));
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
@@ -147,7 +180,7 @@ void WavImporterTest::wrongSignature() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "wrongSignature.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file signature is invalid\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file signature is invalid\n");
 }
 
 void WavImporterTest::unsupportedFormat() {
@@ -156,7 +189,7 @@ void WavImporterTest::unsupportedFormat() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedFormat.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::unsupportedChannelCount() {
@@ -165,7 +198,7 @@ void WavImporterTest::unsupportedChannelCount() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedChannelCount.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 6 with 8 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): PCM with unsupported channel count 6 with 8 bits per sample\n");
 }
 
 void WavImporterTest::invalidPadding() {
@@ -174,7 +207,7 @@ void WavImporterTest::invalidPadding() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidPadding.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file has improper size, expected 66 but got 73\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file has improper size, expected 66 but got 73\n");
 }
 
 void WavImporterTest::invalidLength() {
@@ -183,7 +216,7 @@ void WavImporterTest::invalidLength() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidLength.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file has improper size, expected 160844 but got 80444\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file has improper size, expected 160844 but got 80444\n");
 }
 
 void WavImporterTest::invalidDataChunk() {
@@ -192,7 +225,7 @@ void WavImporterTest::invalidDataChunk() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidDataChunk.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file contains no data chunk\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): the file contains no data chunk\n");
 }
 
 void WavImporterTest::invalidFactChunk() {
@@ -224,7 +257,7 @@ void WavImporterTest::mono4() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "mono4.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::mono8() {
@@ -308,7 +341,7 @@ void WavImporterTest::stereo4() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo4.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::stereo8() {
@@ -355,7 +388,7 @@ void WavImporterTest::stereo12() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo12.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 12 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): PCM with unsupported channel count 2 with 12 bits per sample\n");
 }
 
 void WavImporterTest::stereo16() {
@@ -376,7 +409,7 @@ void WavImporterTest::stereo24() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo24.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 24 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): PCM with unsupported channel count 2 with 24 bits per sample\n");
 }
 
 void WavImporterTest::stereo32() {
@@ -385,7 +418,7 @@ void WavImporterTest::stereo32() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo32.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 32 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): PCM with unsupported channel count 2 with 32 bits per sample\n");
 }
 
 void WavImporterTest::mono32f() {
@@ -459,7 +492,7 @@ void WavImporterTest::surround51Channel16() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "surround51Channel16.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
 void WavImporterTest::surround71Channel24() {
@@ -468,7 +501,85 @@ void WavImporterTest::surround71Channel24() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, "surround71Channel24.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): unsupported format Audio::WavAudioFormat::Extensible\n");
+}
+
+void WavImporterTest::stream() {
+    auto&& data = StreamData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Stream);
+
+    const Containers::String filename = Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, data.filename);
+    if(data.openFile) {
+        CORRADE_VERIFY(importer->openFile(filename));
+    } else {
+        Containers::Optional<Containers::Array<char>> file = Utility::Path::read(filename);
+        CORRADE_VERIFY(file);
+        CORRADE_VERIFY(importer->openData(*file));
+    }
+
+    const Containers::Array<char> expected = importer->data();
+    CORRADE_COMPARE(importer->dataSize(), expected.size());
+
+    /* Read everything in small pieces and verify it matches the data
+       returned all at once */
+    Containers::Array<char> streamed{NoInit, expected.size()};
+    Containers::Array<char> buffer{NoInit, data.bufferSize};
+    std::size_t offset = 0;
+    while(const std::size_t size = importer->read(buffer)) {
+        CORRADE_VERIFY(size <= data.bufferSize);
+        CORRADE_VERIFY(offset + size <= streamed.size());
+        Utility::copy(buffer.prefix(size), streamed.sliceSize(offset, size));
+        offset += size;
+    }
+    CORRADE_COMPARE(offset, expected.size());
+    CORRADE_COMPARE_AS(streamed, expected, TestSuite::Compare::Container);
+
+    /* Reading past the end gives back nothing */
+    CORRADE_COMPARE(importer->read(buffer), 0);
+}
+
+void WavImporterTest::streamSeek() {
+    auto&& data = StreamData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    const Containers::String filename = Utility::Path::join(WAVAUDIOIMPORTER_TEST_DIR, data.filename);
+    if(data.openFile) {
+        CORRADE_VERIFY(importer->openFile(filename));
+    } else {
+        Containers::Optional<Containers::Array<char>> file = Utility::Path::read(filename);
+        CORRADE_VERIFY(file);
+        CORRADE_VERIFY(importer->openData(*file));
+    }
+
+    const Containers::Array<char> expected = importer->data();
+
+    /* 16 bytes is a multiple of the frame size for all tested formats, so
+       the read is cut only by the end of the data */
+    Containers::Array<char> buffer{NoInit, 16};
+
+    /* The offset gets rounded down to a whole sample frame */
+    CORRADE_VERIFY(importer->seek(data.seekOffset));
+    const Containers::ArrayView<const char> expectedAtOffset = expected.exceptPrefix(data.expectedSeekOffset);
+    const std::size_t size = importer->read(buffer);
+    CORRADE_COMPARE(size, expectedAtOffset.size() < 16 ? expectedAtOffset.size() : 16);
+    CORRADE_COMPARE_AS(buffer.prefix(size), expectedAtOffset.prefix(size),
+        TestSuite::Compare::Container);
+
+    /* Seeking back to the start gives the beginning again */
+    CORRADE_VERIFY(importer->seek(0));
+    const std::size_t sizeAtStart = importer->read(buffer);
+    CORRADE_COMPARE(sizeAtStart, expected.size() < 16 ? expected.size() : 16);
+    CORRADE_COMPARE_AS(buffer.prefix(sizeAtStart), expected.prefix(sizeAtStart),
+        TestSuite::Compare::Container);
+
+    /* Seeking to the end makes the next read return nothing */
+    CORRADE_VERIFY(importer->seek(importer->dataSize()));
+    CORRADE_COMPARE(importer->read(buffer), 0);
 }
 
 }}}}
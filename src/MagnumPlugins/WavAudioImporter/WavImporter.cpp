@@ -24,12 +24,28 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+/* Has to be defined before any system header is included to make off_t and
+   thus fseeko() / ftello() 64-bit on 32-bit platforms as well */
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
 #include "WavImporter.h"
 
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once AbstractImporter is <string>-free */
 #include <Corrade/Utility/EndiannessBatch.h>
+#include <Corrade/Utility/Move.h>
+
+#ifdef CORRADE_TARGET_WINDOWS
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Unicode.h>
+#endif
 
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
@@ -40,29 +56,143 @@ using Implementation::WavAudioFormat;
 using Implementation::WavFormatChunk;
 using Implementation::WavHeaderChunk;
 
+namespace {
+
+/* The plain fseek() / ftell() operate with a long, which is 32-bit on
+   Windows and on 32-bit platforms, so files over 2 GB couldn't be streamed */
+bool seek(std::FILE* const file, const std::size_t offset, const int origin) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    return fseeko(file, off_t(offset), origin) == 0;
+    #else
+    return _fseeki64(file, __int64(offset), origin) == 0;
+    #endif
+}
+
+long long tell(std::FILE* const file) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    return ftello(file);
+    #else
+    return _ftelli64(file);
+    #endif
+}
+
+}
+
+/* Gives access to the file contents either in memory or on disk, so the
+   header parsing can be shared between openData() and openFile() without
+   having to read the whole file into memory for the latter */
+struct WavImporter::Input {
+    bool read(std::size_t offset, void* out, std::size_t size) const {
+        if(offset + size > this->size) return false;
+        if(!file) {
+            std::memcpy(out, data + offset, size);
+            return true;
+        }
+        return seek(file, offset, SEEK_SET) &&
+               std::fread(out, 1, size, file) == size;
+    }
+
+    const char* data;
+    std::FILE* file;
+    std::size_t size;
+};
+
+struct WavImporter::State {
+    ~State() { if(file) std::fclose(file); }
+
+    /* If opened from memory, the data chunk is copied here. If opened from a
+       file, the file is kept open and the data are read on demand, so
+       streaming a file doesn't need it to be in memory at once. */
+    Containers::Array<char> data;
+    std::FILE* file{};
+    std::size_t dataOffset{}, dataSize{}, position{};
+
+    BufferFormat format;
+    UnsignedInt frequency;
+    UnsignedShort blockAlign, bitsPerSample;
+    bool swapEndianness;
+};
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
 
-ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
+WavImporter::~WavImporter() = default;
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::Stream; }
+
+bool WavImporter::doIsOpened() const { return !!_state; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
-    /* Check file size */
-    if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
+    Containers::Pointer<State> state = parse("Audio::WavImporter::openData():", Input{data.data(), nullptr, data.size()});
+    if(!state) return;
+
+    /* The data view isn't guaranteed to stay in scope, copy the data chunk */
+    state->data = Containers::Array<char>{NoInit, state->dataSize};
+    Utility::copy(data.sliceSize(state->dataOffset, state->dataSize), state->data);
+    if(state->swapEndianness) swapDataEndianness(state->data, state->bitsPerSample);
+
+    _state = Utility::move(state);
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    std::FILE* const file = std::fopen(filename.c_str(), "rb");
+    #else
+    std::FILE* const file = _wfopen(Utility::Unicode::widen(filename), L"rb");
+    #endif
+    if(!file) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
         return;
     }
 
+    std::size_t size = 0;
+    if(seek(file, 0, SEEK_END)) {
+        const long long position = tell(file);
+        if(position > 0) size = position;
+    }
+
+    Containers::Pointer<State> state = parse("Audio::WavImporter::openFile():", Input{nullptr, file, size});
+    if(!state) {
+        std::fclose(file);
+        return;
+    }
+
+    /* Keep the file open, the data get read from it only in data() or
+       read() */
+    state->file = file;
+    _state = Utility::move(state);
+}
+
+void WavImporter::swapDataEndianness(Containers::ArrayView<char> data, UnsignedShort bitsPerSample) {
+    if(bitsPerSample == 16)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(data));
+    else if(bitsPerSample == 32)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(data));
+    else if(bitsPerSample == 64)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(data));
+    else CORRADE_INTERNAL_ASSERT(bitsPerSample == 8);
+}
+
+Containers::Pointer<WavImporter::State> WavImporter::parse(const char* const messagePrefix, const Input& input) {
+    /* Check file size */
+    if(input.size < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
+        Error() << messagePrefix << "the file is too short:" << input.size << "bytes";
+        return {};
+    }
+
     /* Get the RIFF/WAV header */
-    WavHeaderChunk header(*reinterpret_cast<const WavHeaderChunk*>(data.begin()));
+    WavHeaderChunk header;
+    if(!input.read(0, &header, sizeof(WavHeaderChunk))) {
+        Error() << messagePrefix << "cannot read the file header";
+        return {};
+    }
 
     /* Check RIFF/WAV file signature */
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
-        Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        Error() << messagePrefix << "the file signature is invalid";
+        return {};
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -74,16 +204,17 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         Utility::Endianness::swapInPlace(header.chunk.chunkSize);
 
     /* Check file size */
-    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
-        Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != input.size) {
+        Error() << messagePrefix << "the file has improper size, expected"
+                << header.chunk.chunkSize + 8 << "but got" << input.size;
+        return {};
     }
 
-    const RiffChunk* dataChunk = nullptr;
-    /* We're doing endian-swapping on this, thus can't be just a reference to
-       the original data */
+    /* We're doing endian-swapping on this, and it might not be in memory,
+       thus can't be just a reference to the original data */
     Containers::Optional<WavFormatChunk> formatChunk;
+    bool hasDataChunk = false;
+    UnsignedInt dataChunkOffset = 0;
     UnsignedInt dataChunkSize = 0;
 
     const UnsignedInt headerSize = sizeof(WavHeaderChunk);
@@ -91,28 +222,38 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Skip any chunks that aren't the format or data chunk */
     while(headerSize + offset <= header.chunk.chunkSize) {
-        const RiffChunk* currChunk = reinterpret_cast<const RiffChunk*>(data.begin() + headerSize + offset);
-        UnsignedInt chunkSize = currChunk->chunkSize;
+        const UnsignedInt chunkOffset = headerSize + offset;
+        RiffChunk currChunk;
+        if(!input.read(chunkOffset, &currChunk, sizeof(RiffChunk))) {
+            Error() << messagePrefix << "the file is corrupted";
+            return {};
+        }
+        UnsignedInt chunkSize = currChunk.chunkSize;
         if(hasBigEndianData != Utility::Endianness::isBigEndian())
             Utility::Endianness::swapInPlace(chunkSize);
 
         offset += chunkSize + sizeof(RiffChunk);
 
-        if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
+        if(std::strncmp(currChunk.chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
-                Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                Error() << messagePrefix << "the file contains too many format chunks";
+                return {};
             }
 
-            formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
+            formatChunk.emplace();
+            if(!input.read(chunkOffset, &*formatChunk, sizeof(WavFormatChunk))) {
+                Error() << messagePrefix << "the file is corrupted";
+                return {};
+            }
 
-        } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
-            if(dataChunk != nullptr) {
-                Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+        } else if(std::strncmp(currChunk.chunkId, "data", 4) == 0) {
+            if(hasDataChunk) {
+                Error() << messagePrefix << "the file contains too many data chunks";
+                return {};
             }
 
-            dataChunk = currChunk;
+            hasDataChunk = true;
+            dataChunkOffset = chunkOffset + sizeof(RiffChunk);
             dataChunkSize = chunkSize;
             break;
         }
@@ -120,14 +261,14 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
-        Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        Error() << messagePrefix << "the file contains no format chunk";
+        return {};
     }
 
     /* Make sure we actually got a data chunk */
-    if(dataChunk == nullptr) {
-        Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+    if(!hasDataChunk) {
+        Error() << messagePrefix << "the file contains no data chunk";
+        return {};
     }
 
     /* Fix endianness on Format chunk */
@@ -138,115 +279,148 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             formatChunk->byteRate, formatChunk->blockAlign,
             formatChunk->bitsPerSample);
 
+    Containers::Pointer<State> state{InPlaceInit};
+
     /* Check PCM format */
     if(formatChunk->audioFormat == WavAudioFormat::Pcm) {
         /* Decide about format */
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Mono8;
+            state->format = BufferFormat::Mono8;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 16)
-            _format = BufferFormat::Mono16;
+            state->format = BufferFormat::Mono16;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Stereo8;
+            state->format = BufferFormat::Stereo8;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 16)
-             _format = BufferFormat::Stereo16;
+             state->format = BufferFormat::Stereo16;
         else {
-            Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
+            Error() << messagePrefix << "PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check IEEE Float format */
     } else if(formatChunk->audioFormat == WavAudioFormat::IeeeFloat) {
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::MonoFloat;
+            state->format = BufferFormat::MonoFloat;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::StereoFloat;
+            state->format = BufferFormat::StereoFloat;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::MonoDouble;
+            state->format = BufferFormat::MonoDouble;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::StereoDouble;
+            state->format = BufferFormat::StereoDouble;
         else {
-            Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
+            Error() << messagePrefix << "IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check A-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::ALaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoALaw;
+            state->format = BufferFormat::MonoALaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoALaw;
+            state->format = BufferFormat::StereoALaw;
         else {
-            Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
+            Error() << messagePrefix << "ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check μ-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::MuLaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoMuLaw;
+            state->format = BufferFormat::MonoMuLaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoMuLaw;
+            state->format = BufferFormat::StereoMuLaw;
         else {
-            Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
+            Error() << messagePrefix << "MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Unknown/unimplemented format */
     } else {
-        Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        Error() << messagePrefix << "unsupported format" << formatChunk->audioFormat;
+        return {};
     }
 
     /* Size sanity checks */
-    if(headerSize + offset > data.size()) {
-        Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+    if(headerSize + offset > input.size) {
+        Error() << messagePrefix << "file size doesn't match computed size";
+        return {};
     }
 
     /* Format sanity checks */
-    if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
+    if(!formatChunk->blockAlign ||
+       formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
-        Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        Error() << messagePrefix << "the file is corrupted";
+        return {};
     }
 
-    /* Save frequency */
-    _frequency = formatChunk->sampleRate;
+    state->frequency = formatChunk->sampleRate;
+    state->blockAlign = formatChunk->blockAlign;
+    state->bitsPerSample = formatChunk->bitsPerSample;
+    state->swapEndianness = hasBigEndianData != Utility::Endianness::isBigEndian();
+    state->dataOffset = dataChunkOffset;
+    state->dataSize = dataChunkSize;
+    return state;
+}
 
-    /* Copy the data */
-    _data = Containers::Array<char>{NoInit, dataChunkSize};
-    Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize), *_data);
+void WavImporter::doClose() { _state = nullptr; }
 
-    /* Fix the data endianness */
-    if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
+BufferFormat WavImporter::doFormat() const { return _state->format; }
+
+UnsignedInt WavImporter::doFrequency() const { return _state->frequency; }
+
+std::size_t WavImporter::readInto(const std::size_t offset, const Containers::ArrayView<char> data) {
+    if(!_state->file) {
+        Utility::copy(_state->data.sliceSize(offset, data.size()), data);
+        return data.size();
     }
+
+    /* Byte-swapping is done only on whole samples, so if the file was
+       truncated in the middle of one, throw the partial sample away */
+    if(!seek(_state->file, _state->dataOffset + offset, SEEK_SET))
+        return 0;
+    const std::size_t bytesPerSample = _state->bitsPerSample/8;
+    const std::size_t size = std::fread(data.data(), 1, data.size(), _state->file)/bytesPerSample*bytesPerSample;
+    if(_state->swapEndianness)
+        swapDataEndianness(data.prefix(size), _state->bitsPerSample);
+    return size;
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+Containers::Array<char> WavImporter::doData() {
+    Containers::Array<char> out{NoInit, _state->dataSize};
+    const std::size_t size = readInto(0, out);
+    if(size != out.size()) {
+        Error() << "Audio::WavImporter::data(): expected" << out.size() << "bytes but got only" << size;
+        return {};
+    }
+    return out;
+}
 
-BufferFormat WavImporter::doFormat() const { return _format; }
+std::size_t WavImporter::doDataSize() const { return _state->dataSize; }
 
-UnsignedInt WavImporter::doFrequency() const { return _frequency; }
+std::size_t WavImporter::doRead(const Containers::ArrayView<char> data) {
+    /* Read only whole sample frames */
+    const std::size_t remaining = _state->dataSize - _state->position;
+    std::size_t size = data.size() < remaining ? data.size() : remaining;
+    size = size/_state->blockAlign*_state->blockAlign;
+    if(!size) return 0;
 
-Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy{NoInit, _data->size()};
-    Utility::copy(*_data, copy);
-    return copy;
+    size = readInto(_state->position, data.prefix(size));
+    _state->position += size;
+    return size;
+}
+
+bool WavImporter::doSeek(const std::size_t offset) {
+    _state->position = offset/_state->blockAlign*_state->blockAlign;
+    return true;
 }
 
 }}
@@ -31,7 +31,7 @@
  */
 
 #include <Corrade/Containers/Array.h>
-#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -76,6 +76,9 @@ Supports mono and stereo files of the following formats:
 Both Little-Endian files (with a `RIFF` header) and Big-Endian files (with
 a `RIFX` header) are supported, data is converted to machine endian on import.
 
+The plugin supports @ref ImporterFeature::Stream for all above formats, see
+@ref Audio-WavImporter-streaming below.
+
 @section Audio-WavImporter-usage Usage
 
 @m_class{m-note m-success}
@@ -115,6 +118,21 @@ See @ref building, @ref cmake and @ref plugins for more information.
 @section Audio-WavImporter-limitations Behavior and limitations
 
 Multi-channel formats are not supported.
+
+@section Audio-WavImporter-streaming Streaming
+
+When opened through @ref openFile(), only the headers are read upfront and the
+file is kept open until @ref close(). The sample data are then read from it on
+demand in @ref data() and @ref read(), which means a clip can be played with
+@ref BufferStreamer using only a fixed amount of memory regardless of its
+length. When opened through @ref openData(), the sample data are copied as the
+passed view isn't guaranteed to stay in scope, and @ref read() then copies
+from that copy.
+
+In both cases @ref read() returns only whole sample frames and @ref seek()
+rounds the offset down to a whole sample frame. As none of the supported
+formats is compressed on a frame boundary, seeking is a constant-time
+operation.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
     public:
@@ -124,19 +142,31 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
 
+        ~WavImporter();
+
     private:
+        struct Input;
+        struct State;
+
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
-        Containers::Optional<Containers::Array<char>> _data;
-        BufferFormat _format;
-        UnsignedInt _frequency;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doDataSize() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doRead(Containers::ArrayView<char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doSeek(std::size_t offset) override;
+
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL static Containers::Pointer<State> parse(const char* messagePrefix, const Input& input);
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL static void swapDataEndianness(Containers::ArrayView<char> data, UnsignedShort bitsPerSample);
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t readInto(std::size_t offset, Containers::ArrayView<char> data);
+
+        Containers::Pointer<State> _state;
 };
 
 }}